@@ -0,0 +1,205 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <util/atomic.h>
+#include <util/delay_basic.h>
+
+HardwareSerial Serial;
+SPIClass SPI;
+
+// ---------------------------------------------------------------------------------
+//  C++ runtime hooks the core normally provides. There is no heap: a deleting destructor
+//  (emitted for the virtual ones) may be referenced but is never called.
+// ---------------------------------------------------------------------------------
+extern "C" void __cxa_pure_virtual() { for (;;) {} }
+void operator delete(void*) noexcept {}
+void operator delete(void*, size_t) noexcept {}
+
+// ---------------------------------------------------------------------------------
+//  Timebase: Timer0 CTC, clk/64, OCR0A = 249 -> one compare match per millisecond
+// ---------------------------------------------------------------------------------
+static constexpr uint8_t TIMEBASE_TOP      = 249;
+static constexpr uint8_t TIMEBASE_US_SHIFT = 2;                 // 4 us per Timer0 tick
+
+static volatile uint32_t timebaseMs = 0;
+
+ISR(TIMER0_COMPA_vect)
+{
+    timebaseMs = timebaseMs + 1;
+}
+
+void hal::init()
+{
+    TCCR0A = (1 << WGM01);                                      // CTC on OCR0A
+    TCCR0B = (1 << CS01) | (1 << CS00);                         // clk/64
+    OCR0A  = TIMEBASE_TOP;
+    TIMSK0 = (1 << OCIE0A);
+    sei();
+}
+
+unsigned long millis()
+{
+    uint32_t ms;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { ms = timebaseMs; }
+    return ms;
+}
+
+/**
+ * @brief Milliseconds x 1000 + the running Timer0 count. A compare match that happened since
+ *        interrupts were disabled is still pending in TIFR0: count it here.
+ */
+unsigned long micros()
+{
+    uint32_t ms;
+    uint8_t ticks;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        ms    = timebaseMs;
+        ticks = TCNT0;
+        if ((TIFR0 & (1 << OCF0A)) && ticks < TIMEBASE_TOP) ++ms;
+    }
+    return ms * 1000UL + (static_cast<uint16_t>(ticks) << TIMEBASE_US_SHIFT);
+}
+
+void delay(unsigned long ms)
+{
+    uint32_t start = micros();
+    while (ms > 0)
+    {
+        if (micros() - start >= 1000)
+        {
+            --ms;
+            start += 1000;
+        }
+    }
+}
+
+/**
+ * @brief Busy wait, 4 cycles per loop at 16 MHz; the encoders time their pulses with it.
+ *        Call and setup overhead (~1 us) is taken off like the core does.
+ */
+void delayMicroseconds(unsigned int us)
+{
+    if (us <= 1) return;
+    _delay_loop_2(static_cast<uint16_t>((us << 2) - 5));
+}
+
+// ---------------------------------------------------------------------------------
+//  random(): xorshift32, seeded like the core with randomSeed()
+// ---------------------------------------------------------------------------------
+static uint32_t randomState = 2463534242UL;
+
+void randomSeed(unsigned long seed)
+{
+    if (seed != 0) randomState = seed;
+}
+
+long random(long howBig)
+{
+    if (howBig == 0) return 0;
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return static_cast<long>(randomState % static_cast<uint32_t>(howBig));
+}
+
+long random(long howSmall, long howBig)
+{
+    if (howSmall >= howBig) return howSmall;
+    return random(howBig - howSmall) + howSmall;
+}
+
+// ---------------------------------------------------------------------------------
+//  UART0, polled
+// ---------------------------------------------------------------------------------
+void HardwareSerial::begin(unsigned long baud)
+{
+    uint16_t setting = static_cast<uint16_t>((F_CPU / 4 / baud - 1) / 2);    // U2X0, rounded like the core
+    UCSR0A = (1 << U2X0);
+    UBRR0H = static_cast<uint8_t>(setting >> 8);
+    UBRR0L = static_cast<uint8_t>(setting);
+    UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);                    // 8N1
+    UCSR0B = (1 << RXEN0) | (1 << TXEN0);
+}
+
+void HardwareSerial::end()
+{
+    flush();
+    UCSR0B = 0;
+}
+
+int HardwareSerial::available()
+{
+    return (UCSR0A & (1 << RXC0)) ? 1 : 0;
+}
+
+int HardwareSerial::read()
+{
+    return (UCSR0A & (1 << RXC0)) ? UDR0 : -1;
+}
+
+void HardwareSerial::flush()
+{
+    if (!(UCSR0B & (1 << TXEN0))) return;
+    while (!(UCSR0A & (1 << UDRE0))) {}
+}
+
+size_t HardwareSerial::write(uint8_t byte)
+{
+    while (!(UCSR0A & (1 << UDRE0))) {}
+    UDR0 = byte;
+    return 1;
+}
+
+// ---------------------------------------------------------------------------------
+//  Print
+// ---------------------------------------------------------------------------------
+size_t Print::print(const char* text)
+{
+    size_t n = 0;
+    while (*text) n += write(static_cast<uint8_t>(*text++));
+    return n;
+}
+
+size_t Print::print(const __FlashStringHelper* text)
+{
+    const char* p = reinterpret_cast<const char*>(text);
+    size_t n = 0;
+    for (char c = pgm_read_byte(p); c; c = pgm_read_byte(++p)) n += write(static_cast<uint8_t>(c));
+    return n;
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+    if (base < 2) base = 10;
+    char digits[33];
+    uint8_t i = sizeof(digits);
+    digits[--i] = '\0';
+    do
+    {
+        uint8_t digit = static_cast<uint8_t>(value % base);
+        digits[--i] = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value);
+    return print(&digits[i]);
+}
+
+size_t Print::print(long value, int base)
+{
+    if (base == 10 && value < 0) return write('-') + print(static_cast<unsigned long>(-value), 10);
+    return print(static_cast<unsigned long>(value), base);
+}
+
+void SPIClass::begin()
+{
+    uint8_t sreg = SREG;
+    cli();
+    PORTB |= (1 << PB2);                                        // SS high first, then output: stays master
+    DDRB  |= (1 << PB2) | (1 << PB3) | (1 << PB5);              // SS, MOSI, SCK
+    SPCR   = (1 << MSTR) | (1 << SPE);
+    SREG = sreg;
+}
+
+void SPIClass::end()
+{
+    SPCR &= ~(1 << SPE);
+}
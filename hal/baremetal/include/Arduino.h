@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * @brief Minimal bare-metal HAL, drop-in for the subset of the Arduino core the drivers use.
+ *
+ * Only the nanoatmega328_baremetal environment puts this directory on the include path, so
+ * SPIBus, Transceiver, the encoders and the debouncer compile unchanged against it:
+ *   - timebase  : Timer0 CTC at 1 kHz, one 32-bit increment per tick (millis / micros / delay)
+ *   - GPIO      : Nano pin numbers mapped to PORTB/C/D; with a constant pin the call folds to sbi/cbi
+ *   - UART      : polled UDR0 (HardwareSerial.h), no ring buffers and no TX interrupt
+ *   - SPI       : SPCR/SPSR from SPISettings, polled transfer (SPI.h)
+ *   - String    : swallows everything, so the drivers' diagnostic messages cost no heap; the
+ *                 logs that print them are compiled out anyway (no DEBUG in this build)
+ * No heap: nothing here calls malloc, and there is no init() beyond hal::init().
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+// Nano: D0..D7 = PD0..PD7, D8..D13 = PB0..PB5, A0..A5 (14..19) = PC0..PC5
+#define SS   10
+#define MOSI 11
+#define MISO 12
+#define SCK  13
+#define A0   14
+
+#define noInterrupts() cli()
+#define interrupts()   sei()
+
+typedef uint8_t byte;
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(PSTR(string_literal)))
+
+namespace hal
+{
+    /// @brief Starts the timebase and enables interrupts (replaces the core's init())
+    void init();
+
+    namespace detail
+    {
+        constexpr volatile uint8_t* portOf(uint8_t pin) { return pin < 8 ? &PORTD : (pin < 14 ? &PORTB : &PORTC); }
+        constexpr volatile uint8_t* ddrOf(uint8_t pin)  { return pin < 8 ? &DDRD  : (pin < 14 ? &DDRB  : &DDRC);  }
+        constexpr volatile uint8_t* pinOf(uint8_t pin)  { return pin < 8 ? &PIND  : (pin < 14 ? &PINB  : &PINC);  }
+        constexpr uint8_t bitOf(uint8_t pin)            { return static_cast<uint8_t>(1 << (pin < 8 ? pin : (pin < 14 ? pin - 8 : pin - 14))); }
+    }
+}
+
+inline void pinMode(uint8_t pin, uint8_t mode)
+{
+    uint8_t bit = hal::detail::bitOf(pin);
+    uint8_t sreg = SREG;
+    cli();
+    if (mode == OUTPUT)
+    {
+        *hal::detail::ddrOf(pin) |= bit;
+    }
+    else
+    {
+        *hal::detail::ddrOf(pin) &= ~bit;
+        if (mode == INPUT_PULLUP) *hal::detail::portOf(pin) |= bit;
+        else                      *hal::detail::portOf(pin) &= ~bit;
+    }
+    SREG = sreg;
+}
+
+inline void digitalWrite(uint8_t pin, uint8_t value)
+{
+    uint8_t bit = hal::detail::bitOf(pin);
+    uint8_t sreg = SREG;
+    cli();
+    if (value) *hal::detail::portOf(pin) |= bit;
+    else       *hal::detail::portOf(pin) &= ~bit;
+    SREG = sreg;
+}
+
+inline int digitalRead(uint8_t pin)
+{
+    return (*hal::detail::pinOf(pin) & hal::detail::bitOf(pin)) ? HIGH : LOW;
+}
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+/**
+ * @brief Heap-free stand-in for the core String: every construction and concatenation is a no-op.
+ *        Only used by the drivers to build log messages, which this build does not print.
+ */
+class String
+{
+    public:
+
+    String() {}
+    String(const char*) {}
+    String(const __FlashStringHelper*) {}
+    template<typename T> String(T, int = DEC) {}
+
+    String operator+(const String&) const { return String(); }
+    friend String operator+(const char*, const String&) { return String(); }
+    String& operator+=(const String&) { return *this; }
+
+    unsigned int length() const { return 0; }
+    const char* c_str() const { return ""; }
+};
+
+#include "HardwareSerial.h"
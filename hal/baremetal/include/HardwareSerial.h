@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+class __FlashStringHelper;
+class String;
+
+/**
+ * @brief Text output on top of write(): the part of the core's Print the firmware uses.
+ */
+class Print
+{
+    public:
+
+    virtual size_t write(uint8_t byte) = 0;
+
+    size_t write(const uint8_t* data, size_t length)
+    {
+        for (size_t i = 0; i < length; ++i) write(data[i]);
+        return length;
+    }
+
+    size_t print(const char* text);
+    size_t print(const __FlashStringHelper* text);
+    size_t print(const String&) { return 0; }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(unsigned long value, int base = 10);
+    size_t print(long value, int base = 10);
+    size_t print(unsigned int value, int base = 10)  { return print(static_cast<unsigned long>(value), base); }
+    size_t print(int value, int base = 10)           { return print(static_cast<long>(value), base); }
+    size_t print(unsigned char value, int base = 10) { return print(static_cast<unsigned long>(value), base); }
+
+    size_t println() { return write('\r') + write('\n'); }
+    template<typename T> size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template<typename T> size_t println(const T& value, int base) { size_t n = print(value, base); return n + println(); }
+};
+
+/**
+ * @brief UART0 by register: polled transmit (waits on UDRE0), polled receive (RXC0, one byte deep).
+ *        No buffers and no interrupts, so nothing runs behind the application's back.
+ */
+class HardwareSerial : public Print
+{
+    public:
+
+    void begin(unsigned long baud);
+    void end();
+
+    int  available();
+    int  read();
+    void flush();
+
+    size_t write(uint8_t byte) override;
+    using Print::write;
+
+    explicit operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdint.h>
+#include <avr/io.h>
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+/**
+ * @brief SPCR / SPSR values for a clock, bit order and mode, computed once (constexpr for constant arguments).
+ *        The clock is rounded down to the nearest F_CPU / 2^n divider, as in the core.
+ */
+class SPISettings
+{
+    public:
+
+    constexpr SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) :
+    _spcr(static_cast<uint8_t>((1 << SPE) | (1 << MSTR) | (bitOrder == LSBFIRST ? (1 << DORD) : 0) | (dataMode & 0x0C) | (divider(clock) >> 1))),
+    _spsr(static_cast<uint8_t>((divider(clock) & 1) ? 0 : (1 << SPI2X)))
+    {
+    }
+
+    constexpr SPISettings() : SPISettings(4000000, MSBFIRST, SPI_MODE0) {}
+
+    private:
+
+    // 0 = /2 ... 6 = /128; SPR1:SPR0 = index >> 1, SPI2X set for even indices
+    static constexpr uint8_t divider(uint32_t clock)
+    {
+        uint8_t index = 0;
+        while (index < 6 && (F_CPU >> (index + 1)) > clock) ++index;
+        return index == 6 ? 7 : index;                          // /128 is SPR=11 without SPI2X
+    }
+
+    uint8_t _spcr;
+    uint8_t _spsr;
+
+    friend class SPIClass;
+};
+
+/**
+ * @brief Polled SPI master on the hardware port (SS kept as output so the port stays master).
+ */
+class SPIClass
+{
+    public:
+
+    static void begin();
+    static void end();
+
+    static void beginTransaction(const SPISettings& settings)
+    {
+        SPCR = settings._spcr;
+        SPSR = settings._spsr;
+    }
+
+    static void endTransaction() {}
+
+    static uint8_t transfer(uint8_t data)
+    {
+        SPDR = data;
+        asm volatile("nop");                                   // Lets the transfer start before polling (as in the core)
+        while (!(SPSR & (1 << SPIF))) {}
+        return SPDR;
+    }
+};
+
+extern SPIClass SPI;
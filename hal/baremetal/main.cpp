@@ -0,0 +1,102 @@
+#include <Arduino.h>
+#include <avr/wdt.h>
+
+#include "App/RemoteCodes.h"
+#include "Config/Constants.h"
+#include "Config/DigitalPin.h"
+#include "Config/TransceiverConfig.h"
+#include "Debounce/CircularDebounceBuffer.h"
+#include "Delay/Timebase.h"
+#include "Debugging/IsrLoad.h"
+#include "Encoder/SC41344_Encoder.h"
+#include "SPI/SPIBus.h"
+#include "Transciever/CC1101_Transceiver.h"
+
+/**
+ * Bare-metal build (env:nanoatmega328_baremetal): the same drivers as src/main.cpp on the
+ * hal/baremetal HAL instead of the Arduino core. Press -> debounce -> SC41344 open-door burst.
+ *
+ * At boot it prints the figures to compare with the Arduino build (which logs the same ones):
+ *   READY us <reset-to-ready>   ISR permille <background interrupt load>
+ * Flash and SRAM come from `pio run -e nanoatmega328 -e nanoatmega328_baremetal` (size summary).
+ */
+
+SPIBus spiBus(CSN_PIN);
+
+TransceiverConfig config
+(
+FREQ_315MHZ_BAND,
+ModulationScheme::OOK,
+OutputPowerLevels::HIGH_POWER
+);
+
+DigitalPin gdo0Pin('B', static_cast<uint8_t>(GDO0_PORT_BIT));
+SC41344_Encoder encoder(gdo0Pin);
+
+CircularDebounceBuffer debounce(REMOTE_BUTTON_ID, BUTTON_HOME_DOOR_GARAGE_PIN, true, SAMPLE_RATE_DEBOUNCE);
+
+Transceiver transceiver(spiBus, config);
+
+static volatile bool pressed = false;
+
+// Button on D3 = INT1, falling edge: no attachInterrupt() table, the vector is bound at link time
+ISR(INT1_vect)
+{
+    debounce.startDebounce();
+}
+
+static void onButtonPressed()
+{
+    pressed = true;
+}
+
+static void transmitOpenDoor()
+{
+    noInterrupts();
+    wdt_disable();
+    bool sent = transceiver.transmitFrame(REMOTE1_OPEN_DOOR_CODE, encoder);
+    wdt_enable(WDTO_8S);
+    interrupts();
+
+    Serial.println(sent ? F("TX OK") : F("TX FAIL"));
+}
+
+int main()
+{
+    wdt_disable();
+    hal::init();
+    Timebase::begin();                                                     // Debounce sampling runs on Timer2 like the Arduino build
+    Serial.begin(115200);
+
+    bool radioReady = transceiver.begin();
+    encoder.begin();
+
+    pinMode(BUTTON_HOME_DOOR_GARAGE_PIN, INPUT_PULLUP);
+    EICRA = (EICRA & ~((1 << ISC10) | (1 << ISC11))) | (1 << ISC11);      // INT1 on falling edge
+    EIFR  = (1 << INTF1);
+    EIMSK |= (1 << INT1);
+
+    debounce.setThreshold(THRESHOLD_DEBOUNCE);
+    debounce.addCallback(onButtonPressed);
+
+    unsigned long readyUs = micros();
+    Serial.print(F("READY us "));
+    Serial.println(readyUs);
+    Serial.print(F("ISR permille "));
+    Serial.println(measureIsrLoadPermille());
+    if (!radioReady) Serial.println(F("Transceiver initialization failed"));
+
+    wdt_enable(WDTO_8S);
+
+    for (;;)
+    {
+        wdt_reset();
+        debounce.update();
+
+        if (pressed)
+        {
+            pressed = false;
+            transmitOpenDoor();
+        }
+    }
+}
@@ -0,0 +1,574 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <avr/eeprom.h>
+#include <avr/sleep.h>
+#include <util/delay_basic.h>
+#include <stdio.h>
+#include <deque>
+
+HardwareSerial Serial;
+SPIClass SPI;
+
+// ---------------------------------------------------------------------------------
+//  Registers, one set per board (thread)
+// ---------------------------------------------------------------------------------
+#define HAL_DEFINE_8(name)     thread_local volatile uint8_t name;
+#define HAL_DEFINE_16(name)    thread_local volatile uint16_t name;
+#define HAL_DEFINE_FLAGS(name) thread_local hal::detail::FlagRegister name;
+HAL_REGISTERS_8(HAL_DEFINE_8)
+HAL_REGISTERS_16(HAL_DEFINE_16)
+HAL_FLAG_REGISTERS(HAL_DEFINE_FLAGS)
+thread_local hal::detail::EepromControl EECR;
+
+// Vectors the HAL runs; the firmware's ISR() replaces them at link time
+extern "C" __attribute__((weak)) void TIMER2_COMPA_vect() {}
+extern "C" __attribute__((weak)) void EE_READY_vect() {}
+
+namespace
+{
+    constexpr uint8_t  PIN_COUNT = 22;                          // D0..D13, A0..A7
+    constexpr uint16_t TIMER2_DIVIDERS[8] = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+    constexpr int8_t   FLOATING = -1;
+
+    struct PinInterrupt
+    {
+        void (*handler)();
+        int  mode;
+        bool pending;
+    };
+
+    struct Board
+    {
+        uint64_t        cycles = 0;
+        uint64_t        timer2Prescale = 0;                     // Cycles not yet counted by Timer2
+        int8_t          driven[PIN_COUNT];
+        uint16_t        analog[PIN_COUNT] = {};
+        PinInterrupt    pinInterrupts[2] = {};                  // INT0 (D2), INT1 (D3)
+        hal::SpiDevice* devices[PIN_COUNT] = {};
+        hal::SpiDevice* selected = nullptr;
+        uint8_t         spiCyclesPerBit = 4;                    // SPISettings() default: 4 MHz
+        uint32_t        randomState = 2463534242UL;
+        uint8_t         eeprom[E2END + 1];
+        std::deque<uint8_t>          rx;
+        std::function<void(uint8_t)> tx;
+        std::function<void()>        rxSource;
+
+        Board()
+        {
+            for (int8_t& level : driven) level = FLOATING;
+            for (uint8_t& byte : eeprom) byte = 0xFF;
+        }
+    };
+
+    thread_local Board board;
+
+    volatile uint8_t* portOf(uint8_t pin) { return pin < 8 ? &PORTD : (pin < 14 ? &PORTB : &PORTC); }
+    volatile uint8_t* ddrOf(uint8_t pin)  { return pin < 8 ? &DDRD  : (pin < 14 ? &DDRB  : &DDRC);  }
+    volatile uint8_t* pinOf(uint8_t pin)  { return pin < 8 ? &PIND  : (pin < 14 ? &PINB  : &PINC);  }
+    uint8_t bitOf(uint8_t pin)            { return static_cast<uint8_t>(1 << (pin < 8 ? pin : (pin < 14 ? pin - 8 : pin - 14))); }
+
+    /// @brief The level a pin reads: driven from outside, else its own output or pull-up
+    uint8_t levelOf(uint8_t pin)
+    {
+        if (pin >= PIN_COUNT) return LOW;
+        if (board.driven[pin] != FLOATING) return static_cast<uint8_t>(board.driven[pin]);
+        return (*portOf(pin) & bitOf(pin)) ? HIGH : LOW;        // Output latch, or the pull-up of an input
+    }
+
+    void refreshPin(uint8_t pin)
+    {
+        if (pin >= 20) return;                                  // A6/A7 are analog only
+        if (levelOf(pin)) *pinOf(pin) |= bitOf(pin);
+        else              *pinOf(pin) &= static_cast<uint8_t>(~bitOf(pin));
+    }
+
+    void callVector(void (*vector)())
+    {
+        SREG = static_cast<uint8_t>(SREG & 0x7F);               // Entry masks, reti unmasks
+        vector();
+        SREG = static_cast<uint8_t>(SREG | 0x80);
+    }
+
+    /// @brief Runs, in priority order, every enabled interrupt that is pending
+    void serviceInterrupts()
+    {
+        bool serviced = true;
+        while (serviced && (SREG & 0x80))
+        {
+            serviced = false;
+            for (PinInterrupt& interrupt : board.pinInterrupts)
+            {
+                if (interrupt.pending && interrupt.handler)
+                {
+                    interrupt.pending = false;
+                    callVector(interrupt.handler);
+                    serviced = true;
+                }
+            }
+            if ((TIFR2 & (1 << OCF2A)) && (TIMSK2 & (1 << OCIE2A)))
+            {
+                TIFR2 = (1 << OCF2A);
+                callVector(TIMER2_COMPA_vect);
+                serviced = true;
+            }
+            if ((EECR & (1 << EERIE)) && !(EECR & (1 << EEPE)))
+            {
+                callVector(EE_READY_vect);                      // Level triggered: runs until the ISR clears EERIE
+                serviced = true;
+            }
+        }
+    }
+
+    /// @brief Timer2 in normal or CTC mode: counts the elapsed cycles, raises OCF2A on each compare
+    void runTimer2(uint64_t elapsed)
+    {
+        uint8_t select = TCCR2B & 0x07;
+        if (!select) return;
+
+        board.timer2Prescale += elapsed;
+        uint64_t counts = board.timer2Prescale / TIMER2_DIVIDERS[select];
+        board.timer2Prescale %= TIMER2_DIVIDERS[select];
+
+        uint16_t top = (TCCR2A & (1 << WGM21)) ? OCR2A + 1u : 256u;
+        while (counts)
+        {
+            uint16_t left = (TCNT2 < top) ? top - TCNT2 : 1;
+            if (counts < left)
+            {
+                TCNT2 = static_cast<uint8_t>(TCNT2 + counts);
+                return;
+            }
+            counts -= left;
+            TCNT2 = 0;
+            TIFR2.raise(1 << OCF2A);
+            serviceInterrupts();
+        }
+    }
+
+    uint64_t cyclesToTimer2Compare()
+    {
+        uint8_t select = TCCR2B & 0x07;
+        if (!select) return 0;
+        uint16_t top = (TCCR2A & (1 << WGM21)) ? OCR2A + 1u : 256u;
+        uint16_t left = (TCNT2 < top) ? top - TCNT2 : 1;
+        return static_cast<uint64_t>(left) * TIMER2_DIVIDERS[select] - board.timer2Prescale;
+    }
+
+    void spendRead()
+    {
+        hal::advanceCycles(hal::READ_COST_CYCLES);
+    }
+}
+
+hal::detail::EepromControl& hal::detail::EepromControl::operator=(uint8_t value)
+{
+    _value = value;
+    if (_value & (1 << EERE))
+    {
+        EEDR = board.eeprom[EEAR & E2END];
+        _value &= static_cast<uint8_t>(~(1 << EERE));
+    }
+    if ((_value & (1 << EEPE)) && (_value & (1 << EEMPE)))
+    {
+        board.eeprom[EEAR & E2END] = EEDR;
+        _value &= static_cast<uint8_t>(~((1 << EEPE) | (1 << EEMPE)));
+    }
+    return *this;
+}
+
+// ---------------------------------------------------------------------------------
+//  Board control (HostBoard.h)
+// ---------------------------------------------------------------------------------
+void hal::reset()
+{
+#define HAL_RESET(name) name = 0;
+    HAL_REGISTERS_8(HAL_RESET)
+    HAL_REGISTERS_16(HAL_RESET)
+#undef HAL_RESET
+#define HAL_RESET_FLAGS(name) name = 0xFF;
+    HAL_FLAG_REGISTERS(HAL_RESET_FLAGS)
+#undef HAL_RESET_FLAGS
+    EECR = 0;
+    UCSR0A = (1 << UDRE0);
+
+    Board fresh;
+    fresh.tx = std::move(board.tx);                             // The tool's sink and source outlive a reset
+    fresh.rxSource = std::move(board.rxSource);
+    board = std::move(fresh);
+}
+
+uint64_t hal::cycles()
+{
+    return board.cycles;
+}
+
+uint64_t hal::nowUs()
+{
+    return board.cycles / CYCLES_PER_US;
+}
+
+void hal::advanceCycles(uint64_t cycles)
+{
+    serviceInterrupts();                                        // Pending since the last sei() / SREG restore
+    board.cycles += cycles;
+    runTimer2(cycles);
+}
+
+void hal::enableInterrupts()
+{
+    SREG = static_cast<uint8_t>(SREG | 0x80);
+    serviceInterrupts();
+}
+
+void hal::sleep()
+{
+    uint64_t wake = cyclesToTimer2Compare();
+    advanceCycles(wake && (TIMSK2 & (1 << OCIE2A)) ? wake : READ_COST_CYCLES);
+}
+
+void hal::attachSpiDevice(uint8_t csnPin, SpiDevice* device)
+{
+    if (csnPin < PIN_COUNT) board.devices[csnPin] = device;
+}
+
+void hal::drivePin(uint8_t pin, uint8_t level)
+{
+    if (pin >= PIN_COUNT) return;
+    uint8_t before = levelOf(pin);
+    board.driven[pin] = level ? HIGH : LOW;
+    refreshPin(pin);
+
+    int8_t interrupt = digitalPinToInterrupt(pin);
+    uint8_t after = levelOf(pin);
+    if (interrupt < 0 || before == after) return;
+
+    PinInterrupt& attached = board.pinInterrupts[interrupt];
+    bool matches = attached.mode == CHANGE || (attached.mode == FALLING && !after) || (attached.mode == RISING && after);
+    if (attached.handler && matches)
+    {
+        attached.pending = true;
+        serviceInterrupts();
+    }
+}
+
+void hal::releasePin(uint8_t pin)
+{
+    if (pin >= PIN_COUNT) return;
+    board.driven[pin] = FLOATING;
+    refreshPin(pin);
+}
+
+void hal::setAnalog(uint8_t pin, uint16_t value)
+{
+    if (pin >= A0 && pin < PIN_COUNT) board.analog[pin] = value;
+}
+
+void hal::serialInput(const char* data, size_t length)
+{
+    board.rx.insert(board.rx.end(), data, data + length);
+}
+
+void hal::setSerialOutput(std::function<void(uint8_t)> sink)
+{
+    board.tx = std::move(sink);
+}
+
+void hal::setSerialSource(std::function<void()> source)
+{
+    board.rxSource = std::move(source);
+}
+
+size_t hal::serialBuffered()
+{
+    return board.rx.size();
+}
+
+uint8_t* hal::eeprom()
+{
+    return board.eeprom;
+}
+
+// ---------------------------------------------------------------------------------
+//  GPIO, external interrupts, ADC
+// ---------------------------------------------------------------------------------
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (pin >= 20) return;
+    uint8_t bit = bitOf(pin);
+    if (mode == OUTPUT)
+    {
+        *ddrOf(pin) |= bit;
+    }
+    else
+    {
+        *ddrOf(pin) &= static_cast<uint8_t>(~bit);
+        if (mode == INPUT_PULLUP) *portOf(pin) |= bit;
+        else                      *portOf(pin) &= static_cast<uint8_t>(~bit);
+    }
+    refreshPin(pin);
+}
+
+/**
+ * @brief Writes the latch; a CSn pin with an attached device selects or releases it on the edge.
+ */
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    if (pin >= 20) return;
+    uint8_t before = levelOf(pin);
+    if (value) *portOf(pin) |= bitOf(pin);
+    else       *portOf(pin) &= static_cast<uint8_t>(~bitOf(pin));
+    refreshPin(pin);
+
+    hal::SpiDevice* device = board.devices[pin];
+    if (!device || before == (value ? HIGH : LOW)) return;
+    if (!value)
+    {
+        board.selected = device;
+        device->select(true);
+    }
+    else
+    {
+        if (board.selected == device) board.selected = nullptr;
+        device->select(false);
+    }
+}
+
+/**
+ * @brief MISO reads the selected device's SO line; any other pin its level.
+ */
+int digitalRead(uint8_t pin)
+{
+    spendRead();
+    if (pin == MISO && board.selected) return board.selected->misoLevel() ? HIGH : LOW;
+    return levelOf(pin);
+}
+
+int analogRead(uint8_t pin)
+{
+    hal::advanceUs(104);                                        // One conversion at clk/128
+    if (pin < 8) pin += A0;
+    return pin < PIN_COUNT ? board.analog[pin] : 0;
+}
+
+void attachInterrupt(uint8_t interrupt, void (*handler)(), int mode)
+{
+    if (interrupt < 2) board.pinInterrupts[interrupt] = PinInterrupt{ handler, mode, false };
+}
+
+void detachInterrupt(uint8_t interrupt)
+{
+    if (interrupt < 2) board.pinInterrupts[interrupt] = PinInterrupt{};
+}
+
+// ---------------------------------------------------------------------------------
+//  Time
+// ---------------------------------------------------------------------------------
+unsigned long millis()
+{
+    spendRead();
+    return static_cast<unsigned long>(static_cast<uint32_t>(hal::nowUs() / 1000));
+}
+
+unsigned long micros()
+{
+    spendRead();
+    return static_cast<unsigned long>(static_cast<uint32_t>(hal::nowUs()));
+}
+
+void delay(unsigned long ms)
+{
+    hal::advanceUs(static_cast<uint64_t>(ms) * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    hal::advanceUs(us);
+}
+
+// ---------------------------------------------------------------------------------
+//  random(): xorshift32 like hal/baremetal, per board
+// ---------------------------------------------------------------------------------
+void randomSeed(unsigned long seed)
+{
+    if (seed != 0) board.randomState = static_cast<uint32_t>(seed);
+}
+
+long random(long howBig)
+{
+    if (howBig == 0) return 0;
+    board.randomState ^= board.randomState << 13;
+    board.randomState ^= board.randomState >> 17;
+    board.randomState ^= board.randomState << 5;
+    return static_cast<long>(board.randomState % static_cast<uint32_t>(howBig));
+}
+
+long random(long howSmall, long howBig)
+{
+    if (howSmall >= howBig) return howSmall;
+    return random(howBig - howSmall) + howSmall;
+}
+
+// ---------------------------------------------------------------------------------
+//  EEPROM (avr/eeprom.h)
+// ---------------------------------------------------------------------------------
+static uint16_t eepromAddress(const void* address)
+{
+    return static_cast<uint16_t>(reinterpret_cast<uintptr_t>(address) & E2END);
+}
+
+void eeprom_read_block(void* destination, const void* source, size_t length)
+{
+    for (size_t i = 0; i < length; ++i) static_cast<uint8_t*>(destination)[i] = board.eeprom[(eepromAddress(source) + i) & E2END];
+}
+
+void eeprom_update_block(const void* source, void* destination, size_t length)
+{
+    for (size_t i = 0; i < length; ++i) board.eeprom[(eepromAddress(destination) + i) & E2END] = static_cast<const uint8_t*>(source)[i];
+}
+
+uint8_t eeprom_read_byte(const uint8_t* address)
+{
+    return board.eeprom[eepromAddress(address)];
+}
+
+uint16_t eeprom_read_word(const uint16_t* address)
+{
+    uint16_t value;
+    eeprom_read_block(&value, address, sizeof(value));
+    return value;
+}
+
+uint32_t eeprom_read_dword(const uint32_t* address)
+{
+    uint32_t value;
+    eeprom_read_block(&value, address, sizeof(value));
+    return value;
+}
+
+void eeprom_write_byte(uint8_t* address, uint8_t value)  { board.eeprom[eepromAddress(address)] = value; }
+void eeprom_update_byte(uint8_t* address, uint8_t value) { board.eeprom[eepromAddress(address)] = value; }
+void eeprom_update_word(uint16_t* address, uint16_t value)  { eeprom_update_block(&value, address, sizeof(value)); }
+void eeprom_update_dword(uint32_t* address, uint32_t value) { eeprom_update_block(&value, address, sizeof(value)); }
+
+// ---------------------------------------------------------------------------------
+//  UART
+// ---------------------------------------------------------------------------------
+void HardwareSerial::begin(unsigned long)
+{
+    UCSR0A = (1 << UDRE0);
+    UCSR0B = (1 << RXEN0) | (1 << TXEN0);
+}
+
+void HardwareSerial::end()
+{
+    UCSR0B = 0;
+}
+
+int HardwareSerial::available()
+{
+    spendRead();
+    if (board.rxSource) board.rxSource();
+    return static_cast<int>(board.rx.size());
+}
+
+int HardwareSerial::peek()
+{
+    return board.rx.empty() ? -1 : board.rx.front();
+}
+
+int HardwareSerial::read()
+{
+    spendRead();
+    if (board.rxSource) board.rxSource();
+    if (board.rx.empty()) return -1;
+    uint8_t byte = board.rx.front();
+    board.rx.pop_front();
+    return byte;
+}
+
+int HardwareSerial::availableForWrite()
+{
+    return 63;                                                  // The core's TX ring, always drained
+}
+
+size_t HardwareSerial::write(uint8_t byte)
+{
+    if (board.tx) board.tx(byte);
+    else          putchar(byte);
+    return 1;
+}
+
+// ---------------------------------------------------------------------------------
+//  Print
+// ---------------------------------------------------------------------------------
+size_t Print::print(const char* text)
+{
+    size_t n = 0;
+    while (*text) n += write(static_cast<uint8_t>(*text++));
+    return n;
+}
+
+size_t Print::print(const __FlashStringHelper* text)
+{
+    return print(reinterpret_cast<const char*>(text));
+}
+
+size_t Print::print(const String& text)
+{
+    return print(text.c_str());
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+    if (base < 2) base = 10;
+    char digits[33];
+    uint8_t i = sizeof(digits);
+    digits[--i] = '\0';
+    do
+    {
+        uint8_t digit = static_cast<uint8_t>(value % base);
+        digits[--i] = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value);
+    return print(&digits[i]);
+}
+
+size_t Print::print(long value, int base)
+{
+    if (base == 10 && value < 0) return write('-') + print(static_cast<unsigned long>(-value), 10);
+    return print(static_cast<unsigned long>(value), base);
+}
+
+size_t Print::print(double value, int digits)
+{
+    char text[40];
+    snprintf(text, sizeof(text), "%.*f", digits, value);
+    return print(text);
+}
+
+// ---------------------------------------------------------------------------------
+//  SPI
+// ---------------------------------------------------------------------------------
+void SPIClass::begin()
+{
+    SPCR = (1 << MSTR) | (1 << SPE);
+}
+
+void SPIClass::end()
+{
+    SPCR &= static_cast<uint8_t>(~(1 << SPE));
+}
+
+void SPIClass::beginTransaction(const SPISettings& settings)
+{
+    board.spiCyclesPerBit = settings._cyclesPerBit;
+}
+
+/**
+ * @brief 8 SPI clocks plus the polling around them, then the selected device's answer.
+ */
+uint8_t SPIClass::transfer(uint8_t data)
+{
+    hal::advanceCycles(8u * board.spiCyclesPerBit + 8);
+    return board.selected ? board.selected->transfer(data) : 0xFF;
+}
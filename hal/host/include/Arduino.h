@@ -0,0 +1,140 @@
+#pragma once
+
+/**
+ * @brief Host HAL: the subset of the Arduino core the firmware uses, compiled natively (tools/).
+ *
+ * Same role as hal/baremetal, for a PC instead of the chip: tools put this directory on the
+ * include path and link the unchanged firmware sources against Hal.cpp.
+ *   - timebase  : a virtual clock (HostBoard.h), Timer2 and its compare ISR emulated on it
+ *   - GPIO      : Nano pin numbers mapped to the PORTB/C/D variables; inputs are driven by the tool
+ *   - UART      : an input queue and an output sink per board
+ *   - SPI       : bytes go to the hal::SpiDevice attached to the selected CSn pin
+ *   - String    : std::string backed, so diagnostics read as on the board
+ * Board state is per thread (HostBoard.h), and so is firmware state marked PER_BOARD.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include "HostBoard.h"
+
+// Firmware statics that are board state (Timebase count, simulation fixtures): one copy per board thread
+#define PER_BOARD thread_local
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+// Nano: D0..D7 = PD0..PD7, D8..D13 = PB0..PB5, A0..A7 (14..21) = PC0..PC5 + ADC6/7
+#define SS   10
+#define MOSI 11
+#define MISO 12
+#define SCK  13
+#define A0   14
+#define A1   15
+#define A2   16
+#define A3   17
+#define A4   18
+#define A5   19
+#define A6   20
+#define A7   21
+#define LED_BUILTIN 13
+
+#define digitalPinToInterrupt(pin) ((pin) == 2 ? 0 : ((pin) == 3 ? 1 : -1))
+
+#define noInterrupts() cli()
+#define interrupts()   sei()
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(PSTR(string_literal)))
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int  digitalRead(uint8_t pin);
+int  analogRead(uint8_t pin);
+
+void attachInterrupt(uint8_t interrupt, void (*handler)(), int mode);
+void detachInterrupt(uint8_t interrupt);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+/**
+ * @brief The core String on std::string: concatenation and number formatting as on the board.
+ */
+class String
+{
+    public:
+
+    String(const char* text = "") : _text(text ? text : "") {}
+    String(const __FlashStringHelper* text) : _text(reinterpret_cast<const char*>(text)) {}
+    String(const std::string& text) : _text(text) {}
+    String(char c) : _text(1, c) {}
+    String(unsigned char value, int base = DEC) : _text(format(value, base)) {}
+    String(int value, int base = DEC) : _text(format(value, base)) {}
+    String(unsigned int value, int base = DEC) : _text(format(value, base)) {}
+    String(long value, int base = DEC) : _text(format(value, base)) {}
+    String(unsigned long value, int base = DEC) : _text(format(value, base)) {}
+
+    String operator+(const String& other) const { return String(_text + other._text); }
+    friend String operator+(const char* left, const String& right) { return String(left) + right; }
+    String& operator+=(const String& other) { _text += other._text; return *this; }
+    bool operator==(const String& other) const { return _text == other._text; }
+
+    unsigned int length() const { return static_cast<unsigned int>(_text.size()); }
+    const char* c_str() const { return _text.c_str(); }
+
+    private:
+
+    static std::string format(long value, int base)
+    {
+        if (base == DEC || value >= 0) return base == DEC ? std::to_string(value) : format(static_cast<unsigned long>(value), base);
+        return format(static_cast<unsigned long>(value), base);
+    }
+
+    static std::string format(unsigned long value, int base)
+    {
+        std::string digits;
+        do
+        {
+            unsigned digit = static_cast<unsigned>(value % base);
+            digits.insert(digits.begin(), static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10));
+            value /= base;
+        } while (value);
+        return digits;
+    }
+
+    static std::string format(int value, int base)           { return format(static_cast<long>(value), base); }
+    static std::string format(unsigned int value, int base)  { return format(static_cast<unsigned long>(value), base); }
+    static std::string format(unsigned char value, int base) { return format(static_cast<unsigned long>(value), base); }
+
+    std::string _text;
+};
+
+#include "HardwareSerial.h"
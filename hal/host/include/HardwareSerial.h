@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+
+class __FlashStringHelper;
+class String;
+
+/**
+ * @brief Text output on top of write(): the part of the core's Print the firmware uses.
+ */
+class Print
+{
+    public:
+
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t byte) = 0;
+    virtual size_t write(const uint8_t* data, size_t length)
+    {
+        for (size_t i = 0; i < length; ++i) write(data[i]);
+        return length;
+    }
+    size_t write(const char* text) { return write(reinterpret_cast<const uint8_t*>(text), strlen(text)); }
+
+    virtual int  availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print(const char* text);
+    size_t print(const __FlashStringHelper* text);
+    size_t print(const String& text);
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(unsigned long value, int base = 10);
+    size_t print(long value, int base = 10);
+    size_t print(unsigned int value, int base = 10)  { return print(static_cast<unsigned long>(value), base); }
+    size_t print(int value, int base = 10)           { return print(static_cast<long>(value), base); }
+    size_t print(unsigned char value, int base = 10) { return print(static_cast<unsigned long>(value), base); }
+    size_t print(double value, int digits = 2);
+
+    size_t println() { return write('\r') + write('\n'); }
+    template<typename T> size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template<typename T> size_t println(const T& value, int base) { size_t n = print(value, base); return n + println(); }
+};
+
+/**
+ * @brief UART0 of the board: reads the queue filled by hal::serialInput(), writes to the
+ *        hal::setSerialOutput() sink. Transmission takes no virtual time and is never full.
+ */
+class HardwareSerial : public Print
+{
+    public:
+
+    void begin(unsigned long baud);
+    void end();
+
+    int  available();
+    int  peek();
+    int  read();
+    int  availableForWrite() override;
+    void flush() override {}
+
+    size_t write(uint8_t byte) override;
+    using Print::write;
+
+    explicit operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
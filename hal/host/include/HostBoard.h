@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <avr/io.h>
+
+/**
+ * @brief What a host tool sees of the board its firmware runs on (hal/host).
+ *
+ * One board per thread: the clock, pins, registers, EEPROM, UART queues and the SPI device are
+ * thread_local, so a tool runs one firmware instance per worker thread without locks. reset()
+ * puts the calling thread's board back to power-on state.
+ *
+ * Time is virtual and only moves when the firmware spends it:
+ *   - delay(), delayMicroseconds(), _delay_loop_n() advance it by the requested time
+ *   - an SPI byte takes its 8 clocks at the transaction's SPI clock
+ *   - every clock read, pin read and UART poll costs READ_COST_CYCLES, as it does on the chip, so
+ *     a loop polling millis(), a pin or the Timebase ends after the time it would take on the board
+ * Timer2 counts against this clock and runs TIMER2_COMPA_vect when its compare interrupt is
+ * enabled (the application Timebase), interrupts masked included: the compare stays pending
+ * until sei(). millis()/micros() read the clock directly (no Timer0 emulation).
+ */
+namespace hal
+{
+    constexpr uint32_t CYCLES_PER_US     = F_CPU / 1000000UL;
+    constexpr uint32_t READ_COST_CYCLES  = 4 * CYCLES_PER_US;   // A core micros() call at 16 MHz
+
+    void     reset();
+
+    uint64_t cycles();                                          // Virtual CPU cycles since reset()
+    uint64_t nowUs();
+    void     advanceCycles(uint64_t cycles);
+    inline void advanceUs(uint64_t us) { advanceCycles(us * CYCLES_PER_US); }
+
+    /**
+     * @brief A chip on the SPI bus, selected by its CSn pin.
+     *
+     * select(true) on CSn falling, select(false) on CSn rising; transfer() gets the MOSI byte of
+     * every SPI.transfer() while selected and returns the MISO byte. misoLevel() is what
+     * digitalRead(MISO) sees while selected (the CC1101 holds SO high until its crystal runs).
+     */
+    class SpiDevice
+    {
+        public:
+
+        virtual ~SpiDevice() = default;
+        virtual void    select(bool selected) = 0;
+        virtual uint8_t transfer(uint8_t mosi) = 0;
+        virtual uint8_t misoLevel() { return 0; }
+    };
+
+    void attachSpiDevice(uint8_t csnPin, SpiDevice* device);    // nullptr detaches
+
+    /// @brief Drives an input pin from outside (a button, a radio output); runs the attached pin ISR on a matching edge
+    void drivePin(uint8_t pin, uint8_t level);
+    void releasePin(uint8_t pin);                               // Back to the pull-up (or LOW without)
+    void setAnalog(uint8_t pin, uint16_t value);                // What analogRead() returns
+
+    /// @brief UART: bytes the firmware will read, and a sink for what it prints (stdout by default)
+    void serialInput(const char* data, size_t length);
+    void setSerialOutput(std::function<void(uint8_t)> sink);
+    /// @brief Called on every UART poll (available(), read()) after its read cost: a tool hands
+    ///        over with serialInput() what has arrived by nowUs() (a paced link, a pty)
+    void setSerialSource(std::function<void()> source);
+    size_t serialBuffered();                                    // Bytes serialInput() queued, not read yet
+
+    uint8_t* eeprom();                                          // E2END + 1 bytes, erased (0xFF) by reset()
+}
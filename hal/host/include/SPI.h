@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdint.h>
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+/**
+ * @brief Clock, bit order and mode of a transaction. Only the clock matters on the host: it sets
+ *        the virtual time a byte takes (rounded down to F_CPU / 2^n like the chip).
+ */
+class SPISettings
+{
+    public:
+
+    constexpr SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) :
+    _cyclesPerBit(cyclesPerBit(clock)), _bitOrder(bitOrder), _dataMode(dataMode)
+    {
+    }
+
+    constexpr SPISettings() : SPISettings(4000000, MSBFIRST, SPI_MODE0) {}
+
+    private:
+
+    static constexpr uint8_t cyclesPerBit(uint32_t clock)
+    {
+        uint8_t divider = 2;
+        while (divider < 128 && F_CPU / divider > clock) divider *= 2;
+        return divider;
+    }
+
+    uint8_t _cyclesPerBit;
+    uint8_t _bitOrder;
+    uint8_t _dataMode;
+
+    friend class SPIClass;
+};
+
+/**
+ * @brief SPI master: each byte goes to the hal::SpiDevice whose CSn pin is low (HostBoard.h),
+ *        0xFF comes back when none is selected.
+ */
+class SPIClass
+{
+    public:
+
+    static void begin();
+    static void end();
+    static void beginTransaction(const SPISettings& settings);
+    static void endTransaction() {}
+    static uint8_t transfer(uint8_t data);
+};
+
+extern SPIClass SPI;
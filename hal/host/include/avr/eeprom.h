@@ -0,0 +1,21 @@
+#pragma once
+
+// avr-libc EEPROM calls on the board's emulated 1 KiB (HostBoard.h: hal::eeprom())
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define EEMEM
+
+uint8_t  eeprom_read_byte(const uint8_t* address);
+uint16_t eeprom_read_word(const uint16_t* address);
+uint32_t eeprom_read_dword(const uint32_t* address);
+void     eeprom_read_block(void* destination, const void* source, size_t length);
+void     eeprom_write_byte(uint8_t* address, uint8_t value);
+void     eeprom_update_byte(uint8_t* address, uint8_t value);
+void     eeprom_update_word(uint16_t* address, uint16_t value);
+void     eeprom_update_dword(uint32_t* address, uint32_t value);
+void     eeprom_update_block(const void* source, void* destination, size_t length);
+
+#define eeprom_is_ready() (!(EECR & (1 << EEPE)))
+#define eeprom_busy_wait() do {} while (!eeprom_is_ready())
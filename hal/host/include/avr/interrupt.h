@@ -0,0 +1,17 @@
+#pragma once
+
+#include <avr/io.h>
+
+namespace hal
+{
+    void enableInterrupts();                                    // sei(): also runs what became pending while masked
+}
+
+// A vector is a plain function; Hal.cpp calls the ones it emulates (weak defaults there)
+#define ISR(vector, ...) extern "C" void vector(void)
+#define ISR_BLOCK
+#define ISR_NOBLOCK
+#define ISR_NAKED
+
+#define cli() (SREG = static_cast<uint8_t>(SREG & 0x7F))
+#define sei() (hal::enableInterrupts())
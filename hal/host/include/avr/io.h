@@ -0,0 +1,204 @@
+#pragma once
+
+/**
+ * @brief ATmega328P registers for the host build: plain variables, one set per thread.
+ *
+ * Each host thread is one board (hal/host/include/HostBoard.h): the registers, like the rest of
+ * the board state, are thread_local, so tools can run several firmware instances side by side.
+ * Most registers are storage only. Those whose side effects the firmware relies on get them:
+ *   - interrupt flag registers (TIFRn, EIFR, PCIFR) are cleared by writing a one, as on the chip
+ *   - EECR performs the EEPROM read (EERE) or write (EEPE) on the emulated EEPROM at once
+ * Timer2 counts (TCNT2, OCF2A, the compare ISR) as the virtual clock moves (Hal.cpp).
+ */
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+namespace hal
+{
+    namespace detail
+    {
+        /// @brief Write-one-to-clear flag register
+        class FlagRegister
+        {
+            public:
+
+            operator uint8_t() const { return _value; }
+            FlagRegister& operator=(uint8_t clear) { _value &= static_cast<uint8_t>(~clear); return *this; }
+            void raise(uint8_t flags) { _value |= flags; }
+
+            private:
+
+            uint8_t _value;
+        };
+
+        /// @brief EECR: a read strobe loads EEDR, a write strobe stores it, both complete at once
+        class EepromControl
+        {
+            public:
+
+            operator uint8_t() const { return _value; }
+            EepromControl& operator=(uint8_t value);
+            EepromControl& operator|=(uint8_t bits) { return *this = static_cast<uint8_t>(_value | bits); }
+            EepromControl& operator&=(uint8_t bits) { return *this = static_cast<uint8_t>(_value & bits); }
+
+            private:
+
+            uint8_t _value;
+        };
+    }
+}
+
+// Every register the firmware touches; Hal.cpp defines them from the same lists
+#define HAL_REGISTERS_8(X)                                                                  \
+    X(DDRB)   X(PORTB)  X(PINB)   X(DDRC)   X(PORTC)  X(PINC)   X(DDRD)   X(PORTD)  X(PIND) \
+    X(TCCR0A) X(TCCR0B) X(TIMSK0) X(TCNT0)  X(OCR0A)                                        \
+    X(TCCR1A) X(TCCR1B) X(TCCR1C) X(TIMSK1)                                                 \
+    X(TCCR2A) X(TCCR2B) X(TIMSK2) X(TCNT2)  X(OCR2A)  X(OCR2B)                              \
+    X(ADMUX)  X(ADCSRA) X(ADCSRB) X(ADCH)   X(ADCL)   X(DIDR0)                              \
+    X(EEDR)   X(SREG)   X(MCUSR)  X(MCUCR)  X(SMCR)   X(PRR)                                \
+    X(EICRA)  X(EIMSK)  X(PCICR)  X(PCMSK0) X(PCMSK1) X(PCMSK2)                             \
+    X(UCSR0A) X(UCSR0B) X(UCSR0C) X(UBRR0H) X(UBRR0L) X(UDR0)                               \
+    X(SPCR)   X(SPSR)   X(SPDR)   X(GPIOR0) X(CLKPR)
+
+#define HAL_REGISTERS_16(X) X(TCNT1) X(OCR1A) X(OCR1B) X(ICR1) X(ADC) X(EEAR) X(UBRR0)
+#define HAL_FLAG_REGISTERS(X) X(TIFR0) X(TIFR1) X(TIFR2) X(EIFR) X(PCIFR)
+
+#define HAL_DECLARE_8(name)    extern thread_local volatile uint8_t name;
+#define HAL_DECLARE_16(name)   extern thread_local volatile uint16_t name;
+#define HAL_DECLARE_FLAGS(name) extern thread_local hal::detail::FlagRegister name;
+HAL_REGISTERS_8(HAL_DECLARE_8)
+HAL_REGISTERS_16(HAL_DECLARE_16)
+HAL_FLAG_REGISTERS(HAL_DECLARE_FLAGS)
+#undef HAL_DECLARE_8
+#undef HAL_DECLARE_16
+#undef HAL_DECLARE_FLAGS
+
+extern thread_local hal::detail::EepromControl EECR;
+
+#define _BV(bit) (1u << (bit))
+
+#define E2END   0x3FF
+#define RAMEND  0x8FF
+
+// Ports
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PC0 0
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+#define PORTB0 0
+
+// Timer0
+#define WGM01  1
+#define CS00   0
+#define CS01   1
+#define CS02   2
+#define TOIE0  0
+#define OCIE0A 1
+#define OCF0A  1
+
+// Timer1
+#define WGM12  3
+#define WGM13  4
+#define CS10   0
+#define CS11   1
+#define CS12   2
+#define ICES1  6
+#define ICNC1  7
+#define TOIE1  0
+#define OCIE1A 1
+#define OCIE1B 2
+#define ICIE1  5
+#define TOV1   0
+#define OCF1A  1
+#define OCF1B  2
+#define ICF1   5
+
+// Timer2
+#define WGM20  0
+#define WGM21  1
+#define CS20   0
+#define CS21   1
+#define CS22   2
+#define OCIE2A 1
+#define OCF2A  1
+
+// ADC
+#define REFS0 6
+#define REFS1 7
+#define ADLAR 5
+#define ADEN  7
+#define ADSC  6
+#define ADATE 5
+#define ADIF  4
+#define ADIE  3
+#define ADPS0 0
+#define ADPS1 1
+#define ADPS2 2
+#define ADTS0 0
+#define ADTS1 1
+#define ADTS2 2
+
+// EEPROM
+#define EERE  0
+#define EEPE  1
+#define EEMPE 2
+#define EERIE 3
+
+// External and pin change interrupts
+#define ISC00 0
+#define ISC01 1
+#define ISC10 2
+#define ISC11 3
+#define INT0  0
+#define INT1  1
+#define INTF0 0
+#define INTF1 1
+#define PCIE0 0
+#define PCIE1 1
+#define PCIE2 2
+
+// USART0
+#define RXC0   7
+#define TXC0   6
+#define UDRE0  5
+#define U2X0   1
+#define RXCIE0 7
+#define TXCIE0 6
+#define UDRIE0 5
+#define RXEN0  4
+#define TXEN0  3
+#define UCSZ00 1
+#define UCSZ01 2
+
+// SPI
+#define SPIE  7
+#define SPE   6
+#define DORD  5
+#define MSTR  4
+#define SPIF  7
+#define SPI2X 0
+
+// Sleep, reset flags
+#define SE    0
+#define SM0   1
+#define SM1   2
+#define PORF  0
+#define EXTRF 1
+#define BORF  2
+#define WDRF  3
+
+// Status register
+#define SREG_I 7
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <avr/io.h>
+
+#define SLEEP_MODE_IDLE       0
+#define SLEEP_MODE_ADC        1
+#define SLEEP_MODE_PWR_DOWN   2
+#define SLEEP_MODE_PWR_SAVE   3
+
+namespace hal
+{
+    void sleep();                                               // Idles until the next emulated interrupt
+}
+
+inline void set_sleep_mode(int) {}
+inline void sleep_enable() {}
+inline void sleep_disable() {}
+inline void sleep_cpu() { hal::sleep(); }
+inline void sleep_mode() { hal::sleep(); }
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <avr/interrupt.h>
+
+namespace hal
+{
+    namespace detail
+    {
+        struct AtomicRestore
+        {
+            uint8_t sreg;
+            AtomicRestore() : sreg(SREG) { cli(); }
+            ~AtomicRestore() { if (sreg & 0x80) sei(); }
+        };
+
+        struct AtomicForceOn
+        {
+            AtomicForceOn() { cli(); }
+            ~AtomicForceOn() { sei(); }
+        };
+    }
+}
+
+#define ATOMIC_RESTORESTATE hal::detail::AtomicRestore
+#define ATOMIC_FORCEON      hal::detail::AtomicForceOn
+#define ATOMIC_BLOCK(type)  for (type _atomic_guard, *_atomic_once = &_atomic_guard; _atomic_once; _atomic_once = nullptr)
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace hal
+{
+    void advanceCycles(uint64_t cycles);
+}
+
+inline void _delay_loop_1(uint8_t count)  { hal::advanceCycles(3ULL * (count ? count : 256)); }
+inline void _delay_loop_2(uint16_t count) { hal::advanceCycles(4ULL * (count ? count : 65536)); }
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+#include "utils/RingBuffer.h"
+#include "Delay/Timebase.h"
+
+/// @brief Application states. Ready is a superstate (never current): it groups the states a press can start from.
+enum class AppState : uint8_t
+{
+    Boot,
+    Idle,
+    Armed,                                                      // Button edge seen, debouncer armed
+    Debouncing,                                                 // Debouncer sampling
+    Transmitting,
+    Recovering,                                                 // Radio re-init after a failed transmission
+    Sleeping,                                                   // CPU idle sleep between interrupts
+    Learning,                                                   // Field program upload in progress
+    Ready                                                       // Superstate of Idle, Armed, Debouncing, Sleeping
+};
+
+enum class AppEvent : uint8_t
+{
+    BootDone,
+    Edge,                                                       // Raw button edge (ISR)
+    DebounceRunning,
+    PressConfirmed,                                             // Debouncer callback
+    TxDone,
+    TxFailed,
+    RecoveryDone,
+    Timeout,                                                    // State timeout, meaning depends on the state
+    LearnStart,
+    LearnDone
+};
+
+/// @brief Transition actions, bound to functions by the application
+enum class AppAction : uint8_t
+{
+    None,
+    Transmit,                                                   // Must post TxDone or TxFailed (hold-to-transmit: later, from the loop)
+    Recover,                                                    // Posts RecoveryDone once the radio is back
+    Prepare,                                                    // Debouncing started: speculative transmit preparation
+    Discard                                                     // Press rejected: undo Prepare
+};
+
+constexpr uint8_t APP_LEAF_STATE_COUNT = static_cast<uint8_t>(AppState::Ready);
+constexpr uint8_t APP_STATE_COUNT      = APP_LEAF_STATE_COUNT + 1;
+constexpr uint8_t APP_EVENT_COUNT      = static_cast<uint8_t>(AppEvent::LearnDone) + 1;
+constexpr uint8_t APP_ACTION_COUNT     = static_cast<uint8_t>(AppAction::Discard) + 1;
+
+static_assert(APP_EVENT_COUNT <= 16, "Pending events are a 16-bit mask");
+static_assert(APP_EVENT_QUEUE_SIZE >= APP_EVENT_COUNT, "Coalesced events must always fit the queue");
+
+/// @brief One traced transition
+struct AppTrace
+{
+    AppState from;
+    AppState to;
+    AppEvent event;
+    uint32_t queuedUs;                                          // post() -> state entered
+    uint32_t actionUs;                                          // Transition action run time (Timebase resolution, stalls while interrupts are off)
+};
+
+/**
+ * @brief Table-driven application state machine with an event queue.
+ *
+ * The transitions are written as hierarchical rules (a rule on Ready applies to all its children
+ * unless a child overrides it) and flattened at compile time into a dense
+ * [state][event] -> {next, action} table in PROGMEM, so dispatch is one table read whatever the
+ * nesting. Events nobody handles in the current state are dropped and counted.
+ *
+ * Events are queued with their post time and dispatched in order by poll(). post() is ISR safe
+ * and coalesces: an event already waiting in the queue is not queued twice (a bouncing contact
+ * posts one Edge, not twenty), which also bounds the queue to one slot per event.
+ *
+ * Every transition that changes state is reported to the trace hook with the event latency
+ * (post -> state entered) and the action run time; the worst latency per state is kept.
+ *
+ * Times come from the Timebase (TIMEBASE_TICK_US resolution).
+ *
+ * The debounce window is used speculatively: entering Debouncing runs Prepare (the transmission is
+ * made ready up to the carrier), every way out of Debouncing but a confirmed press runs Discard.
+ *
+ * Per-state timeouts post Timeout after the state has been held long enough:
+ *   Idle (APP_IDLE_SLEEP_MS), Armed / Debouncing (APP_DEBOUNCE_TIMEOUT_MS), Recovering (APP_RECOVERY_RETRY_MS)
+ *
+ * @example
+ *   AppStateMachine app;
+ *   app.bind(AppAction::Transmit, transmitOpenDoor);
+ *   app.post(AppEvent::BootDone);
+ *   void loop() { app.poll(); }
+ */
+class AppStateMachine
+{
+    public:
+
+    using Action    = void (*)();
+    using TraceHook = void (*)(const AppTrace& trace);
+
+    AppStateMachine();
+
+    void bind(AppAction action, Action function);
+    void setTraceHook(TraceHook hook);
+
+    bool post(AppEvent event);                                  // ISR safe; false if already pending
+    void poll();                                                // State timeout, then dispatch the queued events
+
+    AppState state() const;
+    uint32_t worstLatencyUs(AppState state) const;
+    uint8_t  unhandledEvents() const;
+
+    private:
+
+    struct QueuedEvent
+    {
+        AppEvent event;
+        uint32_t postedUs;
+    };
+
+    void dispatch(const QueuedEvent& queued);
+    bool timeoutDue() const;
+
+    RingBuffer<QueuedEvent, APP_EVENT_QUEUE_SIZE> _queue;
+    volatile uint16_t _pending;                                 // Bit per event waiting in the queue
+    volatile AppState _state;
+    uint32_t  _enteredTicks;                                    // Timebase::ticks() when the state was entered
+    Action    _actions[APP_ACTION_COUNT];
+    TraceHook _trace;
+    uint32_t  _worstLatencyUs[APP_LEAF_STATE_COUNT];
+    uint8_t   _unhandled;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Storage/ProgramStore.h"
+#include "Transciever/CC1101_Transceiver.h"
+#include "Waveform/WaveformPlayer.h"
+
+/**
+ * @brief Line-based serial console to upload, list, play and erase field-loaded waveform programs.
+ *
+ *   > LOAD <slot> <length> <crc16 hex>       CRC as ProgramStore::crc16 over the program bytes
+ *   < READY
+ *   > 0A0001E80803...                         hex lines, up to MAX_HEX_BYTES_PER_LINE bytes each,
+ *   > ...                                     until <length> bytes have been received
+ *   < OK <slot> | ERR <reason>
+ *   > PLAY <slot>                             transmits the cached program once
+ *   > LIST                                    one "SLOT <n> <length>" line per slot (0 = empty)
+ *   > ERASE <slot>
+ *
+ * Lines end with '\n' ('\r' is ignored). poll() never blocks: it consumes what is in the UART
+ * buffer, so a host should pace hex lines (or wait for the echoed "." after each one).
+ */
+class ProgramConsole
+{
+    public:
+
+    ProgramConsole(HardwareSerial& serial, ProgramStore& store, Transceiver& transceiver, WaveformPlayer& player);
+
+    void poll();
+    bool uploading() const;                                     // Between LOAD and OK / ERR
+
+    static constexpr uint8_t LINE_LENGTH = 40;
+    static constexpr uint8_t MAX_HEX_BYTES_PER_LINE = 16;
+
+    private:
+
+    void handleLine();
+    void handleCommand(char* command);
+    void handleHexLine();
+    void play(uint8_t slot);
+    void reply(const __FlashStringHelper* text, int16_t value = -1);
+
+    HardwareSerial& _serial;
+    ProgramStore&   _store;
+    Transceiver&    _transceiver;
+    WaveformPlayer& _player;
+
+    char     _line[LINE_LENGTH + 1];
+    uint8_t  _lineLength;
+    bool     _lineOverflow;
+
+    // Upload in progress (_upload == nullptr when idle)
+    uint8_t* _upload;
+    uint8_t  _uploadSlot;
+    uint8_t  _uploadLength;
+    uint8_t  _uploadReceived;
+    uint16_t _uploadCrc;
+};
@@ -2,5 +2,10 @@
 
 #include<stdint.h>
 
-// Remote code for the garage door of Mon Home
-extern const uint8_t REMOTE1_OPEN_DOOR_CODE[8] ;
\ No newline at end of file
+// Remote code for the garage door of Mon Home (constexpr so waveform programs can be compiled from it)
+inline constexpr uint8_t REMOTE1_OPEN_DOOR_CODE[8] = {1, 1, 0, 1, 1, 0, 0, 0};
+
+// Rolling-code identity of this fob (paired receivers only), from the git-ignored App/RemoteSecrets.h
+extern const uint32_t REMOTE1_ROLLING_SERIAL;
+extern const uint32_t REMOTE1_ROLLING_KEY[4];
+constexpr uint8_t REMOTE1_ROLLING_BUTTON = 0x1;
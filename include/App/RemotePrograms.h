@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+#include <array>
+#include "App/RemoteCodes.h"
+#include "Waveform/WaveformCompiler.h"
+
+// Waveform programs of the remote codes, compiled at build time and stored in flash.
+// One program per code: a full SC41344 burst is a few dozen bytes instead of a rendered pulse table.
+namespace RemotePrograms
+{
+    constexpr Waveform::Program OPEN_DOOR = Waveform::compile<CodeFamilies::SC41344_8Bit>(REMOTE1_OPEN_DOOR_CODE);
+    static_assert(!OPEN_DOOR.overflow, "REMOTE1 open-door program does not fit");
+    static_assert(Waveform::validate<RAMStoragePolicy>(OPEN_DOOR.bytes.data(), OPEN_DOOR.length) == Waveform::Verdict::Ok,
+                  "REMOTE1 open-door program must be playable unchecked");
+
+    // Hold-to-transmit (WaveformStreamer): the lead-in word, then word-gap words while the button is held
+    inline constexpr const Waveform::ProtocolDescriptor& OPEN_DOOR_LAYOUT = Waveform::Descriptor<CodeFamilies::SC41344_8Bit>::value;
+    constexpr Waveform::Program OPEN_DOOR_FIRST_WORD = Waveform::compileWord<CodeFamilies::SC41344_8Bit>(REMOTE1_OPEN_DOOR_CODE, OPEN_DOOR_LAYOUT.leadInUnits);
+    constexpr Waveform::Program OPEN_DOOR_NEXT_WORD  = Waveform::compileWord<CodeFamilies::SC41344_8Bit>(REMOTE1_OPEN_DOOR_CODE, OPEN_DOOR_LAYOUT.wordGapUnits);
+    static_assert(!OPEN_DOOR_FIRST_WORD.overflow && !OPEN_DOOR_NEXT_WORD.overflow, "REMOTE1 open-door word programs do not fit");
+    static_assert(Waveform::validate<RAMStoragePolicy>(OPEN_DOOR_FIRST_WORD.bytes.data(), OPEN_DOOR_FIRST_WORD.length) == Waveform::Verdict::Ok &&
+                  Waveform::validate<RAMStoragePolicy>(OPEN_DOOR_NEXT_WORD.bytes.data(), OPEN_DOOR_NEXT_WORD.length) == Waveform::Verdict::Ok,
+                  "REMOTE1 open-door word programs must be playable unchecked");
+    static_assert(Waveform::run(OPEN_DOOR_FIRST_WORD).durationUs + OPEN_DOOR_LAYOUT.wordRepeats * Waveform::run(OPEN_DOOR_NEXT_WORD).durationUs ==
+                  Waveform::run(OPEN_DOOR).durationUs, "A stream of 1 + wordRepeats words replays the fixed burst");
+}
+
+extern const std::array<uint8_t, RemotePrograms::OPEN_DOOR.length> REMOTE1_OPEN_DOOR_PROGRAM;     // PROGMEM
+extern const std::array<uint8_t, RemotePrograms::OPEN_DOOR_FIRST_WORD.length> REMOTE1_OPEN_DOOR_FIRST_WORD;    // PROGMEM
+extern const std::array<uint8_t, RemotePrograms::OPEN_DOOR_NEXT_WORD.length> REMOTE1_OPEN_DOOR_NEXT_WORD;      // PROGMEM
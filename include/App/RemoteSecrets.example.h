@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdint.h>
+
+// Template of include/App/RemoteSecrets.h, the per-unit rolling-code identity. That file is
+// git-ignored: copy this one next to it and set the serial and key this fob is paired with.
+// The key must never be committed; a zero key does not build (App/RemoteCodes.cpp). Draw it
+// from a random source per unit (head -c 16 /dev/urandom | xxd -p). A key that was ever committed,
+// pasted or shared is burned: write a new one here, flash the fob and re-pair its receiver.
+constexpr uint32_t REMOTE1_ROLLING_SERIAL_VALUE = 0x0000000;                    // 28 bits, sent in clear
+constexpr uint32_t REMOTE1_ROLLING_KEY_VALUE[4] = { 0, 0, 0, 0 };               // 128-bit XTEA key shared with the receiver
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+#include "Crypto/XTEA.h"
+#include "Storage/CounterJournal.h"
+#include "Debugging/Logging.h"
+
+/**
+ * @brief Builds rolling-code words for our paired receivers.
+ *
+ * Word layout (ROLLING_CODE_WORD_BITS, MSB first, one uint8_t '0'/'1' per bit like the fixed codes):
+ *     [ XTEA_k(counter : 32 | serial : 28 | button : 4) : 64 ][ serial : 28 ][ button : 4 ]
+ * The clear serial lets the receiver pick the key/counter record before decrypting; the
+ * decrypted serial and button must match the clear ones, and the counter must move forward.
+ *
+ * The expensive part (EEPROM commit ~17 ms + encryption, estimated at ~0.8 ms from the 32 XTEA
+ * cycles of 32-bit shifts and adds on the 8-bit core, not measured: LOG_VERBOSE builds print
+ * both times) is done by prepare() while the fob is idle, so a confirmed press only has to
+ * stream bits() and call consume(). The commit is programmed in the background by EepromWriter:
+ * the word only counts as prepared once it is in.
+ */
+class RollingCodeGenerator
+{
+    public:
+
+    /**
+     * @param journal - Persistent counter storage
+     * @param serial - 28-bit transmitter serial number
+     * @param key - 128-bit XTEA key shared with the paired receiver
+     */
+    RollingCodeGenerator(CounterJournal& journal, uint32_t serial, const uint32_t (&key)[4]);
+
+    bool prepare(uint8_t button);                                       // Commits the next counter and encrypts the word for that button
+    bool isPrepared() const;                                            // True while a committed word is waiting to be sent
+    const uint8_t (&bits() const)[ROLLING_CODE_WORD_BITS];              // Word ready to be streamed
+    void consume();                                                     // Marks the prepared word as sent
+
+    private:
+
+    // Writes `count` bits of `value` MSB first starting at _bits[offset]
+    void unpackBits(uint32_t value, uint8_t count, uint8_t offset);
+
+    CounterJournal&  _journal;
+    uint32_t         _serial;
+    const uint32_t (&_key)[4];
+    uint8_t          _bits[ROLLING_CODE_WORD_BITS];
+    bool             _prepared;
+};
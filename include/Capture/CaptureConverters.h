@@ -0,0 +1,293 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Capture/EdgeCapture.h"
+
+/**
+ * @brief Text trace -> edge capture converters, fed one character at a time.
+ *
+ * Both keep a few dozen bytes of state whatever the input size: a host tool pipes a logic
+ * analyzer export through feed() and streams the capture out through a Capture::Writer. Input
+ * gives level transitions; an edge is written when the level changes, and finish() closes the
+ * last level at the last timestamp seen.
+ *
+ *   - CsvConverter : "<time_s>,<level>[,...]" rows (sigrok / Saleae exports), time in decimal
+ *                    seconds (us resolution, may be negative), level 0 / 1, first channel only.
+ *                    Rows that do not parse (the header line) are skipped.
+ *   - VcdConverter : Value Change Dump, first 1-bit $var, $timescale fs .. s. x / z read as 0,
+ *                    vector changes are skipped.
+ *
+ * @example
+ *   Capture::Writer<FileSink, 4096> writer(file);
+ *   Capture::VcdConverter<decltype(writer)> vcd(writer);
+ *   for (int c; (c = getchar()) != EOF; ) vcd.feed(static_cast<char>(c));
+ *   vcd.finish();
+ *   writer.finish();
+ */
+namespace Capture
+{
+    namespace detail
+    {
+        /// @brief Transitions (absolute time, level) -> edges
+        template<typename Writer>
+        class Transitions
+        {
+            public:
+
+            constexpr explicit Transitions(Writer& writer):
+            _writer(writer), _startUs(0), _lastUs(0), _level(0), _open(false)
+            {}
+
+            constexpr void at(int64_t us, uint8_t level)
+            {
+                level = level ? 1 : 0;
+                if (_open && us < _lastUs) return;              // Time going backwards: row dropped
+                if (!_open)
+                {
+                    _open = true;
+                    _startUs = us;
+                    _level = level;
+                }
+                else if (level != _level)
+                {
+                    emit(us);
+                    _startUs = us;
+                    _level = level;
+                }
+                _lastUs = us;
+            }
+
+            /// @brief A timestamp with no change (VCD "#t"): the level holds at least until us
+            constexpr void until(int64_t us)
+            {
+                if (_open && us > _lastUs) _lastUs = us;
+            }
+
+            constexpr void finish()
+            {
+                if (_open) emit(_lastUs);
+                _open = false;
+            }
+
+            private:
+
+            constexpr void emit(int64_t endUs)
+            {
+                uint64_t durationUs = static_cast<uint64_t>(endUs - _startUs);
+                while (durationUs > MAX_EDGE_US)
+                {
+                    _writer.add(_level, MAX_EDGE_US);
+                    durationUs -= MAX_EDGE_US;
+                }
+                _writer.add(_level, static_cast<uint32_t>(durationUs));
+            }
+
+            Writer& _writer;
+            int64_t _startUs;
+            int64_t _lastUs;
+            uint8_t _level;
+            bool    _open;
+        };
+
+        constexpr bool isDigit(char c) { return c >= '0' && c <= '9'; }
+        constexpr bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+    }
+
+    template<typename Writer>
+    class CsvConverter
+    {
+        public:
+
+        constexpr explicit CsvConverter(Writer& writer):
+        _transitions(writer), _field(0), _negative(false), _digits(0), _fraction(0), _inFraction(false),
+        _units(0), _level(0), _levelDigits(0), _bad(false)
+        {}
+
+        constexpr void feed(char c)
+        {
+            if (c == '\n') { endRow(); return; }
+            if (c == '\r' || _bad) return;
+            if (c == ',') { ++_field; return; }
+
+            if (_field == 0)
+            {
+                if (c == ' ' && !_digits) return;
+                if (c == '-' && !_digits && !_negative) { _negative = true; return; }
+                if (c == '.' && !_inFraction) { _inFraction = true; return; }
+                if (!detail::isDigit(c)) { _bad = true; return; }
+                ++_digits;
+                if (!_inFraction)          _units = _units * 10 + (c - '0') * 1000000LL;                           // Whole seconds, in us
+                else if (_fraction < 6)    _units += (c - '0') * FRACTION_SCALE[_fraction++];
+            }
+            else if (_field == 1)
+            {
+                if (c == ' ') return;
+                if (c != '0' && c != '1') { _bad = true; return; }
+                _level = c - '0';
+                ++_levelDigits;
+            }
+        }
+
+        constexpr void finish()
+        {
+            endRow();
+            _transitions.finish();
+        }
+
+        private:
+
+        static constexpr int32_t FRACTION_SCALE[6] = { 100000, 10000, 1000, 100, 10, 1 };
+
+        constexpr void endRow()
+        {
+            if (!_bad && _digits && _field >= 1 && _levelDigits == 1) _transitions.at(_negative ? -_units : _units, _level);
+            _field = 0;
+            _negative = false;
+            _digits = 0;
+            _fraction = 0;
+            _inFraction = false;
+            _units = 0;
+            _levelDigits = 0;
+            _bad = false;
+        }
+
+        detail::Transitions<Writer> _transitions;
+        uint8_t _field;
+        bool    _negative;
+        uint8_t _digits;
+        uint8_t _fraction;
+        bool    _inFraction;
+        int64_t _units;                                         // us
+        uint8_t _level;
+        uint8_t _levelDigits;
+        bool    _bad;
+    };
+
+    template<typename Writer>
+    class VcdConverter
+    {
+        public:
+
+        static constexpr uint8_t MAX_TOKEN = 24;
+        static constexpr uint8_t MAX_ID    = 8;
+
+        constexpr explicit VcdConverter(Writer& writer):
+        _transitions(writer), _token{}, _length(0), _section(Section::None), _varToken(0), _varWide(false),
+        _id{}, _idLength(0), _scaleNumber(1), _multiplier(1), _divider(1), _timeUs(0), _skipNext(false)
+        {}
+
+        constexpr void feed(char c)
+        {
+            if (detail::isSpace(c))
+            {
+                if (_length) token();
+                _length = 0;
+                return;
+            }
+            if (_length < MAX_TOKEN) _token[_length++] = c;
+        }
+
+        constexpr void finish()
+        {
+            if (_length) token();
+            _length = 0;
+            _transitions.finish();
+        }
+
+        private:
+
+        enum class Section : uint8_t { None, Skip, Timescale, Var };
+
+        constexpr bool is(const char* keyword) const
+        {
+            uint8_t i = 0;
+            for (; keyword[i]; ++i) if (i >= _length || _token[i] != keyword[i]) return false;
+            return i == _length;
+        }
+
+        constexpr void token()
+        {
+            if (is("$end")) { _section = Section::None; return; }
+
+            switch (_section)
+            {
+                case Section::Skip:      return;
+                case Section::Timescale: timescale(); return;
+                case Section::Var:       var(); return;
+                case Section::None:      break;
+            }
+
+            if (is("$timescale")) { _section = Section::Timescale; _scaleNumber = 1; return; }
+            if (is("$var"))       { _section = Section::Var; _varToken = 0; _varWide = false; return; }
+            if (is("$comment") || is("$date") || is("$version") || is("$scope")) { _section = Section::Skip; return; }
+            if (_token[0] == '$') return;                       // $dumpvars, $enddefinitions, ...: their values are changes like any other
+
+            if (_skipNext) { _skipNext = false; return; }
+            if (_token[0] == '#') { time(); return; }
+            if (_token[0] == 'b' || _token[0] == 'B' || _token[0] == 'r' || _token[0] == 'R') { _skipNext = true; return; }   // Vector: value then id
+
+            char value = _token[0];
+            if (value != '0' && value != '1' && value != 'x' && value != 'X' && value != 'z' && value != 'Z') return;
+            if (_idLength == 0 || _length - 1 != _idLength) return;
+            for (uint8_t i = 0; i < _idLength; ++i) if (_token[1 + i] != _id[i]) return;
+            _transitions.at(static_cast<int64_t>(_timeUs), value == '1');
+        }
+
+        // "$timescale 10ns $end" or "$timescale 10 ns $end"
+        constexpr void timescale()
+        {
+            uint8_t i = 0;
+            if (detail::isDigit(_token[0]))
+            {
+                _scaleNumber = 0;
+                for (; i < _length && detail::isDigit(_token[i]); ++i) _scaleNumber = _scaleNumber * 10 + (_token[i] - '0');
+            }
+            if (i == _length) return;
+
+            char unit = _token[i];
+            uint64_t perUnit = unit == 'f' ? 1000000000ULL : unit == 'p' ? 1000000ULL : unit == 'n' ? 1000ULL : 1ULL;     // Units per us
+            uint64_t usPer   = unit == 'm' ? 1000ULL : unit == 's' ? 1000000ULL : 1ULL;                                 // us per unit
+            _multiplier = _scaleNumber * usPer;
+            _divider    = perUnit;
+        }
+
+        // "$var wire 1 ! gdo0 $end": type, size, id, reference
+        constexpr void var()
+        {
+            ++_varToken;
+            if (_varToken == 2) _varWide = !is("1");
+            if (_varToken == 3 && !_varWide && _idLength == 0 && _length <= MAX_ID)
+            {
+                for (uint8_t i = 0; i < _length; ++i) _id[i] = _token[i];
+                _idLength = _length;
+            }
+        }
+
+        constexpr void time()
+        {
+            uint64_t ticks = 0;
+            for (uint8_t i = 1; i < _length; ++i)
+            {
+                if (!detail::isDigit(_token[i])) return;
+                ticks = ticks * 10 + (_token[i] - '0');
+            }
+            _timeUs = ticks * _multiplier / _divider;
+            _transitions.until(static_cast<int64_t>(_timeUs));  // The dump's last "#t" ends the last level
+        }
+
+        detail::Transitions<Writer> _transitions;
+        char     _token[MAX_TOKEN];
+        uint8_t  _length;
+        Section  _section;
+        uint8_t  _varToken;
+        bool     _varWide;
+        char     _id[MAX_ID];
+        uint8_t  _idLength;
+        uint64_t _scaleNumber;
+        uint64_t _multiplier;                                   // us = ticks x multiplier / divider
+        uint64_t _divider;
+        uint64_t _timeUs;
+        bool     _skipNext;
+    };
+}
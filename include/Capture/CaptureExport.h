@@ -0,0 +1,17 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Writes the open-door burst, as the waveform player puts it on air, as an edge capture
+ *        (Capture/EdgeCapture.h) on `out`.
+ *
+ * The serial line also carries text, so the capture goes out hex encoded, one line per write
+ * (file header, then one line per CAPTURE_BLOCK_BYTES block):
+ *   "CAP <hex>"
+ * Back to a binary capture on the host:
+ *   grep '^CAP ' boot.log | cut -c5- | xxd -r -p > open_door.ecap
+ * which host tools compare with an analyzer capture of the real transmitter converted by
+ * CsvConverter / VcdConverter (same format, so the same reader).
+ */
+void exportOpenDoorCapture(Print& out);
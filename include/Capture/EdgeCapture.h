@@ -0,0 +1,310 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Config/Constants.h"
+#include "Waveform/WaveformBytecode.h"
+
+/**
+ * @brief Edge capture format: (level, duration) traces in fixed-size, self-indexing blocks.
+ *
+ * Layout (little endian):
+ *
+ *   file header   'E' 'C' 'A' 'P' | version u8 | reserved u8 | blockBytes u16           (8 bytes)
+ *   block k       at 8 + k x blockBytes:
+ *                 startUs u64 | firstEdge u64 | edges u16 | payloadBytes u16            (20 bytes)
+ *                 payload: one LEB128 varint per edge, (durationUs << 1) | level, then zero padding
+ *
+ * Timestamps are deltas inside a block (the edge durations) and absolute in block headers. Every
+ * block has the same size, so the block headers are the index: a time seek is a binary search
+ * over them, then a walk of one block (O(log n)). Nothing is written after the last block, so a
+ * capture can be streamed to a sink that can not seek (a serial port, a pipe) and a truncated
+ * capture still reads up to its last whole block.
+ *
+ * Edges of 2^31 us or more are stored as several edges of the same level (decoders merge them);
+ * zero-length edges are dropped.
+ *
+ * Reader and Writer have no AVR dependency and are constexpr: host tools mmap a capture and
+ * iterate it in place (tools/capture, acceptance_sim -c), the firmware checks a round trip of its
+ * own burst at build time (conformance block in CaptureExport.cpp). Reader::Cursor::next() has the
+ * signature of Waveform::Interpreter::next(), so a consumer of compiled programs reads captures
+ * unchanged.
+ */
+namespace Capture
+{
+    constexpr uint8_t  VERSION            = 1;
+    constexpr size_t   FILE_HEADER_BYTES  = 8;
+    constexpr size_t   BLOCK_HEADER_BYTES = 20;
+    constexpr uint8_t  MAX_VARINT_BYTES   = 5;                  // 32-bit value
+    constexpr uint32_t MAX_EDGE_US        = 0x7FFFFFFFUL;       // Duration and level share 32 bits
+
+    constexpr uint8_t MAGIC[4] = { 'E', 'C', 'A', 'P' };
+
+    /**
+     * @brief Streams edges into blocks of BlockBytes, in bounded memory (one block).
+     *
+     * @tparam Sink - anything with write(const uint8_t*, size_t): Print, a file, a test buffer
+     * @tparam BlockBytes - block size of this capture, written in the file header
+     *
+     * @example
+     *   Capture::Writer<Print> writer(Serial);
+     *   writer.add(1, 300);
+     *   writer.finish();
+     */
+    template<typename Sink, size_t BlockBytes = CAPTURE_BLOCK_BYTES>
+    class Writer
+    {
+        static_assert(BlockBytes >= BLOCK_HEADER_BYTES + MAX_VARINT_BYTES && BlockBytes <= 0xFFFF, "Block must hold its header and one edge");
+
+        public:
+
+        constexpr explicit Writer(Sink& sink):
+        _sink(sink), _block{}, _used(BLOCK_HEADER_BYTES), _edges(0), _blockStartUs(0), _blockFirstEdge(0),
+        _nowUs(0), _edgeCount(0), _started(false)
+        {}
+
+        constexpr void add(uint8_t level, uint32_t durationUs)
+        {
+            level = level ? 1 : 0;
+            while (durationUs > MAX_EDGE_US)
+            {
+                append(level, MAX_EDGE_US);
+                durationUs -= MAX_EDGE_US;
+            }
+            if (durationUs) append(level, durationUs);
+        }
+
+        /// @brief Writes the last partial block (and the file header of an empty capture)
+        constexpr void finish()
+        {
+            start();
+            if (_edges) flush();
+        }
+
+        constexpr uint64_t edgeCount() const { return _edgeCount; }
+        constexpr uint64_t durationUs() const { return _nowUs; }
+
+        private:
+
+        constexpr void start()
+        {
+            if (_started) return;
+            _started = true;
+            uint8_t header[FILE_HEADER_BYTES] = { MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3], VERSION, 0,
+                                                  static_cast<uint8_t>(BlockBytes), static_cast<uint8_t>(BlockBytes >> 8) };
+            _sink.write(header, FILE_HEADER_BYTES);
+        }
+
+        constexpr void append(uint8_t level, uint32_t durationUs)
+        {
+            start();
+            if (_used + MAX_VARINT_BYTES > BlockBytes || _edges == 0xFFFF) flush();
+            if (_edges == 0)
+            {
+                _blockStartUs   = _nowUs;
+                _blockFirstEdge = _edgeCount;
+            }
+
+            uint32_t value = (durationUs << 1) | level;
+            do
+            {
+                uint8_t byte = value & 0x7F;
+                value >>= 7;
+                _block[_used++] = value ? (byte | 0x80) : byte;
+            } while (value);
+
+            ++_edges;
+            ++_edgeCount;
+            _nowUs += durationUs;
+        }
+
+        constexpr void flush()
+        {
+            put(0, _blockStartUs, 8);
+            put(8, _blockFirstEdge, 8);
+            put(16, _edges, 2);
+            put(18, _used - BLOCK_HEADER_BYTES, 2);
+            for (size_t i = _used; i < BlockBytes; ++i) _block[i] = 0;
+            _sink.write(_block, BlockBytes);
+            _used  = BLOCK_HEADER_BYTES;
+            _edges = 0;
+        }
+
+        constexpr void put(size_t at, uint64_t value, uint8_t bytes)
+        {
+            for (uint8_t i = 0; i < bytes; ++i) _block[at + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+
+        Sink&    _sink;
+        uint8_t  _block[BlockBytes];
+        size_t   _used;
+        uint16_t _edges;
+        uint64_t _blockStartUs;
+        uint64_t _blockFirstEdge;
+        uint64_t _nowUs;
+        uint64_t _edgeCount;
+        bool     _started;
+    };
+
+    /**
+     * @brief Zero-copy reader over a whole capture in memory (mmap on a host, RAM or flash here).
+     *
+     * @tparam StoragePolicy - RAMStoragePolicy or PROGMEMStoragePolicy, where the bytes live
+     *
+     * @example
+     *   Capture::Reader<RAMStoragePolicy> capture(data, size);
+     *   auto cursor = capture.seek(25000);                     // Edge on air at t = 25 ms
+     *   Waveform::Edge edge{0, 0};
+     *   while (cursor.next(edge)) { ... }
+     */
+    template<typename StoragePolicy>
+    class Reader
+    {
+        public:
+
+        class Cursor
+        {
+            public:
+
+            /**
+             * @brief Produces the next edge.
+             * @return false past the last edge, or on a malformed block (faulted())
+             */
+            constexpr bool next(Waveform::Edge& edge)
+            {
+                while (_left == 0)
+                {
+                    if (_faulted || _block + 1 >= _reader->_blocks) return false;
+                    load(_block + 1);
+                }
+
+                uint32_t value = 0;
+                for (uint8_t shift = 0; ; shift += 7)
+                {
+                    if (_at >= _end || shift >= 7 * MAX_VARINT_BYTES) { _faulted = true; _left = 0; return false; }
+                    uint8_t byte = StoragePolicy::read(_at++);
+                    value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80)) break;
+                }
+
+                edge.level      = value & 1;
+                edge.durationUs = value >> 1;
+                --_left;
+                ++_edge;
+                _startUs += edge.durationUs;
+                return true;
+            }
+
+            constexpr uint64_t startUs() const { return _startUs; }         // Start of the edge next() returns
+            constexpr uint64_t edgeIndex() const { return _edge; }
+            constexpr bool faulted() const { return _faulted; }
+
+            private:
+
+            friend class Reader;
+
+            constexpr explicit Cursor(const Reader* reader):
+            _reader(reader), _block(0), _at(nullptr), _end(nullptr), _left(0), _edge(0), _startUs(0), _faulted(false)
+            {}
+
+            constexpr void load(size_t block)
+            {
+                const uint8_t* header = _reader->blockAt(block);
+                _block   = block;
+                _startUs = get(header, 8);
+                _edge    = get(header + 8, 8);
+                _left    = static_cast<uint16_t>(get(header + 16, 2));
+                _at      = header + BLOCK_HEADER_BYTES;
+                _end     = _at + get(header + 18, 2);
+                if (get(header + 18, 2) > _reader->_blockBytes - BLOCK_HEADER_BYTES)
+                {
+                    _faulted = true;
+                    _left = 0;
+                }
+            }
+
+            const Reader*  _reader;
+            size_t         _block;
+            const uint8_t* _at;
+            const uint8_t* _end;
+            uint16_t       _left;
+            uint64_t       _edge;
+            uint64_t       _startUs;
+            bool           _faulted;
+        };
+
+        constexpr Reader(const uint8_t* data, size_t size):
+        _data(data), _blockBytes(0), _blocks(0)
+        {
+            if (size < FILE_HEADER_BYTES) return;
+            for (uint8_t i = 0; i < 4; ++i) if (StoragePolicy::read(data + i) != MAGIC[i]) return;
+            if (StoragePolicy::read(data + 4) != VERSION) return;
+
+            size_t blockBytes = static_cast<size_t>(get(data + 6, 2));
+            if (blockBytes < BLOCK_HEADER_BYTES + MAX_VARINT_BYTES) return;
+            _blockBytes = blockBytes;
+            _blocks     = (size - FILE_HEADER_BYTES) / blockBytes;  // A truncated last block is dropped
+        }
+
+        constexpr bool   valid() const { return _blockBytes != 0; }
+        constexpr size_t blockCount() const { return _blocks; }
+
+        constexpr uint64_t edgeCount() const
+        {
+            if (_blocks == 0) return 0;
+            const uint8_t* last = blockAt(_blocks - 1);
+            return get(last + 8, 8) + get(last + 16, 2);
+        }
+
+        constexpr Cursor begin() const
+        {
+            Cursor cursor(this);
+            if (_blocks) cursor.load(0);
+            return cursor;
+        }
+
+        /**
+         * @brief Cursor on the edge on air at t = us: binary search of the block headers, then a
+         *        walk inside one block. Past the end, the cursor is at the end.
+         */
+        constexpr Cursor seek(uint64_t us) const
+        {
+            Cursor cursor(this);
+            if (_blocks == 0) return cursor;
+
+            size_t low = 0;
+            size_t high = _blocks;                              // Last block starting at or before us is in [low, high)
+            while (high - low > 1)
+            {
+                size_t middle = low + (high - low) / 2;
+                if (get(blockAt(middle), 8) <= us) low = middle;
+                else                               high = middle;
+            }
+            cursor.load(low);
+
+            while (cursor._left)
+            {
+                Cursor ahead = cursor;
+                Waveform::Edge edge{0, 0};
+                if (!ahead.next(edge) || ahead._startUs > us) break;
+                cursor = ahead;
+            }
+            return cursor;
+        }
+
+        private:
+
+        constexpr const uint8_t* blockAt(size_t block) const { return _data + FILE_HEADER_BYTES + block * _blockBytes; }
+
+        static constexpr uint64_t get(const uint8_t* at, uint8_t bytes)
+        {
+            uint64_t value = 0;
+            for (uint8_t i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(StoragePolicy::read(at + i)) << (8 * i);
+            return value;
+        }
+
+        const uint8_t* _data;
+        size_t _blockBytes;                                     // 0 = not a capture
+        size_t _blocks;
+    };
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+#include "Capture/TraceFormat.h"
+
+#if defined(FIELD_TRACE_MODE) && defined(TRACE_REPLAY_MODE)
+#error "FIELD_TRACE_MODE records a trace, TRACE_REPLAY_MODE replays one: build one of them"
+#endif
+
+static_assert(FIELD_TRACE_RING_SIZE >= 64 && (FIELD_TRACE_RING_SIZE & (FIELD_TRACE_RING_SIZE - 1)) == 0, "FIELD_TRACE_RING_SIZE must be a power of two >= 64");
+static_assert(FIELD_TRACE_REPLAY_BUFFER >= 2 * FIELD_TRACE_LINE_BYTES && (FIELD_TRACE_REPLAY_BUFFER & (FIELD_TRACE_REPLAY_BUFFER - 1)) == 0,
+              "The replay buffer is a power of two holding at least two trace lines");
+
+/**
+ * @brief Records what a unit in the field sees, the button edges and the whole SPI traffic with
+ *        its timing, and replays it on the bench through the same firmware code.
+ *
+ * Record (-DFIELD_TRACE_MODE): from start() (end of setup()) every button edge (onEdge()) and
+ * every SPI transaction (CSn falling edge, then each byte sent and received) goes into a
+ * FIELD_TRACE_RING_SIZE ring as a Capture/TraceFormat record. service(), called from the loop,
+ * sends it without blocking as hex lines between the LOG lines:
+ *   "TRC <hex>"
+ * A full ring drops records and counts them; a Gap record marks where.
+ *
+ * Replay (-DTRACE_REPLAY_MODE): the same firmware boots as usual, then beginReplay() asks for the
+ * trace one line at a time ("TRC?" on Serial, answered with the next "TRC" line of the field log,
+ * "TRC END" after the last one):
+ *   - time is virtual (Timebase::beginVirtual()): one tick per loop pass while anything is in
+ *     progress, straight to the next recorded edge or transaction otherwise. Idle hours of a
+ *     field session take no time
+ *   - each recorded edge sets the pin level CircularDebounceBuffer reads and calls the button ISR
+ *   - SPIBus does not clock the bus: each transaction must be the next recorded one, each byte
+ *     sent must be the recorded one, and gets the byte the chip answered in the field. The CC1101
+ *     states, FIFO bytes and poll counts are the field ones
+ *   - the first difference stops the replay and reports where: "REPLAY diverged record=<n> ..."
+ *     Otherwise "REPLAY done records=<n> trace_ms=<field time> wall_ms=<replay time> lag_max_us="
+ *
+ * Every clock the replayed code reads is the Timebase: the bursts, the radio driver's settle
+ * delays and timeouts wait through Timebase::delayUs() / delayMs(), which move the virtual count
+ * instead of spinning, and the loop's periodic status read runs on Timebase::nowMs(). A replay
+ * costs CPU time only, bursts included (the hold-to-transmit Timer1 streamer is the exception).
+ *
+ * Replay on the host: tools/trace_replay runs this firmware on hal/host and answers each "TRC?"
+ * from the field log (field.log, any other lines skipped), no board needed:
+ *   tools/trace_replay/build/trace_replay field.log
+ * On a bench unit, answer each "TRC?" with the next "TRC" line of the log, then "TRC END".
+ *
+ * Outside these two builds every hook below is an empty inline function.
+ */
+class FieldTrace
+{
+    public:
+
+#ifdef FIELD_TRACE_MODE
+    static void start(uint8_t level);                           // Button pin level now, then record
+    static void service(Print& out);                            // Non-blocking: whole "TRC" lines that fit the TX buffer
+
+    static inline uint8_t edgeLevel(uint8_t level)
+    {
+        recordTimed(Trace::Kind::Edge, level);
+        return level;
+    }
+
+    static inline uint8_t sampleLevel(uint8_t level) { return level; }
+    static inline void onSelect() { recordTimed(Trace::Kind::Select, 0); }
+
+    static inline uint8_t onTransfer(uint8_t mosi, uint8_t miso)
+    {
+        recordByte(mosi, miso);
+        return miso;
+    }
+
+    static constexpr bool replaying() { return false; }
+    static inline uint8_t replayTransfer(uint8_t) { return 0xFF; }
+
+    private:
+
+    static void recordTimed(Trace::Kind kind, uint8_t level);
+    static void recordByte(uint8_t mosi, uint8_t miso);
+    static bool append(const Trace::Record& record);
+    static uint16_t pending();
+
+    static volatile uint8_t  _ring[FIELD_TRACE_RING_SIZE];
+    static volatile uint16_t _head;
+    static volatile uint16_t _tail;
+    static uint16_t _dropped;                                   // Records lost since the last Gap
+    static uint32_t _lastUs;                                    // Timebase::preciseUs() of the last timed record written
+    static bool     _recording;
+
+#elif defined(TRACE_REPLAY_MODE)
+    static void beginReplay();                                  // Blocks until the Start record arrived
+    // Loop top: virtual time, recorded edges; busy = something may happen before the next recorded event
+    static void replayStep(bool busy, void (*edgeHandler)());
+
+    static inline uint8_t edgeLevel(uint8_t level) { return _replaying ? _level : level; }
+    static inline uint8_t sampleLevel(uint8_t level) { return _replaying ? _level : level; }
+    static inline void onSelect() { if (_replaying) replaySelect(); }
+    static inline uint8_t onTransfer(uint8_t, uint8_t miso) { return miso; }
+
+    static inline bool replaying() { return _replaying; }
+    static uint8_t replayTransfer(uint8_t mosi);
+
+    private:
+
+    static void replaySelect();
+    static bool peek();                                         // Next record in _next; false at the end of the trace
+    static void consume();
+    static void refill();
+    static void readLine();
+    static void advanceTo(uint32_t traceUs);
+    static uint32_t traceNowUs();
+    static void diverge(const __FlashStringHelper* reason, int16_t sent = -1);
+    static void finish(const __FlashStringHelper* reason);
+
+    static uint8_t        _input[FIELD_TRACE_REPLAY_BUFFER];
+    static uint8_t        _inHead;
+    static uint8_t        _inCount;
+    static Trace::Decoder _decoder;
+    static Trace::Record  _next;
+    static bool           _hasNext;
+    static bool           _ended;                               // "TRC END", a timeout or a malformed record
+    static bool           _replaying;
+    static uint8_t        _level;                               // Replayed button pin level
+    static uint32_t       _records;                             // Consumed
+    static uint32_t       _traceUs;                             // Field time of the last timed record consumed
+    static uint32_t       _originUs;                            // Timebase::nowUs() at the Start record
+    static uint32_t       _lagMaxUs;                            // Worst delay of a replayed transaction behind its field time
+    static uint32_t       _wallStartMs;
+
+#else
+    static inline uint8_t edgeLevel(uint8_t level) { return level; }
+    static inline uint8_t sampleLevel(uint8_t level) { return level; }
+    static inline void onSelect() {}
+    static inline uint8_t onTransfer(uint8_t, uint8_t miso) { return miso; }
+    static constexpr bool replaying() { return false; }
+    static inline uint8_t replayTransfer(uint8_t) { return 0xFF; }
+#endif
+};
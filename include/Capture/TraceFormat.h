@@ -0,0 +1,155 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Field trace format: the button edges and the SPI traffic of a running firmware, as one
+ *        byte stream of records (Capture/FieldTrace records and replays it).
+ *
+ *   tag u8            kind in bits 2:0, pin level in bit 3 (Start, Edge)
+ *   Start  | level    first record: the button pin level when recording started
+ *   Edge   | level    varint deltaUs   button pin changed (level read after the edge, like onEdge())
+ *   Select            varint deltaUs   CSn fell: one SPI transaction starts
+ *   Byte              mosi u8, miso u8 one byte clocked in the current transaction
+ *   Gap               varint records   records dropped by the recorder (its ring was full)
+ *
+ * deltaUs is the time since the previous timed record (Start, Edge, Select), LEB128 like the edge
+ * captures. The stream has no framing of its own: records follow each other and a reader starts
+ * at Start.
+ *
+ * Encoder and Decoder have no AVR dependency and are constexpr: the firmware checks a round trip
+ * at build time (conformance block in FieldTrace.cpp), host tools read the same stream.
+ */
+namespace Trace
+{
+    enum class Kind : uint8_t { Start = 1, Edge = 2, Select = 3, Byte = 4, Gap = 5 };
+
+    constexpr uint8_t KIND_MASK        = 0x07;
+    constexpr uint8_t LEVEL_FLAG       = 0x08;
+    constexpr uint8_t MAX_VARINT_BYTES = 5;                     // 32-bit value
+    constexpr uint8_t MAX_RECORD_BYTES = 1 + MAX_VARINT_BYTES;
+
+    struct Record
+    {
+        Kind     kind;
+        uint8_t  level;                                         // Start, Edge
+        uint8_t  mosi;                                          // Byte
+        uint8_t  miso;                                          // Byte
+        uint32_t value;                                         // deltaUs (Edge, Select), dropped records (Gap)
+
+        constexpr bool operator==(const Record& other) const
+        {
+            return kind == other.kind && level == other.level && mosi == other.mosi && miso == other.miso && value == other.value;
+        }
+    };
+
+    constexpr Record start(uint8_t level)                         { return { Kind::Start, static_cast<uint8_t>(level ? 1 : 0), 0, 0, 0 }; }
+    constexpr Record edge(uint8_t level, uint32_t deltaUs)        { return { Kind::Edge, static_cast<uint8_t>(level ? 1 : 0), 0, 0, deltaUs }; }
+    constexpr Record select(uint32_t deltaUs)                     { return { Kind::Select, 0, 0, 0, deltaUs }; }
+    constexpr Record byte(uint8_t mosi, uint8_t miso)             { return { Kind::Byte, 0, mosi, miso, 0 }; }
+    constexpr Record gap(uint32_t dropped)                        { return { Kind::Gap, 0, 0, 0, dropped }; }
+
+    constexpr bool timed(Kind kind) { return kind == Kind::Edge || kind == Kind::Select; }
+
+    /// @brief Writes record into out (MAX_RECORD_BYTES), returns its length
+    constexpr uint8_t encode(const Record& record, uint8_t* out)
+    {
+        uint8_t length = 0;
+        out[length++] = static_cast<uint8_t>(record.kind) | (record.level ? LEVEL_FLAG : 0);
+
+        if (record.kind == Kind::Byte)
+        {
+            out[length++] = record.mosi;
+            out[length++] = record.miso;
+        }
+        else if (record.kind != Kind::Start)
+        {
+            uint32_t value = record.value;
+            do
+            {
+                uint8_t byte = value & 0x7F;
+                value >>= 7;
+                out[length++] = value ? (byte | 0x80) : byte;
+            } while (value);
+        }
+        return length;
+    }
+
+    /**
+     * @brief Byte-at-a-time decoder: bytes can come from a serial line as they arrive.
+     *
+     * @example
+     *   Trace::Decoder decoder;
+     *   Trace::Record record{};
+     *   while (Serial.available()) if (decoder.push(Serial.read(), record)) { ... }
+     */
+    class Decoder
+    {
+        public:
+
+        /// @return true when byte completes a record (written to record). A malformed record faults
+        ///         the decoder: no record comes out of it afterwards
+        constexpr bool push(uint8_t byte, Record& record)
+        {
+            if (_faulted) return false;
+
+            switch (_state)
+            {
+                case State::Tag:
+                {
+                    uint8_t kind = byte & KIND_MASK;
+                    if (kind < static_cast<uint8_t>(Kind::Start) || kind > static_cast<uint8_t>(Kind::Gap) || (byte & ~(KIND_MASK | LEVEL_FLAG)))
+                    {
+                        _faulted = true;
+                        return false;
+                    }
+                    _record = { static_cast<Kind>(kind), static_cast<uint8_t>((byte & LEVEL_FLAG) ? 1 : 0), 0, 0, 0 };
+                    _shift  = 0;
+                    if (_record.kind == Kind::Start) return complete(record);
+                    _state = (_record.kind == Kind::Byte) ? State::Mosi : State::Varint;
+                    return false;
+                }
+
+                case State::Mosi:
+                    _record.mosi = byte;
+                    _state = State::Miso;
+                    return false;
+
+                case State::Miso:
+                    _record.miso = byte;
+                    return complete(record);
+
+                case State::Varint:
+                    if (_shift >= 7 * MAX_VARINT_BYTES)
+                    {
+                        _faulted = true;
+                        return false;
+                    }
+                    _record.value |= static_cast<uint32_t>(byte & 0x7F) << _shift;
+                    _shift += 7;
+                    if (byte & 0x80) return false;
+                    return complete(record);
+            }
+            return false;
+        }
+
+        constexpr bool faulted() const { return _faulted; }
+        constexpr bool between() const { return _state == State::Tag; }    // No record half decoded
+
+        private:
+
+        enum class State : uint8_t { Tag, Varint, Mosi, Miso };
+
+        constexpr bool complete(Record& record)
+        {
+            record = _record;
+            _state = State::Tag;
+            return true;
+        }
+
+        State   _state   = State::Tag;
+        Record  _record  = { Kind::Start, 0, 0, 0, 0 };
+        uint8_t _shift   = 0;
+        bool    _faulted = false;
+    };
+}
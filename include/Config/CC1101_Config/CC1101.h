@@ -12,8 +12,12 @@ namespace CC1101
    {
             constexpr uint8_t IOCFG0     = 0x02;         // GDO0 output: Output Pin Configuration Pag. 71 datasheet
             constexpr uint8_t FIFOTHR    = 0x03;         // 0x03: FIFOTHR – RX FIFO and TX FIFO Thresholds pag 72
+            constexpr uint8_t SYNC1      = 0x04;         // Sync word, high byte (packet mode)
+            constexpr uint8_t SYNC0      = 0x05;         // Sync word, low byte (packet mode)
             constexpr uint8_t PKTLEN     = 0x06;         // Max packet length (not used in async)
+            constexpr uint8_t PKTCTRL1  = 0x07;         // 0x07: PKTCTRL1 – Packet Automation Control (status append, address check, CRC autoflush)
             constexpr uint8_t PKTCTRL0  = 0x08;         // 0x08: PKTCTRL0 – Packet Automation Control
+            constexpr uint8_t ADDR        = 0x09;         // Device address used for packet filtering
             constexpr uint8_t FSCTRL1    = 0x0B;         // FSCTRL1 – Frequency Synthesizer Control pag75 -> The default value gives an IF frequency of 381kHz, assuming a 26.0 MHz crystal.
             constexpr uint8_t FSCTRL0    = 0x0C;         // FSCTRL0 – Frequency Synthesizer Control -> Frequency offset added to the base frequency before being used by the frequency synthesizer. (2s-complement).
             constexpr uint8_t FREQ2       = 0x0D;        // FREQ2 – Frequency Control Word, High Byte
@@ -37,6 +41,9 @@ namespace CC1101
             constexpr uint8_t PARTNUM  = 0x30;        // Chip ID - Part number for CC1101
             constexpr uint8_t VERSION    = 0x31;        // Chip version number. Subject to change without notice.
             constexpr uint8_t MARCSTATE = 0X35;      // Control state machine state
+            constexpr uint8_t TXBYTES    = 0x3A;        // Underflow flag + number of bytes in TX FIFO (status register, burst access)
+            constexpr uint8_t RXBYTES    = 0x3B;        // Overflow flag + number of bytes in RX FIFO (status register, burst access)
+            constexpr uint8_t FIFO          = 0x3F;        // TX FIFO on write, RX FIFO on read
    }
 
     /// @brief Values for the CC1101 transceiver registers and configuration settings.
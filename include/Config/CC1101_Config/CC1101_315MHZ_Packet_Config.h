@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include "Config/CC1101_Config/RegisterSettings.h"
+#include "Config/CC1101_Config/CC1101.h"
+#include "Config/Constants.h"
+
+/**
+ * @brief Register deltas that switch the 315 MHz OOK configuration between the async (SC41344 on GDO0)
+ *  mode and the packet-mode command link used with our own paired receivers.
+ *
+ *  Only the registers that differ from Config_315MHz_OOK are listed, so entering/leaving packet mode is
+ *  a handful of SPI writes instead of re-applying the whole table.
+ *
+ *  Packet link: 4.8 kBaud OOK, 4 preamble bytes, 30/32 sync (0xD391), variable length, whitening,
+ *  hardware CRC-16 with autoflush, address filtering and RSSI/LQI appended to every received packet.
+ *  After TX the radio falls into RX by itself (MCSM1.TXOFF_MODE = RX) to catch the ACK.
+ */
+namespace Config_315MHz_Packet
+{
+    namespace Value
+    {
+        constexpr uint8_t SYNC1      = 0xD3;      // Sync word high byte (datasheet default)
+        constexpr uint8_t SYNC0      = 0x91;      // Sync word low byte (datasheet default)
+        constexpr uint8_t PKTLEN     = PACKET_LINK_MAX_PAYLOAD;  // Longest accepted packet, leaves room for the length + 2 status bytes in the 64-byte FIFO
+        constexpr uint8_t PKTCTRL1  = 0x0E;      // CRC_AUTOFLUSH = 1, APPEND_STATUS = 1, ADR_CHK = 10 (address + 0x00 broadcast)
+        constexpr uint8_t PKTCTRL0  = 0x45;      // WHITE_DATA = 1, PKT_FORMAT = normal (FIFO), CRC_EN = 1, LENGTH_CONFIG = variable
+        constexpr uint8_t ADDR        = PACKET_LINK_FOB_ADDRESS;
+        constexpr uint8_t MDMCFG4   = 0xF7;      // DRATE_E = 7, CHANBW = 58 kHz
+        constexpr uint8_t MDMCFG3   = 0x83;      // DRATE_M = 0x83 -> 4.8 kBaud
+        constexpr uint8_t MDMCFG2   = 0x33;      // OOK, SYNC_MODE = 30/32 sync bits detected
+        constexpr uint8_t MDMCFG1   = 0x22;      // NUM_PREAMBLE = 4 bytes, CHANSPC_E = 2
+        constexpr uint8_t MCSM1     = 0x33;      // RXOFF_MODE = IDLE, TXOFF_MODE = RX
+    }
+
+    // Applied when the command link is opened
+    constexpr std::array<RegisterSettings, 11> enter_Regs =
+    {
+        {
+            { CC1101::Address::SYNC1,       Value::SYNC1,       VERIFY},
+            { CC1101::Address::SYNC0,       Value::SYNC0,       VERIFY},
+            { CC1101::Address::PKTLEN,      Value::PKTLEN,      VERIFY},
+            { CC1101::Address::PKTCTRL1,   Value::PKTCTRL1,   VERIFY},
+            { CC1101::Address::PKTCTRL0,   Value::PKTCTRL0,   VERIFY},
+            { CC1101::Address::ADDR,        Value::ADDR,        VERIFY},
+            { CC1101::Address::MDMCFG4,   Value::MDMCFG4,   VERIFY},
+            { CC1101::Address::MDMCFG3,   Value::MDMCFG3,   VERIFY},
+            { CC1101::Address::MDMCFG2,   Value::MDMCFG2,   VERIFY},
+            { CC1101::Address::MDMCFG1,   Value::MDMCFG1,   VERIFY},
+            { CC1101::Address::MCSM1,       Value::MCSM1,       VERIFY}
+        }
+    };
+
+    // Applied when the command link is closed: back to the async OOK values of Config_315MHz_OOK
+    constexpr std::array<RegisterSettings, 7> leave_Regs =
+    {
+        {
+            { CC1101::Address::PKTLEN,      CC1101::Value::PKTLEN,      SKIP_VERIFY},
+            { CC1101::Address::PKTCTRL0,   CC1101::Value::PKTCTRL0,   VERIFY},
+            { CC1101::Address::MDMCFG4,   CC1101::Value::MDMCFG4,   VERIFY},
+            { CC1101::Address::MDMCFG3,   CC1101::Value::MDMCFG3,   VERIFY},
+            { CC1101::Address::MDMCFG2,   CC1101::Value::MDMCFG2,   VERIFY},
+            { CC1101::Address::MDMCFG1,   CC1101::Value::MDMCFG1,   VERIFY},
+            { CC1101::Address::MCSM1,       CC1101::Value::MCSM1,       VERIFY}
+        }
+    };
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Config/Constants.h"
+
+/**
+ * @brief Compile-time descriptions of the fixed-code families the streamer can emit.
+ *
+ * A family only describes the *frame layout*: how many data bits form a word, where the
+ * sync symbol sits relative to the word, whether a lead-in / inter-word gap is required and
+ * how many times the word is repeated. The pulse shapes themselves stay in the IBitEncoder.
+ *
+ * Every member is constexpr so CodeFamilyStreamer<Family> resolves the layout with
+ * `if constexpr` and the generated code has no runtime branch on the family.
+ */
+namespace CodeFamilies
+{
+    /// @brief Where the synchronisation symbol is sent with respect to the data word
+    enum class SyncPlacement : uint8_t
+    {
+        Leading,                // SYNC -> word      (EV1527, PT2262 learning codes)
+        Trailing                // word -> SYNC      (SC41344: 8 digits followed by the OPEN digit)
+    };
+
+    /**
+     * @brief SC41344-style family: N data digits + trailing OPEN, 10 ms lead-in and a 3-digit silence between words.
+     *
+     * @tparam N - Word length in data bits (8 for the original SC41344, 12/16/24 for the wider variants)
+     */
+    template<size_t N>
+    struct SC41344
+    {
+        static_assert(N > 0 && N <= 32, "SC41344 family word length must be 1..32 bits");
+
+        static constexpr size_t        WORD_BITS        = N;
+        static constexpr SyncPlacement SYNC             = SyncPlacement::Trailing;
+        static constexpr bool          LEAD_IN          = true;                       // sendPreamble() once before the first word
+        static constexpr bool          GAP_BETWEEN_WORDS= true;                       // sendSilence() before every repeated word
+        static constexpr uint8_t       WORD_REPEATS     = FRAME_REPEATS;              // Repeated words after the first one
+
+        static constexpr uint32_t      BIT_PERIOD_US    = DIGIT_PERIOD_US;
+        static constexpr uint32_t      SYNC_PERIOD_US   = DIGIT_PERIOD_US;            // OPEN digit takes one digit period
+        static constexpr uint32_t      LEAD_IN_US       = PREAMBLE_LOW_DURATION_US;
+        static constexpr uint32_t      GAP_US           = FRAME_SILENCE_BETWEEN_WORDS;
+    };
+
+    using SC41344_8Bit  = SC41344<8>;
+    using SC41344_12Bit = SC41344<12>;
+    using SC41344_16Bit = SC41344<16>;
+    using SC41344_24Bit = SC41344<24>;
+
+    /**
+     * @brief EV1527 learning code: 20-bit serial + 4 button bits, each word preceded by its sync pulse.
+     *        The 31T LOW of the sync already separates the words, so no extra gap is emitted.
+     */
+    struct EV1527
+    {
+        static constexpr size_t        WORD_BITS        = 24;
+        static constexpr SyncPlacement SYNC             = SyncPlacement::Leading;
+        static constexpr bool          LEAD_IN          = false;
+        static constexpr bool          GAP_BETWEEN_WORDS= false;
+        static constexpr uint8_t       WORD_REPEATS     = EV1527_WORD_REPEATS;
+
+        static constexpr uint32_t      BIT_PERIOD_US    = 4UL  * EV1527_BASE_PULSE_US;
+        static constexpr uint32_t      SYNC_PERIOD_US   = 32UL * EV1527_BASE_PULSE_US;
+        static constexpr uint32_t      LEAD_IN_US       = 0;
+        static constexpr uint32_t      GAP_US           = 0;
+    };
+
+    /**
+     * @brief Rolling-code word for our own paired receivers: EV1527 pulse shapes, 96-bit word, leading sync.
+     */
+    struct RollingCode
+    {
+        static constexpr size_t        WORD_BITS        = ROLLING_CODE_WORD_BITS;
+        static constexpr SyncPlacement SYNC             = SyncPlacement::Leading;
+        static constexpr bool          LEAD_IN          = false;
+        static constexpr bool          GAP_BETWEEN_WORDS= false;
+        static constexpr uint8_t       WORD_REPEATS     = ROLLING_CODE_WORD_REPEATS;
+
+        static constexpr uint32_t      BIT_PERIOD_US    = 4UL  * EV1527_BASE_PULSE_US;
+        static constexpr uint32_t      SYNC_PERIOD_US   = 32UL * EV1527_BASE_PULSE_US;
+        static constexpr uint32_t      LEAD_IN_US       = 0;
+        static constexpr uint32_t      GAP_US           = 0;
+    };
+
+    /**
+     * @brief Total on-air duration of one burst (lead-in + first word + repeats) for a family.
+     *
+     * @tparam Family - One of the CodeFamilies structs
+     * @return uint32_t - Burst duration in microseconds
+     */
+    template<typename Family>
+    constexpr uint32_t burstDurationUs()
+    {
+        constexpr uint32_t word = Family::WORD_BITS * Family::BIT_PERIOD_US + Family::SYNC_PERIOD_US;
+        return (Family::LEAD_IN ? Family::LEAD_IN_US : 0)
+             + word
+             + Family::WORD_REPEATS * ((Family::GAP_BETWEEN_WORDS ? Family::GAP_US : 0) + word);
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Conformance against the waveforms captured with the logic analyzer (the encoders'
+    //  output is checked run by run against golden waveforms in test/test_code_families)
+    // ---------------------------------------------------------------------------------
+
+    // SC41344: every digit ('0', '1', OPEN) lasts exactly one 5 ms data period
+    static_assert(2 * (LONG_HIGH_US + SHORT_LOW_US)  == DIGIT_PERIOD_US, "SC41344 '1' must fill one digit period");
+    static_assert(2 * (SHORT_HIGH_US + LONG_LOW_US)  == DIGIT_PERIOD_US, "SC41344 '0' must fill one digit period");
+    static_assert(LONG_HIGH_US + SHORT_LOW_US + SHORT_HIGH_US + LONG_LOW_US == DIGIT_PERIOD_US, "SC41344 OPEN must fill one digit period");
+
+    // SC41344 8-digit capture: 10 ms lead-in, 4 words of 9 digits, 3 gaps of 15 ms -> 235 ms burst
+    static_assert(burstDurationUs<SC41344_8Bit>() == 235000UL, "SC41344 8-bit burst differs from the recorded capture");
+
+    // EV1527 capture (T = 350 us): 24 bits x 1.4 ms + 11.2 ms sync = 44.8 ms per word, 8 words
+    static_assert(EV1527::SYNC_PERIOD_US == EV1527_BASE_PULSE_US + EV1527_SYNC_LOW_US, "EV1527 sync must be T HIGH + 31T LOW");
+    static_assert(burstDurationUs<EV1527>() == 8UL * 44800UL, "EV1527 burst differs from the recorded capture");
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>         // include that defines fixed-width integer types — guaranteed to be the same size on every platform.
 
 // ---------------------------------------------------------------------------------
@@ -8,6 +9,23 @@
 constexpr uint8_t REMOTE_BUTTON_ID = 0;
 constexpr uint8_t BUTTON_HOME_DOOR_GARAGE_PIN = 3;
 
+// ---------------------------------------------------------------------------------
+//      Resistor-ladder keypad on one analog pin (ADC free-running, 8-bit ADCH)
+//          Vcc --10k-- A0 --+-- S0 ----------- GND
+//                           +-- S1 -- 2k2 ---- GND
+//                           +-- S2 -- 4k7 ---- GND
+//                           +-- S3 -- 10k ---- GND
+// ---------------------------------------------------------------------------------
+constexpr uint8_t LADDER_ADC_CHANNEL  = 0;                                                // A0
+constexpr uint8_t LADDER_ANALOG_PIN   = 14;                                               // A0 as an Arduino pin number
+constexpr uint8_t LADDER_BUTTON_COUNT = 4;
+constexpr uint8_t LADDER_LEVELS[LADDER_BUTTON_COUNT + 1] = { 0, 46, 81, 128, 255 };        // ADCH per button, last entry = nothing pressed
+constexpr uint8_t LADDER_HYSTERESIS   = 6;                                                // ADC counts a reading must clear a band edge by
+constexpr uint8_t LADDER_PROBE_PORT_BIT = 7;                                              // PD7 (D7): high while the ADC ISR runs (LADDER_PROFILING builds)
+constexpr uint8_t ISR_LATENCY_PROBE_PORT_BIT = 7;                                         // PD7 (D7): high while a probed handler runs (ISR latency suite)
+constexpr uint8_t ISR_LATENCY_TRIGGER_PORT_BIT = 4;                                       // PD4 (D4): drives INT1 through the bench jumper D4 --1k-- D3 (ISR latency suite)
+constexpr uint8_t ISR_LATENCY_TRIALS = 64;                                                // Interrupts measured per source and load
+
 // ----------------------------------------------------------------------------------
 // GDO0 pin that connected to the Transceiver module for OOK control 
 // ----------------------------------------------------------------------------------
@@ -22,6 +40,16 @@ constexpr uint8_t GDO0_PORT_BIT = 0 ;       // PORTB bit 0 (D8, PB0 for CC1101 G
 constexpr uint8_t THRESHOLD_DEBOUNCE = 60 ;                                                              
 constexpr uint16_t SAMPLE_RATE_DEBOUNCE = 1000;  
 
+// Auto-tuning: starting point is the pair above, the tuner moves inside these bounds
+constexpr uint16_t DEBOUNCE_MIN_INTERVAL_US   = 250;                                     // 16 samples -> 4 ms window at the fastest
+constexpr uint16_t DEBOUNCE_MAX_INTERVAL_US   = 4000;                                    // 16 samples -> 64 ms window at the slowest
+constexpr uint8_t  DEBOUNCE_MIN_THRESHOLD     = 60;                                      // % of the buffer; below this a release bounce can confirm a press
+constexpr uint8_t  DEBOUNCE_MAX_THRESHOLD     = 90;
+constexpr uint16_t DEBOUNCE_MIN_HOLD_MS       = 40;                                      // A confirmed press released sooner than this was a false trigger (no finger is that fast)
+constexpr uint8_t  DEBOUNCE_TARGET_FALSE_RATE_Q8 = 3;                                    // False triggers per press, x256 (~1 %)
+constexpr uint8_t  DEBOUNCE_TUNE_MIN_PRESSES  = 8;                                       // Presses observed before the first retune / between two EEPROM writes
+constexpr uint8_t  DEBOUNCE_MAX_INPUTS        = 4;                                       // Profiles reserved in EEPROM (indexed by debouncer id)
+
 // ---------------------------------------------------------------------------------
 // Bit timing extract it from the SC41344 to mimic the waveform( from logic analyzer)
 //      - How data is encoded:                                               
@@ -46,6 +74,152 @@ constexpr uint8_t  FRAME_BIT_COUNT = 8;
 constexpr uint8_t  FRAME_REPEATS = 3;                                                                // Encoding sequence consist in two consecutive words [Word + Word] which is one Frame. To increases the chance the receiver captures at least one valid frame we send 4 frames  initial + 3 repeats
 constexpr float    CLOCK_FREQ_HZ = 1680.7;                                                        //  ForDebug
 
+// ---------------------------------------------------------------------------------
+// EV1527 / PT2262-style learning-code timing (24-bit word, leading sync)
+//      - Everything is a multiple of the oscillator base pulse T:
+//            '0' :     T HIGH + 3T LOW  ->  ..._| |___...
+//            '1' :    3T HIGH +  T LOW  ->  ..._|   |_...
+//            SYNC:     T HIGH + 31T LOW ->  ..._| |______________________________...
+// ---------------------------------------------------------------------------------
+constexpr uint16_t EV1527_BASE_PULSE_US = 350;
+constexpr uint16_t EV1527_SYNC_LOW_US  = 31 * EV1527_BASE_PULSE_US;         // 10.85 ms
+constexpr uint8_t  EV1527_WORD_REPEATS = 7;                                              // Receivers latch after 2..4 identical words, send 8 (initial + 7 repeats)
+
+// ---------------------------------------------------------------------------------
+//                  Waveform bytecode (compiled bursts played by the interpreter)
+// ---------------------------------------------------------------------------------
+constexpr uint8_t  WAVEFORM_MAX_DEPTH         = 4;                                      // SYMBOL/REPEAT nesting: main > REPEAT > WORD > symbol REPEAT
+constexpr size_t   WAVEFORM_MAX_PROGRAM_BYTES = 128;                                    // Compiler scratch size (offsets are 8-bit anyway)
+constexpr uint16_t WAVEFORM_GAP_UNIT_US       = 100;                                    // GAP operand unit: 1 byte covers up to 25.5 ms
+constexpr uint16_t WAVEFORM_MIN_PULSE_US      = 100;                                    // Load-time limits for field-loaded programs: shortest edge...
+constexpr uint16_t WAVEFORM_MAX_PULSE_US      = 30000;                                  // ...longest edge...
+constexpr uint32_t WAVEFORM_MAX_BURST_US      = 1000000UL;                              // ...and whole burst (regulatory duty cycle, watchdog is off while on air)
+constexpr uint16_t HOLD_TX_MAX_MS             = 20000;                                  // Hold-to-transmit: a stuck button stops streaming after this (watchdog stays on, loop live)
+
+// Field-loaded programs: EEPROM slots after the debounce profiles, cached in RAM at boot
+constexpr uint8_t  PROGRAM_STORE_SLOTS        = 2;
+constexpr uint8_t  PROGRAM_STORE_SLOT_BYTES   = WAVEFORM_MAX_PROGRAM_BYTES;
+
+// ---------------------------------------------------------------------------------
+//                  Timebase (Delay/Timebase, Timer2 CTC)
+// ---------------------------------------------------------------------------------
+constexpr uint16_t TIMEBASE_TICK_US          = 250;                                     // One compare ISR per tick: resolution of Delay, debounce and state timeouts (divisor of 1000)
+
+// ---------------------------------------------------------------------------------
+//                  Application state machine (App/AppStateMachine)
+// ---------------------------------------------------------------------------------
+constexpr uint8_t  APP_EVENT_QUEUE_SIZE      = 16;                                      // Power of two, >= event count: coalesced events can never overflow it
+constexpr uint16_t APP_IDLE_SLEEP_MS         = 30000;                                   // Idle this long -> Sleeping (CPU idle sleep between interrupts)
+constexpr uint16_t APP_DEBOUNCE_TIMEOUT_MS   = 1000;                                    // Debouncing without a confirmed press -> back to Idle
+constexpr uint16_t APP_RECOVERY_RETRY_MS     = 1000;                                    // Radio re-init retry period while Recovering
+
+// ---------------------------------------------------------------------------------
+//                  Receiver acceptance simulation (Simulation/AcceptanceSimulator)
+// ---------------------------------------------------------------------------------
+constexpr uint8_t  RECEIVER_TOLERANCE_PCT     = 30;                                     // Typical decoder: pulse widths within +/- 30 %
+constexpr uint16_t RECEIVER_SYNC_MIN_US       = 8000;                                   // LOW this long is a sync (lead-in 10 ms, gap 15 ms)
+constexpr uint8_t  RECEIVER_WORDS_REQUIRED    = 2;                                      // N identical words...
+constexpr uint8_t  RECEIVER_WINDOW_WORDS      = 4;                                      // ...among the last M word slots
+constexpr uint16_t ACCEPTANCE_SIM_TRIALS      = 200;                                    // Trials per scenario
+constexpr uint16_t ACCEPTANCE_SIM_COLLISION_US= DIGIT_PERIOD_US;                        // Colliding transmission holds the carrier this long
+constexpr uint16_t ACCEPTANCE_SIM_SPIKE_MAX_US= 150;                                    // Noise spikes are 20 us .. this wide
+constexpr uint8_t  ACCEPTANCE_SIM_TX_MA       = 27;                                     // CC1101 TX current with the carrier on (approx., +10 dBm)
+
+// Parameter sweeps (Simulation/ParameterSweep): grid points are jobs, each one seeded from its index
+constexpr uint8_t  SWEEP_DEBOUNCE_PRESSES     = 8;                                      // Simulated presses per debounce grid point
+constexpr uint16_t SWEEP_ACCEPTANCE_TRIALS    = 50;                                     // Bursts per trim x tolerance grid point
+constexpr uint8_t  SWEEP_CHECKPOINT_SLOTS     = 4;                                      // One 5-byte resume point per sweep id (id % slots)
+constexpr uint8_t  SWEEP_BLOCK_ROWS           = 8;                                      // Jobs per columnar output block (Simulation/SweepFormat), 4 bytes x columns each in RAM
+
+// Edge captures (Capture/EdgeCapture): fixed-size blocks, the writer buffers one
+constexpr uint16_t CAPTURE_BLOCK_BYTES        = 128;                                    // Firmware writer; host tools can use bigger blocks in the same format
+
+// SPI traffic accounting (SPI/SpiTrace, built with -DSPI_BUDGET_MODE only)
+constexpr uint8_t  SPI_TRACE_LOG_SIZE         = 64;                                     // First byte of each transaction, kept for the OVER report
+
+// Field trace (Capture/FieldTrace): button edges + SPI traffic recorded (-DFIELD_TRACE_MODE), replayed (-DTRACE_REPLAY_MODE)
+constexpr uint16_t FIELD_TRACE_RING_SIZE      = 256;                                    // Recorded bytes waiting for the UART, power of two
+constexpr uint8_t  FIELD_TRACE_LINE_BYTES     = 24;                                     // Per "TRC" line: 54 characters fit the core's 64-byte TX buffer
+constexpr uint8_t  FIELD_TRACE_REPLAY_BUFFER  = 128;                                    // Trace bytes read ahead by the replay, power of two
+constexpr uint16_t FIELD_TRACE_REPLAY_TIMEOUT_MS = 5000;                                // No line after "TRC?": the trace is over
+constexpr uint32_t FIELD_TRACE_REPLAY_SLACK_US = 20000;                                 // A recorded transaction not issued this late is a divergence
+
+// Diagnostics output (Debugging/LogSink, -DDEBUG builds only): LOG* macros fill a ring drained from the loop
+constexpr uint16_t LOG_RING_SIZE              = 256;                                    // Power of two
+constexpr uint8_t  LOG_RING_RESERVED          = 48;                                     // Last bytes of the ring, for LOG_ERROR* only
+
+// Speculative transmit: the radio waits in FSTXON (synthesizer calibrated, no carrier) while a press is debounced
+constexpr uint16_t TX_PREPARE_TIMEOUT_US      = 2000;                                   // IDLE -> FSTXON, calibration included (809 us typ.)
+constexpr uint8_t  TX_ENTRY_POLLS             = 8;                                      // MARCSTATE reads after STX from FSTXON before the full TX entry is used
+constexpr uint32_t RESET_MISO_TIMEOUT_US      = 100000;                                 // Manual reset: SO low (crystal running, SRES done) within this
+
+// ---------------------------------------------------------------------------------
+//                  Energy and airtime estimate (Simulation/EnergyModel), currents in uA
+//      Datasheet typicals: ATmega328P at 5 V / 16 MHz, CC1101 at 315 MHz. Board parts (regulator,
+//      USB bridge, power LED) are not included: a bare Nano draws several mA on its own.
+// ---------------------------------------------------------------------------------
+constexpr uint32_t ENERGY_MCU_ACTIVE_UA       = 9000;
+constexpr uint32_t ENERGY_MCU_IDLE_UA         = 2700;                                   // SLEEP_MODE_IDLE, Timer0 / Timer2 running
+constexpr uint32_t ENERGY_MCU_POWER_DOWN_UA   = 7;                                      // Watchdog on, wake on INT1
+constexpr uint32_t ENERGY_RADIO_SLEEP_UA      = 1;                                      // SPWD (0.2 uA typ.)
+constexpr uint32_t ENERGY_RADIO_IDLE_UA       = 1700;
+constexpr uint32_t ENERGY_RADIO_SYNTH_UA      = 8400;                                   // FSTXON / calibration, and TX with the carrier off (OOK '0')
+inline constexpr uint32_t ENERGY_RADIO_TX_UA[8] = { 10900, 11400, 12600, 13400, 15000, 18300, 22100, 26900 };   // Carrier on, per paTable index (approx.)
+constexpr uint16_t ENERGY_RADIO_CALIBRATE_US  = 809;                                    // IDLE -> TX with auto-calibration (MCSM0)
+constexpr uint16_t ENERGY_RADIO_WAKE_US       = 240;                                    // SLEEP -> IDLE (crystal start)
+// Power-on to ready without -DDEBUG (printDots() is then a no-op): core init + setup() delay(250) + reset delay(10)
+// + ~4 ms of register writes / verifies at 1 MHz SPI, rounded up. Worked out from the code, not measured yet:
+// BOOT_PROFILE prints the real "READY us" (a -DDEBUG build adds seconds of dots)
+constexpr uint32_t ENERGY_ARDUINO_BOOT_US     = 270000UL;
+constexpr uint32_t ENERGY_FAST_BOOT_US        = 25000UL;                                // Same on the bare-metal build
+constexpr uint16_t ENERGY_PRESSES_PER_DAY     = 10;
+constexpr uint16_t ENERGY_BATTERY_MAH         = 1000;                                   // 2 x AAA
+
+// ---------------------------------------------------------------------------------
+//                  Rolling-code transmit mode (paired receivers only)
+//      - Word = 64-bit XTEA(counter | serial | button) + 28-bit serial + 4-bit button in clear
+//      - Sent with the EV1527 pulse shapes, leading sync before each word
+// ---------------------------------------------------------------------------------
+constexpr uint8_t  ROLLING_CODE_CIPHER_BITS = 64;
+constexpr uint8_t  ROLLING_CODE_CLEAR_BITS  = 32;
+constexpr uint8_t  ROLLING_CODE_WORD_BITS   = ROLLING_CODE_CIPHER_BITS + ROLLING_CODE_CLEAR_BITS;
+constexpr uint8_t  ROLLING_CODE_WORD_REPEATS = 1;                                         // Initial word + 1 repeat
+constexpr uint8_t  XTEA_CYCLES = 32;                                                       // Full XTEA: 32 cycles = 64 Feistel rounds
+
+// EEPROM journal that keeps the last used counter (wear-leveled ring of slots)
+constexpr uint16_t COUNTER_JOURNAL_BASE_ADDR = 0x000;                                 // First byte of the ring in EEPROM
+constexpr uint8_t  COUNTER_JOURNAL_SLOTS     = 32;                                      // 32 slots x 100k cycles -> 3.2M presses before wear-out
+constexpr uint16_t DEBOUNCE_PROFILE_BASE_ADDR = COUNTER_JOURNAL_BASE_ADDR + COUNTER_JOURNAL_SLOTS * 5;   // Learned debounce parameters, right after the journal
+constexpr uint16_t PROGRAM_STORE_BASE_ADDR    = DEBOUNCE_PROFILE_BASE_ADDR + DEBOUNCE_MAX_INPUTS * 5;  // Field-loaded waveform programs, after the debounce profiles
+constexpr uint16_t SWEEP_CHECKPOINT_ADDR      = PROGRAM_STORE_BASE_ADDR + PROGRAM_STORE_SLOTS * (3 + PROGRAM_STORE_SLOT_BYTES);   // Parameter sweep resume point, after the program slots
+constexpr uint8_t  EEPROM_QUEUE_SIZE          = 16;                                      // Bytes waiting for the EE_READY ISR (EepromWriter)
+constexpr uint8_t  EEPROM_FENCE_SLOTS         = 4;                                       // writeBlock() completion callbacks pending at once
+
+// ---------------------------------------------------------------------------------
+//              Packet-mode command link (CC1101 FIFO, paired receivers only)
+// ---------------------------------------------------------------------------------
+constexpr uint8_t  PACKET_LINK_FOB_ADDRESS      = 0x01;                                   // ADDR register of this fob, ACKs are sent here
+constexpr uint8_t  PACKET_LINK_RECEIVER_ADDRESS = 0x10;                                   // Door receiver
+constexpr uint8_t  PACKET_LINK_MAX_PAYLOAD      = 61;                                     // 64-byte FIFO - length byte - 2 appended status bytes
+constexpr uint8_t  PACKET_LINK_ACK_FLAG         = 0x80;                                   // Set in the command byte of the receiver's ACK
+constexpr uint8_t  PACKET_LINK_MAX_ATTEMPTS     = 4;                                      // Initial try + 3 retransmissions
+constexpr uint16_t PACKET_LINK_ACK_TIMEOUT_MS   = 40;                                     // ACK airtime (25 ms) + receiver turnaround
+constexpr uint8_t  PACKET_LINK_BACKOFF_BASE_MS  = 8;                                      // Backoff = base << attempt + random(0..base)
+constexpr uint8_t  PACKET_LINK_NOISE_PIN        = 21;                                     // A7: analog-only on the Nano and left floating, its noise seeds random() per unit
+constexpr uint16_t PACKET_LINK_DATA_RATE_BAUD   = 4800;
+constexpr uint8_t  PACKET_LINK_OVERHEAD_BYTES   = 4 + 4 + 1 + 2;                         // Preamble + 30/32 sync (2x16 bits) + length + CRC-16
+
+// ---------------------------------------------------------------------------------
+//                      Serial-to-RF gateway mode
+// ---------------------------------------------------------------------------------
+constexpr uint32_t GATEWAY_BAUD_RATE    = 115200;
+constexpr uint8_t  GATEWAY_QUEUE_DEPTH  = 4;                                                // Power of two; credits granted to the host never exceed it
+constexpr uint8_t  GATEWAY_MAX_BODY     = 16;                                               // Longest TYPE..PAYLOAD section accepted by the parser
+constexpr uint16_t GATEWAY_TELEMETRY_INTERVAL_MS = 1000;                                    // Unsolicited TELEMETRY period (gateway builds have no text log)
+#ifndef GATEWAY_UNIT_ID
+#define GATEWAY_UNIT_ID 0x00000001UL                                                        // Give every unit its own id with -DGATEWAY_UNIT_ID=... so the host can tell ports apart
+#endif
+
 
 
 
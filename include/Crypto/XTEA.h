@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+#include "Config/Constants.h"
+
+/**
+ * @brief Table-free XTEA block cipher (64-bit block, 128-bit key) sized for the ATmega328.
+ *
+ * XTEA only needs 32-bit add/xor and the fixed shifts <<4 / >>5, so it has no S-box in flash
+ * and no data-dependent timing. The key schedule is the running `sum`, so nothing has to be
+ * expanded in SRAM either.
+ *
+ * Cycle budget (avr-gcc -Os, 16 MHz, estimated from the instruction count of one round):
+ *   - one Feistel round  ~ 190 cycles  (the two 32-bit shifts dominate)
+ *   - encrypt()          ~ 12.5k cycles = ~0.8 ms for XTEA_CYCLES = 32
+ *   RollingCodeGenerator::prepare() logs the measured time with LOG_VERBOSE.
+ * The shortest debounce confirmation is 10 samples x SAMPLE_RATE_DEBOUNCE (10 ms), so a block
+ * fits more than ten times inside the window. The firmware still encrypts ahead of the press
+ * (see RollingCodeGenerator::prepare()) so the cost never lands on the press path.
+ */
+class XTEA
+{
+    public:
+
+    /**
+     * @brief Encrypts one 64-bit block in place
+     *
+     * @param block - Two 32-bit halves {v0, v1}
+     * @param key - 128-bit key as four 32-bit words
+     */
+    static void encrypt(uint32_t (&block)[2], const uint32_t (&key)[4]);
+
+    /**
+     * @brief Decrypts one 64-bit block in place (used by the paired receiver firmware)
+     *
+     * @param block - Two 32-bit halves {v0, v1}
+     * @param key - 128-bit key as four 32-bit words
+     */
+    static void decrypt(uint32_t (&block)[2], const uint32_t (&key)[4]);
+
+    private:
+
+    static constexpr uint32_t DELTA = 0x9E3779B9;                   // Key schedule constant (golden ratio)
+
+    // F(v) = ((v << 4) ^ (v >> 5)) + v, the only non-linear part of the round
+    static inline uint32_t mix(uint32_t v) { return ((v << 4) ^ (v >> 5)) + v; }
+};
@@ -16,6 +16,11 @@ static constexpr size_t MAX_CALLBACKS = 4;
 // Callback type: zero arguments
 using Callback = void(*)();
 
+// Sample source type: returns true when input `id` reads "pressed" (replaces digitalRead)
+using SampleSource = bool(*)(uint8_t id);
+
+class DebounceTuner;
+
 class CircularDebounceBuffer {
 public:
     /**
@@ -40,15 +45,41 @@ public:
     // Change how many microseconds between samples
     void setSampleIntervalUs(uint32_t newDelayUs);
 
+    // Sample through `source(id)` instead of digitalRead(pin) (keypads, port expanders)
+    void setSampleSource(SampleSource source);
+
+    // Report every press to the tuner and follow the parameters it learns (nullptr to detach)
+    void attachTuner(DebounceTuner* tuner);
+
     // Called repeatedly (in loop()). Samples only once per interval.
     void update();
 
     // Arms debounce on the FALLING ISR to start a new debounce session
     void startDebounce();
 
+    // Both edges come from a CHANGE ISR through onEdge(): no sampling while the press is held,
+    // the release edge starts the release confirmation (same threshold as the press)
+    void enableEdgeCapture();
+
+    // CHANGE ISR: reads the pin and timestamps the edge. True while the edge belongs to an
+    // unconfirmed press (it armed the session or is one of its bounces)
+    bool onEdge();
+
+    // Register a zero-argument callback called once per confirmed release
+    void setReleaseCallback(Callback cb);
+
+    // Press edge -> release edge of the last confirmed press (edge capture; confirmation to confirmation otherwise)
+    uint32_t lastHoldUs() const;
+
+    // Time since the press edge while stably pressed, 0 otherwise
+    uint32_t heldUs() const;
+
     // Query the last debounced stable state (true=pressed, false=released)
     bool getStableState() const;
 
+    // True from startDebounce() until the release is confirmed (or, with edge capture, the edge was noise)
+    bool isDebouncing() const;
+
     // Re‐initialize everything (buffer, flags, timer). Useful if you want to reset.
     void reset();
 
@@ -66,8 +97,34 @@ private:
     Callback  _callbacks[MAX_CALLBACKS];
     size_t    _callbackCounter;
 
-    Delay     _delayBetweenSamples;   // Delay object (micros‐based)
+    Delay     _delayBetweenSamples;   // Delay object (Timebase ticks)
+    SampleSource _sampleSource;                          // nullptr = digitalRead(_pin)
+
+    // Bounce characterization of the current session (only used with a tuner attached)
+    DebounceTuner* _tuner;
+    uint32_t  _armedUs;                                  // Timebase::nowUs() of the edge that armed the session
+    uint32_t  _lastEdgeUs;                               // Timebase::nowUs() of the last level change before the press was confirmed
+    uint32_t  _pressedUs;                                // Timebase::nowUs() when the press was confirmed
+    uint8_t   _glitches;                                 // level changes seen before confirmation
+    bool      _lastSample;
+
+    // Dual-edge capture (enableEdgeCapture())
+    bool      _edgeCapture;                              // Release edges come from onEdge()
+    volatile bool _sampling;                             // Taking samples: press or release being confirmed
+    volatile bool _edgePressed;                          // Level read by the last onEdge()
+    volatile uint32_t _edgeUs;                           // Timebase::preciseUs() of the last onEdge()
+    uint32_t  _pressEdgeUs;                              // Edge that armed the session
+    uint32_t  _releaseEdgeUs;                            // Edge that started the release confirmation
+    uint32_t  _holdUs;                                   // Of the last confirmed press
+    uint8_t   _sessionSamples;                           // Samples since sampling (re)started, saturating
+    Callback  _releaseCallback;
 
     // Zero out the buffer and reset head to 0
     void clearBuffer();
+
+    // Interrupts off: buffer full of "pressed", sample until the release is confirmed
+    void beginRelease(uint32_t edgeUs);
+
+    // Stop sampling after a confirmation, unless the pin was released meanwhile
+    void pauseSampling();
 };
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+#include "Storage/EepromWriter.h"
+#include "Debugging/Logging.h"
+
+/// @brief Sampling parameters the debouncer runs with
+struct DebounceParams
+{
+    uint16_t sampleIntervalUs;
+    uint8_t  thresholdPercentage;
+};
+
+/**
+ * @brief Learns the bounce profile of one switch and picks the fastest debounce that stays clean.
+ *
+ * Per press the debouncer reports how long the contact bounced after the first edge, how many
+ * glitches (level changes) it saw, and how long the press was held. From that the tuner keeps:
+ *   - a log2 histogram of bounce durations (bin k holds bounces shorter than 512us << k),
+ *   - a running average of glitches per press,
+ *   - a running false-trigger rate: presses released before DEBOUNCE_MIN_HOLD_MS are contact
+ *     noise or a release bounce that got confirmed, not a finger.
+ *
+ * Retune rule:
+ *   window    = p95 bounce x (100 + margin) / 100     confirmation has to outlast the bounce
+ *   threshold = 60 % + 5 % per average glitch         a chattering contact needs a stronger majority
+ *   interval  = window / (threshold samples)          confirmation latency ~= window
+ * The margin grows while the false-trigger rate is above target and shrinks slowly once it is
+ * well below, so latency converges to the lowest value that meets the target.
+ *
+ * The learned parameters persist per input in EEPROM (CRC checked, written after they change,
+ * at most once every DEBOUNCE_TUNE_MIN_PRESSES presses).
+ *
+ * EEPROM layout (5 bytes per input, at DEBOUNCE_PROFILE_BASE_ADDR + id * 5):
+ *     [ interval LSB | interval MSB | threshold | margin | crc8 ]
+ */
+class DebounceTuner
+{
+    public:
+
+    /// @param inputId - Index of the input (debouncer id), selects the EEPROM profile
+    explicit DebounceTuner(uint8_t inputId);
+
+    DebounceParams begin();                                     // Loads the stored profile, or the SAMPLE_RATE/THRESHOLD_DEBOUNCE defaults
+    void recordPress(uint32_t bounceUs, uint8_t glitches, uint32_t holdMs);   // One finished press/release session
+    bool retune(DebounceParams& params);                        // True (and params updated) when the parameters changed
+
+    const DebounceParams& params() const { return _params; }
+    uint8_t histogram(uint8_t bin) const { return _histogram[bin]; }
+    uint8_t falseTriggerRateQ8() const { return _falseRateQ8; }
+
+    static constexpr uint8_t HISTOGRAM_BINS = 8;
+
+    private:
+
+    struct Profile
+    {
+        uint16_t sampleIntervalUs;
+        uint8_t  thresholdPercentage;
+        uint8_t  marginPercentage;
+        uint8_t  crc;
+    };
+
+    uint32_t bounceP95Us() const;
+    void persist();
+    uint16_t profileAddress() const;
+    static uint8_t crc8(const Profile& profile);
+
+    uint8_t        _inputId;
+    DebounceParams _params;
+    uint8_t        _marginPercentage;
+    uint8_t        _histogram[HISTOGRAM_BINS];
+    uint8_t        _glitchAvgQ4;                                // Glitches per press, x16
+    uint8_t        _falseRateQ8;                                // False triggers per press, x256
+    uint8_t        _pressesSinceChange;
+    uint8_t        _pressesSincePersist;
+    uint8_t        _presses;
+    bool           _falseTriggerPending;                        // Last recorded press was a false trigger
+    bool           _dirty;                                      // Parameters changed since the last EEPROM write
+};
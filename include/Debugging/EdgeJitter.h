@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Arduino.h>
+#include "interfaces/IBitEncoder.h"
+
+/// @brief Rising-edge period spread of one run, Timer1 ticks (0.5 us)
+struct EdgeJitterResult
+{
+    uint16_t minTicks;
+    uint16_t maxTicks;
+    uint16_t meanTicks;
+};
+
+/**
+ * @brief Jitter of the encoder output as it reaches GDO0 (D8 = PB0 = ICP1), with and without the
+ *        periodic ISRs.
+ *
+ * The encoder sends 25 '0' bits with interrupts enabled while the Timer1 input
+ * capture unit timestamps every rising edge of its own output (clk/8, 0.5 us). The capture is done
+ * by hardware, the capture ISR only stores ICR1 and costs the same on every edge, so the spread of
+ * the periods (max - min) is the jitter the other ISRs add to the pulses. Printed as
+ *   "JITTER <live|suspended> min=<ticks> max=<ticks> mean=<ticks> p2p=<ticks>"
+ * once with the Timer0 and Timebase ISRs running and once with them suspended.
+ *
+ * The radio must be out of TX (the pin toggles, nothing goes on air). Blocks ~2 x 125 ms with the
+ * SC41344 encoder; Timer1 is restored afterwards.
+ */
+void runEdgeJitterProfile(IBitEncoder& encoder, Print& out);
+
+/// @brief One capture run; suspendPeriodic masks the Timer0 / Timebase ISRs for its duration
+EdgeJitterResult measureEdgeJitter(IBitEncoder& encoder, bool suspendPeriodic);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Interrupt latency and jitter suite (-DISR_LATENCY_MODE, env:nanoatmega328_isr_latency).
+ *
+ * Each source is triggered ISR_LATENCY_TRIALS times under two loads:
+ *   idle   : Timer0 and Timebase ISRs masked, UART quiet: the source alone
+ *   loaded : periodic ISRs running and the UART sending, as in the application
+ * and timed on Timer1 (clk/1, one cycle, except where noted):
+ *
+ *   int1     the button handler through attachInterrupt(): D4 is toggled and a bench jumper
+ *            (D4 --1k-- D3) carries the edge to INT1, D3 stays the button's input. The probe takes
+ *            TCNT1 on entry and exit. Entry includes the core's dispatch. Without the jumper the
+ *            line reports n=0, followed by a "# int1: ..." reminder
+ *   spi      SPI_STC_vect with a one-byte transfer, CSn high (the chip ignores it). Entry is
+ *            counted from the end of the 8 SPI clocks. The firmware polls SPIF: this is what an
+ *            interrupt-driven bus would pay
+ *   timer1   WaveformStreamer's compare ISR streaming the open-door burst (radio idle, pin only):
+ *            GDO0 is ICP1, so the input capture stamps each rising edge in hardware and entry
+ *            is capture - deadline, at clk/8 (8 cycle steps)
+ *   timer0   the core's overflow ISR, and
+ *   timer2   the Timebase tick: no hook in their handlers, a foreground loop reading TCNT1 sees
+ *            each one as a gap; exec is the gap minus one loop pass (response and return included).
+ *            Measured alone, idle only: any other interrupt would merge into the gaps
+ *
+ * D7 is high while a probed handler (int1, spi) runs, for a scope. One line per source and load:
+ *   "ISR source=<s> load=<idle|loaded> n=<n> entry_min= entry_max= exec_min= exec_max= jitter="
+ * in CPU cycles, "-" where the method can not see the value; jitter = entry_max - entry_min
+ * (exec spread for the gap-timed sources). UART filler lines start with '#'.
+ *
+ * Call from setup() with interrupts on and the radio in IDLE. Timer1 and SPCR are restored, D4
+ * is left high-Z; the button handler is attached again on CHANGE. Blocks for about half a second.
+ */
+void runIsrLatencySuite(Print& out, void (*buttonHandler)());
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief CPU share taken by interrupt handlers while idle, in permille.
+ *
+ * Spins a counting loop for a fixed Timer1 window (ISR_LOAD_WINDOW_TICKS at clk/64) once with
+ * interrupts off and once with them on; every cycle an ISR takes is a loop iteration lost:
+ *   load = 1000 - 1000 x iterations(on) / iterations(off)
+ * Only the periodic handlers (timebase, UART, ADC...) are counted, so it compares the background
+ * cost of two builds. Blocks for twice the window (~100 ms); Timer1 is restored afterwards.
+ */
+uint16_t measureIsrLoadPermille();
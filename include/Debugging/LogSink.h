@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+
+static_assert(LOG_RING_SIZE >= 64 && (LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE must be a power of two >= 64");
+static_assert(LOG_RING_RESERVED < LOG_RING_SIZE / 2, "The error reserve must leave room for normal output");
+
+/**
+ * @brief Output backend of the LOG* macros: a RAM ring drained into Serial from the loop, never
+ *        waiting for the UART once the application runs.
+ *
+ * Serial.print() blocks as soon as the core's 64-byte TX buffer is full, so logging inside a
+ * retry loop or a timed path changes the timing it observes. Here:
+ *   - write() copies into a LOG_RING_SIZE ring (interrupts masked for a few cycles, ISR-safe)
+ *   - service(), called from loop(), moves what Serial can take without blocking
+ *   - DropWhenFull: a byte that does not fit is dropped and counted, and so is the rest of its
+ *     line; the part already queued is ended with a newline, never spliced with the next one.
+ *     The next service() with room reports the drops as "LOG dropped <n>"
+ *   - the last LOG_RING_RESERVED bytes only take error output (LOG_ERROR*, Urgent scope): an
+ *     error is not lost behind a burst of verbose logging, nor behind the cut line it interrupts
+ *   - WriteThrough (the default, for setup()): straight to Serial like before, blocking, so boot
+ *     logs are complete and stay in order with the diagnostic reports printed on Serial. main
+ *     switches to DropWhenFull when the application starts
+ *
+ * Worst-case cost of a LOG is its length in ring copies; the ring is only built with -DDEBUG.
+ */
+class LogSink : public Print
+{
+    public:
+
+    enum class Policy : uint8_t { WriteThrough, DropWhenFull };
+
+    /// @brief Error output: may use the reserved bytes for its lifetime
+    class Urgent
+    {
+        public:
+        Urgent();
+        ~Urgent();
+
+        private:
+        bool _previous;
+        bool _resumeDropping;                                   // A cut line was being dropped before
+    };
+
+    using Print::write;
+    size_t write(uint8_t byte) override;
+    int availableForWrite() override;
+
+    void service();                                             // Non-blocking drain into Serial
+    void flush();                                               // Blocking drain
+    void setPolicy(Policy policy);
+
+    uint16_t pending() const;                                   // Bytes waiting in the ring
+    uint32_t dropped() const;                                   // Since boot
+
+    private:
+
+    void drainOne();
+    void endCutLine();
+    uint16_t used() const;
+
+    volatile uint8_t _ring[LOG_RING_SIZE];
+    volatile uint16_t _head = 0;
+    volatile uint16_t _tail = 0;
+    volatile uint32_t _dropped = 0;
+    volatile uint16_t _unreported = 0;                          // Dropped since the last "LOG dropped" line
+    volatile bool     _droppingLine = false;
+    volatile bool     _urgent = false;
+    Policy            _policy = Policy::WriteThrough;
+};
+
+extern LogSink DebugLog;
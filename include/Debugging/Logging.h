@@ -1,17 +1,25 @@
 #pragma once
 #include<Arduino.h>
 #if DEBUG
-   #define LOG(message) do { Serial.print(F(message)); } while(0)
-   #define LOG_NEW_LINE(message) do { Serial.println(F(message)); } while(0)
-   #define LOG_DYNAMIC(message) do { Serial.println(message); } while(0)
-   #define LOG_PAIR_DEC(name, val) do { Serial.print(F(name ": ")); Serial.println(val, DEC); } while(0)
-   #define LOG_PAIR_HEX(name, val) do { Serial.print(F(name ": 0x")); Serial.println(val, HEX); } while(0)
-   #define LOG_PAIR_BIN(name, val) do { Serial.print(F(name ": 0b")); Serial.println(val, BIN); } while(0)
-   #define NEW_LINE() do { Serial.println(); } while(0)
+   #include "Debugging/LogSink.h"
+   #define LOG(message) do { DebugLog.print(F(message)); } while(0)
+   #define LOG_NEW_LINE(message) do { DebugLog.println(F(message)); } while(0)
+   #define LOG_DYNAMIC(message) do { DebugLog.println(message); } while(0)
+   #define LOG_PAIR_DEC(name, val) do { DebugLog.print(F(name ": ")); DebugLog.println(val, DEC); } while(0)
+   #define LOG_PAIR_HEX(name, val) do { DebugLog.print(F(name ": 0x")); DebugLog.println(val, HEX); } while(0)
+   #define LOG_PAIR_BIN(name, val) do { DebugLog.print(F(name ": 0b")); DebugLog.println(val, BIN); } while(0)
+   #define NEW_LINE() do { DebugLog.println(); } while(0)
+   // Errors may use the reserved end of the ring: not lost behind verbose output
+   #define LOG_ERROR(message) do { LogSink::Urgent urgent; DebugLog.println(F(message)); } while(0)
+   #define LOG_ERROR_DYNAMIC(message) do { LogSink::Urgent urgent; DebugLog.println(message); } while(0)
 #else
    #define LOG(message)
    #define LOG_NEW_LINE(message)
    #define LOG_DYNAMIC(message)
    #define LOG_PAIR_DEC(name, val)
    #define LOG_PAIR_HEX(name, val)
-#endif
\ No newline at end of file
+   #define LOG_PAIR_BIN(name, val)
+   #define NEW_LINE()
+   #define LOG_ERROR(message)
+   #define LOG_ERROR_DYNAMIC(message)
+#endif
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Transciever/CC1101_Transceiver.h"
+#include "interfaces/IBitEncoder.h"
+#include "SPI/SpiTrace.h"
+#include "Config/CC1101_Config/CC1101_315MHZ_OOK_Config.h"
+
+/// @brief The budgets, shared with the host model check (tools/spi_budget)
+namespace SpiBudget
+{
+    // ---------------------------------------------------------------------------------
+    //  Cost of the SPIBus primitives on a healthy bus (no retry), as the Transceiver uses them
+    // ---------------------------------------------------------------------------------
+    constexpr SpiTraffic READ           { 1, 2, 1 };                                // readRegister / readStatusRegister: header + value
+    constexpr SpiTraffic WRITE          = SpiTraffic{ 1, 2, 1 } + READ;             // writeRegister: header + value, then the read-back verify
+    constexpr SpiTraffic FAST_STROBE    { 2, 1, 2 };                                // strobeFast: transferByte() inside applyTransaction()
+    constexpr SpiTraffic STROBE         = FAST_STROBE + READ;                       // strobeCommand: the same, then the PARTNUM check
+    constexpr SpiTraffic PATABLE_BURST  { 1, 9, 1 };                                // Header + 8 power levels
+    constexpr SpiTraffic CSN_PULSE      { 0, 0, 2 };                                // Manual CSn LOW / HIGH / LOW of the reset sequence
+
+    constexpr uint16_t verifiedRegisters()                                          // Registers begin() reads back
+    {
+        uint16_t count = 0;
+        for (const RegisterSettings& setting : Config_315MHz_OOK::setting_Regs) count += setting.verify ? 1 : 0;
+        return count;
+    }
+
+    constexpr SpiTraffic RESET          = CSN_PULSE + STROBE + READ;                // SRES, then PARTNUM
+    constexpr SpiTraffic SET_POWER      = PATABLE_BURST + READ + WRITE;             // PATABLE, FREND0 read-modify-write
+    constexpr SpiTraffic BEGIN          = RESET
+                                        + WRITE * Config_315MHz_OOK::setting_Regs.size()
+                                        + READ * verifiedRegisters()
+                                        + SET_POWER
+                                        + READ * 2;                                 // PARTNUM + VERSION
+    constexpr SpiTraffic SET_FREQUENCY  = WRITE * 3;                                // FREQ2..0
+    constexpr SpiTraffic STATUS_POLL    = READ;                                     // The loop's once-a-second readMarcState()
+
+    // The press path. prepareTxSession() polls MARCSTATE until FSTXON for up to TX_PREPARE_TIMEOUT_US:
+    // a status read is at least 2 bytes of 8 us (1 MHz SPI clock at most), so there is a hard cap on the polls
+    constexpr uint16_t SPI_BYTE_US      = 8;
+    constexpr uint16_t PREPARE_POLLS    = TX_PREPARE_TIMEOUT_US / (READ.bytes * SPI_BYTE_US) + 1;
+    constexpr SpiTraffic PREPARE        = READ + FAST_STROBE + READ * PREPARE_POLLS;// MARCSTATE idle, SFSTXON, polls
+    constexpr SpiTraffic CANCEL         = FAST_STROBE;                              // SIDLE of a rejected press
+    constexpr SpiTraffic CLOSE          = STROBE;                                   // SIDLE at the end (the burst itself is GDO0 only)
+    constexpr SpiTraffic PREPARED_ENTRY = READ + FAST_STROBE + READ * TX_ENTRY_POLLS;// Still FSTXON, STX, TX confirmed
+    constexpr SpiTraffic PREPARED_FRAME = PREPARED_ENTRY + CLOSE;
+    constexpr SpiTraffic TRANSMIT_FRAME = READ + STROBE + STROBE                    // Full entry: MARCSTATE, SIDLE if not idle, STX,
+                                        + READ * PREPARE_POLLS + CLOSE;             // TX awaited through the calibration
+
+    // The prep only pays off if its worst-case entry on the bus is shorter than the calibration it
+    // takes off the press path (IDLE -> FSTXON, 809 us typ. with MCSM0 auto-calibration)
+    constexpr uint16_t CALIBRATION_US   = 809;
+    static_assert(PREPARED_ENTRY.bytes * SPI_BYTE_US < CALIBRATION_US, "The prepared TX entry polls longer than the calibration it saves");
+}
+
+/**
+ * @brief SPI traffic budgets of the high-level Transceiver operations, checked on the real radio and
+ *        against the host CC1101 model (tools/spi_budget, `make -C tools test`).
+ *
+ * Each operation runs once between two SpiTrace resets (-DSPI_BUDGET_MODE) and its transactions,
+ * bytes and CSn cycles are compared with a budget built from the cost of the SPIBus primitives it
+ * is supposed to use (SpiBudget namespace above). A healthy exchange stays within the budget; a retry, an
+ * extra verify read or a new register access goes over it. Printed as
+ *   "SPI <op> tx=<n>/<budget> bytes=<n>/<budget> csn=<n>/<budget> <OK|OVER>"
+ * and, for an operation over budget, the first byte of each of its transactions in order:
+ *   "SPI <op> log <header> <header> ...[ +]"           (" +" = log full, more transactions)
+ * then "SPI budget <PASS|FAIL>".
+ *
+ * Operations, the calls the firmware makes: begin, setFrequency, setPowerLevel, status (the loop's
+ * MARCSTATE poll), then the press path: prepare (speculative FSTXON while debouncing), cancel (a
+ * rejected press), preparedFrame (the open-door code through `encoder` after a prepare, so it goes
+ * on air) and transmitFrame (the same with the full TX entry, the modes without a prep). Run it at
+ * boot or from test/test_spi_budget (`pio test -e nanoatmega328_test`), it re-initializes the radio.
+ *
+ * @return true if every operation stayed within its budget
+ */
+bool runSpiBudgetCheck(Transceiver& transceiver, IBitEncoder& encoder, Print& out);
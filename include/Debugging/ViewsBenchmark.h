@@ -0,0 +1,21 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Cycle counts of avr_algorithms::views pipelines against the hand-written loops they replace.
+ *
+ * Each case is a pair of noinline functions (hand loop / view pipeline) computing the same result,
+ * timed with Timer1 at clk/1 (1 tick = 1 cycle) with interrupts off, and printed as
+ *   "<case> hand=<cycles> views=<cycles> <same|DIFF>"
+ *
+ * Code size of the same pairs comes from the linker, not at run time:
+ *   avr-nm --size-sort -S -C .pio/build/nanoatmega328/firmware.elf | grep ViewsBench
+ *
+ * Cases:
+ *   - bits   : set bits of a packed 24-bit code             (bits() | count_if)
+ *   - flash  : XOR of a waveform program read from PROGMEM  (stored<PROGMEMStoragePolicy> | fold)
+ *   - hex    : 16 bytes rendered as 32 hex digits           (nibbles() | transform | copy_to)
+ *   - filter : first 4 bytes above a threshold, summed      (span | filter | take | fold)
+ */
+void runViewsBenchmark(Print& out);
@@ -1,19 +1,20 @@
 #pragma once
 
 #include <Arduino.h>
+#include "Delay/Timebase.h"
 
 class Delay{
   private:
-    unsigned long delayTime;          // us
-    unsigned long previousTime;      // us
+    uint32_t delayTicks;              // Timebase ticks
+    uint32_t previousTicks;           // Timebase ticks
   public:
     Delay(){}                         // Empty Constructor. Do not used
-    Delay(unsigned long delayTime);   // Constructor
+    Delay(unsigned long delayTime);   // Constructor (us, rounded to the nearest Timebase tick)
     
     void init();     
     void init(unsigned long delayTime);                                     // Configure the internal varialbles of the class to keep track the time
     bool isDelayTimeElapsed();                                                // returns true when the time set for the Delay has elapsed
     
-    void updateDelayTime(unsigned long newDelayTime);          // set a new time for the Delay
+    void updateDelayTime(unsigned long newDelayTime);          // set a new time for the Delay (us)
     void restartTimer();                                                            // returns true when the delay time has elapse and reset the counter time
 };
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+
+// Static state that belongs to the board rather than the program: thread_local on the host HAL,
+// where each thread runs a board of its own (hal/host), nothing on the chip
+#ifndef PER_BOARD
+#define PER_BOARD
+#endif
+
+static_assert(TIMEBASE_TICK_US > 0 && 1000 % TIMEBASE_TICK_US == 0, "A millisecond must be a whole number of ticks");
+static_assert(DEBOUNCE_MIN_INTERVAL_US >= TIMEBASE_TICK_US, "The fastest debounce sample interval needs at least one tick");
+
+/**
+ * @brief Application timebase on Timer2 (CTC, one compare ISR per TIMEBASE_TICK_US).
+ *
+ * Replaces micros()/millis() for Delay, the debouncer, the application state machine and the radio
+ * driver's timeouts:
+ *   - the ISR is a single 32-bit increment (no fractional bookkeeping like the core's Timer0)
+ *   - ticks() is lock-free: the counter is read twice until both reads agree, so a read never
+ *     masks interrupts and is safe from ISRs and from the loop alike
+ *   - the tick is a compile-time constant, resolution and ISR rate are traded in Constants.h
+ *
+ * Timed bursts that keep interrupts enabled (UART RX must keep running) can suspend the periodic
+ * ISRs, this timebase, Timer0 and an auto-triggered ADC (Input/LadderKeypad), for the duration of
+ * the burst. resume() advances the count by
+ * the time the caller kept them off, so the timebase does not lose the burst. Suspensions do not
+ * nest. Timer0 based millis()/micros() do stall while suspended.
+ *
+ * Intervals are differences of unsigned reads (ticks() or nowUs()); nowMs() is for reporting.
+ * preciseUs() adds the Timer2 count to the tick (2 us at 16 MHz) for timestamps that must be
+ * finer than a tick; it masks interrupts for a few cycles.
+ *
+ * While suspended the count only moves through advance(): simulations run the real Delay and
+ * debounce code on virtual time, as fast as the CPU goes. beginVirtual() does the same for a whole
+ * running firmware (trace replay): only the Timer2 tick is masked, and a suspend() / resume()
+ * pair inside it advances the count by the suspended time without unmasking the tick.
+ *
+ * delayUs() / delayMs() are the timed waits of the drivers and the encoders: delayMicroseconds()
+ * and delay() on the chip, a move of the virtual count in a trace replay build. The count moves
+ * as the tick would have counted the wait: not while suspended (resume() accounts the time), not
+ * with interrupts off (the masked tick is lost on the chip as well). A replayed burst or radio
+ * timeout then takes no wall time and lands where it did in the field.
+ *
+ * @example
+ *   Timebase::begin();
+ *   uint32_t start = Timebase::ticks();
+ *   if (Timebase::ticks() - start >= Timebase::usToTicks(5000)) { ... }
+ *
+ *   Timebase::suspend();
+ *   streamBurst();
+ *   Timebase::resume(burstUs);
+ */
+class Timebase
+{
+    public:
+
+    static constexpr uint32_t TICK_US      = TIMEBASE_TICK_US;
+    static constexpr uint32_t TICKS_PER_MS = 1000 / TIMEBASE_TICK_US;
+
+    static void begin();                                        // Timer2 CTC + compare interrupt
+
+    static inline uint32_t ticks()
+    {
+        uint32_t first;
+        uint32_t second;
+        do
+        {
+            first  = _ticks;
+            second = _ticks;
+        } while (first != second);                              // A torn read can not match the read after it
+        return first;
+    }
+
+    static inline uint32_t nowUs() { return ticks() * TICK_US; }
+    static inline uint32_t nowMs() { return ticks() / TICKS_PER_MS; }
+    static uint32_t preciseUs();                                // nowUs() refined by the Timer2 count: edge timestamps
+
+    static constexpr uint32_t usToTicks(uint32_t us) { return (us + TICK_US / 2) / TICK_US; }     // Nearest
+    static constexpr uint32_t msToTicks(uint32_t ms) { return ms * TICKS_PER_MS; }
+
+    static void suspend();                                      // Masks the Timer2 compare and every Timer0 interrupt, stops the ADC auto trigger
+    static void resume(uint32_t elapsedUs);                     // Restores them, accounts the suspended time
+    static bool suspended();
+    static void advance(uint32_t ticks);                        // Virtual time for simulations, while suspended or virtual
+    static void beginVirtual();                                 // Tick masked until endVirtual(): the count only moves through advance() / resume() / delayUs()
+    static void endVirtual();
+    static inline bool isVirtual() { return _virtual; }
+
+    static inline void delayUs(uint16_t us)
+    {
+#ifdef TRACE_REPLAY_MODE
+        if (_virtual)
+        {
+            virtualDelay(us);
+            return;
+        }
+#endif
+        delayMicroseconds(us);
+    }
+
+    static inline void delayMs(uint16_t ms)
+    {
+#ifdef TRACE_REPLAY_MODE
+        if (_virtual)
+        {
+            virtualDelay(ms * 1000UL);
+            return;
+        }
+#endif
+        delay(ms);
+    }
+
+    static inline void onTick() { _ticks = _ticks + 1; }       // Timer2 compare ISR only
+
+    private:
+
+    static void virtualDelay(uint32_t us);
+
+    static PER_BOARD volatile uint32_t _ticks;
+    static PER_BOARD uint8_t _savedTIMSK0;
+    static PER_BOARD uint8_t _savedADCSRA;
+    static PER_BOARD bool    _suspended;
+    static PER_BOARD bool    _virtual;
+    static PER_BOARD uint16_t _virtualUs;                       // Waited on virtual time, not a whole tick yet
+};
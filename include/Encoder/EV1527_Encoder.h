@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+#include "Config/DigitalPin.h"
+#include "interfaces/IBitEncoder.h"
+#include "Debugging/Logging.h"
+
+/**
+ * @class EV1527_Encoder
+ * @brief Implement the IBitEncoder interface to generate EV1527 / PT2262-style learning-code waveforms
+ *
+ * Every symbol is a multiple of the base pulse T (EV1527_BASE_PULSE_US):
+ *      '0'   :  T HIGH + 3T LOW
+ *      '1'   : 3T HIGH +  T LOW
+ *      'OPEN':  PT2262 floating digit ('0' followed by '1')
+ *      SYNC  :  T HIGH + 31T LOW, emitted through sendPreamble() before every word
+ *
+ * @note The pin must be configured as OUTPUT via begin() before sending waveforms.
+ * @note Resting state is LOW (carrier off) unlike SC41344.
+ */
+class EV1527_Encoder: public IBitEncoder
+{
+    public:
+
+    /**
+     * @brief Construct a new EV1527 encoder object
+     *
+     * @param pinPort_GDO0 - DigitalPin object that holds a reference to the  port pin where the CC1101 GDO0 pin is connected
+     */
+    EV1527_Encoder(DigitalPin& pinPort_GDO0);
+
+    /**
+     * @brief Configs the output pin and parks it in the idle level
+     *
+     */
+    void begin();
+
+    // -------------------------------------
+    // Inherit method vie IBitEncoder
+    // -------------------------------------
+    void sendOne() override;
+    void sendZero() override;
+    void sendOpen() override;
+    void sendSilence() override;
+    void sendPreamble()override;
+    void setIdle() override;
+
+    private:
+
+    // Emits one HIGH pulse followed by a LOW gap
+    void pulse(uint16_t highUs, uint16_t lowUs);
+
+    DigitalPin& _GDO0_pin;          // Reference to the DigitalPin object controlling the output pin (e.g., D8).
+
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Gateway/GatewayProtocol.h"
+
+/**
+ * @brief Decoders for the GatewayProtocol framing, shared by the firmware and the host tools.
+ *
+ * Two flavours over the same format:
+ *   - scanFrames()        : zero-copy, for callers that already hold the bytes in a contiguous buffer
+ *                           (host ring buffers, tools/gateway_daemon). Frames are reported as views
+ *                           into that buffer and an incomplete tail is left unconsumed for the next call.
+ *   - StreamFrameParser   : byte-at-a-time state machine for the firmware, where bytes come one by one
+ *                           from the UART and there is no buffer to point into.
+ */
+namespace GatewayProtocol
+{
+    /// @brief Longest TYPE..PAYLOAD the gateway ever sends (host side bound; the firmware only parses requests)
+    constexpr uint8_t MAX_REPLY_BODY = 2 + sizeof(GatewayStats);
+
+    /// @brief Decoded frame. `payload` points into the scanned buffer (scanFrames) or the parser body.
+    struct FrameView
+    {
+        uint8_t        type;
+        uint8_t        sequence;
+        const uint8_t* payload;
+        uint8_t        length;
+    };
+
+    /**
+     * @brief Finds every complete, CRC-valid frame in [data, data + length) without copying.
+     *
+     * @tparam MaxBody - Longest LEN accepted; anything above is treated as line noise
+     * @tparam OnFrame - Callable void(const FrameView&)
+     * @param data - Received bytes
+     * @param length - Number of bytes available
+     * @param onFrame - Called for each valid frame, in order
+     * @param framingErrors - Incremented for each bad length / CRC (the scan resynchronises on the next SOF)
+     * @return size_t - Bytes consumed; the caller keeps data[consumed..length) for the next call
+     */
+    template<uint8_t MaxBody, typename OnFrame>
+    size_t scanFrames(const uint8_t* data, size_t length, OnFrame&& onFrame, uint32_t& framingErrors)
+    {
+        size_t pos = 0;
+        while (pos < length)
+        {
+            if (data[pos] != SOF) { ++pos; continue; }
+
+            if (pos + 1 >= length) break;                                   // Need LEN
+            uint8_t bodyLength = data[pos + 1];
+            if (bodyLength < 2 || bodyLength > MaxBody)
+            {
+                ++framingErrors;
+                ++pos;
+                continue;
+            }
+
+            size_t frameEnd = pos + 2 + bodyLength + 1;
+            if (frameEnd > length) break;                                   // Incomplete, keep it
+
+            uint8_t crc = crc8(0, bodyLength);
+            for (size_t i = pos + 2; i < frameEnd - 1; ++i) crc = crc8(crc, data[i]);
+
+            if (crc != data[frameEnd - 1])
+            {
+                ++framingErrors;
+                ++pos;
+                continue;
+            }
+
+            onFrame(FrameView{ data[pos + 2], data[pos + 3], &data[pos + 4], static_cast<uint8_t>(bodyLength - 2) });
+            pos = frameEnd;
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Incremental parser fed one byte at a time (firmware UART path).
+     *
+     * @tparam MaxBody - Longest LEN accepted, sizes the body buffer
+     */
+    template<uint8_t MaxBody>
+    class StreamFrameParser
+    {
+        public:
+
+        /// @brief Feeds one byte; returns true when it completed a valid frame (read it with frame())
+        bool feed(uint8_t byte)
+        {
+            switch (_state)
+            {
+                case State::WaitSof:
+                    if (byte == SOF) _state = State::Length;
+                    return false;
+
+                case State::Length:
+                    if (byte < 2 || byte > MaxBody)                         // TYPE + SEQ at least
+                    {
+                        ++_framingErrors;
+                        _state = State::WaitSof;
+                        return false;
+                    }
+                    _length   = byte;
+                    _received = 0;
+                    _crc      = crc8(0, byte);
+                    _state    = State::Body;
+                    return false;
+
+                case State::Body:
+                    _body[_received++] = byte;
+                    _crc = crc8(_crc, byte);
+                    if (_received == _length) _state = State::Crc;
+                    return false;
+
+                case State::Crc:
+                    _state = State::WaitSof;
+                    if (byte == _crc) return true;
+                    ++_framingErrors;
+                    return false;
+            }
+            return false;
+        }
+
+        FrameView frame() const { return FrameView{ _body[0], _body[1], &_body[2], static_cast<uint8_t>(_length - 2) }; }
+        uint32_t framingErrors() const { return _framingErrors; }
+        void resetErrors() { _framingErrors = 0; }
+
+        private:
+
+        enum class State : uint8_t { WaitSof, Length, Body, Crc };
+
+        State    _state = State::WaitSof;
+        uint8_t  _length = 0;
+        uint8_t  _received = 0;
+        uint8_t  _crc = 0;
+        uint8_t  _body[MaxBody];
+        uint32_t _framingErrors = 0;
+    };
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#ifdef __AVR__
+#include <util/crc16.h>
+#endif
+#include "Config/Constants.h"
+
+/**
+ * @brief Binary framing between the host and the RF gateway (UART, 115200 8N1).
+ *
+ *   [ SOF 0x7E ][ LEN ][ TYPE ][ SEQ ][ PAYLOAD ... ][ CRC8 ]
+ *                 |<-------- LEN bytes -------->|
+ *   CRC8 = CRC-8/CCITT over LEN..PAYLOAD.
+ *
+ * Flow control is credit based: every ACCEPTED / REJECTED reply carries the number of free
+ * queue slots, and the host never has more un-acknowledged TRANSMIT frames in flight than the
+ * last credit it received. With GATEWAY_QUEUE_DEPTH frames in flight the whole burst fits the
+ * Arduino core's 64-byte RX buffer, so nothing is lost while a frame is being streamed.
+ *
+ * The header has no Arduino dependency so host tools (fleet daemon, load generator) decode the
+ * same frames with the same code.
+ */
+namespace GatewayProtocol
+{
+    constexpr uint8_t SOF = 0x7E;
+
+    // Host -> gateway
+    namespace Request
+    {
+        constexpr uint8_t TRANSMIT    = 0x01;     // payload: family id + code bits packed MSB first
+        constexpr uint8_t GET_STATS   = 0x02;
+        constexpr uint8_t RESET_STATS = 0x03;
+        constexpr uint8_t IDENTIFY    = 0x04;     // Ask for the unit id (answered with TELEMETRY)
+    }
+
+    // Gateway -> host
+    namespace Reply
+    {
+        constexpr uint8_t ACCEPTED = 0x81;        // payload: credits
+        constexpr uint8_t REJECTED = 0x82;        // payload: reason, credits
+        constexpr uint8_t COMPLETE = 0x83;        // payload: status (1 = sent), queue depth left
+        constexpr uint8_t STATS    = 0x84;        // payload: GatewayStats (little endian)
+        constexpr uint8_t TELEMETRY= 0x85;        // payload: Telemetry (little endian), sent every GATEWAY_TELEMETRY_INTERVAL_MS
+    }
+
+    // REJECTED reasons
+    namespace Reason
+    {
+        constexpr uint8_t QUEUE_FULL     = 0x01;
+        constexpr uint8_t BAD_FAMILY     = 0x02;
+        constexpr uint8_t BAD_LENGTH     = 0x03;
+        constexpr uint8_t UNKNOWN_TYPE   = 0x04;
+    }
+
+    /// @brief Code families the gateway can stream, selected per command
+    enum class Family : uint8_t
+    {
+        SC41344_8  = 0,
+        SC41344_12 = 1,
+        SC41344_16 = 2,
+        SC41344_24 = 3,
+        EV1527     = 4
+    };
+
+    /// @brief Word length of a family id, 0 if unknown
+    constexpr uint8_t familyBits(uint8_t family)
+    {
+        switch (static_cast<Family>(family))
+        {
+            case Family::SC41344_8:  return 8;
+            case Family::SC41344_12: return 12;
+            case Family::SC41344_16: return 16;
+            case Family::SC41344_24: return 24;
+            case Family::EV1527:     return 24;
+            default:                 return 0;
+        }
+    }
+
+    constexpr uint8_t MAX_CODE_BYTES = 3;                                        // 24 bits packed
+    constexpr uint8_t FRAME_OVERHEAD = 5;                                        // SOF + LEN + TYPE + SEQ + CRC
+    constexpr uint8_t MAX_TRANSMIT_FRAME = FRAME_OVERHEAD + 1 + MAX_CODE_BYTES;  // 9 bytes
+
+    #ifndef SERIAL_RX_BUFFER_SIZE
+    constexpr uint8_t RX_BUFFER_BYTES = 64;                                      // Arduino AVR core default
+    #else
+    constexpr uint8_t RX_BUFFER_BYTES = SERIAL_RX_BUFFER_SIZE;
+    #endif
+
+    static_assert(GATEWAY_QUEUE_DEPTH * MAX_TRANSMIT_FRAME <= RX_BUFFER_BYTES,
+                  "Credits would let the host overrun the UART RX buffer while a frame is streamed");
+    static_assert(1 + 1 + 1 + MAX_CODE_BYTES <= GATEWAY_MAX_BODY, "Parser body too small for TRANSMIT");
+
+    /// @brief CRC-8/CCITT (poly 0x07) step, avr-libc's optimized version on target
+    inline uint8_t crc8(uint8_t crc, uint8_t data)
+    {
+    #ifdef __AVR__
+        return _crc8_ccitt_update(crc, data);
+    #else
+        crc ^= data;
+        for (uint8_t i = 0; i < 8; ++i) crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+        return crc;
+    #endif
+    }
+}
+
+/// @brief Counters reported with Reply::STATS. Packed so a host build sees the AVR wire layout.
+struct __attribute__((packed)) GatewayStats
+{
+    uint32_t received;              // TRANSMIT frames accepted into the queue
+    uint32_t executed;              // Frames streamed on air
+    uint32_t rejected;              // TRANSMIT frames refused (queue full, bad family...)
+    uint32_t framingErrors;         // CRC / length errors seen by the parser
+    uint32_t firstCommandMs;        // millis() when the first accepted command was started
+    uint32_t lastCompleteMs;        // millis() when the last command completed
+    uint8_t  queueHighWater;        // Deepest queue level observed
+};
+
+/// @brief Periodic health record of one unit, decoded by the host fleet daemon
+struct __attribute__((packed)) Telemetry
+{
+    uint32_t unitId;                // Per-unit serial so the host can map ports to units
+    uint32_t uptimeMs;
+    uint32_t executed;              // Same counter as GatewayStats::executed
+    uint8_t  marcState;             // CC1101 MARCSTATE
+    uint8_t  queueDepth;
+    uint8_t  framingErrors;         // Saturating copy of GatewayStats::framingErrors
+};
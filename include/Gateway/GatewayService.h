@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gateway/GatewayProtocol.h"
+#include "Gateway/FrameParser.h"
+#include "Transciever/CC1101_Transceiver.h"
+#include "Encoder/SC41344_Encoder.h"
+#include "Encoder/EV1527_Encoder.h"
+#include "utils/RingBuffer.h"
+#include "Delay/Timebase.h"
+
+/**
+ * @brief Serial-to-RF gateway: ingests framed TRANSMIT commands from the host and streams them back-to-back.
+ *
+ * - poll()    : non-blocking, drains the UART, parses frames, queues commands and answers with credits
+ * - service() : if the queue is not empty, opens one TX session and keeps the radio in TX while
+ *               commands keep arriving (poll() runs between frames), reporting COMPLETE per command;
+ *               when idle, emits a TELEMETRY frame every GATEWAY_TELEMETRY_INTERVAL_MS
+ *
+ * Interrupts stay enabled while streaming: the UART RX ISR must keep filling the core buffer. The
+ * periodic ISRs (Timer0, Timebase) are suspended for each burst so they do not jitter the pulse
+ * edges; times are Timebase::nowMs(), which accounts for the suspended bursts. The fob's own
+ * button burst goes out the same way in gateway builds (transmitOpenDoor() in main.cpp).
+ *
+ * @example
+ *   GatewayService gateway(Serial, transceiver, sc41344Encoder, ev1527Encoder);
+ *   gateway.begin();
+ *   loop() { gateway.poll(); gateway.service(); }
+ */
+class GatewayService
+{
+    public:
+
+    GatewayService(HardwareSerial& serial, Transceiver& transceiver, SC41344_Encoder& sc41344, EV1527_Encoder& ev1527);
+
+    void begin();                                   // Opens the UART at GATEWAY_BAUD_RATE
+    void poll();                                    // Parse incoming bytes (never blocks on input)
+    void service();                                 // Execute the queued commands in one TX session
+    const GatewayStats& stats() const;
+
+    private:
+
+    /// @brief Queued TRANSMIT command, code kept packed until it is streamed
+    struct Command
+    {
+        uint8_t sequence;
+        uint8_t family;
+        uint8_t code[GatewayProtocol::MAX_CODE_BYTES];
+    };
+
+    void handleFrame(const GatewayProtocol::FrameView& frame);
+    bool execute(const Command& command);
+    void sendFrame(uint8_t type, uint8_t sequence, const uint8_t* payload, uint8_t length);
+    void sendStats(uint8_t sequence);
+    void sendTelemetry(uint8_t sequence);
+
+    // Unpacks the first Bits of the packed code and streams it as Family
+    template<typename Family>
+    void streamPacked(const uint8_t* packed, IBitEncoder& encoder);
+
+    HardwareSerial&  _serial;
+    Transceiver&     _transceiver;
+    SC41344_Encoder& _sc41344;
+    EV1527_Encoder&  _ev1527;
+
+    RingBuffer<Command, GATEWAY_QUEUE_DEPTH> _queue;
+    GatewayStats     _stats;
+    GatewayProtocol::StreamFrameParser<GATEWAY_MAX_BODY> _parser;
+    uint32_t         _lastTelemetryMs;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+#include "Debounce/CircularDebounceBuffer.h"
+
+/**
+ * @brief Resistor-ladder keypad: LADDER_BUTTON_COUNT buttons on one analog pin, no interrupt pin needed.
+ *
+ * The ADC runs free (auto-trigger, prescaler 128 -> 125 kHz ADC clock, 13 cycles per conversion
+ * = 104 us, ~9.6 kS/s) with the result left adjusted so the ISR reads ADCH only. Each ISR:
+ *   1) maps the reading to a band (edges are the midpoints between LADDER_LEVELS),
+ *   2) only accepts a *different* band once the reading is LADDER_HYSTERESIS counts inside it,
+ *      so noise around an edge can not toggle between two buttons,
+ *   3) on a change to a button, arms that button's debouncer - the ADC equivalent of the
+ *      FALLING edge ISR used by the direct button.
+ * The debouncers sample isPressed(id) through their sample source, so presses go through the
+ * same debounce / callback pipeline as BUTTON_HOME_DOOR_GARAGE_PIN.
+ *
+ * Measuring (build with -DLADDER_PROFILING):
+ *   - ISR cost     : PD7 is high for the whole ISR; pulse width on a logic analyzer is the cost
+ *                    per conversion, its period is the conversion rate.
+ *   - Decode latency: lastBandChangeUs() is micros() of the conversion that changed band; the
+ *                    press callback compares it with micros() at confirmation.
+ *   Latency budget: <= 1 conversion (104 us) to see the band + the debounce window
+ *   (threshold samples x sample interval, ~10 ms with the defaults).
+ *
+ * Cost when nothing happens: free running, the ISR wakes an idle CPU 9600 times a second. While
+ * the application sleeps with no ladder press in progress, setSleeping(true) paces conversions on
+ * the Timer0 overflow instead (one per 1.024 ms, right after the wake-up the millis tick causes
+ * anyway): a press from sleep is seen up to ~1.1 ms later, then the ADC runs free again. During a
+ * Timebase::suspend() burst the auto trigger is stopped altogether (Delay/Timebase), so no ADC ISR
+ * lands between two edges.
+ *
+ * @example
+ *   LadderKeypad keypad;
+ *   keypad.attach(0, ladderDebounce[0]);     // for every button
+ *   keypad.begin();
+ */
+class LadderKeypad
+{
+    public:
+
+    static constexpr uint8_t NONE = LADDER_BUTTON_COUNT;       // Band of the released ladder
+
+    LadderKeypad();
+
+    void attach(uint8_t button, CircularDebounceBuffer& debounce);   // Routes the button to its debouncer (and sets its sample source)
+    void begin();                                              // Starts the ADC in free-running mode with the conversion ISR
+    void end();                                                // Stops the ADC
+    void setSleeping(bool sleeping);                           // Timer0-paced conversions while true, free running otherwise
+
+    uint8_t currentButton() const { return _band; }            // Decoded button, NONE when released
+    uint32_t lastBandChangeUs() const { return _bandChangeUs; }
+
+    static bool isPressed(uint8_t button);                     // SampleSource for the debouncers
+    static void onConversion(uint8_t sample);                  // Called from ISR(ADC_vect)
+
+    private:
+
+    static uint8_t rawBand(uint8_t sample);
+    static bool insideBand(uint8_t band, uint8_t sample);
+
+    static LadderKeypad* _active;                              // Instance served by the ISR
+
+    CircularDebounceBuffer* _debouncers[LADDER_BUTTON_COUNT];
+    volatile uint8_t  _band;
+    volatile uint32_t _bandChangeUs;
+    bool _sleeping;
+};
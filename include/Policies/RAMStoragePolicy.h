@@ -14,7 +14,7 @@ struct RAMStoragePolicy
      * @param ptr - Accepts a pointer to RAM address from where we want to read
      * @return uint8_t - Derefeance the ptr to get the value store in memory
      */
-    static uint8_t read(const uint8_t* ptr)
+    static constexpr uint8_t read(const uint8_t* ptr)
     {
         return *ptr;                                        // Returns the value stored in the address by dereference the pointer
     }
@@ -26,7 +26,7 @@ struct RAMStoragePolicy
      * @return true 
      * @return  bool to match the expected type in applyRegisterConfig_CC1101.
      */
-    static bool read(const bool* ptr)
+    static constexpr bool read(const bool* ptr)
     {
         return *ptr;
      } 
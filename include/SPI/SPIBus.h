@@ -3,6 +3,8 @@
 #include <Arduino.h>
 #include <SPI.h>                                                                // To handle low level SPI communocation. https://docs.arduino.cc/learn/communication/spi/
 #include "Config/CC1101_Config/CC1101_SPI_Config.h"
+#include "SPI/SpiTrace.h"
+#include "Capture/FieldTrace.h"
 #include "Debugging/Logging.h"
 #include "Debugging/ChipStateUtil.h"
 #include "avr_algorithms.hpp"
@@ -26,6 +28,11 @@ struct ReadResult {
     bool isValid() const {
         return status != 0xFF && value != 0xFF; // Check if both status and value are not 0xFF
     }
+
+    // The chip drove SO: a dead or floating bus reads 0xFF in the status byte. Registers may hold 0xFF (PKTLEN)
+    bool chipAnswered() const {
+        return status != 0xFF;
+    }
     
     uint8_t status;             // Status byte returned
     uint8_t value;              // Value of the specified register  
@@ -99,17 +106,21 @@ class SPIBus
         void end();                                                                                                  // Disables the SPI bus (leaving pin modes unchanged).
         void selectDevice();                                                                                      // Toggle CSn pin LOW to start a transaction.   
         void deselectDevice();                                                                                  // Toggle CSn pin HGH to end a transaction.   
+        bool awaitChipReady(uint32_t timeoutUs);                                                        // CSn low: wait for SO low (CHIP_RDYn), on Timebase time
         uint8_t transferByte( uint8_t data);                                                                 // Single-byte transmission
         bool writeBurstRegister(uint8_t address,const uint8_t* data , size_t length);      // Burst write operation for transfer multiple byte at once
         bool readBurstRegister(uint8_t address, uint8_t* buffer, size_t length);            // Burst read
         bool writeRegister(uint8_t address , uint8_t value);                                        // Write a single register
         ReadResult readRegister(uint8_t address);                                                   // Read a single register   
+        ReadResult readStatusRegister(uint8_t address);                                           // Read a status register (0x30–0x3D), needs the burst bit set
+        bool readFifo(uint8_t* buffer, size_t length);                                                   // Burst read of the RX FIFO without retries (reads consume the FIFO)
 
         template<typename Func>
         inline void applyTransaction( Func&& operation);
 
     private:
 
+        inline uint8_t transfer(uint8_t data);                                                                    // SPI.transfer() + traffic accounting (SPI_BUDGET_MODE), field trace
         bool validateParameters(uint8_t address, const uint8_t* buffer, size_t length) const;   // Validate parameters for burst read/write operations
         bool performBurstRead(uint8_t address, uint8_t* buffer, size_t length);                     // Perform burst read operation
 
@@ -124,9 +135,20 @@ class SPIBus
 template <typename Func>
 inline void SPIBus::applyTransaction(Func &&operation)
 {
+    SpiTrace::onTransaction();                    // Traffic accounting, compiled out unless SPI_BUDGET_MODE
     SPI.beginTransaction(_settings);             // To begin using the SPI port. The SPI port will be configured our settings. The simplest and most efficient way to use SPISettings is directly inside SPI.beginTransaction()
     selectDevice();                                     // Write the CSn LOW to prepare the device for the transition
     operation();                                        //  This will be the type of  transaction  function to apply
     deselectDevice();                                 // write the CSn HIGH to disable the device 
     SPI.endTransaction();                           // End using SPI port after finish   
 };
+
+/// @brief Every byte SPIBus clocks goes through here, so SpiTrace and FieldTrace see the whole bus traffic
+/// @param data - byte to send
+/// @return byte received (the recorded answer while a trace is replayed, the bus is not clocked)
+inline uint8_t SPIBus::transfer(uint8_t data)
+{
+    SpiTrace::onByte(data);
+    if (FieldTrace::replaying()) return FieldTrace::replayTransfer(data);
+    return FieldTrace::onTransfer(data, SPI.transfer(data));
+}
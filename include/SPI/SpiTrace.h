@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdint.h>
+#include "Config/Constants.h"
+
+/// @brief Bus traffic of one operation
+struct SpiTraffic
+{
+    uint16_t transactions;                                      // SPIBus::applyTransaction() calls, nested ones included
+    uint16_t bytes;                                             // Bytes clocked through SPIBus
+    uint16_t csnCycles;                                         // CSn falling edges (selectDevice())
+
+    constexpr SpiTraffic operator+(const SpiTraffic& other) const
+    {
+        return { static_cast<uint16_t>(transactions + other.transactions), static_cast<uint16_t>(bytes + other.bytes),
+                 static_cast<uint16_t>(csnCycles + other.csnCycles) };
+    }
+
+    constexpr SpiTraffic operator*(uint16_t count) const
+    {
+        return { static_cast<uint16_t>(transactions * count), static_cast<uint16_t>(bytes * count), static_cast<uint16_t>(csnCycles * count) };
+    }
+
+    constexpr bool within(const SpiTraffic& budget) const
+    {
+        return transactions <= budget.transactions && bytes <= budget.bytes && csnCycles <= budget.csnCycles;
+    }
+};
+
+/**
+ * @brief Counts what SPIBus puts on the bus, and logs the first byte of every transaction (the
+ *        CC1101 header: address | R/W | burst), up to SPI_TRACE_LOG_SIZE of them.
+ *
+ * Only built with -DSPI_BUDGET_MODE: otherwise the hooks are empty inline functions and SPIBus
+ * compiles to the same code as before. Debugging/SpiBudget resets the trace around each
+ * high-level Transceiver operation and compares it with the operation's budget.
+ */
+class SpiTrace
+{
+    public:
+
+#ifdef SPI_BUDGET_MODE
+    static void reset();
+    static SpiTraffic traffic() { return _traffic; }
+    static uint8_t logLength() { return _logLength; }
+    static uint8_t logAt(uint8_t index) { return _log[index]; }
+    static bool logOverflow() { return _logOverflow; }
+
+    static inline void onTransaction()
+    {
+        ++_traffic.transactions;
+        _header = true;
+    }
+
+    static inline void onByte(uint8_t sent)
+    {
+        ++_traffic.bytes;
+        if (!_header) return;
+        _header = false;
+        if (_logLength < SPI_TRACE_LOG_SIZE) _log[_logLength++] = sent;
+        else                                 _logOverflow = true;
+    }
+
+    static inline void onSelect() { ++_traffic.csnCycles; }
+
+    private:
+
+    static SpiTraffic _traffic;
+    static uint8_t    _log[SPI_TRACE_LOG_SIZE];
+    static uint8_t    _logLength;
+    static bool       _logOverflow;
+    static bool       _header;                                  // Next byte is the first of a transaction
+#else
+    static inline void onTransaction() {}
+    static inline void onByte(uint8_t) {}
+    static inline void onSelect() {}
+#endif
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/CodeFamilies.h"
+#include "Simulation/ReceiverModel.h"
+
+/// @brief Channel impairments applied to the encoder trace of one trial
+struct Impairments
+{
+    uint16_t jitterUs;                                          // Each edge moved by a uniform +/- jitterUs (no drift)
+    int16_t  skewPermille;                                      // Transmitter clock error: every width scaled by 1000 + skew
+    uint16_t noisePermille;                                     // Chance per LOW pulse of a short noise spike inside it
+    uint16_t collisionPermille;                                 // Chance per burst of another transmitter keying over it
+};
+
+/// @brief One simulated scenario: channel + receiver
+struct AcceptanceScenario
+{
+    Impairments    channel;
+    ReceiverParams receiver;
+};
+
+/// @brief Outcome of a scenario, per number of words sent
+struct AcceptanceResult
+{
+    static constexpr uint8_t MAX_WORDS = 1 + CodeFamilies::SC41344_8Bit::WORD_REPEATS;
+
+    uint16_t trials;
+    uint16_t accepted[MAX_WORDS];                               // [w] = accepted with the burst cut after w + 1 words
+    uint16_t wrongWord;                                         // Accepted a word that was not sent
+};
+
+/**
+ * @brief Monte Carlo estimate of receiver acceptance for the open-door burst.
+ *
+ * Each trial replays REMOTE1_OPEN_DOOR_PROGRAM, the same compiled program the waveform player puts
+ * on air, edge by edge through a channel model (clock skew, edge jitter, noise spikes, one
+ * colliding transmission forcing the carrier on for ACCEPTANCE_SIM_COLLISION_US) into an
+ * SC41344Receiver. The acceptance time tells how many words the receiver needed, so a single
+ * full burst per trial gives the acceptance probability for every repeat count at once.
+ *
+ * Trials are seeded from seed and their index: a run is reproducible and two scenarios run with
+ * the same seed see the same noise.
+ * They run one after the other (no threads on the ATmega328): ACCEPTANCE_SIM_TRIALS bursts take a
+ * few seconds per scenario at 16 MHz. firstTrial numbers the trials of a run, so a run can be
+ * split into slices that see the same noise as the whole: tools/acceptance_sim runs the same code
+ * on the host, millions of trials per scenario on a thread pool, and prints the same lines.
+ *
+ * runCapture() runs the same trials on a recorded burst instead, an edge capture in RAM
+ * (Capture/EdgeCapture.h, e.g. the real transmitter through a logic analyzer): the channel and
+ * the receiver see the captured timing, deadlines stay those of the compiled burst.
+ *
+ * runAcceptanceSimulation() prints, per scenario and per number of words sent w:
+ *   "SIM <scenario> words=<w> accept=<permille> wrong=<permille> airtime_ms=<ms> charge_uC=<uC>"
+ * airtime is the burst cut after w words, charge is its carrier-on time x ACCEPTANCE_SIM_TX_MA.
+ */
+class AcceptanceSimulator
+{
+    public:
+
+    static AcceptanceResult run(const AcceptanceScenario& scenario, uint16_t trials, uint32_t seed = 0, uint32_t firstTrial = 0);
+    static AcceptanceResult runCapture(const AcceptanceScenario& scenario, uint16_t trials, const uint8_t* capture, size_t size,
+                                       uint32_t seed = 0, uint32_t firstTrial = 0);
+
+    static uint8_t scenarioCount();                             // The grid runAcceptanceSimulation() prints
+    static AcceptanceScenario scenario(uint8_t index);
+
+    /// @brief One "SIM" line, accept / wrong already in permille
+    static void printLine(Print& out, uint8_t index, uint8_t words, uint16_t acceptPermille, uint16_t wrongPermille);
+
+    /// @brief Lead-in + words + gaps between them
+    static constexpr uint32_t airtimeUs(uint8_t words)
+    {
+        using Family = CodeFamilies::SC41344_8Bit;
+        constexpr uint32_t WORD_US = Family::WORD_BITS * Family::BIT_PERIOD_US + Family::SYNC_PERIOD_US;
+        return words ? Family::LEAD_IN_US + words * WORD_US + (words - 1) * Family::GAP_US : 0;
+    }
+
+    static uint32_t carrierOnUs(uint8_t words);                 // HIGH time of the same cut
+};
+
+void runAcceptanceSimulation(Print& out);
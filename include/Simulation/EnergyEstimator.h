@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Simulation/EnergyModel.h"
+
+/// @brief How the firmware spends its time between and around presses
+struct FirmwareMode
+{
+    uint32_t   bootUs;                                          // Powered by the button: boot before every press (0 = always on)
+    uint8_t    words;                                           // Words sent per press
+    McuPower   standbyMcu;                                      // Between presses
+    RadioPower standbyRadio;
+};
+
+/// @brief What runEnergyEstimate() works on: the board's figures by default, a host tool passes its own
+struct EnergySetup
+{
+    CurrentTable   currents      = DATASHEET_CURRENTS;
+    uint16_t       pressesPerDay = ENERGY_PRESSES_PER_DAY;
+    uint32_t       batteryMah    = ENERGY_BATTERY_MAH;
+    const uint8_t* capture       = nullptr;                     // Edge capture (Capture/EdgeCapture.h) of the burst, instead of the compiled program
+    size_t         captureBytes  = 0;
+};
+
+/**
+ * @brief Energy and airtime of one press and of a day of use, per firmware mode.
+ *
+ * A press is the timeline the firmware goes through (EnergyEstimator.cpp):
+ *   boot (power-switched modes) -> radio wake (if it slept) -> debounce window (MCU idle between
+ *   samples) -> IDLE -> TX calibration -> the open-door burst cut after `words` words (MCU active,
+ *   bit-banged, carrier per edge of the compiled program at PATABLE_HIGH_INDEX) -> back to standby
+ * and a day is ENERGY_PRESSES_PER_DAY presses plus standby current the rest of the time, on an
+ * ENERGY_BATTERY_MAH battery. Currents are DATASHEET_CURRENTS (Config/Constants.h). An EnergySetup
+ * changes any of these (tools/energy: a current table from a file, a recorded burst).
+ *
+ * Modes compared by runEnergyEstimate():
+ *   armed     : current firmware, always on, MCU idle-sleeps and the radio stays in IDLE, full burst
+ *   adaptive  : same standby, burst cut after RECEIVER_WORDS_REQUIRED words
+ *   deep      : MCU power-down (wake on INT1) and radio SLEEP between presses, full burst
+ *   coldboot  : button switches the power, Arduino boot (ENERGY_ARDUINO_BOOT_US) before each burst
+ *   fastboot  : same with the bare-metal boot (ENERGY_FAST_BOOT_US)
+ *
+ * Printed as
+ *   "ENERGY <mode> words=<w> press_ms=<ms> airtime_ms=<ms> press_uC=<uC> standby_uA=<uA> day_mC=<mC> avg_uA=<uA> life_days=<d>"
+ * Board parts (regulator, USB bridge, LED) are not modeled: they dominate the standby of a Nano.
+ */
+class EnergyEstimator
+{
+    public:
+
+    static EnergyMeter press(const FirmwareMode& mode, const CurrentTable& currents = DATASHEET_CURRENTS);
+    /// @brief press() with the burst read from an edge capture
+    static EnergyMeter pressCapture(const FirmwareMode& mode, const uint8_t* capture, size_t size, const CurrentTable& currents = DATASHEET_CURRENTS);
+    static uint32_t standbyUa(const FirmwareMode& mode, const CurrentTable& currents = DATASHEET_CURRENTS);
+
+    static uint8_t modeCount();
+    static FirmwareMode mode(uint8_t index);
+    /// @return index of the mode called name, modeCount() if there is none
+    static uint8_t modeIndex(const char* name);
+};
+
+void runEnergyEstimate(Print& out, const EnergySetup& setup = EnergySetup{});
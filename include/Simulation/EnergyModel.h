@@ -0,0 +1,123 @@
+#pragma once
+
+#include <stdint.h>
+#include "Config/Constants.h"
+#include "Waveform/WaveformBytecode.h"
+
+/// @brief MCU sleep state over a segment
+enum class McuPower : uint8_t { Active, Idle, PowerDown };
+
+/// @brief CC1101 state over a segment. Synth = FSTXON / calibration, and TX with the carrier off
+enum class RadioPower : uint8_t { Sleep, Idle, Synth, Carrier };
+
+/// @brief A stretch of time with constant power states
+struct PowerSegment
+{
+    McuPower   mcu;
+    RadioPower radio;
+    uint8_t    paIndex;                                         // Carrier only: paTable entry on air
+    uint32_t   durationUs;
+};
+
+/// @brief Supply currents, uA. DATASHEET_CURRENTS by default, any other figures can be passed
+struct CurrentTable
+{
+    uint32_t mcuUa[3];                                          // By McuPower
+    uint32_t radioUa[3];                                        // Sleep, Idle, Synth
+    uint32_t carrierUa[8];                                      // By paTable index
+};
+
+constexpr CurrentTable DATASHEET_CURRENTS{
+    { ENERGY_MCU_ACTIVE_UA, ENERGY_MCU_IDLE_UA, ENERGY_MCU_POWER_DOWN_UA },
+    { ENERGY_RADIO_SLEEP_UA, ENERGY_RADIO_IDLE_UA, ENERGY_RADIO_SYNTH_UA },
+    { ENERGY_RADIO_TX_UA[0], ENERGY_RADIO_TX_UA[1], ENERGY_RADIO_TX_UA[2], ENERGY_RADIO_TX_UA[3],
+      ENERGY_RADIO_TX_UA[4], ENERGY_RADIO_TX_UA[5], ENERGY_RADIO_TX_UA[6], ENERGY_RADIO_TX_UA[7] }
+};
+
+/**
+ * @brief Integrates a power-state timeline into charge.
+ *
+ * Segments come from a simulated press (Simulation/EnergyEstimator) or from a trace: addBurst()
+ * takes any edge source with next(Waveform::Edge&), the compiled program's Interpreter or the
+ * Cursor of a recorded capture (Capture/EdgeCapture.h), HIGH = carrier on, LOW = synthesizer only.
+ *
+ * Charge is kept in pC (uA x us), exact for any realistic timeline. Every member is constexpr and
+ * there is no AVR dependency: a host build can reuse it with its own CurrentTable.
+ */
+class EnergyMeter
+{
+    public:
+
+    constexpr explicit EnergyMeter(const CurrentTable& currents = DATASHEET_CURRENTS):
+    _currents(currents), _chargePc(0), _durationUs(0), _carrierUs(0)
+    {}
+
+    constexpr uint32_t currentUa(McuPower mcu, RadioPower radio, uint8_t paIndex = 0) const
+    {
+        uint32_t radioUa = (radio == RadioPower::Carrier) ? _currents.carrierUa[paIndex & 7]
+                                                          : _currents.radioUa[static_cast<uint8_t>(radio)];
+        return _currents.mcuUa[static_cast<uint8_t>(mcu)] + radioUa;
+    }
+
+    constexpr void add(const PowerSegment& segment)
+    {
+        _chargePc   += static_cast<uint64_t>(currentUa(segment.mcu, segment.radio, segment.paIndex)) * segment.durationUs;
+        _durationUs += segment.durationUs;
+        if (segment.radio == RadioPower::Carrier) _carrierUs += segment.durationUs;
+    }
+
+    /// @brief A bit-banged burst (MCU active), cut after limitUs of edges
+    template<typename Source>
+    constexpr void addBurst(Source& source, uint8_t paIndex, uint32_t limitUs = UINT32_MAX)
+    {
+        Waveform::Edge edge{0, 0};
+        uint32_t nowUs = 0;
+        while (nowUs < limitUs && source.next(edge))
+        {
+            uint32_t durationUs = (edge.durationUs < limitUs - nowUs) ? edge.durationUs : limitUs - nowUs;
+            add({ McuPower::Active, edge.level ? RadioPower::Carrier : RadioPower::Synth, paIndex, durationUs });
+            nowUs += durationUs;
+        }
+    }
+
+    constexpr uint64_t chargePc() const { return _chargePc; }
+    constexpr uint32_t chargeUc() const { return static_cast<uint32_t>(_chargePc / 1000000ULL); }
+    constexpr uint32_t durationUs() const { return _durationUs; }
+    constexpr uint32_t carrierUs() const { return _carrierUs; }
+
+    private:
+
+    CurrentTable _currents;
+    uint64_t     _chargePc;
+    uint32_t     _durationUs;
+    uint32_t     _carrierUs;
+};
+
+/// @brief A day of use: presses + standby in between
+struct DailyEnergy
+{
+    uint32_t dayUc;
+    uint32_t averageUa;
+    uint32_t lifetimeDays;                                      // On batteryMah, self-discharge ignored
+};
+
+/// @brief A day of presses of pressPc over pressUs each (an average press of a trace, or one EnergyMeter)
+constexpr DailyEnergy dailyEnergy(uint64_t pressPc, uint32_t pressUs, uint32_t standbyUa, uint16_t pressesPerDay, uint32_t batteryMah)
+{
+    constexpr uint64_t DAY_US = 86400ULL * 1000000ULL;
+
+    uint64_t pressesUs = static_cast<uint64_t>(pressUs) * pressesPerDay;
+    uint64_t standbyUs = (pressesUs < DAY_US) ? DAY_US - pressesUs : 0;
+    uint64_t dayPc     = pressPc * pressesPerDay + standbyUa * standbyUs;
+    uint64_t dayUc     = dayPc / 1000000ULL;
+    uint64_t batteryUc = static_cast<uint64_t>(batteryMah) * 3600ULL * 1000ULL;
+    uint64_t days      = dayUc ? batteryUc / dayUc : UINT32_MAX;
+
+    return { static_cast<uint32_t>(dayUc), static_cast<uint32_t>(dayUc / 86400ULL),
+             static_cast<uint32_t>(days < UINT32_MAX ? days : UINT32_MAX) };
+}
+
+constexpr DailyEnergy dailyEnergy(const EnergyMeter& press, uint32_t standbyUa, uint16_t pressesPerDay, uint32_t batteryMah)
+{
+    return dailyEnergy(press.chargePc(), press.durationUs(), standbyUa, pressesPerDay, batteryMah);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+#include "Simulation/SweepFormat.h"
+
+constexpr uint8_t SWEEP_MAX_AXES    = 4;
+constexpr uint8_t SWEEP_MAX_COLUMNS = 8;
+
+/**
+ * @brief One grid: axes of parameters and a job run at every grid point.
+ *
+ * The job gets the index on every axis and a seed derived from (id, job index) only, so a grid
+ * point gives the same row whatever ran before it, and whether the sweep was resumed or not.
+ * It fills `columns` values, the parameters it used first then its results.
+ */
+struct SweepDefinition
+{
+    using Job = void (*)(const uint8_t* axisIndex, uint32_t seed, int32_t* row);
+
+    uint8_t     id;                                             // Checkpoint key, also the first field of every row
+    const char* header;                                         // PROGMEM, comma separated column names
+    uint8_t     axisCount;
+    uint8_t     axisSize[SWEEP_MAX_AXES];
+    uint8_t     columns;
+    Job         job;
+};
+
+/**
+ * @brief Runs the jobs of a sweep in index order, streaming columnar blocks and checkpointing in EEPROM.
+ *
+ * Output on `out`: a header, then one line per SWEEP_BLOCK_ROWS jobs, a Simulation/SweepFormat
+ * block in hex (the last one may be shorter), then the end:
+ *   "SWEEP <id> jobs=<count> from=<first job> columns=<header>"
+ *   "SWB <hex>"
+ *   "SWEEP <id> done"
+ *
+ * After every block the next job index is written to the sweep's checkpoint slot (id + job count +
+ * next job, SWEEP_CHECKPOINT_SLOTS slots from SWEEP_CHECKPOINT_ADDR, eeprom_update so unchanged
+ * bytes are not rewritten). A reset or a watchdog bite in the middle of a sweep resumes at the
+ * first job of the block it was filling; a finished sweep stays done (header, then "done" straight
+ * away) until clear(), so a list of sweeps resumes where it stopped. A checkpoint of another grid
+ * (id or job count differs) is ignored.
+ *
+ * Jobs are independent and seeded from their index, so any subset of the grid can be computed
+ * elsewhere (or on several boards, split by job range) and merged by job index: blocks carry
+ * their first job. tools/sweep_runner runs the same sweeps on the host on every core, into a
+ * file of these blocks that resumes like the checkpoint.
+ *
+ * @example
+ *   SweepRunner runner(Serial);
+ *   runner.run(DEBOUNCE_SWEEP);
+ */
+class SweepRunner
+{
+    public:
+
+    explicit SweepRunner(Print& out);
+
+    void run(const SweepDefinition& sweep);
+    void clear(const SweepDefinition& sweep);
+    static uint16_t jobCount(const SweepDefinition& sweep);
+    static uint32_t seedOf(uint8_t id, uint16_t job);
+
+    private:
+
+    struct Checkpoint
+    {
+        uint8_t  id;
+        uint16_t jobs;
+        uint16_t next;
+    };
+
+    using Block = SweepFormat::Block<SWEEP_BLOCK_ROWS, SWEEP_MAX_COLUMNS>;
+
+    void     emit(const Block& block) const;
+    uint16_t resumeFrom(const SweepDefinition& sweep, uint16_t jobs) const;
+    void     save(const Checkpoint& checkpoint) const;
+    static void     save(const Checkpoint& checkpoint, uint8_t id);
+    static uint16_t slotAddress(uint8_t id);
+
+    Print& _out;
+};
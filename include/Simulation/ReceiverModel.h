@@ -0,0 +1,225 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Config/Constants.h"
+
+/// @brief Decoder settings of a typical SC41344-style receiver
+struct ReceiverParams
+{
+    uint8_t  tolerancePct;                                      // Pulse accepted within +/- this % of its nominal width
+    uint16_t syncMinUs;                                         // LOW at least this long = sync (lead-in / gap between words)
+    uint8_t  wordsRequired;                                     // N identical words...
+    uint8_t  windowWords;                                       // ...among the last M decoded word slots
+};
+
+/**
+ * @brief Model of an SC41344-style receiver decoder, fed with (level, duration) pulses.
+ *
+ * What the usual fixed-code decoder chips do, reduced to their decisions:
+ *   - sync     : a LOW of at least syncMinUs (the 10 ms lead-in, the 15 ms gap) starts a word slot
+ *   - symbols  : HIGH + LOW pairs, each width classified short / long inside the tolerance window;
+ *                short-long = A, long-short = B, anything else spoils the slot
+ *   - digits   : AA = '0', BB = '1', BA = OPEN; a word is WordBits digits then OPEN, closed by a sync
+ *                (the LOW of the last symbol is absorbed by the sync, only its HIGH is classified)
+ *   - matching : accepted once N identical valid words sit among the last M word slots
+ *
+ * Equal levels fed back to back are merged (a piece of pulse split by the channel model is one
+ * pulse for the decoder). Decisions are dated on the input timeline: a sync is recognised
+ * syncMinUs after its LOW started, which is when acceptedAtUs() is taken.
+ *
+ * Every member is constexpr, so the clean burst of a compiled program is checked at build time
+ * (conformance block in AcceptanceSimulator.cpp).
+ *
+ * @tparam WordBits - Data digits per word (CodeFamilies::SC41344<N>::WORD_BITS)
+ */
+template<size_t WordBits>
+class SC41344Receiver
+{
+    static_assert(WordBits > 0 && WordBits <= 32, "Words are decoded into 32 bits");
+
+    public:
+
+    static constexpr uint8_t MAX_WINDOW_WORDS = 8;
+
+    constexpr explicit SC41344Receiver(const ReceiverParams& params):
+    _params(params), _slots{}, _slotValid{}, _slotCount(0), _nowUs(0), _pendingLevel(0), _pendingUs(0),
+    _havePending(false), _hunting(true), _spoiled(false), _highUs(0), _haveHigh(false),
+    _firstSymbol(None), _symbolsInDigit(0), _digits(0), _openSeen(false), _word(0),
+    _accepted(false), _acceptedWord(0), _acceptedAtUs(0)
+    {
+        if (_params.windowWords == 0 || _params.windowWords > MAX_WINDOW_WORDS) _params.windowWords = MAX_WINDOW_WORDS;
+    }
+
+    constexpr void feed(uint8_t level, uint32_t durationUs)
+    {
+        if (durationUs == 0) return;
+        level = level ? 1 : 0;
+        if (_havePending && level == _pendingLevel)
+        {
+            _pendingUs += durationUs;
+            return;
+        }
+        if (_havePending) pulse(_pendingLevel, _pendingUs);
+        _pendingLevel = level;
+        _pendingUs    = durationUs;
+        _havePending  = true;
+    }
+
+    /// @brief End of the burst: the carrier is gone, the receiver sees LOW from now on
+    constexpr void finish()
+    {
+        if (_havePending && _pendingLevel == 0)
+        {
+            pulse(0, _pendingUs > _params.syncMinUs ? _pendingUs : _params.syncMinUs);
+        }
+        else
+        {
+            if (_havePending) pulse(1, _pendingUs);
+            pulse(0, _params.syncMinUs);
+        }
+        _havePending = false;
+    }
+
+    constexpr bool     accepted() const     { return _accepted; }
+    constexpr uint32_t acceptedWord() const { return _acceptedWord; }
+    constexpr uint32_t acceptedAtUs() const { return _acceptedAtUs; }
+    constexpr uint8_t  wordSlots() const    { return _slotCount; }
+
+    private:
+
+    enum Width : uint8_t { Short, Long, Bad };
+    enum Symbol : uint8_t { None, A, B };
+
+    constexpr Width width(uint32_t us, uint32_t shortUs, uint32_t longUs) const
+    {
+        if (within(us, shortUs)) return Short;
+        if (within(us, longUs))  return Long;
+        return Bad;
+    }
+
+    constexpr bool within(uint32_t us, uint32_t nominalUs) const
+    {
+        uint32_t margin = nominalUs * _params.tolerancePct / 100;
+        return us + margin >= nominalUs && us <= nominalUs + margin;
+    }
+
+    constexpr void pulse(uint8_t level, uint32_t us)
+    {
+        uint32_t startUs = _nowUs;
+        _nowUs += us;
+
+        if (level)
+        {
+            _highUs   = us;
+            _haveHigh = true;
+            return;
+        }
+
+        bool sync = us >= _params.syncMinUs;
+        if (_hunting)
+        {
+            if (sync) startSlot();
+            _haveHigh = false;
+            return;
+        }
+
+        if (_haveHigh)
+        {
+            Width high = width(_highUs, SHORT_HIGH_US, LONG_HIGH_US);
+            Width low  = sync ? (high == Short ? Long : Short) : width(us, SHORT_LOW_US, LONG_LOW_US);
+            symbol((high == Short && low == Long) ? A : (high == Long && low == Short) ? B : None);
+            _haveHigh = false;
+        }
+
+        if (sync)
+        {
+            closeSlot(startUs + _params.syncMinUs);
+            startSlot();
+        }
+    }
+
+    constexpr void symbol(Symbol s)
+    {
+        if (s == None || _openSeen) { _spoiled = true; return; }
+        if (_symbolsInDigit == 0)
+        {
+            _firstSymbol    = s;
+            _symbolsInDigit = 1;
+            return;
+        }
+        _symbolsInDigit = 0;
+
+        if (_firstSymbol == B && s == A)                      // OPEN: only after a full word
+        {
+            if (_digits == WordBits) _openSeen = true;
+            else                     _spoiled  = true;
+            return;
+        }
+        if (_firstSymbol != s || _digits >= WordBits) { _spoiled = true; return; }
+
+        _word = (_word << 1) | (s == B ? 1u : 0u);
+        ++_digits;
+    }
+
+    constexpr void startSlot()
+    {
+        _hunting        = false;
+        _spoiled        = false;
+        _haveHigh       = false;
+        _symbolsInDigit = 0;
+        _digits         = 0;
+        _openSeen       = false;
+        _word           = 0;
+    }
+
+    constexpr void closeSlot(uint32_t decidedAtUs)
+    {
+        if (_digits == 0 && !_openSeen && !_spoiled && _symbolsInDigit == 0) return;      // Two syncs in a row: no slot
+
+        bool valid = _openSeen && !_spoiled && _symbolsInDigit == 0;
+        uint8_t index = _slotCount % _params.windowWords;
+        _slots[index]     = _word;
+        _slotValid[index] = valid;
+        if (_slotCount < 0xFF) ++_slotCount;
+
+        if (!valid || _accepted) return;
+
+        uint8_t filled = (_slotCount < _params.windowWords) ? _slotCount : _params.windowWords;
+        uint8_t same = 0;
+        for (uint8_t i = 0; i < filled; ++i)
+        {
+            if (_slotValid[i] && _slots[i] == _word) ++same;
+        }
+        if (same >= _params.wordsRequired)
+        {
+            _accepted     = true;
+            _acceptedWord = _word;
+            _acceptedAtUs = decidedAtUs;
+        }
+    }
+
+    ReceiverParams _params;
+    uint32_t _slots[MAX_WINDOW_WORDS];
+    bool     _slotValid[MAX_WINDOW_WORDS];
+    uint8_t  _slotCount;
+
+    uint32_t _nowUs;
+    uint8_t  _pendingLevel;
+    uint32_t _pendingUs;
+    bool     _havePending;
+
+    bool     _hunting;
+    bool     _spoiled;
+    uint32_t _highUs;
+    bool     _haveHigh;
+    Symbol   _firstSymbol;
+    uint8_t  _symbolsInDigit;
+    uint8_t  _digits;
+    bool     _openSeen;
+    uint32_t _word;
+
+    bool     _accepted;
+    uint32_t _acceptedWord;
+    uint32_t _acceptedAtUs;
+};
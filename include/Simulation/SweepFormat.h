@@ -0,0 +1,127 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Sweep result format: blocks of consecutive jobs stored column by column (Simulation/ParameterSweep).
+ *
+ *   block   id u8 | firstJob varint | rows u8 | columns u8
+ *           column 0: rows varints, column 1: rows varints, ... column columns-1
+ *
+ * Row r of a block is job firstJob + r (the job index is not stored). Each column holds the
+ * zigzag-encoded difference of a value to the one above it (the first one to 0), LEB128 like the
+ * edge captures: a grid walks its last axis fastest, so most parameter columns repeat and cost one
+ * byte per row, and results that change slowly cost one or two.
+ *
+ * Differences wrap in 32 bits, so any int32 column round-trips. Encoder and decoder have no AVR
+ * dependency and are constexpr: the firmware checks a round trip at build time (conformance block
+ * in ParameterSweep.cpp), host tools decode the "SWB" lines with the same code.
+ */
+namespace SweepFormat
+{
+    constexpr uint8_t MAX_VARINT_BYTES = 5;                     // 32-bit value
+    constexpr size_t  HEADER_BYTES     = 3 + 3;                 // id, rows, columns + firstJob (16-bit)
+
+    template<uint8_t Rows, uint8_t Columns>
+    struct Block
+    {
+        uint8_t  id;
+        uint16_t firstJob;
+        uint8_t  rows;                                          // 1..Rows
+        uint8_t  columns;                                       // 1..Columns
+        int32_t  values[Rows][Columns];
+    };
+
+    /// @brief Largest encoded block, for sizing host buffers
+    template<uint8_t Rows, uint8_t Columns>
+    constexpr size_t MAX_BLOCK_BYTES = HEADER_BYTES + static_cast<size_t>(Rows) * Columns * MAX_VARINT_BYTES;
+
+    constexpr uint32_t zigzag(int32_t value)   { return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value < 0 ? -1 : 0); }
+    constexpr int32_t  unzigzag(uint32_t value) { return static_cast<int32_t>((value >> 1) ^ (0u - (value & 1))); }
+
+    /// @brief Writes value as LEB128 into out (MAX_VARINT_BYTES), returns its length
+    constexpr uint8_t putVarint(uint32_t value, uint8_t* out)
+    {
+        uint8_t length = 0;
+        do
+        {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            out[length++] = value ? (byte | 0x80) : byte;
+        } while (value);
+        return length;
+    }
+
+    /**
+     * @brief Streams one block into sink, a few bytes per write().
+     *
+     * @tparam Sink - anything with write(const uint8_t*, size_t): a hex line printer, a test buffer
+     */
+    template<typename Sink, uint8_t Rows, uint8_t Columns>
+    constexpr void encode(const Block<Rows, Columns>& block, Sink& sink)
+    {
+        uint8_t bytes[MAX_VARINT_BYTES] = {};
+        bytes[0] = block.id;
+        sink.write(bytes, 1);
+        sink.write(bytes, putVarint(block.firstJob, bytes));
+        bytes[0] = block.rows;
+        bytes[1] = block.columns;
+        sink.write(bytes, 2);
+
+        for (uint8_t column = 0; column < block.columns; ++column)
+        {
+            uint32_t previous = 0;
+            for (uint8_t row = 0; row < block.rows; ++row)
+            {
+                uint32_t value = static_cast<uint32_t>(block.values[row][column]);
+                sink.write(bytes, putVarint(zigzag(static_cast<int32_t>(value - previous)), bytes));
+                previous = value;
+            }
+        }
+    }
+
+    /**
+     * @brief Reads one block from in.
+     * @return bytes used, 0 if the block is truncated, malformed or larger than Rows x Columns
+     */
+    template<uint8_t Rows, uint8_t Columns>
+    constexpr size_t decode(const uint8_t* in, size_t length, Block<Rows, Columns>& block)
+    {
+        size_t position = 0;
+
+        auto varint = [&](uint32_t& value) -> bool {
+            value = 0;
+            for (uint8_t shift = 0; shift < 7 * MAX_VARINT_BYTES; shift += 7)
+            {
+                if (position >= length) return false;
+                uint8_t byte = in[position++];
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        };
+
+        uint32_t firstJob = 0;
+        if (length < 1) return 0;
+        block.id = in[position++];
+        if (!varint(firstJob) || firstJob > 0xFFFF || position + 2 > length) return 0;
+        block.firstJob = static_cast<uint16_t>(firstJob);
+        block.rows     = in[position++];
+        block.columns  = in[position++];
+        if (block.rows == 0 || block.rows > Rows || block.columns == 0 || block.columns > Columns) return 0;
+
+        for (uint8_t column = 0; column < block.columns; ++column)
+        {
+            uint32_t previous = 0;
+            for (uint8_t row = 0; row < block.rows; ++row)
+            {
+                uint32_t delta = 0;
+                if (!varint(delta)) return 0;
+                previous += static_cast<uint32_t>(unzigzag(delta));
+                block.values[row][column] = static_cast<int32_t>(previous);
+            }
+        }
+        return position;
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Simulation/ParameterSweep.h"
+
+/**
+ * @brief The sweeps of the firmware's own code, run by runParameterSweeps():
+ *
+ *   - id 1, debounce : threshold x sample interval x bounce profile. The real
+ *                      CircularDebounceBuffer samples a seeded bouncing contact on virtual
+ *                      Timebase time (SWEEP_DEBOUNCE_PRESSES presses per point).
+ *       columns: threshold,interval_us,bounce_us,detected,extra,latency_us
+ *       (extra = callbacks beyond one per press, release chatter included; latency = mean
+ *        first edge -> callback of the detected presses)
+ *
+ *   - id 2, acceptance : transmitter timing trim x receiver tolerance through the
+ *                        AcceptanceSimulator (SWEEP_ACCEPTANCE_TRIALS bursts, 50 us jitter).
+ *       columns: trim_permille,tolerance_pct,accept2_permille,accept4_permille
+ *
+ * The debounce sweep suspends the Timebase and drives it by hand: run it at boot, before the
+ * application uses time. Both grids take tens of seconds; they resume from their checkpoint.
+ * tools/sweep_runner links this file and runs both on the host, with the same rows.
+ */
+extern const SweepDefinition DEBOUNCE_SWEEP;
+extern const SweepDefinition ACCEPTANCE_SWEEP;
+
+void runParameterSweeps(Print& out);
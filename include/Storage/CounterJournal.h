@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+#include "Storage/EepromWriter.h"
+#include "Debugging/Logging.h"
+
+/**
+ * @brief Wear-leveled, power-loss safe journal of the rolling-code counter in EEPROM.
+ *
+ * The journal is a ring of COUNTER_JOURNAL_SLOTS slots. Each commit writes the new counter and
+ * its CRC-8 into the slot *after* the newest one, so:
+ *   - writes are spread over all slots (wear leveling: slots x 100k EEPROM cycles),
+ *   - the newest valid slot is never overwritten, a torn write (power loss while the EEPROM
+ *     cell is being programmed) only corrupts the oldest slot, whose CRC then fails and it is
+ *     ignored at boot,
+ *   - a counter is committed *before* it goes on air, so after a reset the next counter is
+ *     always strictly greater than anything that was transmitted (never reused; at most one
+ *     committed-but-unsent value is skipped, which the receiver's forward window absorbs).
+ *
+ * commitNext() queues the slot as a Critical EepromWriter block and returns; committed() tells
+ * when it has reached EEPROM and the counter may go on air.
+ *
+ * EEPROM layout (5 bytes per slot):
+ *     [ counter LSB .. MSB | crc8(counter) ] x COUNTER_JOURNAL_SLOTS
+ */
+class CounterJournal
+{
+    public:
+
+    /**
+     * @param baseAddress - First EEPROM byte used by the ring
+     * @param slots - Number of slots in the ring
+     */
+    CounterJournal(uint16_t baseAddress = COUNTER_JOURNAL_BASE_ADDR, uint8_t slots = COUNTER_JOURNAL_SLOTS);
+
+    void begin();                                   // Scans the ring and recovers the newest valid counter
+    uint32_t current() const;                       // Last committed counter (0 on a blank EEPROM)
+    uint32_t commitNext();                          // Queues current()+1 for the next slot and returns it
+    bool committed() const;                         // The last commitNext() is in EEPROM
+
+    static constexpr uint8_t SLOT_SIZE = sizeof(uint32_t) + 1;
+
+    private:
+
+    struct Slot
+    {
+        uint32_t counter;
+        uint8_t  crc;
+    };
+
+    uint16_t slotAddress(uint8_t index) const;
+    static uint8_t crc8(uint32_t counter);
+    static bool isValid(const Slot& slot);
+
+    uint16_t _baseAddress;
+    uint8_t  _slots;
+    uint8_t  _newestIndex;                          // Slot holding current()
+    uint32_t _counter;
+};
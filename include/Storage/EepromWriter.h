@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+
+/**
+ * @brief Non-blocking EEPROM writes: a bounded byte queue programmed from the EE_READY ISR.
+ *
+ * An EEPROM byte takes ~3.4 ms to program. write() only queues it and returns; the EE_READY
+ * interrupt programs one queued byte after the other, skipping the ones EEPROM already holds
+ * (same wear as eeprom_update_byte()):
+ *   - coalescing : a byte written again while still queued replaces the queued one, which moves to
+ *                  the back (program order = write order, one queued entry per address)
+ *   - priority   : Critical bytes are programmed before Normal ones. Put there what must survive a
+ *                  supply collapse (the rolling-code counter): the ATmega328 brown-out detector
+ *                  resets without warning, so the sooner it is in EEPROM the better. flush()
+ *                  drains the queue synchronously when the application knows power is going.
+ *   - reads      : read() / readBlock() return the queued value of a pending address, EEPROM
+ *                  otherwise, so callers see their own writes immediately
+ *   - completion : writeBlock() can take a callback, called from the ISR once the block *and
+ *                  everything queued before it* is in EEPROM (keep it short: set a flag)
+ *
+ * Every EEPROM access of the firmware goes through this class: a direct eeprom_*() call could
+ * change EEAR while the ISR is programming a byte.
+ *
+ * @example
+ *   EepromWriter::writeBlock(address, &record, sizeof(record));           // Returns at once
+ *   if (EepromWriter::pending(address, sizeof(record))) { ... }            // Not in EEPROM yet
+ */
+class EepromWriter
+{
+    public:
+
+    enum class Priority : uint8_t { Normal, Critical };
+
+    using Callback = void(*)();
+
+    static bool write(uint16_t address, uint8_t value, Priority priority = Priority::Normal);
+    // All or nothing: false (nothing queued) if the block does not fit in the free entries
+    static bool writeBlock(uint16_t address, const void* data, uint8_t length, Priority priority = Priority::Normal, Callback done = nullptr);
+    // Waits for queue room as needed (not for programming): for blocks larger than the queue
+    static void writeBlockWaiting(uint16_t address, const void* data, uint16_t length, Priority priority = Priority::Normal);
+
+    static uint8_t read(uint16_t address);
+    static void readBlock(void* data, uint16_t address, uint16_t length);
+
+    static bool pending(uint16_t address, uint16_t length = 1);    // Any byte of the range still queued
+    static uint8_t queued();                                        // Bytes waiting, the one being programmed included
+    static void flush();                                            // Blocks until everything queued is in EEPROM
+
+    static void onReady();                                          // EE_READY ISR only
+
+    private:
+
+    struct Entry
+    {
+        uint16_t address;
+        uint8_t  value;
+        uint8_t  flags;                                             // CRITICAL | IN_FLIGHT | generation << 2
+    };
+
+    struct Fence
+    {
+        Callback done;
+        uint8_t  generation;                                        // Completes when no entry of this generation or older is left
+    };
+
+    static int8_t find(uint16_t address);                           // Queued (not in-flight) entry of address, -1 if none
+    static void remove(uint8_t index);
+    static void append(uint16_t address, uint8_t value, Priority priority);
+    static void notify();
+    static bool olderOrSame(uint8_t generation, uint8_t fence);
+
+    static Entry   _queue[EEPROM_QUEUE_SIZE];
+    static volatile uint8_t _count;                                 // Polled by flush()
+    static Fence   _fences[EEPROM_FENCE_SLOTS];
+    static uint8_t _generation;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Constants.h"
+#include "Storage/EepromWriter.h"
+#include "Waveform/WaveformBytecode.h"
+#include "Debugging/Logging.h"
+
+/**
+ * @brief Field-loaded waveform programs: EEPROM slots, validated once, played from a RAM cache.
+ *
+ * A program only reaches EEPROM after its CRC matches what the host sent and
+ * Waveform::validate() accepted it (structure, nesting, per-edge budget, timing limits). At boot
+ * every slot is read back into the cache and checked again (CRC + validate), so a torn write or
+ * a firmware with stricter limits simply disables that slot. Playback then reads RAM only and
+ * needs no checks.
+ *
+ * Uploads are received straight into the slot's cache line (no extra RAM buffer): the slot is
+ * out of service from beginUpload() until commit() accepts it, and a rejected upload reloads
+ * the previous program from EEPROM.
+ *
+ * EEPROM layout (PROGRAM_STORE_SLOTS slots from PROGRAM_STORE_BASE_ADDR):
+ *     [ length | crc16 LSB | crc16 MSB | program bytes x PROGRAM_STORE_SLOT_BYTES ]
+ *     crc16 = CRC-16/CCITT (avr-libc _crc_ccitt_update, init 0xFFFF) over the program bytes
+ */
+class ProgramStore
+{
+    public:
+
+    ProgramStore();
+
+    void begin();                                               // Loads and re-validates every slot into the cache
+    uint8_t* beginUpload(uint8_t slot);                         // Cache line to receive into (nullptr for a bad slot)
+    Waveform::Verdict commit(uint8_t slot, uint8_t length, uint16_t crc);   // Validate the upload, then persist it
+    void cancelUpload(uint8_t slot);                            // Drop a partial upload, the previous program is served again
+    void erase(uint8_t slot);
+
+    bool isLoaded(uint8_t slot) const;
+    const uint8_t* program(uint8_t slot) const;                 // RAM cache, valid when isLoaded()
+    uint8_t length(uint8_t slot) const;
+
+    static uint16_t crc16(const uint8_t* data, uint8_t length);
+
+    static constexpr uint8_t HEADER_SIZE = 3;
+    static constexpr uint8_t SLOT_SIZE   = HEADER_SIZE + PROGRAM_STORE_SLOT_BYTES;
+
+    private:
+
+    uint16_t slotAddress(uint8_t slot) const;
+    void loadSlot(uint8_t slot);
+
+    uint8_t _cache[PROGRAM_STORE_SLOTS][PROGRAM_STORE_SLOT_BYTES];
+    uint8_t _length[PROGRAM_STORE_SLOTS];                       // 0 = slot empty or rejected
+};
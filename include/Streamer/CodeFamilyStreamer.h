@@ -0,0 +1,102 @@
+#pragma once
+#include "interfaces/IFrameStreamer.h"
+#include "interfaces/IBitEncoder.h"
+#include "Config/CodeFamilies.h"
+#include "Debugging/Logging.h"
+#include "avr_algorithms.hpp"
+
+
+// Forward declaration to avoid circular dependency
+class Transceiver;
+
+/**
+ * @brief Generic frame streamer for any fixed-code family described in CodeFamilies.h
+ *
+ * The frame layout (word length, sync placement, lead-in, inter-word gap and repeat count)
+ * comes from the Family traits and is resolved with `if constexpr`, so each instantiation
+ * compiles down to the exact call sequence of its protocol with no runtime family checks.
+ *
+ * Frame construction:
+ *   [lead-in] -> word -> { [gap] -> word } x WORD_REPEATS -> idle
+ *   where word = [SYNC] + data bits        (Leading sync  -> SYNC is IBitEncoder::sendPreamble())
+ *         word = data bits + [SYNC]        (Trailing sync -> SYNC is IBitEncoder::sendOpen())
+ *
+ * @tparam Family - CodeFamilies::SC41344<N>, CodeFamilies::EV1527, ...
+ *
+ * Usage:
+ * --------
+ *   CodeFamilyStreamer<CodeFamilies::EV1527> streamer(transceiver);
+ *   streamer.streamFrame(code24Bits, ev1527Encoder);
+ */
+template<typename Family>
+class CodeFamilyStreamer : public IFrameStreamer<Family::WORD_BITS>
+{
+public:
+
+    static constexpr size_t N = Family::WORD_BITS;
+
+    /// @brief
+    /// @param transceiver makes the FrameStreamer self-contained, capable of managing its own RF state if needed
+    CodeFamilyStreamer(Transceiver& transceiver): _transceiver(transceiver){}
+    ~CodeFamilyStreamer() override = default;
+
+    /**
+     * @brief Stream the whole code message bit by bit using the Encode object to generate the waveform
+     *
+     * @param code_DataBits - Store the code logic bit as an Array of '0' & '1'
+     * @param encoder - Know how is bit is encode for the different Protocols used
+     */
+    void streamFrame(const uint8_t (&code_DataBits)[N], IBitEncoder &encoder) override
+    {
+        #if LOG_VERBOSE
+            LOG_NEW_LINE("CodeFamilyStreamer::streamFrame() - Streaming frame to CC1101...");
+        #endif
+        streamFrameStatic(code_DataBits, encoder);
+    }
+
+    /**
+     * @brief Static method to stream a frame of this family.
+     *
+     * Useful for testing purposes, allowing the frame to be streamed without an instance.
+     *
+     * @param code_DataBits Array of logical bits (0 or 1) representing the word content.
+     * @param encoder       Object that encodes individual bits into physical waveforms.
+     */
+    static void streamFrameStatic(const uint8_t (&code_DataBits)[N], IBitEncoder &encoder)
+    {
+        using CodeFamilies::SyncPlacement;
+
+        // Send each logical bit (0 or 1) via the encoder
+        auto sendBit = [&encoder](uint8_t bit) {
+            if (bit == 1)  encoder.sendOne();
+            else             encoder.sendZero();
+        };
+
+        // Encodes a full word with its sync symbol on the side the family requires
+        auto sendWord = [&]()
+        {
+            if constexpr (Family::SYNC == SyncPlacement::Leading)  encoder.sendPreamble();
+            avr_algorithms::for_each_element(code_DataBits, sendBit);
+            if constexpr (Family::SYNC == SyncPlacement::Trailing) encoder.sendOpen();
+        };
+
+        if constexpr (Family::LEAD_IN) encoder.sendPreamble();                  // Step1: Lead-in for sync with receiver
+        sendWord();                                                                // Step2: First word
+
+        // Step3: Repeat the word the family's number of times
+        avr_algorithms::repeat(Family::WORD_REPEATS, [&]()
+        {
+            if constexpr (Family::GAP_BETWEEN_WORDS) encoder.sendSilence();    // Gap between words
+            sendWord();
+        });
+
+        encoder.setIdle();                                                         // Leave the encoder output in the protocol's resting state
+    }
+
+    /// @brief On-air duration of one burst of this family (microseconds)
+    static constexpr uint32_t burstDurationUs() { return CodeFamilies::burstDurationUs<Family>(); }
+
+protected:
+
+    Transceiver& _transceiver;
+};
@@ -6,8 +6,11 @@
 #include "Config/CC1101_Config/CC1101.h"
 #include "Debugging/Logging.h"
 #include "Config/CC1101_Config/CC1101_315MHZ_OOK_Config.h"
+#include "Config/CC1101_Config/CC1101_315MHZ_Packet_Config.h"
+#include "Transciever/CommandPacket.h"
 #include "utils/HelperConfigRegisters_CC1101.h"
 #include "Streamer/SC41344_FrameStreamer.h"
+#include "Streamer/CodeFamilyStreamer.h"
 
 #include "Policies/PROGMEMStoragePolicy.h"
 #include "Policies/RAMStoragePolicy.h"
@@ -62,14 +65,35 @@ class Transceiver : public ITransceiver
 
         template<size_t N>
         bool transmitFrame(const uint8_t (&code_DataBits)[N], IBitEncoder& encoder);    // Coordinate data transmission with the Encoder frame Streamer
+        template<typename Family>
+        bool transmitFrame(const uint8_t (&code_DataBits)[Family::WORD_BITS], IBitEncoder& encoder);    // Same, for any CodeFamilies:: layout (EV1527, SC41344<12>, ...)
+        bool openTxSession();                                                                               // Enter TX once for a batch of back-to-back frames
+        template<typename Family>
+        void streamFrame(const uint8_t (&code_DataBits)[Family::WORD_BITS], IBitEncoder& encoder);       // Stream one frame inside an open TX session
+        bool closeTxSession();                                                                              // Back to IDLE after the batch
+        bool prepareTxSession();                                                                            // Speculative: IDLE -> FSTXON while a press is debounced, openTxSession() only strobes STX
+        void cancelTxSession();                                                                             // Rejected press: FSTXON -> IDLE
+        bool txPrepared() const;                                                                            // Parked in FSTXON by prepareTxSession()
         bool readBackPATABLE(uint8_t* paTable);                                                          // Verify PATABLE buffer content   
         ReadResult readRegister(uint8_t address);                                                        // Read a specify register 
         static StatusInfo decodeStatus(ReadResult readResult);                                      // Decode and print the status byte for human-readable diagnostics. First byte returned after register read is the chip status byte    
+        uint8_t readMarcState();                                                                             // MARCSTATE through the status-register access
+
+        // -----------------------------------------------
+        //  Packet-mode command link (paired receivers)
+        // -----------------------------------------------
+        bool beginPacketLink();                                                                            // Switch the radio from async OOK to FIFO packet mode (CRC, whitening, sync, address filter)
+        void endPacketLink();                                                                              // Restore the async OOK registers used by transmitFrame()
+        bool transmitCommand(uint8_t command, uint8_t destination = PACKET_LINK_RECEIVER_ADDRESS);   // Send a command and retransmit with backoff until it is acknowledged
+        bool sendPacket(const uint8_t* payload, uint8_t length);                                   // Load the TX FIFO and send one variable-length packet
+        uint8_t receivePacket(uint8_t* buffer, uint8_t maxLength, uint16_t timeoutMs);        // Wait for a CRC-valid packet in RX, returns its length (0 on timeout)
 
     private:
 
         SPIBus& _spi;                                                                                            // Handles low level communication with the Module via SPI protocol   
         const TransceiverConfig& _transceiver_config;                                             // Store the configuration desired for the Transceiver module
+        uint8_t _packetSequence = 0;                                                                       // Sequence number of the last command sent over the packet link
+        bool _txPrepared = false;                                                                          // prepareTxSession() succeeded, not consumed or cancelled yet
        
 
         // --------------------------------------------------------------
@@ -82,11 +106,32 @@ class Transceiver : public ITransceiver
         void configurePATable(uint8_t powerlevelIndex);                                           // Configures the PATABLE for a specific power level transmission.   
 
         bool strobeCommand(CC1101::Strobes::Command command);                     // These commands are used to disable the crystal oscillator, enable receive mode, enable wake-on-radio etc
+        void strobeFast(CC1101::Strobes::Command command);                           // Strobe only, no PARTNUM read-back: callers check MARCSTATE instead
+        bool awaitMarcState(uint8_t state);                                                          // Poll MARCSTATE until `state`, calibration included (TX_PREPARE_TIMEOUT_US)
         void reset();                                                                                              // Apply full reset sequence.
         bool verifyChipId();                                                                                    // Check if the PARTNUM is 0x00 at it should be after reset
+        template<size_t N>
+        bool applyRegisterDeltas(const std::array<RegisterSettings, N>& regs);                // Apply a short register table (packet link enter/leave)
 };
 
 
+/**
+ * @brief Writes a short register table through the same helper used by begin().
+ */
+template <size_t N>
+inline bool Transceiver::applyRegisterDeltas(const std::array<RegisterSettings, N>& regs)
+{
+    auto writeLambda = [this](uint8_t addr, uint8_t val) {
+        return _spi.writeRegister(addr, val);
+    };
+
+    auto readLambda = [this](uint8_t addr) -> uint8_t {
+        return _spi.readRegister(addr).value;
+    };
+
+    return applyRegisterConfig_CC1101<RAMStoragePolicy>(regs.data(), regs.size(), writeLambda, readLambda);
+}
+
 /**
  * @brief Stream a data frame using the SC41344 protocol via the provided encoder.
  * 
@@ -101,33 +146,53 @@ class Transceiver : public ITransceiver
 template <size_t N>
 inline bool Transceiver::transmitFrame(const uint8_t (&code_DataBits)[N], IBitEncoder &encoder)
 {
-    // Alias to access strobes commands
-    using Strobe = CC1101::Strobes::Command;
+    return transmitFrame<CodeFamilies::SC41344<N>>(code_DataBits, encoder);
+}
 
+/**
+ * @brief Stream a data frame of any code family via the provided encoder.
+ *
+ * This function ensures the radio is in TX mode, sends the data using the
+ * Family frame layout, and returns the chip to IDLE.
+ *
+ * @example
+ *   transceiver.transmitFrame<CodeFamilies::EV1527>(code24Bits, ev1527Encoder);
+ *
+ * @tparam Family One of the CodeFamilies layouts.
+ * @param code_DataBits Bit array representing the logical message.
+ * @param encoder Encoder that formats the bitstream into signal pulses.
+ * @return true if transmission and cleanup completed successfully.
+ */
+template <typename Family>
+inline bool Transceiver::transmitFrame(const uint8_t (&code_DataBits)[Family::WORD_BITS], IBitEncoder &encoder)
+{
     // Ensure TX mode
-    enableTransmitMode();
-
-    /*
-    // Check if the chip is in TX mode
-    LOG_NEW_LINE("Checking if CC1101 is in TX mode...");
-    if (readRegister(CC1101::Address::MARCSTATE).value != 0x13) {
-        LOG_NEW_LINE("Error: Not in TX mode.");
-        return false;
-    }
-    */
-   
+    openTxSession();
+
     // Stream Frame
     LOG_NEW_LINE("Streaming frame to CC1101...");
-    // Create a FrameStreamer instance for the SC41344 protocol 
+    streamFrame<Family>(code_DataBits, encoder);
+
+    // Return to IDLE
+    return closeTxSession();
+}
+
+/**
+ * @brief Streams one frame of the given family, assuming openTxSession() already put the radio in TX.
+ *
+ * Used by transmitFrame() and by the gateway to send several frames back-to-back without
+ * the IDLE -> calibrate -> TX transition in between.
+ *
+ * @tparam Family One of the CodeFamilies layouts.
+ * @param code_DataBits Bit array representing the logical message.
+ * @param encoder Encoder that formats the bitstream into signal pulses.
+ */
+template <typename Family>
+inline void Transceiver::streamFrame(const uint8_t (&code_DataBits)[Family::WORD_BITS], IBitEncoder &encoder)
+{
+    // Create a FrameStreamer instance for the requested code family
     // and stream the data bits using the provided encoder
     // This will handle the encoding and timing of the bits
-    SC41344_FrameStreamer<N> streamer(*this);
+    CodeFamilyStreamer<Family> streamer(*this);
     streamer.streamFrame(code_DataBits, encoder);
-
-    // Return to IDLE
-    if (!strobeCommand(Strobe::SIDLE)) { 
-        LOG_NEW_LINE("Error: Failed to return to IDLE mode");
-        return false;
-    }
-    return true;
 }
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>
+#include "Config/Constants.h"
+#include "Config/CodeFamilies.h"
+
+/**
+ * @brief Payload of the packet-mode command link (sent after the CC1101 length byte).
+ *
+ * The receiver answers with the same sequence number and `command | PACKET_LINK_ACK_FLAG`,
+ * addressed to the fob. Retransmissions keep the sequence number so the receiver can drop
+ * duplicates when only the ACK was lost.
+ */
+struct CommandPacket
+{
+    uint8_t destination;            // First byte: checked by the CC1101 address filter (PKTCTRL1.ADR_CHK)
+    uint8_t source;
+    uint8_t sequence;
+    uint8_t command;
+};
+
+// Commands understood by the paired receiver
+namespace PacketCommand
+{
+    constexpr uint8_t OPEN_DOOR  = 0x01;
+    constexpr uint8_t CLOSE_DOOR = 0x02;
+    constexpr uint8_t TOGGLE     = 0x03;
+}
+
+/**
+ * @brief On-air time of one packet of the command link in microseconds.
+ * @param payloadBytes - Bytes after the length byte
+ */
+constexpr uint32_t packetAirtimeUs(uint8_t payloadBytes)
+{
+    return (PACKET_LINK_OVERHEAD_BYTES + payloadBytes) * 8UL * 1000000UL / PACKET_LINK_DATA_RATE_BAUD;
+}
+
+// One command packet (25 ms) must stay about an order of magnitude below a full SC41344 burst (235 ms)
+static_assert(packetAirtimeUs(sizeof(CommandPacket)) * 8 <= CodeFamilies::burstDurationUs<CodeFamilies::SC41344_8Bit>(),
+              "Command packet airtime is no longer an order of magnitude below the OOK burst");
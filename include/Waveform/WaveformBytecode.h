@@ -0,0 +1,223 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Config/Constants.h"
+
+/**
+ * @brief Compact waveform bytecode and its interpreter.
+ *
+ * A program describes a whole burst as edges (level + duration) plus structure, so a code is
+ * stored as a few dozen bytes instead of a rendered pulse table:
+ *
+ *   LEVEL_LOW  d16     LOW  for d microseconds          (3 bytes, d little endian)
+ *   LEVEL_HIGH d16     HIGH for d microseconds          (3 bytes)
+ *   GAP        n       LOW  for n x WAVEFORM_GAP_UNIT_US (2 bytes, lead-ins and inter-word silences)
+ *   SYMBOL     a       call the body at offset a, which ends with RETURN  (2 bytes)
+ *   REPEAT     n       run the ops up to the matching END_REPEAT n times (2 bytes, n >= 1)
+ *   END_REPEAT                                           (1 byte)
+ *   RETURN                                               (1 byte)
+ *   END        l       stop, leave the output at level l (2 bytes)
+ *
+ * Layout: [entry offset][symbol bodies ...][main ... END]. Offsets are 8-bit, so a program is at
+ * most 255 bytes; SYMBOL and REPEAT share a stack of WAVEFORM_MAX_DEPTH frames.
+ *
+ * Worst-case cost per edge:
+ *   next() executes the non-edge ops between two edges. Each frame can be popped once
+ *   (RETURN / END_REPEAT) and pushed once (SYMBOL / REPEAT) before an edge must come out, so at
+ *   most 2 x WAVEFORM_MAX_DEPTH + 1 structural ops run per edge (MAX_OPS_PER_EDGE with the edge
+ *   itself). next() enforces the bound: a program that needs more (an empty REPEAT body or
+ *   symbol) faults instead of stalling the waveform. With avr-gcc -Os one op is ~25-40 cycles,
+ *   so an edge costs at most ~400 cycles (25 us at 16 MHz), an order of magnitude below the
+ *   shortest pulse (300 us). WaveformPlayer measures the real value with Timer1;
+ *   test/test_waveform_bytecode plays a program at that bound and checks it on the target.
+ *
+ * Programs that went through validate() (field-loaded) or the compile-time conformance checks
+ * (built in) are played with Checked = false: no bounds, stack or budget checks on the air path.
+ */
+namespace Waveform
+{
+    namespace Op
+    {
+        constexpr uint8_t LEVEL_LOW  = 0x00;
+        constexpr uint8_t LEVEL_HIGH = 0x01;
+        constexpr uint8_t GAP        = 0x02;
+        constexpr uint8_t SYMBOL     = 0x03;
+        constexpr uint8_t REPEAT     = 0x04;
+        constexpr uint8_t END_REPEAT = 0x05;
+        constexpr uint8_t RETURN     = 0x06;
+        constexpr uint8_t END        = 0x07;
+    }
+
+    constexpr uint8_t MAX_OPS_PER_EDGE = 2 * WAVEFORM_MAX_DEPTH + 2;
+
+    /// @brief One output level held for a duration
+    struct Edge
+    {
+        uint8_t  level;
+        uint32_t durationUs;
+    };
+
+    /**
+     * @brief Steps a program one edge at a time. Usable at compile time (conformance checks) and
+     *        from the transmit loop; every fetch is bounds checked.
+     *
+     * @tparam StoragePolicy - RAMStoragePolicy or PROGMEMStoragePolicy, where the program lives
+     * @tparam Checked - false only for programs already proven by validate() / static_assert
+     */
+    template<typename StoragePolicy, bool Checked = true>
+    class Interpreter
+    {
+        public:
+
+        constexpr Interpreter(const uint8_t* program, uint8_t length):
+        _program(program), _length(length), _pc(0), _depth(0), _idleLevel(0), _opsLastEdge(0), _done(false), _faulted(length == 0), _stack{}
+        {
+            if (!_faulted) _pc = fetch();
+        }
+
+        /**
+         * @brief Produces the next edge.
+         * @return false at END (or on a fault): the output must go to idleLevel()
+         */
+        constexpr bool next(Edge& edge)
+        {
+            for (_opsLastEdge = 1; !Checked || _opsLastEdge <= MAX_OPS_PER_EDGE; ++_opsLastEdge)
+            {
+                if (_faulted || _done) return false;
+
+                uint8_t op = fetch();
+                switch (op)
+                {
+                    case Op::LEVEL_LOW:
+                    case Op::LEVEL_HIGH:
+                    {
+                        uint16_t lo = fetch();
+                        uint16_t hi = fetch();
+                        edge.level = op;
+                        edge.durationUs = static_cast<uint16_t>(lo | (hi << 8));
+                        return !_faulted;
+                    }
+
+                    case Op::GAP:
+                        edge.level = 0;
+                        edge.durationUs = static_cast<uint32_t>(fetch()) * WAVEFORM_GAP_UNIT_US;
+                        return !_faulted;
+
+                    case Op::SYMBOL:
+                    {
+                        uint8_t target = fetch();
+                        push(_pc, 0);
+                        _pc = target;
+                        break;
+                    }
+
+                    case Op::REPEAT:
+                    {
+                        uint8_t count = fetch();
+                        if (Checked && count == 0) _faulted = true;
+                        push(_pc, count);
+                        break;
+                    }
+
+                    case Op::END_REPEAT:
+                        if (Checked && (_depth == 0 || _stack[_depth - 1].count == 0)) { _faulted = true; break; }
+                        if (--_stack[_depth - 1].count > 0) _pc = _stack[_depth - 1].address;
+                        else                                 --_depth;
+                        break;
+
+                    case Op::RETURN:
+                        if (Checked && (_depth == 0 || _stack[_depth - 1].count != 0)) { _faulted = true; break; }
+                        _pc = _stack[--_depth].address;
+                        break;
+
+                    case Op::END:
+                        _idleLevel = fetch();
+                        _done = true;
+                        return false;
+
+                    default:
+                        _faulted = true;
+                        break;
+                }
+            }
+
+            _faulted = true;                                    // Over the per-edge budget
+            return false;
+        }
+
+        constexpr uint8_t idleLevel() const { return _faulted ? 0 : _idleLevel; }   // Carrier off after a fault
+        constexpr bool faulted() const { return _faulted; }
+        constexpr uint8_t opsLastEdge() const { return _opsLastEdge; }
+
+        private:
+
+        struct Frame
+        {
+            uint8_t address;                                    // Return address (SYMBOL) or body start (REPEAT)
+            uint8_t count;                                      // 0 = call frame, else iterations left
+        };
+
+        constexpr uint8_t fetch()
+        {
+            if (Checked && _pc >= _length) { _faulted = true; return Op::END; }
+            return StoragePolicy::read(_program + _pc++);
+        }
+
+        constexpr void push(uint8_t address, uint8_t count)
+        {
+            if (Checked && _depth >= WAVEFORM_MAX_DEPTH) { _faulted = true; return; }
+            _stack[_depth].address = address;
+            _stack[_depth].count   = count;
+            ++_depth;
+        }
+
+        const uint8_t* _program;
+        uint8_t _length;
+        uint8_t _pc;
+        uint8_t _depth;
+        uint8_t _idleLevel;
+        uint8_t _opsLastEdge;
+        bool    _done;
+        bool    _faulted;
+        Frame   _stack[WAVEFORM_MAX_DEPTH];
+    };
+
+    /// @brief Why a program was refused by validate()
+    enum class Verdict : uint8_t
+    {
+        Ok,
+        Malformed,                                              // Bad opcode / operand / nesting, or over the per-edge op budget
+        PulseTooShort,                                          // An edge below WAVEFORM_MIN_PULSE_US
+        PulseTooLong,                                           // An edge above WAVEFORM_MAX_PULSE_US
+        BurstTooLong,                                           // Whole burst above WAVEFORM_MAX_BURST_US
+        Empty                                                   // No edge at all
+    };
+
+    /**
+     * @brief Load-time proof that a program can be played unchecked: dry-runs it with every
+     *        check on and applies the timing limits. Every edge is at least WAVEFORM_MIN_PULSE_US,
+     *        so the dry run stops after WAVEFORM_MAX_BURST_US / WAVEFORM_MIN_PULSE_US edges at most,
+     *        whatever the REPEAT counts.
+     */
+    template<typename StoragePolicy>
+    constexpr Verdict validate(const uint8_t* program, uint8_t length)
+    {
+        Interpreter<StoragePolicy, true> interpreter(program, length);
+        Edge edge{0, 0};
+        uint32_t totalUs = 0;
+        uint16_t edges = 0;
+
+        while (interpreter.next(edge))
+        {
+            if (edge.durationUs < WAVEFORM_MIN_PULSE_US) return Verdict::PulseTooShort;
+            if (edge.durationUs > WAVEFORM_MAX_PULSE_US) return Verdict::PulseTooLong;
+            totalUs += edge.durationUs;
+            if (totalUs > WAVEFORM_MAX_BURST_US) return Verdict::BurstTooLong;
+            ++edges;
+        }
+
+        if (interpreter.faulted()) return Verdict::Malformed;
+        return edges ? Verdict::Ok : Verdict::Empty;
+    }
+}
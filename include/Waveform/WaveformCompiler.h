@@ -0,0 +1,260 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+#include "Config/Constants.h"
+#include "Config/CodeFamilies.h"
+#include "Waveform/WaveformBytecode.h"
+#include "Policies/RAMStoragePolicy.h"
+
+/**
+ * @brief constexpr compiler: protocol descriptor + code bits -> waveform bytecode.
+ *
+ * The descriptor holds the pulse shapes that normally live in the IBitEncoder (as data instead
+ * of code) and the frame layout from CodeFamilies. compile() lays the program out as:
+ *
+ *   entry | ZERO | ONE | SYNC | WORD = SYMBOL(bit) x N + SYMBOL(SYNC) | main
+ *   main  = [GAP lead-in] SYMBOL WORD  REPEAT r { [GAP gap] SYMBOL WORD }  END idle
+ *
+ * Programs are built at compile time and stored in PROGMEM:
+ *
+ * @example
+ *   constexpr auto full = Waveform::compile<CodeFamilies::SC41344_8Bit>(CODE);
+ *   const std::array<uint8_t, full.length> PROGRAM PROGMEM = Waveform::trim<full.length>(full);
+ *   waveformPlayer.play(PROGRAM.data(), PROGRAM.size());
+ */
+namespace Waveform
+{
+    /// @brief One HIGH/LOW step of a symbol
+    struct Pulse
+    {
+        uint8_t  level;
+        uint16_t durationUs;
+    };
+
+    /// @brief pulse[0..pulses) played `repeat` times
+    struct SymbolShape
+    {
+        uint8_t pulses;
+        uint8_t repeat;
+        Pulse   pulse[4];
+    };
+
+    struct ProtocolDescriptor
+    {
+        SymbolShape zero;
+        SymbolShape one;
+        SymbolShape sync;
+        CodeFamilies::SyncPlacement syncPlacement;
+        uint8_t leadInUnits;                                    // GAP units, 0 = no lead-in
+        uint8_t wordGapUnits;                                   // GAP units, 0 = words back to back
+        uint8_t wordRepeats;
+        uint8_t idleLevel;
+    };
+
+    /// @brief Pulse shapes of each family, same timings as the encoders
+    template<typename Family> struct Descriptor;
+
+    template<size_t N>
+    struct Descriptor<CodeFamilies::SC41344<N>>
+    {
+        static constexpr ProtocolDescriptor value
+        {
+            { 2, 2, { {1, SHORT_HIGH_US}, {0, LONG_LOW_US} } },                                              // '0'  : SC41344_Encoder::sendZero()
+            { 2, 2, { {1, LONG_HIGH_US},  {0, SHORT_LOW_US} } },                                             // '1'  : SC41344_Encoder::sendOne()
+            { 4, 1, { {1, LONG_HIGH_US},  {0, SHORT_LOW_US}, {1, SHORT_HIGH_US}, {0, LONG_LOW_US} } },       // OPEN : SC41344_Encoder::sendOpen()
+            CodeFamilies::SyncPlacement::Trailing,
+            PREAMBLE_LOW_DURATION_US / WAVEFORM_GAP_UNIT_US,
+            FRAME_SILENCE_BETWEEN_WORDS / WAVEFORM_GAP_UNIT_US,
+            FRAME_REPEATS,
+            1                                                                                                  // Idles HIGH
+        };
+    };
+
+    template<>
+    struct Descriptor<CodeFamilies::EV1527>
+    {
+        static constexpr ProtocolDescriptor value
+        {
+            { 2, 1, { {1, EV1527_BASE_PULSE_US},     {0, 3 * EV1527_BASE_PULSE_US} } },
+            { 2, 1, { {1, 3 * EV1527_BASE_PULSE_US}, {0, EV1527_BASE_PULSE_US} } },
+            { 2, 1, { {1, EV1527_BASE_PULSE_US},     {0, EV1527_SYNC_LOW_US} } },
+            CodeFamilies::SyncPlacement::Leading,
+            0,
+            0,
+            EV1527_WORD_REPEATS,
+            0                                                                                                  // Idles LOW
+        };
+    };
+
+    /// @brief Compiler output, fixed capacity until trim()
+    struct Program
+    {
+        std::array<uint8_t, WAVEFORM_MAX_PROGRAM_BYTES> bytes;
+        size_t length;
+        bool   overflow;
+    };
+
+    namespace detail
+    {
+        struct Assembler
+        {
+            Program program{};
+
+            constexpr uint8_t here() const { return static_cast<uint8_t>(program.length); }
+
+            constexpr void emit(uint8_t byte)
+            {
+                if (program.length >= WAVEFORM_MAX_PROGRAM_BYTES) { program.overflow = true; return; }
+                program.bytes[program.length++] = byte;
+            }
+
+            constexpr void level(const Pulse& pulse)
+            {
+                emit(pulse.level ? Op::LEVEL_HIGH : Op::LEVEL_LOW);
+                emit(static_cast<uint8_t>(pulse.durationUs));
+                emit(static_cast<uint8_t>(pulse.durationUs >> 8));
+            }
+
+            // Body of a symbol, returns its offset
+            constexpr uint8_t symbol(const SymbolShape& shape)
+            {
+                uint8_t start = here();
+                if (shape.repeat > 1) { emit(Op::REPEAT); emit(shape.repeat); }
+                for (uint8_t i = 0; i < shape.pulses; ++i) level(shape.pulse[i]);
+                if (shape.repeat > 1) emit(Op::END_REPEAT);
+                emit(Op::RETURN);
+                return start;
+            }
+
+            constexpr void call(uint8_t target) { emit(Op::SYMBOL); emit(target); }
+        };
+
+        template<size_t N>
+        constexpr Program compileWith(const ProtocolDescriptor& d, const uint8_t (&bits)[N])
+        {
+            Assembler as{};
+            as.emit(0);                                             // Entry offset, patched below
+
+            uint8_t zero = as.symbol(d.zero);
+            uint8_t one  = as.symbol(d.one);
+            uint8_t sync = as.symbol(d.sync);
+
+            uint8_t word = as.here();
+            if (d.syncPlacement == CodeFamilies::SyncPlacement::Leading) as.call(sync);
+            for (size_t i = 0; i < N; ++i) as.call(bits[i] ? one : zero);
+            if (d.syncPlacement == CodeFamilies::SyncPlacement::Trailing) as.call(sync);
+            as.emit(Op::RETURN);
+
+            uint8_t entry = as.here();
+            if (d.leadInUnits) { as.emit(Op::GAP); as.emit(d.leadInUnits); }
+            as.call(word);
+            if (d.wordRepeats)
+            {
+                as.emit(Op::REPEAT); as.emit(d.wordRepeats);
+                if (d.wordGapUnits) { as.emit(Op::GAP); as.emit(d.wordGapUnits); }
+                as.call(word);
+                as.emit(Op::END_REPEAT);
+            }
+            as.emit(Op::END);
+            as.emit(d.idleLevel);
+
+            as.program.bytes[0] = entry;
+            return as.program;
+        }
+    }
+
+    /**
+     * @brief Compiles one burst of `bits` with the Family's layout and pulse shapes.
+     *        Check `overflow == false` (the conformance asserts below do for every family).
+     */
+    template<typename Family, size_t N>
+    constexpr Program compile(const uint8_t (&bits)[N])
+    {
+        static_assert(N == Family::WORD_BITS, "Code length does not match the family word");
+        return detail::compileWith(Descriptor<Family>::value, bits);
+    }
+
+    /**
+     * @brief One word of `bits` after `leadInUnits` of silence, for streams that repeat words until
+     *        told to stop (WaveformStreamer): [GAP lead-in] SYMBOL WORD END. Back to back, the
+     *        Family's lead-in word then word-gap words replay compile()'s burst.
+     */
+    template<typename Family, size_t N>
+    constexpr Program compileWord(const uint8_t (&bits)[N], uint8_t leadInUnits)
+    {
+        static_assert(N == Family::WORD_BITS, "Code length does not match the family word");
+        ProtocolDescriptor d = Descriptor<Family>::value;
+        d.leadInUnits = leadInUnits;
+        d.wordRepeats = 0;
+        return detail::compileWith(d, bits);
+    }
+
+    /// @brief Exact-size copy of a compiled program, ready for a PROGMEM table
+    template<size_t Length>
+    constexpr std::array<uint8_t, Length> trim(const Program& program)
+    {
+        std::array<uint8_t, Length> out{};
+        for (size_t i = 0; i < Length; ++i) out[i] = program.bytes[i];
+        return out;
+    }
+
+    /// @brief Runs a program at compile time: total on-air time, edge count and the worst ops-per-edge
+    struct RunResult
+    {
+        uint32_t durationUs;
+        uint16_t edges;
+        uint8_t  worstOpsPerEdge;
+        bool     faulted;
+    };
+
+    constexpr RunResult run(const Program& program)
+    {
+        Interpreter<RAMStoragePolicy> interpreter(program.bytes.data(), static_cast<uint8_t>(program.length));
+        RunResult result{0, 0, 0, false};
+        Edge edge{0, 0};
+        while (interpreter.next(edge))
+        {
+            result.durationUs += edge.durationUs;
+            result.edges++;
+            if (interpreter.opsLastEdge() > result.worstOpsPerEdge) result.worstOpsPerEdge = interpreter.opsLastEdge();
+        }
+        result.faulted = interpreter.faulted();
+        return result;
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Conformance: compiled programs replay the same burst as the streamers
+    // ---------------------------------------------------------------------------------
+    namespace detail
+    {
+        constexpr uint8_t TEST_CODE_8[8]   = { 1, 1, 0, 1, 1, 0, 0, 0 };
+        constexpr uint8_t TEST_CODE_24[24] = { 1, 0, 1, 1, 0, 0, 1, 0, 1, 1, 1, 0, 0, 0, 1, 0, 1, 0, 0, 1, 1, 0, 1, 1 };
+
+        constexpr Program SC41344_8_PROGRAM  = compile<CodeFamilies::SC41344_8Bit>(TEST_CODE_8);
+        constexpr Program SC41344_24_PROGRAM = compile<CodeFamilies::SC41344_24Bit>(TEST_CODE_24);
+        constexpr Program EV1527_PROGRAM     = compile<CodeFamilies::EV1527>(TEST_CODE_24);
+
+        constexpr RunResult SC41344_8_RUN  = run(SC41344_8_PROGRAM);
+        constexpr RunResult SC41344_24_RUN = run(SC41344_24_PROGRAM);
+        constexpr RunResult EV1527_RUN     = run(EV1527_PROGRAM);
+    }
+
+    static_assert(!detail::SC41344_8_PROGRAM.overflow && !detail::SC41344_24_PROGRAM.overflow && !detail::EV1527_PROGRAM.overflow,
+                  "WAVEFORM_MAX_PROGRAM_BYTES too small for a supported family");
+    static_assert(detail::SC41344_8_PROGRAM.length <= 80, "SC41344 8-bit burst should stay a few dozen bytes");
+
+    static_assert(!detail::SC41344_8_RUN.faulted && !detail::SC41344_24_RUN.faulted && !detail::EV1527_RUN.faulted,
+                  "Compiled program faults in the interpreter");
+    static_assert(detail::SC41344_8_RUN.durationUs  == CodeFamilies::burstDurationUs<CodeFamilies::SC41344_8Bit>(),  "SC41344 8-bit program differs from the capture");
+    static_assert(detail::SC41344_24_RUN.durationUs == CodeFamilies::burstDurationUs<CodeFamilies::SC41344_24Bit>(), "SC41344 24-bit program differs from the streamer");
+    static_assert(detail::EV1527_RUN.durationUs     == CodeFamilies::burstDurationUs<CodeFamilies::EV1527>(),        "EV1527 program differs from the capture");
+
+    // 4 words x (8 digits x 4 edges + OPEN 4 edges) + lead-in + 3 gaps
+    static_assert(detail::SC41344_8_RUN.edges == 4 * (8 * 4 + 4) + 1 + 3, "SC41344 8-bit program edge count");
+
+    // Per-edge bound: the deepest supported program stays within the budget next() enforces
+    static_assert(detail::SC41344_24_RUN.worstOpsPerEdge <= MAX_OPS_PER_EDGE && detail::EV1527_RUN.worstOpsPerEdge <= MAX_OPS_PER_EDGE,
+                  "Interpreter exceeds the documented ops-per-edge bound");
+}
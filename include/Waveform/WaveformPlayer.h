@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/DigitalPin.h"
+#include "Waveform/WaveformBytecode.h"
+#include "Policies/PROGMEMStoragePolicy.h"
+#include "Policies/RAMStoragePolicy.h"
+#include "Delay/Timebase.h"
+
+/**
+ * @brief Plays a proven waveform program on the GDO0 pin, timed by Timer1.
+ *
+ * Timer1 free-runs at clk/8 (0.5 us per tick) and every edge is scheduled on an absolute
+ * deadline: the level is written, the interpreter decodes the following edge while the current
+ * one is on air, then the loop waits for the deadline. Decode time therefore never stretches a
+ * pulse as long as it stays below the pulse itself (see the per-edge bound in WaveformBytecode.h);
+ * the worst decode time seen is kept in worstEdgeCostTicks().
+ *
+ * Only programs proven ahead of time are accepted (the interpreter runs unchecked):
+ *   - play()      : built-in PROGMEM programs, proven by static_assert at compile time
+ *   - playCached(): field-loaded programs, proven by Waveform::validate() when loaded, played
+ *                   from the RAM cache (ld is cheaper than lpm, so never slower than PROGMEM)
+ *
+ * The periodic ISRs are suspended for the burst and the Timebase advanced by its length, so it
+ * can run with interrupts disabled like the other transmit paths or with them enabled (UART live)
+ * without edge jitter. Timer1 registers are restored afterwards.
+ *
+ * @example
+ *   WaveformPlayer player(gdo0Pin);
+ *   transceiver.openTxSession();
+ *   player.play(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size());
+ *   transceiver.closeTxSession();
+ */
+class WaveformPlayer
+{
+    public:
+
+    explicit WaveformPlayer(DigitalPin& pinPort_GDO0);
+
+    void play(const uint8_t* program, uint8_t length);         // Program in PROGMEM (blocking)
+    void playCached(const uint8_t* program, uint8_t length);   // Program in RAM (blocking)
+    uint16_t worstEdgeCostTicks() const;                       // Longest next() call so far, Timer1 ticks (0.5 us)
+
+    private:
+
+    template<typename StoragePolicy>
+    void run(const uint8_t* program, uint8_t length);
+
+    DigitalPin& _GDO0_pin;
+    uint16_t    _worstEdgeCostTicks;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/DigitalPin.h"
+#include "Waveform/WaveformBytecode.h"
+#include "Policies/PROGMEMStoragePolicy.h"
+
+/**
+ * @brief Non-blocking waveform playback for hold-to-transmit: words are streamed from the
+ *        Timer1 compare A interrupt while loop() keeps running (debounce, UART, watchdog).
+ *
+ * Timer1 free-runs at clk/8 (0.5 us per tick). Each compare writes the level decoded for it,
+ * moves OCR1A by that edge's duration (absolute deadlines, no drift) and decodes the next edge
+ * while this one is on air, exactly like WaveformPlayer but one edge per interrupt. Edges are
+ * late by the interrupt latency plus whatever ISR is running (Timebase tick, Timer0, UART: a
+ * few us against 300 us pulses), never accumulated.
+ *
+ * The stream is a first program, then a second one replayed back to back until stop():
+ *   - both are single-word programs (Waveform::compileWord), so a program end is a word boundary
+ *   - stop() lets the word on air, or the one whose gap is on air, finish; the carrier is never
+ *     cut inside a word
+ *   - at least `minWords` are sent whatever stop() says: a tap sends the normal burst
+ *
+ * Programs are PROGMEM and proven ahead of time (played unchecked). Timer1 registers are restored
+ * when the stream ends.
+ *
+ * @example
+ *   transceiver.openTxSession();
+ *   streamer.start(FIRST.data(), FIRST.size(), NEXT.data(), NEXT.size(), 4);
+ *   ...                                                         // loop() runs
+ *   streamer.stop();                                            // Release confirmed
+ *   if (!streamer.busy()) transceiver.closeTxSession();
+ */
+class WaveformStreamer
+{
+    public:
+
+    explicit WaveformStreamer(DigitalPin& pinPort_GDO0);
+
+    void start(const uint8_t* first, uint8_t firstLength, const uint8_t* next, uint8_t nextLength, uint16_t minWords);
+    void stop();                                                // Finish at the next word boundary (after minWords)
+    bool busy() const;                                          // Until the last edge is over and Timer1 is restored
+    uint16_t words() const;                                     // Words completed so far
+
+    void onCompare();                                           // TIMER1_COMPA ISR only
+
+    private:
+
+    using Interpreter = Waveform::Interpreter<PROGMEMStoragePolicy, false>;
+
+    void finish();                                              // ISR: idle level, Timer1 back
+
+    DigitalPin&      _GDO0_pin;
+    Interpreter      _interpreter;
+    Waveform::Edge   _edge;                                     // Written at the next compare
+    const uint8_t*   _next;
+    uint8_t          _nextLength;
+    uint16_t         _minWords;
+    volatile uint16_t _words;
+    volatile bool    _repeat;
+    volatile bool    _busy;
+    bool             _onAir;                                    // _edge holds an edge to write
+    uint8_t          _savedTCCR1A;
+    uint8_t          _savedTCCR1B;
+};
@@ -10,4 +10,6 @@ void printDots(uint8_t numOfDots, unsigned long delay_ms);
 
 /// Function to wait for a specified delay in milliseconds
 /// This function is useful for adding a delay between operations, such as during initialization or data processing
-void wait(unsigned long delay_ms);
\ No newline at end of file
+void wait(unsigned long delay_ms);
+/// Seed for randomSeed() from the LSBs of a floating analog pin: differs per unit and per boot
+uint32_t analogNoiseSeed(uint8_t pin);
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Fixed-capacity FIFO ring for a single producer and a single consumer.
+ *
+ * The capacity must be a power of two so wrapping is a mask instead of a division, and the
+ * head/tail indices are free-running 8-bit counters: `head - tail` is the fill level even after
+ * they overflow. One side may run in an ISR as long as it only touches its own index.
+ *
+ * @tparam T - Element type (copied in and out)
+ * @tparam N - Capacity, power of two, at most 128
+ *
+ * @example
+ *   RingBuffer<uint8_t, 16> rx;
+ *   rx.push(0x42);
+ *   uint8_t byte;
+ *   if (rx.pop(byte)) { ... }
+ */
+template<typename T, uint8_t N>
+class RingBuffer
+{
+    static_assert(N > 0 && N <= 128 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two <= 128");
+
+    public:
+
+    bool push(const T& item)
+    {
+        if (full()) return false;
+        _items[_head & MASK] = item;
+        _head = _head + 1;
+        return true;
+    }
+
+    bool pop(T& item)
+    {
+        if (empty()) return false;
+        item = _items[_tail & MASK];
+        _tail = _tail + 1;
+        return true;
+    }
+
+    // Oldest element, only valid when !empty()
+    const T& front() const { return _items[_tail & MASK]; }
+    void dropFront() { if (!empty()) _tail = _tail + 1; }
+
+    uint8_t size() const { return static_cast<uint8_t>(_head - _tail); }
+    uint8_t freeSlots() const { return N - size(); }
+    bool empty() const { return _head == _tail; }
+    bool full() const { return size() == N; }
+    void clear() { _tail = _head; }
+
+    static constexpr uint8_t capacity() { return N; }
+
+    private:
+
+    static constexpr uint8_t MASK = N - 1;
+
+    T _items[N];
+    volatile uint8_t _head = 0;                 // Written by the producer only
+    volatile uint8_t _tail = 0;                 // Written by the consumer only
+};
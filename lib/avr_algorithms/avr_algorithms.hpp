@@ -1,6 +1,7 @@
 #pragma once
 #include <Arduino.h>
 #include "Config/CC1101_Config/CC1101.h"
+#include "avr_views.hpp"                       // Lazy views: avr_algorithms::views
 
 /// @brief Namespace for AVR algorithms and utilities
 /// @note This namespace contains various utility functions and algorithms that can be used in AVR-based applications
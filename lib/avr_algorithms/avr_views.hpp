@@ -0,0 +1,474 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+
+/// @brief Lazy, composable views over arrays, flash tables and packed bit fields
+/// @note Views are push based: a view hands each element to the next stage through a callable
+/// instead of exposing iterators, so a pipeline such as `bits(code, 24) | filter(...) | take(8)`
+/// inlines into one loop with no intermediate buffers. Every view and terminal is constexpr,
+/// which is how the conformance checks at the end of this file run.
+/// @namespace avr_algorithms::views
+namespace avr_algorithms {
+namespace views {
+
+/**
+ * @brief Default reader of the sources: plain RAM access.
+ * * Any type with a `static uint8_t read(const uint8_t*)` can replace it, e.g. PROGMEMStoragePolicy.
+ */
+struct ram_reader {
+    static constexpr uint8_t read(const uint8_t* ptr) { return *ptr; }
+};
+
+/// @brief Element of enumerate(): position in the view and the value
+template<typename T>
+struct indexed {
+    size_t index;
+    T value;
+};
+
+/// @brief Element of chunk<N>(): up to N values, only the last chunk can be short
+template<typename T, size_t N>
+struct chunk_of {
+    T item[N];
+    uint8_t size;
+};
+
+/// @brief Element of zip(): one value of each source
+template<typename A, typename B>
+struct pair_of {
+    A first;
+    B second;
+};
+
+/**
+ * @brief Terminal operations shared by every view.
+ * * A view only provides `each(sink)`: it calls `sink(value)` per element and stops as soon as the
+ *   sink returns false. It returns false when the sink stopped it, true when the view ran out.
+ *
+ * @tparam Derived - The view (CRTP)
+ */
+template<typename Derived>
+struct view_base {
+
+    /**
+     * @brief Applies a function to each element of the view.
+     * * @example
+     *   views::bits(code, 24).for_each([](uint8_t bit) { bit ? encoder.sendOne() : encoder.sendZero(); });
+     */
+    template<typename Func>
+    constexpr void for_each(Func&& func) const {
+        self().each([&](const auto& value) { func(value); return true; });
+    }
+
+    /**
+     * @brief Applies a function to each element until it returns false.
+     * @return bool - true if every element was visited
+     */
+    template<typename Func>
+    constexpr bool for_each_until(Func&& func) const {
+        return self().each([&](const auto& value) { return static_cast<bool>(func(value)); });
+    }
+
+    /// @brief Number of elements that satisfy the predicate
+    template<typename Predicate>
+    constexpr size_t count_if(Predicate&& predicate) const {
+        size_t count = 0;
+        self().each([&](const auto& value) { if (predicate(value)) ++count; return true; });
+        return count;
+    }
+
+    /// @brief Number of elements (walks the view, filters included)
+    constexpr size_t count() const {
+        size_t count = 0;
+        self().each([&](const auto&) { ++count; return true; });
+        return count;
+    }
+
+    /**
+     * @brief Left fold: op(op(op(init, v0), v1), ...).
+     * * @example
+     *   uint8_t xorSum = views::span(frame, len).fold(uint8_t{0}, [](uint8_t acc, uint8_t b) { return acc ^ b; });
+     */
+    template<typename T, typename Op>
+    constexpr T fold(T init, Op&& op) const {
+        self().each([&](const auto& value) { init = op(init, value); return true; });
+        return init;
+    }
+
+    /**
+     * @brief Copies the view into a buffer.
+     * @return size_t - The number of elements written (at most 'capacity')
+     */
+    template<typename T>
+    constexpr size_t copy_to(T* dest, size_t capacity) const {
+        size_t written = 0;
+        if (capacity == 0) return 0;
+        self().each([&](const auto& value) { dest[written++] = value; return written < capacity; });
+        return written;
+    }
+
+    private:
+    constexpr const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+/**
+ * @brief Random-access source: `size()` and `operator[]`, plus a plain indexed loop for each().
+ * * Sources are the only views zip() accepts.
+ */
+template<typename Derived>
+struct source_base : view_base<Derived> {
+
+    template<typename Sink>
+    constexpr bool each(Sink&& sink) const {
+        const Derived& source = static_cast<const Derived&>(*this);
+        for (size_t i = 0; i < source.size(); ++i) {
+            if (!sink(source[i])) return false;
+        }
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------------
+//  Sources
+// ---------------------------------------------------------------------------------
+
+/**
+ * @brief Elements of a RAM array or buffer, passed by reference.
+ * * Also usable over a PROGMEM table of structs as long as the next stage reads the fields through
+ *   the StoragePolicy (the element is never dereferenced here, only its address is handed on).
+ *
+ * @example
+ *   views::span(config, N) | views::transform([](const RegisterSettings& r) { return PROGMEMStoragePolicy::read(&r.reg); })
+ */
+template<typename T>
+struct span_view : source_base<span_view<T>> {
+    using value_type = T;
+
+    const T* data;
+    size_t length;
+
+    constexpr span_view(const T* data, size_t length) : data(data), length(length) {}
+
+    constexpr size_t size() const { return length; }
+    constexpr const T& operator[](size_t i) const { return data[i]; }
+};
+
+template<typename T>
+constexpr span_view<T> span(const T* data, size_t length) { return span_view<T>(data, length); }
+
+template<typename T, size_t N>
+constexpr span_view<T> span(const T (&array)[N]) { return span_view<T>(array, N); }
+
+/**
+ * @brief Bytes read through a storage policy (RAM, PROGMEM, ...).
+ * * @example
+ *   views::stored<PROGMEMStoragePolicy>(PROGRAM.data(), PROGRAM.size()).fold(...)
+ */
+template<typename Reader>
+struct stored_view : source_base<stored_view<Reader>> {
+    using value_type = uint8_t;
+
+    const uint8_t* data;
+    size_t length;
+
+    constexpr stored_view(const uint8_t* data, size_t length) : data(data), length(length) {}
+
+    constexpr size_t size() const { return length; }
+    constexpr uint8_t operator[](size_t i) const { return Reader::read(data + i); }
+};
+
+template<typename Reader>
+constexpr stored_view<Reader> stored(const uint8_t* data, size_t length) { return stored_view<Reader>(data, length); }
+
+/**
+ * @brief Fields of Width bits packed MSB first in a byte array (Width = 1, 2 or 4).
+ * * each() walks a mask one step per field: AVR has no barrel shifter, so `byte >> i` with a
+ *   variable i would be a loop per element. operator[] (used by zip) pays that shift.
+ *
+ * @tparam Width - Bits per field
+ * @tparam Reader - Where the bytes live (ram_reader or a StoragePolicy)
+ */
+template<uint8_t Width, typename Reader = ram_reader>
+struct packed_view : source_base<packed_view<Width, Reader>> {
+    static_assert(Width == 1 || Width == 2 || Width == 4, "Fields must not straddle a byte");
+    static constexpr uint8_t PER_BYTE = 8 / Width;
+    static constexpr uint8_t MASK = static_cast<uint8_t>((1u << Width) - 1);
+
+    using value_type = uint8_t;
+
+    const uint8_t* data;
+    size_t fields;
+
+    constexpr packed_view(const uint8_t* data, size_t fields) : data(data), fields(fields) {}
+
+    constexpr size_t size() const { return fields; }
+
+    constexpr uint8_t operator[](size_t i) const {
+        uint8_t shift = static_cast<uint8_t>((PER_BYTE - 1 - i % PER_BYTE) * Width);
+        return static_cast<uint8_t>((Reader::read(data + i / PER_BYTE) >> shift) & MASK);
+    }
+
+    template<typename Sink>
+    constexpr bool each(Sink&& sink) const {
+        const uint8_t* byte = data;
+        uint8_t current = 0;
+        uint8_t left = 0;
+        for (size_t i = 0; i < fields; ++i) {
+            if (left == 0) { current = Reader::read(byte++); left = PER_BYTE; }
+            uint8_t field = static_cast<uint8_t>(current >> (8 - Width));
+            current = static_cast<uint8_t>(current << Width);
+            --left;
+            if (!sink(field)) return false;
+        }
+        return true;
+    }
+};
+
+/// @brief Bit by bit, MSB first: 'count' bits starting at data[0] bit 7
+template<typename Reader = ram_reader>
+constexpr packed_view<1, Reader> bits(const uint8_t* data, size_t count) { return packed_view<1, Reader>(data, count); }
+
+/// @brief Each byte as two nibbles, high nibble first (hex dumps)
+template<typename Reader = ram_reader>
+constexpr packed_view<4, Reader> nibbles(const uint8_t* data, size_t bytes) { return packed_view<4, Reader>(data, 2 * bytes); }
+
+/**
+ * @brief Walks two sources side by side, stops at the shorter one.
+ * * @example
+ *   views::zip(views::span(expected, n), views::span(readback, n)).count_if([](const auto& p) { return p.first != p.second; });
+ */
+template<typename A, typename B>
+struct zip_view : source_base<zip_view<A, B>> {
+    using value_type = pair_of<typename A::value_type, typename B::value_type>;
+
+    A a;
+    B b;
+
+    constexpr zip_view(const A& a, const B& b) : a(a), b(b) {}
+
+    constexpr size_t size() const { return a.size() < b.size() ? a.size() : b.size(); }
+    constexpr value_type operator[](size_t i) const { return value_type{a[i], b[i]}; }
+};
+
+template<typename A, typename B>
+constexpr zip_view<A, B> zip(const A& a, const B& b) { return zip_view<A, B>(a, b); }
+
+// ---------------------------------------------------------------------------------
+//  Adaptors: `view | adaptor` builds the next stage, nothing runs until a terminal
+// ---------------------------------------------------------------------------------
+
+struct adaptor_tag {};
+
+template<typename View, typename Adaptor,
+         typename = std::enable_if_t<std::is_base_of<adaptor_tag, Adaptor>::value>>
+constexpr auto operator|(const View& view, const Adaptor& adaptor) {
+    return adaptor.apply(view);
+}
+
+template<typename Source, typename Func>
+struct transform_view : view_base<transform_view<Source, Func>> {
+    using value_type = std::decay_t<decltype(std::declval<const Func&>()(std::declval<const typename Source::value_type&>()))>;
+
+    Source source;
+    Func func;
+
+    constexpr transform_view(const Source& source, const Func& func) : source(source), func(func) {}
+
+    template<typename Sink>
+    constexpr bool each(Sink&& sink) const {
+        return source.each([&](const auto& value) { return sink(func(value)); });
+    }
+};
+
+template<typename Func>
+struct transform_adaptor : adaptor_tag {
+    Func func;
+    template<typename Source>
+    constexpr transform_view<Source, Func> apply(const Source& source) const { return transform_view<Source, Func>(source, func); }
+};
+
+/// @brief Each element replaced by func(element)
+template<typename Func>
+constexpr transform_adaptor<Func> transform(Func func) { return transform_adaptor<Func>{{}, func}; }
+
+template<typename Source, typename Predicate>
+struct filter_view : view_base<filter_view<Source, Predicate>> {
+    using value_type = typename Source::value_type;
+
+    Source source;
+    Predicate predicate;
+
+    constexpr filter_view(const Source& source, const Predicate& predicate) : source(source), predicate(predicate) {}
+
+    template<typename Sink>
+    constexpr bool each(Sink&& sink) const {
+        return source.each([&](const auto& value) { return predicate(value) ? sink(value) : true; });
+    }
+};
+
+template<typename Predicate>
+struct filter_adaptor : adaptor_tag {
+    Predicate predicate;
+    template<typename Source>
+    constexpr filter_view<Source, Predicate> apply(const Source& source) const { return filter_view<Source, Predicate>(source, predicate); }
+};
+
+/// @brief Only the elements that satisfy the predicate
+template<typename Predicate>
+constexpr filter_adaptor<Predicate> filter(Predicate predicate) { return filter_adaptor<Predicate>{{}, predicate}; }
+
+template<typename Source>
+struct take_view : view_base<take_view<Source>> {
+    using value_type = typename Source::value_type;
+
+    Source source;
+    size_t limit;
+
+    constexpr take_view(const Source& source, size_t limit) : source(source), limit(limit) {}
+
+    template<typename Sink>
+    constexpr bool each(Sink&& sink) const {
+        if (limit == 0) return true;
+        size_t left = limit;
+        bool stopped = false;
+        source.each([&](const auto& value) {
+            if (!sink(value)) { stopped = true; return false; }
+            return --left != 0;                                 // Stops the source early, not an error
+        });
+        return !stopped;
+    }
+};
+
+struct take_adaptor : adaptor_tag {
+    size_t limit;
+    template<typename Source>
+    constexpr take_view<Source> apply(const Source& source) const { return take_view<Source>(source, limit); }
+};
+
+/// @brief At most the first 'limit' elements; the source is not read past them
+constexpr take_adaptor take(size_t limit) { return take_adaptor{{}, limit}; }
+
+template<typename Source>
+struct enumerate_view : view_base<enumerate_view<Source>> {
+    using value_type = indexed<typename Source::value_type>;
+
+    Source source;
+
+    constexpr explicit enumerate_view(const Source& source) : source(source) {}
+
+    template<typename Sink>
+    constexpr bool each(Sink&& sink) const {
+        size_t index = 0;
+        return source.each([&](const auto& value) { return sink(value_type{index++, value}); });
+    }
+};
+
+struct enumerate_adaptor : adaptor_tag {
+    template<typename Source>
+    constexpr enumerate_view<Source> apply(const Source& source) const { return enumerate_view<Source>(source); }
+};
+
+/// @brief Each element paired with its position (copies the value: read flash fields first)
+constexpr enumerate_adaptor enumerate() { return enumerate_adaptor{}; }
+
+template<typename Source, size_t N>
+struct chunk_view : view_base<chunk_view<Source, N>> {
+    using value_type = chunk_of<typename Source::value_type, N>;
+
+    Source source;
+
+    constexpr explicit chunk_view(const Source& source) : source(source) {}
+
+    template<typename Sink>
+    constexpr bool each(Sink&& sink) const {
+        value_type chunk{};
+        bool completed = source.each([&](const auto& value) {
+            chunk.item[chunk.size++] = value;
+            if (chunk.size < N) return true;
+            bool more = sink(static_cast<const value_type&>(chunk));
+            chunk.size = 0;
+            return more;
+        });
+        if (!completed) return false;
+        return chunk.size == 0 || sink(static_cast<const value_type&>(chunk));
+    }
+};
+
+template<size_t N>
+struct chunk_adaptor : adaptor_tag {
+    static_assert(N > 0 && N < 256, "Chunk size must fit chunk_of::size");
+    template<typename Source>
+    constexpr chunk_view<Source, N> apply(const Source& source) const { return chunk_view<Source, N>(source); }
+};
+
+/// @brief Groups of N consecutive elements (one N-element buffer on the stack, not a copy of the view)
+template<size_t N>
+constexpr chunk_adaptor<N> chunk() { return chunk_adaptor<N>{}; }
+
+// ---------------------------------------------------------------------------------
+//  Conformance: views give the same results as the hand-written loops
+// ---------------------------------------------------------------------------------
+namespace detail {
+    constexpr uint8_t TEST_BYTES[3] = { 0xB2, 0x0F, 0x5A };             // 1011 0010  0000 1111  0101 1010
+
+    constexpr bool bits_match_shifts() {
+        size_t i = 0;
+        return bits(TEST_BYTES, 24).for_each_until([&](uint8_t bit) {
+            bool same = bit == ((TEST_BYTES[i / 8] >> (7 - i % 8)) & 1);
+            ++i;
+            return same;
+        });
+    }
+
+    constexpr size_t ones_in_first_ten() {
+        return (bits(TEST_BYTES, 24) | take(10)).count_if([](uint8_t bit) { return bit != 0; });
+    }
+
+    constexpr uint16_t hex_digits_checksum() {
+        return (nibbles(TEST_BYTES, 3)
+                | transform([](uint8_t n) { return static_cast<uint8_t>(n < 10 ? '0' + n : 'A' + n - 10); }))
+               .fold(uint16_t{0}, [](uint16_t acc, uint8_t c) { return static_cast<uint16_t>(acc * 31 + c); });
+    }
+
+    constexpr uint16_t expected_hex_checksum() {
+        const char text[] = "B20F5A";
+        uint16_t acc = 0;
+        for (size_t i = 0; i < 6; ++i) acc = static_cast<uint16_t>(acc * 31 + static_cast<uint8_t>(text[i]));
+        return acc;
+    }
+
+    constexpr size_t odd_positions_set() {
+        return (bits(TEST_BYTES, 8) | enumerate() | filter([](const auto& e) { return e.index % 2 == 1; }))
+               .count_if([](const auto& e) { return e.value != 0; });
+    }
+
+    constexpr uint8_t last_chunk_size() {
+        uint8_t size = 0;
+        (span(TEST_BYTES) | chunk<2>()).for_each([&](const auto& c) { size = c.size; });
+        return size;
+    }
+
+    constexpr size_t zip_differences() {
+        constexpr uint8_t other[3] = { 0xB2, 0x0E, 0x5A };
+        return zip(span(TEST_BYTES), span(other)).count_if([](const auto& p) { return p.first != p.second; });
+    }
+
+    constexpr bool packed_index_matches_each() {
+        size_t i = 0;
+        constexpr packed_view<2> pairs(TEST_BYTES, 12);
+        return pairs.for_each_until([&](uint8_t v) { return v == pairs[i++]; });
+    }
+}
+
+static_assert(detail::bits_match_shifts(), "bits() disagrees with shift-and-mask");
+static_assert(detail::ones_in_first_ten() == 4, "take() over bits()");
+static_assert(detail::hex_digits_checksum() == detail::expected_hex_checksum(), "nibbles() + transform() hex digits");
+static_assert(detail::odd_positions_set() == 1, "enumerate() + filter()");
+static_assert(detail::last_chunk_size() == 1, "chunk() must flush the short tail");
+static_assert(detail::zip_differences() == 1, "zip()");
+static_assert(detail::packed_index_matches_each(), "packed_view operator[] disagrees with each()");
+
+} // namespace views
+} // namespace avr_algorithms
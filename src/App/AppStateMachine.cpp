@@ -0,0 +1,284 @@
+#include "App/AppStateMachine.h"
+#include <util/atomic.h>
+#include "Policies/PROGMEMStoragePolicy.h"
+
+
+namespace
+{
+    using S = AppState;
+    using E = AppEvent;
+    using A = AppAction;
+
+    struct Rule
+    {
+        AppState  state;
+        AppEvent  event;
+        AppState  next;
+        AppAction action;
+    };
+
+    constexpr uint8_t UNHANDLED = 0xFF;                         // No rule: event dropped
+    constexpr uint8_t STAY      = 0xFE;                         // Internal rule: event consumed, no transition
+
+    constexpr AppState INTERNAL = S::Ready;                     // Ready is never entered: as a rule target it means STAY
+
+    // Rules on Ready apply to Idle, Armed, Debouncing and Sleeping unless they override them.
+    // A rule whose next state is its own state re-enters it (timeout restarts, traced).
+    constexpr Rule RULES[] =
+    {
+        { S::Boot,         E::BootDone,        S::Idle,         A::None     },
+
+        { S::Ready,        E::Edge,            S::Armed,        A::None     },
+        { S::Ready,        E::PressConfirmed,  S::Transmitting, A::Transmit },     // A late confirmation still transmits
+        { S::Ready,        E::LearnStart,      S::Learning,     A::None     },
+
+        { S::Idle,         E::Timeout,         S::Sleeping,     A::None     },
+        { S::Armed,        E::Edge,            INTERNAL,        A::None     },     // Contact still bouncing
+        { S::Armed,        E::DebounceRunning, S::Debouncing,   A::Prepare  },
+        { S::Armed,        E::Timeout,         S::Idle,         A::None     },
+        { S::Debouncing,   E::Edge,            INTERNAL,        A::None     },
+        { S::Debouncing,   E::Timeout,         S::Idle,         A::Discard  },     // Noise that never confirmed
+        { S::Debouncing,   E::LearnStart,      S::Learning,     A::Discard  },
+
+        { S::Transmitting, E::TxDone,          S::Idle,         A::None     },
+        { S::Transmitting, E::TxFailed,        S::Recovering,   A::Recover  },
+
+        { S::Recovering,   E::RecoveryDone,    S::Idle,         A::None     },
+        { S::Recovering,   E::Timeout,         S::Recovering,   A::Recover  },     // Retry
+
+        { S::Learning,     E::LearnDone,       S::Idle,         A::None     },
+    };
+
+    constexpr AppState parentOf(AppState state)
+    {
+        switch (state)
+        {
+            case S::Idle:
+            case S::Armed:
+            case S::Debouncing:
+            case S::Sleeping:   return S::Ready;
+            default:            return state;                   // Top level
+        }
+    }
+
+    struct Entry
+    {
+        uint8_t next;
+        uint8_t action;
+    };
+
+    // Dense table: the hierarchy is resolved here, once, by the compiler
+    struct TransitionTable
+    {
+        Entry entry[APP_LEAF_STATE_COUNT][APP_EVENT_COUNT];
+
+        constexpr TransitionTable() : entry{}
+        {
+            for (uint8_t s = 0; s < APP_LEAF_STATE_COUNT; ++s)
+            {
+                for (uint8_t e = 0; e < APP_EVENT_COUNT; ++e)
+                {
+                    entry[s][e] = resolve(static_cast<AppState>(s), static_cast<AppEvent>(e));
+                }
+            }
+        }
+
+        static constexpr Entry resolve(AppState state, AppEvent event)
+        {
+            for (AppState level = state; ; level = parentOf(level))
+            {
+                for (const Rule& rule : RULES)
+                {
+                    if (rule.state != level || rule.event != event) continue;
+                    uint8_t next = (rule.next == INTERNAL) ? STAY : static_cast<uint8_t>(rule.next);
+                    return Entry{ next, static_cast<uint8_t>(rule.action) };
+                }
+                if (parentOf(level) == level) return Entry{ UNHANDLED, static_cast<uint8_t>(A::None) };
+            }
+        }
+    };
+
+    const TransitionTable TABLE PROGMEM = TransitionTable();
+
+    const uint16_t TIMEOUT_MS[APP_LEAF_STATE_COUNT] PROGMEM =
+    {
+        0,                                                      // Boot
+        APP_IDLE_SLEEP_MS,                                      // Idle
+        APP_DEBOUNCE_TIMEOUT_MS,                                // Armed
+        APP_DEBOUNCE_TIMEOUT_MS,                                // Debouncing
+        0,                                                      // Transmitting (the action blocks, or the loop ends the hold stream)
+        APP_RECOVERY_RETRY_MS,                                  // Recovering
+        0,                                                      // Sleeping
+        0                                                       // Learning
+    };
+
+    // ---------------------------------------------------------------------------------
+    //  Conformance of the flattened table
+    // ---------------------------------------------------------------------------------
+    constexpr TransitionTable CHECK{};
+
+    constexpr Entry at(AppState state, AppEvent event)
+    {
+        return CHECK.entry[static_cast<uint8_t>(state)][static_cast<uint8_t>(event)];
+    }
+
+    static_assert(at(S::Sleeping, E::Edge).next == static_cast<uint8_t>(S::Armed), "Sleeping inherits Edge from Ready");
+    static_assert(at(S::Armed, E::Edge).next == STAY, "Armed overrides Edge: bounces are consumed");
+    static_assert(at(S::Debouncing, E::PressConfirmed).action == static_cast<uint8_t>(A::Transmit), "Ready transmits on a confirmed press");
+    static_assert(at(S::Learning, E::PressConfirmed).next == UNHANDLED, "No transmission while a program is uploading");
+    static_assert(at(S::Transmitting, E::TxDone).next != UNHANDLED && at(S::Transmitting, E::TxFailed).next != UNHANDLED,
+                  "Transmit action results must both be handled");
+    static_assert([]{
+        for (uint8_t s = 0; s < APP_LEAF_STATE_COUNT; ++s)
+        {
+            bool exits = false;
+            for (uint8_t e = 0; e < APP_EVENT_COUNT; ++e)
+            {
+                uint8_t next = CHECK.entry[s][e].next;
+                if (next != UNHANDLED && next != STAY && next != s) exits = true;
+            }
+            if (!exits) return false;
+        }
+        return true;
+    }(), "Every state needs a way out");
+    static_assert(at(S::Armed, E::DebounceRunning).action == static_cast<uint8_t>(A::Prepare), "The transmission is prepared while the press is debounced");
+    static_assert([]{
+        constexpr uint8_t debouncing = static_cast<uint8_t>(S::Debouncing);
+        for (uint8_t e = 0; e < APP_EVENT_COUNT; ++e)
+        {
+            Entry entry = CHECK.entry[debouncing][e];
+            bool leaves = entry.next != UNHANDLED && entry.next != STAY && entry.next != debouncing;
+            bool confirmed = entry.next == static_cast<uint8_t>(S::Transmitting);
+            if (leaves && !confirmed && entry.action != static_cast<uint8_t>(A::Discard)) return false;
+        }
+        return true;
+    }(), "A rejected press discards the prepared transmission");
+}
+
+
+AppStateMachine::AppStateMachine():
+_pending(0),
+_state(AppState::Boot),
+_enteredTicks(0),
+_actions{},
+_trace(nullptr),
+_worstLatencyUs{},
+_unhandled(0)
+{
+}
+
+void AppStateMachine::bind(AppAction action, Action function)
+{
+    uint8_t index = static_cast<uint8_t>(action);
+    if (index < APP_ACTION_COUNT) _actions[index] = function;
+}
+
+void AppStateMachine::setTraceHook(TraceHook hook)
+{
+    _trace = hook;
+}
+
+/**
+ * @brief Queues an event with its post time. Safe from ISRs and from the loop (the push is atomic,
+ *        so the queue keeps a single producer at any instant).
+ */
+bool AppStateMachine::post(AppEvent event)
+{
+    uint16_t bit = static_cast<uint16_t>(1u << static_cast<uint8_t>(event));
+    bool queued = false;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (!(_pending & bit))
+        {
+            queued = _queue.push(QueuedEvent{ event, Timebase::nowUs() });
+            if (queued) _pending = _pending | bit;
+        }
+    }
+    return queued;
+}
+
+/**
+ * @brief Posts the state timeout when due, then dispatches what is queued. Events posted by the
+ *        actions are dispatched in the same call; coalescing bounds the work to the queue size.
+ */
+void AppStateMachine::poll()
+{
+    if (timeoutDue()) post(AppEvent::Timeout);
+
+    for (uint8_t budget = APP_EVENT_QUEUE_SIZE; budget > 0; --budget)
+    {
+        QueuedEvent queued;
+        bool popped;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            popped = _queue.pop(queued);
+            if (popped) _pending = _pending & ~static_cast<uint16_t>(1u << static_cast<uint8_t>(queued.event));
+        }
+        if (!popped) return;
+
+        dispatch(queued);
+    }
+}
+
+/**
+ * @brief One PROGMEM read decides the transition. The state changes before the action runs, so the
+ *        events an action posts are handled by the state it led to.
+ */
+void AppStateMachine::dispatch(const QueuedEvent& queued)
+{
+    AppState from = _state;
+
+    // An event queued earlier may have changed state since this Timeout was posted
+    if (queued.event == AppEvent::Timeout && !timeoutDue()) return;
+
+    const Entry& entry = TABLE.entry[static_cast<uint8_t>(from)][static_cast<uint8_t>(queued.event)];
+    uint8_t next   = PROGMEMStoragePolicy::read(&entry.next);
+    uint8_t action = PROGMEMStoragePolicy::read(&entry.action);
+
+    if (next == UNHANDLED)
+    {
+        if (_unhandled < 0xFF) ++_unhandled;
+        return;
+    }
+    if (next == STAY) return;
+
+    AppTrace trace{ from, static_cast<AppState>(next), queued.event, 0, 0 };
+
+    _state        = trace.to;
+    _enteredTicks = Timebase::ticks();
+
+    uint32_t enteredUs = _enteredTicks * Timebase::TICK_US;
+    trace.queuedUs = enteredUs - queued.postedUs;
+    if (trace.queuedUs > _worstLatencyUs[next]) _worstLatencyUs[next] = trace.queuedUs;
+
+    if (action != static_cast<uint8_t>(AppAction::None) && _actions[action])
+    {
+        _actions[action]();
+        trace.actionUs = Timebase::nowUs() - enteredUs;
+    }
+
+    if (_trace) _trace(trace);
+}
+
+bool AppStateMachine::timeoutDue() const
+{
+    uint16_t timeoutMs = pgm_read_word(&TIMEOUT_MS[static_cast<uint8_t>(_state)]);
+    return timeoutMs && Timebase::ticks() - _enteredTicks >= Timebase::msToTicks(timeoutMs);
+}
+
+AppState AppStateMachine::state() const
+{
+    return _state;
+}
+
+uint32_t AppStateMachine::worstLatencyUs(AppState state) const
+{
+    uint8_t index = static_cast<uint8_t>(state);
+    return index < APP_LEAF_STATE_COUNT ? _worstLatencyUs[index] : 0;
+}
+
+uint8_t AppStateMachine::unhandledEvents() const
+{
+    return _unhandled;
+}
@@ -0,0 +1,179 @@
+#include "App/ProgramConsole.h"
+#include <avr/wdt.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+ProgramConsole::ProgramConsole(HardwareSerial& serial, ProgramStore& store, Transceiver& transceiver, WaveformPlayer& player):
+_serial(serial),
+_store(store),
+_transceiver(transceiver),
+_player(player),
+_line{},
+_lineLength(0),
+_lineOverflow(false),
+_upload(nullptr),
+_uploadSlot(0),
+_uploadLength(0),
+_uploadReceived(0),
+_uploadCrc(0)
+{
+}
+
+void ProgramConsole::poll()
+{
+    while (_serial.available() > 0)
+    {
+        char c = static_cast<char>(_serial.read());
+
+        if (c == '\r') continue;
+        if (c != '\n')
+        {
+            if (_lineLength < LINE_LENGTH) _line[_lineLength++] = c;
+            else                           _lineOverflow = true;
+            continue;
+        }
+
+        _line[_lineLength] = '\0';
+        if (_lineOverflow) reply(F("ERR LINE"));
+        else if (_lineLength > 0) handleLine();
+        _lineLength = 0;
+        _lineOverflow = false;
+    }
+}
+
+void ProgramConsole::handleLine()
+{
+    if (_upload) handleHexLine();
+    else         handleCommand(_line);
+}
+
+void ProgramConsole::handleCommand(char* command)
+{
+    char* verb = strtok(command, " ");
+    char* arg1 = strtok(nullptr, " ");
+    char* arg2 = strtok(nullptr, " ");
+    char* arg3 = strtok(nullptr, " ");
+    char* end = nullptr;
+    unsigned long number = arg1 ? strtoul(arg1, &end, 10) : 0;
+    uint8_t slot = (arg1 && *end == '\0' && number < PROGRAM_STORE_SLOTS) ? static_cast<uint8_t>(number) : 0xFF;   // 0xFF: missing, unparsable or out of range
+
+    if (!verb) return;
+
+    if (strcmp(verb, "LOAD") == 0 && arg3)
+    {
+        unsigned long length = strtoul(arg2, nullptr, 10);
+        _upload = (length > 0 && length <= PROGRAM_STORE_SLOT_BYTES) ? _store.beginUpload(slot) : nullptr;
+        if (!_upload) { reply(F("ERR ARGS")); return; }
+
+        _uploadSlot     = slot;
+        _uploadLength   = static_cast<uint8_t>(length);
+        _uploadReceived = 0;
+        _uploadCrc      = static_cast<uint16_t>(strtoul(arg3, nullptr, 16));
+        reply(F("READY"));
+    }
+    else if (strcmp(verb, "PLAY") == 0 && arg1)
+    {
+        if (_store.isLoaded(slot)) play(slot);
+        else                       reply(F("ERR EMPTY"));
+    }
+    else if (strcmp(verb, "ERASE") == 0 && arg1)
+    {
+        if (slot >= PROGRAM_STORE_SLOTS) { reply(F("ERR ARGS")); return; }
+
+        _store.erase(slot);
+        reply(F("OK"), slot);
+    }
+    else if (strcmp(verb, "LIST") == 0)
+    {
+        for (uint8_t i = 0; i < PROGRAM_STORE_SLOTS; ++i)
+        {
+            _serial.print(F("SLOT "));
+            _serial.print(i);
+            _serial.print(' ');
+            _serial.println(_store.length(i));
+        }
+    }
+    else
+    {
+        reply(F("ERR COMMAND"));
+    }
+}
+
+bool ProgramConsole::uploading() const
+{
+    return _upload != nullptr;
+}
+
+/**
+ * @brief Appends one line of hex bytes to the upload; commits when the announced length is reached.
+ */
+void ProgramConsole::handleHexLine()
+{
+    uint8_t digits = static_cast<uint8_t>(strlen(_line));
+    bool ok = (digits % 2 == 0) && (digits / 2 <= MAX_HEX_BYTES_PER_LINE) && (_uploadReceived + digits / 2 <= _uploadLength);
+
+    for (uint8_t i = 0; ok && i < digits; i += 2)
+    {
+        char pair[3] = { _line[i], _line[i + 1], '\0' };
+        char* end = nullptr;
+        uint8_t value = static_cast<uint8_t>(strtoul(pair, &end, 16));
+        if (end != pair + 2) { ok = false; break; }
+        _upload[_uploadReceived++] = value;
+    }
+
+    if (!ok)
+    {
+        _upload = nullptr;
+        _store.cancelUpload(_uploadSlot);
+        reply(F("ERR HEX"));
+        return;
+    }
+
+    if (_uploadReceived < _uploadLength)
+    {
+        _serial.println('.');
+        return;
+    }
+
+    _upload = nullptr;
+    switch (_store.commit(_uploadSlot, _uploadLength, _uploadCrc))
+    {
+        case Waveform::Verdict::Ok:            reply(F("OK"), _uploadSlot);   break;
+        case Waveform::Verdict::PulseTooShort: reply(F("ERR PULSE_SHORT"));   break;
+        case Waveform::Verdict::PulseTooLong:  reply(F("ERR PULSE_LONG"));    break;
+        case Waveform::Verdict::BurstTooLong:  reply(F("ERR BURST_LONG"));    break;
+        case Waveform::Verdict::Empty:         reply(F("ERR EMPTY"));         break;
+        default:                               reply(F("ERR CRC_OR_FORMAT")); break;
+    }
+}
+
+/**
+ * @brief Same critical section as a button press: interrupts and watchdog off while on air.
+ */
+void ProgramConsole::play(uint8_t slot)
+{
+    noInterrupts();
+    wdt_disable();
+
+    _transceiver.openTxSession();
+    _player.playCached(_store.program(slot), _store.length(slot));
+    bool sent = _transceiver.closeTxSession();
+
+    wdt_enable(WDTO_8S);
+    interrupts();
+
+    if (sent) reply(F("OK"), slot);
+    else      reply(F("ERR RADIO"));
+}
+
+void ProgramConsole::reply(const __FlashStringHelper* text, int16_t value)
+{
+    _serial.print(text);
+    if (value >= 0)
+    {
+        _serial.print(' ');
+        _serial.print(value);
+    }
+    _serial.println();
+}
@@ -1,3 +1,17 @@
 #include "App/RemoteCodes.h"
 
-const uint8_t REMOTE1_OPEN_DOOR_CODE[8] = {1, 1, 0, 1, 1, 0, 0, 0};
\ No newline at end of file
+// The rolling-code identity is per unit and the key is secret: it comes from the git-ignored
+// App/RemoteSecrets.h (template: App/RemoteSecrets.example.h), injected at build time
+#if __has_include("App/RemoteSecrets.h")
+#include "App/RemoteSecrets.h"
+
+static_assert(REMOTE1_ROLLING_SERIAL_VALUE <= 0x0FFFFFFF, "The rolling-code serial is 28 bits");
+static_assert((REMOTE1_ROLLING_KEY_VALUE[0] | REMOTE1_ROLLING_KEY_VALUE[1] | REMOTE1_ROLLING_KEY_VALUE[2] | REMOTE1_ROLLING_KEY_VALUE[3]) != 0,
+              "Set this unit's XTEA key in App/RemoteSecrets.h");
+
+const uint32_t REMOTE1_ROLLING_SERIAL = REMOTE1_ROLLING_SERIAL_VALUE;
+const uint32_t REMOTE1_ROLLING_KEY[4] = { REMOTE1_ROLLING_KEY_VALUE[0], REMOTE1_ROLLING_KEY_VALUE[1],
+                                          REMOTE1_ROLLING_KEY_VALUE[2], REMOTE1_ROLLING_KEY_VALUE[3] };
+#elif defined(ROLLING_CODE_MODE)
+#error "ROLLING_CODE_MODE needs include/App/RemoteSecrets.h: copy App/RemoteSecrets.example.h and set this unit's serial and key"
+#endif
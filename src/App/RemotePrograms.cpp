@@ -0,0 +1,11 @@
+#include "App/RemotePrograms.h"
+#include <avr/pgmspace.h>
+
+const std::array<uint8_t, RemotePrograms::OPEN_DOOR.length> REMOTE1_OPEN_DOOR_PROGRAM PROGMEM =
+    Waveform::trim<RemotePrograms::OPEN_DOOR.length>(RemotePrograms::OPEN_DOOR);
+
+const std::array<uint8_t, RemotePrograms::OPEN_DOOR_FIRST_WORD.length> REMOTE1_OPEN_DOOR_FIRST_WORD PROGMEM =
+    Waveform::trim<RemotePrograms::OPEN_DOOR_FIRST_WORD.length>(RemotePrograms::OPEN_DOOR_FIRST_WORD);
+
+const std::array<uint8_t, RemotePrograms::OPEN_DOOR_NEXT_WORD.length> REMOTE1_OPEN_DOOR_NEXT_WORD PROGMEM =
+    Waveform::trim<RemotePrograms::OPEN_DOOR_NEXT_WORD.length>(RemotePrograms::OPEN_DOOR_NEXT_WORD);
@@ -0,0 +1,75 @@
+#include "App/RollingCodeGenerator.h"
+
+
+RollingCodeGenerator::RollingCodeGenerator(CounterJournal& journal, uint32_t serial, const uint32_t (&key)[4]):
+_journal(journal),
+_serial(serial & 0x0FFFFFFF),
+_key(key),
+_prepared(false)
+{
+}
+
+/**
+ * @brief Reserves the next counter in EEPROM *before* it can be transmitted and encrypts the word.
+ * @param button - 4-bit button id carried in the word
+ * @return true once the word is encrypted (isPrepared() also waits for the counter commit)
+ */
+bool RollingCodeGenerator::prepare(uint8_t button)
+{
+    if (_prepared) return true;
+
+    #ifdef LOG_VERBOSE
+    unsigned long start = micros();
+    #endif
+
+    uint32_t counter = _journal.commitNext();
+
+    #ifdef LOG_VERBOSE
+    unsigned long encryptStart = micros();
+    #endif
+
+    // Plain text block: counter | serial (all 28 bits) | button
+    uint32_t block[2] = { counter, (_serial << 4) | (button & 0x0F) };
+    XTEA::encrypt(block, _key);
+
+    #ifdef LOG_VERBOSE
+    unsigned long encryptUs = micros() - encryptStart;
+    #endif
+
+    unpackBits(block[0], 32, 0);
+    unpackBits(block[1], 32, 32);
+    unpackBits(_serial,  28, ROLLING_CODE_CIPHER_BITS);
+    unpackBits(button,    4, ROLLING_CODE_CIPHER_BITS + 28);
+
+    #ifdef LOG_VERBOSE
+    LOG_PAIR_DEC("RollingCodeGenerator::prepare() - counter", counter);
+    LOG_PAIR_DEC("RollingCodeGenerator::prepare() - us", micros() - start);
+    LOG_PAIR_DEC("RollingCodeGenerator::prepare() - encrypt us", encryptUs);
+    #endif
+
+    _prepared = true;
+    return true;
+}
+
+bool RollingCodeGenerator::isPrepared() const
+{
+    return _prepared && _journal.committed();
+}
+
+const uint8_t (&RollingCodeGenerator::bits() const)[ROLLING_CODE_WORD_BITS]
+{
+    return _bits;
+}
+
+void RollingCodeGenerator::consume()
+{
+    _prepared = false;
+}
+
+void RollingCodeGenerator::unpackBits(uint32_t value, uint8_t count, uint8_t offset)
+{
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        _bits[offset + i] = (value >> (count - 1 - i)) & 0x01;
+    }
+}
@@ -0,0 +1,168 @@
+#include "Capture/CaptureExport.h"
+#include "Capture/EdgeCapture.h"
+#include "Capture/CaptureConverters.h"
+#include "App/RemotePrograms.h"
+#include "Simulation/ReceiverModel.h"
+#include "Policies/PROGMEMStoragePolicy.h"
+#include "Policies/RAMStoragePolicy.h"
+
+namespace
+{
+    /// @brief Hex lines on a Print, one per write() of the capture writer
+    struct HexLineSink
+    {
+        Print& out;
+
+        size_t write(const uint8_t* bytes, size_t length)
+        {
+            static const char DIGITS[] = "0123456789abcdef";
+            out.print(F("CAP "));
+            for (size_t i = 0; i < length; ++i)
+            {
+                out.print(DIGITS[bytes[i] >> 4]);
+                out.print(DIGITS[bytes[i] & 0x0F]);
+            }
+            out.println();
+            return length;
+        }
+    };
+
+    // ---------------------------------------------------------------------------------
+    //  Conformance: the compiled burst survives a capture round trip, seeks land on the
+    //  right edge, and the receiver model accepts the burst read back from the capture
+    // ---------------------------------------------------------------------------------
+    constexpr size_t TEST_BLOCK_BYTES = 32;                     // Small blocks: several of them, so the seek really searches
+
+    struct BufferSink
+    {
+        uint8_t bytes[2048];
+        size_t  length;
+        bool    overflow;
+
+        constexpr size_t write(const uint8_t* data, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (length >= sizeof(bytes)) { overflow = true; return i; }
+                bytes[length++] = data[i];
+            }
+            return count;
+        }
+    };
+
+    template<typename Source>
+    constexpr BufferSink captureOf(Source source)
+    {
+        BufferSink sink{};
+        Capture::Writer<BufferSink, TEST_BLOCK_BYTES> writer(sink);
+        Waveform::Edge edge{0, 0};
+        while (source.next(edge)) writer.add(edge.level, edge.durationUs);
+        writer.finish();
+        return sink;
+    }
+
+    constexpr Waveform::Interpreter<RAMStoragePolicy> openDoorProgram()
+    {
+        return Waveform::Interpreter<RAMStoragePolicy>(RemotePrograms::OPEN_DOOR.bytes.data(), RemotePrograms::OPEN_DOOR.length);
+    }
+
+    constexpr BufferSink OPEN_DOOR_CAPTURE = captureOf(openDoorProgram());
+    static_assert(!OPEN_DOOR_CAPTURE.overflow, "Test buffer too small for the open-door capture");
+
+    constexpr bool roundTrips()
+    {
+        Capture::Reader<RAMStoragePolicy> capture(OPEN_DOOR_CAPTURE.bytes, OPEN_DOOR_CAPTURE.length);
+        if (!capture.valid() || capture.blockCount() < 3) return false;
+
+        auto program = openDoorProgram();
+        auto cursor  = capture.begin();
+        Waveform::Edge expected{0, 0};
+        Waveform::Edge read{0, 0};
+        uint64_t edges = 0;
+        while (program.next(expected))
+        {
+            if (!cursor.next(read) || read.level != expected.level || read.durationUs != expected.durationUs) return false;
+            ++edges;
+        }
+        return !cursor.next(read) && !cursor.faulted() && capture.edgeCount() == edges;
+    }
+
+    // Every edge start, and a point inside every edge, seeks to that edge
+    constexpr bool seeksLand()
+    {
+        Capture::Reader<RAMStoragePolicy> capture(OPEN_DOOR_CAPTURE.bytes, OPEN_DOOR_CAPTURE.length);
+        auto program = openDoorProgram();
+        Waveform::Edge edge{0, 0};
+        uint64_t startUs = 0;
+        for (uint64_t index = 0; program.next(edge); ++index)
+        {
+            auto atStart  = capture.seek(startUs);
+            auto inside   = capture.seek(startUs + edge.durationUs - 1);
+            if (atStart.edgeIndex() != index || atStart.startUs() != startUs || inside.edgeIndex() != index) return false;
+            startUs += edge.durationUs;
+        }
+        Waveform::Edge none{0, 0};
+        return !capture.seek(startUs).next(none);
+    }
+
+    constexpr bool receiverAcceptsCapture()
+    {
+        Capture::Reader<RAMStoragePolicy> capture(OPEN_DOOR_CAPTURE.bytes, OPEN_DOOR_CAPTURE.length);
+        SC41344Receiver<CodeFamilies::SC41344_8Bit::WORD_BITS> receiver({ RECEIVER_TOLERANCE_PCT, RECEIVER_SYNC_MIN_US, RECEIVER_WORDS_REQUIRED, RECEIVER_WINDOW_WORDS });
+        auto cursor = capture.begin();
+        Waveform::Edge edge{0, 0};
+        while (cursor.next(edge)) receiver.feed(edge.level, edge.durationUs);
+        receiver.finish();
+        return receiver.accepted();
+    }
+
+    // A two-edge trace through both converters: 300 us HIGH then 900 us LOW
+    constexpr bool convertersAgree()
+    {
+        const char csv[] = "Time [s],Channel 0\n0.000000,1\n0.000300,0\n0.000600,0\n0.001200,1\n";
+        const char vcd[] = "$timescale 100 ns $end\n$scope module top $end\n$var wire 1 ! gdo0 $end\n$upscope $end\n"
+                           "$enddefinitions $end\n#0\n$dumpvars\n1!\n$end\n#3000\n0!\n#12000\n1!\n";
+
+        BufferSink fromCsv{};
+        Capture::Writer<BufferSink, TEST_BLOCK_BYTES> csvWriter(fromCsv);
+        Capture::CsvConverter<decltype(csvWriter)> csvConverter(csvWriter);
+        for (char c : csv) if (c) csvConverter.feed(c);
+        csvConverter.finish();
+        csvWriter.finish();
+
+        BufferSink fromVcd{};
+        Capture::Writer<BufferSink, TEST_BLOCK_BYTES> vcdWriter(fromVcd);
+        Capture::VcdConverter<decltype(vcdWriter)> vcdConverter(vcdWriter);
+        for (char c : vcd) if (c) vcdConverter.feed(c);
+        vcdConverter.finish();
+        vcdWriter.finish();
+
+        if (fromCsv.length != fromVcd.length) return false;
+        for (size_t i = 0; i < fromCsv.length; ++i) if (fromCsv.bytes[i] != fromVcd.bytes[i]) return false;
+
+        Capture::Reader<RAMStoragePolicy> capture(fromCsv.bytes, fromCsv.length);
+        auto cursor = capture.begin();
+        Waveform::Edge high{0, 0};
+        Waveform::Edge low{0, 0};
+        Waveform::Edge none{0, 0};
+        return cursor.next(high) && high.level == 1 && high.durationUs == 300
+            && cursor.next(low) && low.level == 0 && low.durationUs == 900
+            && !cursor.next(none);
+    }
+
+    static_assert(roundTrips(), "Capture of the open-door burst must read back edge for edge");
+    static_assert(seeksLand(), "Capture seek must land on the edge on air at the requested time");
+    static_assert(receiverAcceptsCapture(), "Receiver model must accept the open-door burst read from its capture");
+    static_assert(convertersAgree(), "CSV and VCD of the same trace must give the same capture");
+}
+
+void exportOpenDoorCapture(Print& out)
+{
+    HexLineSink sink{ out };
+    Capture::Writer<HexLineSink> writer(sink);
+
+    Waveform::Interpreter<PROGMEMStoragePolicy, false> interpreter(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size());
+    Waveform::Edge edge{0, 0};
+    while (interpreter.next(edge)) writer.add(edge.level, edge.durationUs);
+    writer.finish();
+}
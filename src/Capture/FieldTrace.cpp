@@ -0,0 +1,456 @@
+#include "Capture/FieldTrace.h"
+#include "Delay/Timebase.h"
+#include "Debugging/LogSink.h"
+#include <avr/wdt.h>
+
+namespace
+{
+    // ---------------------------------------------------------------------------------
+    //  Conformance: records survive an encode / decode round trip, byte by byte, and a
+    //  malformed stream faults the decoder instead of producing records
+    // ---------------------------------------------------------------------------------
+    constexpr Trace::Record SAMPLE[] =
+    {
+        Trace::start(1), Trace::edge(0, 0), Trace::edge(1, 127), Trace::select(128), Trace::byte(0x3D, 0x0F),
+        Trace::byte(0xF5, 0x12), Trace::select(0xFFFFFFFFUL), Trace::gap(3), Trace::edge(0, 250000)
+    };
+
+    constexpr bool roundTrips()
+    {
+        uint8_t bytes[sizeof(SAMPLE) / sizeof(SAMPLE[0]) * Trace::MAX_RECORD_BYTES] = {};
+        uint16_t length = 0;
+        for (const Trace::Record& record : SAMPLE) length += Trace::encode(record, bytes + length);
+
+        Trace::Decoder decoder;
+        Trace::Record decoded{};
+        uint8_t count = 0;
+        for (uint16_t i = 0; i < length; ++i)
+        {
+            if (!decoder.push(bytes[i], decoded)) continue;
+            if (count >= sizeof(SAMPLE) / sizeof(SAMPLE[0]) || !(decoded == SAMPLE[count])) return false;
+            ++count;
+        }
+        return count == sizeof(SAMPLE) / sizeof(SAMPLE[0]) && decoder.between() && !decoder.faulted();
+    }
+
+    constexpr uint8_t encodedLength(const Trace::Record& record)
+    {
+        uint8_t bytes[Trace::MAX_RECORD_BYTES] = {};
+        return Trace::encode(record, bytes);
+    }
+
+    constexpr bool rejects(uint8_t byte)
+    {
+        Trace::Decoder decoder;
+        Trace::Record decoded{};
+        return !decoder.push(byte, decoded) && decoder.faulted() && !decoder.push(0x01, decoded);
+    }
+
+    static_assert(roundTrips(), "Trace records must round trip through the encoder and the decoder");
+    static_assert(encodedLength(Trace::byte(0, 0)) == 3 && encodedLength(Trace::select(100)) == 2 && encodedLength(Trace::start(1)) == 1,
+                  "A transaction byte is 3 bytes, a select within 127 us 2: a MARCSTATE poll is 8 bytes");
+    static_assert(encodedLength(Trace::edge(1, 0xFFFFFFFFUL)) == Trace::MAX_RECORD_BYTES, "Longest record");
+    static_assert(rejects(0x00) && rejects(0x06) && rejects(0x13), "Unknown kinds and stray tag bits fault the decoder");
+    static_assert(FIELD_TRACE_RING_SIZE >= 2 * Trace::MAX_RECORD_BYTES, "A Gap and the record after it fit the ring");
+}
+
+#ifdef FIELD_TRACE_MODE
+
+namespace
+{
+    constexpr uint16_t MASK       = FIELD_TRACE_RING_SIZE - 1;
+    constexpr uint8_t  LINE_CHARS = 4 + 2 * FIELD_TRACE_LINE_BYTES + 2;     // "TRC " + hex + "\r\n"
+}
+
+volatile uint8_t  FieldTrace::_ring[FIELD_TRACE_RING_SIZE] = {};
+volatile uint16_t FieldTrace::_head = 0;
+volatile uint16_t FieldTrace::_tail = 0;
+uint16_t          FieldTrace::_dropped = 0;
+uint32_t          FieldTrace::_lastUs = 0;
+bool              FieldTrace::_recording = false;
+
+void FieldTrace::start(uint8_t level)
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    _head      = 0;
+    _tail      = 0;
+    _dropped   = 0;
+    _lastUs    = Timebase::preciseUs();
+    _recording = true;
+    append(Trace::start(level));
+    SREG = sreg;
+}
+
+/**
+ * @brief Edge (from the CHANGE ISR) or Select (loop). The delta runs from the last timed record
+ *        written, so a dropped record does not shift the ones after it.
+ */
+void FieldTrace::recordTimed(Trace::Kind kind, uint8_t level)
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    if (_recording)
+    {
+        uint32_t now   = Timebase::preciseUs();
+        uint32_t delta = now - _lastUs;
+        if (append(kind == Trace::Kind::Edge ? Trace::edge(level, delta) : Trace::select(delta))) _lastUs = now;
+    }
+    SREG = sreg;
+}
+
+void FieldTrace::recordByte(uint8_t mosi, uint8_t miso)
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    if (_recording) append(Trace::byte(mosi, miso));
+    SREG = sreg;
+}
+
+/// @brief Interrupts off. Whole records only; a Gap goes in first once there is room for both
+bool FieldTrace::append(const Trace::Record& record)
+{
+    uint8_t bytes[2 * Trace::MAX_RECORD_BYTES];
+    uint8_t length = 0;
+    if (_dropped) length = Trace::encode(Trace::gap(_dropped), bytes);
+    length += Trace::encode(record, bytes + length);
+
+    if (FIELD_TRACE_RING_SIZE - static_cast<uint16_t>(_head - _tail) < length)
+    {
+        if (_dropped != UINT16_MAX) ++_dropped;
+        return false;
+    }
+
+    for (uint8_t i = 0; i < length; ++i)
+    {
+        _ring[_head & MASK] = bytes[i];
+        _head = _head + 1;
+    }
+    _dropped = 0;
+    return true;
+}
+
+/// @brief Only between whole LOG lines, and only what Serial takes without waiting
+void FieldTrace::service(Print& out)
+{
+#if DEBUG
+    if (DebugLog.pending() != 0) return;
+#endif
+
+    while (pending() != 0 && out.availableForWrite() >= LINE_CHARS)
+    {
+        static const char DIGITS[] = "0123456789abcdef";
+        out.print(F("TRC "));
+        for (uint8_t i = 0; i < FIELD_TRACE_LINE_BYTES && pending() != 0; ++i)
+        {
+            uint8_t byte = _ring[_tail & MASK];
+
+            uint8_t sreg = SREG;
+            noInterrupts();
+            _tail = _tail + 1;
+            SREG = sreg;
+
+            out.print(DIGITS[byte >> 4]);
+            out.print(DIGITS[byte & 0x0F]);
+        }
+        out.println();
+    }
+}
+
+uint16_t FieldTrace::pending()
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    uint16_t inUse = static_cast<uint16_t>(_head - _tail);
+    SREG = sreg;
+    return inUse;
+}
+
+#elif defined(TRACE_REPLAY_MODE)
+
+namespace
+{
+    constexpr uint8_t INPUT_MASK = FIELD_TRACE_REPLAY_BUFFER - 1;
+
+    int8_t hexValue(char c)
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+}
+
+uint8_t        FieldTrace::_input[FIELD_TRACE_REPLAY_BUFFER] = {};
+uint8_t        FieldTrace::_inHead = 0;
+uint8_t        FieldTrace::_inCount = 0;
+Trace::Decoder FieldTrace::_decoder;
+Trace::Record  FieldTrace::_next = { Trace::Kind::Start, 0, 0, 0, 0 };
+bool           FieldTrace::_hasNext = false;
+bool           FieldTrace::_ended = false;
+bool           FieldTrace::_replaying = false;
+uint8_t        FieldTrace::_level = 1;
+uint32_t       FieldTrace::_records = 0;
+uint32_t       FieldTrace::_traceUs = 0;
+uint32_t       FieldTrace::_originUs = 0;
+uint32_t       FieldTrace::_lagMaxUs = 0;
+uint32_t       FieldTrace::_wallStartMs = 0;
+
+void FieldTrace::beginReplay()
+{
+    Serial.println(F("REPLAY waiting for the trace"));
+    refill();
+    if (!peek() || _next.kind != Trace::Kind::Start)
+    {
+        finish(F("no Start record"));
+        return;
+    }
+
+    _level = _next.level;
+    consume();
+    Timebase::beginVirtual();
+    _originUs    = Timebase::nowUs();
+    _wallStartMs = millis();
+    _replaying   = true;
+}
+
+/**
+ * @brief One loop pass: reads ahead (here, not in the middle of a radio operation), moves the
+ *        virtual clock and delivers the recorded edges that are due. A recorded transaction the
+ *        firmware does not issue, or ends early, is a divergence.
+ */
+void FieldTrace::replayStep(bool busy, void (*edgeHandler)())
+{
+    if (!_replaying) return;
+
+    refill();
+    if (!peek())
+    {
+        finish(nullptr);
+        return;
+    }
+
+    switch (_next.kind)
+    {
+        case Trace::Kind::Edge:
+        case Trace::Kind::Select:
+        {
+            uint32_t dueUs = _traceUs + _next.value;
+            if (!busy && dueUs > traceNowUs()) advanceTo(dueUs);    // Nothing in progress: straight to the next recorded event
+            else                               Timebase::advance(1);
+
+            if (_next.kind == Trace::Kind::Edge && traceNowUs() >= dueUs)
+            {
+                _level = _next.level;
+                consume();
+                noInterrupts();                                     // As from the CHANGE ISR
+                edgeHandler();
+                interrupts();
+            }
+            else if (_next.kind == Trace::Kind::Select && traceNowUs() > dueUs + FIELD_TRACE_REPLAY_SLACK_US)
+            {
+                diverge(F("recorded transaction not issued"));
+            }
+            break;
+        }
+
+        case Trace::Kind::Byte:  diverge(F("transaction ended early")); break;
+        case Trace::Kind::Gap:   finish(F("records dropped by the recorder here")); break;
+        case Trace::Kind::Start: finish(F("recording restarted here")); break;
+    }
+}
+
+/// @brief The firmware starts a transaction: it must be the recorded one. A field transaction
+///        that came later than the replayed one moves the virtual clock to it.
+void FieldTrace::replaySelect()
+{
+    if (!peek() || _next.kind != Trace::Kind::Select)
+    {
+        diverge(F("transaction not in the trace"));
+        return;
+    }
+
+    uint32_t dueUs = _traceUs + _next.value;
+    uint32_t nowUs = traceNowUs();
+    if (dueUs > nowUs)                 advanceTo(dueUs);
+    else if (nowUs - dueUs > _lagMaxUs) _lagMaxUs = nowUs - dueUs;
+    consume();
+}
+
+uint8_t FieldTrace::replayTransfer(uint8_t mosi)
+{
+    if (!peek() || _next.kind != Trace::Kind::Byte)
+    {
+        diverge(F("byte not in the trace"), mosi);
+        return 0xFF;
+    }
+    if (_next.mosi != mosi)
+    {
+        diverge(F("byte differs"), mosi);
+        return 0xFF;
+    }
+
+    uint8_t miso = _next.miso;
+    consume();
+    return miso;
+}
+
+bool FieldTrace::peek()
+{
+    while (!_hasNext)
+    {
+        if (_inCount == 0)
+        {
+            if (_ended) return false;
+            readLine();
+            continue;
+        }
+
+        uint8_t byte = _input[_inHead];
+        _inHead = (_inHead + 1) & INPUT_MASK;
+        --_inCount;
+
+        if (_decoder.push(byte, _next)) _hasNext = true;
+        else if (_decoder.faulted())
+        {
+            _ended   = true;
+            _inCount = 0;
+            return false;
+        }
+    }
+    return true;
+}
+
+void FieldTrace::consume()
+{
+    if (Trace::timed(_next.kind)) _traceUs += _next.value;
+    _hasNext = false;
+    ++_records;
+}
+
+void FieldTrace::refill()
+{
+    while (!_ended && FIELD_TRACE_REPLAY_BUFFER - _inCount >= FIELD_TRACE_LINE_BYTES) readLine();
+}
+
+/**
+ * @brief Asks for one line and reads it: "TRC <hex>" appends its bytes, "TRC END" ends the trace,
+ *        other lines are skipped. No answer within FIELD_TRACE_REPLAY_TIMEOUT_MS ends it too.
+ */
+void FieldTrace::readLine()
+{
+    static const char PREFIX[] = "TRC ";
+    const uint8_t room = FIELD_TRACE_REPLAY_BUFFER - _inCount;
+
+    Serial.println(F("TRC?"));
+    unsigned long start = millis();
+
+    uint8_t matched = 0;                                        // Characters of PREFIX matched, > 4 once the line is not a trace line
+    int8_t  high    = -1;                                       // First digit of a hex pair
+    uint8_t added   = 0;
+
+    for (;;)
+    {
+        wdt_reset();
+        if (!Serial.available())
+        {
+            if (millis() - start > FIELD_TRACE_REPLAY_TIMEOUT_MS)
+            {
+                _ended = true;
+                return;
+            }
+            continue;
+        }
+
+        char c = static_cast<char>(Serial.read());
+        if (c == '\r') continue;
+        if (c == '\n')
+        {
+            if (matched == 4) return;
+            matched = 0;
+            continue;
+        }
+
+        if (matched < 4)
+        {
+            matched = (c == PREFIX[matched]) ? matched + 1 : 5;
+            continue;
+        }
+        if (matched > 4) continue;
+
+        if (c == 'N') _ended = true;                            // "TRC END" ('N' is no hex digit)
+        int8_t digit = hexValue(c);
+        if (_ended || digit < 0) continue;
+
+        if (high < 0)
+        {
+            high = digit;
+            continue;
+        }
+        if (added < room)
+        {
+            _input[(_inHead + _inCount) & INPUT_MASK] = static_cast<uint8_t>((high << 4) | digit);
+            ++_inCount;
+            ++added;
+        }
+        high = -1;
+    }
+}
+
+/// @brief Virtual clock forward to field time traceUs (never backwards)
+void FieldTrace::advanceTo(uint32_t traceUs)
+{
+    uint32_t nowUs = traceNowUs();
+    if (traceUs > nowUs) Timebase::advance((traceUs - nowUs + Timebase::TICK_US - 1) / Timebase::TICK_US);
+}
+
+uint32_t FieldTrace::traceNowUs()
+{
+    return Timebase::nowUs() - _originUs;
+}
+
+void FieldTrace::diverge(const __FlashStringHelper* reason, int16_t sent)
+{
+    Serial.print(F("REPLAY diverged record="));
+    Serial.print(_records);
+    Serial.print(F(" at_us="));
+    Serial.print(traceNowUs());
+    Serial.print(' ');
+    Serial.print(reason);
+    if (_hasNext && _next.kind == Trace::Kind::Byte)
+    {
+        Serial.print(F(" recorded=0x"));
+        Serial.print(_next.mosi, HEX);
+    }
+    if (sent >= 0)
+    {
+        Serial.print(F(" sent=0x"));
+        Serial.print(static_cast<uint8_t>(sent), HEX);
+    }
+    Serial.println();
+
+    _replaying = false;
+    Timebase::endVirtual();
+}
+
+void FieldTrace::finish(const __FlashStringHelper* reason)
+{
+    if (reason)
+    {
+        Serial.print(F("REPLAY stopped: "));
+        Serial.println(reason);
+    }
+    Serial.print(F("REPLAY done records="));
+    Serial.print(_records);
+    Serial.print(F(" trace_ms="));
+    Serial.print(_traceUs / 1000);
+    Serial.print(F(" wall_ms="));
+    Serial.print(millis() - _wallStartMs);
+    Serial.print(F(" lag_max_us="));
+    Serial.println(_lagMaxUs);
+
+    if (_replaying) Timebase::endVirtual();
+    _replaying = false;
+}
+
+#endif
@@ -0,0 +1,43 @@
+#include "Crypto/XTEA.h"
+
+/**
+ * @brief Standard XTEA encryption (Needham & Wheeler, 1997), XTEA_CYCLES full cycles.
+ *
+ * The halves are kept in locals so avr-gcc allocates them in registers for the whole loop.
+ */
+void XTEA::encrypt(uint32_t (&block)[2], const uint32_t (&key)[4])
+{
+    uint32_t v0 = block[0];
+    uint32_t v1 = block[1];
+    uint32_t sum = 0;
+
+    for (uint8_t i = 0; i < XTEA_CYCLES; ++i)
+    {
+        v0  += mix(v1) ^ (sum + key[sum & 3]);
+        sum += DELTA;
+        v1  += mix(v0) ^ (sum + key[(sum >> 11) & 3]);
+    }
+
+    block[0] = v0;
+    block[1] = v1;
+}
+
+/**
+ * @brief Inverse of encrypt(): runs the rounds backwards starting from DELTA * XTEA_CYCLES.
+ */
+void XTEA::decrypt(uint32_t (&block)[2], const uint32_t (&key)[4])
+{
+    uint32_t v0 = block[0];
+    uint32_t v1 = block[1];
+    uint32_t sum = DELTA * XTEA_CYCLES;
+
+    for (uint8_t i = 0; i < XTEA_CYCLES; ++i)
+    {
+        v1  -= mix(v0) ^ (sum + key[(sum >> 11) & 3]);
+        sum -= DELTA;
+        v0  -= mix(v1) ^ (sum + key[sum & 3]);
+    }
+
+    block[0] = v0;
+    block[1] = v1;
+}
@@ -1,4 +1,6 @@
 #include"Debounce/CircularDebounceBuffer.h"
+#include "Debounce/DebounceTuner.h"
+#include "Capture/FieldTrace.h"
 #include <Arduino.h>
 
 
@@ -25,7 +27,23 @@ CircularDebounceBuffer::CircularDebounceBuffer(
   _head(0),
   _thresholdPercentage(90),                         // default to 90% (you can override in setup)
   _callbackCounter(0),
-  _delayBetweenSamples(delayBetweenUs)  // initialize Delay with desired interval
+  _delayBetweenSamples(delayBetweenUs),  // initialize Delay with desired interval
+  _sampleSource(nullptr),
+  _tuner(nullptr),
+  _armedUs(0),
+  _lastEdgeUs(0),
+  _pressedUs(0),
+  _glitches(0),
+  _lastSample(false),
+  _edgeCapture(false),
+  _sampling(false),
+  _edgePressed(false),
+  _edgeUs(0),
+  _pressEdgeUs(0),
+  _releaseEdgeUs(0),
+  _holdUs(0),
+  _sessionSamples(0),
+  _releaseCallback(nullptr)
 {
     clearBuffer();
 }
@@ -61,6 +79,28 @@ void CircularDebounceBuffer::setSampleIntervalUs(uint32_t newDelayUs)
     _delayBetweenSamples.updateDelayTime(newDelayUs);
 }
 
+/**
+ * Replace digitalRead(pin) with a custom source, called with this debouncer's id.
+ * The source already returns "pressed", so isActiveLow is ignored.
+ */
+void CircularDebounceBuffer::setSampleSource(SampleSource source)
+{
+    _sampleSource = source;
+}
+
+/**
+ * Attach the auto-tuner. The tuner must already be begin()'d: its current parameters
+ * (stored profile or defaults) replace the ones set so far.
+ */
+void CircularDebounceBuffer::attachTuner(DebounceTuner* tuner)
+{
+    _tuner = tuner;
+    if (_tuner) {
+        setThreshold(_tuner->params().thresholdPercentage);
+        setSampleIntervalUs(_tuner->params().sampleIntervalUs);
+    }
+}
+
 /**
  * Register a zero‐argument callback. Up to MAX_CALLBACKS can be stored.
  */
@@ -71,6 +111,55 @@ void CircularDebounceBuffer::addCallback(Callback cb)
     }
 }
 
+/**
+ * Release is no longer found by sampling the whole hold: the ISR must be attached on CHANGE and
+ * call onEdge(). Sampling stops once a press is confirmed and restarts on the release edge.
+ */
+void CircularDebounceBuffer::enableEdgeCapture()
+{
+    _edgeCapture = true;
+}
+
+void CircularDebounceBuffer::setReleaseCallback(Callback cb)
+{
+    _releaseCallback = cb;
+}
+
+/**
+ * Called from a CHANGE ISR (enableEdgeCapture()). The level is read here, after the edge:
+ * a bounce that flips it back raises another edge, so the last call sees the settled level.
+ *  - idle, pressed edge      : arms a press session (startDebounce()), timestamped
+ *  - press not confirmed yet : only remembered, the samples decide
+ *  - held, released edge     : starts the release confirmation, the edge time ends the hold
+ */
+bool CircularDebounceBuffer::onEdge()
+{
+    bool raw     = FieldTrace::edgeLevel(digitalRead(_pin));   // Recorded or replayed in the trace builds
+    bool pressed = _isActiveLow ? !raw : raw;
+    uint32_t now = Timebase::preciseUs();
+
+    _edgePressed = pressed;
+    _edgeUs      = now;
+
+    if (!_debouncing) {
+        if (!pressed) {
+            return false;                           // Release of nothing we confirmed
+        }
+        startDebounce();
+        _pressEdgeUs = now;
+        return true;
+    }
+
+    if (!_pressedDetected) {
+        return true;
+    }
+
+    if (!pressed && !_sampling) {
+        beginRelease(now);
+    }
+    return false;
+}
+
 /**
  * Called from your raw FALLING‐edge ISR. Arms the debouncer for a new press.
  * It will clear the buffer, reset flags, and start the Delay countdown.
@@ -83,9 +172,50 @@ void CircularDebounceBuffer::startDebounce()
         _pressedDetected = false;                   // allow the next “press” to fire a callback
         clearBuffer();                                      // drop any old samples
         _delayBetweenSamples.restartTimer();  // begin counting from now
+
+        _armedUs    = Timebase::nowUs();           // the FALLING edge is the first bounce edge
+        _lastEdgeUs = _armedUs;
+        _glitches   = 0;
+        _lastSample = true;
+
+        _pressEdgeUs    = _armedUs;
+        _sessionSamples = 0;
+        _sampling       = true;
     }
 }
 
+/**
+ * Interrupts off. The buffer starts full of "pressed" so the release needs as many "released"
+ * samples as the press needed "pressed" ones.
+ */
+void CircularDebounceBuffer::beginRelease(uint32_t edgeUs)
+{
+    for (size_t i = 0; i < BUFFER_SIZE; ++i) {
+        _buffer[i] = true;
+    }
+    _head           = 0;
+    _releaseEdgeUs  = edgeUs;
+    _sessionSamples = 0;
+    _sampling       = true;
+    _delayBetweenSamples.restartTimer();
+}
+
+/**
+ * Edge capture: nothing to sample until the next edge. An edge the ISR saw while we were still
+ * sampling left the pin released: the release confirmation starts from that edge instead.
+ */
+void CircularDebounceBuffer::pauseSampling()
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    if (_stableState && !_edgePressed) {
+        beginRelease(_edgeUs);
+    } else {
+        _sampling = false;
+    }
+    SREG = sreg;
+}
+
 /**
  * Must be called repeatedly from loop(). It will:
  *  1) Check if we are currently debouncing. If not, return immediately.
@@ -95,17 +225,18 @@ void CircularDebounceBuffer::startDebounce()
  *  5) Count how many “true” bits are in the buffer.
  *  6) If we haven’t yet fired a “pressed” callback this session and trueCount ≥ threshold, fire it.
  *  7) If we have fired a press, wait until trueCount ≤ (BUFFER_SIZE – threshold) to confirm release, then disarm.
+ *     With edge capture, sampling pauses between the two confirmations and the release edge resumes it.
  *  8) Otherwise, keep sampling next time.
  */
 void CircularDebounceBuffer::update()
 {
-    // 1) If not currently in a debouncing session, do nothing
-    if (!_debouncing) {
+    // 1) If not currently in a debouncing session, do nothing (with edge capture: nor while held)
+    if (!_debouncing || !_sampling) {
         return;
     }
 
     // 2) Only take a new sample if the Delay interval has just elapsed.
-    //    Delay::isDelayTimeElapsed() returns true ONCE when micros() - previousTime >= delayTime,
+    //    Delay::isDelayTimeElapsed() returns true ONCE when the Timebase ticks since the last sample reach the interval,
     //    and internally calls restartTimer() immediately. So we do not call restartTimer() here.
     if (!_delayBetweenSamples.isDelayTimeElapsed()) {
         return;
@@ -115,11 +246,29 @@ void CircularDebounceBuffer::update()
     //    already called restartTimer() inside isDelayTimeElapsed().
     //    We can safely proceed to read the pin and insert into buffer.
 
-    // 4) Read raw pin, normalize for active‐LOW/high, and write into buffer
-    bool raw      = digitalRead(_pin);
-    bool adjusted = _isActiveLow ? !raw : raw;
+    // 4) Read raw pin (or the sample source), normalize for active‐LOW/high, and write into buffer
+    bool adjusted;
+    if (_sampleSource) {
+        adjusted = _sampleSource(_pin_ID);
+    } else {
+        bool raw = FieldTrace::sampleLevel(digitalRead(_pin));
+        adjusted = _isActiveLow ? !raw : raw;
+    }
     _buffer[_head] = adjusted;
     _head = (size_t)((_head + 1) % BUFFER_SIZE);
+    if (_sessionSamples < 0xFF) {
+        ++_sessionSamples;
+    }
+
+    // Bounce characterization: every level change before confirmation is a glitch,
+    // the last one marks the end of the bounce
+    if (!_pressedDetected && adjusted != _lastSample) {
+        _lastSample = adjusted;
+        _lastEdgeUs = Timebase::nowUs();
+        if (_glitches < 0xFF) {
+            ++_glitches;
+        }
+    }
 
     // 5) Count how many “true” bits are in the buffer now
     uint8_t trueCount = 0;
@@ -140,6 +289,7 @@ void CircularDebounceBuffer::update()
             // We have reached enough consecutive “true” samples → confirm “pressed”
             _stableState     = true;   // remember we’re pressed now
             _pressedDetected = true;   // so we won’t fire again until release
+            _pressedUs       = Timebase::nowUs();
 
             // Fire all registered zero‐arg callbacks exactly once
             for (size_t i = 0; i < _callbackCounter; ++i) {
@@ -150,6 +300,15 @@ void CircularDebounceBuffer::update()
 
             // We do NOT clear or disarm yet; we stay debouncing
             // so that we can detect the release later.
+            if (_edgeCapture) {
+                pauseSampling();
+            }
+        }
+        else if (_edgeCapture && _sessionSamples >= BUFFER_SIZE && trueCount == 0) {
+            // A whole buffer of "released": the edge was noise, wait for the next one
+            clearBuffer();
+            _sampling   = false;
+            _debouncing = false;
         }
         // Return immediately; wait until the next sample interval to proceed.
         return;
@@ -167,6 +326,27 @@ void CircularDebounceBuffer::update()
 
             clearBuffer();   // drop old data
             _debouncing = false; // disarm until next raw FALLING
+
+            _sampling = false;
+            _holdUs   = _edgeCapture ? _releaseEdgeUs - _pressEdgeUs : Timebase::nowUs() - _pressedUs;
+
+            // Feed the tuner off the press path; it may retune (and write EEPROM) here
+            if (_tuner) {
+                _tuner->recordPress(_lastEdgeUs - _armedUs, _glitches, _holdUs / 1000);
+                DebounceParams params;
+                if (_tuner->retune(params)) {
+                    setThreshold(params.thresholdPercentage);
+                    setSampleIntervalUs(params.sampleIntervalUs);
+                }
+            }
+
+            if (_releaseCallback) {
+                _releaseCallback();
+            }
+        }
+        else if (_edgeCapture && _sessionSamples >= BUFFER_SIZE && trueCount == BUFFER_SIZE) {
+            // Bounced back to pressed for a whole buffer: still held
+            pauseSampling();
         }
         return;
     }
@@ -181,6 +361,21 @@ bool CircularDebounceBuffer::getStableState() const
     return _stableState;
 }
 
+bool CircularDebounceBuffer::isDebouncing() const
+{
+    return _debouncing;
+}
+
+uint32_t CircularDebounceBuffer::lastHoldUs() const
+{
+    return _holdUs;
+}
+
+uint32_t CircularDebounceBuffer::heldUs() const
+{
+    return _stableState ? Timebase::preciseUs() - _pressEdgeUs : 0;
+}
+
 /**
  * Completely re‐initialize:
  *  • Clear the buffer
@@ -194,5 +389,6 @@ void CircularDebounceBuffer::reset()
     _stableState     = false;
     _pressedDetected = false;
     _debouncing      = false;
+    _sampling        = false;
     _callbackCounter = 0;
 }
\ No newline at end of file
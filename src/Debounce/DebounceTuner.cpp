@@ -0,0 +1,184 @@
+#include "Debounce/DebounceTuner.h"
+#include "Debounce/CircularDebounceBuffer.h"
+#include <util/crc16.h>
+
+
+static constexpr uint8_t  MAX_MARGIN_PERCENTAGE = 200;
+static constexpr uint8_t  MARGIN_STEP_UP        = 25;
+static constexpr uint8_t  MARGIN_STEP_DOWN      = 10;
+static constexpr uint8_t  DEFAULT_MARGIN        = 50;
+static constexpr uint16_t FIRST_BIN_US          = 512;
+
+DebounceTuner::DebounceTuner(uint8_t inputId):
+_inputId(inputId),
+_params{ SAMPLE_RATE_DEBOUNCE, THRESHOLD_DEBOUNCE },
+_marginPercentage(DEFAULT_MARGIN),
+_histogram{},
+_glitchAvgQ4(0),
+_falseRateQ8(0),
+_pressesSinceChange(0),
+_pressesSincePersist(0),
+_presses(0),
+_falseTriggerPending(false),
+_dirty(false)
+{
+}
+
+/**
+ * @brief Reads the profile of this input. A blank or corrupted record keeps the defaults.
+ */
+DebounceParams DebounceTuner::begin()
+{
+    if (_inputId >= DEBOUNCE_MAX_INPUTS) return _params;
+
+    Profile profile;
+    EepromWriter::readBlock(&profile, profileAddress(), sizeof(Profile));
+
+    bool inBounds = profile.sampleIntervalUs >= DEBOUNCE_MIN_INTERVAL_US && profile.sampleIntervalUs <= DEBOUNCE_MAX_INTERVAL_US &&
+                    profile.thresholdPercentage >= DEBOUNCE_MIN_THRESHOLD && profile.thresholdPercentage <= DEBOUNCE_MAX_THRESHOLD &&
+                    profile.marginPercentage <= MAX_MARGIN_PERCENTAGE;
+
+    if (profile.crc == crc8(profile) && inBounds)
+    {
+        _params.sampleIntervalUs    = profile.sampleIntervalUs;
+        _params.thresholdPercentage = profile.thresholdPercentage;
+        _marginPercentage           = profile.marginPercentage;
+    }
+
+    LOG_PAIR_DEC("DebounceTuner::begin() - Interval us", _params.sampleIntervalUs);
+    LOG_PAIR_DEC("DebounceTuner::begin() - Threshold %", _params.thresholdPercentage);
+    return _params;
+}
+
+/**
+ * @brief Folds one session into the statistics. Counters saturate at 255; when a histogram bin
+ *        would overflow every bin is halved, so old presses fade out and the profile can drift
+ *        with the switch (wear, temperature).
+ */
+void DebounceTuner::recordPress(uint32_t bounceUs, uint8_t glitches, uint32_t holdMs)
+{
+    uint8_t bin = 0;
+    while (bin < HISTOGRAM_BINS - 1 && bounceUs >= (static_cast<uint32_t>(FIRST_BIN_US) << bin)) ++bin;
+
+    if (_histogram[bin] == 0xFF)
+    {
+        for (uint8_t i = 0; i < HISTOGRAM_BINS; ++i) _histogram[i] >>= 1;
+    }
+    _histogram[bin]++;
+
+    // Exponential averages, weight 1/8. The decay rounds up: with x >> 3 a clean run stalls at 7
+    // (7 >> 3 == 0) and the false rate could never drop below the narrowing bound
+    uint8_t glitchQ4 = (glitches > 15) ? 0xF0 : static_cast<uint8_t>(glitches << 4);
+    _glitchAvgQ4 = _glitchAvgQ4 - ((_glitchAvgQ4 + 7) >> 3) + (glitchQ4 >> 3);
+
+    bool falseTrigger = holdMs < DEBOUNCE_MIN_HOLD_MS;
+    _falseRateQ8 = _falseRateQ8 - ((_falseRateQ8 + 7) >> 3) + (falseTrigger ? 32 : 0);
+    _falseTriggerPending = falseTrigger;
+
+    if (_presses < 0xFF) _presses++;
+    if (_pressesSinceChange < 0xFF) _pressesSinceChange++;
+    if (_pressesSincePersist < 0xFF) _pressesSincePersist++;
+}
+
+/**
+ * @brief Applies the retune rule (see class doc). Nothing moves until DEBOUNCE_TUNE_MIN_PRESSES
+ *        presses have been seen, so a fresh unit runs on the defaults first.
+ */
+bool DebounceTuner::retune(DebounceParams& params)
+{
+    if (_presses < DEBOUNCE_TUNE_MIN_PRESSES) return false;
+
+    // A change that was rate limited (or found the write queue full) is written once allowed
+    if (_dirty && _pressesSincePersist >= DEBOUNCE_TUNE_MIN_PRESSES) persist();
+
+    // Widen once per false trigger (the averaged rate lags for many presses), narrow slowly when clean
+    if (_falseTriggerPending && _falseRateQ8 > DEBOUNCE_TARGET_FALSE_RATE_Q8)
+    {
+        _marginPercentage = (_marginPercentage + MARGIN_STEP_UP > MAX_MARGIN_PERCENTAGE) ? MAX_MARGIN_PERCENTAGE : _marginPercentage + MARGIN_STEP_UP;
+    }
+    else if (_falseRateQ8 <= DEBOUNCE_TARGET_FALSE_RATE_Q8 / 2 && _pressesSinceChange >= DEBOUNCE_TUNE_MIN_PRESSES)
+    {
+        _marginPercentage = (_marginPercentage < MARGIN_STEP_DOWN) ? 0 : _marginPercentage - MARGIN_STEP_DOWN;
+    }
+
+    uint32_t windowUs = bounceP95Us() * (100 + _marginPercentage) / 100;
+
+    uint16_t threshold = DEBOUNCE_MIN_THRESHOLD + ((5 * _glitchAvgQ4) >> 4);
+    if (threshold > DEBOUNCE_MAX_THRESHOLD) threshold = DEBOUNCE_MAX_THRESHOLD;
+
+    uint8_t thresholdCount = (BUFFER_SIZE * threshold + 99) / 100;
+    uint32_t interval = windowUs / thresholdCount;
+    if (interval < DEBOUNCE_MIN_INTERVAL_US) interval = DEBOUNCE_MIN_INTERVAL_US;
+    if (interval > DEBOUNCE_MAX_INTERVAL_US) interval = DEBOUNCE_MAX_INTERVAL_US;
+
+    if (interval == _params.sampleIntervalUs && threshold == _params.thresholdPercentage) return false;
+
+    _params.sampleIntervalUs    = static_cast<uint16_t>(interval);
+    _params.thresholdPercentage = static_cast<uint8_t>(threshold);
+    params = _params;
+    _pressesSinceChange = 0;
+    _dirty = true;
+
+    // Rate limit EEPROM writes: an oscillating margin must not wear the cells out
+    if (_pressesSincePersist >= DEBOUNCE_TUNE_MIN_PRESSES) persist();
+
+    LOG_PAIR_DEC("DebounceTuner::retune() - Interval us", _params.sampleIntervalUs);
+    LOG_PAIR_DEC("DebounceTuner::retune() - Threshold %", _params.thresholdPercentage);
+    return true;
+}
+
+/**
+ * @brief Upper edge of the histogram bin that contains the 95th percentile.
+ */
+uint32_t DebounceTuner::bounceP95Us() const
+{
+    uint16_t total = 0;
+    for (uint8_t i = 0; i < HISTOGRAM_BINS; ++i) total += _histogram[i];
+
+    uint16_t target = total - total / 20;
+    uint16_t seen = 0;
+    for (uint8_t bin = 0; bin < HISTOGRAM_BINS; ++bin)
+    {
+        seen += _histogram[bin];
+        if (seen >= target) return static_cast<uint32_t>(FIRST_BIN_US) << bin;
+    }
+    return static_cast<uint32_t>(FIRST_BIN_US) << (HISTOGRAM_BINS - 1);
+}
+
+/**
+ * @brief Queued in EepromWriter, which only programs the bytes that changed (~3.3 ms each, in
+ *        the background). With the queue full the profile stays dirty and is retried later.
+ */
+void DebounceTuner::persist()
+{
+    if (_inputId >= DEBOUNCE_MAX_INPUTS) return;
+
+    Profile profile;
+    profile.sampleIntervalUs    = _params.sampleIntervalUs;
+    profile.thresholdPercentage = _params.thresholdPercentage;
+    profile.marginPercentage    = _marginPercentage;
+    profile.crc                 = crc8(profile);
+    if (!EepromWriter::writeBlock(profileAddress(), &profile, sizeof(Profile))) return;
+
+    _dirty = false;
+    _pressesSincePersist = 0;
+}
+
+uint16_t DebounceTuner::profileAddress() const
+{
+    return DEBOUNCE_PROFILE_BASE_ADDR + static_cast<uint16_t>(_inputId) * sizeof(Profile);
+}
+
+/**
+ * @brief CRC-8/CCITT over the record minus its CRC byte, seeded with 0x5A so erased EEPROM never validates.
+ */
+uint8_t DebounceTuner::crc8(const Profile& profile)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&profile);
+    uint8_t crc = 0x5A;
+    for (uint8_t i = 0; i < sizeof(Profile) - 1; ++i)
+    {
+        crc = _crc8_ccitt_update(crc, bytes[i]);
+    }
+    return crc;
+}
@@ -0,0 +1,103 @@
+#include "Debugging/EdgeJitter.h"
+#include "Delay/Timebase.h"
+
+static constexpr uint8_t EDGE_JITTER_BITS = 25;
+
+static volatile uint16_t capturedEdges[EDGE_JITTER_BITS * 2];              // Two rising edges per '0' bit
+static volatile uint8_t  capturedCount = 0;
+static volatile bool     capturing     = false;
+
+ISR(TIMER1_CAPT_vect)
+{
+    if (capturing && capturedCount < sizeof(capturedEdges) / sizeof(capturedEdges[0]))
+    {
+        capturedEdges[capturedCount] = ICR1;
+        capturedCount = capturedCount + 1;
+    }
+}
+
+EdgeJitterResult measureEdgeJitter(IBitEncoder& encoder, bool suspendPeriodic)
+{
+    uint8_t sreg = SREG;
+    uint8_t savedTCCR1A = TCCR1A;
+    uint8_t savedTCCR1B = TCCR1B;
+    uint8_t savedTIMSK1 = TIMSK1;
+
+    noInterrupts();
+    TCCR1A = 0;
+    TCCR1B = (1 << ICES1) | (1 << CS11);                        // Rising edges, clk/8
+    TIFR1  = (1 << ICF1);
+    TIMSK1 = (1 << ICIE1);
+    capturedCount = 0;
+    capturing     = true;
+    interrupts();
+
+    uint32_t startTicks = 0;
+    if (suspendPeriodic)
+    {
+        startTicks = TCNT1;
+        Timebase::suspend();
+    }
+
+    encoder.setIdle();
+    for (uint8_t bit = 0; bit < EDGE_JITTER_BITS; ++bit) encoder.sendZero();
+    encoder.setIdle();
+
+    noInterrupts();
+    capturing = false;
+    uint8_t count = capturedCount;
+    if (suspendPeriodic)
+    {
+        // Timer1 wrapped every 32.768 ms: the edge timestamps give the elapsed time between them
+        uint32_t elapsedUs = 0;
+        uint16_t previous  = static_cast<uint16_t>(startTicks);
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            elapsedUs += static_cast<uint16_t>(capturedEdges[i] - previous) / 2;
+            previous   = capturedEdges[i];
+        }
+        elapsedUs += static_cast<uint16_t>(TCNT1 - previous) / 2;
+        Timebase::resume(elapsedUs);
+    }
+    TIMSK1 = savedTIMSK1;
+    TCCR1A = savedTCCR1A;
+    TCCR1B = savedTCCR1B;
+    SREG = sreg;
+
+    EdgeJitterResult result{ 0xFFFF, 0, 0 };
+    uint32_t sum = 0;
+    uint8_t periods = 0;
+    for (uint8_t i = 1; i < count; ++i)
+    {
+        uint16_t period = capturedEdges[i] - capturedEdges[i - 1];
+        if (period < result.minTicks) result.minTicks = period;
+        if (period > result.maxTicks) result.maxTicks = period;
+        sum += period;
+        ++periods;
+    }
+    if (periods == 0) return EdgeJitterResult{ 0, 0, 0 };
+    result.meanTicks = static_cast<uint16_t>(sum / periods);
+    return result;
+}
+
+static void printResult(Print& out, const __FlashStringHelper* label, const EdgeJitterResult& result)
+{
+    out.print(F("JITTER "));
+    out.print(label);
+    out.print(F(" min="));
+    out.print(result.minTicks);
+    out.print(F(" max="));
+    out.print(result.maxTicks);
+    out.print(F(" mean="));
+    out.print(result.meanTicks);
+    out.print(F(" p2p="));
+    out.println(result.maxTicks - result.minTicks);
+}
+
+void runEdgeJitterProfile(IBitEncoder& encoder, Print& out)
+{
+    out.flush();                                                // No UART TX interrupt during the runs
+    printResult(out, F("live"), measureEdgeJitter(encoder, false));
+    out.flush();
+    printResult(out, F("suspended"), measureEdgeJitter(encoder, true));
+}
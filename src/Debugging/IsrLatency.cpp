@@ -0,0 +1,328 @@
+#include "Debugging/IsrLatency.h"
+
+#ifdef ISR_LATENCY_MODE
+
+#include "Config/Constants.h"
+#include "Config/DigitalPin.h"
+#include "Delay/Timebase.h"
+#include "Storage/EepromWriter.h"
+#include "Waveform/WaveformStreamer.h"
+#include "App/RemotePrograms.h"
+
+namespace
+{
+    constexpr uint8_t  TRIGGER                 = 1 << ISR_LATENCY_TRIGGER_PORT_BIT;
+    constexpr uint8_t  PROBE                   = 1 << ISR_LATENCY_PROBE_PORT_BIT;
+    constexpr uint16_t TRIAL_SPACING_US        = 200;
+    constexpr uint16_t FIRE_TIMEOUT_SPINS      = 20000;
+    constexpr uint16_t GAP_MIN_CYCLES          = 40;                               // A longer foreground pass was interrupted
+    constexpr uint32_t GAP_TIMEOUT_SPINS       = 400000UL;
+    constexpr uint8_t  CYCLES_PER_CAPTURE_TICK = 8;                                // Timer1 at clk/8 while the streamer runs
+    constexpr uint8_t  SNOP                    = 0x3D;
+
+    enum class Load : uint8_t { Idle, Loaded };
+
+    struct Stats
+    {
+        uint8_t  n        = 0;
+        bool     hasEntry = false;
+        bool     hasExec  = false;
+        uint16_t entryMin = UINT16_MAX;
+        uint16_t entryMax = 0;
+        uint16_t execMin  = UINT16_MAX;
+        uint16_t execMax  = 0;
+
+        void entry(uint16_t cycles)
+        {
+            hasEntry = true;
+            if (cycles < entryMin) entryMin = cycles;
+            if (cycles > entryMax) entryMax = cycles;
+        }
+
+        void exec(uint16_t cycles)
+        {
+            hasExec = true;
+            if (cycles < execMin) execMin = cycles;
+            if (cycles > execMax) execMax = cycles;
+        }
+    };
+
+    volatile uint16_t entryStamp = 0;
+    volatile uint16_t exitStamp  = 0;
+    volatile bool     fired      = false;
+    void (*buttonWork)()         = nullptr;
+
+    /// @brief Attached to INT1 in place of the button handler, which it wraps
+    void int1Probe()
+    {
+        uint16_t entry = TCNT1;
+        PORTD |= PROBE;
+        buttonWork();
+        PORTD &= ~PROBE;
+        exitStamp  = TCNT1;
+        entryStamp = entry;
+        fired      = true;
+    }
+
+    bool waitFired()
+    {
+        for (uint16_t spin = 0; spin < FIRE_TIMEOUT_SPINS && !fired; ++spin) {}
+        return fired;
+    }
+
+    /// @brief Loaded: keeps the UART TX interrupt busy with a comment line
+    void feedLoad(Load load, Print& out)
+    {
+        if (load == Load::Loaded && Serial.availableForWrite() > 24) out.println(F("# uart load ..........."));
+    }
+
+    void measureInt1(Load load, Print& out, Stats& stats)
+    {
+        for (uint8_t trial = 0; trial < ISR_LATENCY_TRIALS; ++trial)
+        {
+            feedLoad(load, out);
+            fired = false;
+
+            noInterrupts();
+            uint16_t trigger = TCNT1;
+            PIND = TRIGGER;                                     // Toggles D4, the jumper carries it to D3: one CHANGE edge
+            interrupts();
+
+            if (waitFired())
+            {
+                stats.entry(entryStamp - trigger);
+                stats.exec(exitStamp - entryStamp);
+                ++stats.n;
+            }
+            delayMicroseconds(TRIAL_SPACING_US);
+        }
+    }
+
+    void measureSpi(Load load, Print& out, Stats& stats)
+    {
+        if (!(SPCR & (1 << SPE))) return;                      // Bus not started
+
+        static const uint8_t DIVIDERS[] = { 4, 16, 64, 128 };
+        uint8_t divider = DIVIDERS[SPCR & 0x03];
+        if (SPSR & (1 << SPI2X)) divider /= 2;
+        uint16_t transferCycles = 8 * divider;
+
+        uint8_t savedSPCR = SPCR;
+        SPCR = savedSPCR | (1 << SPIE);
+
+        for (uint8_t trial = 0; trial < ISR_LATENCY_TRIALS; ++trial)
+        {
+            feedLoad(load, out);
+            fired = false;
+
+            noInterrupts();
+            uint16_t trigger = TCNT1;
+            SPDR = SNOP;                                        // CSn stays high: the radio ignores it
+            interrupts();
+
+            if (waitFired())
+            {
+                uint16_t sinceStart = entryStamp - trigger;
+                stats.entry(sinceStart > transferCycles ? sinceStart - transferCycles : 0);
+                stats.exec(exitStamp - entryStamp);
+                ++stats.n;
+            }
+            delayMicroseconds(TRIAL_SPACING_US);
+        }
+
+        SPCR = savedSPCR;
+    }
+
+    /**
+     * @brief Plays the open-door burst as a stream (4 words) and compares each rising edge, as
+     *        stamped by ICP1, with the deadline the streamer programmed for it.
+     */
+    void measureWaveform(Load load, Print& out, Stats& stats)
+    {
+        using Expected = Waveform::Interpreter<PROGMEMStoragePolicy, false>;
+        const uint8_t words = RemotePrograms::OPEN_DOOR_LAYOUT.wordRepeats + 1;
+
+        DigitalPin gdo0('B', GDO0_PORT_BIT);
+        gdo0.pinConfig(false, false);
+        gdo0.writePin(0);
+        WaveformStreamer streamer(gdo0);
+
+        streamer.start(REMOTE1_OPEN_DOOR_FIRST_WORD.data(), REMOTE1_OPEN_DOOR_FIRST_WORD.size(),
+                       REMOTE1_OPEN_DOOR_NEXT_WORD.data(), REMOTE1_OPEN_DOOR_NEXT_WORD.size(), words);
+        streamer.stop();
+        uint16_t deadline = OCR1A;                              // First compare, 32 us away
+        TCCR1B |= (1 << ICES1);                                 // Rising edges (start() set normal mode, clk/8)
+        TIFR1 = (1 << ICF1);
+
+        Waveform::Edge edge{0, 0};
+        uint8_t level = 0;
+        for (uint8_t word = 0; word < words; ++word)
+        {
+            Expected expected = (word == 0) ? Expected(REMOTE1_OPEN_DOOR_FIRST_WORD.data(), REMOTE1_OPEN_DOOR_FIRST_WORD.size())
+                                            : Expected(REMOTE1_OPEN_DOOR_NEXT_WORD.data(), REMOTE1_OPEN_DOOR_NEXT_WORD.size());
+            while (expected.next(edge))
+            {
+                if (edge.level && !level && stats.n < ISR_LATENCY_TRIALS)
+                {
+                    while (!(TIFR1 & (1 << ICF1)) && streamer.busy()) {}
+                    if (!(TIFR1 & (1 << ICF1))) break;
+                    uint16_t capture = ICR1;
+                    TIFR1 = (1 << ICF1);
+                    stats.entry((capture - deadline) * CYCLES_PER_CAPTURE_TICK);
+                    ++stats.n;
+                }
+                level = edge.level;
+                deadline += static_cast<uint16_t>(edge.durationUs * 2);
+                feedLoad(load, out);
+            }
+        }
+
+        while (streamer.busy()) {}
+    }
+
+    /**
+     * @brief Foreground loop reading TCNT1 with one periodic source unmasked: a pass longer than
+     *        GAP_MIN_CYCLES is one run of its handler. The longest normal pass is subtracted.
+     */
+    void measureGaps(uint8_t timsk0, uint8_t timsk2, Stats& stats)
+    {
+        Serial.flush();
+
+        noInterrupts();
+        uint8_t savedTIMSK0 = TIMSK0;
+        uint8_t savedTIMSK2 = TIMSK2;
+        TIMSK0 = timsk0;
+        TIMSK2 = timsk2;
+        interrupts();
+
+        uint16_t pass = 0;
+        uint16_t prev = TCNT1;
+        for (uint32_t spin = 0; spin < GAP_TIMEOUT_SPINS && stats.n < ISR_LATENCY_TRIALS; ++spin)
+        {
+            uint16_t now   = TCNT1;
+            uint16_t delta = now - prev;
+            prev = now;
+
+            if (delta <= GAP_MIN_CYCLES)
+            {
+                if (delta > pass) pass = delta;
+            }
+            else
+            {
+                stats.exec(delta);
+                ++stats.n;
+            }
+        }
+
+        noInterrupts();
+        TIMSK0 = savedTIMSK0;
+        TIMSK2 = savedTIMSK2;
+        interrupts();
+
+        if (stats.hasExec)
+        {
+            stats.execMin -= pass;
+            stats.execMax -= pass;
+        }
+    }
+
+    void printField(Print& out, const __FlashStringHelper* name, bool present, uint16_t value)
+    {
+        out.print(name);
+        if (present) out.print(value);
+        else         out.print('-');
+    }
+
+    void report(Print& out, const __FlashStringHelper* source, Load load, const Stats& stats)
+    {
+        out.print(F("ISR source="));
+        out.print(source);
+        out.print(F(" load="));
+        out.print(load == Load::Idle ? F("idle") : F("loaded"));
+        out.print(F(" n="));
+        out.print(stats.n);
+        printField(out, F(" entry_min="), stats.hasEntry, stats.entryMin);
+        printField(out, F(" entry_max="), stats.hasEntry, stats.entryMax);
+        printField(out, F(" exec_min="),  stats.hasExec,  stats.execMin);
+        printField(out, F(" exec_max="),  stats.hasExec,  stats.execMax);
+        printField(out, F(" jitter="),    stats.hasEntry || stats.hasExec,
+                   stats.hasEntry ? stats.entryMax - stats.entryMin : stats.execMax - stats.execMin);
+        out.println();
+    }
+}
+
+ISR(SPI_STC_vect)
+{
+    uint16_t entry = TCNT1;
+    PORTD |= PROBE;
+    (void)SPDR;
+    PORTD &= ~PROBE;
+    exitStamp  = TCNT1;
+    entryStamp = entry;
+    fired      = true;
+}
+
+void runIsrLatencySuite(Print& out, void (*buttonHandler)())
+{
+    EepromWriter::flush();                                      // No EE_READY interrupt in the way
+    out.flush();
+
+    uint8_t savedTCCR1A = TCCR1A;
+    uint8_t savedTCCR1B = TCCR1B;
+    uint8_t savedTIMSK1 = TIMSK1;
+    TCCR1A = 0;
+    TCCR1B = (1 << CS10);                                       // clk/1: one count per cycle
+    TIMSK1 = 0;
+
+    DDRD  |= PROBE;
+    PORTD &= ~PROBE;
+
+    // The trigger pin driven high (released level through the jumper), the probe in place of the
+    // handler. D3 stays the button's INPUT_PULLUP: the jumper's 1k wins over the pull-up, and a press
+    // meanwhile only loads D4 with 5 mA
+    buttonWork = buttonHandler;
+    PORTD |= TRIGGER;
+    DDRD  |= TRIGGER;
+    attachInterrupt(digitalPinToInterrupt(BUTTON_HOME_DOOR_GARAGE_PIN), int1Probe, CHANGE);
+
+    constexpr uint32_t IDLE_RUN_US = 2UL * ISR_LATENCY_TRIALS * TRIAL_SPACING_US + Waveform::run(RemotePrograms::OPEN_DOOR).durationUs;
+
+    for (Load load : { Load::Idle, Load::Loaded })
+    {
+        Stats int1;
+        Stats spi;
+        Stats timer1;
+
+        if (load == Load::Idle) Timebase::suspend();            // Timer0 and Timebase masked
+        measureInt1(load, out, int1);
+        measureSpi(load, out, spi);
+        measureWaveform(load, out, timer1);
+        if (load == Load::Idle) Timebase::resume(IDLE_RUN_US);  // Approximate: the timebase was stopped
+        out.flush();
+
+        report(out, F("int1"), load, int1);
+        if (int1.n == 0) out.println(F("# int1: no edge on D3, fit the D4 --1k-- D3 jumper"));
+        report(out, F("spi"), load, spi);
+        report(out, F("timer1"), load, timer1);
+    }
+
+    // Periodic handlers, one at a time (only measurable alone: other ISRs would merge into the gaps)
+    Stats timer0;
+    Stats timer2;
+    uint8_t periodicTIMSK0 = TIMSK0;
+    uint8_t periodicTIMSK2 = TIMSK2;
+    measureGaps(periodicTIMSK0, 0, timer0);
+    measureGaps(0, periodicTIMSK2, timer2);
+    report(out, F("timer0"), Load::Idle, timer0);
+    report(out, F("timer2"), Load::Idle, timer2);
+
+    DDRD  &= ~TRIGGER;                                          // High-Z: the jumper no longer touches the button
+    PORTD &= ~TRIGGER;
+    attachInterrupt(digitalPinToInterrupt(BUTTON_HOME_DOOR_GARAGE_PIN), buttonHandler, CHANGE);
+
+    TCCR1A = savedTCCR1A;
+    TCCR1B = savedTCCR1B;
+    TIMSK1 = savedTIMSK1;
+}
+
+#endif
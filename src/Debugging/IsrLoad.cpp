@@ -0,0 +1,34 @@
+#include "Debugging/IsrLoad.h"
+#include <Arduino.h>
+
+static constexpr uint16_t ISR_LOAD_WINDOW_TICKS = 12500;       // 50 ms at clk/64
+
+static uint32_t spinWindow(bool withInterrupts)
+{
+    uint8_t sreg = SREG;
+    uint8_t savedTCCR1A = TCCR1A;
+    uint8_t savedTCCR1B = TCCR1B;
+
+    noInterrupts();
+    TCCR1A = 0;
+    TCCR1B = (1 << CS11) | (1 << CS10);                         // clk/64, 4 us per tick
+    TCNT1  = 0;
+    if (withInterrupts) interrupts();
+
+    volatile uint32_t iterations = 0;
+    while (TCNT1 < ISR_LOAD_WINDOW_TICKS) iterations = iterations + 1;
+
+    noInterrupts();
+    TCCR1A = savedTCCR1A;
+    TCCR1B = savedTCCR1B;
+    SREG = sreg;
+    return iterations;
+}
+
+uint16_t measureIsrLoadPermille()
+{
+    uint32_t quiet = spinWindow(false);
+    uint32_t busy  = spinWindow(true);
+    if (quiet == 0 || busy >= quiet) return 0;
+    return static_cast<uint16_t>(1000 - (busy * 1000) / quiet);
+}
@@ -0,0 +1,157 @@
+#include "Debugging/LogSink.h"
+
+#if DEBUG
+
+LogSink DebugLog;
+
+namespace
+{
+    constexpr uint16_t MASK         = LOG_RING_SIZE - 1;
+    constexpr uint8_t  REPORT_BYTES = 19;                       // "LOG dropped 65535\r\n"
+}
+
+/**
+ * @brief A non-urgent line cut before the error must not swallow it: the cut line is ended and
+ *        the error starts on a line of its own. The rest of the cut line is still dropped after.
+ */
+LogSink::Urgent::Urgent():
+_previous(DebugLog._urgent),
+_resumeDropping(DebugLog._droppingLine)
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    DebugLog._urgent = true;
+    if (DebugLog._droppingLine)
+    {
+        DebugLog.endCutLine();
+        DebugLog._droppingLine = false;
+    }
+    SREG = sreg;
+}
+
+LogSink::Urgent::~Urgent()
+{
+    DebugLog._urgent = _previous;
+    if (_resumeDropping) DebugLog._droppingLine = true;
+}
+
+/**
+ * @brief Queues one byte. Always reports it written: a dropped byte is accounted here, and
+ *        Print::write(buffer) must not stop half way through a string.
+ */
+size_t LogSink::write(uint8_t byte)
+{
+    if (_policy == Policy::WriteThrough)
+    {
+        flush();                                                // Whatever DropWhenFull left, in order
+        Serial.write(byte);
+        return 1;
+    }
+
+    uint16_t limit = LOG_RING_SIZE - (_urgent ? 0 : LOG_RING_RESERVED);
+
+    uint8_t sreg = SREG;
+    noInterrupts();
+
+    if (_droppingLine || used() >= limit)
+    {
+        if (!_droppingLine) endCutLine();
+        _dropped = _dropped + 1;
+        if (_unreported != UINT16_MAX) _unreported = _unreported + 1;
+        _droppingLine = (byte != '\n');                         // The rest of the line goes too
+    }
+    else
+    {
+        _ring[_head & MASK] = byte;
+        _head = _head + 1;
+    }
+
+    SREG = sreg;
+    return 1;
+}
+
+int LogSink::availableForWrite()
+{
+    uint16_t limit = LOG_RING_SIZE - (_urgent ? 0 : LOG_RING_RESERVED);
+    uint16_t inUse = pending();
+    return inUse < limit ? limit - inUse : 0;
+}
+
+/**
+ * @brief Moves bytes into Serial while its TX buffer has room, so it never waits for the UART.
+ *        Drops are reported once the ring has drained up to them.
+ */
+void LogSink::service()
+{
+    while (pending() != 0 && Serial.availableForWrite() > 0) drainOne();
+
+    if (pending() == 0 && _unreported != 0 && Serial.availableForWrite() >= REPORT_BYTES)
+    {
+        uint8_t sreg = SREG;
+        noInterrupts();
+        uint16_t unreported = _unreported;
+        _unreported = 0;
+        SREG = sreg;
+
+        Serial.print(F("LOG dropped "));
+        Serial.println(unreported);
+    }
+}
+
+/// @brief Blocking drain, Serial.write() waits for the UART (it polls when interrupts are off)
+void LogSink::flush()
+{
+    while (pending() != 0) drainOne();
+}
+
+void LogSink::setPolicy(Policy policy)
+{
+    _policy = policy;
+}
+
+uint16_t LogSink::pending() const
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    uint16_t inUse = used();
+    SREG = sreg;
+    return inUse;
+}
+
+uint32_t LogSink::dropped() const
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    uint32_t count = _dropped;
+    SREG = sreg;
+    return count;
+}
+
+void LogSink::drainOne()
+{
+    Serial.write(_ring[_tail & MASK]);
+
+    uint8_t sreg = SREG;
+    noInterrupts();
+    _tail = _tail + 1;
+    SREG = sreg;
+}
+
+/// @brief Interrupts off. Ends the queued part of a cut line, out of the reserve if needed
+void LogSink::endCutLine()
+{
+    bool cut = used() != 0 && _ring[(_head - 1) & MASK] != '\n';
+    if (cut && used() < LOG_RING_SIZE)
+    {
+        _ring[_head & MASK] = '\n';
+        _head = _head + 1;
+    }
+}
+
+/// @brief Interrupts off
+uint16_t LogSink::used() const
+{
+    return static_cast<uint16_t>(_head - _tail);
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include "Debugging/SpiBudget.h"
+#include "SPI/SpiTrace.h"
+#include "App/RemoteCodes.h"
+
+#ifdef SPI_BUDGET_MODE                                          // Needs the SpiTrace hooks
+
+using namespace SpiBudget;
+
+namespace
+{
+    struct Check
+    {
+        Print& out;
+        bool   pass;
+
+        template<typename Operation>
+        void run(const __FlashStringHelper* name, const SpiTraffic& budget, Operation&& operation)
+        {
+            SpiTrace::reset();
+            operation();
+            SpiTraffic used = SpiTrace::traffic();
+            bool ok = used.within(budget);
+            pass = pass && ok;
+
+            out.print(F("SPI "));
+            out.print(name);
+            print(F(" tx="), used.transactions, budget.transactions);
+            print(F(" bytes="), used.bytes, budget.bytes);
+            print(F(" csn="), used.csnCycles, budget.csnCycles);
+            out.println(ok ? F(" OK") : F(" OVER"));
+            if (ok) return;
+
+            out.print(F("SPI "));
+            out.print(name);
+            out.print(F(" log"));
+            for (uint8_t i = 0; i < SpiTrace::logLength(); ++i)
+            {
+                out.print(F(" 0x"));
+                if (SpiTrace::logAt(i) < 0x10) out.print('0');
+                out.print(SpiTrace::logAt(i), HEX);
+            }
+            if (SpiTrace::logOverflow()) out.print(F(" +"));
+            out.println();
+        }
+
+        void print(const __FlashStringHelper* label, uint16_t used, uint16_t budget)
+        {
+            out.print(label);
+            out.print(used);
+            out.print('/');
+            out.print(budget);
+        }
+    };
+}
+
+bool runSpiBudgetCheck(Transceiver& transceiver, IBitEncoder& encoder, Print& out)
+{
+    Check check{ out, true };
+
+    check.run(F("begin"), BEGIN, [&]() { transceiver.begin(); });
+    check.run(F("setFrequency"), SET_FREQUENCY, [&]() { transceiver.setFrequency(FREQ_315MHZ_BAND); });
+    check.run(F("setPowerLevel"), SET_POWER, [&]() { transceiver.setPowerLevel(7); });
+    check.run(F("status"), STATUS_POLL, [&]() { transceiver.readMarcState(); });
+
+    // A rejected press, then an accepted one (the order the loop runs them in), then the full entry
+    // the modes without a speculative prep use
+    check.run(F("prepare"), PREPARE, [&]() { transceiver.prepareTxSession(); });
+    check.run(F("cancel"), CANCEL, [&]() { transceiver.cancelTxSession(); });
+    bool prepared = transceiver.prepareTxSession();
+    if (!prepared) out.println(F("SPI prepare did not reach FSTXON"));
+    check.pass = check.pass && prepared;
+    check.run(F("preparedFrame"), PREPARED_FRAME, [&]() { transceiver.transmitFrame(REMOTE1_OPEN_DOOR_CODE, encoder); });
+    check.run(F("transmitFrame"), TRANSMIT_FRAME, [&]() { transceiver.transmitFrame(REMOTE1_OPEN_DOOR_CODE, encoder); });
+
+    out.println(check.pass ? F("SPI budget PASS") : F("SPI budget FAIL"));
+    return check.pass;
+}
+
+#endif
@@ -0,0 +1,142 @@
+#include "Debugging/ViewsBenchmark.h"
+#include "avr_algorithms.hpp"
+#include "App/RemotePrograms.h"
+#include "Policies/PROGMEMStoragePolicy.h"
+
+namespace views = avr_algorithms::views;
+
+namespace ViewsBench
+{
+    static const uint8_t PACKED_CODE[3] = { 0xB2, 0x0F, 0x5A };
+    static const uint8_t HEX_INPUT[16]  = { 0x00, 0x11, 0x2F, 0x3C, 0x4A, 0x59, 0x68, 0x77, 0x86, 0x95, 0xA4, 0xB3, 0xC2, 0xD1, 0xE0, 0xFF };
+    static const uint8_t SAMPLES[16]    = { 12, 240, 3, 199, 45, 180, 7, 90, 250, 1, 160, 33, 77, 201, 5, 130 };
+    static constexpr uint8_t SAMPLE_THRESHOLD = 150;
+
+    static char hexDigit(uint8_t nibble)
+    {
+        return static_cast<char>(nibble < 10 ? '0' + nibble : 'A' + nibble - 10);
+    }
+
+    // ---- bits ---------------------------------------------------------------------
+    __attribute__((noinline)) uint8_t bitsHand(const uint8_t* code, uint8_t bits)
+    {
+        uint8_t ones = 0;
+        for (uint8_t i = 0; i < bits; ++i)
+        {
+            if (code[i >> 3] & (0x80 >> (i & 7))) ++ones;
+        }
+        return ones;
+    }
+
+    __attribute__((noinline)) uint8_t bitsViews(const uint8_t* code, uint8_t bits)
+    {
+        return static_cast<uint8_t>(views::bits(code, bits).count_if([](uint8_t bit) { return bit != 0; }));
+    }
+
+    // ---- flash --------------------------------------------------------------------
+    __attribute__((noinline)) uint8_t flashHand(const uint8_t* program, uint8_t length)
+    {
+        uint8_t acc = 0;
+        for (uint8_t i = 0; i < length; ++i) acc ^= pgm_read_byte(program + i);
+        return acc;
+    }
+
+    __attribute__((noinline)) uint8_t flashViews(const uint8_t* program, uint8_t length)
+    {
+        return views::stored<PROGMEMStoragePolicy>(program, length).fold(uint8_t{0}, [](uint8_t acc, uint8_t b) { return static_cast<uint8_t>(acc ^ b); });
+    }
+
+    // ---- hex ----------------------------------------------------------------------
+    __attribute__((noinline)) uint8_t hexHand(const uint8_t* bytes, uint8_t length, char* out)
+    {
+        for (uint8_t i = 0; i < length; ++i)
+        {
+            out[2 * i]     = hexDigit(bytes[i] >> 4);
+            out[2 * i + 1] = hexDigit(bytes[i] & 0x0F);
+        }
+        return static_cast<uint8_t>(2 * length);
+    }
+
+    __attribute__((noinline)) uint8_t hexViews(const uint8_t* bytes, uint8_t length, char* out)
+    {
+        return static_cast<uint8_t>((views::nibbles(bytes, length) | views::transform(hexDigit)).copy_to(out, 2 * length));
+    }
+
+    // ---- filter -------------------------------------------------------------------
+    __attribute__((noinline)) uint16_t filterHand(const uint8_t* samples, uint8_t length)
+    {
+        uint16_t sum = 0;
+        uint8_t taken = 0;
+        for (uint8_t i = 0; i < length && taken < 4; ++i)
+        {
+            if (samples[i] > SAMPLE_THRESHOLD) { sum += samples[i]; ++taken; }
+        }
+        return sum;
+    }
+
+    __attribute__((noinline)) uint16_t filterViews(const uint8_t* samples, uint8_t length)
+    {
+        return (views::span(samples, length)
+                | views::filter([](uint8_t s) { return s > SAMPLE_THRESHOLD; })
+                | views::take(4))
+               .fold(uint16_t{0}, [](uint16_t sum, uint8_t s) { return static_cast<uint16_t>(sum + s); });
+    }
+
+    /// @brief Cycles taken by one call (Timer1 at clk/1, call overhead included on both sides)
+    template<typename Func>
+    uint16_t cycles(Func&& func)
+    {
+        uint8_t sreg = SREG;
+        noInterrupts();
+        uint8_t savedTCCR1A = TCCR1A;
+        uint8_t savedTCCR1B = TCCR1B;
+        TCCR1A = 0;
+        TCCR1B = (1 << CS10);
+        TCNT1  = 0;
+        func();
+        uint16_t elapsed = TCNT1;
+        TCCR1A = savedTCCR1A;
+        TCCR1B = savedTCCR1B;
+        SREG = sreg;
+        return elapsed;
+    }
+
+    static void report(Print& out, const __FlashStringHelper* name, uint16_t hand, uint16_t viewsCycles, bool same)
+    {
+        out.print(name);
+        out.print(F(" hand="));
+        out.print(hand);
+        out.print(F(" views="));
+        out.print(viewsCycles);
+        out.println(same ? F(" same") : F(" DIFF"));
+    }
+}
+
+void runViewsBenchmark(Print& out)
+{
+    using namespace ViewsBench;
+
+    // volatile sinks keep the calls from being folded away
+    volatile uint16_t handResult = 0;
+    volatile uint16_t viewsResult = 0;
+
+    uint16_t hand = cycles([&] { handResult = bitsHand(PACKED_CODE, 24); });
+    uint16_t lazy = cycles([&] { viewsResult = bitsViews(PACKED_CODE, 24); });
+    report(out, F("bits"), hand, lazy, handResult == viewsResult);
+
+    const uint8_t* program = REMOTE1_OPEN_DOOR_PROGRAM.data();
+    const uint8_t length = static_cast<uint8_t>(REMOTE1_OPEN_DOOR_PROGRAM.size());
+    hand = cycles([&] { handResult = flashHand(program, length); });
+    lazy = cycles([&] { viewsResult = flashViews(program, length); });
+    report(out, F("flash"), hand, lazy, handResult == viewsResult);
+
+    char handHex[2 * sizeof(HEX_INPUT)];
+    char viewsHex[2 * sizeof(HEX_INPUT)];
+    hand = cycles([&] { handResult = hexHand(HEX_INPUT, sizeof(HEX_INPUT), handHex); });
+    lazy = cycles([&] { viewsResult = hexViews(HEX_INPUT, sizeof(HEX_INPUT), viewsHex); });
+    report(out, F("hex"), hand, lazy, handResult == viewsResult && memcmp(handHex, viewsHex, sizeof(handHex)) == 0);
+
+    hand = cycles([&] { handResult = filterHand(SAMPLES, sizeof(SAMPLES)); });
+    lazy = cycles([&] { viewsResult = filterViews(SAMPLES, sizeof(SAMPLES)); });
+    report(out, F("filter"), hand, lazy, handResult == viewsResult);
+}
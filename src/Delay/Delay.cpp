@@ -3,26 +3,27 @@
 #include "Arduino.h"
 
 
-/**Constructor: we pass the  target time delay*/
-Delay::Delay(unsigned long delayTime) : delayTime(delayTime),previousTime(0){}
+/**Constructor: we pass the  target time delay (us). Runs on Timebase ticks, never less than one */
+Delay::Delay(unsigned long delayTime) : delayTicks(0),previousTicks(0){
+  updateDelayTime(delayTime);
+}
 
 /** set the target time delay and start counting */
 void Delay::init(){
-  this->delayTime = delayTime;
-  this->previousTime = micros();
+  this->previousTicks = Timebase::ticks();
 }
 
 void Delay::init(unsigned long delayTime){
-  this->delayTime = delayTime;
-  previousTime = micros();
+  updateDelayTime(delayTime);
+  previousTicks = Timebase::ticks();
 }
 
 
 /** Calculate if the delay time has elapsed*/
 bool Delay::isDelayTimeElapsed(){ 
-  unsigned long now = micros();
-  if(now - previousTime >= delayTime) {
-    restartTimer() ; 
+  uint32_t now = Timebase::ticks();
+  if(now - previousTicks >= delayTicks) {
+    previousTicks = now;
     return true;
   } else {
     return false;
@@ -32,10 +33,11 @@ bool Delay::isDelayTimeElapsed(){
 
 /** when the time delay has elapse we update the time counter*/
 void Delay::restartTimer(){
-  this->previousTime = micros();
+  this->previousTicks = Timebase::ticks();
 }
 
 /** Set new Delay Value for the Class*/
 void Delay::updateDelayTime(unsigned long newDelayTime){
-  this->delayTime = newDelayTime;
-}
\ No newline at end of file
+  uint32_t ticks = Timebase::usToTicks(newDelayTime);
+  this->delayTicks = ticks ? ticks : 1;
+}
@@ -0,0 +1,166 @@
+#include "Delay/Timebase.h"
+
+namespace
+{
+    struct Prescaler
+    {
+        uint16_t divider;
+        uint8_t  clockSelect;                                   // CS22:0
+    };
+
+    constexpr Prescaler PRESCALERS[] = { {1, 1}, {8, 2}, {32, 3}, {64, 4}, {128, 5}, {256, 6}, {1024, 7} };
+
+    constexpr uint32_t CYCLES_PER_TICK = (F_CPU / 1000000UL) * TIMEBASE_TICK_US;
+
+    // Smallest divider that counts one tick exactly in 8 bits
+    constexpr Prescaler pickPrescaler()
+    {
+        for (const Prescaler& prescaler : PRESCALERS)
+        {
+            if (CYCLES_PER_TICK % prescaler.divider == 0 && CYCLES_PER_TICK / prescaler.divider <= 256) return prescaler;
+        }
+        return Prescaler{ 0, 0 };
+    }
+
+    constexpr Prescaler TIMER2_PRESCALER = pickPrescaler();
+    constexpr uint16_t  TIMER2_COUNTS    = TIMER2_PRESCALER.divider ? CYCLES_PER_TICK / TIMER2_PRESCALER.divider : 0;
+
+    static_assert(TIMER2_PRESCALER.clockSelect != 0, "TIMEBASE_TICK_US can not be counted exactly by Timer2 at this F_CPU");
+    static_assert(TIMER2_COUNTS >= 2, "Tick too short for a compare period");
+}
+
+PER_BOARD volatile uint32_t Timebase::_ticks = 0;
+PER_BOARD uint8_t Timebase::_savedTIMSK0 = 0;
+PER_BOARD uint8_t Timebase::_savedADCSRA = 0;
+PER_BOARD bool    Timebase::_suspended = false;
+PER_BOARD bool    Timebase::_virtual = false;
+PER_BOARD uint16_t Timebase::_virtualUs = 0;
+
+ISR(TIMER2_COMPA_vect)
+{
+    Timebase::onTick();
+}
+
+void Timebase::begin()
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    TCCR2A = (1 << WGM21);                                      // CTC on OCR2A
+    TCCR2B = TIMER2_PRESCALER.clockSelect;
+    OCR2A  = static_cast<uint8_t>(TIMER2_COUNTS - 1);
+    TCNT2  = 0;
+    TIFR2  = (1 << OCF2A);
+    TIMSK2 = (1 << OCIE2A);
+    SREG = sreg;
+}
+
+/**
+ * @brief Masks the periodic interrupts: the Timer2 tick and whatever Timer0 runs (the core's
+ *        overflow, or the bare-metal HAL compare) and the auto-triggered ADC: the conversion in
+ *        progress completes, no new one starts and its ISR stays masked. Other interrupts (UART,
+ *        pin change) stay live.
+ */
+void Timebase::suspend()
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    _savedTIMSK0 = TIMSK0;
+    TIMSK0 = 0;
+    TIMSK2 &= ~(1 << OCIE2A);
+    _savedADCSRA = ADCSRA;
+    ADCSRA = _savedADCSRA & ~((1 << ADATE) | (1 << ADIE) | (1 << ADIF));
+    _suspended = true;
+    SREG = sreg;
+}
+
+/**
+ * @brief Advances the count by elapsedUs (nearest tick) and unmasks the periodic interrupts. The
+ *        compare that fired while masked is part of elapsedUs, so its pending flag is dropped, as
+ *        is a stale ADC result; a free-running ADC starts a fresh conversion.
+ */
+void Timebase::resume(uint32_t elapsedUs)
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    if (_suspended)
+    {
+        TIFR2  = (1 << OCF2A);
+        _ticks = _ticks + usToTicks(elapsedUs);
+        if (!_virtual) TIMSK2 |= (1 << OCIE2A);
+        TIMSK0 = _savedTIMSK0;
+        if (_savedADCSRA & (1 << ADATE)) ADCSRA = _savedADCSRA | (1 << ADIF) | (1 << ADSC);
+        _suspended = false;
+    }
+    SREG = sreg;
+}
+
+/**
+ * @brief Tick count plus the Timer2 count inside the tick. A compare that fired but is not serviced
+ *        yet (called from an ISR, or interrupts off) is accounted. Tick resolution while suspended.
+ */
+uint32_t Timebase::preciseUs()
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    uint32_t ticks = _ticks;
+    uint8_t  count = TCNT2;
+    if ((TIFR2 & (1 << OCF2A)) && count < TIMER2_COUNTS / 2) ++ticks;
+    bool suspended = _suspended || _virtual;
+    SREG = sreg;
+
+    if (suspended) return ticks * TICK_US;
+    return ticks * TICK_US + static_cast<uint32_t>(count) * TIMEBASE_TICK_US / TIMER2_COUNTS;
+}
+
+void Timebase::advance(uint32_t ticks)
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    _ticks = _ticks + ticks;
+    SREG = sreg;
+}
+
+/// @brief Masks the tick only: every other interrupt stays live
+void Timebase::beginVirtual()
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    TIMSK2 &= ~(1 << OCIE2A);
+    _virtual   = true;
+    _virtualUs = 0;
+    SREG = sreg;
+}
+
+/**
+ * @brief delayUs() / delayMs() while virtual: the count moves by the wait where the tick would
+ *        have counted it. Sub-tick waits (a 10 us settle) add up until they make a tick.
+ */
+void Timebase::virtualDelay(uint32_t us)
+{
+    uint8_t sreg = SREG;
+    if (_suspended || !(sreg & (1 << SREG_I))) return;         // resume() accounts it / the chip loses it too
+
+    noInterrupts();
+    uint32_t total = _virtualUs + us;
+    _ticks     = _ticks + total / TICK_US;
+    _virtualUs = static_cast<uint16_t>(total % TICK_US);
+    SREG = sreg;
+}
+
+void Timebase::endVirtual()
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    _virtual = false;
+    if (!_suspended)
+    {
+        TIFR2  = (1 << OCF2A);
+        TIMSK2 |= (1 << OCIE2A);
+    }
+    SREG = sreg;
+}
+
+bool Timebase::suspended()
+{
+    return _suspended;
+}
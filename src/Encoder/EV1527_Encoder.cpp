@@ -0,0 +1,86 @@
+#include "Encoder/EV1527_Encoder.h"
+#include "Delay/Timebase.h"
+
+EV1527_Encoder::EV1527_Encoder(DigitalPin &pinPort_GDO0): _GDO0_pin(pinPort_GDO0)
+{
+}
+
+/**
+* @brief Initializes the encoder by setting the pin as OUTPUT and LOW (carrier off).
+*/
+void EV1527_Encoder::begin()
+{
+    #ifdef LOG_VERBOSE
+    LOG_NEW_LINE("EV1527_Encoder::begin() - Initializing Encoder");
+    #endif
+
+    // Pin used for OOK modulation
+    _GDO0_pin.pinConfig
+    (
+        false,                                  // As output
+        false                                   // No internal Pullup resistor enable
+    );
+
+    setIdle();
+}
+
+/**
+ * @brief Single HIGH/LOW pulse pair, the only building block of the EV1527 waveform
+ */
+void EV1527_Encoder::pulse(uint16_t highUs, uint16_t lowUs)
+{
+    _GDO0_pin.writePin(HIGH);
+    Timebase::delayUs(highUs);
+    _GDO0_pin.writePin(LOW);
+    Timebase::delayUs(lowUs);
+}
+
+/**
+ * @brief Send an encoded '1' : 3T HIGH + T LOW ->  ..._|   |_...
+ */
+void EV1527_Encoder::sendOne()
+{
+    pulse(3 * EV1527_BASE_PULSE_US, EV1527_BASE_PULSE_US);
+}
+
+/**
+ * @brief Send an encoded '0' : T HIGH + 3T LOW ->  ..._| |___...
+ */
+void EV1527_Encoder::sendZero()
+{
+    pulse(EV1527_BASE_PULSE_US, 3 * EV1527_BASE_PULSE_US);
+}
+
+/**
+ * @brief PT2262 floating digit : '0' followed by '1'
+ */
+void EV1527_Encoder::sendOpen()
+{
+    sendZero();
+    sendOne();
+}
+
+/**
+ * @brief Silence period between bursts (the sync LOW already separates words inside a burst)
+ */
+void EV1527_Encoder::sendSilence()
+{
+    _GDO0_pin.writePin(LOW);
+    Timebase::delayUs(EV1527_SYNC_LOW_US);
+}
+
+/**
+ * @brief Sync symbol sent before every word : T HIGH + 31T LOW
+ */
+void EV1527_Encoder::sendPreamble()
+{
+    pulse(EV1527_BASE_PULSE_US, EV1527_SYNC_LOW_US);
+}
+
+/**
+ * @brief Sets the encoder to IDLE state by setting the pin LOW (carrier off).
+ */
+void EV1527_Encoder::setIdle()
+{
+    _GDO0_pin.writePin(LOW);
+}
@@ -1,6 +1,7 @@
 #include "Encoder/SC41344_Encoder.h"
 #include "avr_algorithms.hpp" // For repeat function
 #include "utils/HelperFunc.h" // For printDots function
+#include "Delay/Timebase.h"
 
 SC41344_Encoder::SC41344_Encoder(DigitalPin &pinPort_GDO0): _GDO0_pin(pinPort_GDO0)
 {
@@ -39,9 +40,9 @@ void SC41344_Encoder::sendOne()
    auto streamOneBitSeq = [&]()
    {
       _GDO0_pin.writePin(HIGH);
-      delayMicroseconds(LONG_HIGH_US);
+      Timebase::delayUs(LONG_HIGH_US);
       _GDO0_pin.writePin(LOW);
-      delayMicroseconds(SHORT_LOW_US);       
+      Timebase::delayUs(SHORT_LOW_US);       
    };
 
     // Send encoded '1' 
@@ -60,9 +61,9 @@ void SC41344_Encoder::sendZero()
     auto streamZeroBitSeq = [&]()
     {
         _GDO0_pin.writePin(HIGH);
-        delayMicroseconds(SHORT_HIGH_US);
+        Timebase::delayUs(SHORT_HIGH_US);
         _GDO0_pin.writePin(LOW);
-        delayMicroseconds(LONG_LOW_US);       
+        Timebase::delayUs(LONG_LOW_US);       
     };
 
     // Send encoded '0'
@@ -78,13 +79,13 @@ void SC41344_Encoder::sendZero()
 void SC41344_Encoder::sendOpen()
 {
     _GDO0_pin.writePin(HIGH);
-    delayMicroseconds(LONG_HIGH_US);
+    Timebase::delayUs(LONG_HIGH_US);
     _GDO0_pin.writePin(LOW);
-    delayMicroseconds(SHORT_LOW_US);
+    Timebase::delayUs(SHORT_LOW_US);
     _GDO0_pin.writePin(HIGH);
-    delayMicroseconds(SHORT_HIGH_US);
+    Timebase::delayUs(SHORT_HIGH_US);
     _GDO0_pin.writePin(LOW);
-    delayMicroseconds(LONG_LOW_US);
+    Timebase::delayUs(LONG_LOW_US);
 }
 
 /**
@@ -95,7 +96,7 @@ void SC41344_Encoder::sendSilence()
 {
     // Set the pin LOW for FRAME_SILENCE_BETWEEN_WORDS duration
     _GDO0_pin.writePin(LOW);
-    delayMicroseconds(FRAME_SILENCE_BETWEEN_WORDS);
+    Timebase::delayUs(FRAME_SILENCE_BETWEEN_WORDS);
     _GDO0_pin.writePin(HIGH);
 }
 
@@ -107,7 +108,7 @@ void SC41344_Encoder::sendPreamble()
 {
     // Set the pin LOW for PREAMBLE_LOW_DURATION_US duration
     _GDO0_pin.writePin(LOW);                                                
-    delayMicroseconds(PREAMBLE_LOW_DURATION_US);        
+    Timebase::delayUs(PREAMBLE_LOW_DURATION_US);        
 }
 
 
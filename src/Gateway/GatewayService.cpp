@@ -0,0 +1,214 @@
+#include "Gateway/GatewayService.h"
+#include <avr/wdt.h>
+
+using namespace GatewayProtocol;
+
+
+GatewayService::GatewayService(HardwareSerial& serial, Transceiver& transceiver, SC41344_Encoder& sc41344, EV1527_Encoder& ev1527):
+_serial(serial),
+_transceiver(transceiver),
+_sc41344(sc41344),
+_ev1527(ev1527),
+_stats{},
+_lastTelemetryMs(0)
+{
+}
+
+void GatewayService::begin()
+{
+    _serial.begin(GATEWAY_BAUD_RATE);
+}
+
+const GatewayStats& GatewayService::stats() const
+{
+    return _stats;
+}
+
+/**
+ * @brief Feeds the frame parser with what is already in the UART buffer.
+ *        A bad length or CRC drops the frame and resynchronises on the next SOF.
+ */
+void GatewayService::poll()
+{
+    while (_serial.available() > 0)
+    {
+        if (_parser.feed(static_cast<uint8_t>(_serial.read()))) handleFrame(_parser.frame());
+    }
+    _stats.framingErrors = _parser.framingErrors();
+}
+
+/**
+ * @brief Dispatch of a CRC-valid frame. TRANSMIT is only queued here, streaming happens in service().
+ */
+void GatewayService::handleFrame(const FrameView& frame)
+{
+    const uint8_t  sequence = frame.sequence;
+    const uint8_t* payload  = frame.payload;
+    const uint8_t  length   = frame.length;
+
+    switch (frame.type)
+    {
+        case Request::TRANSMIT:
+        {
+            uint8_t reason = 0;
+            uint8_t bits = (length > 0) ? familyBits(payload[0]) : 0;
+
+            if (bits == 0)                                        reason = Reason::BAD_FAMILY;
+            else if (length != 1 + (bits + 7) / 8)                reason = Reason::BAD_LENGTH;
+            else if (_queue.full())                               reason = Reason::QUEUE_FULL;
+
+            if (reason == 0)
+            {
+                Command command { sequence, payload[0], {0, 0, 0} };
+                memcpy(command.code, &payload[1], length - 1);
+                _queue.push(command);
+                _stats.received++;
+                if (_queue.size() > _stats.queueHighWater) _stats.queueHighWater = _queue.size();
+
+                uint8_t credits = _queue.freeSlots();
+                sendFrame(Reply::ACCEPTED, sequence, &credits, 1);
+            }
+            else
+            {
+                _stats.rejected++;
+                uint8_t reply[2] = { reason, _queue.freeSlots() };
+                sendFrame(Reply::REJECTED, sequence, reply, sizeof(reply));
+            }
+            break;
+        }
+
+        case Request::GET_STATS:
+            sendStats(sequence);
+            break;
+
+        case Request::RESET_STATS:
+            _stats = GatewayStats{};
+            _parser.resetErrors();
+            sendStats(sequence);
+            break;
+
+        case Request::IDENTIFY:
+            sendTelemetry(sequence);
+            break;
+
+        default:
+        {
+            uint8_t reply[2] = { Reason::UNKNOWN_TYPE, _queue.freeSlots() };
+            sendFrame(Reply::REJECTED, sequence, reply, sizeof(reply));
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Streams every queued command inside a single TX session.
+ *        New commands received while a frame is on air are picked up between frames, so a host
+ *        that keeps the queue fed keeps the radio in TX.
+ */
+void GatewayService::service()
+{
+    if (_queue.empty())
+    {
+        if (Timebase::nowMs() - _lastTelemetryMs >= GATEWAY_TELEMETRY_INTERVAL_MS) sendTelemetry(0);
+        return;
+    }
+
+    _transceiver.openTxSession();
+
+    Command command;
+    while (_queue.pop(command))
+    {
+        if (_stats.executed == 0) _stats.firstCommandMs = Timebase::nowMs();
+
+        uint8_t reply[2];
+        reply[0] = execute(command) ? 1 : 0;
+        reply[1] = _queue.size();
+        if (reply[0]) _stats.executed++;
+        _stats.lastCompleteMs = Timebase::nowMs();
+        sendFrame(Reply::COMPLETE, command.sequence, reply, sizeof(reply));
+
+        wdt_reset();
+        poll();
+    }
+
+    _transceiver.closeTxSession();
+}
+
+template<typename Family>
+void GatewayService::streamPacked(const uint8_t* packed, IBitEncoder& encoder)
+{
+    uint8_t bits[Family::WORD_BITS];
+    for (uint8_t i = 0; i < Family::WORD_BITS; ++i)
+    {
+        bits[i] = (packed[i >> 3] >> (7 - (i & 0x07))) & 0x01;
+    }
+    // Clean edges with the UART still live: only the periodic ISRs are masked for the burst
+    Timebase::suspend();
+    _transceiver.streamFrame<Family>(bits, encoder);
+    Timebase::resume(CodeFamilies::burstDurationUs<Family>());
+}
+
+/**
+ * @brief The only runtime branch on the family: picks the compile-time streamer for the command.
+ */
+bool GatewayService::execute(const Command& command)
+{
+    switch (static_cast<Family>(command.family))
+    {
+        case Family::SC41344_8:  streamPacked<CodeFamilies::SC41344_8Bit>(command.code, _sc41344);  return true;
+        case Family::SC41344_12: streamPacked<CodeFamilies::SC41344_12Bit>(command.code, _sc41344); return true;
+        case Family::SC41344_16: streamPacked<CodeFamilies::SC41344_16Bit>(command.code, _sc41344); return true;
+        case Family::SC41344_24: streamPacked<CodeFamilies::SC41344_24Bit>(command.code, _sc41344); return true;
+        case Family::EV1527:     streamPacked<CodeFamilies::EV1527>(command.code, _ev1527);         return true;
+        default:                 return false;
+    }
+}
+
+void GatewayService::sendFrame(uint8_t type, uint8_t sequence, const uint8_t* payload, uint8_t length)
+{
+    uint8_t frameLength = 2 + length;
+    uint8_t crc = crc8(0, frameLength);
+    crc = crc8(crc, type);
+    crc = crc8(crc, sequence);
+
+    _serial.write(SOF);
+    _serial.write(frameLength);
+    _serial.write(type);
+    _serial.write(sequence);
+    for (uint8_t i = 0; i < length; ++i)
+    {
+        _serial.write(payload[i]);
+        crc = crc8(crc, payload[i]);
+    }
+    _serial.write(crc);
+}
+
+/**
+ * @brief Reports the counters; commands/s = executed * 1000 / (lastCompleteMs - firstCommandMs) on the host.
+ */
+void GatewayService::sendStats(uint8_t sequence)
+{
+    uint8_t payload[sizeof(GatewayStats)];
+    memcpy(payload, &_stats, sizeof(GatewayStats));                    // AVR is little endian, no padding on 8-bit
+    sendFrame(Reply::STATS, sequence, payload, sizeof(payload));
+}
+
+/**
+ * @brief Binary health record; SEQ is 0 when unsolicited, the request's SEQ when answering IDENTIFY.
+ */
+void GatewayService::sendTelemetry(uint8_t sequence)
+{
+    _lastTelemetryMs = Timebase::nowMs();
+
+    Telemetry telemetry;
+    telemetry.unitId        = GATEWAY_UNIT_ID;
+    telemetry.uptimeMs      = _lastTelemetryMs;
+    telemetry.executed      = _stats.executed;
+    telemetry.marcState     = _transceiver.readMarcState();
+    telemetry.queueDepth    = _queue.size();
+    telemetry.framingErrors = (_stats.framingErrors > 0xFF) ? 0xFF : static_cast<uint8_t>(_stats.framingErrors);
+
+    uint8_t payload[sizeof(Telemetry)];
+    memcpy(payload, &telemetry, sizeof(Telemetry));
+    sendFrame(Reply::TELEMETRY, sequence, payload, sizeof(payload));
+}
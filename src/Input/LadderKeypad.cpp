@@ -0,0 +1,151 @@
+#include "Input/LadderKeypad.h"
+#include <avr/interrupt.h>
+
+
+// Band edges: a reading above EDGES[k] is not button k. Computed once by the compiler.
+struct LadderEdges
+{
+    uint8_t value[LADDER_BUTTON_COUNT];
+
+    constexpr LadderEdges() : value{}
+    {
+        for (uint8_t k = 0; k < LADDER_BUTTON_COUNT; ++k)
+        {
+            value[k] = static_cast<uint8_t>((LADDER_LEVELS[k] + LADDER_LEVELS[k + 1]) / 2);
+        }
+    }
+};
+
+static constexpr LadderEdges EDGES{};
+
+static_assert([]{
+    for (uint8_t k = 0; k < LADDER_BUTTON_COUNT; ++k)
+        if (LADDER_LEVELS[k + 1] - LADDER_LEVELS[k] <= 4 * LADDER_HYSTERESIS) return false;
+    return true;
+}(), "LADDER_LEVELS too close for LADDER_HYSTERESIS: bands would have no accept zone");
+
+LadderKeypad* LadderKeypad::_active = nullptr;
+
+
+LadderKeypad::LadderKeypad():
+_debouncers{},
+_band(NONE),
+_bandChangeUs(0),
+_sleeping(false)
+{
+}
+
+void LadderKeypad::attach(uint8_t button, CircularDebounceBuffer& debounce)
+{
+    if (button >= LADDER_BUTTON_COUNT) return;
+
+    _debouncers[button] = &debounce;
+    debounce.setSampleSource(&LadderKeypad::isPressed);
+}
+
+/**
+ * @brief AVcc reference, ADLAR (8-bit result in ADCH), free-running auto trigger, ISR per conversion.
+ *        The digital input buffer of the pin is disabled: it only adds leakage on an analog level.
+ */
+void LadderKeypad::begin()
+{
+    _active   = this;
+    _band     = NONE;
+    _sleeping = false;
+
+#ifdef LADDER_PROFILING
+    DDRD |= (1 << LADDER_PROBE_PORT_BIT);
+#endif
+
+    DIDR0  |= (1 << LADDER_ADC_CHANNEL);
+    ADMUX   = (1 << REFS0) | (1 << ADLAR) | (LADDER_ADC_CHANNEL & 0x07);
+    ADCSRB  = 0;                                                                        // Auto-trigger source: free running
+    ADCSRA  = (1 << ADEN) | (1 << ADATE) | (1 << ADIE) | (1 << ADIF) |
+              (1 << ADPS2) | (1 << ADPS1) | (1 << ADPS0);                               // /128 -> 125 kHz ADC clock
+    ADCSRA |= (1 << ADSC);                                                              // First conversion starts the chain
+}
+
+void LadderKeypad::end()
+{
+    ADCSRA = 0;
+    _active = nullptr;
+}
+
+/**
+ * @brief Switches the auto-trigger source: Timer0 overflow while sleeping (the core's millis ISR
+ *        clears TOV0, so every overflow is a new trigger edge), free running otherwise. Leaving
+ *        sleep restarts the free-running chain with ADSC; ADIF is written 0 so a pending result
+ *        still reaches the ISR.
+ */
+void LadderKeypad::setSleeping(bool sleeping)
+{
+    if (!_active || sleeping == _sleeping) return;
+    _sleeping = sleeping;
+
+    if (sleeping)
+    {
+        ADCSRB = (1 << ADTS2);                                                          // Auto-trigger source: Timer0 overflow
+    }
+    else
+    {
+        ADCSRB = 0;                                                                     // Free running
+        ADCSRA = (ADCSRA & ~(1 << ADIF)) | (1 << ADSC);
+    }
+}
+
+bool LadderKeypad::isPressed(uint8_t button)
+{
+    return _active && _active->_band == button;
+}
+
+uint8_t LadderKeypad::rawBand(uint8_t sample)
+{
+    uint8_t band = 0;
+    while (band < LADDER_BUTTON_COUNT && sample > EDGES.value[band]) ++band;
+    return band;
+}
+
+/**
+ * @brief True when the sample is at least LADDER_HYSTERESIS counts away from both edges of the band.
+ */
+bool LadderKeypad::insideBand(uint8_t band, uint8_t sample)
+{
+    if (band > 0 && sample <= EDGES.value[band - 1] + LADDER_HYSTERESIS) return false;
+    if (band < LADDER_BUTTON_COUNT && sample + LADDER_HYSTERESIS >= EDGES.value[band]) return false;
+    return true;
+}
+
+/**
+ * @brief Runs in the ADC ISR: a few compares per conversion, more work only on a band change.
+ */
+void LadderKeypad::onConversion(uint8_t sample)
+{
+    LadderKeypad* keypad = _active;
+    if (!keypad) return;
+
+    uint8_t band = rawBand(sample);
+    if (band == keypad->_band || !insideBand(band, sample)) return;
+
+    keypad->_band = band;
+#ifdef LADDER_PROFILING
+    keypad->_bandChangeUs = micros();
+#endif
+
+    if (band != NONE && keypad->_debouncers[band])
+    {
+        keypad->_debouncers[band]->startDebounce();
+    }
+}
+
+ISR(ADC_vect)
+{
+#ifdef LADDER_PROFILING
+    PORTD |= (1 << LADDER_PROBE_PORT_BIT);
+#endif
+
+    LadderKeypad::onConversion(ADCH);
+
+#ifdef LADDER_PROFILING
+    PORTD &= ~(1 << LADDER_PROBE_PORT_BIT);
+#endif
+}
@@ -1,5 +1,6 @@
 #include "SPI/SPIBus.h"
 #include "utils/HelperFunc.h"
+#include "Delay/Timebase.h"
 
 
 /// @brief SPIBus constructor
@@ -24,6 +25,8 @@ void SPIBus::begin()
 /// @brief Set CSn pin LOW to select the device.
 void SPIBus::selectDevice()
 {   
+    SpiTrace::onSelect();                                                   // SPI_BUDGET_MODE accounting, empty otherwise
+    FieldTrace::onSelect();                                                 // Field trace record / replay, empty otherwise
     digitalWrite(_csnPin,LOW);                                           // Enable device to be ready for receiving data   
 }
 
@@ -33,6 +36,23 @@ void SPIBus::deselectDevice()
     digitalWrite(_csnPin,HIGH);                                           // Disable Slave device from SPI bus  
 }
 
+/// @brief With CSn low, waits for the chip to pull SO low (CHIP_RDYn: crystal running, reset done).
+///        While a trace is replayed the bus is the trace: SO is not read, the status byte of the next
+///        recorded transaction tells whether the chip was ready.
+/// @param timeoutUs - Timebase time to wait
+/// @return false on timeout
+bool SPIBus::awaitChipReady(uint32_t timeoutUs)
+{
+    if (FieldTrace::replaying()) return true;
+
+    uint32_t start = Timebase::nowUs();
+    while (digitalRead(MISO) == HIGH)
+    {
+        if (Timebase::nowUs() - start > timeoutUs) return false;
+    }
+    return true;
+}
+
 
 /// @brief Transfer a single byte through the SPI bus and return the response. Suitable for Strobe commands
 /// @param data - byte to send
@@ -43,7 +63,7 @@ uint8_t SPIBus::transferByte(uint8_t data)
     uint8_t receivedData;
     
     // Apply SPI transaction
-    applyTransaction([&](){ receivedData = SPI.transfer(data);});
+    applyTransaction([&](){ receivedData = transfer(data);});
     
     // Log the transfer operation
     #if LOG_VERBOSE
@@ -68,16 +88,16 @@ bool SPIBus::writeBurstRegister(uint8_t address, const uint8_t *data, size_t len
     // Validate parameters
     if (!data || length == 0 || length>64)
     {
-        LOG_NEW_LINE("writeBurstRegister Error : Invalid parameters");
+        LOG_ERROR("writeBurstRegister Error : Invalid parameters");
         LOG_PAIR_HEX("Address: ", address);
         LOG_PAIR_HEX("Length: ", length);
         return false;
     }
     
-    // Validate address
-    if(address != 0x03 && address != 0x3F)
+    // Validate address: configuration registers, PATABLE and TX FIFO take bursts, 0x30..0x3D are strobes
+    if(address > 0x2E && address != CC1101::Address::PATABLE && address != CC1101::Address::FIFO)
     {
-        LOG_NEW_LINE("writeBurstRegister Error : Invalid address ");
+        LOG_ERROR("writeBurstRegister Error : Invalid address ");
         LOG_PAIR_HEX("Address: ", address);
         return false;
     }
@@ -85,9 +105,9 @@ bool SPIBus::writeBurstRegister(uint8_t address, const uint8_t *data, size_t len
     // Sends the address followed by data bytes in a loop.
     applyTransaction( [&]()
         {
-            SPI.transfer(address | bitFlags::writeBurstRegister);                                                                   // bitFlags::writeBurstRegister (0x40) to set bit 6 for burst write mode
+            transfer(address | bitFlags::writeBurstRegister);                                                                   // bitFlags::writeBurstRegister (0x40) to set bit 6 for burst write mode
             for (size_t i = 0; i < length; i++) {
-                SPI.transfer(data[i]);
+                transfer(data[i]);
             }
         });
 
@@ -108,7 +128,7 @@ bool SPIBus::readBurstRegister(uint8_t address, uint8_t *buffer, size_t length)
    // The function checks if the address is valid, the buffer is not null, and the length is within the valid range (1 to 64 bytes).
    // If any of these conditions are not met, the function returns false.
    if (!validateParameters(address, buffer, length)) {
-      LOG_NEW_LINE("readBurstRegister Error : Invalid parameters");
+      LOG_ERROR("readBurstRegister Error : Invalid parameters");
       LOG_PAIR_HEX("Address: ", address);
       LOG_PAIR_HEX("Length: ", length);
       return true; // Retry
@@ -162,7 +182,7 @@ bool SPIBus::writeRegister(uint8_t address, uint8_t value)
     if(address > bitFlags::AddressMask)
     {
       LOG("---------- SPIBus communication Error ---------");
-      LOG_NEW_LINE("SPIBus::writeRegister Error: Invalid CC1101 register address");
+      LOG_ERROR("SPIBus::writeRegister Error: Invalid CC1101 register address");
       LOG_PAIR_HEX("Address: ", address);
       return false;                                                                                                                         // Validates address against bitFlags::AddressMask (0x3F) to ensure it’s a valid CC1101 register address (0x00–0x3F).
     }
@@ -175,13 +195,13 @@ bool SPIBus::writeRegister(uint8_t address, uint8_t value)
         // Perform SPI write transaction
         applyTransaction([&]()
         {
-            SPI.transfer(address & bitFlags::WriteSingle);                                                                      // bitFlags::WriteSingle (0x7F) to clear bit 7 for single-byte write mode (e.g., 0x02 & 0x7F = 0x02 for IOCFG0)
-            SPI.transfer(value);
+            transfer(address & bitFlags::WriteSingle);                                                                      // bitFlags::WriteSingle (0x7F) to clear bit 7 for single-byte write mode (e.g., 0x02 & 0x7F = 0x02 for IOCFG0)
+            transfer(value);
         });
 
         // Step 3: Read back to verify success  
         readResult = readRegister(address);                                                                                  // Read the register to verify the write operation
-        if(readResult.isValid() && readResult.value == value)                                                           // Check if the read value matches the written value   
+        if(readResult.chipAnswered() && readResult.value == value)                                                      // Check if the read value matches the written value (0xFF included)
         {
             LOG_NEW_LINE("SPIBus::writeRegister - Write operation successful");
             LOG_PAIR_HEX("Address: ", address);
@@ -201,7 +221,7 @@ bool SPIBus::writeRegister(uint8_t address, uint8_t value)
     });
 
    // If we reach here, it means all retries failed
-   LOG_NEW_LINE("SPIBus::writeRegister Error: Failed to write register after 3 attempts");  
+   LOG_ERROR("SPIBus::writeRegister Error: Failed to write register after 3 attempts");  
    LOG("\n\n");
    return false;    
 }
@@ -219,7 +239,7 @@ ReadResult SPIBus::readRegister(uint8_t address)
 
     // Step 1: Validate address (immediate exit if invalid)
     if (address > bitFlags::AddressMask) {
-        LOG_NEW_LINE("SPIBus::readRegister Error: Invalid CC1101 register address");
+        LOG_ERROR("SPIBus::readRegister Error: Invalid CC1101 register address");
         LOG_PAIR_HEX("Address: ", address);
         return result;
     }
@@ -234,8 +254,8 @@ ReadResult SPIBus::readRegister(uint8_t address)
     // Read retry mechanism
     avr_algorithms::repeat_withExitCondition(3, [&]() {
         applyTransaction([&]() {      
-            result.status = SPI.transfer(address | bitFlags::ReadSingle);
-            result.value  = SPI.transfer(bitFlags::DummyByte);
+            result.status = transfer(address | bitFlags::ReadSingle);
+            result.value  = transfer(bitFlags::DummyByte);
 
             #if LOG_VERBOSE
                 LOG_NEW_LINE("SPIBus::readRegister - Read operation");
@@ -246,11 +266,11 @@ ReadResult SPIBus::readRegister(uint8_t address)
             return false; // Transaction succeeded, exit retry loop
         });
 
-        if (!result.isValid()) {
-            LOG_NEW_LINE("SPIBus::readRegister Error: Invalid status byte (0xFF) or value (0xFF)");
+        if (!result.chipAnswered()) {                                                                   // 0xFF is a legal register value, only the status byte tells
+            LOG_ERROR("SPIBus::readRegister Error: Invalid status byte (0xFF)");
             String errorMsg = "Attempt " + String(attempts + 1) + " failed.";
-            delayMicroseconds(100);
-            LOG_DYNAMIC(errorMsg);
+            Timebase::delayUs(100);
+            LOG_ERROR_DYNAMIC(errorMsg);
             LOG("Retrying");
             printDots(3, 1000); // Print 3 dots with a 500 ms delay between each dot
             LOG("\n");
@@ -262,13 +282,50 @@ ReadResult SPIBus::readRegister(uint8_t address)
         return false; // Success, exit loop
     });
 
-    if (!result.isValid()) {
-        LOG_NEW_LINE("SPIBus::readRegister Error: Failed to read register after 3 attempts");
+    if (!result.chipAnswered()) {
+        LOG_ERROR("SPIBus::readRegister Error: Failed to read register after 3 attempts");
         LOG("\n\n");
     }
     return result;
 }
 
+/// @brief Reads one of the CC1101 status registers (PARTNUM..RCCTRL0_STATUS, 0x30–0x3D).
+/// @note  Status registers share their addresses with the strobes: a single read (0x80 | addr) would be
+///        executed as a strobe, so the burst bit must be set (0xC0 | addr). No retries: status values
+///        such as RXBYTES legitimately change between two reads.
+/// @param address - Status register address
+/// @return ReadResult - Chip status byte and register value
+ReadResult SPIBus::readStatusRegister(uint8_t address)
+{
+    ReadResult result(0xFF, 0xFF);
+
+    applyTransaction([&]() {
+        result.status = transfer((address & bitFlags::AddressMask) | bitFlags::readBurstRegister);
+        result.value  = transfer(bitFlags::DummyByte);
+    });
+
+    return result;
+}
+
+/// @brief Reads `length` bytes from the RX FIFO in a single burst transaction.
+/// @note  Unlike readBurstRegister() there is no retry and no all-0xFF check: reading the FIFO consumes it
+///        and 0xFF is a valid payload byte.
+/// @param buffer - Destination buffer
+/// @param length - Number of bytes to read (1 to 64 bytes)
+/// @return true if the parameters were valid and the bytes were read
+bool SPIBus::readFifo(uint8_t *buffer, size_t length)
+{
+    if (!buffer || length == 0 || length > 64) return false;
+
+    applyTransaction([&]() {
+        transfer(CC1101::Address::FIFO | bitFlags::readBurstRegister);
+        avr_algorithms::for_each(buffer, length, [&](uint8_t& data, uint8_t index) {
+            data = transfer(bitFlags::DummyByte);
+        });
+    });
+    return true;
+}
+
 /**
  * @brief Validates the parameters for SPI operations.
  * This function checks if the address is within the valid range,
@@ -335,9 +392,9 @@ bool SPIBus::performBurstRead(uint8_t address, uint8_t *buffer, size_t length)
     // If any byte is not 0xFF, the allFFs flag is set to false, indicating that the read operation was successful and data was read into the buffer.
     // If all bytes are 0xFF, it indicates a likely SPI read failure,
     applyTransaction([&]() {
-        SPI.transfer(address | bitFlags::readBurstRegister);
+        transfer(address | bitFlags::readBurstRegister);
         avr_algorithms::for_each(buffer, length, [&](uint8_t& data, uint8_t index) {
-            data = SPI.transfer(bitFlags::DummyByte);
+            data = transfer(bitFlags::DummyByte);
             if (data != 0xFF) allFFs = false;
         });
     });
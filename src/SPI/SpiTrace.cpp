@@ -0,0 +1,19 @@
+#include "SPI/SpiTrace.h"
+
+#ifdef SPI_BUDGET_MODE
+
+SpiTraffic SpiTrace::_traffic = { 0, 0, 0 };
+uint8_t    SpiTrace::_log[SPI_TRACE_LOG_SIZE] = {};
+uint8_t    SpiTrace::_logLength = 0;
+bool       SpiTrace::_logOverflow = false;
+bool       SpiTrace::_header = false;
+
+void SpiTrace::reset()
+{
+    _traffic = { 0, 0, 0 };
+    _logLength = 0;
+    _logOverflow = false;
+    _header = false;
+}
+
+#endif
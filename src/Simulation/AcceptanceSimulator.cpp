@@ -0,0 +1,246 @@
+#include "Simulation/AcceptanceSimulator.h"
+#include "App/RemotePrograms.h"
+#include "Policies/PROGMEMStoragePolicy.h"
+#include "Policies/RAMStoragePolicy.h"
+#include "Capture/EdgeCapture.h"
+
+namespace
+{
+    using Family   = CodeFamilies::SC41344_8Bit;
+    using Receiver = SC41344Receiver<Family::WORD_BITS>;
+
+    constexpr uint32_t WORD_US = Family::WORD_BITS * Family::BIT_PERIOD_US + Family::SYNC_PERIOD_US;
+
+    constexpr uint32_t expectedWord()
+    {
+        uint32_t word = 0;
+        for (uint8_t bit : REMOTE1_OPEN_DOOR_CODE) word = (word << 1) | bit;
+        return word;
+    }
+
+    constexpr ReceiverParams TYPICAL_RECEIVER{ RECEIVER_TOLERANCE_PCT, RECEIVER_SYNC_MIN_US, RECEIVER_WORDS_REQUIRED, RECEIVER_WINDOW_WORDS };
+
+    // Channel x receiver grid printed by runAcceptanceSimulation()
+    const AcceptanceScenario SCENARIOS[] PROGMEM =
+    {
+        { {   0,    0,   0,   0 }, TYPICAL_RECEIVER },                                             // 0 clean
+        { {  50,    0,   0,   0 }, TYPICAL_RECEIVER },                                             // 1 ISR-grade jitter
+        { { 200,    0,   0,   0 }, TYPICAL_RECEIVER },                                             // 2 heavy jitter
+        { {  50,  150,   0,   0 }, TYPICAL_RECEIVER },                                             // 3 slow transmitter clock (+15 %)
+        { {  50, -250,   0,   0 }, TYPICAL_RECEIVER },                                             // 4 fast transmitter clock (-25 %)
+        { {  50,    0,  20,   0 }, TYPICAL_RECEIVER },                                             // 5 noise spikes
+        { {  50,    0,   0, 500 }, TYPICAL_RECEIVER },                                             // 6 collision on half the bursts
+        { { 100,    0,   0,   0 }, { 15, RECEIVER_SYNC_MIN_US, RECEIVER_WORDS_REQUIRED, RECEIVER_WINDOW_WORDS } },   // 7 tight receiver
+        { {  50,    0,  20,   0 }, { RECEIVER_TOLERANCE_PCT, RECEIVER_SYNC_MIN_US, 3, RECEIVER_WINDOW_WORDS } },     // 8 3-of-4 receiver
+    };
+
+    /// @brief xorshift32: reproducible per trial, same sequence on the host
+    struct Rng
+    {
+        uint32_t state;
+
+        uint32_t next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        uint32_t below(uint32_t bound) { return bound ? next() % bound : 0; }
+        bool     chance(uint16_t permille) { return permille && below(1000) < permille; }
+    };
+
+    /// @brief Feeds time-stamped pieces to the receiver, forcing the carrier on inside the collision window
+    struct Channel
+    {
+        Receiver& receiver;
+        int32_t   collisionStart;
+        int32_t   collisionEnd;                                 // Empty window when equal
+
+        void feed(uint8_t level, int32_t start, int32_t end)
+        {
+            if (end <= start) return;
+            if (collisionEnd <= start || collisionStart >= end)
+            {
+                receiver.feed(level, end - start);
+                return;
+            }
+            if (start < collisionStart) receiver.feed(level, collisionStart - start);
+            receiver.feed(1, (end < collisionEnd ? end : collisionEnd) - (start > collisionStart ? start : collisionStart));
+            if (end > collisionEnd) receiver.feed(level, end - collisionEnd);
+        }
+    };
+
+    int32_t skewed(uint32_t us, int16_t skewPermille)
+    {
+        return static_cast<int32_t>(us) * (1000 + skewPermille) / 1000;                   // Bursts stay below 2^31 / 1250 us
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Conformance: the clean compiled burst is accepted by the typical receiver
+    // ---------------------------------------------------------------------------------
+    constexpr Receiver decodeClean(const ReceiverParams& params)
+    {
+        Receiver receiver(params);
+        Waveform::Interpreter<RAMStoragePolicy> interpreter(RemotePrograms::OPEN_DOOR.bytes.data(), RemotePrograms::OPEN_DOOR.length);
+        Waveform::Edge edge{0, 0};
+        while (interpreter.next(edge)) receiver.feed(edge.level, edge.durationUs);
+        receiver.finish();
+        return receiver;
+    }
+
+    constexpr Receiver CLEAN = decodeClean(TYPICAL_RECEIVER);
+
+    static_assert(CLEAN.accepted() && CLEAN.acceptedWord() == expectedWord(), "Typical receiver must accept the clean open-door burst");
+    static_assert(CLEAN.wordSlots() == AcceptanceResult::MAX_WORDS, "One word slot per word sent");
+    static_assert(CLEAN.acceptedAtUs() <= Family::LEAD_IN_US + RECEIVER_WORDS_REQUIRED * WORD_US + (RECEIVER_WORDS_REQUIRED - 1) * Family::GAP_US + RECEIVER_SYNC_MIN_US,
+                  "Clean burst is accepted on the N-th word");
+    static_assert(CodeFamilies::burstDurationUs<Family>() == AcceptanceSimulator::airtimeUs(AcceptanceResult::MAX_WORDS),
+                  "airtimeUs() of a full burst is the family burst duration");
+}
+
+uint32_t AcceptanceSimulator::carrierOnUs(uint8_t words)
+{
+    uint32_t cutUs = airtimeUs(words);
+    uint32_t nowUs = 0;
+    uint32_t onUs  = 0;
+
+    Waveform::Interpreter<PROGMEMStoragePolicy, false> interpreter(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size());
+    Waveform::Edge edge{0, 0};
+    while (nowUs < cutUs && interpreter.next(edge))
+    {
+        uint32_t durationUs = (edge.durationUs < cutUs - nowUs) ? edge.durationUs : cutUs - nowUs;
+        if (edge.level) onUs += durationUs;
+        nowUs += durationUs;
+    }
+    return onUs;
+}
+
+namespace
+{
+    /// @brief The trials, on copies of `burst`: any edge source with next(Waveform::Edge&)
+    template<typename Source>
+    AcceptanceResult simulate(const AcceptanceScenario& scenario, uint16_t trials, uint32_t seed, uint32_t firstTrial, const Source& burst)
+    {
+        const Impairments& channel = scenario.channel;
+        AcceptanceResult result{};
+        result.trials = trials;
+
+        for (uint16_t trial = 0; trial < trials; ++trial)
+        {
+            uint32_t index = firstTrial + trial;
+            Rng rng{ static_cast<uint32_t>((0x9E3779B9UL ^ seed) ^ (index * 0x85EBCA6BUL + 1)) };
+            Receiver receiver(scenario.receiver);
+
+            Channel line{ receiver, 0, 0 };
+            if (rng.chance(channel.collisionPermille))
+            {
+                line.collisionStart = static_cast<int32_t>(rng.below(skewed(CodeFamilies::burstDurationUs<Family>(), channel.skewPermille)));
+                line.collisionEnd   = line.collisionStart + ACCEPTANCE_SIM_COLLISION_US;
+            }
+
+            Source source = burst;
+            Waveform::Edge edge{0, 0};
+            int32_t nominalUs = 0;
+            int32_t edgeUs    = 0;                              // Jittered time of the previous edge
+
+            while (source.next(edge))
+            {
+                nominalUs += skewed(edge.durationUs, channel.skewPermille);
+                int32_t jitter = channel.jitterUs ? static_cast<int32_t>(rng.below(2 * channel.jitterUs + 1)) - channel.jitterUs : 0;
+                int32_t endUs  = nominalUs + jitter;
+                if (endUs <= edgeUs) continue;                  // Swallowed by its neighbours
+
+                if (!edge.level && rng.chance(channel.noisePermille))
+                {
+                    int32_t width   = 20 + static_cast<int32_t>(rng.below(ACCEPTANCE_SIM_SPIKE_MAX_US - 20 + 1));
+                    int32_t spikeAt = edgeUs + static_cast<int32_t>(rng.below(endUs - edgeUs));
+                    int32_t spikeEnd = (spikeAt + width < endUs) ? spikeAt + width : endUs;
+                    line.feed(0, edgeUs, spikeAt);
+                    line.feed(1, spikeAt, spikeEnd);
+                    line.feed(0, spikeEnd, endUs);
+                }
+                else
+                {
+                    line.feed(edge.level, edgeUs, endUs);
+                }
+                edgeUs = endUs;
+            }
+            receiver.finish();
+
+            if (!receiver.accepted()) continue;
+            if (receiver.acceptedWord() != expectedWord())
+            {
+                ++result.wrongWord;
+                continue;
+            }
+            for (uint8_t words = 1; words <= AcceptanceResult::MAX_WORDS; ++words)
+            {
+                int32_t deadline = skewed(AcceptanceSimulator::airtimeUs(words), channel.skewPermille) + scenario.receiver.syncMinUs + channel.jitterUs;
+                if (static_cast<int32_t>(receiver.acceptedAtUs()) <= deadline) ++result.accepted[words - 1];
+            }
+        }
+        return result;
+    }
+}
+
+AcceptanceResult AcceptanceSimulator::run(const AcceptanceScenario& scenario, uint16_t trials, uint32_t seed, uint32_t firstTrial)
+{
+    Waveform::Interpreter<PROGMEMStoragePolicy, false> program(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size());
+    return simulate(scenario, trials, seed, firstTrial, program);
+}
+
+AcceptanceResult AcceptanceSimulator::runCapture(const AcceptanceScenario& scenario, uint16_t trials, const uint8_t* capture, size_t size,
+                                                 uint32_t seed, uint32_t firstTrial)
+{
+    Capture::Reader<RAMStoragePolicy> reader(capture, size);
+    return simulate(scenario, trials, seed, firstTrial, reader.begin());
+}
+
+uint8_t AcceptanceSimulator::scenarioCount()
+{
+    return sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+}
+
+AcceptanceScenario AcceptanceSimulator::scenario(uint8_t index)
+{
+    AcceptanceScenario scenario;
+    memcpy_P(&scenario, &SCENARIOS[index], sizeof(scenario));
+    return scenario;
+}
+
+void AcceptanceSimulator::printLine(Print& out, uint8_t index, uint8_t words, uint16_t acceptPermille, uint16_t wrongPermille)
+{
+    out.print(F("SIM "));
+    out.print(index);
+    out.print(F(" words="));
+    out.print(words);
+    out.print(F(" accept="));
+    out.print(acceptPermille);
+    out.print(F(" wrong="));
+    out.print(wrongPermille);
+    out.print(F(" airtime_ms="));
+    out.print(airtimeUs(words) / 1000);
+    out.print(F(" charge_uC="));
+    out.println((carrierOnUs(words) / 1000) * ACCEPTANCE_SIM_TX_MA);
+}
+
+static uint16_t permille(uint16_t count, uint16_t trials)
+{
+    return trials ? static_cast<uint16_t>((static_cast<uint32_t>(count) * 1000) / trials) : 0;
+}
+
+void runAcceptanceSimulation(Print& out)
+{
+    for (uint8_t index = 0; index < AcceptanceSimulator::scenarioCount(); ++index)
+    {
+        AcceptanceResult result = AcceptanceSimulator::run(AcceptanceSimulator::scenario(index), ACCEPTANCE_SIM_TRIALS);
+
+        for (uint8_t words = 1; words <= AcceptanceResult::MAX_WORDS; ++words)
+        {
+            AcceptanceSimulator::printLine(out, index, words, permille(result.accepted[words - 1], result.trials),
+                                           permille(result.wrongWord, result.trials));
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#include "Simulation/EnergyEstimator.h"
+#include "Simulation/AcceptanceSimulator.h"
+#include "Capture/EdgeCapture.h"
+#include "Debounce/CircularDebounceBuffer.h"
+#include "App/RemotePrograms.h"
+#include "Policies/PROGMEMStoragePolicy.h"
+#include "Policies/RAMStoragePolicy.h"
+
+namespace
+{
+    // Confirmed once THRESHOLD_DEBOUNCE % of the buffer reads pressed: a clean press takes that many samples
+    constexpr uint32_t DEBOUNCE_WINDOW_US = ((BUFFER_SIZE * THRESHOLD_DEBOUNCE + 99) / 100) * static_cast<uint32_t>(SAMPLE_RATE_DEBOUNCE);
+
+    static_assert(DEBOUNCE_WINDOW_US > ENERGY_RADIO_CALIBRATE_US, "The speculative radio entry must fit in the debounce window");
+
+    const FirmwareMode MODES[] PROGMEM =
+    {
+        { 0,                      AcceptanceResult::MAX_WORDS, McuPower::Idle,      RadioPower::Idle  },   // armed
+        { 0,                      RECEIVER_WORDS_REQUIRED,     McuPower::Idle,      RadioPower::Idle  },   // adaptive
+        { 0,                      AcceptanceResult::MAX_WORDS, McuPower::PowerDown, RadioPower::Sleep },   // deep
+        { ENERGY_ARDUINO_BOOT_US, AcceptanceResult::MAX_WORDS, McuPower::PowerDown, RadioPower::Sleep },   // coldboot
+        { ENERGY_FAST_BOOT_US,    AcceptanceResult::MAX_WORDS, McuPower::PowerDown, RadioPower::Sleep }    // fastboot
+    };
+
+    const char ARMED[]    PROGMEM = "armed";
+    const char ADAPTIVE[] PROGMEM = "adaptive";
+    const char DEEP[]     PROGMEM = "deep";
+    const char COLDBOOT[] PROGMEM = "coldboot";
+    const char FASTBOOT[] PROGMEM = "fastboot";
+
+    const char* const MODE_NAMES[] PROGMEM = { ARMED, ADAPTIVE, DEEP, COLDBOOT, FASTBOOT };
+
+    static_assert(sizeof(MODES) / sizeof(MODES[0]) == sizeof(MODE_NAMES) / sizeof(MODE_NAMES[0]), "One name per firmware mode");
+
+    /// @brief The press timeline of `mode`, the burst read from any edge source with next(Waveform::Edge&)
+    template<typename Source>
+    constexpr EnergyMeter pressTimeline(const FirmwareMode& mode, const CurrentTable& currents, Source burst)
+    {
+        EnergyMeter meter(currents);
+
+        if (mode.bootUs)                                meter.add({ McuPower::Active, RadioPower::Idle, 0, mode.bootUs });
+        else if (mode.standbyRadio == RadioPower::Sleep) meter.add({ McuPower::Active, RadioPower::Idle, 0, ENERGY_RADIO_WAKE_US });
+
+        // AppAction::Prepare: calibrated at the start of the debounce window, parked in FSTXON until confirmation
+        meter.add({ McuPower::Active, RadioPower::Synth, 0, ENERGY_RADIO_CALIBRATE_US });
+        meter.add({ McuPower::Idle, RadioPower::Synth, 0, DEBOUNCE_WINDOW_US - ENERGY_RADIO_CALIBRATE_US });
+        meter.addBurst(burst, PATABLE_HIGH_INDEX, AcceptanceSimulator::airtimeUs(mode.words));
+        return meter;
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Conformance: the timeline follows the compiled burst and the modes rank as expected
+    // ---------------------------------------------------------------------------------
+    constexpr EnergyMeter cleanPress(const FirmwareMode& mode)
+    {
+        return pressTimeline(mode, DATASHEET_CURRENTS,
+                             Waveform::Interpreter<RAMStoragePolicy>(RemotePrograms::OPEN_DOOR.bytes.data(), RemotePrograms::OPEN_DOOR.length));
+    }
+
+    constexpr FirmwareMode FULL{ 0, AcceptanceResult::MAX_WORDS, McuPower::Idle, RadioPower::Idle };
+    constexpr FirmwareMode CUT{ 0, RECEIVER_WORDS_REQUIRED, McuPower::Idle, RadioPower::Idle };
+
+    static_assert(cleanPress(FULL).durationUs() == DEBOUNCE_WINDOW_US + AcceptanceSimulator::airtimeUs(AcceptanceResult::MAX_WORDS),
+                  "A press is the debounce window and the whole burst: the calibration is done inside the window");
+    static_assert(cleanPress(CUT).durationUs() == DEBOUNCE_WINDOW_US + AcceptanceSimulator::airtimeUs(RECEIVER_WORDS_REQUIRED),
+                  "The burst is cut after the mode's words");
+    static_assert(cleanPress(CUT).carrierUs() < cleanPress(FULL).carrierUs() && cleanPress(CUT).chargePc() < cleanPress(FULL).chargePc(),
+                  "Fewer words, less carrier and less charge");
+    static_assert(EnergyMeter().currentUa(McuPower::Active, RadioPower::Carrier, PATABLE_HIGH_INDEX) == ENERGY_MCU_ACTIVE_UA + ENERGY_RADIO_TX_UA[PATABLE_HIGH_INDEX],
+                  "Carrier current is taken at the paTable index on air");
+}
+
+EnergyMeter EnergyEstimator::press(const FirmwareMode& mode, const CurrentTable& currents)
+{
+    return pressTimeline(mode, currents,
+                         Waveform::Interpreter<PROGMEMStoragePolicy, false>(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size()));
+}
+
+EnergyMeter EnergyEstimator::pressCapture(const FirmwareMode& mode, const uint8_t* capture, size_t size, const CurrentTable& currents)
+{
+    Capture::Reader<RAMStoragePolicy> reader(capture, size);
+    return pressTimeline(mode, currents, reader.begin());
+}
+
+uint32_t EnergyEstimator::standbyUa(const FirmwareMode& mode, const CurrentTable& currents)
+{
+    if (mode.bootUs) return 0;                                  // Powered off between presses
+    return EnergyMeter(currents).currentUa(mode.standbyMcu, mode.standbyRadio);
+}
+
+uint8_t EnergyEstimator::modeCount()
+{
+    return sizeof(MODES) / sizeof(MODES[0]);
+}
+
+FirmwareMode EnergyEstimator::mode(uint8_t index)
+{
+    FirmwareMode mode;
+    memcpy_P(&mode, &MODES[index], sizeof(mode));
+    return mode;
+}
+
+uint8_t EnergyEstimator::modeIndex(const char* name)
+{
+    uint8_t index = 0;
+    while (index < modeCount() && strcmp_P(name, reinterpret_cast<const char*>(pgm_read_ptr(&MODE_NAMES[index]))) != 0) ++index;
+    return index;
+}
+
+void runEnergyEstimate(Print& out, const EnergySetup& setup)
+{
+    for (uint8_t index = 0; index < EnergyEstimator::modeCount(); ++index)
+    {
+        FirmwareMode mode = EnergyEstimator::mode(index);
+
+        EnergyMeter press = setup.capture ? EnergyEstimator::pressCapture(mode, setup.capture, setup.captureBytes, setup.currents)
+                                          : EnergyEstimator::press(mode, setup.currents);
+        uint32_t standby  = EnergyEstimator::standbyUa(mode, setup.currents);
+        DailyEnergy day   = dailyEnergy(press, standby, setup.pressesPerDay, setup.batteryMah);
+
+        out.print(F("ENERGY "));
+        out.print(reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&MODE_NAMES[index])));
+        out.print(F(" words="));
+        out.print(mode.words);
+        out.print(F(" press_ms="));
+        out.print(press.durationUs() / 1000);
+        out.print(F(" airtime_ms="));
+        out.print(AcceptanceSimulator::airtimeUs(mode.words) / 1000);
+        out.print(F(" press_uC="));
+        out.print(press.chargeUc());
+        out.print(F(" standby_uA="));
+        out.print(standby);
+        out.print(F(" day_mC="));
+        out.print(day.dayUc / 1000);
+        out.print(F(" avg_uA="));
+        out.print(day.averageUa);
+        out.print(F(" life_days="));
+        out.println(day.lifetimeDays);
+    }
+}
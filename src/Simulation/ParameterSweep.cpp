@@ -0,0 +1,177 @@
+#include "Simulation/ParameterSweep.h"
+#include <avr/wdt.h>
+#include "Config/Constants.h"
+#include "Storage/ProgramStore.h"
+#include "Storage/EepromWriter.h"
+
+static_assert(SWEEP_CHECKPOINT_ADDR >= PROGRAM_STORE_BASE_ADDR + PROGRAM_STORE_SLOTS * ProgramStore::SLOT_SIZE, "Sweep checkpoint overlaps the program slots");
+static_assert(SWEEP_CHECKPOINT_ADDR + SWEEP_CHECKPOINT_SLOTS * 5 <= E2END + 1, "Sweep checkpoints do not fit in EEPROM");
+
+namespace
+{
+    // ---------------------------------------------------------------------------------
+    //  Conformance: a partial block with repeated, negative and extreme values round-trips
+    // ---------------------------------------------------------------------------------
+    using TestBlock = SweepFormat::Block<4, 3>;
+
+    struct BufferSink
+    {
+        uint8_t bytes[SweepFormat::MAX_BLOCK_BYTES<4, 3>];
+        size_t  length;
+
+        constexpr size_t write(const uint8_t* data, size_t count)
+        {
+            for (size_t i = 0; i < count && length < sizeof(bytes); ++i) bytes[length++] = data[i];
+            return count;
+        }
+    };
+
+    constexpr bool roundTrips()
+    {
+        TestBlock block{ 2, 300, 3, 3, { { 60, -5, INT32_MIN }, { 60, 7, INT32_MAX }, { 70, 7, 0 }, { 0, 0, 0 } } };
+        BufferSink sink{};
+        SweepFormat::encode(block, sink);
+
+        TestBlock read{};
+        if (SweepFormat::decode(sink.bytes, sink.length, read) != sink.length) return false;
+        if (read.id != block.id || read.firstJob != block.firstJob || read.rows != block.rows || read.columns != block.columns) return false;
+        for (uint8_t row = 0; row < block.rows; ++row)
+            for (uint8_t column = 0; column < block.columns; ++column)
+                if (read.values[row][column] != block.values[row][column]) return false;
+
+        // Truncated: never a block
+        return SweepFormat::decode(sink.bytes, sink.length - 1, read) == 0;
+    }
+
+    static_assert(roundTrips(), "Sweep blocks must round-trip through SweepFormat");
+}
+
+SweepRunner::SweepRunner(Print& out):
+_out(out)
+{
+}
+
+uint16_t SweepRunner::jobCount(const SweepDefinition& sweep)
+{
+    uint16_t jobs = 1;
+    for (uint8_t axis = 0; axis < sweep.axisCount && axis < SWEEP_MAX_AXES; ++axis) jobs *= sweep.axisSize[axis];
+    return jobs;
+}
+
+/**
+ * @brief splitmix32-style mix of (id, job): neighbouring jobs get unrelated seeds, never 0
+ *        (xorshift generators stay at 0 forever).
+ */
+uint32_t SweepRunner::seedOf(uint8_t id, uint16_t job)
+{
+    uint32_t z = (static_cast<uint32_t>(id) << 16 | job) + 0x9E3779B9UL;
+    z = (z ^ (z >> 16)) * 0x85EBCA6BUL;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35UL;
+    z ^= z >> 16;
+    return z ? z : 1;
+}
+
+void SweepRunner::run(const SweepDefinition& sweep)
+{
+    uint16_t jobs = jobCount(sweep);
+    uint16_t first = resumeFrom(sweep, jobs);
+
+    _out.print(F("SWEEP "));
+    _out.print(sweep.id);
+    _out.print(F(" jobs="));
+    _out.print(jobs);
+    _out.print(F(" from="));
+    _out.print(first);
+    _out.print(F(" columns="));
+    _out.println(reinterpret_cast<const __FlashStringHelper*>(sweep.header));
+
+    Block block{};
+    block.id      = sweep.id;
+    block.columns = (sweep.columns < SWEEP_MAX_COLUMNS) ? sweep.columns : SWEEP_MAX_COLUMNS;
+
+    for (uint16_t job = first; job < jobs; ++job)
+    {
+        // Mixed radix: the last axis varies fastest
+        uint8_t index[SWEEP_MAX_AXES] = {};
+        uint16_t rest = job;
+        for (uint8_t axis = (sweep.axisCount < SWEEP_MAX_AXES ? sweep.axisCount : SWEEP_MAX_AXES); axis-- > 0; )
+        {
+            index[axis] = rest % sweep.axisSize[axis];
+            rest /= sweep.axisSize[axis];
+        }
+
+        if (block.rows == 0) block.firstJob = job;
+        sweep.job(index, seedOf(sweep.id, job), block.values[block.rows]);
+        wdt_reset();
+
+        if (++block.rows < SWEEP_BLOCK_ROWS && job + 1 < jobs) continue;
+
+        emit(block);
+        save(Checkpoint{ sweep.id, jobs, static_cast<uint16_t>(job + 1) });
+        block.rows = 0;
+        for (auto& row : block.values) for (int32_t& value : row) value = 0;
+    }
+
+    save(Checkpoint{ sweep.id, jobs, jobs });                  // Done: skipped until clear()
+    _out.print(F("SWEEP "));
+    _out.print(sweep.id);
+    _out.println(F(" done"));
+}
+
+/**
+ * @brief One "SWB <hex>" line, encoded straight onto the output (no byte buffer)
+ */
+void SweepRunner::emit(const Block& block) const
+{
+    struct HexSink
+    {
+        Print& out;
+
+        size_t write(const uint8_t* bytes, size_t length)
+        {
+            static const char DIGITS[] = "0123456789abcdef";
+            for (size_t i = 0; i < length; ++i)
+            {
+                out.print(DIGITS[bytes[i] >> 4]);
+                out.print(DIGITS[bytes[i] & 0x0F]);
+            }
+            return length;
+        }
+    };
+
+    HexSink sink{ _out };
+    _out.print(F("SWB "));
+    SweepFormat::encode(block, sink);
+    _out.println();
+}
+
+/**
+ * @brief Forgets the resume point of a sweep: its next run starts at job 0.
+ */
+void SweepRunner::clear(const SweepDefinition& sweep)
+{
+    save(Checkpoint{ 0xFF, 0xFFFF, 0xFFFF }, sweep.id);         // Erased EEPROM state
+}
+
+uint16_t SweepRunner::resumeFrom(const SweepDefinition& sweep, uint16_t jobs) const
+{
+    Checkpoint checkpoint;
+    EepromWriter::readBlock(&checkpoint, slotAddress(sweep.id), sizeof(checkpoint));
+    if (checkpoint.id != sweep.id || checkpoint.jobs != jobs || checkpoint.next > jobs) return 0;
+    return checkpoint.next;
+}
+
+void SweepRunner::save(const Checkpoint& checkpoint) const
+{
+    save(checkpoint, checkpoint.id);
+}
+
+void SweepRunner::save(const Checkpoint& checkpoint, uint8_t id)
+{
+    EepromWriter::writeBlockWaiting(slotAddress(id), &checkpoint, sizeof(checkpoint));
+}
+
+uint16_t SweepRunner::slotAddress(uint8_t id)
+{
+    return SWEEP_CHECKPOINT_ADDR + (id % SWEEP_CHECKPOINT_SLOTS) * sizeof(Checkpoint);
+}
@@ -0,0 +1,198 @@
+#include "Simulation/Sweeps.h"
+#include "Simulation/AcceptanceSimulator.h"
+#include "Debounce/CircularDebounceBuffer.h"
+#include "Delay/Timebase.h"
+#include "Config/Constants.h"
+
+namespace
+{
+    // ---------------------------------------------------------------------------------
+    //  Debounce: threshold x sample interval x bounce profile
+    // ---------------------------------------------------------------------------------
+    const uint8_t  THRESHOLDS[]   = { 60, 70, 80, 90 };
+    const uint16_t INTERVALS_US[] = { 250, 500, 1000, 2000 };
+    const uint16_t BOUNCES_US[]   = { 500, 3000, 10000 };     // Clean tactile switch, typical, worn contact
+
+    const char DEBOUNCE_HEADER[] PROGMEM = "threshold,interval_us,bounce_us,detected,extra,latency_us";
+
+    constexpr uint8_t  MAX_FLIPS       = 16;
+    constexpr uint32_t MIN_FLIP_GAP_US = 30;
+    constexpr uint32_t SETTLE_US       = 100000UL;             // Released and quiet between two presses
+
+    struct Rng
+    {
+        uint32_t state;
+
+        uint32_t next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        uint32_t between(uint32_t low, uint32_t high) { return low + next() % (high - low + 1); }
+    };
+
+    /// @brief One press: closes at 0 then chatters, opens at releaseUs then chatters (even flip counts)
+    struct Contact
+    {
+        uint32_t pressFlips[MAX_FLIPS];
+        uint8_t  pressCount;
+        uint32_t releaseUs;
+        uint32_t releaseFlips[MAX_FLIPS];
+        uint8_t  releaseCount;
+
+        bool closedAt(uint32_t t) const
+        {
+            if (t < releaseUs) return (flipsUntil(pressFlips, pressCount, t) & 1) == 0;
+            return (flipsUntil(releaseFlips, releaseCount, t) & 1) == 1;
+        }
+
+        static uint8_t flipsUntil(const uint32_t* flips, uint8_t count, uint32_t t)
+        {
+            uint8_t n = 0;
+            while (n < count && flips[n] <= t) ++n;
+            return n;
+        }
+
+        static uint8_t chatter(Rng& rng, uint32_t* flips, uint32_t fromUs, uint32_t bounceUs)
+        {
+            uint8_t count = 0;
+            uint32_t t = fromUs;
+            uint32_t maxGap = bounceUs / 4 > MIN_FLIP_GAP_US ? bounceUs / 4 : MIN_FLIP_GAP_US;
+            while (count < MAX_FLIPS)
+            {
+                t += rng.between(MIN_FLIP_GAP_US, maxGap);
+                if (t >= fromUs + bounceUs) break;
+                flips[count++] = t;
+            }
+            return count & ~1;                                  // Ends in the settled position
+        }
+    };
+
+    // The debouncer reads the contact through a SampleSource (plain function), so the press under
+    // test lives here, one per board (host sweeps run a job per thread)
+    PER_BOARD Contact  contact;
+    PER_BOARD uint32_t pressStartUs;
+    PER_BOARD uint8_t  callbacks;
+    PER_BOARD uint32_t firstCallbackUs;
+
+    bool contactSample(uint8_t)
+    {
+        uint32_t now = Timebase::nowUs();
+        return now >= pressStartUs && contact.closedAt(now - pressStartUs);
+    }
+
+    void onSimulatedPress()
+    {
+        if (callbacks++ == 0) firstCallbackUs = Timebase::nowUs() - pressStartUs;
+    }
+
+    void debounceJob(const uint8_t* axis, uint32_t seed, int32_t* row)
+    {
+        uint8_t  threshold  = THRESHOLDS[axis[0]];
+        uint16_t intervalUs = INTERVALS_US[axis[1]];
+        uint16_t bounceUs   = BOUNCES_US[axis[2]];
+
+        CircularDebounceBuffer debounce(0, 0, true, intervalUs);
+        debounce.setThreshold(threshold);
+        debounce.setSampleSource(contactSample);
+        debounce.addCallback(onSimulatedPress);
+
+        Rng rng{ seed };
+        int32_t  detected = 0;
+        int32_t  extra = 0;
+        uint32_t latencySum = 0;
+
+        for (uint8_t press = 0; press < SWEEP_DEBOUNCE_PRESSES; ++press)
+        {
+            contact.pressCount   = Contact::chatter(rng, contact.pressFlips, 0, bounceUs);
+            contact.releaseUs    = bounceUs + rng.between(50000UL, 250000UL);
+            contact.releaseCount = Contact::chatter(rng, contact.releaseFlips, contact.releaseUs, bounceUs);
+
+            pressStartUs = Timebase::nowUs();
+            callbacks = 0;
+            bool wasClosed = false;
+            uint32_t endUs = contact.releaseUs + bounceUs + SETTLE_US;
+
+            for (uint32_t t = 0; t < endUs; t += Timebase::TICK_US)
+            {
+                bool closed = contactSample(0);
+                if (closed && !wasClosed) debounce.startDebounce();         // The pin ISR: every closing edge
+                wasClosed = closed;
+                debounce.update();
+                Timebase::advance(1);
+            }
+
+            if (callbacks)
+            {
+                ++detected;
+                extra += callbacks - 1;
+                latencySum += firstCallbackUs;
+            }
+        }
+
+        row[0] = threshold;
+        row[1] = intervalUs;
+        row[2] = bounceUs;
+        row[3] = detected;
+        row[4] = extra;
+        row[5] = detected ? static_cast<int32_t>(latencySum / detected) : 0;
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Receiver acceptance: transmitter timing trim x receiver tolerance
+    // ---------------------------------------------------------------------------------
+    const int16_t TRIMS_PERMILLE[] = { -100, -50, 0, 50, 100 };
+    const uint8_t TOLERANCES_PCT[] = { 15, 20, 25, 30, 40 };
+
+    const char ACCEPTANCE_HEADER[] PROGMEM = "trim_permille,tolerance_pct,accept2_permille,accept4_permille";
+
+    void acceptanceJob(const uint8_t* axis, uint32_t seed, int32_t* row)
+    {
+        AcceptanceScenario scenario
+        {
+            { 50, TRIMS_PERMILLE[axis[0]], 0, 0 },
+            { TOLERANCES_PCT[axis[1]], RECEIVER_SYNC_MIN_US, RECEIVER_WORDS_REQUIRED, RECEIVER_WINDOW_WORDS }
+        };
+        AcceptanceResult result = AcceptanceSimulator::run(scenario, SWEEP_ACCEPTANCE_TRIALS, seed);
+
+        row[0] = scenario.channel.skewPermille;
+        row[1] = scenario.receiver.tolerancePct;
+        row[2] = static_cast<int32_t>(result.accepted[1]) * 1000 / result.trials;
+        row[3] = static_cast<int32_t>(result.accepted[AcceptanceResult::MAX_WORDS - 1]) * 1000 / result.trials;
+    }
+
+    template<typename T, size_t N>
+    constexpr uint8_t countOf(const T (&)[N]) { return static_cast<uint8_t>(N); }
+}
+
+const SweepDefinition DEBOUNCE_SWEEP =
+{
+    1, DEBOUNCE_HEADER,
+    3, { countOf(THRESHOLDS), countOf(INTERVALS_US), countOf(BOUNCES_US) },
+    6, debounceJob
+};
+
+const SweepDefinition ACCEPTANCE_SWEEP =
+{
+    2, ACCEPTANCE_HEADER,
+    2, { countOf(TRIMS_PERMILLE), countOf(TOLERANCES_PCT) },
+    4, acceptanceJob
+};
+
+void runParameterSweeps(Print& out)
+{
+    SweepRunner runner(out);
+
+    Timebase::suspend();                                        // Virtual time for the debouncer
+    runner.run(DEBOUNCE_SWEEP);
+    Timebase::resume(0);
+
+    runner.run(ACCEPTANCE_SWEEP);
+
+    // Whole list done: the next boot runs it again from the start
+    runner.clear(DEBOUNCE_SWEEP);
+    runner.clear(ACCEPTANCE_SWEEP);
+}
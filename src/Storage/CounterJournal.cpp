@@ -0,0 +1,87 @@
+#include "Storage/CounterJournal.h"
+#include <util/crc16.h>
+
+
+CounterJournal::CounterJournal(uint16_t baseAddress, uint8_t slots):
+_baseAddress(baseAddress),
+_slots(slots),
+_newestIndex(slots - 1),                            // So that the first commit on a blank ring lands in slot 0
+_counter(0)
+{
+}
+
+/**
+ * @brief Reads every slot and keeps the highest counter whose CRC matches.
+ *        Blank (0xFF) and torn slots fail the CRC and are skipped.
+ */
+void CounterJournal::begin()
+{
+    _counter = 0;
+    _newestIndex = _slots - 1;
+
+    for (uint8_t i = 0; i < _slots; ++i)
+    {
+        Slot slot;
+        EepromWriter::readBlock(&slot, slotAddress(i), SLOT_SIZE);
+
+        if (isValid(slot) && slot.counter >= _counter)
+        {
+            _counter = slot.counter;
+            _newestIndex = i;
+        }
+    }
+
+    LOG_PAIR_DEC("CounterJournal::begin() - Recovered counter", _counter);
+}
+
+uint32_t CounterJournal::current() const
+{
+    return _counter;
+}
+
+/**
+ * @brief Queues current()+1 for the slot after the newest one, ahead of every Normal write.
+ *        EepromWriter skips bytes that already hold the value, saving cycles and wear.
+ * @return The counter, safe to put on air once committed().
+ */
+uint32_t CounterJournal::commitNext()
+{
+    Slot slot;
+    slot.counter = _counter + 1;
+    slot.crc     = crc8(slot.counter);
+
+    uint8_t next = (_newestIndex + 1) % _slots;
+    EepromWriter::writeBlockWaiting(slotAddress(next), &slot, SLOT_SIZE, EepromWriter::Priority::Critical);
+
+    _newestIndex = next;
+    _counter     = slot.counter;
+    return _counter;
+}
+
+bool CounterJournal::committed() const
+{
+    return !EepromWriter::pending(slotAddress(_newestIndex), SLOT_SIZE);
+}
+
+uint16_t CounterJournal::slotAddress(uint8_t index) const
+{
+    return _baseAddress + static_cast<uint16_t>(index) * SLOT_SIZE;
+}
+
+/**
+ * @brief CRC-8/CCITT over the 4 counter bytes, seeded with 0x5A so an erased slot never validates.
+ */
+uint8_t CounterJournal::crc8(uint32_t counter)
+{
+    uint8_t crc = 0x5A;
+    for (uint8_t i = 0; i < sizeof(counter); ++i)
+    {
+        crc = _crc8_ccitt_update(crc, static_cast<uint8_t>(counter >> (8 * i)));
+    }
+    return crc;
+}
+
+bool CounterJournal::isValid(const Slot& slot)
+{
+    return slot.counter != 0xFFFFFFFF && slot.crc == crc8(slot.counter);
+}
@@ -0,0 +1,253 @@
+#include "Storage/EepromWriter.h"
+
+static_assert(EEPROM_QUEUE_SIZE > 0 && EEPROM_QUEUE_SIZE <= 127, "Queue indices are int8_t");
+
+namespace
+{
+    constexpr uint8_t CRITICAL         = 0x01;
+    constexpr uint8_t IN_FLIGHT        = 0x02;
+    constexpr uint8_t GENERATION_SHIFT = 2;
+    constexpr uint8_t GENERATION_MASK  = 0x3F;                  // 6 bits: far more than fences + 1 are ever live
+
+    static_assert(EEPROM_FENCE_SLOTS + 1 < GENERATION_MASK / 2, "Live generations must compare without ambiguity");
+
+    inline uint8_t generationOf(uint8_t flags) { return flags >> GENERATION_SHIFT; }
+}
+
+EepromWriter::Entry   EepromWriter::_queue[EEPROM_QUEUE_SIZE] = {};
+volatile uint8_t      EepromWriter::_count = 0;
+EepromWriter::Fence   EepromWriter::_fences[EEPROM_FENCE_SLOTS] = {};
+uint8_t               EepromWriter::_generation = 0;
+
+ISR(EE_READY_vect)
+{
+    EepromWriter::onReady();
+}
+
+/**
+ * @brief Queues one byte. Returns false when the queue is full (nothing queued); a byte already
+ *        queued for this address never needs a new entry.
+ */
+bool EepromWriter::write(uint16_t address, uint8_t value, Priority priority)
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    bool queued = find(address) >= 0 || _count < EEPROM_QUEUE_SIZE;
+    if (queued)
+    {
+        append(address, value, priority);
+        EECR |= (1 << EERIE);                                   // Fires at once if EEPROM is idle
+    }
+    SREG = sreg;
+    return queued;
+}
+
+bool EepromWriter::writeBlock(uint16_t address, const void* data, uint8_t length, Priority priority, Callback done)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    uint8_t sreg = SREG;
+    noInterrupts();
+
+    uint8_t needed = 0;
+    for (uint8_t i = 0; i < length; ++i) needed += (find(address + i) < 0) ? 1 : 0;
+
+    int8_t fence = -1;
+    for (uint8_t i = 0; done && i < EEPROM_FENCE_SLOTS && fence < 0; ++i) fence = _fences[i].done ? -1 : i;
+
+    bool queued = needed <= EEPROM_QUEUE_SIZE - _count && (!done || fence >= 0);
+    if (queued)
+    {
+        for (uint8_t i = 0; i < length; ++i) append(address + i, bytes[i], priority);
+        if (done)
+        {
+            _fences[fence] = { done, _generation };
+            _generation = (_generation + 1) & GENERATION_MASK;
+        }
+        EECR |= (1 << EERIE);
+    }
+    SREG = sreg;
+    return queued;
+}
+
+void EepromWriter::writeBlockWaiting(uint16_t address, const void* data, uint16_t length, Priority priority)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (uint16_t i = 0; i < length; ++i)
+    {
+        while (!write(address + i, bytes[i], priority)) {}      // The ISR frees an entry every ~3.4 ms
+    }
+}
+
+uint8_t EepromWriter::read(uint16_t address)
+{
+    uint8_t value;
+    readBlock(&value, address, 1);
+    return value;
+}
+
+/**
+ * @brief Newest queued value of each byte, EEPROM for the others. An EEPROM read waits until no
+ *        byte is being programmed, with interrupts on between two attempts.
+ */
+void EepromWriter::readBlock(void* data, uint16_t address, uint16_t length)
+{
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    for (uint16_t i = 0; i < length; ++i)
+    {
+        for (;;)
+        {
+            uint8_t sreg = SREG;
+            noInterrupts();
+
+            int8_t index = -1;
+            for (uint8_t e = 0; e < _count; ++e)
+            {
+                if (_queue[e].address == address + i) index = e;    // Later entries are newer (queued after the in-flight one)
+            }
+
+            bool done = true;
+            if (index >= 0)                 bytes[i] = _queue[index].value;
+            else if (!(EECR & (1 << EEPE)))
+            {
+                EEAR = address + i;
+                EECR |= (1 << EERE);
+                bytes[i] = EEDR;
+            }
+            else                            done = false;
+
+            SREG = sreg;
+            if (done) break;
+        }
+    }
+}
+
+bool EepromWriter::pending(uint16_t address, uint16_t length)
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    bool found = false;
+    for (uint8_t e = 0; e < _count && !found; ++e)
+    {
+        found = _queue[e].address >= address && _queue[e].address - address < length;
+    }
+    SREG = sreg;
+    return found;
+}
+
+uint8_t EepromWriter::queued()
+{
+    return _count;
+}
+
+/// @brief Interrupts must be on: the ISR does the draining
+void EepromWriter::flush()
+{
+    while (_count != 0) {}
+}
+
+/**
+ * @brief EEPROM is idle: retire the byte that was being programmed, then start the next one,
+ *        Critical first, in queue order. Bytes EEPROM already holds are retired without a write.
+ *        The interrupt is disabled once the queue is empty.
+ */
+void EepromWriter::onReady()
+{
+    for (uint8_t e = 0; e < _count; ++e)
+    {
+        if (_queue[e].flags & IN_FLIGHT)
+        {
+            remove(e);
+            break;
+        }
+    }
+
+    while (_count != 0)
+    {
+        uint8_t next = 0;
+        for (uint8_t e = 0; e < _count; ++e)
+        {
+            if (_queue[e].flags & CRITICAL)
+            {
+                next = e;
+                break;
+            }
+        }
+
+        EEAR = _queue[next].address;
+        EECR |= (1 << EERE);
+        if (EEDR == _queue[next].value)
+        {
+            remove(next);
+            continue;
+        }
+
+        EEDR = _queue[next].value;
+        EECR = (1 << EEMPE) | (1 << EERIE);                     // Erase + write (EEPM = 0), EEPE within 4 cycles
+        EECR |= (1 << EEPE);
+        _queue[next].flags |= IN_FLIGHT;
+        notify();
+        return;
+    }
+
+    EECR &= ~(1 << EERIE);
+    notify();
+}
+
+int8_t EepromWriter::find(uint16_t address)
+{
+    for (uint8_t e = 0; e < _count; ++e)
+    {
+        if (_queue[e].address == address && !(_queue[e].flags & IN_FLIGHT)) return static_cast<int8_t>(e);
+    }
+    return -1;
+}
+
+void EepromWriter::remove(uint8_t index)
+{
+    for (uint8_t e = index; e + 1 < _count; ++e) _queue[e] = _queue[e + 1];
+    _count = _count - 1;
+}
+
+/**
+ * @brief Interrupts off. Adds an entry, or replaces the queued entry of address: the new one keeps
+ *        its Critical flag and its generation (fences waiting for the old value wait for this one).
+ */
+void EepromWriter::append(uint16_t address, uint8_t value, Priority priority)
+{
+    uint8_t flags = (_generation << GENERATION_SHIFT) | (priority == Priority::Critical ? CRITICAL : 0);
+
+    int8_t existing = find(address);
+    if (existing >= 0)
+    {
+        flags = _queue[existing].flags | (flags & CRITICAL);
+        remove(static_cast<uint8_t>(existing));
+    }
+    _queue[_count] = { address, value, flags };
+    _count = _count + 1;
+}
+
+/// @brief Interrupts off. Calls the fences that no longer have an entry of their generation or older
+void EepromWriter::notify()
+{
+    for (Fence& fence : _fences)
+    {
+        if (!fence.done) continue;
+
+        bool waiting = false;                                   // The byte being programmed is not in EEPROM yet either
+        for (uint8_t e = 0; e < _count && !waiting; ++e)
+        {
+            waiting = olderOrSame(generationOf(_queue[e].flags), fence.generation);
+        }
+        if (waiting) continue;
+
+        Callback done = fence.done;
+        fence.done = nullptr;
+        done();
+    }
+}
+
+bool EepromWriter::olderOrSame(uint8_t generation, uint8_t fence)
+{
+    return ((fence - generation) & GENERATION_MASK) < (GENERATION_MASK + 1) / 2;
+}
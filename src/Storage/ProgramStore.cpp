@@ -0,0 +1,131 @@
+#include "Storage/ProgramStore.h"
+#include "Policies/RAMStoragePolicy.h"
+#include <util/crc16.h>
+
+
+static const uint8_t ERASED = 0xFF;
+
+static_assert(PROGRAM_STORE_BASE_ADDR + PROGRAM_STORE_SLOTS * ProgramStore::SLOT_SIZE <= E2END + 1, "Program slots do not fit in EEPROM");
+
+ProgramStore::ProgramStore():
+_cache{},
+_length{}
+{
+}
+
+/**
+ * @brief Rebuilds the RAM cache from EEPROM.
+ */
+void ProgramStore::begin()
+{
+    for (uint8_t slot = 0; slot < PROGRAM_STORE_SLOTS; ++slot)
+    {
+        loadSlot(slot);
+        LOG_PAIR_DEC("ProgramStore::begin() - Slot", slot);
+        LOG_PAIR_DEC("ProgramStore::begin() - Loaded bytes", _length[slot]);
+    }
+}
+
+/**
+ * @brief Reads one slot into its cache line. It is only served if its CRC and validate() both pass.
+ */
+void ProgramStore::loadSlot(uint8_t slot)
+{
+    _length[slot] = 0;
+
+    uint8_t header[HEADER_SIZE];
+    EepromWriter::readBlock(header, slotAddress(slot), HEADER_SIZE);
+
+    uint8_t length = header[0];
+    uint16_t crc = static_cast<uint16_t>(header[1] | (header[2] << 8));
+    if (length == 0 || length > PROGRAM_STORE_SLOT_BYTES) return;                      // Blank (0xFF) or erased
+
+    EepromWriter::readBlock(_cache[slot], slotAddress(slot) + HEADER_SIZE, length);
+
+    if (crc16(_cache[slot], length) == crc &&
+        Waveform::validate<RAMStoragePolicy>(_cache[slot], length) == Waveform::Verdict::Ok)
+    {
+        _length[slot] = length;
+    }
+}
+
+uint8_t* ProgramStore::beginUpload(uint8_t slot)
+{
+    if (slot >= PROGRAM_STORE_SLOTS) return nullptr;
+
+    _length[slot] = 0;                                                                  // Out of service while it is overwritten
+    return _cache[slot];
+}
+
+void ProgramStore::cancelUpload(uint8_t slot)
+{
+    if (slot < PROGRAM_STORE_SLOTS) loadSlot(slot);
+}
+
+/**
+ * @brief Checks the uploaded program and persists it. Nothing is written unless it is playable.
+ *        The invalidation is flushed before the program is queued (a queued write of the header
+ *        would coalesce with it and land last), then EepromWriter keeps the program before the
+ *        header. A program is larger than the queue: this waits for room, ~3.3 ms per changed
+ *        byte, and runs from the console, not from a transmit path.
+ */
+Waveform::Verdict ProgramStore::commit(uint8_t slot, uint8_t length, uint16_t crc)
+{
+    if (slot >= PROGRAM_STORE_SLOTS) return Waveform::Verdict::Malformed;
+
+    Waveform::Verdict verdict = Waveform::Verdict::Malformed;
+    if (length > 0 && length <= PROGRAM_STORE_SLOT_BYTES && crc16(_cache[slot], length) == crc)
+    {
+        verdict = Waveform::validate<RAMStoragePolicy>(_cache[slot], length);
+    }
+
+    if (verdict != Waveform::Verdict::Ok)
+    {
+        loadSlot(slot);                                                                 // Back to the previous program
+        return verdict;
+    }
+
+    uint8_t header[HEADER_SIZE] = { length, static_cast<uint8_t>(crc), static_cast<uint8_t>(crc >> 8) };
+    EepromWriter::writeBlockWaiting(slotAddress(slot), &ERASED, 1);                     // Invalidate first: a torn write leaves an empty slot
+    EepromWriter::flush();
+    EepromWriter::writeBlockWaiting(slotAddress(slot) + HEADER_SIZE, _cache[slot], length);
+    EepromWriter::writeBlockWaiting(slotAddress(slot), header, HEADER_SIZE);
+
+    _length[slot] = length;
+    return verdict;
+}
+
+void ProgramStore::erase(uint8_t slot)
+{
+    if (slot >= PROGRAM_STORE_SLOTS) return;
+
+    _length[slot] = 0;
+    EepromWriter::writeBlockWaiting(slotAddress(slot), &ERASED, 1);
+}
+
+bool ProgramStore::isLoaded(uint8_t slot) const
+{
+    return slot < PROGRAM_STORE_SLOTS && _length[slot] != 0;
+}
+
+const uint8_t* ProgramStore::program(uint8_t slot) const
+{
+    return _cache[slot];
+}
+
+uint8_t ProgramStore::length(uint8_t slot) const
+{
+    return (slot < PROGRAM_STORE_SLOTS) ? _length[slot] : 0;
+}
+
+uint16_t ProgramStore::crc16(const uint8_t* data, uint8_t length)
+{
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < length; ++i) crc = _crc_ccitt_update(crc, data[i]);
+    return crc;
+}
+
+uint16_t ProgramStore::slotAddress(uint8_t slot) const
+{
+    return PROGRAM_STORE_BASE_ADDR + static_cast<uint16_t>(slot) * SLOT_SIZE;
+}
@@ -1,4 +1,5 @@
 #include "Transciever/CC1101_Transceiver.h"
+#include "Delay/Timebase.h"
 
 
 /**
@@ -27,6 +28,7 @@ bool Transceiver::begin()
    #endif 
     
     // Step1: Initialize the SPI
+    _txPrepared = false;
     _spi.begin();
 
     #ifdef LOG_VERBOSE  
@@ -66,20 +68,21 @@ bool Transceiver::begin()
     bool success = false;
     avr_algorithms::repeat_withExitCondition(3,[&](){
         // PARTNUM == 0x00, it indicates the CC1101 is powered, connected, and responsive to SPI
-        if (readRegister(CC1101::Address::PARTNUM).value != 0x00)
+        // (status registers: a plain read of PARTNUM / VERSION would be the SRES / SFSTXON strobe)
+        if (_spi.readStatusRegister(CC1101::Address::PARTNUM).value != 0x00)
         {
-            LOG_NEW_LINE("------ SPI communication Error   ------");
-            LOG_NEW_LINE(" Error: apply configuration of CC1101 failed in Transceiver::begin() ");
-            LOG_NEW_LINE(" Fail to read PARTNUM ");
+            LOG_ERROR("------ SPI communication Error   ------");
+            LOG_ERROR(" Error: apply configuration of CC1101 failed in Transceiver::begin() ");
+            LOG_ERROR(" Fail to read PARTNUM ");
             return true;    // Retry
         }
   
          // VERSION register at 0x30 address after reset should read 0x14 HEX  
-        if (readRegister(CC1101::Address::VERSION).value != 0x14)
+        if (_spi.readStatusRegister(CC1101::Address::VERSION).value != 0x14)
         {
-            LOG_NEW_LINE("------ SPI communication Error   ------");
-            LOG_NEW_LINE(" Error: apply configuration of CC1101 failed in Transceiver::begin() ");
-            LOG_NEW_LINE("Fail to read VERSION");
+            LOG_ERROR("------ SPI communication Error   ------");
+            LOG_ERROR(" Error: apply configuration of CC1101 failed in Transceiver::begin() ");
+            LOG_ERROR("Fail to read VERSION");
             return true;    // Retry
         }     
         
@@ -89,7 +92,7 @@ bool Transceiver::begin()
 
    if (!success)
    {
-        LOG_NEW_LINE("Error: CC1101 initialization failed");
+        LOG_ERROR("Error: CC1101 initialization failed");
         return false;
    }   
 
@@ -105,7 +108,7 @@ bool Transceiver::begin()
  ///    - Checks MARCSTATE (0x01 = IDLE) before STX.
 ///     - Issues SIDLE if not in IDLE.
 ///     - Sends STX via strobeCommand.
-///     - Verifies MARCSTATE = 0x13 (TX) after STX.
+///     - Waits for MARCSTATE = 0x13 (TX) after STX, the calibration included.
 ///     - Logs errors for debugging.
  void Transceiver::enableTransmitMode()
 {
@@ -113,19 +116,19 @@ bool Transceiver::begin()
     bool success = false;
     String error = "Transceiver::enableTransmitMode(): TX mode Active Successfully...";
 
-    // Check if already in IDLE
-    if (readRegister(CC1101::Address::MARCSTATE).value != 0x01) {
+    // Check if already in IDLE (status-register access: a plain read of MARCSTATE is the STX strobe)
+    if (readMarcState() != 0x01) {
       avr_algorithms::repeat_withExitCondition(3, [&]() {
             if (!strobeCommand(Strobe::SIDLE)) {
                 error = "Error: Failed to enter IDLE mode";
                 return true; // Retry
             }
-            delayMicroseconds(10); // Wait for transition
+            Timebase::delayUs(10); // Wait for transition
             success = true;
             return false; // Exit repeat
         });
         if (!success) {
-            LOG_DYNAMIC(error);
+            LOG_ERROR_DYNAMIC(error);
             return;
         }
     }
@@ -137,7 +140,7 @@ bool Transceiver::begin()
             error = "Error: Failed to enter TX mode";
             return true; // Retry
         }
-        if (readRegister(CC1101::Address::MARCSTATE).value != 0x13) {
+        if (!awaitMarcState(0x13)) {                                // From IDLE the chip calibrates first (MCSM0 FS_AUTOCAL, 809 us)
             error = "Error: Failed to confirm TX mode (MARCSTATE != 0x13)";
             return true; // Retry
         }
@@ -145,10 +148,95 @@ bool Transceiver::begin()
         return false; // Exit repeat
     });
 
-    LOG_DYNAMIC(error);
+    LOG_ERROR_DYNAMIC(error);
     LOG("\n\n");
 }
 
+/// @brief Puts the radio in TX for a batch of frames (see streamFrame()).
+///        After prepareTxSession() this is a single STX from FSTXON (no calibration, no read-back delays);
+///        the full entry is used if the radio left FSTXON meanwhile or does not confirm TX.
+/// @return true if the chip is responsive
+bool Transceiver::openTxSession()
+{
+    if (_txPrepared)
+    {
+        _txPrepared = false;
+        if (readMarcState() == 0x12)                                // Still FSTXON
+        {
+            strobeFast(CC1101::Strobes::Command::STX);
+            for (uint8_t poll = 0; poll < TX_ENTRY_POLLS; ++poll)
+            {
+                if (readMarcState() == 0x13) return true;
+            }
+        }
+        LOG_ERROR("Transceiver::openTxSession(): prepared TX entry lost, full entry");
+    }
+
+    enableTransmitMode();
+    return true;
+}
+
+/// @brief Returns the radio to IDLE at the end of a batch.
+/// @return true if the SIDLE strobe was accepted
+bool Transceiver::closeTxSession()
+{
+    if (!strobeCommand(CC1101::Strobes::Command::SIDLE)) { 
+        LOG_ERROR("Error: Failed to return to IDLE mode");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Speculative half of openTxSession(), run while a press is still being debounced: IDLE -> FSTXON,
+ *        the synthesizer starts and calibrates (MCSM0 auto-calibration) but no carrier is sent.
+ *        Only the status-register access and raw strobes are used, so it costs the calibration time and
+ *        a few SPI transfers, not the read-back delays of strobeCommand() / readRegister().
+ * @return true once MARCSTATE reads FSTXON; false (radio back to IDLE) if it was not IDLE or timed out
+ */
+bool Transceiver::prepareTxSession()
+{
+    if (_txPrepared) return true;
+    if (readMarcState() != 0x01) return false;                      // Not IDLE (sleeping, RX, packet link...): keep the full entry
+
+    strobeFast(CC1101::Strobes::Command::SFSTXON);
+    if (awaitMarcState(0x12))
+    {
+        _txPrepared = true;
+        return true;
+    }
+
+    strobeFast(CC1101::Strobes::Command::SIDLE);
+    LOG_ERROR("Transceiver::prepareTxSession(): FSTXON not reached");
+    return false;
+}
+
+/// @brief Polls MARCSTATE until it reads `state`, for up to TX_PREPARE_TIMEOUT_US (an IDLE -> FSTXON / TX
+///        transition calibrates first, 809 us typ.)
+/// @return true once MARCSTATE reads `state`, false on timeout
+bool Transceiver::awaitMarcState(uint8_t state)
+{
+    uint32_t start = Timebase::preciseUs();
+    while (Timebase::preciseUs() - start < TX_PREPARE_TIMEOUT_US)
+    {
+        if (readMarcState() == state) return true;
+    }
+    return false;
+}
+
+/// @brief Drops a prepared session (press rejected): the synthesizer draws ~8 mA in FSTXON.
+void Transceiver::cancelTxSession()
+{
+    if (!_txPrepared) return;
+    _txPrepared = false;
+    strobeFast(CC1101::Strobes::Command::SIDLE);
+}
+
+bool Transceiver::txPrepared() const
+{
+    return _txPrepared;
+}
+
 /**
  * @brief  Implement the Manual Power-on reset via Spi to ensure the Chip is in a Know state(IDLE) before configuration
  *   This method execute the Following sequence as specify on the datasheet
@@ -187,7 +275,7 @@ void Transceiver::reset()
         unsigned long start = millis();
         while (digitalRead(MISO) == HIGH) {
             if (millis() - start > 100) {
-                LOG_NEW_LINE("Timeout waiting for MISO LOW before SRES");
+                LOG_ERROR("Timeout waiting for MISO LOW before SRES");
                 break;
             }
         }
@@ -201,7 +289,7 @@ void Transceiver::reset()
         start = millis();
         while (digitalRead(MISO) == HIGH) {
             if (millis() - start > 100) {
-                LOG_NEW_LINE("Timeout waiting for MISO LOW after SRES");
+                LOG_ERROR("Timeout waiting for MISO LOW after SRES");
                 break;
             }
         }
@@ -219,7 +307,7 @@ void Transceiver::reset()
         }
     }
 
-    LOG_NEW_LINE("Error: CC1101 reset failed after 3 attempts");
+    LOG_ERROR("Error: CC1101 reset failed after 3 attempts");
     */
 
     // The following code is a more robust implementation using the SPIBus class for better abstraction and error handling.
@@ -240,51 +328,43 @@ void Transceiver::reset()
 
         // Step1: Pull CSn LOW for at least 10 µs
         _spi.selectDevice();
-        delayMicroseconds(10);
+        Timebase::delayUs(10);
 
         // Step2: Pull CSn HIGH for at least 40 µs
         _spi.deselectDevice();
-        delayMicroseconds(40);
+        Timebase::delayUs(40);
 
         // Step3: Pull CSn LOW again to start SPI transaction
         _spi.selectDevice();
 
-        // Step4: Wait for MISO to go low (indicating chip is ready)
-        unsigned long start = millis();
-        // Polling MISO until it goes LOW or timeout after 100 ms
-        while (digitalRead(MISO) == HIGH) {
-            if (millis() - start > 100) {
-                LOG_NEW_LINE("Timeout waiting for MISO LOW before SRES");
-                break; // Exit loop on timeout
-            }
+        // Step4: Wait for MISO to go low (indicating chip is ready), timeout after 100 ms
+        if (!_spi.awaitChipReady(RESET_MISO_TIMEOUT_US)) {
+            LOG_ERROR("Timeout waiting for MISO LOW before SRES");
         }
 
         // Step5: Send SRES command (0x30)
         if (!strobeCommand(CC1101::Strobes::Command::SRES)) {
-            LOG_NEW_LINE("Error: Failed to send SRES command");
+            LOG_ERROR("Error: Failed to send SRES command");
             return true; // Retry
         }
 
         // Step6: Wait for MISO to go low again (indicating reset finished)
-        start = millis();
-        while (digitalRead(MISO) == HIGH) {
-            if (millis() - start > 100) {
-                LOG_NEW_LINE("Timeout waiting for MISO LOW after SRES");
-                break; // Exit loop on timeout
-            }
+        if (!_spi.awaitChipReady(RESET_MISO_TIMEOUT_US)) {
+            LOG_ERROR("Timeout waiting for MISO LOW after SRES");
         }
         // Step7: Wait for the chip to stabilize (typically 10 ms)
-        delay(10);
+        Timebase::delayMs(10);
 
         // Step8: Verify PARTNUM register
         if (verifyChipId()) {
             LOG_NEW_LINE("CC1101 reset successful");
             return false; // Exit on success
         }
+        return true; // Retry
     }
     );
 
-    LOG_NEW_LINE("Error: CC1101 reset failed after 3 attempts");
+    LOG_ERROR("Error: CC1101 reset failed after 3 attempts");
     LOG("\n\n");
 }
 
@@ -293,7 +373,7 @@ void Transceiver::reset()
 /// @return True if PARTNUM is 0x00  
 bool Transceiver::verifyChipId()
 {
-    if(ReadResult result = _spi.readRegister(0x30); result.value == 0x00) return true;
+    if(ReadResult result = _spi.readStatusRegister(CC1101::Address::PARTNUM); result.value == 0x00) return true;
     else return false;
 }
 
@@ -359,7 +439,7 @@ bool Transceiver::readBackPATABLE(uint8_t* paTable)
     // Step 1: Sanity check for address
     if(CC1101::Address::PATABLE > bitFlags::AddressMask)
     {
-        LOG_NEW_LINE("Error: Invalid PATABLE address");
+        LOG_ERROR("Error: Invalid PATABLE address");
         return false;
     }
 
@@ -374,7 +454,7 @@ bool Transceiver::readBackPATABLE(uint8_t* paTable)
       });
         return success;
     }else{
-        LOG("Error: Failed to read PATABLE via burst read\n\n");
+        LOG_ERROR("Error: Failed to read PATABLE via burst read\n");
         return false;
     }
 }
@@ -401,7 +481,7 @@ void Transceiver::configurePATable(uint8_t powerLevelIndex)
 {
     // Step1: Validate index
     if (powerLevelIndex > 7) {
-        LOG_NEW_LINE("Error: Invalid PATABLE index");
+        LOG_ERROR("Error: Invalid PATABLE index");
         return;
     }
 
@@ -412,7 +492,7 @@ void Transceiver::configurePATable(uint8_t powerLevelIndex)
     uint8_t frend0 = readRegister(CC1101::Address::FREND0).value;          // Reads the current value of the FREND0 register (address 0x22) and clears its PA_POWER bits (bits 2:0) while preserving other bits.
     frend0 &= ~0x07;                                                                            // Clear PA_POWER bits (bits 2:0)                                                                                  
     frend0 |= (powerLevelIndex & 0x07);                                                 // Sets the PA_POWER bits (2:0) in frend0 to the desired PATABLE index (powerLevelIndex), ensuring it’s within 0–7.   
-    writeRegister(CC1101::Value::FREND0, frend0);                                            // Writes the updated frend0 value back to the FREND0 register.  
+    writeRegister(CC1101::Address::FREND0, frend0);                                          // Writes the updated frend0 value back to the FREND0 register.  
     
 }
 
@@ -430,8 +510,8 @@ bool Transceiver::strobeCommand(CC1101::Strobes::Command command)
             _spi.transferByte(static_cast<uint8_t>(command));
         });
 
-        // Step 2: Check if the chip is responsive (PARTNUM == 0x00)
-        auto partnum = readRegister(CC1101::Address::PARTNUM).value;
+        // Step 2: Check if the chip is responsive (PARTNUM == 0x00, status access: a plain read would be SRES)
+        auto partnum = _spi.readStatusRegister(CC1101::Address::PARTNUM).value;
         if (partnum == 0x00) {
             success = true;
             LOG_DYNAMIC("Strobe Command " + String(avr_algorithms::toString(command)) + 
@@ -442,17 +522,24 @@ bool Transceiver::strobeCommand(CC1101::Strobes::Command command)
             String errorMsg = "CC1101 unresponsive after strobe command: " + String(avr_algorithms::toString(command)) + 
                             " (0x" + String(static_cast<uint8_t>(command), HEX) + 
                             "), PARTNUM: " + String(partnum, HEX);
-            LOG_DYNAMIC(errorMsg);
+            LOG_ERROR_DYNAMIC(errorMsg);
             return true; // Retry
         }
     });
 
     if (!success) {
-        LOG_NEW_LINE("Error: CC1101 unresponsive after strobe.");
+        LOG_ERROR("Error: CC1101 unresponsive after strobe.");
     }
     return success;
 }
 
+void Transceiver::strobeFast(CC1101::Strobes::Command command)
+{
+    _spi.applyTransaction([&]() {
+        _spi.transferByte(static_cast<uint8_t>(command));
+    });
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ------------------------------------- Implemented method from ITransceiver ---------------------------------------------------------
@@ -471,7 +558,7 @@ void Transceiver::setFrequency(uint32_t frequencyHz)
 {
     // Step1 : Frequency Validation
     if (frequencyHz < 300000000 || frequencyHz > 928000000) {
-        LOG_NEW_LINE("Error: Frequency out of CC1101 range (300–928 MHz)");
+        LOG_ERROR("Error: Frequency out of CC1101 range (300–928 MHz)");
         return;
     }
 
@@ -512,4 +599,164 @@ StatusInfo Transceiver::decodeStatus(ReadResult readResult)
     statusInfo.chipState =(readResult.status >> 4) & bitFlags::ChipState;           // shift first: status >> 4 (moves CHIP_STATE into bits 3–0). Then mask with 0x0F to get just those 4 bits cleanly.
 
     return statusInfo;
-}
\ No newline at end of file
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ------------------------------------- Packet-mode command link --------------------------------------------------------------------------
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief MARCSTATE is a status register, so it must be read with the burst bit (see SPIBus::readStatusRegister)
+/// @return Main radio control state (0x01 IDLE, 0x0D RX, 0x13 TX, 0x11 RXFIFO_OVERFLOW, 0x16 TXFIFO_UNDERFLOW)
+uint8_t Transceiver::readMarcState()
+{
+    return _spi.readStatusRegister(CC1101::Address::MARCSTATE).value & 0x1F;
+}
+
+/// @brief Switches the radio to FIFO packet mode: only the registers that differ from the async OOK table are written.
+/// @note  GDO0 stays High-Z (IOCFG0 = 0x2E) so it never fights the MCU pin that drives it in async mode;
+///        packet progress is polled through MARCSTATE / TXBYTES / RXBYTES instead.
+/// @return true if every register was written and verified
+bool Transceiver::beginPacketLink()
+{
+    strobeCommand(CC1101::Strobes::Command::SIDLE);
+    return applyRegisterDeltas(Config_315MHz_Packet::enter_Regs);
+}
+
+/// @brief Leaves packet mode and restores the async OOK registers so transmitFrame() works again.
+void Transceiver::endPacketLink()
+{
+    strobeCommand(CC1101::Strobes::Command::SIDLE);
+    strobeCommand(CC1101::Strobes::Command::SFRX);
+    strobeCommand(CC1101::Strobes::Command::SFTX);
+    applyRegisterDeltas(Config_315MHz_Packet::leave_Regs);
+}
+
+/// @brief Sends one variable-length packet through the TX FIFO.
+///     - Step1: IDLE + flush TX FIFO
+///     - Step2: Write [length | payload] in one burst (CRC and whitening are added by the chip)
+///     - Step3: STX and wait until the FIFO has drained and the radio left TX (MCSM1 puts it in RX for the ACK)
+/// @param payload - Bytes after the length byte (the first one is the destination address)
+/// @param length - Payload length (1 to PACKET_LINK_MAX_PAYLOAD)
+/// @return true if the packet left the FIFO before the airtime timeout
+bool Transceiver::sendPacket(const uint8_t *payload, uint8_t length)
+{
+    using Strobe = CC1101::Strobes::Command;
+
+    if (!payload || length == 0 || length > PACKET_LINK_MAX_PAYLOAD)
+    {
+        LOG_ERROR("Transceiver::sendPacket Error: Invalid payload");
+        return false;
+    }
+
+    // Step1: Known state with an empty TX FIFO
+    strobeCommand(Strobe::SIDLE);
+    strobeCommand(Strobe::SFTX);
+
+    // Step2: Length byte followed by the payload, written in a single burst
+    uint8_t frame[PACKET_LINK_MAX_PAYLOAD + 1];
+    frame[0] = length;
+    memcpy(frame + 1, payload, length);
+    if (!writeBurstRegister(CC1101::Address::FIFO, frame, length + 1))
+    {
+        LOG_ERROR("Transceiver::sendPacket Error: Failed to load TX FIFO");
+        return false;
+    }
+
+    // Step3: Transmit and wait for the end of packet (2x the nominal airtime as timeout)
+    strobeCommand(Strobe::STX);
+    uint32_t start = Timebase::ticks();
+    uint32_t timeoutTicks = Timebase::msToTicks(2 * packetAirtimeUs(length) / 1000 + 1);
+    while (readMarcState() == 0x13 || (_spi.readStatusRegister(CC1101::Address::TXBYTES).value & 0x7F) != 0)
+    {
+        if (Timebase::ticks() - start > timeoutTicks)
+        {
+            LOG_ERROR("Transceiver::sendPacket Error: TX did not complete");
+            strobeCommand(Strobe::SIDLE);
+            strobeCommand(Strobe::SFTX);
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief Waits in RX for a packet that passed the hardware CRC and address filter.
+/// @note  CRC_AUTOFLUSH drops bad packets in the chip, and APPEND_STATUS adds RSSI + (CRC_OK | LQI) after the payload.
+/// @param buffer - Destination for the payload (without length and status bytes)
+/// @param maxLength - Capacity of buffer
+/// @param timeoutMs - How long to listen
+/// @return Payload length, 0 on timeout or invalid packet
+uint8_t Transceiver::receivePacket(uint8_t *buffer, uint8_t maxLength, uint16_t timeoutMs)
+{
+    using Strobe = CC1101::Strobes::Command;
+
+    if (readMarcState() != 0x0D) strobeCommand(Strobe::SRX);
+
+    uint32_t start = Timebase::ticks();
+    uint32_t timeoutTicks = Timebase::msToTicks(timeoutMs);
+    while ((_spi.readStatusRegister(CC1101::Address::RXBYTES).value & 0x7F) == 0)
+    {
+        if (Timebase::ticks() - start > timeoutTicks) return 0;
+    }
+
+    // Wait for the whole packet: the radio leaves RX (RXOFF_MODE = IDLE) once the status bytes are in the FIFO
+    while (readMarcState() == 0x0D)
+    {
+        if (Timebase::ticks() - start > timeoutTicks) return 0;
+    }
+
+    uint8_t length = 0;
+    _spi.readFifo(&length, 1);
+    if (length == 0 || length > maxLength)
+    {
+        strobeCommand(Strobe::SIDLE);
+        strobeCommand(Strobe::SFRX);
+        return 0;
+    }
+
+    uint8_t status[2];
+    _spi.readFifo(buffer, length);
+    _spi.readFifo(status, sizeof(status));
+
+    // status[1] bit7 = CRC_OK
+    return (status[1] & 0x80) ? length : 0;
+}
+
+/// @brief Sends a command over the packet link and only retransmits if the ACK is missing.
+///     - The same sequence number is used for every retransmission so the receiver can drop duplicates.
+///     - Backoff doubles on every attempt with a random jitter so two fobs don't keep colliding.
+/// @param command - One of PacketCommand
+/// @param destination - Receiver address
+/// @return true if the receiver acknowledged the command
+bool Transceiver::transmitCommand(uint8_t command, uint8_t destination)
+{
+    using Strobe = CC1101::Strobes::Command;
+
+    CommandPacket packet { destination, PACKET_LINK_FOB_ADDRESS, ++_packetSequence, command };
+    bool acked = false;
+    uint8_t attempt = 0;
+
+    avr_algorithms::repeat_withExitCondition(PACKET_LINK_MAX_ATTEMPTS, [&]() {
+        if (sendPacket(reinterpret_cast<const uint8_t*>(&packet), sizeof(packet)))
+        {
+            CommandPacket ack;
+            if (receivePacket(reinterpret_cast<uint8_t*>(&ack), sizeof(ack), PACKET_LINK_ACK_TIMEOUT_MS) == sizeof(ack) &&
+                ack.source == destination &&
+                ack.sequence == packet.sequence &&
+                ack.command == (command | PACKET_LINK_ACK_FLAG))
+            {
+                acked = true;
+                return false;                   // Exit repeat
+            }
+        }
+
+        LOG_PAIR_DEC("Transceiver::transmitCommand - No ACK, attempt", attempt + 1);
+        strobeCommand(Strobe::SIDLE);
+        strobeCommand(Strobe::SFRX);
+        Timebase::delayMs((PACKET_LINK_BACKOFF_BASE_MS << attempt) + random(PACKET_LINK_BACKOFF_BASE_MS + 1));
+        attempt++;
+        return true;                            // Retry
+    });
+
+    strobeCommand(Strobe::SIDLE);
+    return acked;
+}
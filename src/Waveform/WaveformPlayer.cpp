@@ -0,0 +1,71 @@
+#include "Waveform/WaveformPlayer.h"
+
+static constexpr uint8_t  TICKS_PER_US   = 2;                  // 16 MHz / 8
+static constexpr uint16_t MAX_WAIT_TICKS = 0x7FFF;             // Signed compare against TCNT1 stays valid
+
+WaveformPlayer::WaveformPlayer(DigitalPin& pinPort_GDO0):
+_GDO0_pin(pinPort_GDO0),
+_worstEdgeCostTicks(0)
+{
+}
+
+void WaveformPlayer::play(const uint8_t* program, uint8_t length)
+{
+    run<PROGMEMStoragePolicy>(program, length);
+}
+
+void WaveformPlayer::playCached(const uint8_t* program, uint8_t length)
+{
+    run<RAMStoragePolicy>(program, length);
+}
+
+template<typename StoragePolicy>
+void WaveformPlayer::run(const uint8_t* program, uint8_t length)
+{
+    Waveform::Interpreter<StoragePolicy, false> interpreter(program, length);
+
+    uint8_t savedTCCR1A = TCCR1A;
+    uint8_t savedTCCR1B = TCCR1B;
+    TCCR1A = 0;                                                 // Normal mode, free running
+    TCCR1B = (1 << CS11);                                       // clk/8
+    Timebase::suspend();                                        // No periodic ISR between two edges
+
+    Waveform::Edge edge{0, 0};
+    bool running = interpreter.next(edge);
+    uint16_t deadline = TCNT1;
+    uint32_t elapsedUs = 0;
+
+    while (running)
+    {
+        _GDO0_pin.writePin(edge.level);
+        uint32_t remaining = edge.durationUs * TICKS_PER_US;
+        elapsedUs += edge.durationUs;
+
+        // Decode the next edge while this one is on air
+        uint16_t start = TCNT1;
+        running = interpreter.next(edge);
+        uint16_t cost = TCNT1 - start;
+        if (cost > _worstEdgeCostTicks) _worstEdgeCostTicks = cost;
+
+        if (Timebase::isVirtual()) continue;                    // Trace replay: resume() accounts the edge, no wall time
+
+        while (remaining > 0)
+        {
+            uint16_t chunk = (remaining > MAX_WAIT_TICKS) ? MAX_WAIT_TICKS : static_cast<uint16_t>(remaining);
+            deadline += chunk;
+            while (static_cast<int16_t>(TCNT1 - deadline) < 0) {}
+            remaining -= chunk;
+        }
+    }
+
+    _GDO0_pin.writePin(interpreter.idleLevel());
+    Timebase::resume(elapsedUs);
+
+    TCCR1A = savedTCCR1A;
+    TCCR1B = savedTCCR1B;
+}
+
+uint16_t WaveformPlayer::worstEdgeCostTicks() const
+{
+    return _worstEdgeCostTicks;
+}
@@ -0,0 +1,117 @@
+#include "Waveform/WaveformStreamer.h"
+
+static constexpr uint8_t  TICKS_PER_US      = 2;                // 16 MHz / 8
+static constexpr uint16_t START_DELAY_TICKS = 64;               // First compare 32 us after start()
+
+static_assert(static_cast<uint32_t>(WAVEFORM_MAX_PULSE_US) * TICKS_PER_US <= 0xFFFF && 0xFFUL * WAVEFORM_GAP_UNIT_US * TICKS_PER_US <= 0xFFFF,
+              "One edge must fit a single OCR1A step");
+
+static WaveformStreamer* activeStreamer = nullptr;
+
+ISR(TIMER1_COMPA_vect)
+{
+    if (activeStreamer) activeStreamer->onCompare();
+}
+
+WaveformStreamer::WaveformStreamer(DigitalPin& pinPort_GDO0):
+_GDO0_pin(pinPort_GDO0),
+_interpreter(nullptr, 0),
+_edge{0, 0},
+_next(nullptr),
+_nextLength(0),
+_minWords(0),
+_words(0),
+_repeat(false),
+_busy(false),
+_onAir(false),
+_savedTCCR1A(0),
+_savedTCCR1B(0)
+{
+}
+
+/**
+ * @brief Decodes the first edge and arms the first compare; returns at once. Ignored while a
+ *        stream is running.
+ */
+void WaveformStreamer::start(const uint8_t* first, uint8_t firstLength, const uint8_t* next, uint8_t nextLength, uint16_t minWords)
+{
+    if (_busy) return;
+
+    _interpreter = Interpreter(first, firstLength);
+    _next        = next;
+    _nextLength  = nextLength;
+    _minWords    = minWords;
+    _words       = 0;
+    _repeat      = true;
+    _onAir       = _interpreter.next(_edge);
+    if (!_onAir) return;
+
+    uint8_t sreg = SREG;
+    noInterrupts();
+    _busy          = true;
+    activeStreamer = this;
+    _savedTCCR1A   = TCCR1A;
+    _savedTCCR1B   = TCCR1B;
+    TCCR1A = 0;                                                 // Normal mode, free running
+    TCCR1B = (1 << CS11);                                       // clk/8
+    OCR1A  = TCNT1 + START_DELAY_TICKS;
+    TIFR1  = (1 << OCF1A);
+    TIMSK1 |= (1 << OCIE1A);
+    SREG = sreg;
+}
+
+void WaveformStreamer::stop()
+{
+    _repeat = false;
+}
+
+bool WaveformStreamer::busy() const
+{
+    return _busy;
+}
+
+uint16_t WaveformStreamer::words() const
+{
+    uint8_t sreg = SREG;
+    noInterrupts();
+    uint16_t words = _words;
+    SREG = sreg;
+    return words;
+}
+
+/**
+ * @brief One edge per compare: write it, schedule the next deadline, decode the next edge. The
+ *        end of a word program is a word boundary: the next word starts only while repeating.
+ */
+void WaveformStreamer::onCompare()
+{
+    if (!_onAir)
+    {
+        finish();                                               // The last edge is over
+        return;
+    }
+
+    _GDO0_pin.writePin(_edge.level);
+    OCR1A += static_cast<uint16_t>(_edge.durationUs * TICKS_PER_US);
+
+    _onAir = _interpreter.next(_edge);
+    if (!_onAir)
+    {
+        _words = _words + 1;
+        if (_repeat || _words < _minWords)
+        {
+            _interpreter = Interpreter(_next, _nextLength);
+            _onAir = _interpreter.next(_edge);
+        }
+    }
+}
+
+void WaveformStreamer::finish()
+{
+    _GDO0_pin.writePin(_interpreter.idleLevel());
+    TIMSK1 &= ~(1 << OCIE1A);
+    TCCR1A = _savedTCCR1A;
+    TCCR1B = _savedTCCR1B;
+    activeStreamer = nullptr;
+    _busy = false;
+}
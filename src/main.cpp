@@ -1,9 +1,11 @@
 #include <Arduino.h>
 #include <avr/wdt.h>
+#include <avr/sleep.h>
 
 #include "avr_algorithms.hpp"
 #include "App/RemoteCodes.h"
 #include "Debounce/CircularDebounceBuffer.h"
+#include "Debounce/DebounceTuner.h"
 #include "Encoder/SC41344_Encoder.h"
 #include "Streamer/SC41344_FrameStreamer.h"
 #include "Config/Constants.h"
@@ -14,12 +16,74 @@
 #include "Encoder/SC41344_Encoder.h"
 #include "Config/TransceiverConfig.h"
 #include "Debugging/Logging.h"
-
-// Global state flag
-volatile bool buttonFlag = false;
-
-// Timing for periodic status updates
-unsigned long lastTimeSend = 0;
+#include "App/AppStateMachine.h"
+#include "Delay/Timebase.h"
+#include "Capture/FieldTrace.h"
+#ifdef GATEWAY_MODE
+#include "Gateway/GatewayService.h"
+#if DEBUG
+#error "GATEWAY_MODE speaks a binary protocol on Serial: build it without -DDEBUG"
+#endif
+#endif
+#ifdef LADDER_KEYPAD_MODE
+#include "Input/LadderKeypad.h"
+#endif
+#if defined(WAVEFORM_BYTECODE_MODE) || defined(FIELD_PROGRAMS_MODE)
+#include "App/RemotePrograms.h"
+#include "Waveform/WaveformPlayer.h"
+#endif
+#ifdef HOLD_TO_TRANSMIT_MODE
+#include "App/RemotePrograms.h"
+#include "Waveform/WaveformStreamer.h"
+#endif
+#ifdef FIELD_PROGRAMS_MODE
+#include "App/ProgramConsole.h"
+#include "Storage/ProgramStore.h"
+#ifdef GATEWAY_MODE
+#error "FIELD_PROGRAMS_MODE uses Serial as a text console: it can not be combined with GATEWAY_MODE"
+#endif
+#endif
+#ifdef VIEWS_BENCHMARK_MODE
+#include "Debugging/ViewsBenchmark.h"
+#endif
+#ifdef ACCEPTANCE_SIM_MODE
+#include "Simulation/AcceptanceSimulator.h"
+#endif
+#ifdef PARAMETER_SWEEP_MODE
+#include "Simulation/Sweeps.h"
+#endif
+#ifdef CAPTURE_EXPORT_MODE
+#include "Capture/CaptureExport.h"
+#endif
+#ifdef SPI_BUDGET_MODE
+#include "Debugging/SpiBudget.h"
+#endif
+#ifdef ENERGY_ESTIMATE_MODE
+#include "Simulation/EnergyEstimator.h"
+#endif
+#ifdef BOOT_PROFILE
+#include "Debugging/IsrLoad.h"
+#endif
+#ifdef EDGE_JITTER_PROFILING
+#include "Debugging/EdgeJitter.h"
+#endif
+#ifdef ISR_LATENCY_MODE
+#include "Debugging/IsrLatency.h"
+#endif
+#ifdef ROLLING_CODE_MODE
+#include "App/RollingCodeGenerator.h"
+#include "Storage/CounterJournal.h"
+#include "Encoder/EV1527_Encoder.h"
+#endif
+
+// Application state machine: edge -> debounce -> transmit (-> recovery), idle sleep, program uploads
+AppStateMachine app;
+
+// Radio entry time the last Prepare took off the press path (0: the press used the full entry)
+uint32_t speculativePrepUs = 0;
+
+// Timing for periodic status updates (Timebase::nowMs())
+uint32_t lastTimeSend = 0;
 constexpr uint16_t SEND_INTERVAL = 1000;
 
 // SPI instance for CC1101 communication
@@ -37,6 +101,28 @@ OutputPowerLevels::HIGH_POWER
 DigitalPin  gdo0Pin('B',static_cast<uint8_t>(GDO0_PORT_BIT));          // PORTB bit 0 (D8, PB0)                            
 SC41344_Encoder encoder(gdo0Pin);                                   
 
+#ifdef ROLLING_CODE_MODE
+// Rolling-code mode: counter journal in EEPROM + XTEA word sent with EV1527 pulse shapes
+CounterJournal counterJournal;
+RollingCodeGenerator rollingCode(counterJournal, REMOTE1_ROLLING_SERIAL, REMOTE1_ROLLING_KEY);
+EV1527_Encoder rollingEncoder(gdo0Pin);
+#endif
+
+
+#if defined(WAVEFORM_BYTECODE_MODE) || defined(FIELD_PROGRAMS_MODE)
+// Bursts come from compiled waveform programs in flash instead of the encoder/streamer pair
+WaveformPlayer waveformPlayer(gdo0Pin);
+#endif
+
+#ifdef HOLD_TO_TRANSMIT_MODE
+// Open-door words streamed from the Timer1 compare ISR while the button is held
+WaveformStreamer holdStreamer(gdo0Pin);
+#endif
+
+#ifdef GATEWAY_MODE
+// Serial-to-RF gateway: host streams TRANSMIT frames, codes are sent back-to-back
+EV1527_Encoder ev1527Encoder(gdo0Pin);
+#endif
 
 // Debounce buffer for button input
 CircularDebounceBuffer debounce(
@@ -46,6 +132,22 @@ CircularDebounceBuffer debounce(
   SAMPLE_RATE_DEBOUNCE 
 );
 
+// Learns the switch bounce profile and retunes the debounce (persisted in EEPROM)
+DebounceTuner debounceTuner(REMOTE_BUTTON_ID);
+
+#ifdef LADDER_KEYPAD_MODE
+// Resistor-ladder keypad on A0: one debouncer per button, armed by the ADC ISR instead of a pin interrupt
+LadderKeypad keypad;
+CircularDebounceBuffer ladderDebounce[LADDER_BUTTON_COUNT] =
+{
+  { 0, LADDER_ANALOG_PIN, false, SAMPLE_RATE_DEBOUNCE },
+  { 1, LADDER_ANALOG_PIN, false, SAMPLE_RATE_DEBOUNCE },
+  { 2, LADDER_ANALOG_PIN, false, SAMPLE_RATE_DEBOUNCE },
+  { 3, LADDER_ANALOG_PIN, false, SAMPLE_RATE_DEBOUNCE }
+};
+static_assert(LADDER_BUTTON_COUNT == 4, "One ladderDebounce entry per ladder button");
+#endif
+
 // CC1101 Transceiver instance 
 Transceiver transceiver
 (
@@ -53,17 +155,32 @@ Transceiver transceiver
   config
 );
 
+#ifdef GATEWAY_MODE
+GatewayService gateway(Serial, transceiver, encoder, ev1527Encoder);
+#endif
+
+#ifdef FIELD_PROGRAMS_MODE
+// Waveform programs uploaded over the serial console, kept in EEPROM and cached in RAM
+ProgramStore programStore;
+ProgramConsole programConsole(Serial, programStore, transceiver, waveformPlayer);
+#endif
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                                                                  ISR's section
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /**
- * @brief Triggers on a "physical" FALLING edge of the butto
- *   - This ISR arms the debounce to in the next update call from the
- *    loop() start to sample the button Pin
+ * @brief Triggers on both "physical" edges of the button
+ *   - A press edge arms the debounce, the next update calls from the
+ *    loop() sample the button Pin until the press is confirmed
+ *   - A release edge of a confirmed press starts the release confirmation
+ *   - Only press edges reach the application state machine
  */
-void rawISRbuttonPressed()
+void rawISRbuttonEdge()
 {
-  debounce.startDebounce();
+  if (debounce.onEdge())
+  {
+    app.post(AppEvent::Edge);
+  }
 }
 
 
@@ -85,6 +202,55 @@ void printPATable();
  */
 void onButtonPressed();
 
+/**
+ * @brief Release callback of the button debouncer: reports the hold time (press edge -> release edge)
+ */
+void onButtonReleased();
+
+/**
+ * @brief AppAction::Transmit: sends the open-door burst, posts TxDone / TxFailed
+ */
+void transmitOpenDoor();
+
+#ifdef HOLD_TO_TRANSMIT_MODE
+/**
+ * @brief Ends the hold-to-transmit stream once the release is confirmed (or the hold is too long),
+ *  then closes the TX session and posts TxDone / TxFailed
+ */
+void serviceHoldStream();
+#endif
+
+/**
+ * @brief AppAction::Recover: re-initializes the radio, posts RecoveryDone when it answers again
+ */
+void recoverRadio();
+
+/**
+ * @brief AppAction::Prepare: the press is being debounced, park the radio in FSTXON (calibrated, no carrier)
+ */
+void prepareTransmission();
+
+/**
+ * @brief AppAction::Discard: the press was rejected, the radio goes back to IDLE
+ */
+void discardTransmission();
+
+#if DEBUG
+/**
+ * @brief Trace hook of the application state machine: one line per transition with its latency
+ */
+void traceTransition(const AppTrace& trace);
+#endif
+
+#ifdef LADDER_KEYPAD_MODE
+/**
+ * @brief Callback of ladder buttons 1..N (button 0 opens the door like the direct button).
+ *  With LADDER_PROFILING it also reports the decode latency: ADC band change -> debounced press.
+ */
+template<uint8_t Button>
+void onLadderButtonPressed();
+#endif
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////// 
 //                                              Setup section 
@@ -93,8 +259,15 @@ void onButtonPressed();
 void setup() {
 
    // Initialize Serial Communication
+#ifdef GATEWAY_MODE
+  gateway.begin();
+#else
   Serial.begin(115200);
+#endif
   delay(250);                                                                                                             // Stabilize serial                    
+
+  // Timer2 timebase for Delay, the debouncer and the state machine timeouts
+  Timebase::begin();
  
   // Disable watchdog to prevent reset during initialization
   wdt_disable();
@@ -113,33 +286,149 @@ void setup() {
     LOG_NEW_LINE("Transceiver initialized successfully");
   }
 
+#ifdef PACKET_LINK_MODE
+  // Paired receiver: FIFO packets with CRC + ACK instead of blind OOK repeats
+  if (!transceiver.beginPacketLink())
+  {
+    LOG_NEW_LINE("Packet link configuration failed");
+  }
+
+  // Retransmission backoff jitter: without a seed every fob draws the same random() sequence
+  // and two of them that collided once would collide on every retry
+  randomSeed(analogNoiseSeed(PACKET_LINK_NOISE_PIN));
+#endif
+
   // Configure button pin with pull-up resistor
   pinMode(BUTTON_HOME_DOOR_GARAGE_PIN, INPUT_PULLUP);
   
-  // Attach interrupt to the Button
+  // Attach interrupt to the Button: both edges, press and release are confirmed the same way
+  debounce.enableEdgeCapture();
   attachInterrupt(
     digitalPinToInterrupt(BUTTON_HOME_DOOR_GARAGE_PIN),
-    rawISRbuttonPressed,
-    FALLING
+    rawISRbuttonEdge,
+    CHANGE
   );
 
   // Configure Debouncing parameters
   debounce.setThreshold(THRESHOLD_DEBOUNCE);                                                                                             
   debounce.addCallback(onButtonPressed);
+  debounce.setReleaseCallback(onButtonReleased);
+  debounceTuner.begin();
+  debounce.attachTuner(&debounceTuner);                                                                                                   // Stored profile replaces the defaults above
+
+#ifdef FIELD_PROGRAMS_MODE
+  programStore.begin();                                                                                                                  // RAM cache of the validated EEPROM programs
+#endif
+
+#ifdef LADDER_KEYPAD_MODE
+  for (uint8_t i = 0; i < LADDER_BUTTON_COUNT; ++i)
+  {
+    ladderDebounce[i].setThreshold(THRESHOLD_DEBOUNCE);
+    keypad.attach(i, ladderDebounce[i]);
+  }
+  ladderDebounce[0].addCallback(onButtonPressed);
+  ladderDebounce[1].addCallback(onLadderButtonPressed<1>);
+  ladderDebounce[2].addCallback(onLadderButtonPressed<2>);
+  ladderDebounce[3].addCallback(onLadderButtonPressed<3>);
+  keypad.begin();
+  LOG_NEW_LINE("Ladder keypad running (ADC free-running on A0)");
+#endif
   
   // Initialization encoder
+#ifdef ROLLING_CODE_MODE
+  rollingEncoder.begin();
+  counterJournal.begin();
+  rollingCode.prepare(REMOTE1_ROLLING_BUTTON);                                                           // First word is ready before the first press
+#else
   encoder.begin();
+#endif
   LOG_NEW_LINE("Encoder initialized");
 
+  // Application state machine actions
+  app.bind(AppAction::Transmit, transmitOpenDoor);
+  app.bind(AppAction::Recover, recoverRadio);
+#ifndef PACKET_LINK_MODE
+  app.bind(AppAction::Prepare, prepareTransmission);
+  app.bind(AppAction::Discard, discardTransmission);
+#endif
+#if DEBUG
+  app.setTraceHook(traceTransition);
+#endif
+
   // Verify PA_TABLE configuration
   printPATable();
 
+#ifdef VIEWS_BENCHMARK_MODE
+  runViewsBenchmark(Serial);
+#endif
+
+#ifdef ACCEPTANCE_SIM_MODE
+  // Receiver acceptance vs words sent for the open-door burst (seconds of CPU, before the watchdog runs)
+  runAcceptanceSimulation(Serial);
+#endif
+
+#ifdef PARAMETER_SWEEP_MODE
+  // Debounce and acceptance grids as columnar "SWB" blocks, resumed from their EEPROM checkpoint after a reset
+  runParameterSweeps(Serial);
+#endif
+
+#ifdef CAPTURE_EXPORT_MODE
+  // Open-door burst as an edge capture, hex lines "CAP ..." for the host tools
+  exportOpenDoorCapture(Serial);
+#endif
+
+#ifdef SPI_BUDGET_MODE
+  // Bus traffic of begin / setFrequency / setPowerLevel / status and the press path (prepare, cancel, frames) against their budgets
+  runSpiBudgetCheck(transceiver, encoder, Serial);
+#endif
+
+#ifdef ENERGY_ESTIMATE_MODE
+  // Charge per press / per day and battery life of each firmware mode, from the datasheet currents
+  runEnergyEstimate(Serial);
+#endif
+
   // Enable interrupts
   interrupts();
 
   // Enable watchDog(8s timeout)
   wdt_enable(WDTO_8S);
   LOG_NEW_LINE("Watchdog enabled (8s timeout)");
+
+#ifdef BOOT_PROFILE
+  // Same figures as the bare-metal build prints (not LOG: they are wanted without -DDEBUG too)
+  unsigned long readyUs = micros();
+  Serial.print(F("READY us "));
+  Serial.println(readyUs);
+  Serial.print(F("ISR permille "));
+  Serial.println(measureIsrLoadPermille());
+#endif
+
+#ifdef EDGE_JITTER_PROFILING
+  // Encoder output jitter with the periodic ISRs running, then suspended (radio is in IDLE)
+  runEdgeJitterProfile(encoder, Serial);
+#endif
+
+#ifdef ISR_LATENCY_MODE
+  // Entry latency, handler time and jitter per interrupt source, idle and loaded (env:nanoatmega328_isr_latency)
+  runIsrLatencySuite(Serial, rawISRbuttonEdge);
+#endif
+
+#if DEBUG
+  // From here LOG* never waits for the UART: the loop drains the ring, overflow is dropped and counted
+  DebugLog.setPolicy(LogSink::Policy::DropWhenFull);
+#endif
+
+#ifdef FIELD_TRACE_MODE
+  // Button edges and SPI traffic from here on, sent as "TRC" lines from the loop
+  FieldTrace::start(digitalRead(BUTTON_HOME_DOOR_GARAGE_PIN));
+#endif
+
+#ifdef TRACE_REPLAY_MODE
+  // The same firmware from here on, fed with a field trace on virtual time (Capture/FieldTrace.h)
+  FieldTrace::beginReplay();
+#endif
+
+  app.post(AppEvent::BootDone);
 }
 
 
@@ -153,26 +442,88 @@ void loop() {
   // If not periodically reset, it assumes the program is stuck (e.g., in an infinite loop) and resets the microcontroller.
   wdt_reset();
 
+#ifdef TRACE_REPLAY_MODE
+  // Recorded edges and virtual time: one tick per pass while anything is in progress
+  FieldTrace::replayStep(app.state() != AppState::Sleeping || debounce.isDebouncing(), rawISRbuttonEdge);
+#endif
+
   // Runs the Debounce state machine:
   // - If the startDebounce() has been call, it will start sample the pin button each stablish delay.
   // - Each sample would be shifted in a buffer.
   // - It would count the true values inside the buffer and if >= threshold it will execute the callback
-  // - then the buffer is clear a the debounce is disarm until the next rawISRbuttonPressed is triggered
+  // - sampling pauses while the button is held, the release edge resumes it until the release is confirmed
+  // - then the buffer is clear a the debounce is disarm until the next press edge reaches rawISRbuttonEdge
   debounce.update();
+  if (app.state() == AppState::Armed && debounce.isDebouncing())
+  {
+    app.post(AppEvent::DebounceRunning);
+  }
+
+#ifdef LADDER_KEYPAD_MODE
+  for (auto& button : ladderDebounce) button.update();
+#endif
+
+#ifdef FIELD_PROGRAMS_MODE
+  // LOAD / PLAY / LIST / ERASE of field-loaded waveform programs
+  programConsole.poll();
+  if (programConsole.uploading() != (app.state() == AppState::Learning))
+  {
+    app.post(programConsole.uploading() ? AppEvent::LearnStart : AppEvent::LearnDone);
+  }
+#endif
+
+#ifdef GATEWAY_MODE
+  // Ingest host commands and stream whatever is queued
+  gateway.poll();
+  gateway.service();
+#endif
 
+#ifdef ROLLING_CODE_MODE
+  // Encrypt + commit the next word while idle so a press never waits for EEPROM or the cipher
+  if (!rollingCode.isPrepared() && !debounce.getStableState())
+  {
+    rollingCode.prepare(REMOTE1_ROLLING_BUTTON);
+  }
+#endif
   
-  // Print CC1101 status every second
-  unsigned long currentTime = millis();
+  // Print the CC1101 state every second, through the status-register access: a plain read of MARCSTATE
+  // (readRegister()) is the STX strobe and would leave the radio in TX, so no press could be prepared.
+  // On the Timebase, so a trace replay reads it where the field unit did
+  uint32_t currentTime = Timebase::nowMs();
   if (currentTime - lastTimeSend >= SEND_INTERVAL)
   {
-     StatusInfo status = Transceiver::decodeStatus( 
-      transceiver.readRegister(CC1101::Address::MARCSTATE)
-    );
-    LOG_DYNAMIC(status.toString());  
-    LOG_NEW_LINE("");
+    LOG_PAIR_HEX("MARCSTATE", transceiver.readMarcState());
     lastTimeSend = currentTime;        // Reset timer
   } 
-  
+
+#ifdef HOLD_TO_TRANSMIT_MODE
+  serviceHoldStream();
+#endif
+
+  // Timeouts, then every queued event (transmission and recovery run from here)
+  app.poll();
+
+#if DEBUG
+  DebugLog.service();
+#endif
+
+#ifdef FIELD_TRACE_MODE
+  FieldTrace::service(Serial);
+#endif
+
+#ifdef LADDER_KEYPAD_MODE
+  // Free-running ADC only while awake or while a ladder press is being debounced
+  bool ladderBusy = false;
+  for (auto& button : ladderDebounce) ladderBusy |= button.isDebouncing();
+  keypad.setSleeping(app.state() == AppState::Sleeping && !ladderBusy);
+#endif
+
+  // Nothing pending: CPU idle until the next interrupt (button edge, Timebase / Timer0 tick, UART)
+  if (app.state() == AppState::Sleeping && !FieldTrace::replaying())
+  {
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_mode();
+  }
 
 }
 
@@ -202,13 +553,66 @@ void printPATable()
 
 
 /**
- * @brief Callback for stable button state changes.
- * Generates waveform on D8 when pressed, disables watchdog during critical section.
+ * @brief Callback for stable button state changes: the state machine decides whether to transmit.
  */
 void onButtonPressed()
+{
+  app.post(AppEvent::PressConfirmed);
+}
+
+void onButtonReleased()
+{
+  LOG_PAIR_DEC("Button held us", debounce.lastHoldUs());
+}
+
+/**
+ * @brief Generates waveform on D8, disables watchdog during critical section.
+ */
+void transmitOpenDoor()
 {      
   LOG_NEW_LINE("Button pressed → transmitting");
 
+#ifdef PACKET_LINK_MODE
+  // No bit-banged timing here: keep interrupts on so the Timebase drives the ACK timeout and backoff
+  wdt_reset();
+  if (transceiver.transmitCommand(PacketCommand::OPEN_DOOR))
+  {
+    LOG_NEW_LINE("Command acknowledged");
+    app.post(AppEvent::TxDone);
+  }
+  else
+  {
+    LOG_NEW_LINE("Command not acknowledged");
+    app.post(AppEvent::TxFailed);
+  }
+  return;
+#endif
+
+#ifdef GATEWAY_MODE
+  // The host's path (GatewayService::streamPacked): interrupts stay on so the UART RX ISR keeps
+  // filling the core buffer through the 235 ms burst (the host's credits bound what it can send
+  // meanwhile), only the periodic ISRs are suspended for clean edges
+  wdt_reset();
+  transceiver.openTxSession();
+  Timebase::suspend();
+  transceiver.streamFrame<CodeFamilies::SC41344_8Bit>(REMOTE1_OPEN_DOOR_CODE, encoder);
+  Timebase::resume(CodeFamilies::burstDurationUs<CodeFamilies::SC41344_8Bit>());
+  speculativePrepUs = 0;
+  app.post(transceiver.closeTxSession() ? AppEvent::TxDone : AppEvent::TxFailed);
+  return;
+#endif
+
+#ifdef HOLD_TO_TRANSMIT_MODE
+  // Edges come from the Timer1 compare ISR: interrupts and watchdog stay on, the loop keeps
+  // debouncing and ends the stream at a word boundary once the release is confirmed
+  transceiver.openTxSession();
+  holdStreamer.start(REMOTE1_OPEN_DOOR_FIRST_WORD.data(), REMOTE1_OPEN_DOOR_FIRST_WORD.size(),
+                     REMOTE1_OPEN_DOOR_NEXT_WORD.data(), REMOTE1_OPEN_DOOR_NEXT_WORD.size(),
+                     RemotePrograms::OPEN_DOOR_LAYOUT.wordRepeats + 1);                                    // A tap still sends the whole burst
+  speculativePrepUs = 0;
+  return;
+#endif
+
   // Disable interrupts for a timing-critical section
   noInterrupts();                                                                                                          
   
@@ -217,9 +621,24 @@ void onButtonPressed()
   LOG_NEW_LINE(" WatchDog disable");  
   
   // Send Command
-  if (transceiver.transmitFrame(REMOTE1_OPEN_DOOR_CODE, encoder))
+#ifdef ROLLING_CODE_MODE
+  bool sent = rollingCode.isPrepared() &&
+              transceiver.transmitFrame<CodeFamilies::RollingCode>(rollingCode.bits(), rollingEncoder);
+  rollingCode.consume();
+#elif defined(WAVEFORM_BYTECODE_MODE)
+  transceiver.openTxSession();
+  waveformPlayer.play(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size());
+  bool sent = transceiver.closeTxSession();
+#else
+  bool sent = transceiver.transmitFrame(REMOTE1_OPEN_DOOR_CODE, encoder);
+#endif
+  if (sent)
   {
     LOG_NEW_LINE("Transmission successful");
+    LOG_PAIR_DEC("Radio entry done while debouncing us", speculativePrepUs);
+#ifdef WAVEFORM_BYTECODE_MODE
+    LOG_PAIR_DEC("Worst interpreter cost per edge (0.5 us ticks)", waveformPlayer.worstEdgeCostTicks());
+#endif
   }
   else
   {
@@ -234,5 +653,89 @@ void onButtonPressed()
   
   // Re-enable interrupts
   interrupts();                                                                                                                  
+
+  speculativePrepUs = 0;
+  app.post(sent ? AppEvent::TxDone : AppEvent::TxFailed);
 }
+
+void prepareTransmission()
+{
+  uint32_t start = Timebase::nowUs();
+  bool prepared = transceiver.prepareTxSession();
+  speculativePrepUs = prepared ? Timebase::nowUs() - start : 0;
+}
+
+void discardTransmission()
+{
+  transceiver.cancelTxSession();
+  speculativePrepUs = 0;
+}
+
+#ifdef HOLD_TO_TRANSMIT_MODE
+void serviceHoldStream()
+{
+  if (app.state() != AppState::Transmitting)
+  {
+    return;
+  }
+
+  if (!debounce.getStableState() || debounce.heldUs() >= HOLD_TX_MAX_MS * 1000UL)
+  {
+    holdStreamer.stop();
+  }
+
+  if (!holdStreamer.busy())
+  {
+    bool sent = transceiver.closeTxSession();
+    LOG_PAIR_DEC("Words streamed", holdStreamer.words());
+    app.post(sent ? AppEvent::TxDone : AppEvent::TxFailed);
+  }
+}
+#endif
+
+void recoverRadio()
+{
+  bool ready = transceiver.begin();
+#ifdef PACKET_LINK_MODE
+  ready = ready && transceiver.beginPacketLink();
+#endif
+  if (ready)
+  {
+    LOG_NEW_LINE("Transceiver recovered");
+    app.post(AppEvent::RecoveryDone);
+  }
+  else
+  {
+    LOG_NEW_LINE("Transceiver recovery failed, retrying");
+  }
+}
+
+#if DEBUG
+void traceTransition(const AppTrace& trace)
+{
+  // Through the log ring like the LOG lines: a transition is traced from the loop, it must not wait for the UART
+  DebugLog.print(F("APP "));
+  DebugLog.print(static_cast<uint8_t>(trace.from));
+  DebugLog.print(F(" -> "));
+  DebugLog.print(static_cast<uint8_t>(trace.to));
+  DebugLog.print(F(" on "));
+  DebugLog.print(static_cast<uint8_t>(trace.event));
+  DebugLog.print(F(" queued us: "));
+  DebugLog.print(trace.queuedUs);
+  DebugLog.print(F(" action us: "));
+  DebugLog.println(trace.actionUs);
+}
+#endif
    
+
+
+#ifdef LADDER_KEYPAD_MODE
+template<uint8_t Button>
+void onLadderButtonPressed()
+{
+  LOG_PAIR_DEC("Ladder button pressed", Button);
+#ifdef LADDER_PROFILING
+  LOG_PAIR_DEC("Decode latency us", micros() - keypad.lastBandChangeUs());
+#endif
+}
+#endif
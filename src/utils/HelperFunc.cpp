@@ -14,13 +14,16 @@
  * printDots(5, 500); // Prints 5 dots with a 500 ms delay between each dot.
  * @endcode
  * * @note This function is usefull to add a delay between operations, such as during initialization or data processing. So is easy to see the progress in the serial monitor.
+ * @note Without -DDEBUG there is nothing to watch: no dots and no delay. The boot (setup(), Transceiver::begin(),
+ *       every SPIBus::readRegister()) then costs only its own work, ENERGY_ARDUINO_BOOT_US counts on it.
  */
 void printDots(uint8_t numOfDots, unsigned long delay_ms)
 {
+#if DEBUG
     // Validate delay_ms
     if(delay_ms == 0)
     {
-        LOG_NEW_LINE("Error: delay_ms cannot be zero");
+        LOG_ERROR("Error: delay_ms cannot be zero");
         return;
     }
 
@@ -36,6 +39,10 @@ void printDots(uint8_t numOfDots, unsigned long delay_ms)
     avr_algorithms::repeat(numOfDots,printDot);
 
     LOG("\n\n"); // Print a new line after all dots
+#else
+    (void)numOfDots;
+    (void)delay_ms;
+#endif
 }
 
 
@@ -57,4 +64,27 @@ void wait(unsigned long delay_ms)
     while (millis() - startTime < delay_ms) {
         // Do nothing, just wait
     }     
-}
\ No newline at end of file
+}
+
+
+/**
+ * @brief Folds the least significant bit of 32 conversions of a floating analog pin into a seed.
+ * * Two units (or two boots of one unit) that share the same firmware start random() from different
+ *   points, so their random backoffs do not stay in lockstep.
+ * 
+ * @param pin - Analog pin left unconnected (nothing drives it, so its LSB is thermal and coupling noise)
+ * @return Seed for randomSeed(), never 0
+ * 
+ * @code
+ * randomSeed(analogNoiseSeed(PACKET_LINK_NOISE_PIN));
+ * @endcode
+ */
+uint32_t analogNoiseSeed(uint8_t pin)
+{
+    uint32_t seed = micros();                           // Boot time adds a little: the crystal and the caps differ per unit
+    for (uint8_t i = 0; i < 32; ++i)
+    {
+        seed = (seed << 1 | seed >> 31) ^ (analogRead(pin) & 0x01);
+    }
+    return seed ? seed : 1;
+}
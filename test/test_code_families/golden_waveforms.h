@@ -0,0 +1,186 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Golden waveforms of the code families: the output level runs of one whole burst.
+ *
+ * A waveform is its first level and the width of every run in us; levels alternate from there. A
+ * run ends where the level changes, so a last run that merges into the idle level (EV1527 shapes
+ * idle LOW) is not part of it.
+ *
+ * SC41344 8/12/16/24: recorded from the SC41344 encoder and frame streamer of the tree before
+ * the code families, stepped on the host with every pin write and delay logged. EV1527 and the
+ * rolling code: written from the PT2262/EV1527 timing (T = 350 us), not from this firmware.
+ */
+namespace Golden
+{
+    struct Waveform
+    {
+        uint8_t         firstLevel;
+        const uint16_t* runs;                                   // PROGMEM
+        uint16_t        count;
+    };
+
+    // SC41344, 8 digits (the open-door code)
+    constexpr uint8_t SC41344_8_CODE[8] =
+    {
+        1, 1, 0, 1, 1, 0, 0, 0
+    };
+    const uint16_t SC41344_8_RUNS[145] PROGMEM =
+    {
+        10000, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200,
+        300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 300, 17200,
+        2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200,
+        300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 300, 17200, 2200, 300,
+        2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300,
+        2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 300, 17200, 2200, 300, 2200,
+        300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200,
+        300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 300, 2200
+    };
+    constexpr Waveform SC41344_8 = { 0, SC41344_8_RUNS, 145 };
+
+    // SC41344, 12 digits
+    constexpr uint8_t SC41344_12_CODE[12] =
+    {
+        1, 0, 1, 1, 0, 0, 1, 0, 1, 1, 1, 0
+    };
+    const uint16_t SC41344_12_RUNS[209] PROGMEM =
+    {
+        10000, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300,
+        2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300,
+        2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 300, 17200, 2200, 300,
+        2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 300,
+        2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300,
+        2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 300, 17200, 2200, 300, 2200, 300, 300, 2200, 300,
+        2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300,
+        2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300,
+        2200, 300, 2200, 2200, 300, 300, 17200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200,
+        300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200,
+        300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200,
+        300, 300, 2200
+    };
+    constexpr Waveform SC41344_12 = { 0, SC41344_12_RUNS, 209 };
+
+    // SC41344, 16 digits
+    constexpr uint8_t SC41344_16_CODE[16] =
+    {
+        0, 1, 1, 0, 1, 0, 0, 1, 1, 1, 0, 0, 1, 0, 1, 1
+    };
+    const uint16_t SC41344_16_RUNS[273] PROGMEM =
+    {
+        10000, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200,
+        300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300,
+        2200, 300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300,
+        2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 17200, 300, 2200, 300, 2200, 2200,
+        300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200,
+        300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300,
+        2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300,
+        2200, 300, 2200, 300, 300, 17200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300,
+        2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300,
+        2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200,
+        300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 17200, 300, 2200,
+        300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300,
+        2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300,
+        300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200,
+        300, 2200, 300, 2200, 300, 2200, 300, 300, 2200
+    };
+    constexpr Waveform SC41344_16 = { 0, SC41344_16_RUNS, 273 };
+
+    // SC41344, 24 digits
+    constexpr uint8_t SC41344_24_CODE[24] =
+    {
+        1, 0, 0, 1, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1
+    };
+    const uint16_t SC41344_24_RUNS[401] PROGMEM =
+    {
+        10000, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200,
+        300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200,
+        300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200,
+        300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300,
+        2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200,
+        300, 2200, 300, 2200, 300, 300, 17200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200,
+        2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200,
+        300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300,
+        2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200,
+        300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200,
+        2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 17200, 2200, 300, 2200, 300, 300, 2200, 300,
+        2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200,
+        300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300,
+        2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200,
+        300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200,
+        300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 17200, 2200, 300,
+        2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200,
+        300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 300, 2200, 300, 2200,
+        2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200, 300,
+        2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 300, 2200,
+        300, 2200, 2200, 300, 2200, 300, 300, 2200, 300, 2200, 2200, 300, 2200, 300, 2200, 300, 2200, 300, 2200,
+        300, 300, 2200
+    };
+    constexpr Waveform SC41344_24 = { 0, SC41344_24_RUNS, 401 };
+
+    // EV1527, 20-bit serial + 4 button bits
+    constexpr uint8_t EV1527_CODE[24] =
+    {
+        1, 0, 1, 1, 0, 1, 0, 0, 0, 1, 1, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 1, 0, 0
+    };
+    const uint16_t EV1527_RUNS[399] PROGMEM =
+    {
+        350, 10850, 1050, 350, 350, 1050, 1050, 350, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 350,
+        1050, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050,
+        350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 350, 10850, 1050, 350, 350, 1050,
+        1050, 350, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 350, 1050, 1050, 350, 1050, 350, 1050,
+        350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050,
+        1050, 350, 350, 1050, 350, 1050, 350, 10850, 1050, 350, 350, 1050, 1050, 350, 1050, 350, 350, 1050,
+        1050, 350, 350, 1050, 350, 1050, 350, 1050, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 1050,
+        350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050,
+        350, 10850, 1050, 350, 350, 1050, 1050, 350, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 350,
+        1050, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050,
+        350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 350, 10850, 1050, 350, 350, 1050,
+        1050, 350, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 350, 1050, 1050, 350, 1050, 350, 1050,
+        350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050,
+        1050, 350, 350, 1050, 350, 1050, 350, 10850, 1050, 350, 350, 1050, 1050, 350, 1050, 350, 350, 1050,
+        1050, 350, 350, 1050, 350, 1050, 350, 1050, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 1050,
+        350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050,
+        350, 10850, 1050, 350, 350, 1050, 1050, 350, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 350,
+        1050, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050,
+        350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 350, 10850, 1050, 350, 350, 1050,
+        1050, 350, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 350, 1050, 1050, 350, 1050, 350, 1050,
+        350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050,
+        1050, 350, 350, 1050, 350
+    };
+    constexpr Waveform EV1527 = { 1, EV1527_RUNS, 399 };
+
+    // Rolling code, 64 cipher + 32 clear bits
+    constexpr uint8_t ROLLING_CODE[96] =
+    {
+        1, 1, 1, 1, 0, 1, 1, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 1, 0, 0, 0, 0,
+        0, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 1, 1, 1, 0, 0,
+        1, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1
+    };
+    const uint16_t ROLLING_RUNS[387] PROGMEM =
+    {
+        350, 10850, 1050, 350, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 1050, 350, 1050, 350, 350, 1050, 350,
+        1050, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050,
+        1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350,
+        1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 350, 1050, 350, 1050, 350, 1050, 1050, 350,
+        1050, 350, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 350, 1050, 1050, 350, 1050, 350, 1050, 350, 1050,
+        350, 350, 1050, 1050, 350, 1050, 350, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 350, 1050,
+        350, 1050, 1050, 350, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 1050,
+        350, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050,
+        1050, 350, 350, 1050, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 350, 1050, 350, 1050, 1050, 350, 1050,
+        350, 350, 1050, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050,
+        350, 1050, 1050, 350, 350, 10850, 1050, 350, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 1050, 350,
+        1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 1050, 350, 350, 1050, 350,
+        1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050,
+        1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 350, 1050, 350, 1050, 350,
+        1050, 350, 1050, 1050, 350, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 350, 1050, 1050, 350,
+        1050, 350, 1050, 350, 1050, 350, 350, 1050, 1050, 350, 1050, 350, 1050, 350, 1050, 350, 1050, 350, 350,
+        1050, 350, 1050, 350, 1050, 350, 1050, 1050, 350, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 1050, 350,
+        350, 1050, 350, 1050, 1050, 350, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 350,
+        1050, 1050, 350, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 350, 1050,
+        350, 1050, 1050, 350, 1050, 350, 350, 1050, 350, 1050, 350, 1050, 1050, 350, 350, 1050, 1050, 350, 350,
+        1050, 1050, 350, 350, 1050, 350, 1050, 1050
+    };
+    constexpr Waveform ROLLING = { 1, ROLLING_RUNS, 387 };
+}
@@ -0,0 +1,158 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <stdio.h>
+#include "Config/CodeFamilies.h"
+#include "Config/DigitalPin.h"
+#include "Encoder/SC41344_Encoder.h"
+#include "Encoder/EV1527_Encoder.h"
+#include "Streamer/CodeFamilyStreamer.h"
+#include "Delay/Timebase.h"
+#include "golden_waveforms.h"
+
+// Each family streams one burst through its real encoder onto D5 (PD5, nothing connected: D8 is
+// the CC1101's GDO0, an output of the chip until the transceiver configures it). The pin change
+// interrupt of D5 timestamps every level change on Timer1 and checks the run that just ended
+// against the golden waveform, so nothing is buffered.
+namespace
+{
+    constexpr uint8_t  OUTPUT_PORT_BIT  = 5;                    // PD5 = PCINT21
+    constexpr uint16_t RUN_TOLERANCE_US = 16;                   // Call overhead + this ISR, which stretches the delay it lands in
+
+    DigitalPin      outputPin('D', OUTPUT_PORT_BIT);
+    SC41344_Encoder sc41344(outputPin);
+    EV1527_Encoder  ev1527(outputPin);
+
+    const Golden::Waveform* golden;
+    volatile bool     started;
+    volatile uint16_t lastCount;
+    volatile uint16_t runs;                                     // Runs ended so far
+    volatile uint16_t mismatches;
+    volatile uint16_t firstMismatch;
+    volatile uint16_t firstMismatchUs;
+
+    // Timer1 free running at clk/8 (0.5 us), the 15 ms + 2.2 ms SC41344 gap is the longest run
+    static_assert(FRAME_SILENCE_BETWEEN_WORDS + LONG_LOW_US < 0xFFFF / 2, "A run must fit one Timer1 period");
+}
+
+ISR(PCINT2_vect)
+{
+    uint16_t now   = TCNT1;
+    uint8_t  level = (PIND >> OUTPUT_PORT_BIT) & 1;
+    uint16_t us    = static_cast<uint16_t>(now - lastCount) >> 1;
+    lastCount = now;
+
+    if (!started)
+    {
+        started = true;
+        if (level != golden->firstLevel && !mismatches++) firstMismatch = 0;
+        return;
+    }
+
+    uint16_t index = runs++;
+    bool matches = false;
+    if (index < golden->count)
+    {
+        uint16_t expected = pgm_read_word(golden->runs + index);
+        uint8_t  runLevel = golden->firstLevel ^ (index & 1);
+        uint16_t error    = (us > expected) ? us - expected : expected - us;
+        matches = (level != runLevel) && error <= RUN_TOLERANCE_US + expected / 64;
+    }
+    if (!matches && !mismatches++)
+    {
+        firstMismatch   = index;
+        firstMismatchUs = us;
+    }
+}
+
+/**
+ * @brief Streams code as Family through encoder and checks every run against expected.
+ */
+template<typename Family>
+void expectWaveform(const Golden::Waveform& expected, const uint8_t (&code)[Family::WORD_BITS], IBitEncoder& encoder, uint8_t idleLevel)
+{
+    outputPin.pinConfig(false, false);
+    outputPin.writePin(idleLevel);
+    Serial.flush();                                             // No UART ISR in the burst
+
+    golden     = &expected;
+    started    = false;
+    runs       = 0;
+    mismatches = 0;
+
+    uint8_t savedTCCR1A = TCCR1A;
+    uint8_t savedTCCR1B = TCCR1B;
+    TCCR1A = 0;
+    TCCR1B = (1 << CS11);
+    lastCount = TCNT1;
+
+    // The periodic ISRs off like on air, only the pin change interrupt of D5 on
+    Timebase::suspend();
+    PCMSK2 = (1 << OUTPUT_PORT_BIT);
+    PCIFR  = (1 << PCIF2);
+    PCICR |= (1 << PCIE2);
+    CodeFamilyStreamer<Family>::streamFrameStatic(code, encoder);
+    PCICR &= ~(1 << PCIE2);
+    PCMSK2 = 0;
+    Timebase::resume(CodeFamilies::burstDurationUs<Family>());
+
+    TCCR1A = savedTCCR1A;
+    TCCR1B = savedTCCR1B;
+
+    char message[48];
+    snprintf(message, sizeof(message), "first mismatch: run %u, %u us", firstMismatch, firstMismatchUs);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(expected.count, runs, "runs in the burst");
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(0, mismatches, message);
+}
+
+/**
+ * @brief The family traits (burstDurationUs()) agree with the golden waveform: its runs add up
+ *        to the burst, less the last LOW that merges into idle (at most one 3T LOW).
+ */
+void expectBurstDuration(const Golden::Waveform& expected, uint32_t burstUs)
+{
+    uint32_t totalUs = 0;
+    for (uint16_t i = 0; i < expected.count; ++i) totalUs += pgm_read_word(expected.runs + i);
+
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(burstUs, totalUs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(3UL * EV1527_BASE_PULSE_US, burstUs - totalUs);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_sc41344_8bit_matches_recording()  { expectWaveform<CodeFamilies::SC41344_8Bit>(Golden::SC41344_8, Golden::SC41344_8_CODE, sc41344, HIGH); }
+void test_sc41344_12bit_matches_recording() { expectWaveform<CodeFamilies::SC41344_12Bit>(Golden::SC41344_12, Golden::SC41344_12_CODE, sc41344, HIGH); }
+void test_sc41344_16bit_matches_recording() { expectWaveform<CodeFamilies::SC41344_16Bit>(Golden::SC41344_16, Golden::SC41344_16_CODE, sc41344, HIGH); }
+void test_sc41344_24bit_matches_recording() { expectWaveform<CodeFamilies::SC41344_24Bit>(Golden::SC41344_24, Golden::SC41344_24_CODE, sc41344, HIGH); }
+void test_ev1527_matches_spec()             { expectWaveform<CodeFamilies::EV1527>(Golden::EV1527, Golden::EV1527_CODE, ev1527, LOW); }
+void test_rolling_code_matches_spec()       { expectWaveform<CodeFamilies::RollingCode>(Golden::ROLLING, Golden::ROLLING_CODE, ev1527, LOW); }
+
+void test_burst_durations_match_traits()
+{
+    expectBurstDuration(Golden::SC41344_8,  CodeFamilies::burstDurationUs<CodeFamilies::SC41344_8Bit>());
+    expectBurstDuration(Golden::SC41344_12, CodeFamilies::burstDurationUs<CodeFamilies::SC41344_12Bit>());
+    expectBurstDuration(Golden::SC41344_16, CodeFamilies::burstDurationUs<CodeFamilies::SC41344_16Bit>());
+    expectBurstDuration(Golden::SC41344_24, CodeFamilies::burstDurationUs<CodeFamilies::SC41344_24Bit>());
+    expectBurstDuration(Golden::EV1527,     CodeFamilies::burstDurationUs<CodeFamilies::EV1527>());
+    expectBurstDuration(Golden::ROLLING,    CodeFamilies::burstDurationUs<CodeFamilies::RollingCode>());
+}
+
+void setup()
+{
+    delay(2000);                                                // The board resets when the runner opens the port
+    Timebase::begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_burst_durations_match_traits);
+    RUN_TEST(test_sc41344_8bit_matches_recording);
+    RUN_TEST(test_sc41344_12bit_matches_recording);
+    RUN_TEST(test_sc41344_16bit_matches_recording);
+    RUN_TEST(test_sc41344_24bit_matches_recording);
+    RUN_TEST(test_ev1527_matches_spec);
+    RUN_TEST(test_rolling_code_matches_spec);
+    UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,365 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+#include "Capture/EdgeCapture.h"
+#include "Capture/CaptureConverters.h"
+#include "Capture/CaptureExport.h"
+#include "Simulation/AcceptanceSimulator.h"
+#include "App/RemotePrograms.h"
+#include "Policies/PROGMEMStoragePolicy.h"
+#include "Policies/RAMStoragePolicy.h"
+#include "../test_code_families/golden_waveforms.h"
+
+// Captures written at run time: the recorded open-door burst (golden waveform) round trip at
+// several block sizes, the hex lines of exportOpenDoorCapture() read back, seeks, truncated and
+// damaged captures, the converters, and the acceptance simulator reading a capture.
+namespace
+{
+    using Reader = Capture::Reader<RAMStoragePolicy>;
+
+    constexpr size_t SMALL_BLOCK_BYTES = 48;                    // A dozen edges per block: several blocks to search
+
+    /// @brief Capture bytes in RAM
+    struct BufferSink
+    {
+        uint8_t bytes[640];
+        size_t  length;
+        bool    overflow;
+
+        size_t write(const uint8_t* data, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (length >= sizeof(bytes)) { overflow = true; return i; }
+                bytes[length++] = data[i];
+            }
+            return count;
+        }
+    };
+
+    BufferSink buffer;
+
+    /// @brief The runs of a golden waveform as edges
+    struct GoldenSource
+    {
+        const Golden::Waveform* golden;
+        uint16_t run;
+
+        bool next(Waveform::Edge& edge)
+        {
+            if (run >= golden->count) return false;
+            edge.level      = golden->firstLevel ^ (run & 1);
+            edge.durationUs = pgm_read_word(golden->runs + run);
+            ++run;
+            return true;
+        }
+    };
+
+    /// @brief Parses the "CAP <hex>" lines of exportOpenDoorCapture() back into buffer
+    class HexLines : public Print
+    {
+        public:
+
+        size_t write(uint8_t c) override
+        {
+            if (c == '\n') { _column = 0; return 1; }
+            if (c == '\r') return 1;
+            if (_column < 4) { _prefix[_column++] = c; return 1; }
+            if (memcmp(_prefix, "CAP ", 4) != 0) return 1;
+
+            uint8_t nibble = (c >= 'a') ? c - 'a' + 10 : c - '0';
+            if (_high) { uint8_t byte = (_nibble << 4) | nibble; buffer.write(&byte, 1); }
+            else       _nibble = nibble;
+            _high = !_high;
+            return 1;
+        }
+
+        private:
+
+        char    _prefix[4] = {};
+        uint8_t _column = 0;                                    // Up to the 4 prefix characters
+        uint8_t _nibble = 0;
+        bool    _high = false;
+    };
+
+    template<size_t BlockBytes, typename Source>
+    void capture(Source source)
+    {
+        Capture::Writer<BufferSink, BlockBytes> writer(buffer);
+        Waveform::Edge edge{0, 0};
+        while (source.next(edge)) writer.add(edge.level, edge.durationUs);
+        writer.finish();
+    }
+
+    GoldenSource openDoorRecording() { return GoldenSource{ &Golden::SC41344_8, 0 }; }
+
+    Waveform::Interpreter<PROGMEMStoragePolicy> openDoorProgram()
+    {
+        return Waveform::Interpreter<PROGMEMStoragePolicy>(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size());
+    }
+
+    /// @brief Reads the capture in buffer back and compares it edge for edge with source
+    template<typename Source>
+    void expectSameEdges(Source source)
+    {
+        Reader reader(buffer.bytes, buffer.length);
+        TEST_ASSERT_TRUE(reader.valid());
+
+        auto cursor = reader.begin();
+        Waveform::Edge expected{0, 0};
+        Waveform::Edge read{0, 0};
+        uint16_t edges = 0;
+        while (source.next(expected))
+        {
+            TEST_ASSERT_TRUE(cursor.next(read));
+            TEST_ASSERT_EQUAL_UINT8(expected.level, read.level);
+            TEST_ASSERT_EQUAL_UINT32(expected.durationUs, read.durationUs);
+            ++edges;
+        }
+        TEST_ASSERT_FALSE(cursor.next(read));
+        TEST_ASSERT_FALSE(cursor.faulted());
+        TEST_ASSERT_EQUAL_UINT32(edges, static_cast<uint32_t>(reader.edgeCount()));
+    }
+
+    /// @brief Feeds text to a converter writing into buffer
+    template<template<typename> class Converter>
+    void convert(const char* text)
+    {
+        buffer = BufferSink{};
+        Capture::Writer<BufferSink, SMALL_BLOCK_BYTES> writer(buffer);
+        Converter<decltype(writer)> converter(writer);
+        while (*text) converter.feed(*text++);
+        converter.finish();
+        writer.finish();
+    }
+
+    void expectEdge(Reader::Cursor& cursor, uint8_t level, uint32_t durationUs)
+    {
+        Waveform::Edge edge{0, 0};
+        TEST_ASSERT_TRUE(cursor.next(edge));
+        TEST_ASSERT_EQUAL_UINT8(level, edge.level);
+        TEST_ASSERT_EQUAL_UINT32(durationUs, edge.durationUs);
+    }
+}
+
+void setUp() { buffer = BufferSink{}; }
+void tearDown() {}
+
+void test_recording_round_trip_small_blocks()
+{
+    capture<SMALL_BLOCK_BYTES>(openDoorRecording());
+    TEST_ASSERT_FALSE(buffer.overflow);
+    TEST_ASSERT_EQUAL_UINT32(0, (buffer.length - Capture::FILE_HEADER_BYTES) % SMALL_BLOCK_BYTES);
+    TEST_ASSERT_GREATER_THAN_UINT32(4, Reader(buffer.bytes, buffer.length).blockCount());
+    expectSameEdges(openDoorRecording());
+}
+
+void test_recording_round_trip_firmware_blocks()
+{
+    capture<CAPTURE_BLOCK_BYTES>(openDoorRecording());
+    TEST_ASSERT_FALSE(buffer.overflow);
+    expectSameEdges(openDoorRecording());
+}
+
+// The hex lines the firmware prints are the capture of the compiled burst
+void test_exported_lines_read_back()
+{
+    HexLines lines;
+    exportOpenDoorCapture(lines);
+    TEST_ASSERT_FALSE(buffer.overflow);
+
+    Reader reader(buffer.bytes, buffer.length);
+    TEST_ASSERT_EQUAL_UINT32(Capture::FILE_HEADER_BYTES + reader.blockCount() * CAPTURE_BLOCK_BYTES, buffer.length);
+    expectSameEdges(openDoorProgram());
+}
+
+void test_seek_lands_on_the_edge_on_air()
+{
+    capture<SMALL_BLOCK_BYTES>(openDoorRecording());
+    Reader reader(buffer.bytes, buffer.length);
+
+    GoldenSource source = openDoorRecording();
+    Waveform::Edge edge{0, 0};
+    uint32_t startUs = 0;
+    for (uint16_t index = 0; source.next(edge); ++index)
+    {
+        auto atStart = reader.seek(startUs);
+        auto inside  = reader.seek(startUs + edge.durationUs / 2);
+        TEST_ASSERT_EQUAL_UINT32(index, static_cast<uint32_t>(atStart.edgeIndex()));
+        TEST_ASSERT_EQUAL_UINT32(startUs, static_cast<uint32_t>(atStart.startUs()));
+        TEST_ASSERT_EQUAL_UINT32(index, static_cast<uint32_t>(inside.edgeIndex()));
+        startUs += edge.durationUs;
+    }
+
+    auto past = reader.seek(startUs + 1000000UL);
+    TEST_ASSERT_FALSE(past.next(edge));
+    TEST_ASSERT_FALSE(past.faulted());
+}
+
+// A capture cut anywhere reads up to its last whole block
+void test_truncated_capture()
+{
+    capture<SMALL_BLOCK_BYTES>(openDoorRecording());
+    size_t blocks = Reader(buffer.bytes, buffer.length).blockCount();
+
+    Reader cut(buffer.bytes, buffer.length - SMALL_BLOCK_BYTES / 2);
+    TEST_ASSERT_TRUE(cut.valid());
+    TEST_ASSERT_EQUAL_UINT32(blocks - 1, cut.blockCount());
+
+    auto cursor = cut.begin();
+    GoldenSource source = openDoorRecording();
+    Waveform::Edge expected{0, 0};
+    Waveform::Edge read{0, 0};
+    uint32_t edges = 0;
+    while (cursor.next(read))
+    {
+        TEST_ASSERT_TRUE(source.next(expected));
+        TEST_ASSERT_EQUAL_UINT32(expected.durationUs, read.durationUs);
+        ++edges;
+    }
+    TEST_ASSERT_FALSE(cursor.faulted());
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(cut.edgeCount()), edges);
+    TEST_ASSERT_LESS_THAN_UINT32(Golden::SC41344_8.count, edges);
+
+    TEST_ASSERT_FALSE(Reader(buffer.bytes, Capture::FILE_HEADER_BYTES - 1).valid());
+    TEST_ASSERT_EQUAL_UINT32(0, Reader(buffer.bytes, Capture::FILE_HEADER_BYTES).blockCount());
+}
+
+void test_damaged_capture()
+{
+    capture<SMALL_BLOCK_BYTES>(openDoorRecording());
+    uint8_t* second = buffer.bytes + Capture::FILE_HEADER_BYTES + SMALL_BLOCK_BYTES;
+    Waveform::Edge edge{0, 0};
+
+    // Payload longer than the block: the cursor stops with a fault at that block
+    uint8_t payload = second[18];
+    second[18] = SMALL_BLOCK_BYTES;
+    Reader reader(buffer.bytes, buffer.length);
+    auto cursor = reader.begin();
+    uint32_t edges = 0;
+    while (cursor.next(edge)) ++edges;
+    TEST_ASSERT_TRUE(cursor.faulted());
+    TEST_ASSERT_EQUAL_UINT32(second[8], edges);                 // Exactly the first block
+    second[18] = payload;
+
+    // A varint that never ends
+    memset(second + Capture::BLOCK_HEADER_BYTES, 0x80, SMALL_BLOCK_BYTES - Capture::BLOCK_HEADER_BYTES);
+    cursor = reader.begin();
+    while (cursor.next(edge)) {}
+    TEST_ASSERT_TRUE(cursor.faulted());
+
+    buffer.bytes[0] = 'X';
+    TEST_ASSERT_FALSE(Reader(buffer.bytes, buffer.length).valid());
+    Reader notACapture(buffer.bytes, buffer.length);
+    TEST_ASSERT_FALSE(notACapture.begin().next(edge));
+    buffer.bytes[0] = 'E';
+    buffer.bytes[4] = Capture::VERSION + 1;
+    TEST_ASSERT_FALSE(Reader(buffer.bytes, buffer.length).valid());
+}
+
+// Edges of 2^31 us or more are split, zero-length edges dropped, an empty capture is a header
+void test_long_and_empty_edges()
+{
+    Capture::Writer<BufferSink, SMALL_BLOCK_BYTES> writer(buffer);
+    writer.add(1, 0);
+    writer.add(1, 0xC0000000UL);
+    writer.add(0, 5);
+    writer.finish();
+
+    Reader reader(buffer.bytes, buffer.length);
+    auto cursor = reader.begin();
+    TEST_ASSERT_EQUAL_UINT32(3, static_cast<uint32_t>(reader.edgeCount()));
+    expectEdge(cursor, 1, Capture::MAX_EDGE_US);
+    expectEdge(cursor, 1, 0xC0000000UL - Capture::MAX_EDGE_US);
+    expectEdge(cursor, 0, 5);
+
+    buffer = BufferSink{};
+    Capture::Writer<BufferSink, SMALL_BLOCK_BYTES> empty(buffer);
+    empty.finish();
+    TEST_ASSERT_EQUAL_UINT32(Capture::FILE_HEADER_BYTES, buffer.length);
+    TEST_ASSERT_TRUE(Reader(buffer.bytes, buffer.length).valid());
+    TEST_ASSERT_EQUAL_UINT32(0, static_cast<uint32_t>(Reader(buffer.bytes, buffer.length).edgeCount()));
+}
+
+// Header skipped, negative time, repeated levels merged, a row going back in time dropped
+void test_csv_converter()
+{
+    convert<Capture::CsvConverter>("Time [s],Channel 0,Channel 1\n"
+                                   "-0.000100,0,1\n"
+                                   "0.000200,1,0\n"
+                                   "0.000250,1,1\n"
+                                   "0.000150,0,0\n"
+                                   "0.001700,0,1\n"
+                                   "0.0025,1\n");
+    Reader reader(buffer.bytes, buffer.length);
+    auto cursor = reader.begin();
+    expectEdge(cursor, 0, 300);
+    expectEdge(cursor, 1, 1500);
+    expectEdge(cursor, 0, 800);
+    Waveform::Edge none{0, 0};
+    TEST_ASSERT_FALSE(cursor.next(none));                       // The last level has no duration yet
+}
+
+// 1 us timescale, x read as 0, a vector and a second wire skipped
+void test_vcd_converter()
+{
+    convert<Capture::VcdConverter>("$date today $end\n$timescale 1us $end\n"
+                                   "$var wire 1 # gdo0 $end\n$var wire 8 % bus $end\n$var wire 1 & other $end\n"
+                                   "$enddefinitions $end\n"
+                                   "#0\n1#\nb1010 %\n#300\nx#\n1&\n#2500\n1#\n#2800\n0#\n");
+    Reader reader(buffer.bytes, buffer.length);
+    auto cursor = reader.begin();
+    expectEdge(cursor, 1, 300);
+    expectEdge(cursor, 0, 2200);
+    expectEdge(cursor, 1, 300);
+    Waveform::Edge none{0, 0};
+    TEST_ASSERT_FALSE(cursor.next(none));
+}
+
+// The dump's last timestamp, with no change at it, ends the last level
+void test_vcd_last_timestamp_closes_the_last_edge()
+{
+    convert<Capture::VcdConverter>("$timescale 10ns $end\n$var wire 1 ! gdo0 $end\n$enddefinitions $end\n"
+                                   "#0\n0!\n#3000\n1!\n#4000\n#3900\n");
+    Reader reader(buffer.bytes, buffer.length);
+    auto cursor = reader.begin();
+    expectEdge(cursor, 0, 30);
+    expectEdge(cursor, 1, 10);                                  // #3900 goes back in time: ignored
+    Waveform::Edge none{0, 0};
+    TEST_ASSERT_FALSE(cursor.next(none));
+}
+
+// The simulator reads a capture of the compiled burst exactly like the program itself
+void test_simulator_reads_captures()
+{
+    capture<CAPTURE_BLOCK_BYTES>(openDoorProgram());
+    TEST_ASSERT_FALSE(buffer.overflow);
+
+    ReceiverParams typical{ RECEIVER_TOLERANCE_PCT, RECEIVER_SYNC_MIN_US, RECEIVER_WORDS_REQUIRED, RECEIVER_WINDOW_WORDS };
+    AcceptanceScenario noisy{ { 100, 50, 20, 200 }, typical };
+    AcceptanceResult fromProgram = AcceptanceSimulator::run(noisy, 20, 3);
+    AcceptanceResult fromCapture = AcceptanceSimulator::runCapture(noisy, 20, buffer.bytes, buffer.length, 3);
+    TEST_ASSERT_EQUAL_MEMORY(&fromProgram, &fromCapture, sizeof(fromProgram));
+}
+
+void setup()
+{
+    delay(2000);                                                // The board resets when the runner opens the port
+
+    UNITY_BEGIN();
+    RUN_TEST(test_recording_round_trip_small_blocks);
+    RUN_TEST(test_recording_round_trip_firmware_blocks);
+    RUN_TEST(test_exported_lines_read_back);
+    RUN_TEST(test_seek_lands_on_the_edge_on_air);
+    RUN_TEST(test_truncated_capture);
+    RUN_TEST(test_damaged_capture);
+    RUN_TEST(test_long_and_empty_edges);
+    RUN_TEST(test_csv_converter);
+    RUN_TEST(test_vcd_converter);
+    RUN_TEST(test_vcd_last_timestamp_closes_the_last_edge);
+    RUN_TEST(test_simulator_reads_captures);
+    UNITY_END();
+}
+
+void loop() {}
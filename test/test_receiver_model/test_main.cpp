@@ -0,0 +1,254 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+#include "Simulation/ReceiverModel.h"
+#include "Simulation/AcceptanceSimulator.h"
+#include "Waveform/WaveformCompiler.h"
+#include "App/RemotePrograms.h"
+#include "Policies/PROGMEMStoragePolicy.h"
+#include "../test_code_families/golden_waveforms.h"
+
+// The receiver model on the recorded open-door burst (golden waveform, not the compiler's output)
+// and on spoiled copies of it, then the Monte Carlo runs of AcceptanceSimulator.
+namespace
+{
+    using Family   = CodeFamilies::SC41344_8Bit;
+    using Receiver = SC41344Receiver<Family::WORD_BITS>;
+
+    constexpr ReceiverParams TYPICAL{ RECEIVER_TOLERANCE_PCT, RECEIVER_SYNC_MIN_US, RECEIVER_WORDS_REQUIRED, RECEIVER_WINDOW_WORDS };
+    constexpr uint32_t OPEN_DOOR_WORD = 0xD8;                   // 1 1 0 1 1 0 0 0
+    constexpr uint16_t TRIALS  = 50;
+
+    // Another code of the same family, compiled at build time into RAM
+    constexpr uint8_t OTHER_CODE[8] = { 0, 1, 0, 1, 0, 0, 1, 1 };
+    constexpr Waveform::Program OTHER = Waveform::compile<Family>(OTHER_CODE);
+    static_assert(!OTHER.overflow, "Test program does not fit");
+
+    /// @brief Run i of the recorded burst after edit(), which may change its width
+    template<typename Edit>
+    void feedGolden(Receiver& receiver, Edit edit)
+    {
+        const Golden::Waveform& golden = Golden::SC41344_8;
+        for (uint16_t i = 0; i < golden.count; ++i)
+        {
+            uint8_t  level = golden.firstLevel ^ (i & 1);
+            uint32_t us    = edit(i, level, pgm_read_word(golden.runs + i));
+            receiver.feed(level, us);
+        }
+        receiver.finish();
+    }
+
+    void feedGolden(Receiver& receiver) { feedGolden(receiver, [](uint16_t, uint8_t, uint32_t us) { return us; }); }
+
+    /// @brief Scales the data pulses by percent, the syncs stay as recorded
+    uint32_t scaled(uint32_t us, uint16_t percent) { return (us >= RECEIVER_SYNC_MIN_US) ? us : us * percent / 100; }
+
+    /// @brief When a receiver decides on word `words` of the recording: syncMinUs into the gap after it
+    uint32_t decidedAtUs(uint8_t words)
+    {
+        const Golden::Waveform& golden = Golden::SC41344_8;
+        uint32_t startUs = 0;
+        uint8_t  syncs   = 0;                                   // The lead-in is sync 0
+        for (uint16_t i = 0; i < golden.count; ++i)
+        {
+            uint16_t us = pgm_read_word(golden.runs + i);
+            if (!(golden.firstLevel ^ (i & 1)) && us >= RECEIVER_SYNC_MIN_US && syncs++ == words) break;
+            startUs += us;
+        }
+        return startUs + RECEIVER_SYNC_MIN_US;
+    }
+
+    uint32_t cleanAcceptedAtUs()
+    {
+        Receiver receiver(TYPICAL);
+        feedGolden(receiver);
+        return receiver.acceptedAtUs();
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_accepts_recorded_burst()
+{
+    Receiver receiver(TYPICAL);
+    feedGolden(receiver);
+
+    TEST_ASSERT_TRUE(receiver.accepted());
+    TEST_ASSERT_EQUAL_HEX32(OPEN_DOOR_WORD, receiver.acceptedWord());
+    TEST_ASSERT_EQUAL_UINT8(AcceptanceResult::MAX_WORDS, receiver.wordSlots());
+    TEST_ASSERT_EQUAL_UINT32(decidedAtUs(RECEIVER_WORDS_REQUIRED), receiver.acceptedAtUs());
+}
+
+void test_compiled_program_decodes_like_recording()
+{
+    Receiver receiver(TYPICAL);
+    Waveform::Interpreter<PROGMEMStoragePolicy> interpreter(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size());
+    Waveform::Edge edge{0, 0};
+    while (interpreter.next(edge)) receiver.feed(edge.level, edge.durationUs);
+    receiver.finish();
+
+    TEST_ASSERT_TRUE(receiver.accepted());
+    TEST_ASSERT_EQUAL_HEX32(OPEN_DOOR_WORD, receiver.acceptedWord());
+    TEST_ASSERT_EQUAL_UINT32(cleanAcceptedAtUs(), receiver.acceptedAtUs());
+}
+
+// Pieces of one pulse (a channel split) are the same pulse for the decoder
+void test_split_pulses_merge()
+{
+    Receiver receiver(TYPICAL);
+    const Golden::Waveform& golden = Golden::SC41344_8;
+    for (uint16_t i = 0; i < golden.count; ++i)
+    {
+        uint8_t  level = golden.firstLevel ^ (i & 1);
+        uint16_t us    = pgm_read_word(golden.runs + i);
+        receiver.feed(level, us / 3);
+        receiver.feed(level, 0);
+        receiver.feed(level, us - us / 3);
+    }
+    receiver.finish();
+
+    TEST_ASSERT_TRUE(receiver.accepted());
+    TEST_ASSERT_EQUAL_UINT32(cleanAcceptedAtUs(), receiver.acceptedAtUs());
+}
+
+void test_decodes_the_word_sent()
+{
+    Receiver receiver(TYPICAL);
+    Waveform::Interpreter<RAMStoragePolicy> interpreter(OTHER.bytes.data(), OTHER.length);
+    Waveform::Edge edge{0, 0};
+    while (interpreter.next(edge)) receiver.feed(edge.level, edge.durationUs);
+    receiver.finish();
+
+    TEST_ASSERT_TRUE(receiver.accepted());
+    TEST_ASSERT_EQUAL_HEX32(0x53, receiver.acceptedWord());
+}
+
+void test_tolerance_window()
+{
+    uint16_t inside  = 100 + RECEIVER_TOLERANCE_PCT - 5;
+    uint16_t outside = 100 + RECEIVER_TOLERANCE_PCT + 5;
+
+    Receiver slow(TYPICAL);
+    feedGolden(slow, [&](uint16_t, uint8_t, uint32_t us) { return scaled(us, inside); });
+    TEST_ASSERT_TRUE(slow.accepted());
+    TEST_ASSERT_EQUAL_HEX32(OPEN_DOOR_WORD, slow.acceptedWord());
+
+    Receiver fast(TYPICAL);
+    feedGolden(fast, [&](uint16_t, uint8_t, uint32_t us) { return scaled(us, 200 - inside); });
+    TEST_ASSERT_TRUE(fast.accepted());
+
+    Receiver tooSlow(TYPICAL);
+    feedGolden(tooSlow, [&](uint16_t, uint8_t, uint32_t us) { return scaled(us, outside); });
+    TEST_ASSERT_FALSE(tooSlow.accepted());
+    TEST_ASSERT_EQUAL_UINT8(AcceptanceResult::MAX_WORDS, tooSlow.wordSlots());        // Slots seen, none valid
+
+    Receiver tooFast(TYPICAL);
+    feedGolden(tooFast, [&](uint16_t, uint8_t, uint32_t us) { return scaled(us, 200 - outside); });
+    TEST_ASSERT_FALSE(tooFast.accepted());
+}
+
+// No LOW long enough to sync: the receiver never leaves hunting
+void test_no_sync_no_word()
+{
+    Receiver receiver(TYPICAL);
+    feedGolden(receiver, [](uint16_t, uint8_t level, uint32_t us) { return (!level && us >= RECEIVER_SYNC_MIN_US) ? RECEIVER_SYNC_MIN_US - 1 : us; });
+    TEST_ASSERT_FALSE(receiver.accepted());                     // finish() syncs once, after the last word
+
+    // Without finish() not even a slot opens
+    Receiver hunting(TYPICAL);
+    const Golden::Waveform& golden = Golden::SC41344_8;
+    for (uint16_t i = 0; i < golden.count; ++i)
+    {
+        uint8_t  level = golden.firstLevel ^ (i & 1);
+        uint32_t us    = pgm_read_word(golden.runs + i);
+        hunting.feed(level, (!level && us >= RECEIVER_SYNC_MIN_US) ? RECEIVER_SYNC_MIN_US - 1 : us);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, hunting.wordSlots());
+    TEST_ASSERT_FALSE(hunting.accepted());
+}
+
+// N of M: one spoiled word delays acceptance by a word, too many spoiled words prevent it
+void test_n_of_m_matching()
+{
+    // The first HIGH of word 1 (long) cut to 1000 us, its LOW takes the rest: same timeline
+    auto spoilFirstWord = [](uint16_t i, uint8_t, uint32_t us) { return (i == 1) ? 1000u : (i == 2) ? us + LONG_HIGH_US - 1000u : us; };
+
+    Receiver receiver(TYPICAL);
+    feedGolden(receiver, spoilFirstWord);
+    TEST_ASSERT_TRUE(receiver.accepted());
+    TEST_ASSERT_EQUAL_HEX32(OPEN_DOOR_WORD, receiver.acceptedWord());
+    TEST_ASSERT_EQUAL_UINT32(decidedAtUs(RECEIVER_WORDS_REQUIRED + 1), receiver.acceptedAtUs());
+
+    ReceiverParams allWords = TYPICAL;
+    allWords.wordsRequired = AcceptanceResult::MAX_WORDS;
+    Receiver strict(allWords);
+    feedGolden(strict, spoilFirstWord);
+    TEST_ASSERT_FALSE(strict.accepted());
+
+    Receiver strictClean(allWords);
+    feedGolden(strictClean);
+    TEST_ASSERT_TRUE(strictClean.accepted());
+}
+
+void test_simulator_clean_channel()
+{
+    AcceptanceScenario clean{ { 0, 0, 0, 0 }, TYPICAL };
+    AcceptanceResult result = AcceptanceSimulator::run(clean, TRIALS, 1);
+
+    TEST_ASSERT_EQUAL_UINT16(TRIALS, result.trials);
+    TEST_ASSERT_EQUAL_UINT16(0, result.wrongWord);
+    for (uint8_t words = 1; words <= AcceptanceResult::MAX_WORDS; ++words)
+    {
+        TEST_ASSERT_EQUAL_UINT16(words < RECEIVER_WORDS_REQUIRED ? 0 : TRIALS, result.accepted[words - 1]);
+    }
+}
+
+// Same seed, same noise; more words sent never lowers acceptance; a tight receiver loses to jitter
+void test_simulator_reproducible()
+{
+    AcceptanceScenario noisy{ { 200, 100, 20, 500 }, TYPICAL };
+    AcceptanceResult first  = AcceptanceSimulator::run(noisy, TRIALS, 7);
+    AcceptanceResult second = AcceptanceSimulator::run(noisy, TRIALS, 7);
+    TEST_ASSERT_EQUAL_MEMORY(&first, &second, sizeof(first));
+
+    for (uint8_t words = 1; words < AcceptanceResult::MAX_WORDS; ++words)
+    {
+        TEST_ASSERT_LESS_OR_EQUAL_UINT16(first.accepted[words], first.accepted[words - 1]);
+    }
+
+    AcceptanceScenario tight{ { 200, 0, 0, 0 }, { 5, RECEIVER_SYNC_MIN_US, RECEIVER_WORDS_REQUIRED, RECEIVER_WINDOW_WORDS } };
+    AcceptanceResult lost = AcceptanceSimulator::run(tight, TRIALS, 7);
+    TEST_ASSERT_LESS_THAN_UINT16(TRIALS / 10, lost.accepted[AcceptanceResult::MAX_WORDS - 1]);
+}
+
+void test_carrier_on_time_grows_with_words()
+{
+    TEST_ASSERT_EQUAL_UINT32(0, AcceptanceSimulator::carrierOnUs(0));
+    for (uint8_t words = 1; words <= AcceptanceResult::MAX_WORDS; ++words)
+    {
+        TEST_ASSERT_GREATER_THAN_UINT32(AcceptanceSimulator::carrierOnUs(words - 1), AcceptanceSimulator::carrierOnUs(words));
+        TEST_ASSERT_LESS_THAN_UINT32(AcceptanceSimulator::airtimeUs(words), AcceptanceSimulator::carrierOnUs(words));
+    }
+}
+
+void setup()
+{
+    delay(2000);                                                // The board resets when the runner opens the port
+
+    UNITY_BEGIN();
+    RUN_TEST(test_accepts_recorded_burst);
+    RUN_TEST(test_compiled_program_decodes_like_recording);
+    RUN_TEST(test_split_pulses_merge);
+    RUN_TEST(test_decodes_the_word_sent);
+    RUN_TEST(test_tolerance_window);
+    RUN_TEST(test_no_sync_no_word);
+    RUN_TEST(test_n_of_m_matching);
+    RUN_TEST(test_simulator_clean_channel);
+    RUN_TEST(test_simulator_reproducible);
+    RUN_TEST(test_carrier_on_time_grows_with_words);
+    UNITY_END();
+}
+
+void loop() {}
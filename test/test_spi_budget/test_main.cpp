@@ -0,0 +1,39 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "Config/Constants.h"
+#include "Config/DigitalPin.h"
+#include "Config/TransceiverConfig.h"
+#include "SPI/SPIBus.h"
+#include "Transciever/CC1101_Transceiver.h"
+#include "Encoder/SC41344_Encoder.h"
+#include "Delay/Timebase.h"
+#include "Debugging/SpiBudget.h"
+
+// The radio the firmware drives: CC1101 on CSN_PIN, the burst on GDO0 (D8)
+SPIBus spiBus(CSN_PIN);
+TransceiverConfig config(FREQ_315MHZ_BAND, ModulationScheme::OOK, OutputPowerLevels::HIGH_POWER);
+Transceiver transceiver(spiBus, config);
+DigitalPin gdo0Pin('B', static_cast<uint8_t>(GDO0_PORT_BIT));
+SC41344_Encoder encoder(gdo0Pin);
+
+void setUp() {}
+void tearDown() {}
+
+// Every operation of the firmware stays within the SPI traffic budget of Debugging/SpiBudget.h
+// (the same operations run against a CC1101 model on the host: tools/spi_budget)
+void test_spi_traffic_within_budget()
+{
+    TEST_ASSERT_TRUE(runSpiBudgetCheck(transceiver, encoder, Serial));
+}
+
+void setup()
+{
+    delay(2000);                                                // The board resets when the runner opens the port
+    Timebase::begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_spi_traffic_within_budget);
+    UNITY_END();
+}
+
+void loop() {}
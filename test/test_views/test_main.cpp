@@ -0,0 +1,219 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+#include <stdlib.h>
+#include "avr_algorithms.hpp"
+#include "Policies/PROGMEMStoragePolicy.h"
+#include "Debugging/ViewsBenchmark.h"
+
+namespace views = avr_algorithms::views;
+
+// Every view against the loop it replaces, on data only known at run time (the conformance block
+// of avr_views.hpp covers the constexpr side), then the benchmark pairs of Debugging/ViewsBenchmark.
+namespace
+{
+    const uint8_t FLASH_BYTES[] PROGMEM = { 0x3C, 0xA5, 0x00, 0xFF, 0x81, 0x7E, 0x12, 0xED, 0x55 };
+
+    uint8_t bytes[9];
+    uint8_t length;
+
+    uint8_t handBit(const uint8_t* data, size_t i) { return (data[i >> 3] >> (7 - (i & 7))) & 1; }
+
+    /// @brief Collects the lines runViewsBenchmark() prints
+    class LineBuffer : public Print
+    {
+        public:
+
+        size_t write(uint8_t c) override
+        {
+            if (c == '\r') return 1;
+            if (c == '\n') { _line[_length] = '\0'; _length = 0; onLine(_line); return 1; }
+            if (_length < sizeof(_line) - 1) _line[_length++] = static_cast<char>(c);
+            return 1;
+        }
+
+        uint8_t lines = 0;
+        uint8_t differing = 0;
+        uint8_t slower = 0;                                     // Views more than 1.5 x the hand loop
+
+        private:
+
+        // "<case> hand=<cycles> views=<cycles> <same|DIFF>"
+        void onLine(const char* line)
+        {
+            const char* hand  = strstr(line, "hand=");
+            const char* lazy  = strstr(line, "views=");
+            if (!hand || !lazy) return;
+            ++lines;
+            if (!strstr(line, " same")) ++differing;
+            unsigned long handCycles  = strtoul(hand + 5, nullptr, 10);
+            unsigned long viewsCycles = strtoul(lazy + 6, nullptr, 10);
+            if (viewsCycles > handCycles + handCycles / 2) ++slower;
+        }
+
+        char    _line[64];
+        uint8_t _length = 0;
+    };
+}
+
+void setUp()
+{
+    length = sizeof(bytes);
+    for (uint8_t i = 0; i < length; ++i) bytes[i] = PROGMEMStoragePolicy::read(FLASH_BYTES + i);
+}
+
+void tearDown() {}
+
+void test_bits_msb_first()
+{
+    size_t i = 0;
+    uint8_t mismatches = 0;
+    views::bits(bytes, 8 * length).for_each([&](uint8_t bit) { if (bit != handBit(bytes, i++)) ++mismatches; });
+
+    TEST_ASSERT_EQUAL_UINT32(8 * length, i);
+    TEST_ASSERT_EQUAL_UINT8(0, mismatches);
+    TEST_ASSERT_EQUAL_UINT32(5, views::bits(bytes, 5).count());                 // 0x3C: 0 0 1 1 1
+    TEST_ASSERT_EQUAL_UINT32(3, views::bits(bytes, 5).count_if([](uint8_t b) { return b != 0; }));
+}
+
+void test_packed_fields_and_index_agree()
+{
+    views::packed_view<2> pairs(bytes, 4 * length);
+    size_t i = 0;
+    uint8_t mismatches = 0;
+    pairs.for_each([&](uint8_t field) {
+        uint8_t hand = (bytes[i / 4] >> (6 - 2 * (i % 4))) & 0x03;
+        if (field != hand || field != pairs[i]) ++mismatches;
+        ++i;
+    });
+
+    TEST_ASSERT_EQUAL_UINT32(4 * length, i);
+    TEST_ASSERT_EQUAL_UINT8(0, mismatches);
+}
+
+void test_nibbles_to_hex()
+{
+    char hex[2 * sizeof(bytes)];
+    size_t written = (views::nibbles(bytes, length)
+                      | views::transform([](uint8_t n) { return static_cast<char>(n < 10 ? '0' + n : 'A' + n - 10); }))
+                     .copy_to(hex, sizeof(hex));
+
+    TEST_ASSERT_EQUAL_UINT32(2 * length, written);
+    TEST_ASSERT_EQUAL_MEMORY("3CA500FF817E12ED55", hex, sizeof(hex));
+}
+
+void test_stored_reads_through_policy()
+{
+    uint8_t copy[sizeof(FLASH_BYTES)] = {};
+    size_t written = views::stored<PROGMEMStoragePolicy>(FLASH_BYTES, sizeof(FLASH_BYTES)).copy_to(copy, sizeof(copy));
+
+    TEST_ASSERT_EQUAL_UINT32(sizeof(FLASH_BYTES), written);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(bytes, copy, sizeof(copy));
+    TEST_ASSERT_EQUAL_UINT8(0x3C ^ 0xA5 ^ 0x00 ^ 0xFF ^ 0x81 ^ 0x7E ^ 0x12 ^ 0xED ^ 0x55,
+                            views::stored<PROGMEMStoragePolicy>(FLASH_BYTES, sizeof(FLASH_BYTES)).fold(uint8_t{0}, [](uint8_t acc, uint8_t b) { return static_cast<uint8_t>(acc ^ b); }));
+}
+
+void test_filter_then_take_stops_the_source()
+{
+    size_t reads = 0;
+    auto counted = views::span(bytes, length) | views::transform([&](uint8_t b) { ++reads; return b; });
+    uint16_t sum = (counted | views::filter([](uint8_t b) { return b > 0x80; }) | views::take(2))
+                   .fold(uint16_t{0}, [](uint16_t acc, uint8_t b) { return static_cast<uint16_t>(acc + b); });
+
+    TEST_ASSERT_EQUAL_UINT16(0xA5 + 0xFF, sum);
+    TEST_ASSERT_EQUAL_UINT32(4, reads);                                         // 0x3C 0xA5 0x00 0xFF, nothing after the second match
+}
+
+void test_take_limits()
+{
+    TEST_ASSERT_EQUAL_UINT32(0, (views::span(bytes, length) | views::take(0)).count());
+    TEST_ASSERT_EQUAL_UINT32(length, (views::span(bytes, length) | views::take(100)).count());
+    TEST_ASSERT_EQUAL_UINT32(3, (views::span(bytes, length) | views::take(3)).count());
+}
+
+void test_enumerate_counts_positions()
+{
+    size_t expected = 0;
+    uint8_t mismatches = 0;
+    (views::span(bytes, length) | views::filter([](uint8_t b) { return b != 0; }) | views::enumerate())
+        .for_each([&](const auto& e) { if (e.index != expected++) ++mismatches; });
+
+    TEST_ASSERT_EQUAL_UINT32(length - 1, expected);                             // One zero byte filtered out
+    TEST_ASSERT_EQUAL_UINT8(0, mismatches);
+}
+
+void test_chunk_full_and_tail()
+{
+    uint8_t sizes[4] = {};
+    uint8_t firsts[4] = {};
+    uint8_t chunks = 0;
+    (views::span(bytes, length) | views::chunk<4>()).for_each([&](const auto& c) {
+        if (chunks < 4) { sizes[chunks] = c.size; firsts[chunks] = c.item[0]; }
+        ++chunks;
+    });
+
+    TEST_ASSERT_EQUAL_UINT8(3, chunks);
+    TEST_ASSERT_EQUAL_UINT8(4, sizes[0]);
+    TEST_ASSERT_EQUAL_UINT8(4, sizes[1]);
+    TEST_ASSERT_EQUAL_UINT8(1, sizes[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x81, firsts[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x55, firsts[2]);
+
+    // A sink that stops on the first chunk does not get the tail
+    chunks = 0;
+    bool completed = (views::span(bytes, length) | views::chunk<4>()).for_each_until([&](const auto&) { ++chunks; return false; });
+    TEST_ASSERT_FALSE(completed);
+    TEST_ASSERT_EQUAL_UINT8(1, chunks);
+}
+
+void test_zip_stops_at_shorter()
+{
+    uint8_t other[5];
+    memcpy(other, bytes, sizeof(other));
+    other[3] ^= 0x10;
+
+    auto pairs = views::zip(views::span(bytes, length), views::span(other, sizeof(other)));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(other), pairs.count());
+    TEST_ASSERT_EQUAL_UINT32(1, pairs.count_if([](const auto& p) { return p.first != p.second; }));
+}
+
+void test_copy_to_respects_capacity()
+{
+    uint8_t out[4] = { 0xEE, 0xEE, 0xEE, 0xEE };
+    TEST_ASSERT_EQUAL_UINT32(3, views::span(bytes, length).copy_to(out, 3));
+    TEST_ASSERT_EQUAL_UINT8(0xEE, out[3]);
+    TEST_ASSERT_EQUAL_UINT32(0, views::span(bytes, length).copy_to(out, 0));
+}
+
+// The benchmark pairs compute the same results, and the views stay close to the hand loops
+void test_benchmark_pairs()
+{
+    LineBuffer lines;
+    runViewsBenchmark(lines);
+
+    TEST_ASSERT_EQUAL_UINT8(4, lines.lines);
+    TEST_ASSERT_EQUAL_UINT8(0, lines.differing);
+    TEST_ASSERT_EQUAL_UINT8(0, lines.slower);
+}
+
+void setup()
+{
+    delay(2000);                                                // The board resets when the runner opens the port
+
+    UNITY_BEGIN();
+    RUN_TEST(test_bits_msb_first);
+    RUN_TEST(test_packed_fields_and_index_agree);
+    RUN_TEST(test_nibbles_to_hex);
+    RUN_TEST(test_stored_reads_through_policy);
+    RUN_TEST(test_filter_then_take_stops_the_source);
+    RUN_TEST(test_take_limits);
+    RUN_TEST(test_enumerate_counts_positions);
+    RUN_TEST(test_chunk_full_and_tail);
+    RUN_TEST(test_zip_stops_at_shorter);
+    RUN_TEST(test_copy_to_respects_capacity);
+    RUN_TEST(test_benchmark_pairs);
+    UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,237 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <avr/pgmspace.h>
+#include "Config/DigitalPin.h"
+#include "Waveform/WaveformBytecode.h"
+#include "Waveform/WaveformCompiler.h"
+#include "Waveform/WaveformPlayer.h"
+#include "App/RemotePrograms.h"
+#include "Delay/Timebase.h"
+#include "../test_code_families/golden_waveforms.h"
+
+namespace
+{
+    using namespace Waveform;
+
+    // Programs of the golden codes, compiled like RemotePrograms and kept in flash
+    constexpr Program SC41344_12 = compile<CodeFamilies::SC41344_12Bit>(Golden::SC41344_12_CODE);
+    constexpr Program SC41344_24 = compile<CodeFamilies::SC41344_24Bit>(Golden::SC41344_24_CODE);
+    constexpr Program EV1527     = compile<CodeFamilies::EV1527>(Golden::EV1527_CODE);
+    static_assert(!SC41344_12.overflow && !SC41344_24.overflow && !EV1527.overflow, "Test programs do not fit");
+
+    const std::array<uint8_t, SC41344_12.length> SC41344_12_PROGRAM PROGMEM = trim<SC41344_12.length>(SC41344_12);
+    const std::array<uint8_t, SC41344_24.length> SC41344_24_PROGRAM PROGMEM = trim<SC41344_24.length>(SC41344_24);
+    const std::array<uint8_t, EV1527.length>     EV1527_PROGRAM     PROGMEM = trim<EV1527.length>(EV1527);
+
+    // Deepest call chain between two edges: 4 RETURNs out of D, 4 SYMBOLs back in, then the edge
+    //   [entry 17][A 1: SYMBOL B, RETURN][B 4: SYMBOL C, RETURN][C 7: SYMBOL D, RETURN]
+    //   [D 10: HIGH 300, LOW 300, RETURN][main 17: SYMBOL A x 8, END HIGH]
+    static_assert(WAVEFORM_MAX_DEPTH == 4, "WORST_CASE nests exactly WAVEFORM_MAX_DEPTH calls");
+    const uint8_t WORST_CASE[] PROGMEM =
+    {
+        17,
+        Op::SYMBOL, 4, Op::RETURN,
+        Op::SYMBOL, 7, Op::RETURN,
+        Op::SYMBOL, 10, Op::RETURN,
+        Op::LEVEL_HIGH, 0x2C, 0x01, Op::LEVEL_LOW, 0x2C, 0x01, Op::RETURN,
+        Op::SYMBOL, 1, Op::SYMBOL, 1, Op::SYMBOL, 1, Op::SYMBOL, 1,
+        Op::SYMBOL, 1, Op::SYMBOL, 1, Op::SYMBOL, 1, Op::SYMBOL, 1,
+        Op::END, 1
+    };
+
+    // The per-edge bound of WaveformBytecode.h: ~400 cycles, 25 us at 16 MHz (0.5 us Timer1 ticks)
+    constexpr uint16_t MAX_EDGE_COST_TICKS = 50;
+
+    // D5 (PD5, nothing connected): D8 is the CC1101's GDO0, an output of the chip until configured
+    DigitalPin outputPin('D', 5);
+    WaveformPlayer player(outputPin);
+
+    /// @brief Interprets a PROGMEM program with every check on and compares its runs with a golden waveform
+    void expectRuns(const uint8_t* program, uint8_t length, const Golden::Waveform& golden, uint8_t idleLevel)
+    {
+        Interpreter<PROGMEMStoragePolicy> interpreter(program, length);
+        Edge edge{0, 0};
+        uint16_t run = 0;
+        uint8_t  level = 0;
+        uint32_t widthUs = 0;
+        bool     open = false;
+
+        // Edges of the same level add up to one run, as on the pin
+        auto close = [&]()
+        {
+            if (!open) return;
+            TEST_ASSERT_TRUE_MESSAGE(run < golden.count, "more runs than the golden waveform");
+            if (run >= golden.count) return;
+            TEST_ASSERT_EQUAL_UINT8(golden.firstLevel ^ (run & 1), level);
+            TEST_ASSERT_EQUAL_UINT32(pgm_read_word(golden.runs + run), widthUs);
+            ++run;
+        };
+
+        while (interpreter.next(edge))
+        {
+            if (open && edge.level == level) { widthUs += edge.durationUs; continue; }
+            close();
+            level   = edge.level;
+            widthUs = edge.durationUs;
+            open    = true;
+        }
+        if (level != idleLevel) close();                        // A last run at the idle level merges into idle
+
+        TEST_ASSERT_FALSE(interpreter.faulted());
+        TEST_ASSERT_EQUAL_UINT8(idleLevel, interpreter.idleLevel());
+        TEST_ASSERT_EQUAL_UINT16(golden.count, run);
+    }
+
+    /// @brief validate() of a RAM program
+    Verdict verdictOf(const uint8_t* program, uint8_t length)
+    {
+        return validate<RAMStoragePolicy>(program, length);
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ---------------------------------------------------------------------------------
+//  Compiled programs replay the golden waveforms
+// ---------------------------------------------------------------------------------
+
+// A few dozen bytes: under a quarter of the same burst as a table of 16-bit pulse widths
+void test_open_door_program_is_compact()
+{
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(Golden::SC41344_8.count * sizeof(uint16_t) / 4, REMOTE1_OPEN_DOOR_PROGRAM.size());
+}
+
+void test_open_door_program_matches_recording()
+{
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(Golden::SC41344_8_CODE, REMOTE1_OPEN_DOOR_CODE, 8);
+    expectRuns(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size(), Golden::SC41344_8, HIGH);
+}
+
+void test_family_programs_match_goldens()
+{
+    expectRuns(SC41344_12_PROGRAM.data(), SC41344_12_PROGRAM.size(), Golden::SC41344_12, HIGH);
+    expectRuns(SC41344_24_PROGRAM.data(), SC41344_24_PROGRAM.size(), Golden::SC41344_24, HIGH);
+    expectRuns(EV1527_PROGRAM.data(), EV1527_PROGRAM.size(), Golden::EV1527, LOW);
+}
+
+// ---------------------------------------------------------------------------------
+//  validate(): every verdict, and the faults the checked interpreter must catch
+// ---------------------------------------------------------------------------------
+
+void test_validate_accepts_a_minimal_program()
+{
+    const uint8_t program[] = { 1, Op::LEVEL_HIGH, 0x2C, 0x01, Op::END, 1 };
+    TEST_ASSERT_TRUE(verdictOf(program, sizeof(program)) == Verdict::Ok);
+}
+
+void test_validate_refuses_empty_program()
+{
+    const uint8_t program[] = { 1, Op::END, 0 };
+    TEST_ASSERT_TRUE(verdictOf(program, sizeof(program)) == Verdict::Empty);
+    TEST_ASSERT_TRUE(verdictOf(program, 0) == Verdict::Malformed);
+}
+
+void test_validate_refuses_pulse_limits()
+{
+    const uint8_t tooShort[] = { 1, Op::LEVEL_HIGH, WAVEFORM_MIN_PULSE_US - 1, 0x00, Op::END, 1 };
+    const uint8_t tooLong[]  = { 1, Op::LEVEL_LOW, 0x31, 0x75, Op::END, 1 };                       // 30001 us
+    const uint8_t burst[]    = { 1, Op::REPEAT, 255, Op::REPEAT, 255, Op::LEVEL_HIGH, 0x30, 0x75,   // 30000 us x 65025
+                                 Op::END_REPEAT, Op::END_REPEAT, Op::END, 1 };
+    static_assert(WAVEFORM_MAX_PULSE_US == 30000, "tooLong / burst are one over / at the longest pulse");
+
+    TEST_ASSERT_TRUE(verdictOf(tooShort, sizeof(tooShort)) == Verdict::PulseTooShort);
+    TEST_ASSERT_TRUE(verdictOf(tooLong, sizeof(tooLong)) == Verdict::PulseTooLong);
+    TEST_ASSERT_TRUE(verdictOf(burst, sizeof(burst)) == Verdict::BurstTooLong);
+}
+
+void test_validate_refuses_malformed_programs()
+{
+    const uint8_t badOpcode[]      = { 1, 0x08, Op::END, 1 };
+    const uint8_t badEntry[]       = { 9, Op::LEVEL_HIGH, 0x2C, 0x01, Op::END, 1 };
+    const uint8_t noEnd[]          = { 1, Op::LEVEL_HIGH, 0x2C, 0x01 };
+    const uint8_t cutOperand[]     = { 1, Op::LEVEL_HIGH, 0x2C };
+    const uint8_t zeroRepeat[]     = { 1, Op::REPEAT, 0, Op::LEVEL_HIGH, 0x2C, 0x01, Op::END_REPEAT, Op::END, 1 };
+    const uint8_t strayEndRepeat[] = { 1, Op::LEVEL_HIGH, 0x2C, 0x01, Op::END_REPEAT, Op::END, 1 };
+    const uint8_t strayReturn[]    = { 1, Op::LEVEL_HIGH, 0x2C, 0x01, Op::RETURN, Op::END, 1 };
+    const uint8_t returnInRepeat[] = { 1, Op::REPEAT, 2, Op::LEVEL_HIGH, 0x2C, 0x01, Op::RETURN, Op::END, 1 };
+    const uint8_t symbolOutside[]  = { 1, Op::SYMBOL, 0xF0, Op::END, 1 };
+    const uint8_t tooDeep[]        = { 1, Op::REPEAT, 2, Op::REPEAT, 2, Op::REPEAT, 2, Op::REPEAT, 2, Op::REPEAT, 2,
+                                       Op::LEVEL_HIGH, 0x2C, 0x01,
+                                       Op::END_REPEAT, Op::END_REPEAT, Op::END_REPEAT, Op::END_REPEAT, Op::END_REPEAT, Op::END, 1 };
+    const uint8_t selfCall[]       = { 1, Op::SYMBOL, 1 };                                          // Recursion until the stack is full
+    const uint8_t emptyRepeat[]    = { 1, Op::LEVEL_HIGH, 0x2C, 0x01, Op::REPEAT, 200, Op::END_REPEAT, Op::END, 1 };   // Over the per-edge budget
+    static_assert(WAVEFORM_MAX_DEPTH == 4, "tooDeep nests one REPEAT more than the stack holds");
+
+    TEST_ASSERT_TRUE(verdictOf(badOpcode, sizeof(badOpcode)) == Verdict::Malformed);
+    TEST_ASSERT_TRUE(verdictOf(badEntry, sizeof(badEntry)) == Verdict::Malformed);
+    TEST_ASSERT_TRUE(verdictOf(noEnd, sizeof(noEnd)) == Verdict::Malformed);
+    TEST_ASSERT_TRUE(verdictOf(cutOperand, sizeof(cutOperand)) == Verdict::Malformed);
+    TEST_ASSERT_TRUE(verdictOf(zeroRepeat, sizeof(zeroRepeat)) == Verdict::Malformed);
+    TEST_ASSERT_TRUE(verdictOf(strayEndRepeat, sizeof(strayEndRepeat)) == Verdict::Malformed);
+    TEST_ASSERT_TRUE(verdictOf(strayReturn, sizeof(strayReturn)) == Verdict::Malformed);
+    TEST_ASSERT_TRUE(verdictOf(returnInRepeat, sizeof(returnInRepeat)) == Verdict::Malformed);
+    TEST_ASSERT_TRUE(verdictOf(symbolOutside, sizeof(symbolOutside)) == Verdict::Malformed);
+    TEST_ASSERT_TRUE(verdictOf(tooDeep, sizeof(tooDeep)) == Verdict::Malformed);
+    TEST_ASSERT_TRUE(verdictOf(selfCall, sizeof(selfCall)) == Verdict::Malformed);
+    TEST_ASSERT_TRUE(verdictOf(emptyRepeat, sizeof(emptyRepeat)) == Verdict::Malformed);
+}
+
+void test_fault_leaves_carrier_off()
+{
+    const uint8_t program[] = { 1, Op::LEVEL_HIGH, 0x2C, 0x01, 0x08 };
+    Interpreter<RAMStoragePolicy> interpreter(program, sizeof(program));
+    Edge edge{0, 0};
+
+    TEST_ASSERT_TRUE(interpreter.next(edge));
+    TEST_ASSERT_FALSE(interpreter.next(edge));
+    TEST_ASSERT_TRUE(interpreter.faulted());
+    TEST_ASSERT_EQUAL_UINT8(0, interpreter.idleLevel());
+}
+
+// ---------------------------------------------------------------------------------
+//  Worst-case cost per edge: op count, then cycles on the air path
+// ---------------------------------------------------------------------------------
+
+void test_worst_case_ops_per_edge()
+{
+    Interpreter<PROGMEMStoragePolicy> interpreter(WORST_CASE, sizeof(WORST_CASE));
+    Edge edge{0, 0};
+    uint8_t worst = 0;
+    while (interpreter.next(edge)) if (interpreter.opsLastEdge() > worst) worst = interpreter.opsLastEdge();
+
+    TEST_ASSERT_FALSE(interpreter.faulted());
+    TEST_ASSERT_EQUAL_UINT8(2 * WAVEFORM_MAX_DEPTH + 1, worst);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(MAX_OPS_PER_EDGE, worst);
+}
+
+void test_worst_case_edge_cost_within_bound()
+{
+    player.play(WORST_CASE, sizeof(WORST_CASE));
+    player.play(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size());
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, player.worstEdgeCostTicks());
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(MAX_EDGE_COST_TICKS, player.worstEdgeCostTicks());
+}
+
+void setup()
+{
+    delay(2000);                                                // The board resets when the runner opens the port
+    Timebase::begin();
+    outputPin.pinConfig(false, false);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_open_door_program_is_compact);
+    RUN_TEST(test_open_door_program_matches_recording);
+    RUN_TEST(test_family_programs_match_goldens);
+    RUN_TEST(test_validate_accepts_a_minimal_program);
+    RUN_TEST(test_validate_refuses_empty_program);
+    RUN_TEST(test_validate_refuses_pulse_limits);
+    RUN_TEST(test_validate_refuses_malformed_programs);
+    RUN_TEST(test_fault_leaves_carrier_off);
+    RUN_TEST(test_worst_case_ops_per_edge);
+    RUN_TEST(test_worst_case_edge_cost_within_bound);
+    UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,44 @@
+#include "AcceptancePool.h"
+#include "JobPool.h"
+#include <vector>
+
+PooledResult& PooledResult::operator+=(const AcceptanceResult& slice)
+{
+    trials += slice.trials;
+    for (uint8_t words = 0; words < AcceptanceResult::MAX_WORDS; ++words) accepted[words] += slice.accepted[words];
+    wrongWord += slice.wrongWord;
+    return *this;
+}
+
+AcceptancePool::AcceptancePool(unsigned threads, const uint8_t* capture, size_t captureBytes):
+_threads(threads),
+_capture(capture),
+_captureBytes(captureBytes)
+{}
+
+PooledResult AcceptancePool::run(const AcceptanceScenario& scenario, uint64_t trials, uint32_t seed) const
+{
+    size_t jobs = static_cast<size_t>((trials + SLICE_TRIALS - 1) / SLICE_TRIALS);
+    std::vector<AcceptanceResult> slices(jobs);
+
+    runJobs(jobs, _threads, [&](size_t job)
+    {
+        uint32_t first = static_cast<uint32_t>(job * SLICE_TRIALS);
+        uint16_t count = static_cast<uint16_t>(trials - first < SLICE_TRIALS ? trials - first : SLICE_TRIALS);
+        slices[job] = _capture ? AcceptanceSimulator::runCapture(scenario, count, _capture, _captureBytes, seed, first)
+                               : AcceptanceSimulator::run(scenario, count, seed, first);
+    });
+
+    PooledResult total{};
+    for (const AcceptanceResult& slice : slices) total += slice;
+    return total;
+}
+
+void AcceptancePool::print(Print& out, uint8_t index, const PooledResult& result)
+{
+    auto permille = [&](uint64_t count) { return static_cast<uint16_t>(result.trials ? count * 1000 / result.trials : 0); };
+    for (uint8_t words = 1; words <= AcceptanceResult::MAX_WORDS; ++words)
+    {
+        AcceptanceSimulator::printLine(out, index, words, permille(result.accepted[words - 1]), permille(result.wrongWord));
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "Simulation/AcceptanceSimulator.h"
+
+/// @brief AcceptanceResult summed over any number of trials
+struct PooledResult
+{
+    uint64_t trials;
+    uint64_t accepted[AcceptanceResult::MAX_WORDS];
+    uint64_t wrongWord;
+
+    PooledResult& operator+=(const AcceptanceResult& slice);
+};
+
+/**
+ * @brief AcceptanceSimulator::run() / runCapture() on a thread pool (JobPool.h).
+ *
+ * The trials are cut into slices of SLICE_TRIALS, one job each, numbered with firstTrial: trial t
+ * gets the seed it gets in a single run, so the totals do not depend on the thread count or on
+ * the slicing, and a run of ACCEPTANCE_SIM_TRIALS matches what the firmware prints.
+ */
+class AcceptancePool
+{
+    public:
+
+    static constexpr uint16_t SLICE_TRIALS = 4096;
+
+    /// @param capture - edge capture to replay instead of the compiled burst, in place (a MappedFile)
+    AcceptancePool(unsigned threads, const uint8_t* capture = nullptr, size_t captureBytes = 0);
+
+    PooledResult run(const AcceptanceScenario& scenario, uint64_t trials, uint32_t seed = 0) const;
+
+    /// @brief The "SIM" lines of one scenario, as runAcceptanceSimulation() prints them
+    static void print(Print& out, uint8_t index, const PooledResult& result);
+
+    private:
+
+    unsigned       _threads;
+    const uint8_t* _capture;
+    size_t         _captureBytes;
+};
@@ -0,0 +1,83 @@
+// Host run of the receiver acceptance simulation (Simulation/AcceptanceSimulator), many more
+// trials than the board can afford, on every core. Prints the lines ACCEPTANCE_SIM_MODE prints.
+//
+//   acceptance_sim [-n trials] [-j threads] [-s seed] [-c capture.ecap] [scenario ...]
+//
+//   -n  trials per scenario (default 100000; ACCEPTANCE_SIM_TRIALS reproduces the board)
+//   -j  worker threads (default: one per hardware thread)
+//   -s  seed (default 0, the board's)
+//   -c  replay an edge capture (Capture/EdgeCapture.h file) instead of the compiled burst
+//   scenario indices to run (default: all of AcceptanceSimulator::scenario())
+#include "AcceptancePool.h"
+#include "MappedFile.h"
+#include <HostBoard.h>
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace
+{
+    void usage()
+    {
+        fprintf(stderr, "usage: acceptance_sim [-n trials] [-j threads] [-s seed] [-c capture.ecap] [scenario ...]\n");
+        exit(2);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t trials  = 100000;
+    unsigned threads = 0;
+    uint32_t seed    = 0;
+    const char* capturePath = nullptr;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:j:s:c:")) != -1)
+    {
+        switch (option)
+        {
+            case 'n': trials  = strtoull(optarg, nullptr, 0); break;
+            case 'j': threads = static_cast<unsigned>(strtoul(optarg, nullptr, 0)); break;
+            case 's': seed    = static_cast<uint32_t>(strtoul(optarg, nullptr, 0)); break;
+            case 'c': capturePath = optarg; break;
+            default:  usage();
+        }
+    }
+
+    std::vector<uint8_t> scenarios;
+    for (int i = optind; i < argc; ++i)
+    {
+        unsigned long index = strtoul(argv[i], nullptr, 0);
+        if (index >= AcceptanceSimulator::scenarioCount()) usage();
+        scenarios.push_back(static_cast<uint8_t>(index));
+    }
+    if (scenarios.empty())
+        for (uint8_t index = 0; index < AcceptanceSimulator::scenarioCount(); ++index) scenarios.push_back(index);
+
+    std::unique_ptr<MappedFile> capture;
+    if (capturePath)
+    {
+        capture.reset(new MappedFile(capturePath));
+        if (!capture->valid())
+        {
+            fprintf(stderr, "acceptance_sim: can not open %s: %s\n", capturePath, strerror(capture->error()));
+            return 1;
+        }
+    }
+
+    hal::reset();
+    AcceptancePool pool(threads, capture ? capture->data() : nullptr, capture ? capture->size() : 0);
+    auto start = std::chrono::steady_clock::now();
+    for (uint8_t index : scenarios)
+    {
+        PooledResult result = pool.run(AcceptanceSimulator::scenario(index), trials, seed);
+        AcceptancePool::print(Serial, index, result);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fprintf(stderr, "%zu scenarios x %llu trials in %.2f s (%.0f trials/s)\n", scenarios.size(),
+            static_cast<unsigned long long>(trials), seconds, seconds > 0 ? scenarios.size() * trials / seconds : 0.0);
+    return 0;
+}
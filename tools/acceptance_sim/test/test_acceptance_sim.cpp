@@ -0,0 +1,146 @@
+// The host acceptance pool against the firmware's own runs: slicing and thread count must not
+// change a result, and a board-sized run prints exactly what ACCEPTANCE_SIM_MODE prints.
+#include "AcceptancePool.h"
+#include <HostBoard.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "App/RemotePrograms.h"
+#include "Capture/EdgeCapture.h"
+#include "Policies/PROGMEMStoragePolicy.h"
+
+namespace
+{
+    int failures = 0;
+
+    #define CHECK(condition) \
+        do { if (!(condition)) { ++failures; fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); } } while (0)
+
+    #define CHECK_EQUAL(expected, actual) \
+        do { auto e_ = (expected); auto a_ = (actual); if (!(e_ == a_)) { ++failures; \
+             fprintf(stderr, "  %s:%d: expected %s, got %s\n", __FILE__, __LINE__, toText(e_).c_str(), toText(a_).c_str()); } } while (0)
+
+    std::string toText(const std::string& value) { return "\"" + value + "\""; }
+    template<typename T> std::string toText(T value) { return std::to_string(value); }
+
+    /// @brief Print into a string
+    struct Text : Print
+    {
+        std::string text;
+        size_t write(uint8_t byte) override { text += static_cast<char>(byte); return 1; }
+    };
+
+    /// @brief Capture::Writer sink into a vector
+    struct Bytes
+    {
+        std::vector<uint8_t> bytes;
+        size_t write(const uint8_t* data, size_t length) { bytes.insert(bytes.end(), data, data + length); return length; }
+    };
+
+    bool same(const PooledResult& a, const PooledResult& b)
+    {
+        return memcmp(&a, &b, sizeof(a)) == 0;
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Tests
+    // ---------------------------------------------------------------------------------
+
+    // The firmware's boot output, on the host: same scenarios, trials and seed
+    void test_board_run_prints_what_the_firmware_prints()
+    {
+        hal::reset();
+        Text firmware;
+        runAcceptanceSimulation(firmware);
+
+        Text pooled;
+        AcceptancePool pool(4);
+        for (uint8_t index = 0; index < AcceptanceSimulator::scenarioCount(); ++index)
+        {
+            AcceptancePool::print(pooled, index, pool.run(AcceptanceSimulator::scenario(index), ACCEPTANCE_SIM_TRIALS));
+        }
+        CHECK(!firmware.text.empty());
+        CHECK_EQUAL(firmware.text, pooled.text);
+    }
+
+    // Trial t gets the same seed in any slice: two firstTrial runs add up to the single run
+    void test_slices_add_up_to_a_single_run()
+    {
+        AcceptanceScenario noisy = AcceptanceSimulator::scenario(5);
+        AcceptanceResult whole = AcceptanceSimulator::run(noisy, 3000, 11);
+
+        PooledResult sliced{};
+        sliced += AcceptanceSimulator::run(noisy, 1000, 11, 0);
+        sliced += AcceptanceSimulator::run(noisy, 2000, 11, 1000);
+
+        CHECK_EQUAL(uint64_t(whole.trials), sliced.trials);
+        CHECK_EQUAL(uint64_t(whole.wrongWord), sliced.wrongWord);
+        for (uint8_t words = 0; words < AcceptanceResult::MAX_WORDS; ++words) CHECK_EQUAL(uint64_t(whole.accepted[words]), sliced.accepted[words]);
+    }
+
+    // More trials than one AcceptanceResult counts, the same totals on 1 and 8 threads
+    void test_thread_count_does_not_change_results()
+    {
+        constexpr uint64_t TRIALS = 70000;
+        AcceptanceScenario jitter = AcceptanceSimulator::scenario(2);
+        PooledResult one   = AcceptancePool(1).run(jitter, TRIALS, 5);
+        PooledResult eight = AcceptancePool(8).run(jitter, TRIALS, 5);
+        CHECK_EQUAL(TRIALS, one.trials);
+        CHECK(same(one, eight));
+    }
+
+    void test_clean_scenario_always_accepted()
+    {
+        constexpr uint64_t TRIALS = 20000;
+        PooledResult clean = AcceptancePool(0).run(AcceptanceSimulator::scenario(0), TRIALS);
+        CHECK_EQUAL(TRIALS, clean.accepted[AcceptanceResult::MAX_WORDS - 1]);
+        CHECK_EQUAL(uint64_t(0), clean.wrongWord);
+    }
+
+    // A capture of the compiled burst replays like the burst itself
+    void test_capture_replay()
+    {
+        Bytes file;
+        Capture::Writer<Bytes> writer(file);
+        Waveform::Interpreter<PROGMEMStoragePolicy, false> program(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size());
+        Waveform::Edge edge{ 0, 0 };
+        while (program.next(edge)) writer.add(edge.level, edge.durationUs);
+        writer.finish();
+
+        AcceptanceScenario noisy = AcceptanceSimulator::scenario(6);
+        PooledResult fromProgram = AcceptancePool(4).run(noisy, 10000, 3);
+        PooledResult fromCapture = AcceptancePool(4, file.bytes.data(), file.bytes.size()).run(noisy, 10000, 3);
+        CHECK(same(fromProgram, fromCapture));
+    }
+
+    struct Test
+    {
+        const char* name;
+        void (*run)();
+    };
+}
+
+int main()
+{
+    const Test tests[] =
+    {
+        { "board_run_prints_what_the_firmware_prints", test_board_run_prints_what_the_firmware_prints },
+        { "slices_add_up_to_a_single_run",             test_slices_add_up_to_a_single_run },
+        { "thread_count_does_not_change_results",      test_thread_count_does_not_change_results },
+        { "clean_scenario_always_accepted",            test_clean_scenario_always_accepted },
+        { "capture_replay",                            test_capture_replay },
+    };
+
+    int failed = 0;
+    for (const Test& test : tests)
+    {
+        int before = failures;
+        test.run();
+        bool passed = failures == before;
+        if (!passed) ++failed;
+        printf("%s %s\n", passed ? "PASS" : "FAIL", test.name);
+    }
+    printf("%zu tests, %d failed\n", sizeof(tests) / sizeof(tests[0]), failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "Capture/EdgeCapture.h"
+
+/// @brief Block size of the captures the host tools write (the firmware writes CAPTURE_BLOCK_BYTES)
+constexpr size_t HOST_CAPTURE_BLOCK_BYTES = 4096;
+
+/// @brief Capture::Writer sink on a stdio stream; a short write is kept in failed()
+struct FileSink
+{
+    FILE* file;
+    bool  failed;
+
+    explicit FileSink(FILE* file): file(file), failed(false) {}
+
+    size_t write(const uint8_t* data, size_t length)
+    {
+        size_t written = fwrite(data, 1, length, file);
+        failed = failed || written != length;
+        return written;
+    }
+};
+
+using HostCaptureWriter = Capture::Writer<FileSink, HOST_CAPTURE_BLOCK_BYTES>;
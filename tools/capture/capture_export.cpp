@@ -0,0 +1,107 @@
+// Edge capture (Capture/EdgeCapture.h) -> text, read in place from a mapped file: a window is
+// found by a seek (a binary search of the block headers), so it costs the same at the start of
+// a capture of many gigabytes as at its end.
+//
+//   capture_export [-f csv|vcd|info] [-s start_us] [-d duration_us] capture.ecap
+//
+//   -f  csv  "<time_s>,<level>" rows, one per level change, and one at the end (capture_import's input)
+//       vcd  one 1-bit wire, 1 us timescale
+//       info edges, blocks and duration
+//   -s  first edge: the one on air at start_us (default 0)
+//   -d  stop after the edges starting within duration_us of it (default: to the end)
+#include "CaptureTools.h"
+#include "MappedFile.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "Policies/RAMStoragePolicy.h"
+
+namespace
+{
+    using Reader = Capture::Reader<RAMStoragePolicy>;
+
+    void usage()
+    {
+        fprintf(stderr, "usage: capture_export [-f csv|vcd|info] [-s start_us] [-d duration_us] capture.ecap\n");
+        exit(2);
+    }
+
+    void printCsv(uint64_t us, uint8_t level)
+    {
+        printf("%llu.%06llu,%u\n", static_cast<unsigned long long>(us / 1000000), static_cast<unsigned long long>(us % 1000000), level);
+    }
+
+    void printVcd(uint64_t us, uint8_t level)
+    {
+        printf("#%llu\n%u!\n", static_cast<unsigned long long>(us), level);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* format   = "csv";
+    uint64_t startUs     = 0;
+    uint64_t durationUs  = UINT64_MAX;
+
+    int option;
+    while ((option = getopt(argc, argv, "f:s:d:")) != -1)
+    {
+        switch (option)
+        {
+            case 'f': format     = optarg; break;
+            case 's': startUs    = strtoull(optarg, nullptr, 0); break;
+            case 'd': durationUs = strtoull(optarg, nullptr, 0); break;
+            default:  usage();
+        }
+    }
+    if (argc - optind != 1) usage();
+    bool csv = strcmp(format, "csv") == 0, vcd = strcmp(format, "vcd") == 0, info = strcmp(format, "info") == 0;
+    if (!csv && !vcd && !info) usage();
+
+    MappedFile file(argv[optind], durationUs == UINT64_MAX);
+    if (!file.valid())
+    {
+        fprintf(stderr, "capture_export: can not open %s: %s\n", argv[optind], strerror(file.error()));
+        return 1;
+    }
+    Reader capture(file.data(), file.size());
+    if (!capture.valid())
+    {
+        fprintf(stderr, "capture_export: %s is not an edge capture (version %u)\n", argv[optind], Capture::VERSION);
+        return 1;
+    }
+
+    if (info)
+    {
+        Reader::Cursor end = capture.seek(UINT64_MAX);
+        printf("edges=%llu blocks=%zu duration_us=%llu\n", static_cast<unsigned long long>(capture.edgeCount()),
+               capture.blockCount(), static_cast<unsigned long long>(end.startUs()));
+        return end.faulted() ? 1 : 0;
+    }
+
+    if (vcd) printf("$timescale 1us $end\n$scope module capture $end\n$var wire 1 ! edge $end\n$upscope $end\n$enddefinitions $end\n");
+
+    Reader::Cursor cursor = capture.seek(startUs);
+    uint64_t firstUs = cursor.startUs();
+    uint64_t endUs   = durationUs > UINT64_MAX - firstUs ? UINT64_MAX : firstUs + durationUs;
+    Waveform::Edge edge{ 0, 0 };
+    uint8_t level = 2;                                          // None printed yet
+    uint64_t atUs = firstUs;
+    while (cursor.startUs() < endUs && cursor.next(edge))
+    {
+        if (edge.level != level)                                // Split long edges merge back
+        {
+            level = edge.level;
+            csv ? printCsv(atUs, level) : printVcd(atUs, level);
+        }
+        atUs += edge.durationUs;
+    }
+    if (level != 2) csv ? printCsv(atUs, level) : printVcd(atUs, level);   // Closes the last edge
+
+    if (cursor.faulted())
+    {
+        fprintf(stderr, "capture_export: %s: damaged block after edge %llu\n", argv[optind], static_cast<unsigned long long>(cursor.edgeIndex()));
+        return 1;
+    }
+    return 0;
+}
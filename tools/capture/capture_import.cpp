@@ -0,0 +1,100 @@
+// Logic analyzer export -> edge capture (Capture/EdgeCapture.h), streamed: the converters and the
+// writer hold one block whatever the input size, so a trace of many gigabytes converts in a few
+// kilobytes of memory, from a file or a pipe.
+//
+//   capture_import [-f csv|vcd] [input] output.ecap
+//
+//   -f  input format (default: from the input's extension, csv for stdin)
+//   input: CSV "<time_s>,<level>" rows or a VCD (first 1-bit wire); "-" or none reads stdin
+#include "CaptureTools.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "Capture/CaptureConverters.h"
+
+namespace
+{
+    constexpr size_t READ_BYTES = 64 * 1024;
+
+    void usage()
+    {
+        fprintf(stderr, "usage: capture_import [-f csv|vcd] [input] output.ecap\n");
+        exit(2);
+    }
+
+    bool endsWith(const char* text, const char* suffix)
+    {
+        size_t length = strlen(text), suffixLength = strlen(suffix);
+        return length >= suffixLength && strcasecmp(text + length - suffixLength, suffix) == 0;
+    }
+
+    template<typename Converter>
+    void convert(FILE* input, Converter& converter)
+    {
+        static char buffer[READ_BYTES];
+        size_t length;
+        while ((length = fread(buffer, 1, sizeof(buffer), input)) > 0)
+            for (size_t i = 0; i < length; ++i) converter.feed(buffer[i]);
+        converter.finish();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* format = nullptr;
+
+    int option;
+    while ((option = getopt(argc, argv, "f:")) != -1)
+    {
+        switch (option)
+        {
+            case 'f': format = optarg; break;
+            default:  usage();
+        }
+    }
+    if (argc - optind < 1 || argc - optind > 2) usage();
+    const char* inputPath  = argc - optind == 2 ? argv[optind] : "-";
+    const char* outputPath = argv[argc - 1];
+
+    if (!format) format = endsWith(inputPath, ".vcd") ? "vcd" : "csv";
+    bool vcd = strcmp(format, "vcd") == 0;
+    if (!vcd && strcmp(format, "csv") != 0) usage();
+
+    FILE* input = strcmp(inputPath, "-") == 0 ? stdin : fopen(inputPath, "rb");
+    if (!input)
+    {
+        fprintf(stderr, "capture_import: can not open %s: %s\n", inputPath, strerror(errno));
+        return 1;
+    }
+    FILE* output = fopen(outputPath, "wb");
+    if (!output)
+    {
+        fprintf(stderr, "capture_import: can not create %s: %s\n", outputPath, strerror(errno));
+        return 1;
+    }
+
+    FileSink sink(output);
+    HostCaptureWriter writer(sink);
+    if (vcd)
+    {
+        Capture::VcdConverter<HostCaptureWriter> converter(writer);
+        convert(input, converter);
+    }
+    else
+    {
+        Capture::CsvConverter<HostCaptureWriter> converter(writer);
+        convert(input, converter);
+    }
+    writer.finish();
+
+    bool failed = ferror(input) || sink.failed || fclose(output) != 0;
+    if (input != stdin) fclose(input);
+    if (failed)
+    {
+        fprintf(stderr, "capture_import: %s: i/o error\n", outputPath);
+        return 1;
+    }
+    fprintf(stderr, "capture_import: %llu edges, %.6f s\n", static_cast<unsigned long long>(writer.edgeCount()), writer.durationUs() / 1e6);
+    return 0;
+}
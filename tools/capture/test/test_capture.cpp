@@ -0,0 +1,366 @@
+// Edge captures at host scale: a large generated capture read in place from a mapped file (every
+// seek lands on its edge and reads O(log n) bytes), and the import / export tools on files and
+// pipes (round trips, windows, bounded memory on a long stream).
+//
+//   test_capture <capture_import> <capture_export>
+#include "CaptureTools.h"
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "Policies/RAMStoragePolicy.h"
+
+namespace
+{
+    int failures = 0;
+    std::string importTool;
+    std::string exportTool;
+
+    #define CHECK(condition) \
+        do { if (!(condition)) { ++failures; fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); } } while (0)
+
+    #define CHECK_EQUAL(expected, actual) \
+        do { auto e_ = (expected); auto a_ = (actual); if (!(e_ == a_)) { ++failures; \
+             fprintf(stderr, "  %s:%d: expected %s, got %s\n", __FILE__, __LINE__, toText(e_).c_str(), toText(a_).c_str()); } } while (0)
+
+    std::string toText(const std::string& value) { return "\"" + value + "\""; }
+    template<typename T> std::string toText(T value) { return std::to_string(value); }
+
+    /// @brief RAMStoragePolicy that counts the bytes a reader touches
+    struct CountingPolicy
+    {
+        static uint64_t reads;
+
+        static uint8_t read(const uint8_t* ptr)
+        {
+            ++reads;
+            return *ptr;
+        }
+    };
+    uint64_t CountingPolicy::reads = 0;
+
+    /// @brief A file in /tmp, removed with the fixture
+    struct TempFile
+    {
+        std::string path;
+
+        TempFile()
+        {
+            char name[] = "/tmp/captureXXXXXX";
+            int fd = mkstemp(name);
+            if (fd >= 0) ::close(fd);
+            path = name;
+        }
+        ~TempFile() { unlink(path.c_str()); }
+    };
+
+    /// @brief Runs a shell command, stdout into output; exit status, -1 if it did not exit
+    int run(const std::string& command, std::string* output = nullptr)
+    {
+        FILE* pipe = popen(command.c_str(), "r");
+        if (!pipe) return -1;
+        char buffer[4096];
+        size_t length;
+        while ((length = fread(buffer, 1, sizeof(buffer), pipe)) > 0)
+            if (output) output->append(buffer, length);
+        int status = pclose(pipe);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+    bool writeText(const std::string& path, const std::string& text)
+    {
+        FILE* file = fopen(path.c_str(), "w");
+        if (!file) return false;
+        bool written = fwrite(text.data(), 1, text.size(), file) == text.size();
+        return fclose(file) == 0 && written;
+    }
+
+    /// @brief Deterministic edge durations: 1 us .. ~16 ms, mostly short like a burst
+    struct Generator
+    {
+        uint32_t state = 0x12345678;
+
+        uint32_t next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return (state & 0x7) == 0 ? 1 + (state >> 18) : 1 + ((state >> 8) & 0x7FF);
+        }
+    };
+
+    struct Checkpoint
+    {
+        uint64_t startUs;
+        uint64_t edge;
+    };
+
+    /**
+     * @brief Writes edges generated edges to path, remembering the start of every stride-th edge.
+     * @return the capture's duration in us
+     */
+    uint64_t generate(const std::string& path, uint64_t edges, uint64_t stride, std::vector<Checkpoint>& checkpoints)
+    {
+        FILE* file = fopen(path.c_str(), "wb");
+        CHECK(file != nullptr);
+        if (!file) return 0;
+        FileSink sink(file);
+        HostCaptureWriter writer(sink);
+        Generator generator;
+        uint64_t nowUs = 0;
+        for (uint64_t edge = 0; edge < edges; ++edge)
+        {
+            if (edge % stride == 0) checkpoints.push_back({ nowUs, edge });
+            uint32_t durationUs = generator.next();
+            writer.add(edge & 1, durationUs);
+            nowUs += durationUs;
+        }
+        writer.finish();
+        CHECK(!sink.failed);
+        CHECK(fclose(file) == 0);
+        return nowUs;
+    }
+
+    uint8_t log2Ceiling(uint64_t value)
+    {
+        uint8_t bits = 0;
+        while ((uint64_t(1) << bits) < value) ++bits;
+        return bits;
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Tests
+    // ---------------------------------------------------------------------------------
+
+    // Millions of edges: mapped, walked in place, every checkpoint found by a seek that reads
+    // the headers of a binary search and one block, not the file
+    void test_large_capture_seeks_in_log_time()
+    {
+        constexpr uint64_t EDGES  = 20000000;
+        constexpr uint64_t STRIDE = 99991;                      // Prime: checkpoints fall anywhere in their block
+        TempFile path;
+        std::vector<Checkpoint> checkpoints;
+        uint64_t durationUs = generate(path.path, EDGES, STRIDE, checkpoints);
+
+        MappedFile file(path.path.c_str());
+        CHECK(file.valid());
+        CHECK(file.size() > 32u * 1024 * 1024);
+        Capture::Reader<CountingPolicy> capture(file.data(), file.size());
+        CHECK(capture.valid());
+        CHECK_EQUAL(EDGES, capture.edgeCount());
+
+        size_t blocks = capture.blockCount();
+        uint64_t bound = 8 * log2Ceiling(blocks) + Capture::BLOCK_HEADER_BYTES + HOST_CAPTURE_BLOCK_BYTES;
+        uint64_t worst = 0;
+        for (const Checkpoint& checkpoint : checkpoints)
+        {
+            CountingPolicy::reads = 0;
+            auto cursor = capture.seek(checkpoint.startUs);
+            if (CountingPolicy::reads > worst) worst = CountingPolicy::reads;
+            CHECK_EQUAL(checkpoint.edge, cursor.edgeIndex());
+            CHECK_EQUAL(checkpoint.startUs, cursor.startUs());
+            if (failures) return;
+        }
+        CHECK(worst <= bound);
+        CHECK(worst * 1000 < file.size());
+
+        CountingPolicy::reads = 0;
+        auto end = capture.seek(durationUs + 1);
+        CHECK(CountingPolicy::reads <= bound);
+        CHECK_EQUAL(EDGES, end.edgeIndex());
+        CHECK_EQUAL(durationUs, end.startUs());
+
+        // The whole capture, front to back, in place
+        MappedFile walked(path.path.c_str(), true);
+        Capture::Reader<RAMStoragePolicy> reader(walked.data(), walked.size());
+        auto cursor = reader.begin();
+        Waveform::Edge edge{ 0, 0 };
+        Generator generator;
+        uint64_t edges = 0;
+        bool same = true;
+        while (cursor.next(edge))
+        {
+            same = same && edge.durationUs == generator.next() && edge.level == (edges & 1);
+            ++edges;
+        }
+        CHECK(!cursor.faulted());
+        CHECK(same);
+        CHECK_EQUAL(EDGES, edges);
+    }
+
+    // Analyzer CSV -> capture -> CSV: level changes and the closing row come back, header skipped
+    void test_csv_round_trip()
+    {
+        TempFile csv, capture;
+        CHECK(writeText(csv.path, "Time [s],Channel 0\n0.000000,0\n0.000250,1\n0.000300,1\n0.001250,0\n2.500000,1\n2.500400,1\n"));
+        CHECK_EQUAL(0, run(importTool + " -f csv " + csv.path + " " + capture.path + " 2>/dev/null"));
+
+        std::string info;
+        CHECK_EQUAL(0, run(exportTool + " -f info " + capture.path, &info));
+        CHECK_EQUAL(std::string("edges=4 blocks=1 duration_us=2500400\n"), info);
+
+        std::string text;
+        CHECK_EQUAL(0, run(exportTool + " " + capture.path, &text));
+        CHECK_EQUAL(std::string("0.000000,0\n0.000250,1\n0.001250,0\n2.500000,1\n2.500400,1\n"), text);
+    }
+
+    // VCD (10 ns timescale, a vector and a second wire to ignore) -> capture -> VCD -> capture
+    void test_vcd_round_trip()
+    {
+        TempFile vcd, capture, again, back;
+        CHECK(writeText(vcd.path,
+            "$timescale 10ns $end\n$scope module top $end\n$var wire 8 # bus $end\n$var wire 1 ! gdo0 $end\n"
+            "$var wire 1 \" csn $end\n$upscope $end\n$enddefinitions $end\n"
+            "#0\n0!\n1\"\nb1010 #\n#3000\n1!\n#4000\n0\"\n#33000\n0!\n#123000\n1!\n#124000\n"));
+        CHECK_EQUAL(0, run(importTool + " -f vcd " + vcd.path + " " + capture.path + " 2>/dev/null"));
+
+        std::string text;
+        CHECK_EQUAL(0, run(exportTool + " -f vcd " + capture.path, &text));
+        CHECK(text.find("#0\n0!\n#30\n1!\n#330\n0!\n#1230\n1!\n#1240\n1!\n") != std::string::npos);
+
+        CHECK(writeText(back.path, text));
+        CHECK_EQUAL(0, run(importTool + " -f vcd " + back.path + " " + again.path + " 2>/dev/null"));
+        std::string first, second;
+        run(exportTool + " " + capture.path, &first);
+        run(exportTool + " " + again.path, &second);
+        CHECK(!first.empty());
+        CHECK_EQUAL(first, second);
+    }
+
+    // A window starts at the edge on air at -s and stops after -d
+    void test_export_window()
+    {
+        TempFile csv, capture;
+        std::string rows;
+        for (int i = 0; i <= 1000; ++i) rows += std::to_string(i / 1000) + "." + std::string(i % 1000 < 100 ? (i % 1000 < 10 ? "00" : "0") : "") + std::to_string(i % 1000) + "000," + std::to_string(i & 1) + "\n";
+        CHECK(writeText(csv.path, rows));
+        CHECK_EQUAL(0, run(importTool + " " + csv.path + " " + capture.path + " 2>/dev/null"));
+
+        std::string text;
+        CHECK_EQUAL(0, run(exportTool + " -s 500500 -d 2000 " + capture.path, &text));
+        CHECK_EQUAL(std::string("0.500000,0\n0.501000,1\n0.502000,1\n"), text);     // Closing row: the end of the last edge
+    }
+
+    /// @brief Peak resident set of a running process since its exec (VmHWM), in KiB; 0 if unknown
+    long highWaterKiB(pid_t pid)
+    {
+        FILE* status = fopen(("/proc/" + std::to_string(pid) + "/status").c_str(), "r");
+        if (!status) return 0;
+        long kib = 0;
+        char line[128];
+        while (fgets(line, sizeof(line), status))
+            if (strncmp(line, "VmHWM:", 6) == 0) kib = strtol(line + 6, nullptr, 10);
+        fclose(status);
+        return kib;
+    }
+
+    // A long analyzer stream through a pipe: the importer's memory does not grow with it. Its
+    // peak is read while the pipe is still open (rusage would add this process's own peak)
+    void test_import_streams_in_bounded_memory()
+    {
+        TempFile capture;
+        int input[2];
+        CHECK(pipe(input) == 0);
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, input[0], STDIN_FILENO);
+        posix_spawn_file_actions_addclose(&actions, input[1]);
+        posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+        std::string output = capture.path;
+        char* arguments[] = { &importTool[0], const_cast<char*>("-"), &output[0], nullptr };
+        pid_t child;
+        int spawned = posix_spawn(&child, importTool.c_str(), &actions, nullptr, arguments, environ);
+        posix_spawn_file_actions_destroy(&actions);
+        close(input[0]);
+        CHECK_EQUAL(0, spawned);
+        if (spawned != 0) return;
+
+        constexpr uint32_t ROWS = 3000000;                      // ~ 50 MB of CSV
+        FILE* stream = fdopen(input[1], "w");
+        char row[48];
+        uint64_t nowUs = 0;
+        for (uint32_t i = 0; i < ROWS; ++i)
+        {
+            nowUs += 100 + i % 900;
+            int length = snprintf(row, sizeof(row), "%llu.%06llu,%u,0,1\n", static_cast<unsigned long long>(nowUs / 1000000),
+                                  static_cast<unsigned long long>(nowUs % 1000000), i & 1);
+            fwrite(row, 1, length, stream);
+        }
+        fflush(stream);                                         // All but a pipe buffer is converted
+        long peakKiB = highWaterKiB(child);
+        fclose(stream);
+
+        int status = 0;
+        CHECK_EQUAL(child, waitpid(child, &status, 0));
+        CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        CHECK(peakKiB > 0 && peakKiB < 8 * 1024);
+
+        std::string info;
+        CHECK_EQUAL(0, run(exportTool + " -f info " + capture.path, &info));
+        CHECK(info.find("edges=" + std::to_string(ROWS - 1) + " ") == 0);
+    }
+
+    // Not a capture, a damaged block: refused with an error, not garbage
+    void test_export_refuses_damaged_files()
+    {
+        TempFile text, capture;
+        CHECK(writeText(text.path, "0.0,1\n"));
+        CHECK_EQUAL(1, run(exportTool + " " + text.path + " 2>/dev/null"));
+        CHECK_EQUAL(1, run(exportTool + " /nonexistent.ecap 2>/dev/null"));
+
+        std::vector<Checkpoint> checkpoints;
+        generate(capture.path, 10000, 10000, checkpoints);
+        FILE* file = fopen(capture.path.c_str(), "r+b");
+        CHECK(file != nullptr);
+        if (!file) return;
+        uint8_t bad[2] = { 0xFF, 0xFF };                        // Second block's payload length, past its block
+        fseek(file, long(Capture::FILE_HEADER_BYTES + HOST_CAPTURE_BLOCK_BYTES + 18), SEEK_SET);
+        fwrite(bad, 1, sizeof(bad), file);
+        fclose(file);
+        CHECK_EQUAL(1, run(exportTool + " " + capture.path + " > /dev/null 2>&1"));
+    }
+
+    struct Test
+    {
+        const char* name;
+        void (*run)();
+    };
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: test_capture <capture_import> <capture_export>\n");
+        return 2;
+    }
+    importTool = argv[1];
+    exportTool = argv[2];
+
+    const Test tests[] =
+    {
+        { "large_capture_seeks_in_log_time",    test_large_capture_seeks_in_log_time },
+        { "csv_round_trip",                     test_csv_round_trip },
+        { "vcd_round_trip",                     test_vcd_round_trip },
+        { "export_window",                      test_export_window },
+        { "import_streams_in_bounded_memory",   test_import_streams_in_bounded_memory },
+        { "export_refuses_damaged_files",       test_export_refuses_damaged_files },
+    };
+
+    int failed = 0;
+    for (const Test& test : tests)
+    {
+        int before = failures;
+        test.run();
+        bool passed = failures == before;
+        if (!passed) ++failed;
+        printf("%s %s\n", passed ? "PASS" : "FAIL", test.name);
+    }
+    printf("%zu tests, %d failed\n", sizeof(tests) / sizeof(tests[0]), failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,306 @@
+#include "CC1101Model.h"
+#include <string.h>
+
+namespace
+{
+    constexpr uint8_t MCSM0     = 0x18;
+    constexpr uint8_t PATABLE   = 0x3E;
+    constexpr uint8_t FIFO      = 0x3F;
+    constexpr uint32_t RESET_US = 40;                           // SRES: SO high until the chip is reset again
+
+    // Datasheet reset values of 0x00..0x2E
+    constexpr uint8_t RESET_VALUES[0x2F] =
+    {
+        0x29, 0x2E, 0x3F, 0x07, 0xD3, 0x91, 0xFF, 0x04, 0x45, 0x00, 0x00, 0x0F, 0x00, 0x1E, 0xC4, 0xEC,
+        0x8C, 0x22, 0x02, 0x22, 0xF8, 0x47, 0x07, 0x30, 0x04, 0x36, 0x6C, 0x03, 0x40, 0x91, 0x87, 0x6B,
+        0xF8, 0x56, 0x10, 0xA9, 0x0A, 0x20, 0x0D, 0x41, 0x00, 0x59, 0x7F, 0x3F, 0x88, 0x31, 0x0B,
+    };
+
+    const char* const REGISTER_NAMES[0x40] =
+    {
+        "IOCFG2", "IOCFG1", "IOCFG0", "FIFOTHR", "SYNC1", "SYNC0", "PKTLEN", "PKTCTRL1",
+        "PKTCTRL0", "ADDR", "CHANNR", "FSCTRL1", "FSCTRL0", "FREQ2", "FREQ1", "FREQ0",
+        "MDMCFG4", "MDMCFG3", "MDMCFG2", "MDMCFG1", "MDMCFG0", "DEVIATN", "MCSM2", "MCSM1",
+        "MCSM0", "FOCCFG", "BSCFG", "AGCCTRL2", "AGCCTRL1", "AGCCTRL0", "WOREVT1", "WOREVT0",
+        "WORCTRL", "FREND1", "FREND0", "FSCAL3", "FSCAL2", "FSCAL1", "FSCAL0", "RCCTRL1",
+        "RCCTRL0", "FSTEST", "PTEST", "AGCTEST", "TEST2", "TEST1", "TEST0", "0x2F",
+        "PARTNUM", "VERSION", "FREQEST", "LQI", "RSSI", "MARCSTATE", "WORTIME1", "WORTIME0",
+        "PKTSTATUS", "VCO_VC_DAC", "TXBYTES", "RXBYTES", "RCCTRL1_STATUS", "RCCTRL0_STATUS", "PATABLE", "FIFO",
+    };
+
+    const char* const STROBE_NAMES[14] =
+    {
+        "SRES", "SFSTXON", "SXOFF", "SCAL", "SRX", "STX", "SIDLE", "SAFC", "SWOR", "SPWD", "SFRX", "SFTX", "SWORRST", "SNOP",
+    };
+
+    constexpr bool isStrobeOrStatus(uint8_t address) { return address >= 0x30 && address <= 0x3D; }
+}
+
+CC1101Model::CC1101Model():
+_selected(false),
+_phase(Phase::Header),
+_address(0),
+_read(false),
+_burst(false),
+_accessBytes(0),
+_traffic{ 0, 0, 0 }
+{
+    powerOn();
+}
+
+void CC1101Model::powerOn()
+{
+    memset(_registers, 0, sizeof(_registers));
+    memcpy(_registers, RESET_VALUES, sizeof(RESET_VALUES));
+    memset(_paTable, 0, sizeof(_paTable));
+    _paTable[0] = 0xC6;
+    _paIndex = 0;
+    _state = _target = IDLE;
+    _shown = IDLE;
+    _targetAtUs = 0;
+    _readyAtUs = hal::nowUs() + XOSC_START_US;
+    _sleepOnDeselect = false;
+}
+
+void CC1101Model::clearTraffic()
+{
+    _traffic = { 0, 0, 0 };
+    _log.clear();
+}
+
+const char* CC1101Model::registerName(uint8_t address)
+{
+    return REGISTER_NAMES[address & 0x3F];
+}
+
+const char* CC1101Model::strobeName(uint8_t address)
+{
+    return isStrobeOrStatus(address) ? STROBE_NAMES[address - 0x30] : "?";
+}
+
+// ---------------------------------------------------------------------------------
+//  Pins
+// ---------------------------------------------------------------------------------
+void CC1101Model::select(bool selected)
+{
+    if (selected == _selected) return;
+    _selected = selected;
+
+    if (selected)
+    {
+        ++_traffic.csnCycles;
+        _bytesThisSelect = 0;
+        _phase = Phase::Header;
+        if (_state == SLEEP)                                    // CSn low wakes the chip, the crystal restarts
+        {
+            _state = _target = IDLE;
+            _readyAtUs = hal::nowUs() + XOSC_START_US;
+        }
+        return;
+    }
+
+    endAccess();
+    if (_bytesThisSelect == 0) _log.push_back("select");
+    _paIndex = 0;                                               // The PATABLE pointer resets with CSn
+    if (_sleepOnDeselect)
+    {
+        _sleepOnDeselect = false;
+        _state = _target = SLEEP;
+    }
+}
+
+uint8_t CC1101Model::misoLevel()
+{
+    return hal::nowUs() < _readyAtUs ? 1 : 0;                  // CHIP_RDYn
+}
+
+uint8_t CC1101Model::transfer(uint8_t mosi)
+{
+    if (!_selected) return 0xFF;
+    ++_traffic.bytes;
+    ++_bytesThisSelect;
+    return _phase == Phase::Header ? header(mosi) : data(mosi);
+}
+
+// ---------------------------------------------------------------------------------
+//  Accesses
+// ---------------------------------------------------------------------------------
+uint8_t CC1101Model::statusByte()
+{
+    uint8_t state;
+    switch (marcState())
+    {
+        case IDLE:   state = 0; break;
+        case RX:     state = 1; break;
+        case TX:     state = 2; break;
+        case FSTXON: state = 3; break;
+        case STARTCAL: state = 4; break;
+        case FS_LOCK:  state = 5; break;
+        default:     state = 0; break;
+    }
+    uint8_t ready = hal::nowUs() < _readyAtUs ? 0x80 : 0x00;
+    uint8_t fifo  = _read ? 0 : 15;                             // RX bytes available / TX bytes free, saturated
+    return static_cast<uint8_t>(ready | (state << 4) | fifo);
+}
+
+uint8_t CC1101Model::header(uint8_t byte)
+{
+    ++_traffic.transactions;
+    _read    = (byte & 0x80) != 0;
+    _burst   = (byte & 0x40) != 0;
+    _address = byte & 0x3F;
+    _accessBytes = 0;
+    uint8_t status = statusByte();
+
+    if (isStrobeOrStatus(_address) && !_burst)
+    {
+        _log.push_back(std::string("strobe ") + strobeName(_address));
+        strobe(_address);
+        return status;                                          // Next byte is a header again
+    }
+
+    _phase = Phase::Data;
+    return status;
+}
+
+uint8_t CC1101Model::data(uint8_t byte)
+{
+    ++_accessBytes;
+    uint8_t answer = statusByte();
+
+    if (isStrobeOrStatus(_address))                             // Status register (burst bit set)
+    {
+        switch (_address)
+        {
+            case 0x30: answer = 0x00; break;                    // PARTNUM
+            case 0x31: answer = 0x14; break;                    // VERSION
+            case 0x35: answer = marcState(); break;
+            default:   answer = 0x00; break;                    // FIFOs empty, RSSI / LQI not modelled
+        }
+        endAccess();
+        return answer;
+    }
+
+    if (_address == PATABLE)
+    {
+        if (_read) answer = _paTable[_paIndex];
+        else       _paTable[_paIndex] = byte;
+        _paIndex = (_paIndex + 1) & 7;
+    }
+    else if (_address == FIFO)
+    {
+        if (_read) answer = 0x00;                               // Async mode: nothing is received
+    }
+    else
+    {
+        uint8_t address = static_cast<uint8_t>((_address + _accessBytes - 1) & 0x3F);
+        if (address <= 0x2E)
+        {
+            if (_read) answer = _registers[address];
+            else       _registers[address] = byte;
+        }
+    }
+
+    if (!_burst) endAccess();
+    return answer;
+}
+
+/**
+ * @brief Logs the access that just ended; the next byte is a header.
+ */
+void CC1101Model::endAccess()
+{
+    if (_phase != Phase::Data) return;
+    _phase = Phase::Header;
+
+    std::string line;
+    if (isStrobeOrStatus(_address))  line = "status ";
+    else if (_burst)                 line = _read ? "burst read " : "burst write ";
+    else                             line = _read ? "read " : "write ";
+    line += registerName(_address);
+    if (_burst && !isStrobeOrStatus(_address)) line += " " + std::to_string(_accessBytes);
+    _log.push_back(line);
+}
+
+// ---------------------------------------------------------------------------------
+//  State machine
+// ---------------------------------------------------------------------------------
+uint8_t CC1101Model::marcState()
+{
+    if (_state != _target && hal::nowUs() >= _targetAtUs) _state = _target;
+    return _state == _target ? _state : _shown;
+}
+
+/**
+ * @brief Starts the transition to target. Leaving IDLE for FSTXON, TX or RX calibrates first with
+ *        MCSM0.FS_AUTOCAL = 1; a TX / RX strobe during a transition only changes where it ends.
+ */
+void CC1101Model::goTo(State target)
+{
+    marcState();
+    uint64_t now = hal::nowUs();
+
+    if (_state != _target)
+    {
+        _target = target;
+        return;
+    }
+    if (_state == target) return;
+
+    uint32_t durationUs = 0;
+    _shown = FS_LOCK;
+    if (_state == IDLE)
+    {
+        bool calibrate = ((_registers[MCSM0] >> 4) & 0x03) == 1;
+        durationUs = calibrate ? CALIBRATION_US : WAKEUP_US;
+        _shown = calibrate ? STARTCAL : FS_LOCK;
+    }
+    else if (_state == FSTXON && target == TX)
+    {
+        durationUs = FSTXON_TO_TX_US;
+    }
+
+    _target = target;
+    _targetAtUs = now + durationUs;
+    if (durationUs == 0) _state = target;
+}
+
+void CC1101Model::strobe(uint8_t command)
+{
+    marcState();
+    switch (command)
+    {
+        case 0x30:                                              // SRES
+            powerOn();
+            _readyAtUs = hal::nowUs() + RESET_US;
+            break;
+        case 0x31:                                              // SFSTXON
+            if (_state == IDLE || _state == RX) goTo(FSTXON);
+            break;
+        case 0x32:                                              // SXOFF
+            if (_state == IDLE) _state = _target = XOFF;
+            break;
+        case 0x33:                                              // SCAL: calibrate, back to IDLE
+            if (_state == IDLE && _target == IDLE)
+            {
+                _shown = STARTCAL;
+                _state = XOFF;                                  // Anything but the target: the transition runs
+                _targetAtUs = hal::nowUs() + CALIBRATION_US;
+            }
+            break;
+        case 0x34:                                              // SRX
+            if (_state != SLEEP && _state != XOFF) goTo(RX);
+            break;
+        case 0x35:                                              // STX
+            if (_state != SLEEP && _state != XOFF) goTo(TX);
+            break;
+        case 0x36:                                              // SIDLE
+            _state = _target = IDLE;
+            break;
+        case 0x39:                                              // SPWD: sleeps once CSn goes high
+            if (_state == IDLE) _sleepOnDeselect = true;
+            break;
+        default:                                                // SAFC, SWOR, SFRX, SFTX, SWORRST, SNOP
+            break;
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <HostBoard.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Register-level CC1101 on the host SPI bus (hal::SpiDevice), timed on the board's virtual clock.
+ *
+ * Enough of the chip for what the Transceiver does with it: the CSn / SO reset handshake, single
+ * and burst access to the configuration registers and the PATABLE, status registers through the
+ * burst bit (a plain read of 0x30..0x3D is a strobe, as on the chip), the strobes and the main
+ * state machine with the datasheet's transition times:
+ *   - IDLE -> FSTXON / TX / RX calibrates first when MCSM0.FS_AUTOCAL asks for it (CALIBRATION_US)
+ *   - FSTXON -> TX only settles (FSTXON_TO_TX_US), SIDLE is immediate
+ *   - SO stays high after CSn falls until the crystal runs (XOSC_START_US after power-on or SPWD)
+ * MARCSTATE reads what the state machine is doing at that virtual time, so polls see the
+ * calibration through. FIFOs hold no data: the radio is used in async OOK mode (GDO0 keyed).
+ *
+ * What reaches the pins is counted:
+ *   - transactions : accesses the chip decodes (one per header byte, several may share one CSn low)
+ *   - bytes        : bytes clocked while selected
+ *   - csnCycles    : CSn falling edges
+ * and each access is logged as one line ("write IOCFG0", "status MARCSTATE", "strobe SIDLE",
+ * "burst write PATABLE 8", "select" for a CSn cycle without bytes), the transaction log the budget
+ * tests compare with the expected one.
+ */
+class CC1101Model : public hal::SpiDevice
+{
+    public:
+
+    static constexpr uint32_t XOSC_START_US   = 150;
+    static constexpr uint32_t CALIBRATION_US  = 809;            // IDLE -> TX / FSTXON with FS_AUTOCAL
+    static constexpr uint32_t WAKEUP_US       = 90;             // The same without calibration
+    static constexpr uint32_t FSTXON_TO_TX_US = 1;
+
+    struct Traffic
+    {
+        uint32_t transactions;
+        uint32_t bytes;
+        uint32_t csnCycles;
+    };
+
+    CC1101Model();
+
+    void    select(bool selected) override;
+    uint8_t transfer(uint8_t mosi) override;
+    uint8_t misoLevel() override;
+
+    void powerOn();                                             // Registers to their reset values, IDLE, crystal starting
+
+    Traffic traffic() const { return _traffic; }
+    const std::vector<std::string>& log() const { return _log; }
+    void clearTraffic();
+
+    uint8_t marcState();                                        // Also settles a finished transition
+    uint8_t reg(uint8_t address) const { return _registers[address & 0x3F]; }
+    const uint8_t* paTable() const { return _paTable; }
+
+    static const char* registerName(uint8_t address);
+    static const char* strobeName(uint8_t address);
+
+    private:
+
+    enum class Phase : uint8_t
+    {
+        Header,                                                 // Next byte is a header
+        Data,                                                   // Register / PATABLE / FIFO data follow
+    };
+
+    enum State : uint8_t                                        // MARCSTATE values
+    {
+        SLEEP    = 0x00,
+        IDLE     = 0x01,
+        XOFF     = 0x02,
+        STARTCAL = 0x08,
+        FS_LOCK  = 0x0A,
+        RX       = 0x0D,
+        FSTXON   = 0x12,
+        TX       = 0x13,
+    };
+
+    uint8_t statusByte();
+    uint8_t header(uint8_t byte);
+    uint8_t data(uint8_t byte);
+    void    strobe(uint8_t command);
+    void    goTo(State target);                                 // Through calibration / wake-up as MCSM0 says
+    void    endAccess();
+
+    uint8_t  _registers[0x40];
+    uint8_t  _paTable[8];
+    uint8_t  _paIndex;
+
+    State    _state;
+    State    _target;                                           // Where the running transition ends
+    State    _shown;                                            // MARCSTATE while it runs
+    uint64_t _targetAtUs;
+    uint64_t _readyAtUs;                                        // SO low from then on
+    bool     _sleepOnDeselect;
+
+    bool     _selected;
+    uint16_t _bytesThisSelect;
+    Phase    _phase;
+    uint8_t  _address;
+    bool     _read;
+    bool     _burst;
+    uint16_t _accessBytes;                                      // Data bytes of the current access
+
+    Traffic  _traffic;
+    std::vector<std::string> _log;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <HostBoard.h>
+#include <stddef.h>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs jobs 0..count-1 on a work-stealing pool of worker threads, each worker a board of its own.
+ *
+ * Each worker starts with a contiguous range of the jobs in its own deque and takes them from the
+ * front, in order (neighbouring grid points share caches and warm-up). A worker whose deque is
+ * empty steals from the back of another's, so a range of slow jobs (a long bounce profile, a
+ * heavy channel) is spread over the pool instead of holding one thread to the end. Every worker
+ * starts from hal::reset(): firmware code that keeps state on the board (registers, time,
+ * PER_BOARD statics) sees a fresh one per worker. Jobs write their result to their own slot
+ * (index), so the caller combines them in job order whatever the thread count: the output does
+ * not depend on scheduling.
+ *
+ * @param threads - 0 = one per hardware thread; the calling thread is one of them
+ * @param job     - void(size_t index), called once per index from a worker thread
+ */
+template<typename Job>
+void runJobs(size_t count, unsigned threads, Job&& job)
+{
+    if (threads == 0) threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+    if (threads > count) threads = count ? static_cast<unsigned>(count) : 1;
+
+    struct Queue
+    {
+        std::mutex         lock;
+        std::deque<size_t> jobs;
+    };
+    std::vector<Queue> queues(threads);
+    for (unsigned worker = 0; worker < threads; ++worker)
+    {
+        size_t first = count * worker / threads;
+        size_t last  = count * (worker + 1) / threads;
+        for (size_t index = first; index < last; ++index) queues[worker].jobs.push_back(index);
+    }
+
+    auto take = [&](unsigned self, size_t& index) -> bool
+    {
+        {
+            std::lock_guard<std::mutex> guard(queues[self].lock);
+            if (!queues[self].jobs.empty())
+            {
+                index = queues[self].jobs.front();
+                queues[self].jobs.pop_front();
+                return true;
+            }
+        }
+        for (unsigned offset = 1; offset < threads; ++offset)  // Steal the victim's last job, furthest from what it works on
+        {
+            Queue& victim = queues[(self + offset) % threads];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (victim.jobs.empty()) continue;
+            index = victim.jobs.back();
+            victim.jobs.pop_back();
+            return true;
+        }
+        return false;                                           // Nothing queued anywhere: jobs never add jobs, done
+    };
+
+    auto worker = [&](unsigned self)
+    {
+        hal::reset();
+        size_t index;
+        while (take(self, index)) job(index);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned self = 1; self < threads; ++self) pool.emplace_back(worker, self);
+    worker(0);
+    for (std::thread& thread : pool) thread.join();
+}
@@ -0,0 +1,43 @@
+#include "MappedFile.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const char* path, bool sequential):
+_data(nullptr), _size(0), _error(0)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        _error = errno;
+        return;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) < 0)
+    {
+        _error = errno;
+        close(fd);
+        return;
+    }
+
+    if (status.st_size > 0)
+    {
+        void* mapped = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) _error = errno;
+        else
+        {
+            _data = static_cast<const uint8_t*>(mapped);
+            _size = static_cast<size_t>(status.st_size);
+            if (sequential) madvise(mapped, _size, MADV_SEQUENTIAL);
+        }
+    }
+    close(fd);                                                  // The mapping keeps the file
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data) munmap(const_cast<uint8_t*>(_data), _size);
+}
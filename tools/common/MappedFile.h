@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief A whole file mapped read-only (mmap), for readers that work in place over its bytes
+ *        (Capture::Reader<RAMStoragePolicy>): nothing is copied, the kernel pages in what a seek
+ *        or a walk touches, so a capture of many gigabytes opens at once.
+ *
+ * An empty file is valid, with no data.
+ */
+class MappedFile
+{
+    public:
+
+    /// @param sequential - a front-to-back walk is coming: ask for read-ahead (MADV_SEQUENTIAL)
+    explicit MappedFile(const char* path, bool sequential = false);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool valid() const { return _error == 0; }
+    int  error() const { return _error; }                      // errno of the failed open / fstat / mmap
+
+    const uint8_t* data() const { return _data; }
+    size_t         size() const { return _size; }
+
+    private:
+
+    const uint8_t* _data;
+    size_t         _size;
+    int            _error;
+};
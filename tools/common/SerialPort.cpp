@@ -0,0 +1,62 @@
+#include "SerialPort.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace
+{
+    speed_t speedOf(uint32_t baud)
+    {
+        switch (baud)
+        {
+            case 9600:   return B9600;
+            case 19200:  return B19200;
+            case 38400:  return B38400;
+            case 57600:  return B57600;
+            case 115200: return B115200;
+            case 230400: return B230400;
+            default:     return B0;
+        }
+    }
+}
+
+int openSerialPort(const char* path, uint32_t baud)
+{
+    speed_t speed = speedOf(baud);
+    if (speed == B0)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    termios tty{};
+    if (tcgetattr(fd, &tty) < 0)
+    {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+
+    cfmakeraw(&tty);                                            // Binary frames: no echo, no line editing, no CR/LF mapping
+    tty.c_cflag |= CLOCAL | CREAD;
+    tty.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tty.c_cc[VMIN]  = 0;
+    tty.c_cc[VTIME] = 0;
+    cfsetispeed(&tty, speed);
+    cfsetospeed(&tty, speed);
+
+    if (tcsetattr(fd, TCSANOW, &tty) < 0)
+    {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+    tcflush(fd, TCIFLUSH);                                      // Boot noise of a unit reset by the port opening
+    return fd;
+}
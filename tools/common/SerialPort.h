@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Opens a gateway's serial port raw, non-blocking, at baud (8N1, no flow control).
+ *
+ * Works the same on a USB serial adapter and on the slave side of a pty (tests).
+ *
+ * @return int - File descriptor, -1 with errno set on failure (EINVAL: baud not supported)
+ */
+int openSerialPort(const char* path, uint32_t baud);
@@ -0,0 +1,121 @@
+#include "EnergyInputs.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include "Capture/EdgeCapture.h"
+#include "App/RemotePrograms.h"
+#include "Policies/PROGMEMStoragePolicy.h"
+#include "Policies/RAMStoragePolicy.h"
+
+namespace
+{
+    /// @brief The table's entries in file order
+    uint32_t* entry(CurrentTable& table, uint8_t index)
+    {
+        if (index < 3) return &table.mcuUa[index];
+        if (index < 6) return &table.radioUa[index - 3];
+        return &table.carrierUa[index - 6];
+    }
+
+    const char* const NAMES[] = { "mcu_active", "mcu_idle", "mcu_power_down", "radio_sleep", "radio_idle", "radio_synth",
+                                  "tx0", "tx1", "tx2", "tx3", "tx4", "tx5", "tx6", "tx7" };
+    constexpr uint8_t ENTRIES = sizeof(NAMES) / sizeof(NAMES[0]);
+}
+
+bool readCurrentTable(const char* path, CurrentTable& table, std::string& error)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        error = std::string("can not open ") + path;
+        return false;
+    }
+
+    unsigned number = 0;
+    for (std::string line; std::getline(file, line); )
+    {
+        ++number;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        char name[32];
+        char value[32];
+        char extra[2];
+        int fields = sscanf(line.c_str(), "%31s %31s %1s", name, value, extra);
+        if (fields <= 0) continue;                              // Blank or comment only
+
+        uint8_t index = 0;
+        while (index < ENTRIES && strcmp(NAMES[index], name) != 0) ++index;
+        char* end = nullptr;
+        unsigned long ua = fields == 2 ? strtoul(value, &end, 10) : 0;
+        if (index == ENTRIES || fields != 2 || *end || ua > UINT32_MAX)
+        {
+            error = std::string(path) + ":" + std::to_string(number) + ": expected \"<name> <uA>\", name one of mcu_active .. tx7";
+            return false;
+        }
+        *entry(table, index) = static_cast<uint32_t>(ua);
+    }
+    return true;
+}
+
+void printCurrentTable(FILE* out, const CurrentTable& table)
+{
+    CurrentTable copy = table;
+    fprintf(out, "# Supply currents, uA (energy -c)\n");
+    for (uint8_t index = 0; index < ENTRIES; ++index) fprintf(out, "%s %u\n", NAMES[index], *entry(copy, index));
+}
+
+std::vector<Waveform::Edge> compiledBurst()
+{
+    std::vector<Waveform::Edge> burst;
+    Waveform::Interpreter<PROGMEMStoragePolicy, false> program(REMOTE1_OPEN_DOOR_PROGRAM.data(), REMOTE1_OPEN_DOOR_PROGRAM.size());
+    Waveform::Edge edge{ 0, 0 };
+    while (program.next(edge)) if (edge.durationUs) burst.push_back(edge);
+    return burst;
+}
+
+bool captureBurst(const uint8_t* capture, size_t size, std::vector<Waveform::Edge>& burst)
+{
+    Capture::Reader<RAMStoragePolicy> reader(capture, size);
+    if (!reader.valid()) return false;
+    auto cursor = reader.begin();
+    Waveform::Edge edge{ 0, 0 };
+    burst.clear();
+    while (cursor.next(edge)) if (edge.durationUs) burst.push_back(edge);
+    return !cursor.faulted();
+}
+
+bool readFieldTrace(const char* path, std::vector<Trace::Record>& records, std::string& error)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        error = std::string("can not open ") + path;
+        return false;
+    }
+
+    Trace::Decoder decoder;
+    Trace::Record record{};
+    for (std::string line; std::getline(file, line); )
+    {
+        if (line.compare(0, 4, "TRC ") != 0) continue;
+        for (size_t i = 4; i + 1 < line.size() && line[i] != '\r'; i += 2)
+        {
+            char hex[3] = { line[i], line[i + 1], 0 };
+            char* end = nullptr;
+            uint8_t byte = static_cast<uint8_t>(strtoul(hex, &end, 16));
+            if (*end || decoder.faulted())
+            {
+                error = std::string(path) + ": not a field trace after " + std::to_string(records.size()) + " records";
+                return false;
+            }
+            if (decoder.push(byte, record)) records.push_back(record);
+        }
+    }
+    if (decoder.faulted())
+    {
+        error = std::string(path) + ": not a field trace after " + std::to_string(records.size()) + " records";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "Capture/TraceFormat.h"
+#include "Simulation/EnergyModel.h"
+
+/**
+ * @brief Current table file: one "<name> <uA>" per line, '#' starts a comment. Names are
+ *        mcu_active mcu_idle mcu_power_down radio_sleep radio_idle radio_synth and tx0 .. tx7
+ *        (carrier on, per PATABLE index). Entries not in the file keep their value in table.
+ *
+ * @return false with error set on an unknown name, a bad value or a file that does not open
+ */
+bool readCurrentTable(const char* path, CurrentTable& table, std::string& error);
+
+/// @brief table in the readCurrentTable() format
+void printCurrentTable(FILE* out, const CurrentTable& table);
+
+/// @brief The open-door burst as edges: the compiled program, or an edge capture's (zero-length edges dropped)
+std::vector<Waveform::Edge> compiledBurst();
+bool captureBurst(const uint8_t* capture, size_t size, std::vector<Waveform::Edge>& burst);
+
+/**
+ * @brief Decodes the "TRC <hex>" lines of a field log (Capture/FieldTrace.h) into records; other
+ *        lines are skipped, like trace_replay does.
+ *
+ * @return false with error set when the file does not open or the stream does not decode
+ */
+bool readFieldTrace(const char* path, std::vector<Trace::Record>& records, std::string& error);
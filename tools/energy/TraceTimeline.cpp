@@ -0,0 +1,166 @@
+#include "TraceTimeline.h"
+
+namespace
+{
+    constexpr uint8_t FREND0      = 0x22;
+    constexpr uint8_t READ_FLAG   = 0x80;
+    constexpr uint8_t BURST_FLAG  = 0x40;
+    constexpr uint8_t FIRST_STROBE = 0x30;
+    constexpr uint8_t LAST_STROBE  = 0x3D;
+
+    constexpr uint8_t SRES    = 0x30;
+    constexpr uint8_t SFSTXON = 0x31;
+    constexpr uint8_t SXOFF   = 0x32;
+    constexpr uint8_t SCAL    = 0x33;
+    constexpr uint8_t SRX     = 0x34;
+    constexpr uint8_t STX     = 0x35;
+    constexpr uint8_t SIDLE   = 0x36;
+    constexpr uint8_t SPWD    = 0x39;
+}
+
+TraceTimeline::TraceTimeline(const FirmwareMode& mode, const CurrentTable& currents, const std::vector<Waveform::Edge>& burst):
+_mode(mode),
+_meter(currents),
+_burst(burst),
+_paIndex(PATABLE_HIGH_INDEX)
+{}
+
+void TraceTimeline::add(const Trace::Record& record)
+{
+    switch (record.kind)
+    {
+        case Trace::Kind::Start:
+            break;
+
+        case Trace::Kind::Edge:
+            advance(_nowUs + record.value);
+            break;
+
+        case Trace::Kind::Select:
+            advance(_nowUs + record.value);
+            if (_radio == Radio::Sleep) enter(Radio::Idle);     // CSn low starts the crystal
+            _bytes = 0;
+            break;
+
+        case Trace::Kind::Byte:
+        {
+            if (_bytes++ == 0)
+            {
+                _header = record.mosi;
+                uint8_t address = _header & 0x3F;
+                if (!(_header & BURST_FLAG) && address >= FIRST_STROBE && address <= LAST_STROBE) strobe(address);
+                break;
+            }
+            if (_header & READ_FLAG) break;
+            uint16_t address = (_header & 0x3F) + ((_header & BURST_FLAG) ? _bytes - 2 : 0);
+            if (address == FREND0 && ((_header & BURST_FLAG) || _bytes == 2)) _paIndex = record.mosi & 0x07;
+            break;
+        }
+
+        case Trace::Kind::Gap:
+            ++_gaps;
+            break;
+    }
+}
+
+void TraceTimeline::finish()
+{
+    if (_radio != Radio::Sleep && _radio != Radio::Idle && _transmitted) ++_pressCount;
+    _transmitted = false;
+}
+
+void TraceTimeline::strobe(uint8_t command)
+{
+    switch (command)
+    {
+        case SRES:
+        case SIDLE:   enter(Radio::Idle); break;
+        case SXOFF:
+        case SPWD:    enter(Radio::Sleep); break;
+        case SFSTXON:
+        case SCAL:
+        case SRX:     enter(Radio::Synth); break;
+        case STX:     enter(Radio::Transmit); break;
+        default:      break;                                    // Flushes, SNOP, ...: no state change
+    }
+}
+
+void TraceTimeline::enter(Radio radio)
+{
+    bool wasStandby = _radio == Radio::Sleep || _radio == Radio::Idle;
+    bool standby    = radio == Radio::Sleep || radio == Radio::Idle;
+
+    if (wasStandby && !standby)
+    {
+        _transmitted  = false;
+        _calibratedUs = _nowUs + ENERGY_RADIO_CALIBRATE_US;
+    }
+    if (!wasStandby && standby && _transmitted) ++_pressCount;
+    if (radio == Radio::Transmit && _radio != Radio::Transmit)
+    {
+        _transmitted = true;
+        _burstEdge   = 0;
+        _burstEdgeUs = 0;
+    }
+    _radio = radio;
+}
+
+void TraceTimeline::advance(uint64_t toUs)
+{
+    if (_radio == Radio::Sleep || _radio == Radio::Idle)
+    {
+        charge(_mode.standbyMcu, _nowUs, toUs);
+        _nowUs = toUs;
+        return;
+    }
+
+    uint64_t calibratedUs = _calibratedUs < toUs ? _calibratedUs : toUs;
+    if (_nowUs < calibratedUs)
+    {
+        uint64_t durationUs = calibratedUs - _nowUs;
+        _presses.chargePc   += static_cast<uint64_t>(_meter.currentUa(McuPower::Active, RadioPower::Synth)) * durationUs;
+        _presses.durationUs += durationUs;
+        if (_radio == Radio::Transmit) _presses.transmitUs += durationUs;
+        _nowUs = calibratedUs;
+    }
+    if (_nowUs >= toUs) return;
+
+    if (_radio == Radio::Transmit) chargeBurst(toUs - _nowUs);
+    else                           charge(McuPower::Idle, _nowUs, toUs);
+    _nowUs = toUs;
+}
+
+void TraceTimeline::charge(McuPower mcu, uint64_t fromUs, uint64_t toUs)
+{
+    RadioPower radio = _radio == Radio::Sleep ? RadioPower::Sleep : _radio == Radio::Idle ? RadioPower::Idle : RadioPower::Synth;
+    ChargeTotal& total = (_radio == Radio::Sleep || _radio == Radio::Idle) ? _standby : _presses;
+    total.chargePc   += static_cast<uint64_t>(_meter.currentUa(mcu, radio)) * (toUs - fromUs);
+    total.durationUs += toUs - fromUs;
+}
+
+void TraceTimeline::chargeBurst(uint64_t durationUs)
+{
+    _presses.durationUs += durationUs;
+    _presses.transmitUs += durationUs;
+    if (_burst.empty())
+    {
+        _presses.chargePc += static_cast<uint64_t>(_meter.currentUa(McuPower::Active, RadioPower::Synth)) * durationUs;
+        return;
+    }
+
+    while (durationUs)
+    {
+        const Waveform::Edge& edge = _burst[_burstEdge];
+        uint64_t leftUs = edge.durationUs - _burstEdgeUs;
+        uint64_t takenUs = leftUs < durationUs ? leftUs : durationUs;
+        RadioPower radio = edge.level ? RadioPower::Carrier : RadioPower::Synth;
+        _presses.chargePc += static_cast<uint64_t>(_meter.currentUa(McuPower::Active, radio, _paIndex)) * takenUs;
+        durationUs   -= takenUs;
+        _burstEdgeUs += static_cast<uint32_t>(takenUs);
+        if (_burstEdgeUs == edge.durationUs)
+        {
+            _burstEdgeUs = 0;
+            _burstEdge   = (_burstEdge + 1) % _burst.size();   // Held: the burst starts over
+        }
+    }
+}
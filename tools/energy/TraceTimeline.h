@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "Capture/TraceFormat.h"
+#include "Simulation/EnergyEstimator.h"
+
+/// @brief Charge and time of a part of a timeline, without EnergyMeter's 32-bit duration (a trace can run for days)
+struct ChargeTotal
+{
+    uint64_t chargePc  = 0;
+    uint64_t durationUs = 0;
+    uint64_t transmitUs = 0;                                    // STX .. the strobe that ends it
+};
+
+/**
+ * @brief Power-state timeline of a field trace (Capture/TraceFormat.h), integrated into charge.
+ *
+ * A trace holds the SPI traffic, not the chip's state, so the radio state follows the strobes
+ * the firmware sent:
+ *   SFSTXON / SCAL / SRX -> Synth (the table has no RX figure), STX -> transmitting,
+ *   SIDLE / SRES -> Idle, SPWD / SXOFF -> Sleep, CSn falling on a sleeping chip -> Idle.
+ * The carrier is charged at the PATABLE entry the last FREND0 write selected (PATABLE_HIGH_INDEX
+ * before one). GDO0 is not traced: a transmission is charged as `burst` played from its start,
+ * repeated while it lasts (hold to transmit). Leaving Idle / Sleep for Synth or TX calibrates:
+ * the MCU is active for ENERGY_RADIO_CALIBRATE_US (it polls MARCSTATE through it), as in
+ * EnergyEstimator's press.
+ *
+ * A press is a stretch with the radio out of Idle / Sleep that transmits. Stretches that do not
+ * (a calibration cancelled on a bounce) are charged to the presses too; everything else is
+ * standby. The MCU is idle inside a press outside the calibration and the burst, and in the
+ * mode's standby state between presses.
+ */
+class TraceTimeline
+{
+    public:
+
+    TraceTimeline(const FirmwareMode& mode, const CurrentTable& currents, const std::vector<Waveform::Edge>& burst);
+
+    void add(const Trace::Record& record);
+    /// @brief Closes the timeline at its last timed record
+    void finish();
+
+    const ChargeTotal& presses() const { return _presses; }
+    const ChargeTotal& standby() const { return _standby; }
+    uint32_t pressCount() const { return _pressCount; }
+    uint32_t gaps() const { return _gaps; }                     // Gap records: the recorder dropped some, the timeline has holes
+    uint64_t durationUs() const { return _nowUs; }
+
+    private:
+
+    enum class Radio : uint8_t { Sleep, Idle, Synth, Transmit };
+
+    void advance(uint64_t toUs);
+    void charge(McuPower mcu, uint64_t fromUs, uint64_t toUs);
+    void chargeBurst(uint64_t durationUs);
+    void strobe(uint8_t command);
+    void enter(Radio radio);
+
+    FirmwareMode                        _mode;
+    EnergyMeter                         _meter;                 // currentUa() only
+    const std::vector<Waveform::Edge>&  _burst;
+    ChargeTotal                         _presses;
+    ChargeTotal                         _standby;
+    uint32_t                            _pressCount = 0;
+    uint32_t                            _gaps = 0;
+
+    uint64_t _nowUs = 0;
+    Radio    _radio = Radio::Idle;
+    uint8_t  _paIndex;
+    uint64_t _calibratedUs = 0;                                 // MCU active until then
+    bool     _transmitted = false;                              // In this press
+    size_t   _burstEdge = 0;                                    // Position in the burst of a transmission
+    uint32_t _burstEdgeUs = 0;
+
+    uint8_t  _header = 0;                                       // Current transaction
+    uint16_t _bytes = 0;
+};
@@ -0,0 +1,130 @@
+// Energy and airtime of the firmware modes on the host (Simulation/EnergyEstimator), with any
+// current table and burst, and of a recorded field trace (Capture/FieldTrace.h). Prints the
+// lines ENERGY_ESTIMATE_MODE prints, then one for the trace.
+//
+//   energy [-c currents.txt] [-p presses_per_day] [-b battery_mAh] [-e burst.ecap] [-m mode] [-t field.log]
+//   energy -T [-c currents.txt]
+//
+//   -c  current table (EnergyInputs.h format; default the datasheet figures of Config/Constants.h)
+//   -p  presses per day (default ENERGY_PRESSES_PER_DAY)
+//   -b  battery capacity (default ENERGY_BATTERY_MAH)
+//   -e  the burst from an edge capture (Capture/EdgeCapture.h) instead of the compiled program
+//   -m  firmware mode the trace was recorded in: the MCU's standby state (default armed)
+//   -t  field log: its power-state timeline (TraceTimeline.h), "ENERGY trace ..."
+//   -T  print the current table and exit (a starting point for -c)
+#include "EnergyInputs.h"
+#include "TraceTimeline.h"
+#include "MappedFile.h"
+#include <HostBoard.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <memory>
+
+namespace
+{
+    void usage()
+    {
+        fprintf(stderr, "usage: energy [-c currents.txt] [-p presses_per_day] [-b battery_mAh] [-e burst.ecap] [-m mode] [-t field.log]\n"
+                        "       energy -T [-c currents.txt]\n");
+        exit(2);
+    }
+
+    /// @brief The trace's line, fields as the mode lines have them (presses= in place of words=)
+    void printTrace(const TraceTimeline& timeline, const EnergySetup& setup)
+    {
+        uint32_t presses  = timeline.pressCount();
+        const ChargeTotal& press   = timeline.presses();
+        const ChargeTotal& standby = timeline.standby();
+        uint64_t pressPc  = presses ? press.chargePc / presses : 0;
+        uint64_t pressUs  = presses ? press.durationUs / presses : 0;
+        uint32_t standbyUa = standby.durationUs ? static_cast<uint32_t>((standby.chargePc + standby.durationUs / 2) / standby.durationUs) : 0;
+        DailyEnergy day   = dailyEnergy(pressPc, static_cast<uint32_t>(pressUs), standbyUa, setup.pressesPerDay, setup.batteryMah);
+
+        printf("ENERGY trace presses=%u press_ms=%llu airtime_ms=%llu press_uC=%llu standby_uA=%u day_mC=%u avg_uA=%u life_days=%u trace_s=%llu gaps=%u\n",
+               presses, static_cast<unsigned long long>(pressUs / 1000),
+               static_cast<unsigned long long>(presses ? press.transmitUs / presses / 1000 : 0),
+               static_cast<unsigned long long>(pressPc / 1000000), standbyUa, day.dayUc / 1000, day.averageUa, day.lifetimeDays,
+               static_cast<unsigned long long>(timeline.durationUs() / 1000000), timeline.gaps());
+    }
+}
+
+int main(int argc, char** argv)
+{
+    EnergySetup setup;
+    const char* tablePath   = nullptr;
+    const char* capturePath = nullptr;
+    const char* tracePath   = nullptr;
+    const char* modeName    = "armed";
+    bool printTable = false;
+
+    int option;
+    while ((option = getopt(argc, argv, "c:p:b:e:m:t:T")) != -1)
+    {
+        switch (option)
+        {
+            case 'c': tablePath   = optarg; break;
+            case 'p': setup.pressesPerDay = static_cast<uint16_t>(strtoul(optarg, nullptr, 0)); break;
+            case 'b': setup.batteryMah    = static_cast<uint32_t>(strtoul(optarg, nullptr, 0)); break;
+            case 'e': capturePath = optarg; break;
+            case 'm': modeName    = optarg; break;
+            case 't': tracePath   = optarg; break;
+            case 'T': printTable  = true; break;
+            default:  usage();
+        }
+    }
+    if (optind != argc) usage();
+
+    std::string error;
+    if (tablePath && !readCurrentTable(tablePath, setup.currents, error))
+    {
+        fprintf(stderr, "energy: %s\n", error.c_str());
+        return 1;
+    }
+    if (printTable)
+    {
+        printCurrentTable(stdout, setup.currents);
+        return 0;
+    }
+
+    uint8_t mode = EnergyEstimator::modeIndex(modeName);
+    if (mode == EnergyEstimator::modeCount())
+    {
+        fprintf(stderr, "energy: no firmware mode %s\n", modeName);
+        return 2;
+    }
+
+    std::vector<Waveform::Edge> burst = compiledBurst();
+    std::unique_ptr<MappedFile> capture;
+    if (capturePath)
+    {
+        capture.reset(new MappedFile(capturePath));
+        if (!capture->valid() || !captureBurst(capture->data(), capture->size(), burst))
+        {
+            fprintf(stderr, "energy: %s is not an edge capture\n", capturePath);
+            return 1;
+        }
+        setup.capture      = capture->data();
+        setup.captureBytes = capture->size();
+    }
+
+    hal::reset();
+    runEnergyEstimate(Serial, setup);
+    fflush(stdout);
+
+    if (tracePath)
+    {
+        std::vector<Trace::Record> records;
+        if (!readFieldTrace(tracePath, records, error))
+        {
+            fprintf(stderr, "energy: %s\n", error.c_str());
+            return 1;
+        }
+        TraceTimeline timeline(EnergyEstimator::mode(mode), setup.currents, burst);
+        for (const Trace::Record& record : records) timeline.add(record);
+        timeline.finish();
+        printTrace(timeline, setup);
+    }
+    return 0;
+}
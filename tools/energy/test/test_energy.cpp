@@ -0,0 +1,366 @@
+// The host energy tool's inputs and trace timelines: current table files, a burst read from a
+// capture, and field traces built record by record, whose charge is checked segment by segment
+// against EnergyMeter.
+#include "EnergyInputs.h"
+#include "TraceTimeline.h"
+#include <HostBoard.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "Capture/EdgeCapture.h"
+
+namespace
+{
+    int failures = 0;
+
+    #define CHECK(condition) \
+        do { if (!(condition)) { ++failures; fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); } } while (0)
+
+    #define CHECK_EQUAL(expected, actual) \
+        do { auto e_ = (expected); auto a_ = (actual); if (!(e_ == a_)) { ++failures; \
+             fprintf(stderr, "  %s:%d: expected %s, got %s\n", __FILE__, __LINE__, toText(e_).c_str(), toText(a_).c_str()); } } while (0)
+
+    std::string toText(const std::string& value) { return "\"" + value + "\""; }
+    template<typename T> std::string toText(T value) { return std::to_string(value); }
+
+    constexpr uint8_t SFSTXON = 0x31;
+    constexpr uint8_t STX     = 0x35;
+    constexpr uint8_t SIDLE   = 0x36;
+    constexpr uint8_t SPWD    = 0x39;
+    constexpr uint8_t FREND0  = 0x22;
+
+    /// @brief Print into a string
+    struct Text : Print
+    {
+        std::string text;
+        size_t write(uint8_t byte) override { text += static_cast<char>(byte); return 1; }
+    };
+
+    /// @brief Capture::Writer sink into a vector
+    struct Bytes
+    {
+        std::vector<uint8_t> bytes;
+        size_t write(const uint8_t* data, size_t length) { bytes.insert(bytes.end(), data, data + length); return length; }
+    };
+
+    /// @brief A file in /tmp, removed with the fixture
+    struct TempFile
+    {
+        std::string path;
+
+        TempFile()
+        {
+            char name[] = "/tmp/energyXXXXXX";
+            int fd = mkstemp(name);
+            if (fd >= 0) ::close(fd);
+            path = name;
+        }
+        ~TempFile() { unlink(path.c_str()); }
+    };
+
+    bool writeText(const std::string& path, const std::string& text)
+    {
+        FILE* file = fopen(path.c_str(), "w");
+        if (!file) return false;
+        bool written = fwrite(text.data(), 1, text.size(), file) == text.size();
+        return fclose(file) == 0 && written;
+    }
+
+    /// @brief A field trace written at absolute times, as the recorder would
+    struct TraceBuilder
+    {
+        std::vector<Trace::Record> records{ Trace::start(1) };
+        uint64_t lastUs = 0;
+
+        uint32_t delta(uint64_t us)
+        {
+            uint32_t deltaUs = static_cast<uint32_t>(us - lastUs);
+            lastUs = us;
+            return deltaUs;
+        }
+
+        void edge(uint64_t us, uint8_t level) { records.push_back(Trace::edge(level, delta(us))); }
+
+        void transaction(uint64_t us, std::initializer_list<uint8_t> mosi)
+        {
+            records.push_back(Trace::select(delta(us)));
+            for (uint8_t byte : mosi) records.push_back(Trace::byte(byte, 0x0F));
+        }
+
+        void strobe(uint64_t us, uint8_t command) { transaction(us, { command }); }
+    };
+
+    /// @brief Edge source over a vector, from an offset, repeated: what a held transmission plays
+    struct Repeated
+    {
+        const std::vector<Waveform::Edge>& edges;
+        size_t next_ = 0;
+
+        bool next(Waveform::Edge& edge)
+        {
+            edge = edges[next_];
+            next_ = (next_ + 1) % edges.size();
+            return true;
+        }
+    };
+
+    uint32_t burstUs(const std::vector<Waveform::Edge>& burst)
+    {
+        uint32_t total = 0;
+        for (const Waveform::Edge& edge : burst) total += edge.durationUs;
+        return total;
+    }
+
+    /// @brief Charge of durationUs of transmission at paIndex, the burst from its start
+    uint64_t transmitPc(const std::vector<Waveform::Edge>& burst, uint8_t paIndex, uint32_t durationUs)
+    {
+        EnergyMeter meter;
+        Repeated source{ burst };
+        meter.addBurst(source, paIndex, durationUs);
+        return meter.chargePc();
+    }
+
+    uint64_t pc(McuPower mcu, RadioPower radio, uint64_t durationUs)
+    {
+        return static_cast<uint64_t>(EnergyMeter().currentUa(mcu, radio)) * durationUs;
+    }
+
+    /// @brief A press as the firmware makes it: speculative FSTXON at the first edge, STX on
+    ///        confirmation, SIDLE after transmitUs, then a quiet minute
+    TraceBuilder press(uint32_t transmitUs, uint8_t frend0 = 0)
+    {
+        TraceBuilder trace;
+        if (frend0) trace.transaction(500000, { FREND0, frend0 });
+        trace.edge(1000000, 0);
+        trace.strobe(1000020, SFSTXON);
+        for (uint64_t us = 1000100; us < 1001000; us += 100) trace.transaction(us, { 0xF5, 0x00 });    // MARCSTATE polls
+        trace.strobe(1010000, STX);
+        trace.strobe(1010000 + transmitUs, SIDLE);
+        trace.edge(1300000 + transmitUs, 1);
+        trace.edge(61000000, 1);
+        return trace;
+    }
+
+    TraceTimeline replay(const TraceBuilder& trace, const std::vector<Waveform::Edge>& burst, const char* mode = "armed")
+    {
+        TraceTimeline timeline(EnergyEstimator::mode(EnergyEstimator::modeIndex(mode)), DATASHEET_CURRENTS, burst);
+        for (const Trace::Record& record : trace.records) timeline.add(record);
+        timeline.finish();
+        return timeline;
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Tests
+    // ---------------------------------------------------------------------------------
+
+    // Entries override the datasheet table, comments and blanks are skipped, -T output reads back
+    void test_current_table_file()
+    {
+        TempFile file;
+        CHECK(writeText(file.path, "# bench figures\n\ntx7 30000\nmcu_idle   2000   # measured\r\n"));
+        CurrentTable table = DATASHEET_CURRENTS;
+        std::string error;
+        CHECK(readCurrentTable(file.path.c_str(), table, error));
+        CHECK_EQUAL(30000u, table.carrierUa[7]);
+        CHECK_EQUAL(2000u, table.mcuUa[1]);
+        CHECK_EQUAL(DATASHEET_CURRENTS.radioUa[2], table.radioUa[2]);
+
+        FILE* out = fopen(file.path.c_str(), "w");
+        printCurrentTable(out, table);
+        fclose(out);
+        CurrentTable back = DATASHEET_CURRENTS;
+        CHECK(readCurrentTable(file.path.c_str(), back, error));
+        CHECK(memcmp(&table, &back, sizeof(table)) == 0);
+
+        CHECK(writeText(file.path, "tx0 1\ntx8 5\n"));
+        CHECK(!readCurrentTable(file.path.c_str(), table, error));
+        CHECK(error.find(":2:") != std::string::npos);
+        CHECK(writeText(file.path, "radio_idle 17mA\n"));
+        CHECK(!readCurrentTable(file.path.c_str(), table, error));
+    }
+
+    // A capture of the compiled burst estimates like the program, and a table changes the figures
+    void test_capture_burst_and_table_change_the_estimate()
+    {
+        std::vector<Waveform::Edge> burst = compiledBurst();
+        Bytes file;
+        Capture::Writer<Bytes> writer(file);
+        for (const Waveform::Edge& edge : burst) writer.add(edge.level, edge.durationUs);
+        writer.finish();
+
+        std::vector<Waveform::Edge> read;
+        CHECK(captureBurst(file.bytes.data(), file.bytes.size(), read));
+        CHECK_EQUAL(burst.size(), read.size());
+
+        Text board, fromCapture, louder;
+        runEnergyEstimate(board);
+        EnergySetup setup;
+        setup.capture      = file.bytes.data();
+        setup.captureBytes = file.bytes.size();
+        runEnergyEstimate(fromCapture, setup);
+        CHECK(!board.text.empty());
+        CHECK_EQUAL(board.text, fromCapture.text);
+
+        EnergySetup loud;
+        loud.currents.carrierUa[PATABLE_HIGH_INDEX] *= 2;
+        runEnergyEstimate(louder, loud);
+        CHECK(louder.text != board.text);
+        CHECK_EQUAL(EnergyEstimator::modeCount(), EnergyEstimator::modeIndex("nope"));
+        CHECK_EQUAL(2, EnergyEstimator::modeIndex("deep"));
+    }
+
+    // Calibration (MCU active), FSTXON wait, one burst, then the minute in standby
+    void test_press_charged_segment_by_segment()
+    {
+        std::vector<Waveform::Edge> burst = compiledBurst();
+        uint32_t transmitUs = burstUs(burst);
+        TraceTimeline timeline = replay(press(transmitUs), burst);
+
+        CHECK_EQUAL(1u, timeline.pressCount());
+        CHECK_EQUAL(0u, timeline.gaps());
+        uint64_t pressPc = pc(McuPower::Active, RadioPower::Synth, ENERGY_RADIO_CALIBRATE_US) +
+                           pc(McuPower::Idle, RadioPower::Synth, 1010000 - 1000020 - ENERGY_RADIO_CALIBRATE_US) +
+                           transmitPc(burst, PATABLE_HIGH_INDEX, transmitUs);
+        CHECK_EQUAL(pressPc, timeline.presses().chargePc);
+        CHECK_EQUAL(uint64_t(1010000 - 1000020 + transmitUs), timeline.presses().durationUs);
+        CHECK_EQUAL(uint64_t(transmitUs), timeline.presses().transmitUs);
+
+        uint64_t standbyUs = 1000020 + (61000000 - 1010000 - transmitUs);
+        CHECK_EQUAL(pc(McuPower::Idle, RadioPower::Idle, standbyUs), timeline.standby().chargePc);
+        CHECK_EQUAL(uint64_t(61000000), timeline.durationUs());
+    }
+
+    // FREND0 selects the PATABLE entry on air, single or burst write
+    void test_pa_level_follows_frend0()
+    {
+        std::vector<Waveform::Edge> burst = compiledBurst();
+        uint32_t transmitUs = burstUs(burst);
+        uint64_t high = replay(press(transmitUs), burst).presses().chargePc;
+        uint64_t low  = replay(press(transmitUs, 0x13), burst).presses().chargePc;
+        CHECK_EQUAL(high - transmitPc(burst, PATABLE_HIGH_INDEX, transmitUs) + transmitPc(burst, 3, transmitUs), low);
+
+        TraceBuilder trace = press(transmitUs);
+        trace.records.insert(trace.records.begin() + 1, { Trace::select(0), Trace::byte(0x40 | 0x20, 0), Trace::byte(0, 0),
+                                                          Trace::byte(0, 0), Trace::byte(0x11, 0) });   // Burst write from 0x20: FREND0 third
+        CHECK_EQUAL(high - transmitPc(burst, PATABLE_HIGH_INDEX, transmitUs) + transmitPc(burst, 1, transmitUs),
+                    replay(trace, burst).presses().chargePc);
+    }
+
+    // Held past the burst: it plays again from the start
+    void test_held_transmission_repeats_the_burst()
+    {
+        std::vector<Waveform::Edge> burst = compiledBurst();
+        uint32_t transmitUs = 2 * burstUs(burst) + 1000;
+        TraceTimeline timeline = replay(press(transmitUs), burst);
+        CHECK_EQUAL(1u, timeline.pressCount());
+        CHECK_EQUAL(2 * transmitPc(burst, PATABLE_HIGH_INDEX, burstUs(burst)) + transmitPc(burst, PATABLE_HIGH_INDEX, 1000),
+                    timeline.presses().chargePc - pc(McuPower::Active, RadioPower::Synth, ENERGY_RADIO_CALIBRATE_US) -
+                    pc(McuPower::Idle, RadioPower::Synth, 1010000 - 1000020 - ENERGY_RADIO_CALIBRATE_US));
+    }
+
+    // Deep mode: the radio sleeps after the press (SPWD) and the MCU powers down
+    void test_deep_standby_sleeps()
+    {
+        std::vector<Waveform::Edge> burst = compiledBurst();
+        TraceBuilder trace;
+        trace.strobe(100, SPWD);
+        trace.strobe(1000000, SFSTXON);                          // CSn wakes the chip, then calibrates
+        trace.strobe(1010000, STX);
+        trace.strobe(1100000, SIDLE);
+        trace.strobe(1100100, SPWD);
+        trace.edge(5000000, 1);
+
+        TraceTimeline timeline = replay(trace, burst, "deep");
+        CHECK_EQUAL(1u, timeline.pressCount());
+        uint64_t standbyPc = pc(McuPower::PowerDown, RadioPower::Idle, 100) + pc(McuPower::PowerDown, RadioPower::Sleep, 1000000 - 100) +
+                             pc(McuPower::PowerDown, RadioPower::Idle, 100) + pc(McuPower::PowerDown, RadioPower::Sleep, 5000000 - 1100100);
+        CHECK_EQUAL(standbyPc, timeline.standby().chargePc);
+    }
+
+    // A calibration cancelled on a bounce is charged, but is not a press
+    void test_cancelled_calibration_is_not_a_press()
+    {
+        std::vector<Waveform::Edge> burst = compiledBurst();
+        TraceBuilder trace;
+        trace.strobe(1000, SFSTXON);
+        trace.strobe(3000, SIDLE);
+        trace.edge(10000, 1);
+
+        TraceTimeline timeline = replay(trace, burst);
+        CHECK_EQUAL(0u, timeline.pressCount());
+        CHECK_EQUAL(pc(McuPower::Active, RadioPower::Synth, ENERGY_RADIO_CALIBRATE_US) +
+                    pc(McuPower::Idle, RadioPower::Synth, 2000 - ENERGY_RADIO_CALIBRATE_US), timeline.presses().chargePc);
+    }
+
+    // "TRC" lines among the other output of a field unit; a broken stream is refused
+    void test_field_log_lines()
+    {
+        TraceBuilder trace = press(5000);
+        trace.records.push_back(Trace::gap(3));
+        std::string hex;
+        for (const Trace::Record& record : trace.records)
+        {
+            uint8_t bytes[Trace::MAX_RECORD_BYTES];
+            uint8_t length = Trace::encode(record, bytes);
+            for (uint8_t i = 0; i < length; ++i)
+            {
+                char text[3];
+                snprintf(text, sizeof(text), "%02x", bytes[i]);
+                hex += text;
+            }
+        }
+
+        TempFile file;
+        std::string log = "System Booting...\r\n";
+        for (size_t at = 0; at < hex.size(); at += 48) log += "TRC " + hex.substr(at, 48) + "\r\nMARCSTATE: 0x1\r\n";
+        CHECK(writeText(file.path, log));
+
+        std::vector<Trace::Record> records;
+        std::string error;
+        CHECK(readFieldTrace(file.path.c_str(), records, error));
+        CHECK(records == trace.records);
+        CHECK_EQUAL(1u, replay(trace, compiledBurst()).gaps());
+
+        CHECK(writeText(file.path, "TRC 01ff\n"));
+        records.clear();
+        CHECK(!readFieldTrace(file.path.c_str(), records, error));
+        CHECK(!readFieldTrace("/nonexistent.log", records, error));
+    }
+
+    struct Test
+    {
+        const char* name;
+        void (*run)();
+    };
+}
+
+int main()
+{
+    hal::reset();
+
+    const Test tests[] =
+    {
+        { "current_table_file",                          test_current_table_file },
+        { "capture_burst_and_table_change_the_estimate", test_capture_burst_and_table_change_the_estimate },
+        { "press_charged_segment_by_segment",            test_press_charged_segment_by_segment },
+        { "pa_level_follows_frend0",                     test_pa_level_follows_frend0 },
+        { "held_transmission_repeats_the_burst",         test_held_transmission_repeats_the_burst },
+        { "deep_standby_sleeps",                         test_deep_standby_sleeps },
+        { "cancelled_calibration_is_not_a_press",        test_cancelled_calibration_is_not_a_press },
+        { "field_log_lines",                             test_field_log_lines },
+    };
+
+    int failed = 0;
+    for (const Test& test : tests)
+    {
+        int before = failures;
+        test.run();
+        bool passed = failures == before;
+        if (!passed) ++failed;
+        printf("%s %s\n", passed ? "PASS" : "FAIL", test.name);
+    }
+    printf("%zu tests, %d failed\n", sizeof(tests) / sizeof(tests[0]), failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,616 @@
+#include "GatewayDaemon.h"
+#include "SerialPort.h"
+#include <errno.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <sstream>
+
+using namespace GatewayProtocol;
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Telemetry and GatewayStats are copied as sent by the AVR (little endian)");
+
+namespace
+{
+    constexpr size_t MAX_EVENTS      = 64;
+    constexpr size_t MAX_LINE        = 256;                     // Longer client input without a newline: client dropped
+    constexpr size_t MAX_CLIENT_OUT  = 1 << 20;                 // Client not reading its replies: dropped
+
+    std::string format(const char* pattern, ...) __attribute__((format(printf, 1, 2)));
+
+    std::string format(const char* pattern, ...)
+    {
+        char line[512];
+        va_list args;
+        va_start(args, pattern);
+        vsnprintf(line, sizeof(line), pattern, args);
+        va_end(args);
+        return line;
+    }
+
+    /// @brief Whole-token unsigned number, false on anything else
+    bool parseNumber(const std::string& token, unsigned long limit, unsigned long& value)
+    {
+        if (token.empty() || token[0] == '-') return false;
+        char* end = nullptr;
+        errno = 0;
+        value = strtoul(token.c_str(), &end, 0);
+        return errno == 0 && *end == '\0' && value <= limit;
+    }
+
+    bool parseHex(const std::string& token, std::vector<uint8_t>& bytes)
+    {
+        if (token.empty() || token.size() % 2) return false;
+        bytes.clear();
+        for (size_t i = 0; i < token.size(); i += 2)
+        {
+            char pair[3] = { token[i], token[i + 1], '\0' };
+            char* end = nullptr;
+            unsigned long byte = strtoul(pair, &end, 16);
+            if (*end != '\0' || !isxdigit(static_cast<unsigned char>(pair[0]))) return false;
+            bytes.push_back(static_cast<uint8_t>(byte));
+        }
+        return true;
+    }
+
+    long millisUntil(GatewayDaemon::Clock::time_point at, GatewayDaemon::Clock::time_point now)
+    {
+        if (at <= now) return 0;
+        return static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(at - now).count()) + 1;
+    }
+}
+
+GatewayDaemon::~GatewayDaemon()
+{
+    for (auto& unit : _units) if (unit->fd >= 0) close(unit->fd);
+    for (auto& entry : _clients) close(entry.second.fd);
+    if (_listen >= 0)
+    {
+        close(_listen);
+        unlink(_options.socketPath.c_str());
+    }
+    if (_epoll >= 0) close(_epoll);
+}
+
+bool GatewayDaemon::start(const Options& options)
+{
+    _options = options;
+
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll < 0)
+    {
+        fprintf(stderr, "gateway_daemon: epoll: %s\n", strerror(errno));
+        return false;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (_options.socketPath.size() >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "gateway_daemon: socket path too long: %s\n", _options.socketPath.c_str());
+        return false;
+    }
+    memcpy(address.sun_path, _options.socketPath.c_str(), _options.socketPath.size() + 1);
+
+    struct stat existing{};
+    if (lstat(_options.socketPath.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) unlink(_options.socketPath.c_str());      // Left by a previous run
+
+    _listen = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (_listen < 0 || bind(_listen, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(_listen, 64) < 0)
+    {
+        fprintf(stderr, "gateway_daemon: %s: %s\n", _options.socketPath.c_str(), strerror(errno));
+        if (_listen >= 0) close(_listen);
+        _listen = -1;
+        return false;
+    }
+    if (!watch(_listen, Source::Listen, 0, EPOLLIN)) return false;
+
+    for (const std::string& path : _options.ports)
+    {
+        auto unit = std::make_unique<Unit>();
+        unit->path = path;
+        if (!unit->rx.allocate(_options.ringBytes))
+        {
+            fprintf(stderr, "gateway_daemon: ring for %s: %s\n", path.c_str(), strerror(errno));
+            return false;
+        }
+        _units.push_back(std::move(unit));
+        openPort(_units.size() - 1);
+    }
+    return true;
+}
+
+int GatewayDaemon::runOnce(int timeoutMs)
+{
+    // Wake up for the next request deadline or port retry, whichever comes first
+    Clock::time_point now = Clock::now();
+    long waitMs = timeoutMs;
+    for (const Pending& pending : _pending) waitMs = std::min(waitMs, millisUntil(pending.deadline, now));
+    for (const auto& unit : _units) if (!unit->online()) waitMs = std::min(waitMs, millisUntil(unit->retryAt, now));
+
+    epoll_event events[MAX_EVENTS];
+    int count = epoll_wait(_epoll, events, MAX_EVENTS, static_cast<int>(waitMs));
+    if (count < 0)
+    {
+        if (errno == EINTR) return 0;
+        fprintf(stderr, "gateway_daemon: epoll_wait: %s\n", strerror(errno));
+        return -1;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        Source   source = static_cast<Source>(events[i].data.u64 >> 32);
+        uint32_t id     = static_cast<uint32_t>(events[i].data.u64);
+        switch (source)
+        {
+            case Source::Listen: onListen(); break;
+            case Source::Port:   onPort(id, events[i].events); break;
+            case Source::Client: onClient(id, events[i].events); break;
+        }
+    }
+
+    expire(Clock::now());
+
+    std::vector<uint32_t> replied;
+    replied.swap(_replied);
+    for (uint32_t id : replied) flushClient(id);
+    return count;
+}
+
+// ---------------------------------------------------------------------------------
+//  Serial ports
+// ---------------------------------------------------------------------------------
+
+bool GatewayDaemon::openPort(size_t index)
+{
+    Unit& unit = *_units[index];
+    unit.fd = openSerialPort(unit.path.c_str(), _options.baud);
+    if (unit.fd < 0)
+    {
+        fprintf(stderr, "gateway_daemon: %s: %s\n", unit.path.c_str(), strerror(errno));
+        unit.retryAt = Clock::now() + std::chrono::milliseconds(_options.reopenMs);
+        return false;
+    }
+
+    unit.rx.clear();
+    unit.tx.clear();
+    unit.writing = false;
+    unit.credits = GATEWAY_QUEUE_DEPTH;                         // A unit that (re)appears has just reset
+    unit.unacked = 0;
+    if (!watch(unit.fd, Source::Port, static_cast<uint32_t>(index), EPOLLIN))
+    {
+        close(unit.fd);
+        unit.fd = -1;
+        unit.retryAt = Clock::now() + std::chrono::milliseconds(_options.reopenMs);
+        return false;
+    }
+    return true;
+}
+
+void GatewayDaemon::closePort(size_t index, const char* why)
+{
+    Unit& unit = *_units[index];
+    if (unit.fd < 0) return;
+
+    fprintf(stderr, "gateway_daemon: %s offline (%s)\n", unit.path.c_str(), why);
+    epoll_ctl(_epoll, EPOLL_CTL_DEL, unit.fd, nullptr);
+    close(unit.fd);
+    unit.fd = -1;
+    unit.retryAt = Clock::now() + std::chrono::milliseconds(_options.reopenMs);
+
+    for (auto it = _pending.begin(); it != _pending.end(); )
+    {
+        if (it->unit != index) { ++it; continue; }
+        if (it->client) reply(it->client, format("OFFLINE %zu seq=%u", index, it->sequence));
+        it = _pending.erase(it);
+    }
+}
+
+/**
+ * @brief Reads what the port has straight into its ring and scans the frames in place.
+ */
+void GatewayDaemon::onPort(size_t index, uint32_t events)
+{
+    Unit& unit = *_units[index];
+    if (unit.fd < 0) return;
+
+    if (events & EPOLLIN)
+    {
+        if (unit.rx.writable() == 0)                            // Only a frame tail stays after a scan: never with a sane ring
+        {
+            unit.overflows += unit.rx.readable();
+            _counters.overflows += unit.rx.readable();
+            unit.rx.clear();
+        }
+
+        ssize_t count = read(unit.fd, unit.rx.writePointer(), unit.rx.writable());
+        if (count > 0)
+        {
+            unit.rx.commit(static_cast<size_t>(count));
+            unit.bytes += static_cast<uint64_t>(count);
+            _counters.bytes += static_cast<uint64_t>(count);
+
+            uint32_t errors = 0;
+            size_t consumed = scanFrames<MAX_REPLY_BODY>(unit.rx.readPointer(), unit.rx.readable(),
+                                                         [&](const FrameView& frame) { onFrame(index, frame); }, errors);
+            unit.rx.consume(consumed);
+            unit.framingErrors += errors;
+            _counters.framingErrors += errors;
+        }
+        else if (count == 0 || (errno != EAGAIN && errno != EINTR))
+        {
+            closePort(index, count == 0 ? "end of file" : strerror(errno));
+            return;
+        }
+    }
+
+    if (events & EPOLLOUT) flushPort(index);
+    if ((events & (EPOLLHUP | EPOLLERR)) && !(events & EPOLLIN)) closePort(index, "hang up");
+}
+
+void GatewayDaemon::onFrame(size_t index, const FrameView& frame)
+{
+    Unit& unit = *_units[index];
+    ++unit.frames;
+    ++_counters.frames;
+
+    auto pending = std::find_if(_pending.begin(), _pending.end(), [&](const Pending& p) {
+        return p.unit == index && p.sequence == frame.sequence;
+    });
+    bool matched = frame.sequence != 0 && pending != _pending.end();
+    uint32_t client = matched ? pending->client : 0;
+
+    switch (frame.type)
+    {
+        case Reply::TELEMETRY:
+        {
+            if (frame.length != sizeof(Telemetry)) return;
+            memcpy(&unit.telemetry, frame.payload, sizeof(Telemetry));
+            unit.haveTelemetry = true;
+            if (!matched || pending->request != Request::IDENTIFY) return;
+            const Telemetry& t = unit.telemetry;
+            if (client) reply(client, format("TELEMETRY %zu id=0x%08x uptime_ms=%u executed=%u marc=%u queue=%u framing_errors=%u",
+                                             index, t.unitId, t.uptimeMs, t.executed, t.marcState, t.queueDepth, t.framingErrors));
+            _pending.erase(pending);
+            return;
+        }
+
+        case Reply::ACCEPTED:
+        {
+            if (frame.length < 1) return;
+            unit.credits = frame.payload[0];
+            if (!matched || pending->request != Request::TRANSMIT || pending->accepted) return;       // Timed out: no longer counted
+            if (unit.unacked) --unit.unacked;
+            if (client) reply(client, format("ACCEPTED %zu seq=%u credits=%u", index, frame.sequence, frame.payload[0]));
+            pending->accepted = true;
+            pending->deadline = Clock::now() + std::chrono::milliseconds(_options.completeTimeoutMs);
+            return;
+        }
+
+        case Reply::REJECTED:
+        {
+            if (frame.length < 2) return;
+            if (matched && pending->request == Request::TRANSMIT && unit.unacked) --unit.unacked;
+            unit.credits = frame.payload[1];
+            if (!matched) return;
+            if (client) reply(client, format("REJECTED %zu seq=%u reason=%u credits=%u", index, frame.sequence, frame.payload[0], frame.payload[1]));
+            _pending.erase(pending);
+            return;
+        }
+
+        case Reply::COMPLETE:
+        {
+            if (frame.length < 2) return;
+            if (unit.credits < GATEWAY_QUEUE_DEPTH) ++unit.credits;                  // Its queue slot is free again
+            if (!matched || pending->request != Request::TRANSMIT) return;
+            if (client) reply(client, format("COMPLETE %zu seq=%u status=%u", index, frame.sequence, frame.payload[0]));
+            _pending.erase(pending);
+            return;
+        }
+
+        case Reply::STATS:
+        {
+            if (frame.length != sizeof(GatewayStats) || !matched) return;
+            if (pending->request != Request::GET_STATS && pending->request != Request::RESET_STATS) return;
+            GatewayStats s;
+            memcpy(&s, frame.payload, sizeof(s));
+            if (client) reply(client, format("STATS %zu received=%u executed=%u rejected=%u framing_errors=%u first_command_ms=%u last_complete_ms=%u queue_high_water=%u",
+                                             index, s.received, s.executed, s.rejected, s.framingErrors, s.firstCommandMs, s.lastCompleteMs, s.queueHighWater));
+            _pending.erase(pending);
+            return;
+        }
+
+        default:
+            return;
+    }
+}
+
+bool GatewayDaemon::sendRequest(size_t index, uint8_t type, const uint8_t* payload, uint8_t length, uint32_t client)
+{
+    Unit& unit = *_units[index];
+    if (!unit.online()) return false;
+
+    if (++unit.sequence == 0) unit.sequence = 1;
+
+    uint8_t frameLength = 2 + length;
+    uint8_t crc = crc8(crc8(crc8(0, frameLength), type), unit.sequence);
+    unit.tx.push_back(static_cast<char>(SOF));
+    unit.tx.push_back(static_cast<char>(frameLength));
+    unit.tx.push_back(static_cast<char>(type));
+    unit.tx.push_back(static_cast<char>(unit.sequence));
+    for (uint8_t i = 0; i < length; ++i)
+    {
+        unit.tx.push_back(static_cast<char>(payload[i]));
+        crc = crc8(crc, payload[i]);
+    }
+    unit.tx.push_back(static_cast<char>(crc));
+
+    if (type == Request::TRANSMIT) ++unit.unacked;
+    _pending.push_back(Pending{ client, static_cast<uint32_t>(index), unit.sequence, type, false,
+                                Clock::now() + std::chrono::milliseconds(_options.requestTimeoutMs) });
+    flushPort(index);
+    return true;
+}
+
+void GatewayDaemon::flushPort(size_t index)
+{
+    Unit& unit = *_units[index];
+    if (unit.fd < 0) return;
+
+    while (!unit.tx.empty())
+    {
+        ssize_t written = write(unit.fd, unit.tx.data(), unit.tx.size());
+        if (written > 0) { unit.tx.erase(0, static_cast<size_t>(written)); continue; }
+        if (written < 0 && (errno == EAGAIN || errno == EINTR)) break;
+        closePort(index, strerror(errno));
+        return;
+    }
+
+    bool writing = !unit.tx.empty();
+    if (writing != unit.writing)
+    {
+        unit.writing = writing;
+        watch(unit.fd, Source::Port, static_cast<uint32_t>(index), writing ? EPOLLIN | EPOLLOUT : EPOLLIN, true);
+    }
+}
+
+// ---------------------------------------------------------------------------------
+//  Clients
+// ---------------------------------------------------------------------------------
+
+void GatewayDaemon::onListen()
+{
+    while (true)
+    {
+        int fd = accept4(_listen, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;                                     // EAGAIN: all taken (or out of descriptors, retried on the next event)
+
+        uint32_t id = _nextClient++;
+        if (_nextClient == 0) _nextClient = 1;                  // 0 marks a pending request without a client
+        if (!watch(fd, Source::Client, id, EPOLLIN))
+        {
+            close(fd);
+            continue;
+        }
+        _clients[id].fd = fd;
+    }
+}
+
+void GatewayDaemon::onClient(uint32_t id, uint32_t events)
+{
+    auto it = _clients.find(id);
+    if (it == _clients.end()) return;
+
+    if (events & EPOLLIN)
+    {
+        char buffer[1024];
+        ssize_t count = read(it->second.fd, buffer, sizeof(buffer));
+        if (count == 0 || (count < 0 && errno != EAGAIN && errno != EINTR))
+        {
+            closeClient(id);
+            return;
+        }
+        if (count > 0) it->second.in.append(buffer, static_cast<size_t>(count));
+
+        size_t newline;
+        while ((newline = it->second.in.find('\n')) != std::string::npos)
+        {
+            std::string line = it->second.in.substr(0, newline);
+            it->second.in.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            command(id, line);
+        }
+        if (it->second.in.size() > MAX_LINE)
+        {
+            closeClient(id);
+            return;
+        }
+    }
+
+    if (events & EPOLLOUT) flushClient(id);
+    else if (events & (EPOLLHUP | EPOLLERR)) closeClient(id);
+}
+
+void GatewayDaemon::closeClient(uint32_t id)
+{
+    auto it = _clients.find(id);
+    if (it == _clients.end()) return;
+
+    epoll_ctl(_epoll, EPOLL_CTL_DEL, it->second.fd, nullptr);
+    close(it->second.fd);
+    _clients.erase(it);
+    for (Pending& pending : _pending) if (pending.client == id) pending.client = 0;      // Replies still keep the credits right
+}
+
+void GatewayDaemon::command(uint32_t id, const std::string& line)
+{
+    std::istringstream tokens(line);
+    std::string verb;
+    std::vector<std::string> args;
+    tokens >> verb;
+    for (std::string arg; tokens >> arg; ) args.push_back(arg);
+    if (verb.empty()) return;
+
+    if (verb == "units" && args.empty())
+    {
+        for (size_t i = 0; i < _units.size(); ++i) reply(id, unitLine(i));
+        reply(id, "END");
+        return;
+    }
+
+    if (verb == "daemon" && args.empty())
+    {
+        size_t online = std::count_if(_units.begin(), _units.end(), [](const std::unique_ptr<Unit>& unit) { return unit->online(); });
+        reply(id, format("DAEMON units=%zu online=%zu clients=%zu frames=%llu framing_errors=%llu bytes=%llu overflows=%llu timeouts=%llu",
+                         _units.size(), online, _clients.size(),
+                         static_cast<unsigned long long>(_counters.frames), static_cast<unsigned long long>(_counters.framingErrors),
+                         static_cast<unsigned long long>(_counters.bytes), static_cast<unsigned long long>(_counters.overflows),
+                         static_cast<unsigned long long>(_counters.timeouts)));
+        return;
+    }
+
+    uint8_t request = verb == "transmit" ? Request::TRANSMIT
+                    : verb == "stats"    ? Request::GET_STATS
+                    : verb == "reset"    ? Request::RESET_STATS
+                    : verb == "identify" ? Request::IDENTIFY
+                    : 0;
+    if (request == 0)
+    {
+        reply(id, "ERR unknown command");
+        return;
+    }
+    if (args.size() != (request == Request::TRANSMIT ? 3u : 1u))
+    {
+        reply(id, "ERR arguments");
+        return;
+    }
+
+    unsigned long index = 0;
+    if (!parseNumber(args[0], _units.empty() ? 0 : _units.size() - 1, index) || _units.empty())
+    {
+        reply(id, "ERR unit");
+        return;
+    }
+
+    uint8_t payload[1 + MAX_CODE_BYTES] = {};
+    uint8_t length = 0;
+    if (request == Request::TRANSMIT)
+    {
+        unsigned long family = 0;
+        std::vector<uint8_t> code;
+        if (!parseNumber(args[1], 0xFF, family) || familyBits(static_cast<uint8_t>(family)) == 0)
+        {
+            reply(id, "ERR family");
+            return;
+        }
+        if (!parseHex(args[2], code) || code.size() != (familyBits(static_cast<uint8_t>(family)) + 7u) / 8u)
+        {
+            reply(id, "ERR code");
+            return;
+        }
+        payload[0] = static_cast<uint8_t>(family);
+        memcpy(&payload[1], code.data(), code.size());
+        length = static_cast<uint8_t>(1 + code.size());
+
+        if (_units[index]->online() && _units[index]->freeCredits() == 0)
+        {
+            reply(id, "ERR busy");
+            return;
+        }
+    }
+
+    if (!sendRequest(index, request, payload, length, id)) reply(id, "ERR offline");
+}
+
+void GatewayDaemon::reply(uint32_t id, const std::string& line)
+{
+    auto it = _clients.find(id);
+    if (it == _clients.end()) return;
+    if (it->second.out.empty()) _replied.push_back(id);
+    it->second.out += line;
+    it->second.out += '\n';
+}
+
+void GatewayDaemon::flushClient(uint32_t id)
+{
+    auto it = _clients.find(id);
+    if (it == _clients.end()) return;
+    Client& client = it->second;
+
+    while (!client.out.empty())
+    {
+        ssize_t sent = send(client.fd, client.out.data(), client.out.size(), MSG_NOSIGNAL);
+        if (sent > 0) { client.out.erase(0, static_cast<size_t>(sent)); continue; }
+        if (sent < 0 && (errno == EAGAIN || errno == EINTR)) break;
+        closeClient(id);
+        return;
+    }
+    if (client.out.size() > MAX_CLIENT_OUT)
+    {
+        closeClient(id);
+        return;
+    }
+
+    bool writing = !client.out.empty();
+    if (writing != client.writing)
+    {
+        client.writing = writing;
+        watch(client.fd, Source::Client, id, writing ? EPOLLIN | EPOLLOUT : EPOLLIN, true);
+    }
+}
+
+// ---------------------------------------------------------------------------------
+//  Timers and helpers
+// ---------------------------------------------------------------------------------
+
+void GatewayDaemon::expire(Clock::time_point now)
+{
+    for (auto it = _pending.begin(); it != _pending.end(); )
+    {
+        if (it->deadline > now) { ++it; continue; }
+
+        Unit& unit = *_units[it->unit];
+        if (it->request == Request::TRANSMIT && !it->accepted && unit.unacked) --unit.unacked;     // Never acknowledged: not in flight any more
+        if (it->client) reply(it->client, format("TIMEOUT %u seq=%u", it->unit, it->sequence));
+        ++_counters.timeouts;
+        it = _pending.erase(it);
+    }
+
+    for (size_t i = 0; i < _units.size(); ++i)
+    {
+        if (!_units[i]->online() && _units[i]->retryAt <= now) openPort(i);
+    }
+}
+
+bool GatewayDaemon::watch(int fd, Source source, uint32_t id, uint32_t events, bool modify)
+{
+    epoll_event event{};
+    event.events   = events;
+    event.data.u64 = (static_cast<uint64_t>(source) << 32) | id;
+    if (epoll_ctl(_epoll, modify ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event) == 0) return true;
+    fprintf(stderr, "gateway_daemon: epoll_ctl: %s\n", strerror(errno));
+    return false;
+}
+
+std::string GatewayDaemon::unitLine(size_t index) const
+{
+    const Unit& unit = *_units[index];
+    const Telemetry& t = unit.telemetry;
+    std::string line = format("UNIT %zu %s %s", index, unit.path.c_str(), unit.online() ? "online" : "offline");
+    if (unit.haveTelemetry)
+    {
+        line += format(" id=0x%08x uptime_ms=%u executed=%u marc=%u queue=%u", t.unitId, t.uptimeMs, t.executed, t.marcState, t.queueDepth);
+    }
+    line += format(" credits=%u frames=%llu framing_errors=%u bytes=%llu", unit.freeCredits(),
+                   static_cast<unsigned long long>(unit.frames), unit.framingErrors, static_cast<unsigned long long>(unit.bytes));
+    return line;
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Gateway/GatewayProtocol.h"
+#include "Gateway/FrameParser.h"
+#include "MirrorRing.h"
+
+/**
+ * @brief Host side of a fleet of RF gateways (GATEWAY_MODE firmware) on serial ports: one process,
+ *        one epoll loop, any number of units.
+ *
+ * Each port has a MirrorRing: read() lands in the ring and GatewayProtocol::scanFrames(), the
+ * decoder the firmware tests against, reports frames as views into it. Nothing is copied per
+ * frame, and an incomplete tail simply stays in the ring for the next read. TELEMETRY keeps the
+ * latest health record of every unit; replies are routed to the client that asked.
+ *
+ * Clients talk to a unix stream socket, one text command per line, one or more lines back:
+ *
+ *   units                          UNIT <n> <path> <online|offline> id=0x.. uptime_ms= executed= marc= queue=
+ *                                       credits= frames= framing_errors= bytes=      (one per unit), then END
+ *   daemon                         DAEMON units= online= clients= frames= framing_errors= bytes= overflows= timeouts=
+ *   transmit <n> <family> <hex>    ACCEPTED <n> seq= credits=   then   COMPLETE <n> seq= status=
+ *                                  REJECTED <n> seq= reason= credits=
+ *   stats <n> / reset <n>          STATS <n> received= executed= rejected= framing_errors= first_command_ms=
+ *                                        last_complete_ms= queue_high_water=
+ *   identify <n>                   TELEMETRY <n> id=0x.. uptime_ms= executed= marc= queue= framing_errors=
+ *
+ * Failures answer "ERR <reason>"; a unit that does not answer in time gives "TIMEOUT <n> seq=",
+ * one that goes away "OFFLINE <n> seq=". Requests are not retried: a TRANSMIT may have reached
+ * the air even when its reply was lost.
+ *
+ * TRANSMIT follows the gateway's credit scheme (GatewayProtocol.h): the daemon never has more
+ * TRANSMIT frames in flight to a unit than its last credit, less the ones not acknowledged yet,
+ * plus one per COMPLETE since. Over that, the client gets "ERR busy" and the frame is not sent.
+ *
+ * A port that hangs up (unit unplugged) goes offline and is reopened every reopenMs.
+ *
+ * @example
+ *   GatewayDaemon daemon;
+ *   if (!daemon.start({ "/run/gateway.sock", { "/dev/ttyUSB0", "/dev/ttyUSB1" } })) return 1;
+ *   while (!stop) daemon.runOnce(100);
+ */
+class GatewayDaemon
+{
+    public:
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::string              socketPath;
+        std::vector<std::string> ports;
+        uint32_t                 baud        = GATEWAY_BAUD_RATE;
+        uint32_t                 requestTimeoutMs = 1000;       // ACCEPTED / STATS / TELEMETRY answer
+        uint32_t                 completeTimeoutMs = 5000;      // COMPLETE after ACCEPTED: a full queue of bursts
+        uint32_t                 reopenMs    = 1000;
+        size_t                   ringBytes   = 4096;            // Per port, rounded up to pages
+    };
+
+    /// @brief One gateway on one serial port
+    struct Unit
+    {
+        std::string path;
+        int         fd = -1;
+        MirrorRing  rx;
+        std::string tx;                                         // Frames not yet accepted by the port
+        bool        writing = false;                            // EPOLLOUT armed for tx
+        Clock::time_point retryAt{};
+
+        bool      haveTelemetry = false;
+        Telemetry telemetry{};
+
+        uint8_t  credits  = GATEWAY_QUEUE_DEPTH;                // Last credit reported (+1 per COMPLETE)
+        uint8_t  unacked  = 0;                                  // TRANSMIT frames sent, not ACCEPTED / REJECTED yet
+        uint8_t  sequence = 0;                                  // Last SEQ used; 0 is left to unsolicited frames
+
+        uint64_t bytes = 0;
+        uint64_t frames = 0;
+        uint32_t framingErrors = 0;
+        uint64_t overflows = 0;                                 // Bytes dropped with a full ring
+
+        bool online() const { return fd >= 0; }
+        uint8_t freeCredits() const { return credits > unacked ? credits - unacked : 0; }
+    };
+
+    struct Counters
+    {
+        uint64_t frames = 0;
+        uint64_t framingErrors = 0;
+        uint64_t bytes = 0;
+        uint64_t overflows = 0;
+        uint64_t timeouts = 0;
+    };
+
+    GatewayDaemon() = default;
+    ~GatewayDaemon();
+    GatewayDaemon(const GatewayDaemon&) = delete;
+    GatewayDaemon& operator=(const GatewayDaemon&) = delete;
+
+    /**
+     * @brief Binds the socket and opens every port. A port that does not open yet is retried.
+     * @return false if the socket or epoll can not be set up (message on stderr)
+     */
+    bool start(const Options& options);
+
+    /**
+     * @brief Waits up to timeoutMs for ports and clients, handles what is ready, expires requests.
+     * @return int - Events handled, -1 if epoll failed
+     */
+    int runOnce(int timeoutMs);
+
+    size_t unitCount() const { return _units.size(); }
+    const Unit& unit(size_t index) const { return *_units[index]; }
+    const Counters& counters() const { return _counters; }
+
+    private:
+
+    /// @brief A request waiting for its reply from a unit
+    struct Pending
+    {
+        uint32_t          client;                               // 0 once the client is gone
+        uint32_t          unit;
+        uint8_t           sequence;
+        uint8_t           request;                              // GatewayProtocol::Request type
+        bool              accepted;                             // TRANSMIT: ACCEPTED seen, waiting for COMPLETE
+        Clock::time_point deadline;
+    };
+
+    struct Client
+    {
+        int         fd = -1;
+        std::string in;
+        std::string out;
+        bool        writing = false;                            // EPOLLOUT armed for out
+    };
+
+    enum class Source : uint32_t { Listen = 1, Port = 2, Client = 3 };
+
+    bool openPort(size_t index);
+    void closePort(size_t index, const char* why);
+    void onPort(size_t index, uint32_t events);
+    void onFrame(size_t index, const GatewayProtocol::FrameView& frame);
+    void flushPort(size_t index);
+    bool sendRequest(size_t index, uint8_t type, const uint8_t* payload, uint8_t length, uint32_t client);
+
+    void onListen();
+    void onClient(uint32_t id, uint32_t events);
+    void closeClient(uint32_t id);
+    void command(uint32_t id, const std::string& line);
+    void reply(uint32_t id, const std::string& line);
+    void flushClient(uint32_t id);
+
+    void expire(Clock::time_point now);
+    bool watch(int fd, Source source, uint32_t id, uint32_t events, bool modify = false);
+
+    std::string unitLine(size_t index) const;
+
+    Options  _options;
+    int      _epoll  = -1;
+    int      _listen = -1;
+    std::vector<std::unique_ptr<Unit>> _units;
+    std::unordered_map<uint32_t, Client> _clients;
+    uint32_t _nextClient = 1;
+    std::vector<Pending> _pending;
+    std::vector<uint32_t> _replied;                             // Clients with output, flushed at the end of runOnce()
+    Counters _counters;
+};
@@ -0,0 +1,49 @@
+#include "MirrorRing.h"
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+MirrorRing::~MirrorRing()
+{
+    if (_base) munmap(_base, 2 * _capacity);
+}
+
+/**
+ * @brief Reserves 2 x capacity of address space, then maps one memfd over both halves.
+ */
+bool MirrorRing::allocate(size_t minCapacity)
+{
+    if (_base) return true;
+
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t capacity = (minCapacity + page - 1) / page * page;
+    if (capacity == 0) capacity = page;
+
+    int fd = memfd_create("gateway_ring", MFD_CLOEXEC);
+    if (fd < 0) return false;
+    if (ftruncate(fd, static_cast<off_t>(capacity)) < 0)
+    {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return false;
+    }
+
+    void* area = mmap(nullptr, 2 * capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    bool mapped = area != MAP_FAILED
+        && mmap(area, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+        && mmap(static_cast<uint8_t*>(area) + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+    int saved = errno;
+    close(fd);                                                  // The mappings keep the pages
+
+    if (!mapped)
+    {
+        if (area != MAP_FAILED) munmap(area, 2 * capacity);
+        errno = saved;
+        return false;
+    }
+
+    _base     = static_cast<uint8_t*>(area);
+    _capacity = capacity;
+    return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Byte ring whose free space and contents are always contiguous: the same pages are mapped
+ *        twice, back to back, so bytes that wrap past the end are also readable right after it.
+ *
+ * read() writes straight into writePointer(), and GatewayProtocol::scanFrames() parses
+ * readPointer() in place. Frames are never copied or reassembled, even when they straddle the
+ * wrap. Indices are free running like RingBuffer's: `_written - _read` is the fill level.
+ *
+ * @example
+ *   MirrorRing rx;
+ *   rx.allocate(4096);
+ *   ssize_t n = read(fd, rx.writePointer(), rx.writable());
+ *   if (n > 0) rx.commit(n);
+ *   rx.consume(GatewayProtocol::scanFrames<MAX>(rx.readPointer(), rx.readable(), onFrame, errors));
+ */
+class MirrorRing
+{
+    public:
+
+    MirrorRing() = default;
+    ~MirrorRing();
+    MirrorRing(const MirrorRing&) = delete;
+    MirrorRing& operator=(const MirrorRing&) = delete;
+
+    /// @brief Maps at least minCapacity bytes (rounded up to pages); false with errno set on failure
+    bool allocate(size_t minCapacity);
+
+    uint8_t*       writePointer()       { return _base + (_written % _capacity); }
+    const uint8_t* readPointer() const  { return _base + (_read % _capacity); }
+    size_t         writable() const     { return _capacity - readable(); }
+    size_t         readable() const     { return static_cast<size_t>(_written - _read); }
+    size_t         capacity() const     { return _capacity; }
+
+    void commit(size_t count)  { _written += count; }
+    void consume(size_t count) { _read += count; }
+    void clear()               { _read = _written; }
+
+    private:
+
+    uint8_t* _base = nullptr;                                   // 2 x _capacity of address space
+    size_t   _capacity = 0;
+    uint64_t _written = 0;
+    uint64_t _read = 0;
+};
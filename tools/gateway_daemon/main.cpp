@@ -0,0 +1,60 @@
+#include "GatewayDaemon.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+    volatile sig_atomic_t stopRequested = 0;
+
+    void onSignal(int) { stopRequested = 1; }
+
+    void usage()
+    {
+        fprintf(stderr,
+                "usage: gateway_daemon [-s socket] [-b baud] [-t timeout_ms] port...\n"
+                "  -s  unix socket of the command API (default /tmp/gateway_daemon.sock)\n"
+                "  -b  serial speed (default %lu)\n"
+                "  -t  reply timeout of a request (default 1000)\n"
+                "e.g.  gateway_daemon -s /run/gateway.sock /dev/ttyUSB*\n"
+                "      echo units | socat - UNIX-CONNECT:/run/gateway.sock\n",
+                static_cast<unsigned long>(GATEWAY_BAUD_RATE));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    GatewayDaemon::Options options;
+    options.socketPath = "/tmp/gateway_daemon.sock";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "-s") && hasValue)      options.socketPath = argv[++i];
+        else if (!strcmp(argv[i], "-b") && hasValue) options.baud = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (!strcmp(argv[i], "-t") && hasValue) options.requestTimeoutMs = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (argv[i][0] == '-')                  { usage(); return 2; }
+        else                                         options.ports.push_back(argv[i]);
+    }
+    if (options.ports.empty())
+    {
+        usage();
+        return 2;
+    }
+
+    struct sigaction action{};
+    action.sa_handler = onSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    GatewayDaemon daemon;
+    if (!daemon.start(options)) return 1;
+    fprintf(stderr, "gateway_daemon: %zu port(s), commands on %s\n", daemon.unitCount(), options.socketPath.c_str());
+
+    while (!stopRequested)
+    {
+        if (daemon.runOnce(1000) < 0) return 1;
+    }
+    return 0;
+}
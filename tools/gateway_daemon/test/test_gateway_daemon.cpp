@@ -0,0 +1,467 @@
+// Pty stand-ins for the units: the test holds each pty's master side and plays the gateway
+// firmware on it (frames built like GatewayService::sendFrame(), requests read back with
+// scanFrames()), while the daemon opens the slave side like a USB serial port.
+#include "GatewayDaemon.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace GatewayProtocol;
+
+namespace
+{
+    int failures = 0;
+
+    #define CHECK(condition) \
+        do { if (!(condition)) { ++failures; fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); } } while (0)
+
+    #define CHECK_EQUAL(expected, actual) \
+        do { auto e_ = (expected); auto a_ = (actual); if (!(e_ == a_)) { ++failures; \
+             fprintf(stderr, "  %s:%d: expected %s, got %s\n", __FILE__, __LINE__, toText(e_).c_str(), toText(a_).c_str()); } } while (0)
+
+    std::string toText(const std::string& value) { return "\"" + value + "\""; }
+    template<typename T> std::string toText(T value) { return std::to_string(value); }
+
+    /// @brief One fake unit: the master side of a pty
+    struct FakeGateway
+    {
+        int         master = -1;
+        std::string slave;
+        std::string received;                                   // Bytes the daemon sent, not parsed yet
+
+        bool open()
+        {
+            master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+            if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0) return false;
+            slave = ptsname(master);
+            return true;
+        }
+
+        void close()
+        {
+            if (master >= 0) ::close(master);
+            master = -1;
+        }
+
+        void write(const std::string& bytes)
+        {
+            size_t done = 0;
+            while (done < bytes.size())
+            {
+                ssize_t written = ::write(master, bytes.data() + done, bytes.size() - done);
+                if (written > 0) done += static_cast<size_t>(written);
+                else if (errno != EAGAIN) return;
+            }
+        }
+
+        /// @brief Frames the daemon sent so far, scanned with the shared decoder
+        std::vector<std::string> requests()
+        {
+            char buffer[512];
+            ssize_t count;
+            while ((count = ::read(master, buffer, sizeof(buffer))) > 0) received.append(buffer, static_cast<size_t>(count));
+
+            std::vector<std::string> frames;
+            uint32_t errors = 0;
+            size_t consumed = scanFrames<GATEWAY_MAX_BODY>(reinterpret_cast<const uint8_t*>(received.data()), received.size(),
+                [&](const FrameView& frame) {
+                    std::string body(1, static_cast<char>(frame.type));
+                    body += static_cast<char>(frame.sequence);
+                    body.append(reinterpret_cast<const char*>(frame.payload), frame.length);
+                    frames.push_back(body);
+                }, errors);
+            received.erase(0, consumed);
+            return frames;
+        }
+
+        ~FakeGateway() { close(); }
+    };
+
+    /// @brief A frame as GatewayService::sendFrame() puts it on the wire
+    std::string frame(uint8_t type, uint8_t sequence, const std::string& payload)
+    {
+        uint8_t length = static_cast<uint8_t>(2 + payload.size());
+        uint8_t crc = crc8(crc8(crc8(0, length), type), sequence);
+        std::string bytes{ static_cast<char>(SOF), static_cast<char>(length), static_cast<char>(type), static_cast<char>(sequence) };
+        for (char c : payload) crc = crc8(crc, static_cast<uint8_t>(c));
+        return bytes + payload + static_cast<char>(crc);
+    }
+
+    template<typename Record>
+    std::string bytesOf(const Record& record) { return std::string(reinterpret_cast<const char*>(&record), sizeof(record)); }
+
+    std::string telemetry(uint32_t unitId, uint32_t uptimeMs, uint8_t sequence = 0)
+    {
+        Telemetry t{};
+        t.unitId    = unitId;
+        t.uptimeMs  = uptimeMs;
+        t.executed  = 7;
+        t.marcState = 0x01;
+        return frame(Reply::TELEMETRY, sequence, bytesOf(t));
+    }
+
+    /// @brief Line client of the daemon's socket
+    struct Client
+    {
+        int         fd = -1;
+        std::string in;
+
+        bool connect(const std::string& path)
+        {
+            fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+            return fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        }
+
+        void send(const std::string& line) { std::string text = line + "\n"; ::send(fd, text.data(), text.size(), MSG_NOSIGNAL); }
+
+        bool line(std::string& out)
+        {
+            char buffer[4096];
+            ssize_t count;
+            while ((count = ::read(fd, buffer, sizeof(buffer))) > 0) in.append(buffer, static_cast<size_t>(count));
+            size_t newline = in.find('\n');
+            if (newline == std::string::npos) return false;
+            out = in.substr(0, newline);
+            in.erase(0, newline + 1);
+            return true;
+        }
+
+        ~Client() { if (fd >= 0) ::close(fd); }
+    };
+
+    /// @brief A started daemon on fresh ptys and a temporary socket
+    struct Bench
+    {
+        std::string socketPath;
+        std::vector<FakeGateway> units;
+        GatewayDaemon daemon;
+        Client client;
+
+        explicit Bench(size_t count, uint32_t requestTimeoutMs = 1000):
+        units(count)
+        {
+            char directory[] = "/tmp/gateway_daemon_test.XXXXXX";
+            socketPath = std::string(mkdtemp(directory)) + "/api.sock";
+
+            GatewayDaemon::Options options;
+            options.socketPath = socketPath;
+            options.requestTimeoutMs = requestTimeoutMs;
+            options.reopenMs = 60000;                           // A closed pty does not come back
+            for (FakeGateway& unit : units)
+            {
+                if (!unit.open()) { fprintf(stderr, "  posix_openpt: %s\n", strerror(errno)); ++failures; }
+                options.ports.push_back(unit.slave);
+            }
+            if (!daemon.start(options)) ++failures;
+            if (!client.connect(socketPath)) ++failures;
+            pump([] { return false; }, 20);                     // Accept the client
+        }
+
+        ~Bench()
+        {
+            unlink(socketPath.c_str());
+            rmdir(socketPath.substr(0, socketPath.rfind('/')).c_str());
+        }
+
+        /// @brief Runs the daemon until done() or timeoutMs
+        bool pump(const std::function<bool()>& done, int timeoutMs = 2000)
+        {
+            auto until = GatewayDaemon::Clock::now() + std::chrono::milliseconds(timeoutMs);
+            while (GatewayDaemon::Clock::now() < until)
+            {
+                if (done()) return true;
+                daemon.runOnce(5);
+            }
+            return done();
+        }
+
+        /// @brief Sends a command and waits for the next reply line
+        std::string ask(const std::string& command, int timeoutMs = 2000)
+        {
+            if (!command.empty()) client.send(command);
+            std::string line;
+            pump([&] { return client.line(line); }, timeoutMs);
+            return line;
+        }
+
+        /// @brief Waits for the daemon's next request frame to unit
+        std::string request(size_t unit)
+        {
+            std::vector<std::string> frames;
+            pump([&] { frames = units[unit].requests(); return !frames.empty(); });
+            return frames.empty() ? std::string() : frames.front();
+        }
+
+        bool framesSeen(size_t unit, uint64_t frames)
+        {
+            return pump([&] { return daemon.unit(unit).frames >= frames; });
+        }
+    };
+
+    // ---------------------------------------------------------------------------------
+
+    void test_telemetry_from_every_port()
+    {
+        Bench bench(3);
+        for (size_t i = 0; i < 3; ++i) bench.units[i].write(telemetry(0x1000 + i, 5000));
+        for (size_t i = 0; i < 3; ++i) CHECK(bench.framesSeen(i, 1));
+
+        for (size_t i = 0; i < 3; ++i)
+        {
+            std::string line = bench.ask(i == 0 ? "units" : "");
+            char expected[64];
+            snprintf(expected, sizeof(expected), "UNIT %zu %s online id=0x%08zx uptime_ms=5000 executed=7", i, bench.units[i].slave.c_str(), 0x1000 + i);
+            CHECK_EQUAL(std::string(expected), line.substr(0, strlen(expected)));
+        }
+        CHECK_EQUAL(std::string("END"), bench.ask(""));
+    }
+
+    // A frame written one byte per read, split across reads, and between noise and a bad CRC
+    void test_split_frames_and_noise()
+    {
+        Bench bench(1);
+        std::string first = telemetry(0xA1, 1);
+        for (char c : first)
+        {
+            bench.units[0].write(std::string(1, c));
+            bench.pump([] { return false; }, 2);
+        }
+        CHECK(bench.framesSeen(0, 1));
+
+        std::string corrupt = telemetry(0xA2, 2);
+        corrupt[6] ^= 0x01;
+        bench.units[0].write(std::string("\x00\x55\x7e\x7e", 4) + corrupt + telemetry(0xA3, 3));
+        CHECK(bench.framesSeen(0, 2));
+        CHECK_EQUAL(0xA3u, bench.daemon.unit(0).telemetry.unitId);
+        CHECK(bench.daemon.unit(0).framingErrors >= 2);             // The corrupt frame and the stray SOF in front of it
+        CHECK_EQUAL(uint64_t(0), bench.daemon.unit(0).overflows);
+    }
+
+    // Far more bytes than the ring holds, in odd chunks: frames straddle the wrap and still scan in place
+    void test_ring_wraps_without_copies()
+    {
+        Bench bench(1);
+        size_t capacity = bench.daemon.unit(0).rx.capacity();
+        std::string stream;
+        uint32_t frames = 0;
+        while (stream.size() < 10 * capacity)
+        {
+            ++frames;
+            stream += telemetry(frames, frames);
+        }
+
+        for (size_t at = 0; at < stream.size(); at += 997)
+        {
+            bench.units[0].write(stream.substr(at, 997));
+            bench.pump([] { return false; }, 1);
+        }
+        CHECK(bench.framesSeen(0, frames));
+        CHECK_EQUAL(uint64_t(frames), bench.daemon.unit(0).frames);
+        CHECK_EQUAL(frames, bench.daemon.unit(0).telemetry.unitId);
+        CHECK_EQUAL(0u, bench.daemon.unit(0).framingErrors);
+        CHECK_EQUAL(size_t(0), bench.daemon.unit(0).rx.readable());
+    }
+
+    void test_transmit_round_trip()
+    {
+        Bench bench(1);
+        bench.client.send("transmit 0 0 d8");
+        std::string request = bench.request(0);
+        CHECK_EQUAL(size_t(4), request.size());
+        if (request.size() != 4) return;
+        CHECK_EQUAL(int(Request::TRANSMIT), int(static_cast<uint8_t>(request[0])));
+        CHECK_EQUAL(0, int(request[2]));
+        CHECK_EQUAL(0xD8, int(static_cast<uint8_t>(request[3])));
+        uint8_t sequence = static_cast<uint8_t>(request[1]);
+        CHECK(sequence != 0);
+
+        bench.units[0].write(frame(Reply::ACCEPTED, sequence, std::string(1, '\x03')));
+        CHECK_EQUAL("ACCEPTED 0 seq=" + std::to_string(sequence) + " credits=3", bench.ask(""));
+        bench.units[0].write(frame(Reply::COMPLETE, sequence, std::string("\x01\x00", 2)));
+        CHECK_EQUAL("COMPLETE 0 seq=" + std::to_string(sequence) + " status=1", bench.ask(""));
+
+        bench.client.send("transmit 0 4 0a0b0c");                // EV1527, 24 bits
+        request = bench.request(0);
+        CHECK_EQUAL(std::string("\x04\x0a\x0b\x0c", 4), request.substr(2));
+        bench.units[0].write(frame(Reply::REJECTED, static_cast<uint8_t>(request[1]), std::string("\x01\x00", 2)));
+        CHECK_EQUAL("REJECTED 0 seq=" + std::to_string(static_cast<uint8_t>(request[1])) + " reason=1 credits=0", bench.ask(""));
+    }
+
+    // No more TRANSMIT in flight than the credits: "ERR busy" until a COMPLETE frees a slot
+    void test_credits_limit_transmits()
+    {
+        Bench bench(1);
+        std::vector<uint8_t> sequences;
+        for (int i = 0; i < GATEWAY_QUEUE_DEPTH; ++i)
+        {
+            bench.client.send("transmit 0 0 01");
+            bench.pump([] { return false; }, 10);
+        }
+        CHECK_EQUAL(std::string("ERR busy"), bench.ask("transmit 0 0 01"));
+
+        std::vector<std::string> frames;
+        bench.pump([&] { auto more = bench.units[0].requests(); frames.insert(frames.end(), more.begin(), more.end()); return frames.size() >= GATEWAY_QUEUE_DEPTH; });
+        CHECK_EQUAL(size_t(GATEWAY_QUEUE_DEPTH), frames.size());
+        if (frames.size() != GATEWAY_QUEUE_DEPTH) return;
+
+        for (int i = 0; i < GATEWAY_QUEUE_DEPTH; ++i)
+        {
+            bench.units[0].write(frame(Reply::ACCEPTED, static_cast<uint8_t>(frames[i][1]), std::string(1, static_cast<char>(GATEWAY_QUEUE_DEPTH - 1 - i))));
+            bench.ask("");
+        }
+        CHECK_EQUAL(0, int(bench.daemon.unit(0).freeCredits()));
+        CHECK_EQUAL(std::string("ERR busy"), bench.ask("transmit 0 0 01"));
+
+        bench.units[0].write(frame(Reply::COMPLETE, static_cast<uint8_t>(frames[0][1]), std::string("\x01\x03", 2)));
+        bench.ask("");
+        CHECK_EQUAL(1, int(bench.daemon.unit(0).freeCredits()));
+        bench.client.send("transmit 0 0 01");
+        CHECK_EQUAL(int(Request::TRANSMIT), int(static_cast<uint8_t>(bench.request(0)[0])));
+    }
+
+    void test_stats_and_identify()
+    {
+        Bench bench(1);
+        bench.client.send("stats 0");
+        std::string request = bench.request(0);
+        CHECK_EQUAL(int(Request::GET_STATS), int(static_cast<uint8_t>(request[0])));
+
+        GatewayStats stats{};
+        stats.received = 12;
+        stats.executed = 11;
+        stats.rejected = 1;
+        stats.framingErrors = 2;
+        stats.firstCommandMs = 100;
+        stats.lastCompleteMs = 2700;
+        stats.queueHighWater = 4;
+        bench.units[0].write(frame(Reply::STATS, static_cast<uint8_t>(request[1]), bytesOf(stats)));
+        CHECK_EQUAL(std::string("STATS 0 received=12 executed=11 rejected=1 framing_errors=2 first_command_ms=100 last_complete_ms=2700 queue_high_water=4"),
+                    bench.ask(""));
+
+        bench.client.send("identify 0");
+        request = bench.request(0);
+        CHECK_EQUAL(int(Request::IDENTIFY), int(static_cast<uint8_t>(request[0])));
+        bench.units[0].write(telemetry(0x0BADCAFE, 42, static_cast<uint8_t>(request[1])));
+        CHECK_EQUAL(std::string("TELEMETRY 0 id=0x0badcafe uptime_ms=42 executed=7 marc=1 queue=0 framing_errors=0"), bench.ask(""));
+    }
+
+    void test_bad_commands()
+    {
+        Bench bench(2);
+        CHECK_EQUAL(std::string("ERR unknown command"), bench.ask("fly 0"));
+        CHECK_EQUAL(std::string("ERR arguments"), bench.ask("stats"));
+        CHECK_EQUAL(std::string("ERR unit"), bench.ask("stats 2"));
+        CHECK_EQUAL(std::string("ERR unit"), bench.ask("stats -1"));
+        CHECK_EQUAL(std::string("ERR family"), bench.ask("transmit 0 9 d8"));
+        CHECK_EQUAL(std::string("ERR code"), bench.ask("transmit 0 0 d8d8"));
+        CHECK_EQUAL(std::string("ERR code"), bench.ask("transmit 0 1 zz0"));
+        CHECK(bench.units[0].requests().empty() && bench.units[1].requests().empty());
+    }
+
+    void test_unanswered_request_times_out()
+    {
+        Bench bench(1, 50);
+        bench.client.send("transmit 0 0 d8");
+        std::string request = bench.request(0);
+        CHECK_EQUAL("TIMEOUT 0 seq=" + std::to_string(static_cast<uint8_t>(request[1])), bench.ask(""));
+        CHECK_EQUAL(uint64_t(1), bench.daemon.counters().timeouts);
+        CHECK_EQUAL(int(GATEWAY_QUEUE_DEPTH), int(bench.daemon.unit(0).freeCredits()));      // Not in flight any more
+
+        // A late ACCEPTED no longer counts
+        bench.units[0].write(frame(Reply::ACCEPTED, static_cast<uint8_t>(request[1]), std::string(1, '\x03')));
+        CHECK(bench.framesSeen(0, 1));
+        CHECK_EQUAL(3, int(bench.daemon.unit(0).freeCredits()));
+    }
+
+    // An unplugged unit: its pending request ends OFFLINE, the others carry on
+    void test_hang_up_takes_unit_offline()
+    {
+        Bench bench(2);
+        bench.client.send("identify 0");
+        bench.request(0);
+        bench.units[0].close();
+        CHECK(bench.ask("").rfind("OFFLINE 0 seq=", 0) == 0);
+        CHECK(!bench.daemon.unit(0).online());
+        CHECK_EQUAL(std::string("ERR offline"), bench.ask("stats 0"));
+
+        bench.units[1].write(telemetry(0x22, 1));
+        CHECK(bench.framesSeen(1, 1));
+        std::string line = bench.ask("daemon");
+        CHECK(line.rfind("DAEMON units=2 online=1 clients=1 frames=1 ", 0) == 0);
+    }
+
+    // Hundreds of units on one loop
+    void test_many_units()
+    {
+        constexpr size_t UNITS = 256;
+        rlimit files{};
+        getrlimit(RLIMIT_NOFILE, &files);
+        if (files.rlim_cur < 2 * UNITS + 32)
+        {
+            files.rlim_cur = std::min<rlim_t>(files.rlim_max, 2 * UNITS + 32);
+            setrlimit(RLIMIT_NOFILE, &files);
+        }
+
+        Bench bench(UNITS);
+        for (size_t round = 0; round < 4; ++round)
+        {
+            for (size_t i = 0; i < UNITS; ++i) bench.units[i].write(telemetry(static_cast<uint32_t>(i), static_cast<uint32_t>(round)));
+        }
+        CHECK(bench.pump([&] { return bench.daemon.counters().frames >= 4 * UNITS; }, 5000));
+        CHECK_EQUAL(uint64_t(4 * UNITS), bench.daemon.counters().frames);
+        CHECK_EQUAL(uint64_t(0), bench.daemon.counters().framingErrors);
+        for (size_t i = 0; i < UNITS; ++i) CHECK_EQUAL(uint32_t(i), bench.daemon.unit(i).telemetry.unitId);
+
+        std::string line = bench.ask("units");
+        size_t lines = 1;
+        while (line != "END" && !line.empty()) { line = bench.ask(""); ++lines; }
+        CHECK_EQUAL(UNITS + 1, lines);
+    }
+
+    struct Test
+    {
+        const char* name;
+        void (*run)();
+    };
+}
+
+int main()
+{
+    const Test tests[] =
+    {
+        { "telemetry_from_every_port",    test_telemetry_from_every_port },
+        { "split_frames_and_noise",       test_split_frames_and_noise },
+        { "ring_wraps_without_copies",    test_ring_wraps_without_copies },
+        { "transmit_round_trip",          test_transmit_round_trip },
+        { "credits_limit_transmits",      test_credits_limit_transmits },
+        { "stats_and_identify",           test_stats_and_identify },
+        { "bad_commands",                 test_bad_commands },
+        { "unanswered_request_times_out", test_unanswered_request_times_out },
+        { "hang_up_takes_unit_offline",   test_hang_up_takes_unit_offline },
+        { "many_units",                   test_many_units },
+    };
+
+    int failed = 0;
+    for (const Test& test : tests)
+    {
+        int before = failures;
+        test.run();
+        bool passed = failures == before;
+        if (!passed) ++failed;
+        printf("%s %s\n", passed ? "PASS" : "FAIL", test.name);
+    }
+    printf("%zu tests, %d failed\n", sizeof(tests) / sizeof(tests[0]), failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+// A gateway unit on the host: the GATEWAY_MODE firmware (src/main.cpp) on hal/host with the CC1101
+// model on its SPI bus and its UART on a pty (PtyLink). Prints "PTY <slave path>" on stdout once
+// setup() is done; gateway_load, the fleet daemon or a terminal then open that path like the
+// unit's USB serial port. Runs until SIGINT / SIGTERM and reports the RX overruns on stderr.
+//
+//   gateway_unit [-x speed]
+//
+//   -x  board time per wall time (default 1: real time; 20 streams a 235 ms burst in ~12 ms)
+#include "CC1101Model.h"
+#include "PtyLink.h"
+#include <Arduino.h>
+#include <HostBoard.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "Config/Constants.h"
+
+void setup();
+void loop();
+
+namespace
+{
+    constexpr uint32_t LOOP_PASS_US = 20;                       // A loop() pass on the board (hal/host only charges clock, pin and UART reads)
+
+    volatile sig_atomic_t stopping = 0;
+
+    void stop(int)
+    {
+        stopping = 1;
+    }
+
+    void usage()
+    {
+        fprintf(stderr, "usage: gateway_unit [-x speed]\n");
+        exit(2);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    double speed = 1.0;
+
+    int option;
+    while ((option = getopt(argc, argv, "x:")) != -1)
+    {
+        switch (option)
+        {
+            case 'x': speed = strtod(optarg, nullptr); break;
+            default:  usage();
+        }
+    }
+    if (speed <= 0.0) usage();
+
+    struct sigaction action{};
+    action.sa_handler = stop;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    CC1101Model radio;
+    hal::reset();
+    hal::attachSpiDevice(CSN_PIN, &radio);
+
+    PtyLink link(GATEWAY_BAUD_RATE, speed);
+    if (!link.open())
+    {
+        perror("gateway_unit: pty");
+        return 1;
+    }
+    setup();
+    printf("PTY %s\n", link.slavePath().c_str());
+    fflush(stdout);
+
+    while (!stopping)
+    {
+        loop();
+        hal::advanceUs(LOOP_PASS_US);
+    }
+    fprintf(stderr, "gateway_unit: %llu RX overruns\n", static_cast<unsigned long long>(link.overruns()));
+    return 0;
+}
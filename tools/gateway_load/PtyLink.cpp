@@ -0,0 +1,98 @@
+#include "PtyLink.h"
+#include <HostBoard.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include <thread>
+#include "Gateway/GatewayProtocol.h"
+
+namespace
+{
+    constexpr uint64_t PACE_SLACK_US = 1000;                    // Ahead of the wall clock by less: no sleep
+}
+
+PtyLink::PtyLink(uint32_t baud, double speed):
+_master(-1),
+_slave(-1),
+_byteUs(10UL * 1000000UL / baud),
+_speed(speed),
+_lastArrivalUs(0),
+_overruns(0)
+{}
+
+PtyLink::~PtyLink()
+{
+    hal::setSerialSource(nullptr);
+    hal::setSerialOutput(nullptr);
+    if (_slave >= 0) close(_slave);
+    if (_master >= 0) close(_master);
+}
+
+bool PtyLink::open()
+{
+    _master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (_master < 0 || grantpt(_master) < 0 || unlockpt(_master) < 0) return false;
+    _slavePath = ptsname(_master);
+
+    _slave = ::open(_slavePath.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC);
+    termios tty{};
+    if (_slave < 0 || tcgetattr(_slave, &tty) < 0) return false;
+    cfmakeraw(&tty);
+    if (tcsetattr(_slave, TCSANOW, &tty) < 0) return false;
+
+    _start = std::chrono::steady_clock::now();
+    hal::setSerialSource([this]() { receive(); });
+    hal::setSerialOutput([this](uint8_t byte) { send(byte); });
+    return true;
+}
+
+void PtyLink::pace()
+{
+    double wallUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - _start).count();
+    double aheadUs = static_cast<double>(hal::nowUs()) - wallUs * _speed;
+    if (aheadUs > PACE_SLACK_US) std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(aheadUs / _speed)));
+}
+
+void PtyLink::receive()
+{
+    pace();
+    flush();
+
+    uint64_t nowUs = hal::nowUs();
+    uint8_t buffer[256];
+    ssize_t count;
+    while ((count = read(_master, buffer, sizeof(buffer))) > 0)
+    {
+        for (ssize_t i = 0; i < count; ++i)
+        {
+            _lastArrivalUs = (_lastArrivalUs + _byteUs > nowUs) ? _lastArrivalUs + _byteUs : nowUs;
+            _arriving.push_back({ _lastArrivalUs, buffer[i] });
+        }
+    }
+
+    while (!_arriving.empty() && _arriving.front().atUs <= nowUs)
+    {
+        if (hal::serialBuffered() < GatewayProtocol::RX_BUFFER_BYTES) hal::serialInput(reinterpret_cast<const char*>(&_arriving.front().byte), 1);
+        else                                                         ++_overruns;
+        _arriving.pop_front();
+    }
+}
+
+void PtyLink::send(uint8_t byte)
+{
+    if (_out.empty()) pace();                                   // A reply leaves when the unit sends it
+    _out.push_back(static_cast<char>(byte));
+    flush();
+}
+
+void PtyLink::flush()
+{
+    while (!_out.empty())
+    {
+        ssize_t written = write(_master, _out.data(), _out.size());
+        if (written <= 0) return;                               // Full (EAGAIN): the rest goes at the next poll
+        _out.erase(0, static_cast<size_t>(written));
+    }
+}
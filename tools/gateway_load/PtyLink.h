@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <deque>
+#include <string>
+
+/**
+ * @brief The virtual board's UART on a pty, for host programs that open the slave side like a
+ *        gateway's USB serial port.
+ *
+ * What the host writes reaches the firmware at the line rate (10 bits per byte at the baud rate)
+ * into the core's RX ring: bytes that arrive with the ring full are lost, as on the chip, and
+ * counted as overruns. What the firmware prints goes out at once. The board's virtual clock is
+ * held to the wall clock times `speed` (a 235 ms burst takes 235 ms / speed), so the host sees
+ * replies when the unit would send them and its own latency counts.
+ *
+ * The slave side is kept open and raw: no echo of the unit's frames back into its RX, and no
+ * hang-up between two host programs.
+ */
+class PtyLink
+{
+    public:
+
+    PtyLink(uint32_t baud, double speed);
+    ~PtyLink();
+
+    PtyLink(const PtyLink&) = delete;
+    PtyLink& operator=(const PtyLink&) = delete;
+
+    /// @brief Opens the pty and attaches it to the calling thread's board (hal::setSerialSource / setSerialOutput)
+    bool open();
+
+    const std::string& slavePath() const { return _slavePath; }
+    uint64_t overruns() const { return _overruns; }
+
+    /// @brief Waits until the board's clock is due on the wall clock
+    void pace();
+
+    private:
+
+    struct Arrival
+    {
+        uint64_t atUs;
+        uint8_t  byte;
+    };
+
+    void receive();                                             // hal serial source
+    void send(uint8_t byte);                                    // hal serial output
+    void flush();
+
+    int         _master;
+    int         _slave;
+    std::string _slavePath;
+    uint32_t    _byteUs;
+    double      _speed;
+    std::chrono::steady_clock::time_point _start;
+
+    std::deque<Arrival> _arriving;
+    uint64_t    _lastArrivalUs;
+    uint64_t    _overruns;
+    std::string _out;                                           // Not taken by the pty yet
+};
@@ -0,0 +1,246 @@
+// Load generator for one gateway unit: streams TRANSMIT frames under the GatewayProtocol credit
+// flow (never more frames in flight than the last credit, like the fleet daemon), then reads the
+// unit's GatewayStats and reports host and unit commands/s and the queue depth the unit saw.
+//
+//   gateway_load [-n commands] [-f family] [-w window] [-t timeout_ms] [-F] port
+//
+//   -n  TRANSMIT frames to send (default 100)
+//   -f  family id, GatewayProtocol::Family (default 0: SC41344 8 digits)
+//   -w  frames in flight at most, below the credit (default GATEWAY_QUEUE_DEPTH; 1 = lock-step)
+//   -t  a reply later than this ends the run, its frames counted lost (default 2000 ms)
+//   -F  flood: ignore the credits, send everything at once (what the credits prevent)
+//
+// Prints, exit status 1 when a frame was lost or the unit did not answer:
+//   LOAD sent=.. accepted=.. rejected=.. complete=.. lost=.. wall_s=.. cmd_per_s=..
+//   DEPTH 0=.. 1=.. ..          queue depth left at each COMPLETE
+//   STATS received=.. executed=.. rejected=.. framing_errors=.. high_water=.. unit_cmd_per_s=..
+#include "SerialPort.h"
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include "Gateway/FrameParser.h"
+
+using namespace GatewayProtocol;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    void usage()
+    {
+        fprintf(stderr, "usage: gateway_load [-n commands] [-f family] [-w window] [-t timeout_ms] [-F] port\n");
+        exit(2);
+    }
+
+    /// @brief The unit's side of the run: frames out, replies in, the credit bookkeeping
+    class Load
+    {
+        public:
+
+        explicit Load(int port) : _port(port) {}
+
+        bool send(uint8_t type, uint8_t sequence, const uint8_t* payload, uint8_t length)
+        {
+            uint8_t frame[FRAME_OVERHEAD + MAX_REPLY_BODY];
+            uint8_t frameLength = 2 + length;
+            frame[0] = SOF;
+            frame[1] = frameLength;
+            frame[2] = type;
+            frame[3] = sequence;
+            memcpy(&frame[4], payload, length);
+            uint8_t crc = 0;
+            for (uint8_t i = 1; i < 4 + length; ++i) crc = crc8(crc, frame[i]);
+            frame[4 + length] = crc;
+
+            size_t done = 0, total = 5u + length;
+            while (done < total)
+            {
+                ssize_t written = write(_port, frame + done, total - done);
+                if (written > 0)            done += static_cast<size_t>(written);
+                else if (errno == EAGAIN)   { pollfd out{ _port, POLLOUT, 0 }; ::poll(&out, 1, 100); }
+                else                        return false;
+            }
+            if (type == Request::TRANSMIT) { ++sent; ++unacked; }
+            return true;
+        }
+
+        /// @brief Waits up to timeoutMs for bytes and handles every complete reply
+        void receive(int timeoutMs)
+        {
+            pollfd in{ _port, POLLIN, 0 };
+            if (::poll(&in, 1, timeoutMs) <= 0) return;
+
+            char buffer[512];
+            ssize_t count;
+            while ((count = read(_port, buffer, sizeof(buffer))) > 0) _received.append(buffer, static_cast<size_t>(count));
+
+            size_t consumed = scanFrames<MAX_REPLY_BODY>(reinterpret_cast<const uint8_t*>(_received.data()), _received.size(),
+                [&](const FrameView& frame) { handle(frame); }, framingErrors);
+            _received.erase(0, consumed);
+        }
+
+        /// @brief Frames the credits let go now
+        uint8_t freeCredits() const { return credits > unacked ? credits - unacked : 0; }
+        uint32_t inFlight() const   { return sent - complete - rejected; }
+
+        uint32_t sent = 0, accepted = 0, rejected = 0, complete = 0;
+        uint32_t depth[GATEWAY_QUEUE_DEPTH + 1] = {};
+        uint32_t framingErrors = 0;
+        uint8_t  credits = GATEWAY_QUEUE_DEPTH;
+        uint8_t  unacked = 0;
+        bool         haveStats = false;
+        GatewayStats stats{};
+
+        private:
+
+        void handle(const FrameView& frame)
+        {
+            switch (frame.type)
+            {
+                case Reply::ACCEPTED:
+                    if (frame.length < 1) return;
+                    ++accepted;
+                    credits = frame.payload[0];
+                    if (unacked) --unacked;
+                    break;
+
+                case Reply::REJECTED:
+                    if (frame.length < 2) return;
+                    ++rejected;
+                    credits = frame.payload[1];
+                    if (unacked) --unacked;
+                    break;
+
+                case Reply::COMPLETE:
+                    if (frame.length < 2) return;
+                    ++complete;
+                    if (frame.payload[1] <= GATEWAY_QUEUE_DEPTH) ++depth[frame.payload[1]];
+                    if (credits < GATEWAY_QUEUE_DEPTH) ++credits;                   // Its queue slot is free again
+                    break;
+
+                case Reply::STATS:
+                    if (frame.length != sizeof(GatewayStats)) return;
+                    memcpy(&stats, frame.payload, sizeof(GatewayStats));
+                    haveStats = true;
+                    break;
+
+                default:                                                            // TELEMETRY
+                    break;
+            }
+        }
+
+        int         _port;
+        std::string _received;
+    };
+
+    constexpr unsigned STATS_ATTEMPTS = 3;
+
+    /**
+     * @brief Sends a stats request and waits for the STATS reply. Asked again on a timeout: after
+     *        an RX overrun the unit's parser may still be inside a broken frame and take the first
+     *        request as its body.
+     */
+    bool requestStats(Load& load, uint8_t request, int timeoutMs)
+    {
+        load.haveStats = false;
+        for (unsigned attempt = 0; attempt < STATS_ATTEMPTS && !load.haveStats; ++attempt)
+        {
+            if (!load.send(request, 0, nullptr, 0)) return false;
+            Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+            while (!load.haveStats && Clock::now() < deadline) load.receive(10);
+        }
+        return load.haveStats;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t commands  = 100;
+    uint8_t  family    = static_cast<uint8_t>(Family::SC41344_8);
+    uint32_t window    = GATEWAY_QUEUE_DEPTH;
+    int      timeoutMs = 2000;
+    bool     flood     = false;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:f:w:t:F")) != -1)
+    {
+        switch (option)
+        {
+            case 'n': commands  = static_cast<uint32_t>(strtoul(optarg, nullptr, 0)); break;
+            case 'f': family    = static_cast<uint8_t>(strtoul(optarg, nullptr, 0)); break;
+            case 'w': window    = static_cast<uint32_t>(strtoul(optarg, nullptr, 0)); break;
+            case 't': timeoutMs = atoi(optarg); break;
+            case 'F': flood     = true; break;
+            default:  usage();
+        }
+    }
+    if (optind + 1 != argc || familyBits(family) == 0 || window == 0 || timeoutMs <= 0) usage();
+
+    int port = openSerialPort(argv[optind], GATEWAY_BAUD_RATE);
+    if (port < 0)
+    {
+        fprintf(stderr, "gateway_load: %s: %s\n", argv[optind], strerror(errno));
+        return 1;
+    }
+
+    Load load(port);
+    if (!requestStats(load, Request::RESET_STATS, timeoutMs))
+    {
+        fprintf(stderr, "gateway_load: no STATS reply to RESET_STATS\n");
+        return 1;
+    }
+
+    const uint8_t codeBytes = (familyBits(family) + 7) / 8;
+    Clock::time_point start = Clock::now();
+    Clock::time_point progress = start;                                         // Last TRANSMIT reply (TELEMETRY keeps coming regardless)
+    uint32_t replies = 0;
+    bool timedOut = false;
+    while (load.complete + load.rejected < commands)
+    {
+        while (load.sent < commands && (flood || (load.freeCredits() > 0 && load.inFlight() < window)))
+        {
+            uint8_t payload[1 + MAX_CODE_BYTES] = { family };
+            for (uint8_t i = 0; i < codeBytes; ++i) payload[1 + i] = static_cast<uint8_t>(load.sent >> (8 * i));   // A different code per command
+            uint8_t sequence = static_cast<uint8_t>(1 + load.sent % 255);                                       // SEQ 0 is the unit's own
+            if (!load.send(Request::TRANSMIT, sequence, payload, 1 + codeBytes)) break;
+        }
+        load.receive(timeoutMs);
+        if (load.accepted + load.rejected + load.complete != replies)
+        {
+            replies  = load.accepted + load.rejected + load.complete;
+            progress = Clock::now();
+        }
+        else if (Clock::now() - progress >= std::chrono::milliseconds(timeoutMs))
+        {
+            timedOut = true;
+            break;
+        }
+    }
+    double wallS = std::chrono::duration<double>(Clock::now() - start).count();
+
+    uint32_t lost = load.sent - load.complete - load.rejected;
+    printf("LOAD sent=%u accepted=%u rejected=%u complete=%u lost=%u wall_s=%.3f cmd_per_s=%.2f\n",
+           load.sent, load.accepted, load.rejected, load.complete, lost, wallS, wallS > 0 ? load.complete / wallS : 0.0);
+    printf("DEPTH");
+    for (uint32_t level = 0; level <= GATEWAY_QUEUE_DEPTH; ++level) printf(" %u=%u", level, load.depth[level]);
+    printf("\n");
+
+    if (!requestStats(load, Request::GET_STATS, timeoutMs))
+    {
+        fprintf(stderr, "gateway_load: no STATS reply to GET_STATS\n");
+        return 1;
+    }
+    const GatewayStats& stats = load.stats;
+    uint32_t unitMs = stats.lastCompleteMs - stats.firstCommandMs;
+    printf("STATS received=%u executed=%u rejected=%u framing_errors=%u high_water=%u unit_cmd_per_s=%.2f\n",
+           stats.received, stats.executed, stats.rejected, stats.framingErrors, stats.queueHighWater,
+           unitMs ? stats.executed * 1000.0 / unitMs : 0.0);
+    fflush(stdout);
+    close(port);
+    return (timedOut || lost) ? 1 : 0;
+}
@@ -0,0 +1,206 @@
+// gateway_load against gateway_unit (the GATEWAY_MODE firmware on hal/host, its UART on a pty),
+// both run as the programs they are. One unit serves every test: each run starts with
+// RESET_STATS. The unit runs 20 times faster than real time; its own counters (GatewayStats) are
+// in board time, so the unit's commands/s must be one burst per command, the TX session kept
+// open by the credits.
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <string>
+#include "Config/CodeFamilies.h"
+#include "Gateway/GatewayProtocol.h"
+
+extern char** environ;
+
+namespace
+{
+    int failures = 0;
+    std::string unitTool;
+    std::string loadTool;
+    std::string port;
+
+    #define CHECK(condition) \
+        do { if (!(condition)) { ++failures; fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); } } while (0)
+
+    #define CHECK_EQUAL(expected, actual) \
+        do { auto e_ = (expected); auto a_ = (actual); if (!(e_ == a_)) { ++failures; \
+             fprintf(stderr, "  %s:%d: expected %s, got %s\n", __FILE__, __LINE__, toText(e_).c_str(), toText(a_).c_str()); } } while (0)
+
+    template<typename T> std::string toText(T value) { return std::to_string(value); }
+
+    /// @brief One gateway_load run: its exit status and what it printed
+    struct Run
+    {
+        int         status = -1;
+        std::string output;
+
+        /// @brief The number after "key=" in the output, -1 if missing
+        double value(const char* key) const
+        {
+            std::string field = std::string(" ") + key + "=";
+            size_t at = output.find(field);
+            return at == std::string::npos ? -1.0 : strtod(output.c_str() + at + field.size(), nullptr);
+        }
+    };
+
+    Run load(const std::string& options)
+    {
+        Run run;
+        std::string command = loadTool + " " + options + " " + port;
+        FILE* pipe = popen(command.c_str(), "r");
+        if (!pipe) return run;
+        char buffer[1024];
+        size_t length;
+        while ((length = fread(buffer, 1, sizeof(buffer), pipe)) > 0) run.output.append(buffer, length);
+        int status = pclose(pipe);
+        run.status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        return run;
+    }
+
+    /// @brief Starts gateway_unit and reads the pty it prints
+    pid_t startUnit()
+    {
+        int pipeFds[2];
+        if (pipe(pipeFds) != 0) return -1;
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, pipeFds[1], STDOUT_FILENO);
+        posix_spawn_file_actions_addclose(&actions, pipeFds[0]);
+        posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+        char* arguments[] = { &unitTool[0], const_cast<char*>("-x"), const_cast<char*>("20"), nullptr };
+        pid_t unit;
+        int spawned = posix_spawn(&unit, unitTool.c_str(), &actions, nullptr, arguments, environ);
+        posix_spawn_file_actions_destroy(&actions);
+        close(pipeFds[1]);
+        if (spawned != 0) { close(pipeFds[0]); return -1; }
+
+        FILE* output = fdopen(pipeFds[0], "r");
+        char line[256] = {};
+        if (fgets(line, sizeof(line), output) && strncmp(line, "PTY ", 4) == 0)
+        {
+            port = line + 4;
+            port.erase(port.find_last_not_of("\n") + 1);
+        }
+        fclose(output);
+        return unit;
+    }
+
+    /// @brief Commands/s of back-to-back bursts of a family
+    template<typename Family>
+    double burstRate()
+    {
+        return 1e6 / CodeFamilies::burstDurationUs<Family>();
+    }
+
+    bool near(double expected, double actual, double tolerance)
+    {
+        if (actual >= expected * (1.0 - tolerance) && actual <= expected * (1.0 + tolerance)) return true;
+        fprintf(stderr, "  expected %.3f +- %.0f%%, got %.3f\n", expected, tolerance * 100, actual);
+        return false;
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Tests
+    // ---------------------------------------------------------------------------------
+
+    // Under the credits nothing is refused or lost, and the queue refills while a frame is on air
+    void test_credit_flow_keeps_the_radio_busy()
+    {
+        Run run = load("-n 24 -f 0");
+        CHECK_EQUAL(0, run.status);
+        CHECK_EQUAL(24.0, run.value("complete"));
+        CHECK_EQUAL(0.0, run.value("rejected"));
+        CHECK_EQUAL(0.0, run.value("lost"));
+        CHECK_EQUAL(24.0, run.value("executed"));
+        CHECK_EQUAL(0.0, run.value("framing_errors"));
+        CHECK(run.value("high_water") >= 2 && run.value("high_water") <= GATEWAY_QUEUE_DEPTH);
+        CHECK(run.value("1") + run.value("2") + run.value("3") >= 20);   // Completed with the next frames queued
+        CHECK(near(burstRate<CodeFamilies::SC41344_8Bit>(), run.value("unit_cmd_per_s"), 0.02));
+    }
+
+    void test_ev1527_rate_is_its_burst()
+    {
+        Run run = load("-n 12 -f 4");
+        CHECK_EQUAL(0, run.status);
+        CHECK_EQUAL(12.0, run.value("executed"));
+        CHECK(near(burstRate<CodeFamilies::EV1527>(), run.value("unit_cmd_per_s"), 0.02));
+    }
+
+    // One frame in flight: the queue never holds two, every COMPLETE leaves it empty
+    void test_lock_step_window()
+    {
+        Run run = load("-n 8 -w 1");
+        CHECK_EQUAL(0, run.status);
+        CHECK_EQUAL(8.0, run.value("received"));                       // The stats of the runs before were reset
+        CHECK_EQUAL(1.0, run.value("high_water"));
+        CHECK_EQUAL(8.0, run.value("0"));
+    }
+
+    // Without the credits the unit's RX buffer overruns while it streams: frames refused and lost
+    void test_flood_overruns_the_unit()
+    {
+        Run run = load("-n 20 -F -t 500");
+        CHECK_EQUAL(1, run.status);
+        CHECK(run.value("lost") > 0);
+        CHECK(run.value("rejected") > 0);
+        CHECK_EQUAL(double(GATEWAY_QUEUE_DEPTH), run.value("high_water"));
+
+        Run after = load("-n 4");                                      // The unit recovers for the next run
+        CHECK_EQUAL(0, after.status);
+        CHECK_EQUAL(4.0, after.value("executed"));
+    }
+
+    struct Test
+    {
+        const char* name;
+        void (*run)();
+    };
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: test_gateway_load gateway_unit gateway_load\n");
+        return 2;
+    }
+    unitTool = argv[1];
+    loadTool = argv[2];
+
+    pid_t unit = startUnit();
+    if (unit < 0 || port.empty())
+    {
+        fprintf(stderr, "gateway_unit did not start\n");
+        if (unit > 0) kill(unit, SIGTERM);
+        return 1;
+    }
+
+    const Test tests[] =
+    {
+        { "credit_flow_keeps_the_radio_busy", test_credit_flow_keeps_the_radio_busy },
+        { "ev1527_rate_is_its_burst",         test_ev1527_rate_is_its_burst },
+        { "lock_step_window",                 test_lock_step_window },
+        { "flood_overruns_the_unit",          test_flood_overruns_the_unit },
+    };
+
+    int failed = 0;
+    for (const Test& test : tests)
+    {
+        int before = failures;
+        test.run();
+        bool passed = failures == before;
+        if (!passed) ++failed;
+        printf("%s %s\n", passed ? "PASS" : "FAIL", test.name);
+    }
+    printf("%zu tests, %d failed\n", sizeof(tests) / sizeof(tests[0]), failed);
+
+    kill(unit, SIGTERM);
+    waitpid(unit, nullptr, 0);
+    return failed ? 1 : 0;
+}
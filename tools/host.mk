@@ -0,0 +1,43 @@
+# Shared rules of the host tools that link firmware sources on hal/host (one virtual board per thread).
+#
+# A tool's Makefile sets FIRMWARE (paths under src/), TOOL_SOURCES (its own .cpp), COMMON (models
+# shared by several tools, under tools/common), TARGETS and the firmware build flags in
+# FIRMWARE_FLAGS, then includes this file. BUILD may be set first to build a second firmware
+# flavour into its own directory.
+
+ROOT     := ../..
+CXX      ?= g++
+CXXFLAGS ?= -std=gnu++17 -O2 -g -Wall -Wextra
+CPPFLAGS += -I. -I$(ROOT)/tools/common -I$(ROOT)/hal/host/include -I$(ROOT)/include -I$(ROOT)/lib/avr_algorithms $(FIRMWARE_FLAGS)
+LDLIBS   += -pthread
+
+BUILD    ?= build
+
+.DEFAULT_GOAL := all
+
+FIRMWARE_OBJECTS := $(FIRMWARE:%.cpp=$(BUILD)/firmware/%.o) $(BUILD)/hal/Hal.o
+TOOL_OBJECTS     := $(TOOL_SOURCES:%.cpp=$(BUILD)/%.o)
+COMMON_OBJECTS   := $(COMMON:%.cpp=$(BUILD)/common/%.o)
+
+$(BUILD)/firmware/%.o: $(ROOT)/src/%.cpp
+	@mkdir -p $(dir $@)
+	$(CXX) $(CPPFLAGS) $(CXXFLAGS) -MMD -MP -c -o $@ $<
+
+$(BUILD)/hal/Hal.o: $(ROOT)/hal/host/Hal.cpp
+	@mkdir -p $(dir $@)
+	$(CXX) $(CPPFLAGS) $(CXXFLAGS) -MMD -MP -c -o $@ $<
+
+$(BUILD)/common/%.o: $(ROOT)/tools/common/%.cpp
+	@mkdir -p $(dir $@)
+	$(CXX) $(CPPFLAGS) $(CXXFLAGS) -MMD -MP -c -o $@ $<
+
+$(BUILD)/%.o: %.cpp
+	@mkdir -p $(dir $@)
+	$(CXX) $(CPPFLAGS) $(CXXFLAGS) -MMD -MP -c -o $@ $<
+
+clean:
+	rm -rf $(BUILD)
+
+.PHONY: all test clean
+
+-include $(shell find $(BUILD) -name '*.d' 2>/dev/null)
@@ -0,0 +1,271 @@
+// The Transceiver operations of Debugging/SpiBudget against the CC1101 model, on the host board's
+// virtual clock: each operation must stay within its budget, the model must see the bytes SpiTrace
+// counted, and the model's transaction log must match test/expected/<operation>.log (a line diff is
+// printed when it does not; `make golden` rewrites the files after an intended change).
+#include "CC1101Model.h"
+#include <Arduino.h>
+#include <HostBoard.h>
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Config/Constants.h"
+#include "Config/DigitalPin.h"
+#include "Config/TransceiverConfig.h"
+#include "SPI/SPIBus.h"
+#include "SPI/SpiTrace.h"
+#include "Transciever/CC1101_Transceiver.h"
+#include "Encoder/SC41344_Encoder.h"
+#include "Delay/Timebase.h"
+#include "App/RemoteCodes.h"
+#include "Debugging/SpiBudget.h"
+
+namespace
+{
+    int failures = 0;
+    std::string expectedDir;
+    bool update = false;
+
+    #define CHECK(condition) \
+        do { if (!(condition)) { ++failures; fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); } } while (0)
+
+    #define CHECK_EQUAL(expected, actual) \
+        do { auto e_ = (expected); auto a_ = (actual); if (!(e_ == a_)) { ++failures; \
+             fprintf(stderr, "  %s:%d: expected %s, got %s\n", __FILE__, __LINE__, toText(e_).c_str(), toText(a_).c_str()); } } while (0)
+
+    template<typename T> std::string toText(T value) { return std::to_string(value); }
+
+    std::string toText(const SpiTraffic& traffic)
+    {
+        return "tx=" + std::to_string(traffic.transactions) + " bytes=" + std::to_string(traffic.bytes) +
+               " csn=" + std::to_string(traffic.csnCycles);
+    }
+
+    /// @brief The radio the firmware drives (CC1101 on CSN_PIN, the burst on GDO0), on a fresh board
+    struct Bench
+    {
+        CC1101Model       model;
+        SPIBus            spiBus{ CSN_PIN };
+        TransceiverConfig config{ FREQ_315MHZ_BAND, ModulationScheme::OOK, OutputPowerLevels::HIGH_POWER };
+        Transceiver       transceiver{ spiBus, config };
+        DigitalPin        gdo0Pin{ 'B', static_cast<uint8_t>(GDO0_PORT_BIT) };
+        SC41344_Encoder   encoder{ gdo0Pin };
+
+        static Bench& fresh()
+        {
+            static std::unique_ptr<Bench> bench;
+            bench.reset();
+            hal::reset();
+            hal::setSerialOutput([](uint8_t) {});
+            bench.reset(new Bench);
+            hal::attachSpiDevice(CSN_PIN, &bench->model);
+            Timebase::begin();
+            sei();
+            return *bench;
+        }
+    };
+
+    std::vector<std::string> readLines(const std::string& path)
+    {
+        std::vector<std::string> lines;
+        std::ifstream file(path);
+        for (std::string line; std::getline(file, line); ) lines.push_back(line);
+        return lines;
+    }
+
+    /// @brief Line diff (longest common subsequence): "-" expected only, "+" actual only, 2 lines of context
+    void printDiff(const std::vector<std::string>& expected, const std::vector<std::string>& actual)
+    {
+        size_t n = expected.size(), m = actual.size();
+        std::vector<std::vector<uint32_t>> common(n + 1, std::vector<uint32_t>(m + 1, 0));
+        for (size_t i = n; i-- > 0; )
+            for (size_t j = m; j-- > 0; )
+                common[i][j] = expected[i] == actual[j] ? common[i + 1][j + 1] + 1 : std::max(common[i + 1][j], common[i][j + 1]);
+
+        std::vector<std::string> lines;
+        std::vector<bool> changed;
+        size_t i = 0, j = 0;
+        while (i < n || j < m)
+        {
+            if (i < n && j < m && expected[i] == actual[j])        { lines.push_back("  " + expected[i++]); ++j; changed.push_back(false); }
+            else if (j < m && (i == n || common[i][j + 1] >= common[i + 1][j])) { lines.push_back("+ " + actual[j++]); changed.push_back(true); }
+            else                                                   { lines.push_back("- " + expected[i++]); changed.push_back(true); }
+        }
+
+        constexpr size_t CONTEXT = 2;
+        bool skipped = false;
+        for (size_t line = 0; line < lines.size(); ++line)
+        {
+            bool near = false;
+            for (size_t k = (line > CONTEXT ? line - CONTEXT : 0); k < lines.size() && k <= line + CONTEXT; ++k) near = near || changed[k];
+            if (!near) { skipped = true; continue; }
+            if (skipped) fprintf(stderr, "    ...\n");
+            skipped = false;
+            fprintf(stderr, "    %s\n", lines[line].c_str());
+        }
+    }
+
+    /**
+     * @brief Runs one operation between two trace resets and checks it: within budget, the model saw
+     *        the bytes SpiTrace counted and no more accesses or CSn cycles (SpiTrace counts a nested
+     *        applyTransaction() twice, the chip once), and its transaction log is the expected one.
+     */
+    void checkOperation(Bench& bench, const char* name, const SpiTraffic& budget, const std::function<void()>& operation)
+    {
+        SpiTrace::reset();
+        bench.model.clearTraffic();
+        operation();
+
+        SpiTraffic used = SpiTrace::traffic();
+        CC1101Model::Traffic wire = bench.model.traffic();
+        if (!used.within(budget))
+        {
+            ++failures;
+            fprintf(stderr, "  %s over budget: %s, budget %s\n", name, toText(used).c_str(), toText(budget).c_str());
+        }
+        CHECK_EQUAL(uint32_t(used.bytes), wire.bytes);
+        CHECK(wire.transactions <= used.transactions);
+        CHECK(wire.csnCycles <= used.csnCycles);
+
+        std::string path = expectedDir + "/" + name + ".log";
+        if (update)
+        {
+            std::ofstream file(path);
+            for (const std::string& line : bench.model.log()) file << line << '\n';
+            return;
+        }
+        std::vector<std::string> expected = readLines(path);
+        if (expected != bench.model.log())
+        {
+            ++failures;
+            fprintf(stderr, "  %s: transaction log differs from %s (- expected, + actual)\n", name, path.c_str());
+            printDiff(expected, bench.model.log());
+        }
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Operations, in the order runSpiBudgetCheck() runs them
+    // ---------------------------------------------------------------------------------
+    void test_begin()
+    {
+        Bench& bench = Bench::fresh();
+        checkOperation(bench, "begin", SpiBudget::BEGIN, [&]() { CHECK(bench.transceiver.begin()); });
+        CHECK_EQUAL(uint8_t(0x18), bench.model.reg(0x18));    // MCSM0: auto-calibration on IDLE -> TX / FSTXON
+        CHECK_EQUAL(uint8_t(0x01), bench.model.marcState());
+    }
+
+    void test_set_frequency()
+    {
+        Bench& bench = Bench::fresh();
+        bench.transceiver.begin();
+        checkOperation(bench, "setFrequency", SpiBudget::SET_FREQUENCY, [&]() { bench.transceiver.setFrequency(FREQ_315MHZ_BAND); });
+    }
+
+    void test_set_power_level()
+    {
+        Bench& bench = Bench::fresh();
+        bench.transceiver.begin();
+        checkOperation(bench, "setPowerLevel", SpiBudget::SET_POWER, [&]() { bench.transceiver.setPowerLevel(7); });
+        CHECK_EQUAL(7, bench.model.reg(0x22) & 0x07);           // FREND0.PA_POWER selects the last PATABLE entry
+        CHECK(bench.model.paTable()[7] != 0x00);
+    }
+
+    void test_status()
+    {
+        Bench& bench = Bench::fresh();
+        bench.transceiver.begin();
+        checkOperation(bench, "status", SpiBudget::STATUS_POLL, [&]() { CHECK_EQUAL(uint8_t(0x01), bench.transceiver.readMarcState()); });
+    }
+
+    void test_prepare_and_cancel()
+    {
+        Bench& bench = Bench::fresh();
+        bench.transceiver.begin();
+        checkOperation(bench, "prepare", SpiBudget::PREPARE, [&]() { CHECK(bench.transceiver.prepareTxSession()); });
+        CHECK_EQUAL(uint8_t(0x12), bench.model.marcState());
+        checkOperation(bench, "cancel", SpiBudget::CANCEL, [&]() { bench.transceiver.cancelTxSession(); });
+        CHECK_EQUAL(uint8_t(0x01), bench.model.marcState());
+    }
+
+    void test_prepared_frame()
+    {
+        Bench& bench = Bench::fresh();
+        bench.transceiver.begin();
+        CHECK(bench.transceiver.prepareTxSession());
+        checkOperation(bench, "preparedFrame", SpiBudget::PREPARED_FRAME,
+                       [&]() { CHECK(bench.transceiver.transmitFrame(REMOTE1_OPEN_DOOR_CODE, bench.encoder)); });
+    }
+
+    void test_transmit_frame()
+    {
+        Bench& bench = Bench::fresh();
+        bench.transceiver.begin();
+        checkOperation(bench, "transmitFrame", SpiBudget::TRANSMIT_FRAME,
+                       [&]() { CHECK(bench.transceiver.transmitFrame(REMOTE1_OPEN_DOOR_CODE, bench.encoder)); });
+    }
+
+    // The full entry strobes STX from IDLE: the chip calibrates first, TX must be confirmed before the burst
+    void test_full_entry_waits_for_calibration()
+    {
+        Bench& bench = Bench::fresh();
+        bench.transceiver.begin();
+        uint64_t start = hal::nowUs();
+        CHECK(bench.transceiver.openTxSession());
+        CHECK_EQUAL(uint8_t(0x13), bench.model.marcState());
+        CHECK(hal::nowUs() - start >= CC1101Model::CALIBRATION_US);
+        bench.transceiver.closeTxSession();
+    }
+
+    // The on-target check itself, on the model
+    void test_on_target_check_passes()
+    {
+        Bench& bench = Bench::fresh();
+        std::string printed;
+        hal::setSerialOutput([&](uint8_t byte) { printed += static_cast<char>(byte); });
+        bool pass = runSpiBudgetCheck(bench.transceiver, bench.encoder, Serial);
+        hal::setSerialOutput([](uint8_t) {});
+        if (!pass) fprintf(stderr, "%s", printed.c_str());
+        CHECK(pass);
+        CHECK(printed.find("SPI budget PASS") != std::string::npos);
+    }
+
+    struct Test
+    {
+        const char* name;
+        void (*run)();
+    };
+}
+
+int main(int argc, char** argv)
+{
+    expectedDir = argc > 1 ? argv[1] : "test/expected";
+    update = argc > 2 && strcmp(argv[2], "--update") == 0;
+
+    const Test tests[] =
+    {
+        { "begin",                            test_begin },
+        { "set_frequency",                    test_set_frequency },
+        { "set_power_level",                  test_set_power_level },
+        { "status",                           test_status },
+        { "prepare_and_cancel",               test_prepare_and_cancel },
+        { "prepared_frame",                   test_prepared_frame },
+        { "transmit_frame",                   test_transmit_frame },
+        { "full_entry_waits_for_calibration", test_full_entry_waits_for_calibration },
+        { "on_target_check_passes",           test_on_target_check_passes },
+    };
+
+    int failed = 0;
+    for (const Test& test : tests)
+    {
+        int before = failures;
+        test.run();
+        bool passed = failures == before;
+        if (!passed) ++failed;
+        printf("%s %s\n", passed ? "PASS" : "FAIL", test.name);
+    }
+    printf("%zu tests, %d failed\n", sizeof(tests) / sizeof(tests[0]), failed);
+    return failed ? 1 : 0;
+}
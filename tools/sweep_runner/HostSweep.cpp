@@ -0,0 +1,88 @@
+#include "HostSweep.h"
+#include "JobPool.h"
+#include "Delay/Timebase.h"
+#include <mutex>
+
+HostSweep::HostSweep(SweepFile& file, unsigned threads):
+_file(file),
+_threads(threads)
+{}
+
+/// @brief Mixed radix, the last axis fastest: SweepRunner::run()'s order
+void HostSweep::axisIndex(const SweepDefinition& sweep, uint16_t job, uint8_t* index)
+{
+    uint16_t rest = job;
+    for (uint8_t axis = (sweep.axisCount < SWEEP_MAX_AXES ? sweep.axisCount : SWEEP_MAX_AXES); axis-- > 0; )
+    {
+        index[axis] = rest % sweep.axisSize[axis];
+        rest /= sweep.axisSize[axis];
+    }
+}
+
+HostSweep::Stats HostSweep::run(const SweepDefinition& sweep, size_t maxUnits)
+{
+    Stats stats{};
+    uint16_t jobs = SweepRunner::jobCount(sweep);
+    stats.jobs = jobs;
+
+    // Units with work left, in grid order
+    std::vector<uint16_t> units;
+    for (uint32_t first = 0; first < jobs; first += SWEEP_BLOCK_ROWS)
+    {
+        bool pending = false;
+        for (uint32_t job = first; job < jobs && job < first + SWEEP_BLOCK_ROWS; ++job)
+        {
+            if (_file.hasJob(sweep.id, static_cast<uint16_t>(job))) ++stats.skipped;
+            else pending = true;
+        }
+        if (pending) units.push_back(static_cast<uint16_t>(first));
+    }
+    if (maxUnits && units.size() > maxUnits) units.resize(maxUnits);
+
+    // Which jobs to run is decided before any thread starts, the file only grows below
+    std::vector<std::vector<uint16_t>> missing(units.size());
+    for (size_t unit = 0; unit < units.size(); ++unit)
+        for (uint32_t job = units[unit]; job < jobs && job < units[unit] + uint32_t(SWEEP_BLOCK_ROWS); ++job)
+            if (!_file.hasJob(sweep.id, static_cast<uint16_t>(job))) missing[unit].push_back(static_cast<uint16_t>(job));
+
+    std::mutex output;
+    uint8_t columns = sweep.columns < SWEEP_MAX_COLUMNS ? sweep.columns : SWEEP_MAX_COLUMNS;
+
+    runJobs(units.size(), _threads, [&](size_t unit)
+    {
+        Timebase::suspend();
+
+        SweepFile::Block block{};
+        block.id      = sweep.id;
+        block.columns = columns;
+
+        auto flush = [&]()
+        {
+            if (block.rows == 0) return;
+            std::lock_guard<std::mutex> guard(output);
+            if (!_file.append(block)) stats.writeFailed = true;
+            stats.run += block.rows;
+            block = SweepFile::Block{};
+            block.id      = sweep.id;
+            block.columns = columns;
+        };
+
+        for (uint16_t job : missing[unit])
+        {
+            if (block.rows && block.firstJob + block.rows != job) flush();          // A gap: the jobs after it get their own block
+            if (block.rows == 0) block.firstJob = job;
+
+            uint8_t index[SWEEP_MAX_AXES] = {};
+            axisIndex(sweep, job, index);
+            sweep.job(index, SweepRunner::seedOf(sweep.id, job), block.values[block.rows]);
+            ++block.rows;
+        }
+        flush();
+
+        Timebase::resume(0);
+    });
+
+    stats.complete = true;
+    for (uint32_t job = 0; job < jobs; ++job) stats.complete = stats.complete && _file.hasJob(sweep.id, static_cast<uint16_t>(job));
+    return stats;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "SweepFile.h"
+#include "Simulation/ParameterSweep.h"
+
+/**
+ * @brief SweepRunner for the host: the same grid, jobs and seeds, on a work-stealing pool (JobPool.h).
+ *
+ * The grid is cut into units of SWEEP_BLOCK_ROWS consecutive jobs, the block size the firmware
+ * streams; a unit runs the jobs of it that the file does not hold yet, in job order on one board,
+ * and appends them as one block per run of consecutive missing jobs. Each job gets
+ * SweepRunner::seedOf(id, job) and the mixed-radix axis index SweepRunner::run() gives it, so a
+ * row is the row the board computes, whatever the thread count, the order units complete in, or
+ * how often the run was resumed.
+ *
+ * Jobs run with the Timebase suspended (virtual time only moves through Timebase::advance()), as
+ * runParameterSweeps() runs the debounce sweep.
+ */
+class HostSweep
+{
+    public:
+
+    struct Stats
+    {
+        size_t jobs;                                            // In the grid
+        size_t skipped;                                         // Already in the file
+        size_t run;
+        bool   complete;                                        // Every job is in the file
+        bool   writeFailed;
+    };
+
+    HostSweep(SweepFile& file, unsigned threads);
+
+    /// @brief Runs the jobs missing from the file; maxUnits > 0 stops after that many units (a partial run)
+    Stats run(const SweepDefinition& sweep, size_t maxUnits = 0);
+
+    static void axisIndex(const SweepDefinition& sweep, uint16_t job, uint8_t* index);
+
+    private:
+
+    SweepFile& _file;
+    unsigned   _threads;
+};
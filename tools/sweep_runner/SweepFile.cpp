@@ -0,0 +1,125 @@
+#include "SweepFile.h"
+#include <string.h>
+#include <unistd.h>
+
+constexpr uint8_t SweepFile::MAGIC[4];
+
+namespace
+{
+    /// @brief SweepFormat::encode() sink into a byte vector
+    struct Bytes
+    {
+        std::vector<uint8_t> bytes;
+        size_t write(const uint8_t* data, size_t length) { bytes.insert(bytes.end(), data, data + length); return length; }
+    };
+}
+
+SweepFile::~SweepFile()
+{
+    close();
+}
+
+bool SweepFile::open(const std::string& path, std::string& error)
+{
+    close();
+    _blocks.clear();
+    _done.clear();
+    _dropped = 0;
+
+    std::vector<uint8_t> content;
+    if (FILE* existing = fopen(path.c_str(), "rb"))
+    {
+        uint8_t chunk[4096];
+        size_t  length;
+        while ((length = fread(chunk, 1, sizeof(chunk), existing)) > 0) content.insert(content.end(), chunk, chunk + length);
+        fclose(existing);
+    }
+
+    size_t valid = 0;
+    if (!content.empty())
+    {
+        if (content.size() < sizeof(MAGIC) + 1 || memcmp(content.data(), MAGIC, sizeof(MAGIC)) != 0 || content[sizeof(MAGIC)] != VERSION)
+        {
+            error = path + ": not a sweep file (version " + std::to_string(VERSION) + ")";
+            return false;
+        }
+        valid = sizeof(MAGIC) + 1;
+        while (valid < content.size())
+        {
+            Block block{};
+            size_t used = SweepFormat::decode(content.data() + valid, content.size() - valid, block);
+            if (used == 0) break;
+            _blocks.push_back(block);
+            mark(block);
+            valid += used;
+        }
+        _dropped = content.size() - valid;
+    }
+
+    _file = fopen(path.c_str(), content.empty() ? "wb" : "r+b");
+    if (!_file)
+    {
+        error = path + ": can not open for writing";
+        return false;
+    }
+    if (content.empty())
+    {
+        fwrite(MAGIC, 1, sizeof(MAGIC), _file);
+        fputc(VERSION, _file);
+        fflush(_file);
+    }
+    else
+    {
+        if (_dropped && ftruncate(fileno(_file), static_cast<off_t>(valid)) != 0)
+        {
+            error = path + ": can not cut the partial block";
+            return false;
+        }
+        fseek(_file, static_cast<long>(valid), SEEK_SET);
+    }
+    return true;
+}
+
+void SweepFile::close()
+{
+    if (_file) fclose(_file);
+    _file = nullptr;
+}
+
+bool SweepFile::append(const Block& block)
+{
+    Bytes encoded;
+    SweepFormat::encode(block, encoded);
+    if (!_file || fwrite(encoded.bytes.data(), 1, encoded.bytes.size(), _file) != encoded.bytes.size() || fflush(_file) != 0) return false;
+    _blocks.push_back(block);
+    mark(block);
+    return true;
+}
+
+void SweepFile::mark(const Block& block)
+{
+    std::vector<bool>& done = _done[block.id];
+    size_t end = static_cast<size_t>(block.firstJob) + block.rows;
+    if (done.size() < end) done.resize(end, false);
+    for (size_t job = block.firstJob; job < end; ++job) done[job] = true;
+}
+
+bool SweepFile::hasJob(uint8_t id, uint16_t job) const
+{
+    auto found = _done.find(id);
+    return found != _done.end() && job < found->second.size() && found->second[job];
+}
+
+std::map<uint16_t, std::vector<int32_t>> SweepFile::rows(uint8_t id) const
+{
+    std::map<uint16_t, std::vector<int32_t>> rows;
+    for (const Block& block : _blocks)
+    {
+        if (block.id != id) continue;
+        for (uint8_t row = 0; row < block.rows; ++row)
+        {
+            rows[static_cast<uint16_t>(block.firstJob + row)].assign(block.values[row], block.values[row] + block.columns);
+        }
+    }
+    return rows;
+}
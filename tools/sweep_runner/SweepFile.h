@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "Simulation/ParameterSweep.h"
+
+/**
+ * @brief Sweep results on disk: the firmware's columnar blocks (Simulation/SweepFormat), back to back.
+ *
+ *   file    'S' 'W' 'P' 'F' | version u8                        (5 bytes)
+ *           block, block, ...                                    (SweepFormat blocks, any sweep id)
+ *
+ * Blocks are appended as they complete, so they need not be in job order; each names its sweep
+ * and first job. A run killed while writing leaves at most one partial block at the end: open()
+ * reads every whole block, cuts the file after the last one and appends from there, which is the
+ * resume: the jobs already in the file are not run again.
+ */
+class SweepFile
+{
+    public:
+
+    static constexpr uint8_t MAGIC[4] = { 'S', 'W', 'P', 'F' };
+    static constexpr uint8_t VERSION  = 1;
+
+    using Block = SweepFormat::Block<SWEEP_BLOCK_ROWS, SWEEP_MAX_COLUMNS>;
+
+    ~SweepFile();
+
+    /// @brief Opens (or creates) path for appending, after reading the blocks it holds
+    bool open(const std::string& path, std::string& error);
+    void close();
+
+    bool append(const Block& block);                            // Written and flushed: on disk before the next one starts
+
+    const std::vector<Block>& blocks() const { return _blocks; }
+    bool hasJob(uint8_t id, uint16_t job) const;
+    size_t droppedBytes() const { return _dropped; }            // Partial block cut off by open()
+
+    /// @brief The rows of one sweep in job order (row = job), missing jobs left out
+    std::map<uint16_t, std::vector<int32_t>> rows(uint8_t id) const;
+
+    private:
+
+    FILE*              _file = nullptr;
+    std::vector<Block> _blocks;
+    std::map<uint8_t, std::vector<bool>> _done;                 // Per sweep id, per job
+    size_t             _dropped = 0;
+
+    void mark(const Block& block);
+};
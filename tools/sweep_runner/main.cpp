@@ -0,0 +1,110 @@
+// Host runner of the firmware's parameter sweeps (Simulation/Sweeps): the same jobs and seeds on
+// every core, into a resumable columnar file (SweepFile.h).
+//
+//   sweep_runner [-j threads] [-l units] -o results.swp [sweep ...]   run the missing jobs (all sweeps by default)
+//   sweep_runner -c results.swp [sweep ...]                           print the rows as CSV, in job order
+//
+//   -j  worker threads (default: one per hardware thread)
+//   -l  stop after this many blocks of SWEEP_BLOCK_ROWS jobs per sweep (split a long run)
+//   sweep: 1 debounce, 2 acceptance
+#include "HostSweep.h"
+#include <HostBoard.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "Simulation/Sweeps.h"
+
+namespace
+{
+    const SweepDefinition* const SWEEPS[] = { &DEBOUNCE_SWEEP, &ACCEPTANCE_SWEEP };
+
+    void usage()
+    {
+        fprintf(stderr, "usage: sweep_runner [-j threads] [-l units] -o results.swp [sweep ...]\n"
+                        "       sweep_runner -c results.swp [sweep ...]\n");
+        exit(2);
+    }
+
+    const SweepDefinition* find(unsigned long id)
+    {
+        for (const SweepDefinition* sweep : SWEEPS) if (sweep->id == id) return sweep;
+        return nullptr;
+    }
+
+    void printCsv(const SweepFile& file, const SweepDefinition& sweep)
+    {
+        printf("sweep,job,%s\n", sweep.header);
+        for (const auto& row : file.rows(sweep.id))
+        {
+            printf("%u,%u", sweep.id, row.first);
+            for (int32_t value : row.second) printf(",%d", value);
+            printf("\n");
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned threads = 0;
+    size_t   maxUnits = 0;
+    const char* output = nullptr;
+    const char* csv = nullptr;
+
+    int option;
+    while ((option = getopt(argc, argv, "j:l:o:c:")) != -1)
+    {
+        switch (option)
+        {
+            case 'j': threads  = static_cast<unsigned>(strtoul(optarg, nullptr, 0)); break;
+            case 'l': maxUnits = strtoul(optarg, nullptr, 0); break;
+            case 'o': output   = optarg; break;
+            case 'c': csv      = optarg; break;
+            default:  usage();
+        }
+    }
+    if (!output == !csv) usage();
+
+    std::vector<const SweepDefinition*> sweeps;
+    for (int i = optind; i < argc; ++i)
+    {
+        const SweepDefinition* sweep = find(strtoul(argv[i], nullptr, 0));
+        if (!sweep) usage();
+        sweeps.push_back(sweep);
+    }
+    if (sweeps.empty()) sweeps.assign(std::begin(SWEEPS), std::end(SWEEPS));
+
+    SweepFile file;
+    std::string error;
+    if (!file.open(output ? output : csv, error))
+    {
+        fprintf(stderr, "sweep_runner: %s\n", error.c_str());
+        return 1;
+    }
+
+    if (csv)
+    {
+        for (const SweepDefinition* sweep : sweeps) printCsv(file, *sweep);
+        return 0;
+    }
+
+    if (file.droppedBytes()) fprintf(stderr, "sweep_runner: cut a partial block of %zu bytes, resuming\n", file.droppedBytes());
+
+    hal::reset();
+    HostSweep runner(file, threads);
+    bool ok = true;
+    for (const SweepDefinition* sweep : sweeps)
+    {
+        auto start = std::chrono::steady_clock::now();
+        HostSweep::Stats stats = runner.run(*sweep, maxUnits);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        fprintf(stderr, "SWEEP %u jobs=%zu skipped=%zu run=%zu %s in %.2f s\n", sweep->id, stats.jobs, stats.skipped, stats.run,
+                stats.complete ? "done" : "partial", seconds);
+        if (stats.writeFailed)
+        {
+            fprintf(stderr, "sweep_runner: write to %s failed\n", output);
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,219 @@
+// The host sweep runner against the firmware's own runner: the rows in the file must be the rows
+// SweepRunner prints on the board, on any thread count, and a run that was cut short (stopped
+// early, or killed in the middle of a block) must resume to the same file content.
+#include "HostSweep.h"
+#include "SweepFile.h"
+#include <HostBoard.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "Delay/Timebase.h"
+#include "Simulation/Sweeps.h"
+
+namespace
+{
+    int failures = 0;
+
+    #define CHECK(condition) \
+        do { if (!(condition)) { ++failures; fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); } } while (0)
+
+    #define CHECK_EQUAL(expected, actual) \
+        do { auto e_ = (expected); auto a_ = (actual); if (!(e_ == a_)) { ++failures; \
+             fprintf(stderr, "  %s:%d: expected %s, got %s\n", __FILE__, __LINE__, toText(e_).c_str(), toText(a_).c_str()); } } while (0)
+
+    template<typename T> std::string toText(T value) { return std::to_string(value); }
+
+    using Rows = std::map<uint16_t, std::vector<int32_t>>;
+
+    /// @brief Print into a string
+    struct Text : Print
+    {
+        std::string text;
+        size_t write(uint8_t byte) override { text += static_cast<char>(byte); return 1; }
+    };
+
+    /// @brief A sweep file in /tmp, removed with the fixture
+    struct TempFile
+    {
+        std::string path;
+
+        TempFile()
+        {
+            char name[] = "/tmp/sweep_runnerXXXXXX";
+            int fd = mkstemp(name);
+            if (fd >= 0) ::close(fd);
+            unlink(name);                                       // SweepFile creates it with its header
+            path = name;
+        }
+        ~TempFile() { unlink(path.c_str()); }
+    };
+
+    /// @brief The rows of a sweep as the board prints them: decoded "SWB" lines of SweepRunner::run()
+    Rows boardRows(const SweepDefinition& sweep)
+    {
+        hal::reset();
+        Text out;
+        SweepRunner runner(out);
+        runner.clear(sweep);
+        Timebase::suspend();
+        runner.run(sweep);
+        Timebase::resume(0);
+
+        Rows rows;
+        size_t position = 0;
+        while ((position = out.text.find("SWB ", position)) != std::string::npos)
+        {
+            position += 4;
+            size_t end = out.text.find_first_of("\r\n", position);
+            std::vector<uint8_t> bytes;
+            for (size_t i = position; i + 1 < end; i += 2) bytes.push_back(static_cast<uint8_t>(strtoul(out.text.substr(i, 2).c_str(), nullptr, 16)));
+
+            SweepFile::Block block{};
+            CHECK_EQUAL(bytes.size(), SweepFormat::decode(bytes.data(), bytes.size(), block));
+            for (uint8_t row = 0; row < block.rows; ++row)
+                rows[block.firstJob + row].assign(block.values[row], block.values[row] + block.columns);
+        }
+        return rows;
+    }
+
+    Rows hostRows(const std::string& path, const SweepDefinition& sweep, unsigned threads, size_t maxUnits = 0)
+    {
+        SweepFile file;
+        std::string error;
+        CHECK(file.open(path, error));
+        HostSweep(file, threads).run(sweep, maxUnits);
+        return file.rows(sweep.id);
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Tests
+    // ---------------------------------------------------------------------------------
+
+    void test_debounce_rows_match_the_board()
+    {
+        Rows board = boardRows(DEBOUNCE_SWEEP);
+        CHECK_EQUAL(size_t(SweepRunner::jobCount(DEBOUNCE_SWEEP)), board.size());
+
+        TempFile file;
+        CHECK(board == hostRows(file.path, DEBOUNCE_SWEEP, 4));
+    }
+
+    void test_acceptance_rows_match_the_board()
+    {
+        Rows board = boardRows(ACCEPTANCE_SWEEP);
+        CHECK_EQUAL(size_t(SweepRunner::jobCount(ACCEPTANCE_SWEEP)), board.size());
+
+        TempFile file;
+        CHECK(board == hostRows(file.path, ACCEPTANCE_SWEEP, 4));
+    }
+
+    void test_thread_count_does_not_change_rows()
+    {
+        TempFile one, eight;
+        Rows single = hostRows(one.path, DEBOUNCE_SWEEP, 1);
+        CHECK(!single.empty());
+        CHECK(single == hostRows(eight.path, DEBOUNCE_SWEEP, 8));
+    }
+
+    // Stopped after two units, then resumed: no job twice, the same rows as one full run
+    void test_resume_after_a_partial_run()
+    {
+        TempFile full, split;
+        Rows whole = hostRows(full.path, DEBOUNCE_SWEEP, 2);
+
+        {
+            SweepFile file;
+            std::string error;
+            CHECK(file.open(split.path, error));
+            HostSweep::Stats first = HostSweep(file, 2).run(DEBOUNCE_SWEEP, 2);
+            CHECK_EQUAL(size_t(2 * SWEEP_BLOCK_ROWS), first.run);
+            CHECK(!first.complete);
+        }
+
+        SweepFile file;
+        std::string error;
+        CHECK(file.open(split.path, error));
+        HostSweep::Stats second = HostSweep(file, 3).run(DEBOUNCE_SWEEP);
+        CHECK_EQUAL(size_t(2 * SWEEP_BLOCK_ROWS), second.skipped);
+        CHECK_EQUAL(second.jobs - second.skipped, second.run);
+        CHECK(second.complete);
+        CHECK(whole == file.rows(DEBOUNCE_SWEEP.id));
+
+        size_t stored = 0;
+        for (const SweepFile::Block& block : file.blocks()) if (block.id == DEBOUNCE_SWEEP.id) stored += block.rows;
+        CHECK_EQUAL(second.jobs, stored);
+    }
+
+    // Killed while writing: the half block at the end is cut, its jobs run again
+    void test_partial_block_at_the_end_is_cut()
+    {
+        TempFile full, killed;
+        Rows whole = hostRows(full.path, ACCEPTANCE_SWEEP, 2);
+        hostRows(killed.path, ACCEPTANCE_SWEEP, 2, 1);
+
+        FILE* raw = fopen(killed.path.c_str(), "ab");
+        const uint8_t half[] = { ACCEPTANCE_SWEEP.id, 0x08, 0x00, 0x04 };      // A header and no rows
+        CHECK(raw && fwrite(half, 1, sizeof(half), raw) == sizeof(half));
+        if (raw) fclose(raw);
+
+        SweepFile file;
+        std::string error;
+        CHECK(file.open(killed.path, error));
+        CHECK_EQUAL(sizeof(half), file.droppedBytes());
+        CHECK(HostSweep(file, 2).run(ACCEPTANCE_SWEEP).complete);
+        CHECK(whole == file.rows(ACCEPTANCE_SWEEP.id));
+
+        SweepFile reopened;
+        CHECK(reopened.open(killed.path, error));
+        CHECK_EQUAL(size_t(0), reopened.droppedBytes());
+        CHECK(whole == reopened.rows(ACCEPTANCE_SWEEP.id));
+    }
+
+    void test_not_a_sweep_file_is_refused()
+    {
+        TempFile file;
+        FILE* raw = fopen(file.path.c_str(), "wb");
+        CHECK(raw && fputs("id,job\n", raw) >= 0);
+        if (raw) fclose(raw);
+
+        SweepFile sweeps;
+        std::string error;
+        CHECK(!sweeps.open(file.path, error));
+        CHECK(!error.empty());
+    }
+
+    struct Test
+    {
+        const char* name;
+        void (*run)();
+    };
+}
+
+int main()
+{
+    const Test tests[] =
+    {
+        { "debounce_rows_match_the_board",    test_debounce_rows_match_the_board },
+        { "acceptance_rows_match_the_board",  test_acceptance_rows_match_the_board },
+        { "thread_count_does_not_change_rows", test_thread_count_does_not_change_rows },
+        { "resume_after_a_partial_run",       test_resume_after_a_partial_run },
+        { "partial_block_at_the_end_is_cut",  test_partial_block_at_the_end_is_cut },
+        { "not_a_sweep_file_is_refused",      test_not_a_sweep_file_is_refused },
+    };
+
+    int failed = 0;
+    for (const Test& test : tests)
+    {
+        int before = failures;
+        test.run();
+        bool passed = failures == before;
+        if (!passed) ++failed;
+        printf("%s %s\n", passed ? "PASS" : "FAIL", test.name);
+    }
+    printf("%zu tests, %d failed\n", sizeof(tests) / sizeof(tests[0]), failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+// A field unit on the host: the FIELD_TRACE_MODE firmware (src/main.cpp) on hal/host with the
+// CC1101 model on its SPI bus, its button pressed on a schedule. Prints what the unit prints on
+// its UART, the field log with the "TRC" lines trace_replay reads.
+//
+//   field_unit [-t seconds] [-b bounces] press_ms[:hold_ms] ... > field.log
+//
+//   -t  session length in board time, from the end of setup() (default 10 s)
+//   -b  contact bounces on each press and release edge, 300 us apart (default 2)
+//   press_ms  press time from the end of setup(), held hold_ms (default 300 ms)
+#include "CC1101Model.h"
+#include <Arduino.h>
+#include <HostBoard.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <vector>
+#include "Config/Constants.h"
+
+void setup();
+void loop();
+
+namespace
+{
+    constexpr uint32_t BOUNCE_SPACING_US = 300;
+    constexpr uint32_t DEFAULT_HOLD_MS   = 300;
+    constexpr uint32_t DRAIN_US          = 1000000;             // After the session: the recorder's ring goes out
+    constexpr uint32_t LOOP_PASS_US      = 20;                  // A loop() pass on the board (hal/host only charges clock, pin and UART reads)
+
+    struct PinEdge
+    {
+        uint64_t atUs;
+        uint8_t  level;
+
+        bool operator<(const PinEdge& other) const { return atUs < other.atUs; }
+    };
+
+    void usage()
+    {
+        fprintf(stderr, "usage: field_unit [-t seconds] [-b bounces] press_ms[:hold_ms] ... > field.log\n");
+        exit(2);
+    }
+
+    /// @brief The contact closes (LOW, pull-up) bouncing, opens bouncing
+    void addPress(std::vector<PinEdge>& edges, uint64_t pressUs, uint64_t holdUs, unsigned bounces)
+    {
+        for (uint64_t edgeUs : { pressUs, pressUs + holdUs })
+        {
+            uint8_t settled = edgeUs == pressUs ? LOW : HIGH;
+            for (unsigned bounce = 0; bounce < bounces; ++bounce)
+            {
+                edges.push_back({ edgeUs + 2 * bounce * BOUNCE_SPACING_US, settled });
+                edges.push_back({ edgeUs + (2 * bounce + 1) * BOUNCE_SPACING_US, static_cast<uint8_t>(!settled) });
+            }
+            edges.push_back({ edgeUs + 2 * bounces * BOUNCE_SPACING_US, settled });
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t sessionUs = 10000000;
+    unsigned bounces   = 2;
+
+    int option;
+    while ((option = getopt(argc, argv, "t:b:")) != -1)
+    {
+        switch (option)
+        {
+            case 't': sessionUs = static_cast<uint64_t>(strtod(optarg, nullptr) * 1e6); break;
+            case 'b': bounces   = static_cast<unsigned>(strtoul(optarg, nullptr, 0)); break;
+            default:  usage();
+        }
+    }
+
+    std::vector<PinEdge> edges;
+    for (int i = optind; i < argc; ++i)
+    {
+        char* rest = nullptr;
+        uint64_t pressMs = strtoull(argv[i], &rest, 0);
+        uint64_t holdMs  = *rest == ':' ? strtoull(rest + 1, &rest, 0) : DEFAULT_HOLD_MS;
+        if (*rest != '\0' || holdMs == 0) usage();
+        addPress(edges, pressMs * 1000, holdMs * 1000, bounces);
+    }
+    std::stable_sort(edges.begin(), edges.end());
+
+    CC1101Model radio;
+    hal::reset();
+    hal::attachSpiDevice(CSN_PIN, &radio);
+    setup();
+
+    uint64_t origin = hal::nowUs();
+    size_t next = 0;
+    while (hal::nowUs() - origin < sessionUs + DRAIN_US)
+    {
+        while (next < edges.size() && hal::nowUs() - origin >= edges[next].atUs)
+        {
+            hal::drivePin(BUTTON_HOME_DOOR_GARAGE_PIN, edges[next++].level);
+        }
+        loop();
+        hal::advanceUs(LOOP_PASS_US);
+    }
+    fflush(stdout);
+    return 0;
+}
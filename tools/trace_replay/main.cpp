@@ -0,0 +1,115 @@
+// Replays a field log (Capture/FieldTrace) through the TRACE_REPLAY_MODE firmware (src/main.cpp)
+// on hal/host: each "TRC?" of the firmware is answered with the next "TRC" line of the log, "TRC
+// END" after the last one. The unit boots against the CC1101 model, as the field unit booted
+// against its chip; from the Start record on, SPIBus answers from the trace and the model is off
+// the bus. Time is the Timebase's virtual count: idle stretches, bursts and radio timeouts take
+// no wall time.
+//
+//   trace_replay [-v] field.log
+//
+//   -v  also print the firmware's other output (boot, LOG lines)
+// Prints the firmware's "REPLAY ..." lines. Exit status 0 when the whole trace replayed, 1 on a
+// divergence or an unusable trace.
+#include "CC1101Model.h"
+#include <Arduino.h>
+#include <HostBoard.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Capture/FieldTrace.h"
+#include "Config/Constants.h"
+
+void setup();
+void loop();
+
+namespace
+{
+    void usage()
+    {
+        fprintf(stderr, "usage: trace_replay [-v] field.log\n");
+        exit(2);
+    }
+
+    /// @brief The host end of the replay: answers the prompts, picks out the REPLAY lines
+    struct Console
+    {
+        std::vector<std::string> trace;                         // "TRC <hex>" lines of the field log
+        size_t      next = 0;
+        bool        verbose = false;
+        bool        done = false;                               // "REPLAY done" printed
+        bool        diverged = false;
+        std::string line;
+
+        void onByte(uint8_t byte)
+        {
+            if (byte == '\r') return;
+            if (byte != '\n')
+            {
+                line += static_cast<char>(byte);
+                return;
+            }
+
+            if (line == "TRC?")
+            {
+                std::string answer = (next < trace.size() ? trace[next++] : std::string("TRC END")) + "\n";
+                hal::serialInput(answer.data(), answer.size());
+            }
+            else if (line.compare(0, 7, "REPLAY ") == 0)
+            {
+                done     = done || line.compare(0, 11, "REPLAY done") == 0;
+                diverged = diverged || line.compare(0, 15, "REPLAY diverged") == 0 || line.compare(0, 14, "REPLAY stopped") == 0;
+                printf("%s\n", line.c_str());
+            }
+            else if (verbose)
+            {
+                printf("%s\n", line.c_str());
+            }
+            line.clear();
+        }
+    };
+}
+
+int main(int argc, char** argv)
+{
+    Console console;
+
+    int option;
+    while ((option = getopt(argc, argv, "v")) != -1)
+    {
+        if (option == 'v') console.verbose = true;
+        else usage();
+    }
+    if (optind + 1 != argc) usage();
+
+    std::ifstream log(argv[optind]);
+    if (!log)
+    {
+        fprintf(stderr, "trace_replay: can not read %s\n", argv[optind]);
+        return 2;
+    }
+    for (std::string line; std::getline(log, line); )
+    {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.compare(0, 4, "TRC ") == 0) console.trace.push_back(line);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    CC1101Model radio;
+    hal::reset();
+    hal::setSerialOutput([&](uint8_t byte) { console.onByte(byte); });
+    hal::attachSpiDevice(CSN_PIN, &radio);
+    setup();                                                    // Ends in FieldTrace::beginReplay(): the Start record is read
+    hal::attachSpiDevice(CSN_PIN, nullptr);
+
+    while (FieldTrace::replaying()) loop();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fflush(stdout);
+    fprintf(stderr, "trace_replay: %zu trace lines in %.2f s\n", console.trace.size(), seconds);
+    return console.done && !console.diverged ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+// Record / replay round trips of the whole firmware: field_unit records a session against the
+// CC1101 model (FIELD_TRACE_MODE), trace_replay replays its log (TRACE_REPLAY_MODE, SPIBus
+// answering from the trace). Two firmware builds, so the test drives the two programs.
+//
+//   test_trace_replay <field_unit> <trace_replay>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Capture/TraceFormat.h"
+#include "Config/Constants.h"
+
+namespace
+{
+    int failures = 0;
+    std::string fieldUnit;
+    std::string traceReplay;
+
+    #define CHECK(condition) \
+        do { if (!(condition)) { ++failures; fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); } } while (0)
+
+    #define CHECK_EQUAL(expected, actual) \
+        do { auto e_ = (expected); auto a_ = (actual); if (!(e_ == a_)) { ++failures; \
+             fprintf(stderr, "  %s:%d: expected %s, got %s\n", __FILE__, __LINE__, toText(e_).c_str(), toText(a_).c_str()); } } while (0)
+
+    template<typename T> std::string toText(T value) { return std::to_string(value); }
+
+    /// @brief A file in /tmp, removed with the fixture
+    struct TempFile
+    {
+        std::string path;
+
+        TempFile()
+        {
+            char name[] = "/tmp/trace_replayXXXXXX";
+            int fd = mkstemp(name);
+            if (fd >= 0) ::close(fd);
+            path = name;
+        }
+        ~TempFile() { unlink(path.c_str()); }
+    };
+
+    struct Run
+    {
+        int         status;                                     // Exit status, -1 if it did not exit
+        std::string output;                                     // stdout
+        double      seconds;
+    };
+
+    Run run(const std::string& command)
+    {
+        Run result{ -1, "", 0 };
+        auto start = std::chrono::steady_clock::now();
+        FILE* pipe = popen((command + " 2>/dev/null").c_str(), "r");
+        if (!pipe) return result;
+        char buffer[4096];
+        size_t length;
+        while ((length = fread(buffer, 1, sizeof(buffer), pipe)) > 0) result.output.append(buffer, length);
+        int status = pclose(pipe);
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (WIFEXITED(status)) result.status = WEXITSTATUS(status);
+        return result;
+    }
+
+    Run record(const std::string& log, const std::string& arguments)
+    {
+        return run(fieldUnit + " " + arguments + " > " + log);
+    }
+
+    /// @brief The number after "<key>=" in text, -1 without one
+    long field(const std::string& text, const std::string& key)
+    {
+        size_t at = text.find(key + "=");
+        return at == std::string::npos ? -1 : strtol(text.c_str() + at + key.size() + 1, nullptr, 10);
+    }
+
+    /// @brief The trace records of a field log, its "TRC" lines decoded
+    std::vector<Trace::Record> readTrace(const std::string& path)
+    {
+        std::vector<Trace::Record> records;
+        Trace::Decoder decoder;
+        Trace::Record record{};
+        std::ifstream log(path);
+        for (std::string line; std::getline(log, line); )
+        {
+            if (line.compare(0, 4, "TRC ") != 0) continue;
+            for (size_t i = 4; i + 1 < line.size(); i += 2)
+            {
+                uint8_t byte = static_cast<uint8_t>(strtoul(line.substr(i, 2).c_str(), nullptr, 16));
+                if (decoder.push(byte, record)) records.push_back(record);
+            }
+        }
+        CHECK(!decoder.faulted() && decoder.between());
+        return records;
+    }
+
+    /// @brief A field log holding records, FIELD_TRACE_LINE_BYTES per "TRC" line like the recorder's
+    void writeTrace(const std::string& path, const std::vector<Trace::Record>& records)
+    {
+        std::vector<uint8_t> bytes;
+        for (const Trace::Record& record : records)
+        {
+            uint8_t encoded[Trace::MAX_RECORD_BYTES];
+            uint8_t length = Trace::encode(record, encoded);
+            bytes.insert(bytes.end(), encoded, encoded + length);
+        }
+
+        FILE* log = fopen(path.c_str(), "w");
+        CHECK(log != nullptr);
+        if (!log) return;
+        for (size_t i = 0; i < bytes.size(); ++i)
+        {
+            if (i % FIELD_TRACE_LINE_BYTES == 0) fprintf(log, i ? "\nTRC " : "TRC ");
+            fprintf(log, "%02x", bytes[i]);
+        }
+        fprintf(log, "\n");
+        fclose(log);
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  Tests
+    // ---------------------------------------------------------------------------------
+
+    // Two presses, one held: every recorded record is consumed, no divergence
+    void test_session_replays_without_divergence()
+    {
+        TempFile log;
+        CHECK_EQUAL(0, record(log.path, "-t 20 1000 6000:1500").status);
+        std::vector<Trace::Record> trace = readTrace(log.path);
+        CHECK(trace.size() > 100);
+
+        size_t edges = 0;
+        for (const Trace::Record& record : trace) edges += record.kind == Trace::Kind::Edge;
+        CHECK_EQUAL(size_t(2 * 2 * 5), edges);                  // 2 presses x (press + release) x (2 bounces + settle)
+
+        Run replay = run(traceReplay + " " + log.path);
+        CHECK_EQUAL(0, replay.status);
+        CHECK(replay.output.find("REPLAY done") != std::string::npos);
+        CHECK_EQUAL(long(trace.size()), field(replay.output, "records"));
+    }
+
+    // Ten minutes in the field, idle between three presses: far faster than real time
+    void test_long_idle_session_replays_fast()
+    {
+        TempFile log;
+        CHECK_EQUAL(0, record(log.path, "-t 600 1000 240000 590000").status);
+
+        Run replay = run(traceReplay + " " + log.path);
+        CHECK_EQUAL(0, replay.status);
+        long traceMs = field(replay.output, "trace_ms");
+        CHECK(traceMs > 589000);
+        CHECK(replay.seconds * 100 < traceMs / 1000.0);
+    }
+
+    // A transaction byte the firmware would now send differently: reported at that record
+    void test_changed_byte_is_reported_at_its_record()
+    {
+        TempFile log, changed;
+        CHECK_EQUAL(0, record(log.path, "-t 5 1000").status);
+        std::vector<Trace::Record> trace = readTrace(log.path);
+
+        size_t target = trace.size();                           // The first byte sent after the press edge
+        bool pressed = false;
+        for (size_t i = 0; i < trace.size() && target == trace.size(); ++i)
+        {
+            pressed = pressed || trace[i].kind == Trace::Kind::Edge;
+            if (pressed && trace[i].kind == Trace::Kind::Byte) target = i;
+        }
+        CHECK(target < trace.size());
+        if (target == trace.size()) return;
+
+        trace[target].mosi ^= 0x01;
+        writeTrace(changed.path, trace);
+
+        Run replay = run(traceReplay + " " + changed.path);
+        CHECK_EQUAL(1, replay.status);
+        CHECK(replay.output.find("REPLAY diverged") != std::string::npos);
+        CHECK(replay.output.find("byte differs") != std::string::npos);
+        CHECK_EQUAL(long(target), field(replay.output, "record"));
+    }
+
+    // The field log as captured: other lines between the trace lines, CRLF line ends
+    void test_other_log_lines_are_skipped()
+    {
+        TempFile log, noisy;
+        CHECK_EQUAL(0, record(log.path, "-t 5 1000").status);
+        std::vector<Trace::Record> trace = readTrace(log.path);
+
+        std::ifstream in(log.path);
+        std::ofstream out(noisy.path);
+        out << "System Booting...\r\n";
+        for (std::string line; std::getline(in, line); ) out << line << "\r\nMARCSTATE: 0x1\r\n";
+        out.close();
+
+        Run replay = run(traceReplay + " " + noisy.path);
+        CHECK_EQUAL(0, replay.status);
+        CHECK_EQUAL(long(trace.size()), field(replay.output, "records"));
+    }
+
+    struct Test
+    {
+        const char* name;
+        void (*run)();
+    };
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: test_trace_replay <field_unit> <trace_replay>\n");
+        return 2;
+    }
+    fieldUnit   = argv[1];
+    traceReplay = argv[2];
+
+    const Test tests[] =
+    {
+        { "session_replays_without_divergence",  test_session_replays_without_divergence },
+        { "long_idle_session_replays_fast",      test_long_idle_session_replays_fast },
+        { "changed_byte_is_reported_at_its_record", test_changed_byte_is_reported_at_its_record },
+        { "other_log_lines_are_skipped",         test_other_log_lines_are_skipped },
+    };
+
+    int failed = 0;
+    for (const Test& test : tests)
+    {
+        int before = failures;
+        test.run();
+        bool passed = failures == before;
+        if (!passed) ++failed;
+        printf("%s %s\n", passed ? "PASS" : "FAIL", test.name);
+    }
+    printf("%zu tests, %d failed\n", sizeof(tests) / sizeof(tests[0]), failed);
+    return failed ? 1 : 0;
+}